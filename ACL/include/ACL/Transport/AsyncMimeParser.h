@@ -0,0 +1,197 @@
+/*
+ * AsyncMimeParser.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_ACL_INCLUDE_ACL_TRANSPORT_ASYNCMIMEPARSER_H_
+#define ALEXA_CLIENT_SDK_ACL_INCLUDE_ACL_TRANSPORT_ASYNCMIMEPARSER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <AVSCommon/AVS/Attachment/AttachmentManager.h>
+#include <AVSCommon/Utils/SDS/InProcessSDS.h>
+#include <AVSCommon/Utils/Threading/Executor.h>
+#include <AVSCommon/Utils/Threading/ThreadPool.h>
+
+#include "ACL/Transport/MessageConsumerInterface.h"
+#include "ACL/Transport/MimeParser.h"
+
+namespace alexaClientSDK {
+namespace acl {
+
+/**
+ * A @c MimeParser which runs on an @c Executor rather than on the thread feeding it.
+ *
+ * @c HTTP2Transport has a single network thread for all of its streams.  Parsing a response there, which includes
+ * writing attachments and handing directives to the @c MessageConsumerInterface, holds up every other stream, including
+ * uploads of live audio.  Instead, @c feed() only copies the data into a queue, and the data is parsed on the
+ * executor.  The queue is a single writer, single reader @c InProcessSDS, so the network thread never waits for the
+ * parser.  The executor runs on a @c ThreadPool which the parsers of all the streams of a transport share, and only
+ * uses a thread of it while there is data to parse.
+ *
+ * When an attachment's buffer is full, parsing stops and the thread is released until @c feed() or @c resume() is
+ * called again.  Meanwhile, once the queue is full, @c feed() returns @c INCOMPLETE so that the transfer can be
+ * paused as before.
+ *
+ * @c feed(), @c resume(), @c reset(), @c setBoundaryString() and @c setAttachmentContextId() must be called from one
+ * thread.
+ */
+class AsyncMimeParser {
+public:
+    /// The default size of the queue of data waiting to be parsed.
+    static constexpr size_t DEFAULT_QUEUE_SIZE_IN_BYTES = 64 * 1024;
+
+    /**
+     * Constructor.  The queue is not allocated until data is first fed.
+     *
+     * @param messageConsumer The MessageConsumerInterface which should receive messages from AVS.
+     * @param attachmentManager The attachment manager that manages the attachment.
+     * @param threadPool The pool to parse on.  If @c nullptr, the parser's @c Executor picks one as usual.
+     * @param queueSizeInBytes The size of the queue of data waiting to be parsed.
+     */
+    AsyncMimeParser(
+        std::shared_ptr<MessageConsumerInterface> messageConsumer,
+        std::shared_ptr<avsCommon::avs::attachment::AttachmentManager> attachmentManager,
+        std::shared_ptr<avsCommon::utils::threading::ThreadPool> threadPool = nullptr,
+        size_t queueSizeInBytes = DEFAULT_QUEUE_SIZE_IN_BYTES);
+
+    /**
+     * Destructor.  Data which has not been parsed yet is dropped.
+     */
+    ~AsyncMimeParser();
+
+    /**
+     * Resets the parser for use in another transfer.  Data which has not been parsed yet is dropped, the idle callback
+     * is cleared, and this waits for the executor to stop using the parser.
+     */
+    void reset();
+
+    /**
+     * Queues a chunk of a MIME multipart stream to be parsed.
+     *
+     * @param data pointer to chunk of data.
+     * @param length length of data to feed.
+     * @return @c OK if the data was queued, @c INCOMPLETE if there is no room for it yet, in which case it should be
+     *     fed again later, or @c ERROR if parsing earlier data failed.
+     */
+    MimeParser::DataParsedStatus feed(char* data, size_t length);
+
+    /**
+     * Parse again the data which was held back because an attachment's buffer was full.  Attachment readers do not
+     * signal when they catch up, so the owner calls this whenever it next gets the chance, as @c feed() does.
+     */
+    void resume();
+
+    /**
+     * Set the context ID to use when creating attachments.  This must not be called while data is being parsed.
+     *
+     * @param attachmentContextId The context ID to use when creating attachments.
+     */
+    void setAttachmentContextId(const std::string& attachmentContextId);
+
+    /**
+     * Sets the MIME multipart boundary string.  This must not be called while data is being parsed.
+     *
+     * @param boundaryString The MIME multipart boundary string
+     */
+    void setBoundaryString(const std::string& boundaryString);
+
+    /**
+     * Report whether all of the data fed so far has been parsed (or dropped after an error), so that every directive
+     * in it has been passed to the @c MessageConsumerInterface.
+     *
+     * @return Whether all of the data fed so far has been parsed.
+     */
+    bool isIdle() const;
+
+    /**
+     * Set a function to be called on the executor each time the parser becomes idle.  Set it before checking
+     * @c isIdle(), so that the parser can't become idle unnoticed in between.
+     *
+     * @param idleCallback The function to call, or @c nullptr for none.
+     */
+    void setIdleCallback(std::function<void()> idleCallback);
+
+private:
+    /**
+     * Parse the queued data until the queue is empty.  This runs on @c m_executor.
+     */
+    void parseQueuedData();
+
+    /**
+     * Allocate @c m_queue and its reader and writer.
+     *
+     * @return Whether the queue was created.
+     */
+    bool createQueue();
+
+    /**
+     * Call @c m_idleCallback, if set.
+     */
+    void notifyIdle();
+
+    /// The size of @c m_queue, once it is created.
+    const size_t m_queueSizeInBytes;
+
+    /// The parser, which is only used on @c m_executor once data has been fed.
+    MimeParser m_parser;
+
+    /// The queue of data waiting to be parsed.
+    std::shared_ptr<avsCommon::utils::sds::InProcessSDS> m_queue;
+
+    /// The writer used by @c feed() to add data to @c m_queue.
+    std::unique_ptr<avsCommon::utils::sds::InProcessSDS::Writer> m_queueWriter;
+
+    /// The reader used by @c parseQueuedData() to take data from @c m_queue.
+    std::unique_ptr<avsCommon::utils::sds::InProcessSDS::Reader> m_queueReader;
+
+    /// The chunk of data being parsed, which is kept to be fed again if the parser returns @c INCOMPLETE.
+    std::vector<char> m_chunk;
+
+    /// The number of bytes in @c m_chunk.
+    size_t m_chunkSize;
+
+    /// The number of bytes which have been fed but not yet parsed.
+    std::atomic<size_t> m_numPendingBytes;
+
+    /// Whether a call to @c parseQueuedData() has been submitted and has not yet found @c m_queue empty.
+    std::atomic<bool> m_isParseScheduled;
+
+    /// Whether parsing has failed since the last @c reset().  Further data is dropped.
+    std::atomic<bool> m_hasFailed;
+
+    /// Whether @c reset() or the destructor is waiting for @c parseQueuedData() to return.
+    std::atomic<bool> m_isCancelled;
+
+    /// Mutex serializing access to @c m_idleCallback.
+    std::mutex m_idleCallbackMutex;
+
+    /// The function to call when the parser becomes idle.
+    std::function<void()> m_idleCallback;
+
+    /// The executor which parses the data.  This is declared last so that it shuts down first.
+    avsCommon::utils::threading::Executor m_executor;
+};
+
+}  // namespace acl
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_ACL_INCLUDE_ACL_TRANSPORT_ASYNCMIMEPARSER_H_
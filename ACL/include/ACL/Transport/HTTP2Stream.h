@@ -20,6 +20,7 @@
 
 #include <atomic>
 #include <chrono>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -27,9 +28,11 @@
 #include <AVSCommon/AVS/Attachment/AttachmentManager.h>
 #include <AVSCommon/Utils/LibcurlUtils/CurlEasyHandleWrapper.h>
 #include <AVSCommon/AVS/MessageRequest.h>
+#include <AVSCommon/AVS/MessageRequestTimings.h>
 #include <AVSCommon/SDKInterfaces/MessageRequestObserverInterface.h>
+#include <AVSCommon/Utils/Threading/ThreadPool.h>
 
-#include "ACL/Transport/MimeParser.h"
+#include "ACL/Transport/AsyncMimeParser.h"
 #include "ACL/Transport/MessageConsumerInterface.h"
 
 /// Whether or not curl logs should be emitted.
@@ -69,10 +72,12 @@ public:
      *
      * @param messageConsumer The MessageConsumerInterface which should receive messages from AVS.
      * @param attachmentManager The attachment manager.
+     * @param parseThreadPool The pool to parse responses on, or @c nullptr to let the parser pick one.
      */
     HTTP2Stream(
         std::shared_ptr<MessageConsumerInterface> messageConsumer,
-        std::shared_ptr<avsCommon::avs::attachment::AttachmentManager> attachmentManager);
+        std::shared_ptr<avsCommon::avs::attachment::AttachmentManager> attachmentManager,
+        std::shared_ptr<avsCommon::utils::threading::ThreadPool> parseThreadPool = nullptr);
 
     /**
      * Initializes streams that are supposed to POST the given request.
@@ -121,6 +126,20 @@ public:
      */
     long getResponseCode();
 
+    /**
+     * Set how long the request of this stream waited to be sent after it was queued, to be included in its timings.
+     *
+     * @param queueWaitTime How long the request waited in the queue.
+     */
+    void setQueueWaitTime(std::chrono::steady_clock::duration queueWaitTime);
+
+    /**
+     * Get the breakdown of where the time went in the transfer of this stream so far.
+     *
+     * @return The timings of this stream.
+     */
+    avsCommon::avs::MessageRequestTimings getTimings();
+
     /**
      * Notify the current request observer that the transfer is complete with
      * the appropriate SendCompleteStatus code.
@@ -186,6 +205,25 @@ public:
      */
     bool isPaused() const;
 
+    /**
+     * Return whether data received on this stream is still waiting to be parsed.  Until it has been, the directives in
+     * the response may not all have been passed to the @c MessageConsumerInterface.
+     */
+    bool isParsing() const;
+
+    /**
+     * Parse again any response data held back because an attachment's buffer was full.
+     */
+    void resumeParsing();
+
+    /**
+     * Set a function to be called, on the parser's thread, when the data received so far has been parsed.  It is
+     * cleared when the stream is reset.  Set it before checking @c isParsing().
+     *
+     * @param callback The function to call, or @c nullptr for none.
+     */
+    void setParsedCallback(std::function<void()> callback);
+
     /**
      * Set the logical stream ID for this stream.
      *
@@ -236,6 +274,12 @@ private:
     template <typename ParamType>
     bool setopt(CURLoption option, const char* optionName, ParamType param);
 
+    /**
+     * Pass the timings of this stream to the current request, and to the metrics log.  Called before the request is
+     * notified that it has been sent.
+     */
+    void reportTimings();
+
     /**
      * Initialize capturing this streams activities in a log file.
      */
@@ -273,8 +317,8 @@ private:
     unsigned int m_logicalStreamId;
     /// The underlying curl easy handle.
     avsCommon::utils::libcurlUtils::CurlEasyHandleWrapper m_transfer;
-    /// An DirectiveParser instance used to parse multipart MIME messages.
-    MimeParser m_parser;
+    /// Parses multipart MIME messages off the network thread.
+    AsyncMimeParser m_parser;
     /// The current request being sent on this HTTP/2 stream.
     std::shared_ptr<avsCommon::avs::MessageRequest> m_currentRequest;
     /// Whether this stream has any paused transfers.
@@ -288,6 +332,14 @@ private:
     std::atomic<std::chrono::steady_clock::rep> m_progressTimeout;
     /// Last time something was transferred.
     std::atomic<std::chrono::steady_clock::rep> m_timeOfLastTransfer;
+    /// How long the current request waited to be sent after it was queued.
+    std::chrono::steady_clock::duration m_queueWaitTime;
+    /// Whether the upload is paused waiting for data from the attachment of the current request.
+    bool m_isAttachmentReadPaused;
+    /// When the upload last paused waiting for data from the attachment.
+    std::chrono::steady_clock::time_point m_attachmentReadPauseStart;
+    /// The total time the upload has been paused waiting for data from the attachment.
+    std::chrono::steady_clock::duration m_attachmentReadPausedTime;
 };
 
 template <class TickType, class TickPeriod>
@@ -25,6 +25,7 @@
 
 #include <AVSCommon/AVS/Attachment/AttachmentManager.h>
 #include <AVSCommon/AVS/MessageRequest.h>
+#include <AVSCommon/Utils/Threading/ThreadPool.h>
 
 #include "ACL/Transport/HTTP2Stream.h"
 #include "ACL/Transport/MessageConsumerInterface.h"
@@ -97,6 +98,12 @@ private:
     const int m_maxStreams;
     /// The attachment manager.
     std::shared_ptr<avsCommon::avs::attachment::AttachmentManager> m_attachmentManager;
+
+    /**
+     * The pool the responses of all the streams are parsed on.  Parsing stops rather than waits while an attachment's
+     * buffer is full, so a single thread is shared by all of the streams.
+     */
+    std::shared_ptr<avsCommon::utils::threading::ThreadPool> m_parseThreadPool;
     /**
      * A static counter to ensure each newly acquired stream across all pools has a different ID.  The notion of a
      * stream ID is needed to provide a per-HTTP/2-stream context for any given attachment received from AVS.  AVS
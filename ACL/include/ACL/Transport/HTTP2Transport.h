@@ -29,6 +29,7 @@
 #include <string>
 #include <thread>
 #include <utility>
+#include <vector>
 
 #include <AVSCommon/AVS/Attachment/AttachmentManager.h>
 
@@ -155,6 +156,16 @@ private:
      */
     void networkLoop();
 
+    /**
+     * Called by the network loop when @c connect() was called before an auth token was available.  Opens the
+     * connection to AVS with an unauthenticated request, so that the TCP and TLS handshakes overlap the refresh of
+     * the token, then waits for the token and sets up the downchannel stream, which reuses the open connection.  The
+     * wait has no deadline, it only ends early if the transport is disconnected.
+     *
+     * @return Whether the downchannel stream was set up.  If not, the transport is stopping.
+     */
+    bool connectWhileAwaitingAuthorization();
+
     /**
      * Establishes a connection to AVS.
      *
@@ -167,6 +178,37 @@ private:
      */
     void cleanupFinishedStreams();
 
+    /**
+     * Reports the response code of finished event streams whose responses have since been parsed to their observers,
+     * and releases the streams, as well as a finished downchannel.  Parsing of the others is resumed.
+     *
+     * @param force Whether to also report and release the streams whose responses are still being parsed, dropping
+     *     the rest of their responses.
+     */
+    void cleanupParsedStreams(bool force = false);
+
+    /**
+     * Checks whether a finished stream's response is still being parsed.  If so, the network loop is woken once it
+     * has been, to release the stream.
+     *
+     * @param stream The finished stream.
+     * @return Whether the response of the stream is still being parsed.
+     */
+    bool isStillParsing(std::shared_ptr<HTTP2Stream> stream);
+
+    /**
+     * Resumes parsing the responses of the active streams, for any which stopped because an attachment's buffer was
+     * full.  Attachment readers do not signal when they catch up, so this is done on each pass of the network loop.
+     */
+    void resumeParsing();
+
+    /**
+     * Reports the response code of a finished event stream to its observer, and releases the stream.
+     *
+     * @param stream The finished event stream.
+     */
+    void releaseFinishedEventStream(std::shared_ptr<HTTP2Stream> stream);
+
     /**
      * Check for streams that have not progressed within their timeout and remove them.
      */
@@ -179,6 +221,14 @@ private:
      */
     bool canProcessOutgoingMessage();
 
+    /**
+     * Checks whether the network loop has nothing to do until AVS sends something or a request is queued: there are no
+     * event streams in flight, no responses being parsed, no paused streams, and no queued requests.
+     *
+     * @return Whether the network loop is idle.
+     */
+    bool isIdle();
+
     /**
      * Send the next @c MessageRequest if any are queued.
      */
@@ -254,9 +304,10 @@ private:
     /**
      * De-queue a @c MessageRequest from (the front of) the queue of @c MessageRequest instances to process.
      *
+     * @param[out] queueWaitTime How long the returned request waited in the queue.
      * @return The next @c MessageRequest to process (or @c nullptr).
      */
-    std::shared_ptr<avsCommon::avs::MessageRequest> dequeueRequest();
+    std::shared_ptr<avsCommon::avs::MessageRequest> dequeueRequest(std::chrono::steady_clock::duration* queueWaitTime);
 
     /**
      * Clear the queue of @c MessageRequest instances, but first call @c onSendCompleted(NOT_CONNECTED) for any
@@ -342,9 +393,22 @@ private:
     /// The list of streams that either do not have HTTP response headers, or have outstanding response data.
     std::map<CURL*, std::shared_ptr<HTTP2Stream>> m_activeStreams;
 
+    /**
+     * Streams which have finished transferring, but whose responses are still being parsed.  The observers of event
+     * streams are notified once the directives in the responses have been passed on.  This may include
+     * @c m_downchannelStream.
+     */
+    std::vector<std::shared_ptr<HTTP2Stream>> m_parsingStreams;
+
     /// Main thread for this class.
     std::thread m_networkThread;
 
+    /**
+     * Whether the network loop waits for activity without a timeout while it is idle, rather than polling, from the
+     * @c ticklessIdle setting of the @c acl configuration.
+     */
+    bool m_isTicklessIdle;
+
     /// An abstracted HTTP/2 stream pool to ensure that we efficiently and correctly manage our active streams.
     HTTP2StreamPool m_streamPool;
 
@@ -366,8 +430,9 @@ private:
     /// Whether or not the onDisconnected() notification has been sent. Serialized by @c m_mutex.
     bool m_disconnectedSent;
 
-    /// Queue of @c MessageRequest instances to send. Serialized by @c m_mutex.
-    std::deque<std::shared_ptr<avsCommon::avs::MessageRequest>> m_requestQueue;
+    /// Queue of @c MessageRequest instances to send, with the times they were queued. Serialized by @c m_mutex.
+    std::deque<std::pair<std::shared_ptr<avsCommon::avs::MessageRequest>, std::chrono::steady_clock::time_point>>
+        m_requestQueue;
 
     /// Used to wake the main network thread in connection retry back-off situation.
     std::condition_variable m_wakeRetryTrigger;
@@ -0,0 +1,221 @@
+/*
+ * AsyncMimeParser.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+#include "ACL/Transport/AsyncMimeParser.h"
+
+namespace alexaClientSDK {
+namespace acl {
+
+using namespace avsCommon::utils;
+using namespace avsCommon::utils::sds;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("AsyncMimeParser");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The queue holds bytes.
+static const size_t QUEUE_WORD_SIZE = 1;
+
+/// The queue has a single reader.
+static const size_t QUEUE_MAX_READERS = 1;
+
+/// The largest chunk of queued data fed to the parser at once.
+static const size_t MAX_CHUNK_SIZE = 16 * 1024;
+
+constexpr size_t AsyncMimeParser::DEFAULT_QUEUE_SIZE_IN_BYTES;
+
+AsyncMimeParser::AsyncMimeParser(
+    std::shared_ptr<MessageConsumerInterface> messageConsumer,
+    std::shared_ptr<avsCommon::avs::attachment::AttachmentManager> attachmentManager,
+    std::shared_ptr<threading::ThreadPool> threadPool,
+    size_t queueSizeInBytes) :
+        m_queueSizeInBytes{queueSizeInBytes},
+        m_parser{messageConsumer, attachmentManager},
+        m_chunkSize{0},
+        m_numPendingBytes{0},
+        m_isParseScheduled{false},
+        m_hasFailed{false},
+        m_isCancelled{false},
+        m_executor{threadPool} {
+}
+
+AsyncMimeParser::~AsyncMimeParser() {
+    m_isCancelled = true;
+    m_executor.shutdown();
+}
+
+void AsyncMimeParser::reset() {
+    m_isCancelled = true;
+    m_executor.waitForSubmittedTasks();
+    m_isCancelled = false;
+
+    setIdleCallback(nullptr);
+    if (m_queueReader) {
+        m_queueReader->seek(0, InProcessSDS::Reader::Reference::BEFORE_WRITER);
+    }
+    m_chunkSize = 0;
+    m_numPendingBytes = 0;
+    m_isParseScheduled = false;
+    m_hasFailed = false;
+    m_parser.reset();
+}
+
+MimeParser::DataParsedStatus AsyncMimeParser::feed(char* data, size_t length) {
+    if (m_hasFailed) {
+        return MimeParser::DataParsedStatus::ERROR;
+    }
+    if (0 == length) {
+        return MimeParser::DataParsedStatus::OK;
+    }
+    if (!m_queue && !createQueue()) {
+        ACSDK_ERROR(LX("feedFailed").d("reason", "noQueue"));
+        return MimeParser::DataParsedStatus::ERROR;
+    }
+
+    if (length > m_queue->getDataSize()) {
+        // This can never fit in the queue, so parse it here once the queue has drained.
+        if (!isIdle() || m_isParseScheduled) {
+            resume();
+            return MimeParser::DataParsedStatus::INCOMPLETE;
+        }
+        ACSDK_DEBUG9(LX("feedingSynchronously").d("length", length));
+        auto status = m_parser.feed(data, length);
+        if (MimeParser::DataParsedStatus::ERROR == status) {
+            m_hasFailed = true;
+        }
+        return status;
+    }
+
+    // Count the bytes before queueing them, so that parseQueuedData() can't see them before they are counted.
+    m_numPendingBytes += length;
+    auto result = m_queueWriter->write(data, length);
+    if (result != static_cast<ssize_t>(length)) {
+        m_numPendingBytes -= length;
+        if (InProcessSDS::Writer::Error::WOULDBLOCK == result) {
+            // The parser may be waiting for an attachment's buffer rather than still parsing.
+            resume();
+            return MimeParser::DataParsedStatus::INCOMPLETE;
+        }
+        ACSDK_ERROR(LX("feedFailed").d("reason", "writeFailed").d("result", result));
+        return MimeParser::DataParsedStatus::ERROR;
+    }
+
+    if (!m_isParseScheduled.exchange(true)) {
+        m_executor.submit([this]() { parseQueuedData(); });
+    }
+    return MimeParser::DataParsedStatus::OK;
+}
+
+void AsyncMimeParser::resume() {
+    if (!isIdle() && !m_isParseScheduled.exchange(true)) {
+        m_executor.submit([this]() { parseQueuedData(); });
+    }
+}
+
+void AsyncMimeParser::setAttachmentContextId(const std::string& attachmentContextId) {
+    m_parser.setAttachmentContextId(attachmentContextId);
+}
+
+void AsyncMimeParser::setBoundaryString(const std::string& boundaryString) {
+    m_parser.setBoundaryString(boundaryString);
+}
+
+bool AsyncMimeParser::isIdle() const {
+    return 0 == m_numPendingBytes;
+}
+
+void AsyncMimeParser::setIdleCallback(std::function<void()> idleCallback) {
+    std::lock_guard<std::mutex> lock(m_idleCallbackMutex);
+    m_idleCallback = idleCallback;
+}
+
+bool AsyncMimeParser::createQueue() {
+    auto buffer = std::make_shared<InProcessSDS::Buffer>(
+        InProcessSDS::calculateBufferSize(m_queueSizeInBytes, QUEUE_WORD_SIZE, QUEUE_MAX_READERS));
+    m_queue = InProcessSDS::create(buffer, QUEUE_WORD_SIZE, QUEUE_MAX_READERS);
+    if (!m_queue) {
+        ACSDK_ERROR(LX("createQueueFailed").d("queueSizeInBytes", m_queueSizeInBytes));
+        return false;
+    }
+    m_queueWriter = m_queue->createWriter(InProcessSDS::Writer::Policy::ALL_OR_NOTHING);
+    m_queueReader = m_queue->createReader(InProcessSDS::Reader::Policy::NONBLOCKING);
+    if (!m_queueWriter || !m_queueReader) {
+        ACSDK_ERROR(LX("createQueueFailed").d("reason", "createWriterOrReaderFailed"));
+        m_queueWriter.reset();
+        m_queueReader.reset();
+        m_queue.reset();
+        return false;
+    }
+    m_chunk.resize(MAX_CHUNK_SIZE);
+    return true;
+}
+
+void AsyncMimeParser::notifyIdle() {
+    std::lock_guard<std::mutex> lock(m_idleCallbackMutex);
+    if (m_idleCallback) {
+        m_idleCallback();
+    }
+}
+
+void AsyncMimeParser::parseQueuedData() {
+    while (!m_isCancelled) {
+        if (0 == m_chunkSize) {
+            auto result = m_queueReader->read(m_chunk.data(), m_chunk.size());
+            if (result <= 0) {
+                m_isParseScheduled = false;
+                // feed() may have queued more data after the read, and seen that a parse was still scheduled.
+                if (0 != m_numPendingBytes && !m_isParseScheduled.exchange(true)) {
+                    continue;
+                }
+                if (0 == m_numPendingBytes) {
+                    notifyIdle();
+                }
+                return;
+            }
+            m_chunkSize = result;
+        }
+
+        auto status = m_hasFailed ? MimeParser::DataParsedStatus::ERROR : m_parser.feed(m_chunk.data(), m_chunkSize);
+        switch (status) {
+            case MimeParser::DataParsedStatus::INCOMPLETE:
+                // An attachment's buffer is full.  Keep the chunk, and free the thread until feed() or resume().
+                m_isParseScheduled = false;
+                return;
+            case MimeParser::DataParsedStatus::ERROR:
+                if (!m_hasFailed) {
+                    ACSDK_ERROR(LX("parseQueuedDataFailed").d("reason", "parseFailed"));
+                    m_hasFailed = true;
+                }
+                break;
+            case MimeParser::DataParsedStatus::OK:
+                break;
+        }
+        m_numPendingBytes -= m_chunkSize;
+        m_chunkSize = 0;
+    }
+}
+
+}  // namespace acl
+}  // namespace alexaClientSDK
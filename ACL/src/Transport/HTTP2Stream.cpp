@@ -22,6 +22,11 @@
 #include <AVSCommon/Utils/Logger/Logger.h>
 #include <AVSCommon/Utils/Logger/LoggerUtils.h>
 #include <AVSCommon/Utils/Logger/ThreadMoniker.h>
+#include <AVSCommon/Utils/Metrics.h>
+
+#ifdef ACSDK_LATENCY_LOG_ENABLED
+#include <AVSCommon/Utils/JSON/JSONUtils.h>
+#endif
 
 #include "ACL/Transport/HTTP2Stream.h"
 #include "ACL/Transport/HTTP2Transport.h"
@@ -136,6 +141,77 @@ static const char* curlInfoTypeToPrefix(curl_infotype type) {
 
 #endif  // ACSDK_EMIT_CURL_LOGS
 
+/**
+ * Get a time from the info of a curl handle.
+ *
+ * @param handle The curl handle to get the time from.
+ * @param info The time to get, which must be one of the @c CURLINFO_*_TIME values.
+ * @param infoName The name of the time to get (for logging).
+ * @return The time, or zero if it could not be retrieved.
+ */
+static std::chrono::microseconds getCurlTime(CURL* handle, CURLINFO info, const char* infoName) {
+    double seconds = 0;
+    CURLcode ret = curl_easy_getinfo(handle, info, &seconds);
+    if (ret != CURLE_OK) {
+        ACSDK_ERROR(LX("getCurlTimeFailed")
+                        .d("reason", "curlFailure")
+                        .d("method", "curl_easy_getinfo")
+                        .d("info", infoName)
+                        .d("error", curl_easy_strerror(ret)));
+        return std::chrono::microseconds::zero();
+    }
+    return std::chrono::microseconds(static_cast<std::chrono::microseconds::rep>(seconds * 1000000));
+}
+
+/**
+ * Get the number of bytes transferred in one direction from the info of a curl handle.
+ *
+ * @param handle The curl handle to get the size from.
+ * @param isUpload Whether to get the number of bytes uploaded, rather than downloaded.
+ * @return The number of bytes, or zero if it could not be retrieved.
+ */
+static uint64_t getCurlTransferSize(CURL* handle, bool isUpload) {
+#if LIBCURL_VERSION_NUM >= 0x073700
+    curl_off_t size = 0;
+    CURLcode ret = curl_easy_getinfo(handle, isUpload ? CURLINFO_SIZE_UPLOAD_T : CURLINFO_SIZE_DOWNLOAD_T, &size);
+#else
+    double size = 0;
+    CURLcode ret = curl_easy_getinfo(handle, isUpload ? CURLINFO_SIZE_UPLOAD : CURLINFO_SIZE_DOWNLOAD, &size);
+#endif
+    if (ret != CURLE_OK) {
+        ACSDK_ERROR(LX("getCurlTransferSizeFailed")
+                        .d("reason", "curlFailure")
+                        .d("method", "curl_easy_getinfo")
+                        .d("isUpload", isUpload)
+                        .d("error", curl_easy_strerror(ret)));
+        return 0;
+    }
+    return static_cast<uint64_t>(size);
+}
+
+#ifdef ACSDK_LATENCY_LOG_ENABLED
+
+/**
+ * Get the name of the event sent by a @c MessageRequest, to identify it in metrics.
+ *
+ * @param request The request to get the event name of.
+ * @return The name of the event, or an empty string if it could not be found.
+ */
+static std::string getEventName(std::shared_ptr<MessageRequest> request) {
+    rapidjson::Document document;
+    rapidjson::Value::ConstMemberIterator event;
+    rapidjson::Value::ConstMemberIterator header;
+    std::string name;
+    if (request && json::jsonUtils::parseJSON(request->getJsonContent(), &document) &&
+        json::jsonUtils::findNode(document, "event", &event) &&
+        json::jsonUtils::findNode(event->value, "header", &header)) {
+        json::jsonUtils::retrieveValue(header->value, "name", &name);
+    }
+    return name;
+}
+
+#endif  // ACSDK_LATENCY_LOG_ENABLED
+
 /**
  * Get @c std::chrono::steady_clock::now() in a form that can be wrapped in @c atomic.
  *
@@ -147,12 +223,16 @@ static std::chrono::steady_clock::rep getNow() {
 
 HTTP2Stream::HTTP2Stream(
     std::shared_ptr<MessageConsumerInterface> messageConsumer,
-    std::shared_ptr<AttachmentManager> attachmentManager) :
+    std::shared_ptr<AttachmentManager> attachmentManager,
+    std::shared_ptr<avsCommon::utils::threading::ThreadPool> parseThreadPool) :
         m_logicalStreamId{0},
-        m_parser{messageConsumer, attachmentManager},
+        m_parser{messageConsumer, attachmentManager, parseThreadPool},
         m_isPaused{false},
         m_progressTimeout{std::chrono::steady_clock::duration::max().count()},
-        m_timeOfLastTransfer{getNow()} {
+        m_timeOfLastTransfer{getNow()},
+        m_queueWaitTime{std::chrono::steady_clock::duration::zero()},
+        m_isAttachmentReadPaused{false},
+        m_attachmentReadPausedTime{std::chrono::steady_clock::duration::zero()} {
 }
 
 bool HTTP2Stream::reset() {
@@ -166,6 +246,9 @@ bool HTTP2Stream::reset() {
     m_exceptionBeingProcessed.clear();
     m_progressTimeout = std::chrono::steady_clock::duration::max().count();
     m_timeOfLastTransfer = getNow();
+    m_queueWaitTime = std::chrono::steady_clock::duration::zero();
+    m_isAttachmentReadPaused = false;
+    m_attachmentReadPausedTime = std::chrono::steady_clock::duration::zero();
     return true;
 }
 
@@ -359,6 +442,10 @@ size_t HTTP2Stream::readCallback(char* data, size_t size, size_t nmemb, void* us
     HTTP2Stream* stream = static_cast<HTTP2Stream*>(userData);
 
     stream->m_timeOfLastTransfer = getNow();
+    if (stream->m_isAttachmentReadPaused) {
+        stream->m_attachmentReadPausedTime += std::chrono::steady_clock::now() - stream->m_attachmentReadPauseStart;
+        stream->m_isAttachmentReadPaused = false;
+    }
     auto attachmentReader = stream->m_currentRequest->getAttachmentReader();
 
     // This is ok - it means there's no attachment to send.  Return 0 so libcurl can complete the stream to AVS.
@@ -391,6 +478,8 @@ size_t HTTP2Stream::readCallback(char* data, size_t size, size_t nmemb, void* us
     // The attachment has no more data right now, but is still readable.
     if (0 == bytesRead) {
         stream->m_isPaused = true;
+        stream->m_isAttachmentReadPaused = true;
+        stream->m_attachmentReadPauseStart = std::chrono::steady_clock::now();
         return CURL_READFUNC_PAUSE;
     }
 
@@ -415,7 +504,43 @@ CURL* HTTP2Stream::getCurlHandle() {
     return m_transfer.getCurlHandle();
 }
 
+void HTTP2Stream::setQueueWaitTime(std::chrono::steady_clock::duration queueWaitTime) {
+    m_queueWaitTime = queueWaitTime;
+}
+
+MessageRequestTimings HTTP2Stream::getTimings() {
+    auto handle = m_transfer.getCurlHandle();
+    MessageRequestTimings timings;
+    timings.queueWait = std::chrono::duration_cast<std::chrono::microseconds>(m_queueWaitTime);
+    timings.nameLookup = getCurlTime(handle, CURLINFO_NAMELOOKUP_TIME, "CURLINFO_NAMELOOKUP_TIME");
+    timings.connect = getCurlTime(handle, CURLINFO_CONNECT_TIME, "CURLINFO_CONNECT_TIME");
+    timings.appConnect = getCurlTime(handle, CURLINFO_APPCONNECT_TIME, "CURLINFO_APPCONNECT_TIME");
+    timings.startTransfer = getCurlTime(handle, CURLINFO_STARTTRANSFER_TIME, "CURLINFO_STARTTRANSFER_TIME");
+    timings.total = getCurlTime(handle, CURLINFO_TOTAL_TIME, "CURLINFO_TOTAL_TIME");
+    auto attachmentReadPausedTime = m_attachmentReadPausedTime;
+    if (m_isAttachmentReadPaused) {
+        attachmentReadPausedTime += std::chrono::steady_clock::now() - m_attachmentReadPauseStart;
+    }
+    timings.attachmentReadPaused = std::chrono::duration_cast<std::chrono::microseconds>(attachmentReadPausedTime);
+    timings.bytesUploaded = getCurlTransferSize(handle, true);
+    timings.bytesDownloaded = getCurlTransferSize(handle, false);
+    return timings;
+}
+
+void HTTP2Stream::reportTimings() {
+    auto timings = getTimings();
+    m_currentRequest->setTimings(timings);
+    ACSDK_METRIC_TIMINGS(
+        TAG, getEventName(m_currentRequest), timings, avsCommon::utils::Metrics::Location::ACL_SEND_COMPLETE);
+    ACSDK_DEBUG9(LX("reportTimings")
+                     .d("streamId", m_logicalStreamId)
+                     .d("queueWaitUs", timings.queueWait.count())
+                     .d("startTransferUs", timings.startTransfer.count())
+                     .d("totalUs", timings.total.count()));
+}
+
 void HTTP2Stream::notifyRequestObserver() {
+    reportTimings();
     if (m_exceptionBeingProcessed.length() > 0) {
         m_currentRequest->exceptionReceived(m_exceptionBeingProcessed);
         m_exceptionBeingProcessed = "";
@@ -450,6 +575,7 @@ void HTTP2Stream::notifyRequestObserver() {
 }
 
 void HTTP2Stream::notifyRequestObserver(avsCommon::sdkInterfaces::MessageRequestObserverInterface::Status status) {
+    reportTimings();
     m_currentRequest->sendCompleted(status);
 }
 
@@ -475,6 +601,18 @@ bool HTTP2Stream::isPaused() const {
     return m_isPaused;
 }
 
+bool HTTP2Stream::isParsing() const {
+    return !m_parser.isIdle();
+}
+
+void HTTP2Stream::resumeParsing() {
+    m_parser.resume();
+}
+
+void HTTP2Stream::setParsedCallback(std::function<void()> callback) {
+    m_parser.setIdleCallback(callback);
+}
+
 void HTTP2Stream::setLogicalStreamId(int logicalStreamId) {
     m_logicalStreamId = logicalStreamId;
     m_parser.setAttachmentContextId(STREAM_CONTEXT_ID_PREFIX_STRING + std::to_string(m_logicalStreamId));
@@ -32,6 +32,9 @@ static const std::string TAG("HTTP2StreamPool");
 
 using namespace avsCommon::utils;
 
+/// The number of threads parsing the responses of the streams of a pool.
+static const size_t NUM_PARSE_THREADS = 1;
+
 unsigned int HTTP2StreamPool::m_nextStreamId = 1;
 
 HTTP2StreamPool::HTTP2StreamPool(
@@ -39,7 +42,8 @@ HTTP2StreamPool::HTTP2StreamPool(
     std::shared_ptr<avsCommon::avs::attachment::AttachmentManager> attachmentManager) :
         m_numAcquiredStreams{0},
         m_maxStreams{maxStreams},
-        m_attachmentManager{attachmentManager} {
+        m_attachmentManager{attachmentManager},
+        m_parseThreadPool{threading::ThreadPool::create(NUM_PARSE_THREADS)} {
 }
 
 std::shared_ptr<HTTP2Stream> HTTP2StreamPool::createGetStream(
@@ -96,7 +100,7 @@ std::shared_ptr<HTTP2Stream> HTTP2StreamPool::getStream(std::shared_ptr<MessageC
 
     std::shared_ptr<HTTP2Stream> result;
     if (m_pool.empty()) {
-        result = std::make_shared<HTTP2Stream>(messageConsumer, m_attachmentManager);
+        result = std::make_shared<HTTP2Stream>(messageConsumer, m_attachmentManager, m_parseThreadPool);
     } else {
         result = m_pool.back();
         m_pool.pop_back();
@@ -15,12 +15,15 @@
  * permissions and limitations under the License.
  */
 
+#include <algorithm>
 #include <chrono>
 #include <functional>
 #include <random>
 
 #include <AVSCommon/Utils/Configuration/ConfigurationNode.h>
+#include <AVSCommon/Utils/LibcurlUtils/CurlEasyHandleWrapper.h>
 #include <AVSCommon/Utils/Logger/Logger.h>
+#include <AVSCommon/Utils/Threading/ThreadName.h>
 #include <AVSCommon/Utils/Timing/TimeUtils.h>
 
 #include "ACL/Transport/HTTP2Transport.h"
@@ -73,6 +76,8 @@ static const std::chrono::seconds STREAM_PROGRESS_TIMEOUT = std::chrono::seconds
 static const std::string ACL_CONFIG_KEY = "acl";
 /// Key for the 'endpoint' value under the @c ACL_CONFIG_KEY configuration node.
 static const std::string ENDPOINT_KEY = "endpoint";
+/// Key for the 'ticklessIdle' value under the @c ACL_CONFIG_KEY configuration node.
+static const std::string TICKLESS_IDLE_KEY = "ticklessIdle";
 
 #ifdef ACSDK_OPENSSL_MIN_VER_REQUIRED
 /**
@@ -171,6 +176,7 @@ HTTP2Transport::HTTP2Transport(
         m_messageConsumer{messageConsumerInterface},
         m_authDelegate{authDelegate},
         m_avsEndpoint{avsEndpoint},
+        m_isTicklessIdle{false},
         m_streamPool{MAX_STREAMS, attachmentManager},
         m_disconnectReason{ConnectionStatusObserverInterface::ChangedReason::INTERNAL_ERROR},
         m_isNetworkThreadRunning{false},
@@ -182,9 +188,14 @@ HTTP2Transport::HTTP2Transport(
 
     printCurlDiagnostics();
 
+    auto aclConfig = alexaClientSDK::avsCommon::utils::configuration::ConfigurationNode::getRoot()[ACL_CONFIG_KEY];
     if (m_avsEndpoint.empty()) {
-        alexaClientSDK::avsCommon::utils::configuration::ConfigurationNode::getRoot()[ACL_CONFIG_KEY].getString(
-            ENDPOINT_KEY, &m_avsEndpoint, DEFAULT_AVS_ENDPOINT);
+        aclConfig.getString(ENDPOINT_KEY, &m_avsEndpoint, DEFAULT_AVS_ENDPOINT);
+    }
+    aclConfig.getBool(TICKLESS_IDLE_KEY, &m_isTicklessIdle, false);
+    if (m_isTicklessIdle && !avsCommon::utils::libcurlUtils::CurlMultiHandleWrapper::isWakeupSupported()) {
+        ACSDK_WARN(LX("ticklessIdleDisabled").d("reason", "curlMultiWakeupUnsupported"));
+        m_isTicklessIdle = false;
     }
 }
 
@@ -226,12 +237,15 @@ bool HTTP2Transport::connect() {
         return false;
     }
 
-    ConnectionStatusObserverInterface::ChangedReason reason =
-        ConnectionStatusObserverInterface::ChangedReason::INTERNAL_ERROR;
-    if (!setupDownchannelStream(&reason)) {
-        m_multi.reset();
-        ACSDK_ERROR(LX("connectFailed").d("reason", "setupDownchannelStreamFailed").d("error", reason));
-        return false;
+    // Without an auth token yet, the network thread opens the connection while it waits for one.
+    if (!m_authDelegate->getAuthToken().empty()) {
+        ConnectionStatusObserverInterface::ChangedReason reason =
+            ConnectionStatusObserverInterface::ChangedReason::INTERNAL_ERROR;
+        if (!setupDownchannelStream(&reason)) {
+            m_multi.reset();
+            ACSDK_ERROR(LX("connectFailed").d("reason", "setupDownchannelStreamFailed").d("error", reason));
+            return false;
+        }
     }
 
     /*
@@ -340,8 +354,10 @@ bool HTTP2Transport::setupDownchannelStream(ConnectionStatusObserverInterface::C
 }
 
 void HTTP2Transport::networkLoop() {
+    avsCommon::utils::threading::setThreadName("HTTP2Transport");
     int retryCount = 0;
-    while (!establishConnection() && !isStopping()) {
+    bool isDownchannelSetUp = m_downchannelStream || connectWhileAwaitingAuthorization();
+    while (isDownchannelSetUp && !establishConnection() && !isStopping()) {
         std::chrono::milliseconds retryBackoff = TransportDefines::RETRY_TIMER.calculateTimeToRetry(retryCount);
         ACSDK_ERROR(LX("networkLoopRetryingToConnect")
                         .d("reason", "establishConnectionFailed")
@@ -359,7 +375,7 @@ void HTTP2Transport::networkLoop() {
      */
     int numTransfersLeft = 1;
     auto inactivityTimerStart = std::chrono::steady_clock::now();
-    while (numTransfersLeft && !isStopping()) {
+    while ((numTransfersLeft || !m_parsingStreams.empty()) && !isStopping()) {
         auto result = m_multi->perform(&numTransfersLeft);
         if (CURLM_CALL_MULTI_PERFORM == result) {
             continue;
@@ -370,6 +386,8 @@ void HTTP2Transport::networkLoop() {
         }
 
         cleanupFinishedStreams();
+        cleanupParsedStreams();
+        resumeParsing();
         cleanupStalledStreams();
         if (isStopping()) {
             break;
@@ -398,6 +416,11 @@ void HTTP2Transport::networkLoop() {
         if (paused) {
             multiWaitTimeout = WAIT_FOR_ACTIVITY_WHILE_STREAMS_PAUSED_TIMEOUT;
             before = std::chrono::steady_clock::now();
+        } else if (m_isTicklessIdle && isIdle()) {
+            // Only activity, a queued request, or stopping (which all wake m_multi) can end the wait before the ping.
+            auto untilPing = std::chrono::duration_cast<std::chrono::milliseconds>(
+                INACTIVITY_TIMEOUT - (std::chrono::steady_clock::now() - inactivityTimerStart));
+            multiWaitTimeout = std::max(std::chrono::milliseconds::zero(), untilPing + std::chrono::milliseconds(1));
         }
 
         // TODO: ACSDK-69 replace timeout with signal fd
@@ -456,10 +479,15 @@ void HTTP2Transport::networkLoop() {
     // Catch-all. Reaching this point implies stopping.
     setIsStopping(ConnectionStatusObserverInterface::ChangedReason::INTERNAL_ERROR);
 
+    cleanupParsedStreams(true);
     releaseAllEventStreams();
     releasePingStream();
     releaseDownchannelStream();
-    m_multi.reset();
+    {
+        // setIsStoppingLocked() may be waking m_multi.
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_multi.reset();
+    }
     clearQueuedRequests();
     setIsConnectedFalse();
 
@@ -469,6 +497,68 @@ void HTTP2Transport::networkLoop() {
     }
 }
 
+bool HTTP2Transport::connectWhileAwaitingAuthorization() {
+    ACSDK_INFO(LX("connectWhileAwaitingAuthorization"));
+    avsCommon::utils::libcurlUtils::CurlEasyHandleWrapper warmUp;
+    bool isWarmingUp = warmUp.setURL(m_avsEndpoint + AVS_PING_URL_PATH_EXTENSION) &&
+                       warmUp.setConnectionTimeout(ESTABLISH_CONNECTION_TIMEOUT) &&
+                       CURLE_OK == curl_easy_setopt(warmUp.getCurlHandle(), CURLOPT_NOBODY, 1L) &&
+                       CURLM_OK == m_multi->addHandle(warmUp.getCurlHandle());
+    if (!isWarmingUp) {
+        ACSDK_WARN(LX("connectionWarmUpFailed").d("reason", "addWarmUpRequestFailed"));
+    }
+
+    // Wait for the token for as long as it takes.  Giving up would disconnect a transport that is still pending, and
+    // MessageRouter only replaces transports which were connected.
+    while (!isStopping()) {
+        if (isWarmingUp) {
+            int numTransfersLeft = 0;
+            auto result = m_multi->perform(&numTransfersLeft);
+            if (CURLM_CALL_MULTI_PERFORM == result) {
+                continue;
+            }
+            int messagesLeft = 0;
+            auto message = m_multi->infoRead(&messagesLeft);
+            if (CURLM_OK != result || (message && CURLMSG_DONE == message->msg)) {
+                // Whatever the response, the connection it opened stays in the multi handle's connection cache.
+                ACSDK_DEBUG(LX("connectionWarmUpFinished")
+                                .d("result", message ? curl_easy_strerror(message->data.result) : "performFailed"));
+                m_multi->removeHandle(warmUp.getCurlHandle());
+                isWarmingUp = false;
+            }
+        }
+        // Add the downchannel once the warm up is done, so that it doesn't race it with a second connection.
+        if (!isWarmingUp && !m_authDelegate->getAuthToken().empty()) {
+            break;
+        }
+        if (isWarmingUp) {
+            int numTransfersUpdated = 0;
+            m_multi->wait(WAIT_FOR_ACTIVITY_WHILE_STREAMS_PAUSED_TIMEOUT, &numTransfersUpdated);
+        } else {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wakeRetryTrigger.wait_for(
+                lock, WAIT_FOR_ACTIVITY_WHILE_STREAMS_PAUSED_TIMEOUT, [this] { return m_isStopping; });
+        }
+    }
+    if (isWarmingUp) {
+        m_multi->removeHandle(warmUp.getCurlHandle());
+    }
+    if (isStopping()) {
+        return false;
+    }
+
+    ConnectionStatusObserverInterface::ChangedReason reason =
+        ConnectionStatusObserverInterface::ChangedReason::INTERNAL_ERROR;
+    if (!setupDownchannelStream(&reason)) {
+        ACSDK_ERROR(LX("connectWhileAwaitingAuthorizationFailed")
+                        .d("reason", "setupDownchannelStreamFailed")
+                        .d("error", reason));
+        setIsStopping(reason);
+        return false;
+    }
+    return true;
+}
+
 bool HTTP2Transport::establishConnection() {
     // Set numTransferLeft to 1 because the downchannel stream has been added already.
     int numTransfersLeft = 1;
@@ -482,7 +572,7 @@ bool HTTP2Transport::establishConnection() {
      * receiving a response code (numTransfersLeft == 0), then set up a new down channel stream in preparation
      * for being called again to retry establishing a connection.
      */
-    while (numTransfersLeft && !isStopping()) {
+    while ((numTransfersLeft || !m_parsingStreams.empty()) && !isStopping()) {
         auto result = m_multi->perform(&numTransfersLeft);
         // curl asked us to call multiperform again immediately
         if (CURLM_CALL_MULTI_PERFORM == result) {
@@ -511,8 +601,13 @@ bool HTTP2Transport::establishConnection() {
             setIsStopping(ConnectionStatusObserverInterface::ChangedReason::INTERNAL_ERROR);
         }
         // wait for activity on the downchannel stream, kinda like poll()
+        // Without polling, curl's own connection timeout (or stopping) still ends the wait if AVS never responds.
+        std::chrono::milliseconds waitTimeout = WAIT_FOR_ACTIVITY_TIMEOUT;
+        if (m_isTicklessIdle) {
+            waitTimeout = ESTABLISH_CONNECTION_TIMEOUT;
+        }
         int numTransfersUpdated = 0;
-        result = m_multi->wait(WAIT_FOR_ACTIVITY_TIMEOUT, &numTransfersUpdated);
+        result = m_multi->wait(waitTimeout, &numTransfersUpdated);
         if (result != CURLM_OK) {
             ACSDK_ERROR(
                 LX("establishConnectionFailed").d("reason", "waitFailed").d("error", curl_multi_strerror(result)));
@@ -539,7 +634,14 @@ void HTTP2Transport::cleanupFinishedStreams() {
                 if (!isStopping()) {
                     notifyObserversOnServerSideDisconnect();
                 }
-                releaseDownchannelStream();
+                if (isStillParsing(m_downchannelStream)) {
+                    // Keep the downchannel until the directives at the end of it have been passed on.
+                    ACSDK_DEBUG9(LX("cleanupFinishedDownchannelDeferred"));
+                    m_activeStreams.erase(message->easy_handle);
+                    m_parsingStreams.push_back(m_downchannelStream);
+                } else {
+                    releaseDownchannelStream();
+                }
                 continue;
             }
 
@@ -550,11 +652,15 @@ void HTTP2Transport::cleanupFinishedStreams() {
 
             auto it = m_activeStreams.find(message->easy_handle);
             if (it != m_activeStreams.end()) {
-                it->second->notifyRequestObserver();
-                ACSDK_DEBUG0(LX("cleanupFinishedStream")
-                                 .d("streamId", it->second->getLogicalStreamId())
-                                 .d("result", it->second->getResponseCode()));
-                releaseEventStream(it->second);
+                auto stream = it->second;
+                if (isStillParsing(stream)) {
+                    // Hold the stream until the directives in its response have been passed on.
+                    ACSDK_DEBUG9(LX("cleanupFinishedStreamDeferred").d("streamId", stream->getLogicalStreamId()));
+                    m_activeStreams.erase(it);
+                    m_parsingStreams.push_back(stream);
+                } else {
+                    releaseFinishedEventStream(stream);
+                }
             } else {
                 ACSDK_ERROR(
                     LX("cleanupFinishedStreamError").d("reason", "streamNotFound").d("handle", message->easy_handle));
@@ -563,6 +669,50 @@ void HTTP2Transport::cleanupFinishedStreams() {
     } while (message);
 }
 
+void HTTP2Transport::cleanupParsedStreams(bool force) {
+    auto it = m_parsingStreams.begin();
+    while (it != m_parsingStreams.end()) {
+        auto stream = *it;
+        if (!force && stream->isParsing()) {
+            stream->resumeParsing();
+            ++it;
+            continue;
+        }
+        it = m_parsingStreams.erase(it);
+        if (stream == m_downchannelStream) {
+            releaseDownchannelStream();
+        } else {
+            releaseFinishedEventStream(stream);
+        }
+    }
+}
+
+bool HTTP2Transport::isStillParsing(std::shared_ptr<HTTP2Stream> stream) {
+    // Set the callback first, so that the parser can't finish unnoticed between the two calls.
+    stream->setParsedCallback([this]() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_multi) {
+            // Release the stream now, rather than when the network loop's wait for activity times out.
+            m_multi->wakeup();
+        }
+    });
+    return stream->isParsing();
+}
+
+void HTTP2Transport::resumeParsing() {
+    for (auto entry : m_activeStreams) {
+        entry.second->resumeParsing();
+    }
+}
+
+void HTTP2Transport::releaseFinishedEventStream(std::shared_ptr<HTTP2Stream> stream) {
+    stream->notifyRequestObserver();
+    ACSDK_DEBUG0(LX("cleanupFinishedStream")
+                     .d("streamId", stream->getLogicalStreamId())
+                     .d("result", stream->getResponseCode()));
+    releaseEventStream(stream);
+}
+
 void HTTP2Transport::cleanupStalledStreams() {
     auto it = m_activeStreams.begin();
     while (it != m_activeStreams.end()) {
@@ -587,8 +737,22 @@ bool HTTP2Transport::canProcessOutgoingMessage() {
     return true;
 }
 
+bool HTTP2Transport::isIdle() {
+    if (!m_parsingStreams.empty()) {
+        return false;
+    }
+    for (auto entry : m_activeStreams) {
+        if (isEventStream(entry.second) || entry.second->isPaused() || entry.second->isParsing()) {
+            return false;
+        }
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_requestQueue.empty();
+}
+
 void HTTP2Transport::processNextOutgoingMessage() {
-    auto request = dequeueRequest();
+    auto queueWaitTime = std::chrono::steady_clock::duration::zero();
+    auto request = dequeueRequest(&queueWaitTime);
     if (!request) {
         return;
     }
@@ -605,6 +769,7 @@ void HTTP2Transport::processNextOutgoingMessage() {
     std::shared_ptr<HTTP2Stream> stream = m_streamPool.createPostStream(url, authToken, request, m_messageConsumer);
     // note : if the stream is nullptr, the stream pool already called sendCompleted on the MessageRequest.
     if (stream) {
+        stream->setQueueWaitTime(queueWaitTime);
         stream->setProgressTimeout(STREAM_PROGRESS_TIMEOUT);
         auto result = m_multi->addHandle(stream->getCurlHandle());
         if (result != CURLM_OK) {
@@ -688,6 +853,10 @@ void HTTP2Transport::setIsStoppingLocked(ConnectionStatusObserverInterface::Chan
     m_disconnectReason = reason;
     m_isStopping = true;
     m_wakeRetryTrigger.notify_one();
+    if (m_multi) {
+        // Stop the network loop now, rather than when its wait for activity times out.
+        m_multi->wakeup();
+    }
 }
 
 bool HTTP2Transport::isStopping() {
@@ -736,7 +905,11 @@ bool HTTP2Transport::enqueueRequest(std::shared_ptr<MessageRequest> request, boo
     if (!m_isStopping) {
         if (ignoreConnectState || m_isConnected) {
             ACSDK_DEBUG9(LX("enqueueRequest").sensitive("jsonContent", request->getJsonContent()));
-            m_requestQueue.push_back(request);
+            m_requestQueue.push_back(std::make_pair(request, std::chrono::steady_clock::now()));
+            if (m_multi) {
+                // The network loop may be waiting for activity without a timeout.
+                m_multi->wakeup();
+            }
             return true;
         } else {
             ACSDK_ERROR(LX("enqueueRequestFailed").d("reason", "isNotConnected"));
@@ -747,20 +920,23 @@ bool HTTP2Transport::enqueueRequest(std::shared_ptr<MessageRequest> request, boo
     return false;
 }
 
-std::shared_ptr<MessageRequest> HTTP2Transport::dequeueRequest() {
+std::shared_ptr<MessageRequest> HTTP2Transport::dequeueRequest(std::chrono::steady_clock::duration* queueWaitTime) {
     std::lock_guard<std::mutex> lock(m_mutex);
     if (m_isStopping || m_requestQueue.empty()) {
         return nullptr;
     }
     auto result = m_requestQueue.front();
     m_requestQueue.pop_front();
-    return result;
+    if (queueWaitTime) {
+        *queueWaitTime = std::chrono::steady_clock::now() - result.second;
+    }
+    return result.first;
 }
 
 void HTTP2Transport::clearQueuedRequests() {
     std::lock_guard<std::mutex> lock(m_mutex);
-    for (auto request : m_requestQueue) {
-        request->sendCompleted(MessageRequestObserverInterface::Status::NOT_CONNECTED);
+    for (auto entry : m_requestQueue) {
+        entry.first->sendCompleted(MessageRequestObserverInterface::Status::NOT_CONNECTED);
     }
     m_requestQueue.clear();
 }
@@ -0,0 +1,427 @@
+/*
+ * AsyncMimeParserTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file AsyncMimeParserTest.cpp
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <ACL/Transport/AsyncMimeParser.h>
+
+#include "Common/Common.h"
+#include "Common/MimeUtils.h"
+#include "Common/TestableAttachmentManager.h"
+#include "Common/TestableMessageObserver.h"
+#include "TestableConsumer.h"
+
+namespace alexaClientSDK {
+namespace acl {
+namespace test {
+
+using namespace avsCommon::avs::attachment;
+using namespace avsCommon::sdkInterfaces;
+
+/// The size of the data for directives and attachments.
+static const int TEST_DATA_SIZE = 100;
+/// The number of directives and of attachments in a burst.
+static const int TEST_BURST_SIZE = 20;
+/// The number of bytes fed at once, as if received from the network.
+static const size_t TEST_FEED_SIZE = 97;
+/// A queue size which holds a few feeds.
+static const size_t SMALL_QUEUE_SIZE = TEST_FEED_SIZE * 3;
+/// A test context id.
+static const std::string TEST_CONTEXT_ID = "TEST_CONTEXT_ID";
+/// A test boundary string, copied from a real interaction with AVS.
+static const std::string MIME_TEST_BOUNDARY_STRING = "84109348-943b-4446-85e6-e73eda9fac43";
+/// How long to wait for something which should happen.
+static const std::chrono::seconds TIMEOUT(5);
+/// How often to check whether something has happened yet.
+static const std::chrono::milliseconds POLL_INTERVAL(1);
+
+/**
+ * A @c MessageObserverInterface which holds up the thread delivering a message until it is opened, as a slow
+ * directive consumer would.
+ */
+class GatedMessageObserver : public MessageObserverInterface {
+public:
+    /**
+     * Constructor.
+     *
+     * @param observer The observer to pass messages on to once opened.
+     */
+    GatedMessageObserver(std::shared_ptr<MessageObserverInterface> observer) : m_observer{observer}, m_isOpen{false} {
+    }
+
+    void receive(const std::string& contextId, const std::string& message) override {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_wakeTrigger.wait(lock, [this] { return m_isOpen; });
+        lock.unlock();
+        m_observer->receive(contextId, message);
+    }
+
+    /// Let messages through.
+    void open() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isOpen = true;
+        m_wakeTrigger.notify_all();
+    }
+
+private:
+    /// The observer to pass messages on to.
+    std::shared_ptr<MessageObserverInterface> m_observer;
+    /// Mutex serializing access to @c m_isOpen.
+    std::mutex m_mutex;
+    /// Notified when @c m_isOpen changes.
+    std::condition_variable m_wakeTrigger;
+    /// Whether messages are let through.
+    bool m_isOpen;
+};
+
+/// Test harness for @c AsyncMimeParser.
+class AsyncMimeParserTest : public ::testing::Test {
+public:
+    /// Set up the test harness for running a test.
+    void SetUp() override;
+
+    /// Make sure the parser has stopped before the objects it uses are destroyed.
+    void TearDown() override;
+
+protected:
+    /**
+     * Create @c m_parser.
+     *
+     * @param queueSize The size of the queue of the parser.
+     */
+    void createParser(size_t queueSize = AsyncMimeParser::DEFAULT_QUEUE_SIZE_IN_BYTES);
+
+    /**
+     * Add a burst of directives and attachments to @c m_mimeParts.
+     */
+    void addBurst();
+
+    /**
+     * Feed data to @c m_parser in small pieces, feeding each piece again until it is accepted.
+     *
+     * @param data The data to feed.
+     * @return Whether all of the data was accepted before @c TIMEOUT.
+     */
+    bool feedParser(const std::string& data);
+
+    /**
+     * Wait for @c m_parser to finish parsing the data fed to it, resuming it while an attachment's buffer is full.
+     *
+     * @return Whether the parser became idle before @c TIMEOUT.
+     */
+    bool waitUntilIdle();
+
+    /**
+     * Check that each part in @c m_mimeParts was received at its destination.
+     */
+    void validateMimePartsParsedOk();
+
+    /// The parts of the MIME string to parse.
+    std::vector<std::shared_ptr<TestMimePart>> m_mimeParts;
+    /// The attachment manager the parser writes attachments to.
+    std::shared_ptr<AttachmentManager> m_attachmentManager;
+    /// The observer which receives the directives.
+    std::shared_ptr<TestableMessageObserver> m_testableMessageObserver;
+    /// Holds up directive delivery until opened.
+    std::shared_ptr<GatedMessageObserver> m_gate;
+    /// The consumer which passes directives to @c m_gate.
+    std::shared_ptr<TestableConsumer> m_testableConsumer;
+    /// The parser under test.
+    std::unique_ptr<AsyncMimeParser> m_parser;
+};
+
+void AsyncMimeParserTest::SetUp() {
+    m_attachmentManager = std::make_shared<AttachmentManager>(AttachmentManager::AttachmentType::IN_PROCESS);
+    m_testableMessageObserver = std::make_shared<TestableMessageObserver>();
+    m_gate = std::make_shared<GatedMessageObserver>(m_testableMessageObserver);
+    m_testableConsumer = std::make_shared<TestableConsumer>();
+    m_testableConsumer->setMessageObserver(m_gate);
+}
+
+void AsyncMimeParserTest::TearDown() {
+    m_gate->open();
+    m_parser.reset();
+}
+
+void AsyncMimeParserTest::createParser(size_t queueSize) {
+    m_parser.reset(new AsyncMimeParser(m_testableConsumer, m_attachmentManager, nullptr, queueSize));
+    m_parser->setAttachmentContextId(TEST_CONTEXT_ID);
+    m_parser->setBoundaryString(MIME_TEST_BOUNDARY_STRING);
+}
+
+void AsyncMimeParserTest::addBurst() {
+    for (int i = 0; i < TEST_BURST_SIZE; ++i) {
+        m_mimeParts.push_back(
+            std::make_shared<TestMimeJsonPart>(MIME_TEST_BOUNDARY_STRING, TEST_DATA_SIZE, m_testableMessageObserver));
+        m_mimeParts.push_back(std::make_shared<TestMimeAttachmentPart>(
+            MIME_TEST_BOUNDARY_STRING,
+            TEST_CONTEXT_ID,
+            "TEST_CONTENT_ID_" + std::to_string(i),
+            TEST_DATA_SIZE,
+            m_attachmentManager));
+    }
+}
+
+bool AsyncMimeParserTest::feedParser(const std::string& data) {
+    auto deadline = std::chrono::steady_clock::now() + TIMEOUT;
+    size_t numberBytesFed = 0;
+    while (numberBytesFed < data.length()) {
+        auto bytesToFeed = std::min(TEST_FEED_SIZE, data.length() - numberBytesFed);
+        auto status = m_parser->feed(const_cast<char*>(&data[numberBytesFed]), bytesToFeed);
+        if (MimeParser::DataParsedStatus::OK == status) {
+            numberBytesFed += bytesToFeed;
+        } else if (MimeParser::DataParsedStatus::ERROR == status || std::chrono::steady_clock::now() > deadline) {
+            return false;
+        } else {
+            std::this_thread::sleep_for(POLL_INTERVAL);
+        }
+    }
+    return true;
+}
+
+bool AsyncMimeParserTest::waitUntilIdle() {
+    auto deadline = std::chrono::steady_clock::now() + TIMEOUT;
+    while (!m_parser->isIdle()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(POLL_INTERVAL);
+        // As HTTP2Transport does on each pass of its network loop.
+        m_parser->resume();
+    }
+    return true;
+}
+
+void AsyncMimeParserTest::validateMimePartsParsedOk() {
+    for (auto mimePart : m_mimeParts) {
+        ASSERT_TRUE(mimePart->validateMimeParsing());
+    }
+}
+
+/**
+ * Verify that a burst of directives and attachments is parsed in full.
+ */
+TEST_F(AsyncMimeParserTest, burstIsParsed) {
+    createParser();
+    m_gate->open();
+    addBurst();
+    ASSERT_TRUE(feedParser(constructTestMimeString(m_mimeParts, MIME_TEST_BOUNDARY_STRING)));
+    ASSERT_TRUE(waitUntilIdle());
+    validateMimePartsParsedOk();
+}
+
+/**
+ * Verify that data is fed to the parser again, rather than dropped, while an attachment's buffer is full.
+ */
+TEST_F(AsyncMimeParserTest, fullAttachmentBufferIsRetried) {
+    m_attachmentManager = std::make_shared<TestableAttachmentManager>();
+    createParser();
+    m_gate->open();
+    m_mimeParts.push_back(
+        std::make_shared<TestMimeJsonPart>(MIME_TEST_BOUNDARY_STRING, TEST_DATA_SIZE, m_testableMessageObserver));
+    m_mimeParts.push_back(std::make_shared<TestMimeAttachmentPart>(
+        MIME_TEST_BOUNDARY_STRING, TEST_CONTEXT_ID, "TEST_CONTENT_ID", TEST_DATA_SIZE, m_attachmentManager));
+    m_mimeParts.push_back(
+        std::make_shared<TestMimeJsonPart>(MIME_TEST_BOUNDARY_STRING, TEST_DATA_SIZE, m_testableMessageObserver));
+    ASSERT_TRUE(feedParser(constructTestMimeString(m_mimeParts, MIME_TEST_BOUNDARY_STRING)));
+    ASSERT_TRUE(waitUntilIdle());
+    validateMimePartsParsedOk();
+}
+
+/**
+ * Verify that feeding data does not wait for the directives in it to be consumed, and that the parser is not idle
+ * until they have been.
+ */
+TEST_F(AsyncMimeParserTest, feedDoesNotWaitForConsumer) {
+    createParser();
+    m_mimeParts.push_back(
+        std::make_shared<TestMimeJsonPart>(MIME_TEST_BOUNDARY_STRING, TEST_DATA_SIZE, m_testableMessageObserver));
+    m_mimeParts.push_back(
+        std::make_shared<TestMimeJsonPart>(MIME_TEST_BOUNDARY_STRING, TEST_DATA_SIZE, m_testableMessageObserver));
+    auto mimeString = constructTestMimeString(m_mimeParts, MIME_TEST_BOUNDARY_STRING);
+
+    ASSERT_EQ(
+        m_parser->feed(const_cast<char*>(mimeString.data()), mimeString.length()), MimeParser::DataParsedStatus::OK);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(m_parser->isIdle());
+
+    m_gate->open();
+    ASSERT_TRUE(waitUntilIdle());
+    validateMimePartsParsedOk();
+}
+
+/**
+ * Verify that when the consumer falls behind, @c feed() returns @c INCOMPLETE once the queue is full, so that the
+ * transfer can be paused, and that no data is lost.
+ */
+TEST_F(AsyncMimeParserTest, fullQueueIsIncomplete) {
+    createParser(SMALL_QUEUE_SIZE);
+    addBurst();
+    auto mimeString = constructTestMimeString(m_mimeParts, MIME_TEST_BOUNDARY_STRING);
+
+    size_t numberBytesFed = 0;
+    auto status = MimeParser::DataParsedStatus::OK;
+    while (MimeParser::DataParsedStatus::OK == status && numberBytesFed < mimeString.length()) {
+        status = m_parser->feed(const_cast<char*>(&mimeString[numberBytesFed]), TEST_FEED_SIZE);
+        if (MimeParser::DataParsedStatus::OK == status) {
+            numberBytesFed += TEST_FEED_SIZE;
+        }
+    }
+    ASSERT_EQ(status, MimeParser::DataParsedStatus::INCOMPLETE);
+    EXPECT_LE(numberBytesFed, SMALL_QUEUE_SIZE + TEST_DATA_SIZE * 3);
+
+    m_gate->open();
+    ASSERT_TRUE(feedParser(mimeString.substr(numberBytesFed)));
+    ASSERT_TRUE(waitUntilIdle());
+    validateMimePartsParsedOk();
+}
+
+/**
+ * Verify that a chunk too large for the queue is parsed once the queue has drained.
+ */
+TEST_F(AsyncMimeParserTest, oversizedChunk) {
+    createParser(SMALL_QUEUE_SIZE);
+    m_gate->open();
+    addBurst();
+    auto mimeString = constructTestMimeString(m_mimeParts, MIME_TEST_BOUNDARY_STRING);
+    ASSERT_GT(mimeString.length(), SMALL_QUEUE_SIZE * 2);
+
+    auto first = mimeString.substr(0, TEST_FEED_SIZE);
+    auto rest = mimeString.substr(TEST_FEED_SIZE);
+    ASSERT_EQ(m_parser->feed(const_cast<char*>(first.data()), first.length()), MimeParser::DataParsedStatus::OK);
+    auto deadline = std::chrono::steady_clock::now() + TIMEOUT;
+    auto status = MimeParser::DataParsedStatus::INCOMPLETE;
+    while (MimeParser::DataParsedStatus::INCOMPLETE == status && std::chrono::steady_clock::now() < deadline) {
+        status = m_parser->feed(const_cast<char*>(rest.data()), rest.length());
+    }
+    ASSERT_EQ(status, MimeParser::DataParsedStatus::OK);
+    ASSERT_TRUE(waitUntilIdle());
+    validateMimePartsParsedOk();
+}
+
+/**
+ * Verify that the idle callback is called once the data fed so far has been parsed, and not before.
+ */
+TEST_F(AsyncMimeParserTest, idleCallbackIsCalled) {
+    createParser();
+    std::promise<void> idlePromise;
+    auto idleFuture = idlePromise.get_future();
+    std::atomic<bool> wasIdle{false};
+    m_parser->setIdleCallback([this, &idlePromise, &wasIdle]() {
+        if (!wasIdle.exchange(true)) {
+            EXPECT_TRUE(m_parser->isIdle());
+            idlePromise.set_value();
+        }
+    });
+    m_mimeParts.push_back(
+        std::make_shared<TestMimeJsonPart>(MIME_TEST_BOUNDARY_STRING, TEST_DATA_SIZE, m_testableMessageObserver));
+    auto mimeString = constructTestMimeString(m_mimeParts, MIME_TEST_BOUNDARY_STRING);
+    ASSERT_EQ(
+        m_parser->feed(const_cast<char*>(mimeString.data()), mimeString.length()), MimeParser::DataParsedStatus::OK);
+    auto status = idleFuture.wait_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(status, std::future_status::timeout);
+
+    m_gate->open();
+    status = idleFuture.wait_for(TIMEOUT);
+    ASSERT_EQ(status, std::future_status::ready);
+    validateMimePartsParsedOk();
+}
+
+/**
+ * Verify that parsers sharing a single thread each parse all of their data, including while the other one waits for
+ * an attachment's buffer.
+ */
+TEST_F(AsyncMimeParserTest, parsersShareThreadPool) {
+    auto threadPool = avsCommon::utils::threading::ThreadPool::create(1);
+    auto blockingAttachmentManager = std::make_shared<TestableAttachmentManager>();
+    AsyncMimeParser blockingParser(m_testableConsumer, blockingAttachmentManager, threadPool);
+    blockingParser.setAttachmentContextId(TEST_CONTEXT_ID);
+    blockingParser.setBoundaryString(MIME_TEST_BOUNDARY_STRING);
+    m_parser.reset(new AsyncMimeParser(m_testableConsumer, m_attachmentManager, threadPool));
+    m_parser->setAttachmentContextId(TEST_CONTEXT_ID);
+    m_parser->setBoundaryString(MIME_TEST_BOUNDARY_STRING);
+    m_gate->open();
+
+    std::vector<std::shared_ptr<TestMimePart>> blockingParts = {std::make_shared<TestMimeAttachmentPart>(
+        MIME_TEST_BOUNDARY_STRING, TEST_CONTEXT_ID, "BLOCKING_CONTENT_ID", TEST_DATA_SIZE, blockingAttachmentManager)};
+    auto blockingString = constructTestMimeString(blockingParts, MIME_TEST_BOUNDARY_STRING);
+    ASSERT_EQ(
+        blockingParser.feed(const_cast<char*>(blockingString.data()), blockingString.length()),
+        MimeParser::DataParsedStatus::OK);
+
+    addBurst();
+    ASSERT_TRUE(feedParser(constructTestMimeString(m_mimeParts, MIME_TEST_BOUNDARY_STRING)));
+    ASSERT_TRUE(waitUntilIdle());
+    validateMimePartsParsedOk();
+
+    auto deadline = std::chrono::steady_clock::now() + TIMEOUT;
+    while (!blockingParser.isIdle() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(POLL_INTERVAL);
+        blockingParser.resume();
+    }
+    ASSERT_TRUE(blockingParser.isIdle());
+    ASSERT_TRUE(blockingParts[0]->validateMimeParsing());
+}
+
+/**
+ * Verify that @c reset() waits for parsing in progress, and that the parser can then be used again.
+ */
+TEST_F(AsyncMimeParserTest, resetDropsPendingData) {
+    createParser();
+    auto dropped =
+        std::make_shared<TestMimeJsonPart>(MIME_TEST_BOUNDARY_STRING, TEST_DATA_SIZE, m_testableMessageObserver);
+    std::vector<std::shared_ptr<TestMimePart>> droppedParts = {dropped, dropped};
+    auto droppedString = constructTestMimeString(droppedParts, MIME_TEST_BOUNDARY_STRING);
+    ASSERT_EQ(
+        m_parser->feed(const_cast<char*>(droppedString.data()), droppedString.length()),
+        MimeParser::DataParsedStatus::OK);
+
+    // reset() must wait for the delivery held up by the gate before the parser can be reused.
+    std::thread opener([this] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        m_gate->open();
+    });
+    m_parser->reset();
+    opener.join();
+    EXPECT_TRUE(m_parser->isIdle());
+
+    m_parser->setBoundaryString(MIME_TEST_BOUNDARY_STRING);
+    m_mimeParts.push_back(
+        std::make_shared<TestMimeJsonPart>(MIME_TEST_BOUNDARY_STRING, TEST_DATA_SIZE, m_testableMessageObserver));
+    ASSERT_TRUE(feedParser(constructTestMimeString(m_mimeParts, MIME_TEST_BOUNDARY_STRING)));
+    ASSERT_TRUE(waitUntilIdle());
+    validateMimePartsParsedOk();
+}
+
+}  // namespace test
+}  // namespace acl
+}  // namespace alexaClientSDK
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
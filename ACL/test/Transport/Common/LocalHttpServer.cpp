@@ -0,0 +1,239 @@
+/*
+ * LocalHttpServer.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cctype>
+#include <cstring>
+#include <sstream>
+
+#include "LocalHttpServer.h"
+
+namespace alexaClientSDK {
+namespace acl {
+namespace test {
+
+/// How often the server checks whether it is shutting down while waiting for a connection, for data, or to end a body.
+static const int POLL_TIMEOUT_MS = 20;
+/// How long the server waits for the next part of a request before giving up on it.
+static const std::chrono::seconds REQUEST_TIMEOUT(5);
+/// The end of the headers of a request.
+static const std::string END_OF_HEADERS = "\r\n\r\n";
+/// The header asking the server to confirm that the body of the request should be sent.
+static const std::string EXPECT_CONTINUE_HEADER = "expect: 100-continue";
+/// The header announcing a chunked body.
+static const std::string CHUNKED_HEADER = "transfer-encoding: chunked";
+/// The header announcing the length of the body.
+static const std::string CONTENT_LENGTH_HEADER = "content-length:";
+/// The last chunk of a chunked body.
+static const std::string LAST_CHUNK = "0\r\n\r\n";
+
+/**
+ * Send all of a string on a socket.
+ *
+ * @param socket The socket to send on.
+ * @param data The data to send.
+ * @return Whether all of the data was sent.
+ */
+static bool sendAll(int socket, const std::string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        auto result = ::send(socket, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (result <= 0) {
+            return false;
+        }
+        sent += result;
+    }
+    return true;
+}
+
+/**
+ * Check whether a string ends with another.
+ *
+ * @param data The string to check.
+ * @param suffix The string to look for at the end of @c data.
+ * @return Whether @c data ends with @c suffix.
+ */
+static bool endsWith(const std::string& data, const std::string& suffix) {
+    return data.size() >= suffix.size() && 0 == data.compare(data.size() - suffix.size(), suffix.size(), suffix);
+}
+
+std::unique_ptr<LocalHttpServer> LocalHttpServer::create(
+    long responseCode,
+    std::chrono::milliseconds responseDelay,
+    std::chrono::milliseconds bodyDelay) {
+    int listenSocket = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (listenSocket < 0) {
+        return nullptr;
+    }
+    sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = 0;
+    socklen_t addressLength = sizeof(address);
+    if (::bind(listenSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(listenSocket, 1) != 0 ||
+        ::getsockname(listenSocket, reinterpret_cast<sockaddr*>(&address), &addressLength) != 0) {
+        ::close(listenSocket);
+        return nullptr;
+    }
+    return std::unique_ptr<LocalHttpServer>(
+        new LocalHttpServer(listenSocket, ntohs(address.sin_port), responseCode, responseDelay, bodyDelay));
+}
+
+LocalHttpServer::LocalHttpServer(
+    int listenSocket,
+    int port,
+    long responseCode,
+    std::chrono::milliseconds responseDelay,
+    std::chrono::milliseconds bodyDelay) :
+        m_listenSocket{listenSocket},
+        m_port{port},
+        m_responseCode{responseCode},
+        m_responseDelay{responseDelay},
+        m_bodyDelay{bodyDelay},
+        m_numRequestsServed{0},
+        m_isShuttingDown{false} {
+    m_thread = std::thread(&LocalHttpServer::serveLoop, this);
+}
+
+LocalHttpServer::~LocalHttpServer() {
+    m_isShuttingDown = true;
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+    ::close(m_listenSocket);
+}
+
+std::string LocalHttpServer::getUrl() const {
+    return "http://127.0.0.1:" + std::to_string(m_port);
+}
+
+void LocalHttpServer::setResponseBody(const std::string& contentType, const std::string& body) {
+    std::lock_guard<std::mutex> lock(m_bodyMutex);
+    m_contentType = contentType;
+    m_body = body;
+}
+
+int LocalHttpServer::getNumRequestsServed() const {
+    return m_numRequestsServed;
+}
+
+void LocalHttpServer::serveLoop() {
+    while (!m_isShuttingDown) {
+        pollfd listenPoll = {m_listenSocket, POLLIN, 0};
+        if (::poll(&listenPoll, 1, POLL_TIMEOUT_MS) <= 0) {
+            continue;
+        }
+        int connection = ::accept(m_listenSocket, nullptr, nullptr);
+        if (connection < 0) {
+            continue;
+        }
+        serveRequest(connection);
+        ::close(connection);
+    }
+}
+
+void LocalHttpServer::serveRequest(int connection) {
+    std::string request;
+    std::string headers;
+    bool hasHeaders = false;
+    bool isChunked = false;
+    size_t contentLength = 0;
+    auto deadline = std::chrono::steady_clock::now() + REQUEST_TIMEOUT;
+    while (!m_isShuttingDown && std::chrono::steady_clock::now() < deadline) {
+        if (hasHeaders) {
+            auto body = request.substr(headers.size());
+            bool isComplete = isChunked ? endsWith(body, LAST_CHUNK) : body.size() >= contentLength;
+            if (isComplete) {
+                break;
+            }
+        }
+
+        pollfd connectionPoll = {connection, POLLIN, 0};
+        if (::poll(&connectionPoll, 1, POLL_TIMEOUT_MS) <= 0) {
+            continue;
+        }
+        char buffer[4096];
+        auto received = ::recv(connection, buffer, sizeof(buffer), 0);
+        if (received <= 0) {
+            return;
+        }
+        request.append(buffer, received);
+
+        if (!hasHeaders) {
+            auto end = request.find(END_OF_HEADERS);
+            if (std::string::npos == end) {
+                continue;
+            }
+            hasHeaders = true;
+            headers = request.substr(0, end + END_OF_HEADERS.size());
+            std::string lowerHeaders;
+            for (auto c : headers) {
+                lowerHeaders.push_back(static_cast<char>(std::tolower(c)));
+            }
+            isChunked = lowerHeaders.find(CHUNKED_HEADER) != std::string::npos;
+            auto contentLengthPosition = lowerHeaders.find(CONTENT_LENGTH_HEADER);
+            if (contentLengthPosition != std::string::npos) {
+                contentLength = std::stoul(lowerHeaders.substr(contentLengthPosition + CONTENT_LENGTH_HEADER.size()));
+            }
+            if (lowerHeaders.find(EXPECT_CONTINUE_HEADER) != std::string::npos &&
+                !sendAll(connection, "HTTP/1.1 100 Continue\r\n\r\n")) {
+                return;
+            }
+        }
+    }
+
+    std::this_thread::sleep_for(m_responseDelay);
+    auto statusLine = "HTTP/1.1 " + std::to_string(m_responseCode) + " Stand-in\r\n";
+    std::unique_lock<std::mutex> lock(m_bodyMutex);
+    auto contentType = m_contentType;
+    auto body = m_body;
+    lock.unlock();
+    if (!contentType.empty()) {
+        statusLine += "Content-Type: " + contentType + "\r\n";
+    }
+    if (m_bodyDelay.count() > 0) {
+        std::string firstChunk;
+        if (!body.empty()) {
+            std::ostringstream chunkSize;
+            chunkSize << std::hex << body.size();
+            firstChunk = chunkSize.str() + "\r\n" + body + "\r\n";
+        }
+        if (sendAll(connection, statusLine + "Transfer-Encoding: chunked\r\nConnection: close\r\n\r\n" + firstChunk)) {
+            auto bodyDeadline = std::chrono::steady_clock::now() + m_bodyDelay;
+            while (!m_isShuttingDown && std::chrono::steady_clock::now() < bodyDeadline) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(POLL_TIMEOUT_MS));
+            }
+            sendAll(connection, LAST_CHUNK);
+        }
+    } else {
+        sendAll(
+            connection,
+            statusLine + "Content-Length: " + std::to_string(body.size()) + "\r\nConnection: close\r\n\r\n" + body);
+    }
+    ++m_numRequestsServed;
+}
+
+}  // namespace test
+}  // namespace acl
+}  // namespace alexaClientSDK
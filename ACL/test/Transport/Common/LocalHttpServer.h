@@ -0,0 +1,145 @@
+/*
+ * LocalHttpServer.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_ACL_TEST_TRANSPORT_COMMON_LOCALHTTPSERVER_H_
+#define ALEXA_CLIENT_SDK_ACL_TEST_TRANSPORT_COMMON_LOCALHTTPSERVER_H_
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace alexaClientSDK {
+namespace acl {
+namespace test {
+
+/**
+ * A minimal HTTP/1.1 server on the loopback interface, which stands in for AVS in tests that need a real transfer.
+ * It reads each request in full, waits for a configurable delay, and then sends a fixed response and closes the
+ * connection.  The end of the body of the response can be held back for a while after the rest of it, as AVS does
+ * with the downchannel.  Requests are served one at a time.
+ */
+class LocalHttpServer {
+public:
+    /**
+     * Create a @c LocalHttpServer, listening on an ephemeral port.
+     *
+     * @param responseCode The HTTP status code of the responses.
+     * @param responseDelay How long to wait after reading a request before responding.
+     * @param bodyDelay How long to wait after sending the headers and body of a response before ending the body.
+     * @return The new server, or @c nullptr if it could not listen.
+     */
+    static std::unique_ptr<LocalHttpServer> create(
+        long responseCode,
+        std::chrono::milliseconds responseDelay = std::chrono::milliseconds::zero(),
+        std::chrono::milliseconds bodyDelay = std::chrono::milliseconds::zero());
+
+    /**
+     * Destructor.  Stops serving.
+     */
+    ~LocalHttpServer();
+
+    /**
+     * Get the URL of the server.
+     *
+     * @return The URL of the server, with no trailing slash.
+     */
+    std::string getUrl() const;
+
+    /**
+     * Set the body of the responses, which are empty unless this is called.  If the server was created with a
+     * @c bodyDelay, the body is sent as one chunk, and the response only ends after the delay.
+     *
+     * @param contentType The value of the Content-Type header of the responses.
+     * @param body The body of the responses.
+     */
+    void setResponseBody(const std::string& contentType, const std::string& body);
+
+    /**
+     * Get the number of requests served so far.
+     *
+     * @return The number of requests served.
+     */
+    int getNumRequestsServed() const;
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param listenSocket The socket to accept connections on.
+     * @param port The port of @c listenSocket.
+     * @param responseCode The HTTP status code of the responses.
+     * @param responseDelay How long to wait after reading a request before responding.
+     * @param bodyDelay How long to wait after sending the headers and body of a response before ending the body.
+     */
+    LocalHttpServer(
+        int listenSocket,
+        int port,
+        long responseCode,
+        std::chrono::milliseconds responseDelay,
+        std::chrono::milliseconds bodyDelay);
+
+    /**
+     * Accepts and serves connections until the server is destroyed.
+     */
+    void serveLoop();
+
+    /**
+     * Read a request from a connection, and respond to it.
+     *
+     * @param connection The socket of the connection.
+     */
+    void serveRequest(int connection);
+
+    /// The socket to accept connections on.
+    const int m_listenSocket;
+
+    /// The port the server listens on.
+    const int m_port;
+
+    /// The HTTP status code of the responses.
+    const long m_responseCode;
+
+    /// How long to wait after reading a request before responding.
+    const std::chrono::milliseconds m_responseDelay;
+
+    /// How long to wait after sending the headers and body of a response before ending the body.
+    const std::chrono::milliseconds m_bodyDelay;
+
+    /// Mutex serializing access to @c m_contentType and @c m_body.
+    std::mutex m_bodyMutex;
+    /// The value of the Content-Type header of the responses, if they have a body.
+    std::string m_contentType;
+    /// The body of the responses.
+    std::string m_body;
+    /// The number of requests served.
+    std::atomic<int> m_numRequestsServed;
+
+    /// Whether the server is shutting down.
+    std::atomic<bool> m_isShuttingDown;
+
+    /// The thread serving connections.
+    std::thread m_thread;
+};
+
+}  // namespace test
+}  // namespace acl
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_ACL_TEST_TRANSPORT_COMMON_LOCALHTTPSERVER_H_
@@ -96,7 +96,11 @@ bool TestMimeAttachmentPart::validateMimeParsing() {
 
     std::vector<uint8_t> result(m_attachmentData.size());
     auto readStatus = InProcessAttachmentReader::ReadStatus::OK;
-    auto numRead = reader->read(result.data(), result.size(), &readStatus);
+    size_t numRead = 0;
+    // An attachment which was spilled to disk is read in more than one piece.
+    while (numRead < result.size() && InProcessAttachmentReader::ReadStatus::OK == readStatus) {
+        numRead += reader->read(result.data() + numRead, result.size() - numRead, &readStatus);
+    }
     if (numRead != m_attachmentData.length()) {
         return false;
     }
@@ -17,19 +17,29 @@
 
 /// @file HTTP2StreamTest.cpp
 
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <iostream>
 #include <memory>
 #include <random>
+#include <thread>
 
 #include <gtest/gtest.h>
 
 #include <curl/curl.h>
 #include <ACL/Transport/HTTP2Stream.h>
+#include <ACL/Transport/MimeParser.h>
 #include <AVSCommon/AVS/Initialization/AlexaClientSDKInit.h>
 #include <AVSCommon/Utils/SDS/InProcessSDS.h>
 #include <AVSCommon/AVS/Attachment/InProcessAttachmentReader.h>
+#include <AVSCommon/Utils/LibcurlUtils/CurlMultiHandleWrapper.h>
 #include "TestableConsumer.h"
 #include "MockMessageRequest.h"
 #include "Common/Common.h"
+#include "Common/LocalHttpServer.h"
+#include "Common/MimeUtils.h"
+#include "Common/TestableMessageObserver.h"
 
 namespace alexaClientSDK {
 namespace acl {
@@ -57,6 +67,143 @@ static const size_t SDS_MAXREADERS = 1;
 static const size_t SDS_WORDS = 300;
 /// Number of strings to read/write for the test
 static const size_t NUMBER_OF_STRINGS = 1;
+/// How long the local server takes to respond to a request.
+static const std::chrono::milliseconds SERVER_RESPONSE_DELAY(100);
+/// How long the attachment of a request sent to the local server runs dry in the middle of the upload.
+static const std::chrono::milliseconds ATTACHMENT_PAUSE(100);
+/// How long a request sent to the local server is said to have waited in the queue.
+static const std::chrono::milliseconds QUEUE_WAIT_TIME(50);
+/// How long to wait for a transfer to the local server to finish.  This is only reached if a test is failing.
+static const std::chrono::seconds TRANSFER_TIMEOUT(5);
+/// How long to wait for activity on each pass of the transfer loop.
+static const std::chrono::milliseconds TRANSFER_WAIT(10);
+/// The boundary of the multipart responses of the local server.
+static const std::string MIME_TEST_BOUNDARY_STRING = "84109348-943b-4446-85e6-e73eda9fac43";
+/// The Content-Type of the multipart responses of the local server.
+static const std::string MIME_CONTENT_TYPE =
+    "multipart/related; boundary=" + MIME_TEST_BOUNDARY_STRING + "; type=application/json";
+/// The size of each directive in the responses of the local server.
+static const int DIRECTIVE_SIZE = 100;
+/// The number of directives in the response of the local server when testing.
+static const int TEST_BURST_SIZE = 20;
+/// The number of directives in the response of the local server when benchmarking.
+static const int BENCHMARK_BURST_SIZE = 2000;
+/// How long the slow consumer of the benchmark takes over each directive.
+static const std::chrono::microseconds SLOW_CONSUMER_DELAY(300);
+/// How long to wait for a burst of directives to be consumed when benchmarking.
+static const std::chrono::seconds BENCHMARK_TIMEOUT(30);
+
+/**
+ * A @c MessageObserverInterface which takes a while over each message, as a busy directive sequencer might.
+ */
+class SlowMessageObserver : public avsCommon::sdkInterfaces::MessageObserverInterface {
+public:
+    /// Constructor.
+    SlowMessageObserver() : numMessages{0} {
+    }
+
+    void receive(const std::string& contextId, const std::string& message) override {
+        std::this_thread::sleep_for(SLOW_CONSUMER_DELAY);
+        ++numMessages;
+    }
+
+    /// The number of messages received.
+    std::atomic<int> numMessages;
+};
+
+/**
+ * Feed data received by curl straight to a @c MimeParser, as @c HTTP2Stream did before it parsed off the network
+ * thread.
+ *
+ * @param data The data received.
+ * @param size The size of each member of @c data.
+ * @param nmemb The number of members in @c data.
+ * @param user The @c MimeParser.
+ * @return The number of bytes consumed.
+ */
+static size_t feedMimeParser(char* data, size_t size, size_t nmemb, void* user) {
+    static_cast<MimeParser*>(user)->feed(data, size * nmemb);
+    return size * nmemb;
+}
+
+/**
+ * Run a transfer to completion, timing each call to @c perform(), which is where the network thread of
+ * @c HTTP2Transport calls the write callbacks of its streams.
+ *
+ * @param handle The curl handle of the transfer.
+ * @param unPause A function to call after each wait for activity.
+ * @param[out] performTimes The duration of each call to @c perform(), in microseconds.
+ * @return Whether the transfer finished within @c BENCHMARK_TIMEOUT.
+ */
+static bool timeTransfer(CURL* handle, std::function<void()> unPause, std::vector<double>* performTimes) {
+    auto multi = avsCommon::utils::libcurlUtils::CurlMultiHandleWrapper::create();
+    if (!multi || multi->addHandle(handle) != CURLM_OK) {
+        return false;
+    }
+    auto deadline = std::chrono::steady_clock::now() + BENCHMARK_TIMEOUT;
+    int numTransfersLeft = 1;
+    while (numTransfersLeft && std::chrono::steady_clock::now() < deadline) {
+        auto start = std::chrono::steady_clock::now();
+        if (multi->perform(&numTransfersLeft) != CURLM_OK) {
+            break;
+        }
+        performTimes->push_back(
+            std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+        int numTransfersUpdated = 0;
+        multi->wait(TRANSFER_WAIT, &numTransfersUpdated);
+        unPause();
+    }
+    multi->removeHandle(handle);
+    return 0 == numTransfersLeft;
+}
+
+/**
+ * Print the distribution of the durations of calls to @c perform().
+ *
+ * @param name What was measured.
+ * @param performTimes The durations, in microseconds.
+ * @param totalTime How long it took for all of the directives to be consumed.
+ */
+static void printPerformTimes(
+    const std::string& name,
+    std::vector<double> performTimes,
+    std::chrono::steady_clock::duration totalTime) {
+    std::sort(performTimes.begin(), performTimes.end());
+    auto percentile = [&performTimes](double fraction) {
+        return performTimes[static_cast<size_t>(fraction * (performTimes.size() - 1))];
+    };
+    std::cout << std::setw(6) << name << "  calls " << std::setw(5) << performTimes.size() << "  p50 " << std::setw(9)
+              << percentile(0.5) << "us  p99 " << std::setw(9) << percentile(0.99) << "us  max " << std::setw(9)
+              << performTimes.back() << "us  all consumed after "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(totalTime).count() << "ms" << std::endl;
+}
+
+/**
+ * A @c MessageRequest which keeps the status and timings it was completed with.
+ */
+class TimedMessageRequest : public MessageRequest {
+public:
+    /**
+     * Constructor.
+     *
+     * @param attachmentReader The attachment to send with the request.
+     */
+    TimedMessageRequest(std::shared_ptr<AttachmentReader> attachmentReader) :
+            MessageRequest{"", attachmentReader},
+            status{avsCommon::sdkInterfaces::MessageRequestObserverInterface::Status::PENDING} {
+    }
+
+    void sendCompleted(avsCommon::sdkInterfaces::MessageRequestObserverInterface::Status sendStatus) override {
+        status = sendStatus;
+        timings = getTimings();
+    }
+
+    /// The status the request was completed with.
+    avsCommon::sdkInterfaces::MessageRequestObserverInterface::Status status;
+    /// The timings available when the request was completed.
+    MessageRequestTimings timings;
+};
+
 /**
  * Our GTest class.
  */
@@ -190,6 +337,134 @@ TEST_F(HTTP2StreamTest, testReadCallBack) {
     bytesRead = HTTP2Stream::readCallback(m_dataBegin, TEST_EXCEPTION_STRING_LENGTH, NUMBER_OF_STRINGS, nullptr);
     ASSERT_EQ(0, bytesRead);
 }
+
+/**
+ * Send a request whose attachment runs dry for a while to a local stand-in server, and verify that the timings of
+ * the transfer are passed to the request when it completes.
+ */
+TEST_F(HTTP2StreamTest, testTimingsFromLocalServer) {
+    auto server = LocalHttpServer::create(HTTP2Stream::HTTPResponseCodes::SUCCESS_NO_CONTENT, SERVER_RESPONSE_DELAY);
+    ASSERT_NE(server, nullptr);
+
+    size_t bufferSize = InProcessSDS::calculateBufferSize(SDS_WORDS, SDS_WORDSIZE, SDS_MAXREADERS);
+    auto buffer = std::make_shared<InProcessSDS::Buffer>(bufferSize);
+    std::shared_ptr<InProcessSDS> sds = InProcessSDS::create(buffer, SDS_WORDSIZE, SDS_MAXREADERS);
+    ASSERT_NE(sds, nullptr);
+    auto writer = sds->createWriter(InProcessSDS::Writer::Policy::NONBLOCKABLE);
+    ASSERT_NE(writer, nullptr);
+    auto halfLength = TEST_EXCEPTION_STRING_LENGTH / 2;
+    ASSERT_EQ(halfLength, writer->write(m_dataBegin, halfLength));
+
+    auto request = std::make_shared<TimedMessageRequest>(
+        InProcessAttachmentReader::create(AttachmentReader::Policy::NON_BLOCKING, sds));
+    auto stream = std::make_shared<HTTP2Stream>(m_testableConsumer, m_attachmentManager);
+    ASSERT_TRUE(stream->initPost(server->getUrl(), LIBCURL_TEST_AUTH_STRING, request));
+    stream->setQueueWaitTime(QUEUE_WAIT_TIME);
+
+    auto multi = avsCommon::utils::libcurlUtils::CurlMultiHandleWrapper::create();
+    ASSERT_NE(multi, nullptr);
+    ASSERT_EQ(CURLM_OK, multi->addHandle(stream->getCurlHandle()));
+
+    auto start = std::chrono::steady_clock::now();
+    bool isAttachmentComplete = false;
+    int numTransfersLeft = 1;
+    while (numTransfersLeft && std::chrono::steady_clock::now() - start < TRANSFER_TIMEOUT) {
+        ASSERT_EQ(CURLM_OK, multi->perform(&numTransfersLeft));
+        if (!isAttachmentComplete && std::chrono::steady_clock::now() - start >= ATTACHMENT_PAUSE) {
+            auto rest = TEST_EXCEPTION_STRING_LENGTH - halfLength;
+            ASSERT_EQ(rest, writer->write(m_dataBegin + halfLength, rest));
+            writer->close();
+            isAttachmentComplete = true;
+        }
+        int numTransfersUpdated = 0;
+        ASSERT_EQ(CURLM_OK, multi->wait(TRANSFER_WAIT, &numTransfersUpdated));
+        stream->unPause();
+    }
+    ASSERT_EQ(0, numTransfersLeft);
+    stream->notifyRequestObserver();
+    multi->removeHandle(stream->getCurlHandle());
+
+    EXPECT_EQ(1, server->getNumRequestsServed());
+    EXPECT_EQ(avsCommon::sdkInterfaces::MessageRequestObserverInterface::Status::SUCCESS_NO_CONTENT, request->status);
+    auto& timings = request->timings;
+    EXPECT_EQ(QUEUE_WAIT_TIME, timings.queueWait);
+    EXPECT_LE(timings.nameLookup, timings.connect);
+    EXPECT_LE(timings.connect, timings.startTransfer);
+    EXPECT_LE(timings.startTransfer, timings.total);
+    EXPECT_GE(timings.total, SERVER_RESPONSE_DELAY + ATTACHMENT_PAUSE);
+    EXPECT_GE(timings.attachmentReadPaused, ATTACHMENT_PAUSE / 2);
+    EXPECT_LT(timings.attachmentReadPaused, timings.total);
+    EXPECT_GE(timings.bytesUploaded, static_cast<uint64_t>(TEST_EXCEPTION_STRING_LENGTH));
+    EXPECT_EQ(0u, timings.bytesDownloaded);
+}
+
+/**
+ * Receive a burst of directives from a local stand-in server, and verify that each of them is passed on once the
+ * response has been parsed.
+ */
+TEST_F(HTTP2StreamTest, testResponseParsedFromLocalServer) {
+    auto observer = std::make_shared<TestableMessageObserver>();
+    m_testableConsumer->setMessageObserver(observer);
+    std::vector<std::shared_ptr<TestMimePart>> mimeParts;
+    for (int i = 0; i < TEST_BURST_SIZE; ++i) {
+        mimeParts.push_back(std::make_shared<TestMimeJsonPart>(MIME_TEST_BOUNDARY_STRING, DIRECTIVE_SIZE, observer));
+    }
+    auto server = LocalHttpServer::create(HTTP2Stream::HTTPResponseCodes::SUCCESS_OK);
+    ASSERT_NE(server, nullptr);
+    server->setResponseBody(MIME_CONTENT_TYPE, constructTestMimeString(mimeParts, MIME_TEST_BOUNDARY_STRING));
+
+    auto stream = std::make_shared<HTTP2Stream>(m_testableConsumer, m_attachmentManager);
+    ASSERT_TRUE(stream->initGet(server->getUrl(), LIBCURL_TEST_AUTH_STRING));
+    std::vector<double> performTimes;
+    ASSERT_TRUE(timeTransfer(stream->getCurlHandle(), [stream]() { stream->unPause(); }, &performTimes));
+    for (auto mimePart : mimeParts) {
+        EXPECT_TRUE(mimePart->validateMimeParsing());
+    }
+    EXPECT_FALSE(stream->isParsing());
+}
+
+/**
+ * Benchmarks how long the network thread is held up by a burst of directives from a local stand-in server, when a
+ * slow consumer is called on the network thread, as it used to be, and when the response is parsed off it.  Run with
+ * --gtest_also_run_disabled_tests.
+ */
+TEST_F(HTTP2StreamTest, DISABLED_benchmarkParsingOffNetworkThread) {
+    auto observer = std::make_shared<SlowMessageObserver>();
+    m_testableConsumer->setMessageObserver(observer);
+    std::vector<std::shared_ptr<TestMimePart>> mimeParts;
+    for (int i = 0; i < BENCHMARK_BURST_SIZE; ++i) {
+        mimeParts.push_back(std::make_shared<TestMimeJsonPart>(MIME_TEST_BOUNDARY_STRING, DIRECTIVE_SIZE, nullptr));
+    }
+    auto server = LocalHttpServer::create(HTTP2Stream::HTTPResponseCodes::SUCCESS_OK);
+    ASSERT_NE(server, nullptr);
+    server->setResponseBody(MIME_CONTENT_TYPE, constructTestMimeString(mimeParts, MIME_TEST_BOUNDARY_STRING));
+
+    MimeParser parser(m_testableConsumer, m_attachmentManager);
+    parser.setBoundaryString(MIME_TEST_BOUNDARY_STRING);
+    avsCommon::utils::libcurlUtils::CurlEasyHandleWrapper handle;
+    ASSERT_TRUE(handle.setURL(server->getUrl()));
+    ASSERT_TRUE(handle.setWriteCallback(feedMimeParser, &parser));
+    std::vector<double> performTimes;
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(timeTransfer(handle.getCurlHandle(), []() {}, &performTimes));
+    ASSERT_EQ(BENCHMARK_BURST_SIZE, observer->numMessages);
+    printPerformTimes("sync", performTimes, std::chrono::steady_clock::now() - start);
+
+    observer->numMessages = 0;
+    auto stream = std::make_shared<HTTP2Stream>(m_testableConsumer, m_attachmentManager);
+    ASSERT_TRUE(stream->initGet(server->getUrl(), LIBCURL_TEST_AUTH_STRING));
+    performTimes.clear();
+    start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(timeTransfer(stream->getCurlHandle(), [stream]() { stream->unPause(); }, &performTimes));
+    auto deadline = start + BENCHMARK_TIMEOUT;
+    while (stream->isParsing() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(TRANSFER_WAIT);
+        stream->resumeParsing();
+    }
+    ASSERT_EQ(BENCHMARK_BURST_SIZE, observer->numMessages);
+    printPerformTimes("async", performTimes, std::chrono::steady_clock::now() - start);
+}
+
 }  // namespace test
 }  // namespace acl
 }  // namespace alexaClientSDK
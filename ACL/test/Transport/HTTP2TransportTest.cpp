@@ -0,0 +1,294 @@
+/*
+ * HTTP2TransportTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <ACL/Transport/HTTP2Stream.h>
+#include <ACL/Transport/HTTP2Transport.h>
+#include <ACL/Transport/PostConnectObject.h>
+#include <AVSCommon/AVS/Attachment/AttachmentManager.h>
+#include <AVSCommon/AVS/Initialization/AlexaClientSDKInit.h>
+#include <AVSCommon/SDKInterfaces/MockContextManager.h>
+#include <AVSCommon/Utils/Threading/WakeupAudit.h>
+
+#include "Common/LocalHttpServer.h"
+#include "MockAuthDelegate.h"
+#include "MockMessageRequest.h"
+#include "TestableConsumer.h"
+
+namespace alexaClientSDK {
+namespace acl {
+namespace test {
+
+using namespace ::testing;
+using namespace avsCommon::avs::attachment;
+using namespace avsCommon::avs::initialization;
+using namespace avsCommon::sdkInterfaces;
+using namespace avsCommon::sdkInterfaces::test;
+
+/// The auth token handed out once the transport is authorized.
+static const std::string AUTH_TOKEN = "authToken";
+
+/// How long the stand-in for LWA takes to authorize the transport.
+static const std::chrono::milliseconds AUTHORIZATION_DELAY(300);
+
+/**
+ * Used to limit the amount of real time tests will wait for an operation to finish.  This timeout will only be hit if
+ * a test is failing.
+ */
+static const std::chrono::seconds TIMEOUT(10);
+
+/// How long the stand-in for AVS holds the downchannel open after its headers, leaving the transport idle.
+static const std::chrono::milliseconds IDLE_BODY_DELAY(5000);
+
+/// How long to let the transport settle after connecting, before auditing its wakeups.
+static const std::chrono::milliseconds IDLE_SETTLE_TIME(200);
+
+/// How long to audit the wakeups of an idle transport for.
+static const std::chrono::milliseconds IDLE_AUDIT_PERIOD(1000);
+
+/// The name of the network thread of @c HTTP2Transport.
+static const std::string NETWORK_THREAD_NAME = "HTTP2Transport";
+
+/// A @c TransportObserverInterface which the tests don't check.
+class StubTransportObserver : public TransportObserverInterface {
+public:
+    void onConnected(std::shared_ptr<TransportInterface> transport) override {
+    }
+    void onDisconnected(
+        std::shared_ptr<TransportInterface> transport,
+        avsCommon::sdkInterfaces::ConnectionStatusObserverInterface::ChangedReason reason) override {
+    }
+    void onServerSideDisconnect(std::shared_ptr<TransportInterface> transport) override {
+    }
+};
+
+/// Test harness for @c HTTP2Transport, connecting to a @c LocalHttpServer which stands in for AVS.
+class HTTP2TransportTest : public ::testing::Test {
+public:
+    void SetUp() override;
+
+    void TearDown() override;
+
+protected:
+    /**
+     * Wait in real time for a condition.
+     *
+     * @param predicate The condition to wait for.
+     * @return Whether the condition became true before @c TIMEOUT.
+     */
+    bool waitFor(std::function<bool()> predicate);
+
+    /**
+     * Replace the transport with one configured with or without @c ticklessIdle, connect it to a server which holds
+     * the downchannel open for @c IDLE_BODY_DELAY, and measure how often its network thread wakes while idle.
+     *
+     * @param isTicklessIdle Whether to enable @c ticklessIdle.
+     * @param[out] wakeupsPerSecond The wakeups per second of the network thread.
+     * @return Whether the wakeups could be measured.  They can't where the scheduler statistics are unavailable.
+     */
+    bool measureIdleWakeups(bool isTicklessIdle, double* wakeupsPerSecond);
+
+    /// The auth delegate of the transport, which hands out @c AUTH_TOKEN once @c m_isAuthorized is set.
+    std::shared_ptr<NiceMock<MockAuthDelegate>> m_mockAuthDelegate;
+
+    /// Whether @c m_mockAuthDelegate hands out a token.
+    std::atomic<bool> m_isAuthorized;
+
+    /// The stand-in for AVS.
+    std::unique_ptr<LocalHttpServer> m_server;
+
+    /// The transport under test.
+    std::shared_ptr<HTTP2Transport> m_transport;
+};
+
+void HTTP2TransportTest::SetUp() {
+    ASSERT_TRUE(AlexaClientSDKInit::initialize(std::vector<std::istream*>()));
+    PostConnectObject::init(std::make_shared<NiceMock<MockContextManager>>());
+
+    m_isAuthorized = false;
+    m_mockAuthDelegate = std::make_shared<NiceMock<MockAuthDelegate>>();
+    ON_CALL(*m_mockAuthDelegate, getAuthToken()).WillByDefault(Invoke([this] {
+        return m_isAuthorized ? AUTH_TOKEN : "";
+    }));
+
+    m_server = LocalHttpServer::create(HTTP2Stream::HTTPResponseCodes::SUCCESS_OK);
+    ASSERT_NE(m_server, nullptr);
+
+    m_transport = HTTP2Transport::create(
+        m_mockAuthDelegate,
+        m_server->getUrl(),
+        std::make_shared<TestableConsumer>(),
+        std::make_shared<AttachmentManager>(AttachmentManager::AttachmentType::IN_PROCESS),
+        std::make_shared<StubTransportObserver>());
+    ASSERT_NE(m_transport, nullptr);
+}
+
+void HTTP2TransportTest::TearDown() {
+    if (m_transport) {
+        m_transport->shutdown();
+    }
+    m_server.reset();
+    PostConnectObject::init(nullptr);
+    AlexaClientSDKInit::uninitialize();
+}
+
+bool HTTP2TransportTest::waitFor(std::function<bool()> predicate) {
+    auto deadline = std::chrono::steady_clock::now() + TIMEOUT;
+    while (!predicate()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+bool HTTP2TransportTest::measureIdleWakeups(bool isTicklessIdle, double* wakeupsPerSecond) {
+    m_transport->shutdown();
+    m_transport.reset();
+    m_server.reset();
+    AlexaClientSDKInit::uninitialize();
+    std::stringstream config;
+    config << R"({"acl":{"ticklessIdle":)" << (isTicklessIdle ? "true" : "false") << "}}";
+    EXPECT_TRUE(AlexaClientSDKInit::initialize({&config}));
+
+    m_server = LocalHttpServer::create(
+        HTTP2Stream::HTTPResponseCodes::SUCCESS_OK, std::chrono::milliseconds::zero(), IDLE_BODY_DELAY);
+    EXPECT_NE(m_server, nullptr);
+    m_transport = HTTP2Transport::create(
+        m_mockAuthDelegate,
+        m_server->getUrl(),
+        std::make_shared<TestableConsumer>(),
+        std::make_shared<AttachmentManager>(AttachmentManager::AttachmentType::IN_PROCESS),
+        std::make_shared<StubTransportObserver>());
+    EXPECT_NE(m_transport, nullptr);
+    m_isAuthorized = true;
+    EXPECT_TRUE(m_transport->connect());
+    std::this_thread::sleep_for(IDLE_SETTLE_TIME);
+
+    auto audit = avsCommon::utils::threading::WakeupAudit::create();
+    if (!audit) {
+        return false;
+    }
+    std::this_thread::sleep_for(IDLE_AUDIT_PERIOD);
+    auto wakeups = audit->getWakeups();
+    EXPECT_EQ(wakeups[NETWORK_THREAD_NAME].numThreads, 1u);
+    *wakeupsPerSecond = wakeups[NETWORK_THREAD_NAME].wakeupsPerSecond;
+    return true;
+}
+
+/**
+ * Verify that connecting before an auth token is available opens the connection to AVS straight away, and opens the
+ * downchannel as soon as the token arrives, so that booting overlaps connecting with the refresh of the token.
+ */
+TEST_F(HTTP2TransportTest, connectBeforeAuthorization) {
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(m_transport->connect());
+
+    // The unauthenticated warm up request reaches AVS while the token is still being refreshed.
+    ASSERT_TRUE(waitFor([this] { return m_server->getNumRequestsServed() >= 1; }));
+    auto warmedUp = std::chrono::steady_clock::now();
+    EXPECT_LT(warmedUp - start, AUTHORIZATION_DELAY);
+    std::this_thread::sleep_for(AUTHORIZATION_DELAY - (warmedUp - start));
+    EXPECT_EQ(m_server->getNumRequestsServed(), 1);
+
+    // The downchannel follows the token.
+    m_isAuthorized = true;
+    ASSERT_TRUE(waitFor([this] { return m_server->getNumRequestsServed() >= 2; }));
+    auto connected = std::chrono::steady_clock::now();
+    std::cout << "boot to connected with " << AUTHORIZATION_DELAY.count() << " ms authorization: "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(connected - start).count() << " ms"
+              << std::endl;
+    EXPECT_LT(connected - start, AUTHORIZATION_DELAY + TIMEOUT / 10);
+}
+
+/**
+ * Verify that a transport with a token at hand opens the downchannel straight away, without a warm up request.
+ */
+TEST_F(HTTP2TransportTest, connectWithAuthorization) {
+    m_isAuthorized = true;
+    ASSERT_TRUE(m_transport->connect());
+    ASSERT_TRUE(waitFor([this] { return m_server->getNumRequestsServed() >= 1; }));
+    std::this_thread::sleep_for(AUTHORIZATION_DELAY);
+    EXPECT_EQ(m_server->getNumRequestsServed(), 1);
+}
+
+/**
+ * Verify that a transport waiting for an auth token can still be disconnected promptly.
+ */
+TEST_F(HTTP2TransportTest, disconnectWhileAwaitingAuthorization) {
+    ASSERT_TRUE(m_transport->connect());
+    ASSERT_TRUE(waitFor([this] { return m_server->getNumRequestsServed() >= 1; }));
+
+    auto start = std::chrono::steady_clock::now();
+    m_transport->disconnect();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, TIMEOUT / 10);
+    EXPECT_FALSE(m_transport->isConnected());
+    EXPECT_EQ(m_server->getNumRequestsServed(), 1);
+}
+
+// Tickless idle needs curl_multi_wakeup, and the wakeups are measured with the scheduler statistics of Linux.
+#if defined(__linux__) && LIBCURL_VERSION_NUM >= 0x074400
+/**
+ * Verify that with @c ticklessIdle, the network thread of a transport with nothing to do sleeps instead of polling.
+ */
+TEST_F(HTTP2TransportTest, ticklessIdleStopsPolling) {
+    double pollingWakeupsPerSecond = 0;
+    double ticklessWakeupsPerSecond = 0;
+    ASSERT_TRUE(measureIdleWakeups(false, &pollingWakeupsPerSecond));
+    ASSERT_TRUE(measureIdleWakeups(true, &ticklessWakeupsPerSecond));
+    EXPECT_LT(ticklessWakeupsPerSecond * 4, pollingWakeupsPerSecond);
+}
+
+/**
+ * Verify that with @c ticklessIdle, a request queued while the transport sleeps is sent straight away.
+ */
+TEST_F(HTTP2TransportTest, ticklessIdleWakesForRequests) {
+    double wakeupsPerSecond = 0;
+    ASSERT_TRUE(measureIdleWakeups(true, &wakeupsPerSecond));
+
+    // Without a token, the request completes as soon as the network loop gets to it, without going to the server.
+    m_isAuthorized = false;
+    std::promise<void> completed;
+    auto request = std::make_shared<NiceMock<MockMessageRequest>>();
+    EXPECT_CALL(*request, sendCompleted(MessageRequestObserverInterface::Status::INVALID_AUTH))
+        .WillOnce(InvokeWithoutArgs([&completed] { completed.set_value(); }));
+    m_transport->sendPostConnectMessage(request);
+    EXPECT_EQ(completed.get_future().wait_for(TIMEOUT / 10), std::future_status::ready);
+}
+#endif
+
+}  // namespace test
+}  // namespace acl
+}  // namespace alexaClientSDK
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -17,9 +17,12 @@
 
 /// @file MimeParserTest.cpp
 
+#include <cstdlib>
 #include <memory>
 #include <random>
 
+#include <unistd.h>
+
 #include <gtest/gtest.h>
 
 #include "ACL/Transport/MessageConsumerInterface.h"
@@ -62,6 +65,12 @@ static const int TEST_MULTI_WRITE_ITERATIONS = 4;
 /// infinitely.
 static const int TEST_MULTI_MAX_ITERATIONS = 100;
 /// A test context id.
+/// The size of an attachment far larger than an attachment's in-memory buffer.
+static const int TEST_LARGE_ATTACHMENT_SIZE = 20 * 1024 * 1024;
+
+/// The size of the chunks a large MIME string is fed to the parser in, as they would arrive from the network.
+static const size_t TEST_NETWORK_CHUNK_SIZE = 16 * 1024;
+
 static const std::string TEST_CONTEXT_ID = "TEST_CONTEXT_ID";
 /// A test content id.
 static const std::string TEST_CONTENT_ID_01 = "TEST_CONTENT_ID_01";
@@ -311,6 +320,40 @@ TEST_F(MimeParserTest, testDuplicateBounaries) {
     validateMimePartsParsedOk();
 }
 
+/**
+ * Test that a large attachment which nothing reads yet does not hold up the directive which follows it, when
+ * attachments spill to disk.  Each chunk must be accepted the first time it is fed, as the network thread would
+ * otherwise have to stall the whole downchannel until the attachment is read.
+ */
+TEST_F(MimeParserTest, testLargeUnreadAttachmentDoesNotBlockDirective) {
+    char spillDirectory[] = "/tmp/MimeParserTest-XXXXXX";
+    ASSERT_NE(mkdtemp(spillDirectory), nullptr);
+    auto attachmentManager = std::make_shared<AttachmentManager>(AttachmentManager::AttachmentType::IN_PROCESS);
+    AttachmentManager::MemoryPolicy policy;
+    policy.spillDirectory = spillDirectory;
+    ASSERT_TRUE(attachmentManager->setMemoryPolicy(policy));
+    auto parser = std::make_shared<MimeParser>(m_testableConsumer, attachmentManager);
+    parser->setAttachmentContextId(TEST_CONTEXT_ID);
+    parser->setBoundaryString(MIME_TEST_BOUNDARY_STRING);
+
+    auto attachmentPart = std::make_shared<TestMimeAttachmentPart>(
+        MIME_TEST_BOUNDARY_STRING, TEST_CONTEXT_ID, TEST_CONTENT_ID_01, TEST_LARGE_ATTACHMENT_SIZE, attachmentManager);
+    auto directivePart =
+        std::make_shared<TestMimeJsonPart>(MIME_TEST_BOUNDARY_STRING, TEST_DATA_SIZE, m_testableMessageObserver);
+    auto mimeString = constructTestMimeString({attachmentPart, directivePart}, MIME_TEST_BOUNDARY_STRING);
+
+    for (size_t offset = 0; offset < mimeString.size(); offset += TEST_NETWORK_CHUNK_SIZE) {
+        auto size = std::min(TEST_NETWORK_CHUNK_SIZE, mimeString.size() - offset);
+        ASSERT_EQ(parser->feed(const_cast<char*>(mimeString.data() + offset), size), MimeParser::DataParsedStatus::OK);
+    }
+
+    EXPECT_TRUE(directivePart->validateMimeParsing());
+    EXPECT_TRUE(attachmentPart->validateMimeParsing());
+    parser.reset();
+    attachmentManager.reset();
+    EXPECT_EQ(rmdir(spillDirectory), 0);
+}
+
 }  // namespace test
 }  // namespace acl
 }  // namespace alexaClientSDK
@@ -19,7 +19,6 @@
 #define ALEXA_CLIENT_SDK_ADSL_INCLUDE_ADSL_DIRECTIVEPROCESSOR_H_
 
 #include <condition_variable>
-#include <deque>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -29,6 +28,7 @@
 #include <AVSCommon/AVS/AVSDirective.h>
 #include <AVSCommon/SDKInterfaces/DirectiveHandlerInterface.h>
 
+#include "ADSL/DirectiveQueue.h"
 #include "ADSL/DirectiveRouter.h"
 
 namespace alexaClientSDK {
@@ -228,13 +228,13 @@ private:
     std::string m_dialogRequestId;
 
     /// Queue of @c AVSDirectives waiting to be canceled.
-    std::deque<std::shared_ptr<avsCommon::avs::AVSDirective>> m_cancelingQueue;
+    DirectiveQueue m_cancelingQueue;
 
     /// The directive (if any) for which a preHandleDirective() call is in progress.
     std::shared_ptr<avsCommon::avs::AVSDirective> m_directiveBeingPreHandled;
 
     /// Queue of @c AVSDirectives waiting to be handled.
-    std::deque<std::shared_ptr<avsCommon::avs::AVSDirective>> m_handlingQueue;
+    DirectiveQueue m_handlingQueue;
 
     /// Whether @c handleDirective() has been called for the directive at the @c front() of @c m_handlingQueue.
     bool m_isHandlingDirective;
@@ -0,0 +1,211 @@
+/*
+ * DirectiveQueue.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_ADSL_INCLUDE_ADSL_DIRECTIVEQUEUE_H_
+#define ALEXA_CLIENT_SDK_ADSL_INCLUDE_ADSL_DIRECTIVEQUEUE_H_
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <AVSCommon/AVS/AVSDirective.h>
+
+namespace alexaClientSDK {
+namespace adsl {
+
+/**
+ * A FIFO queue of @c AVSDirectives which can also remove a given directive, or every directive of a dialog, without
+ * scanning the queue.
+ *
+ * The directives are held in an intrusive doubly linked list, so that a node can be unlinked in constant time once it
+ * is found.  Nodes are found through two hash indices: one from each directive to its nodes, and one from each
+ * non-empty @c dialogRequestId to a second list threading the nodes of that dialog in queue order.  Removing a
+ * directive is therefore O(1), and removing a dialog is O(number of directives in the dialog), regardless of how many
+ * other directives are queued, which keeps cancellation on barge-in cheap while the @c DirectiveProcessor lock is held.
+ *
+ * A directive may be queued more than once, in which case each removal removes every copy, as the scans this replaced
+ * did.  This class is not thread-safe.
+ */
+class DirectiveQueue {
+public:
+    /**
+     * Constructor.
+     */
+    DirectiveQueue();
+
+    /**
+     * Destructor.
+     */
+    ~DirectiveQueue();
+
+    /// @c DirectiveQueue instances own their nodes, and may not be copied.
+    DirectiveQueue(const DirectiveQueue&) = delete;
+
+    /// @c DirectiveQueue instances own their nodes, and may not be copied.
+    DirectiveQueue& operator=(const DirectiveQueue&) = delete;
+
+    /**
+     * Check whether the queue is empty.
+     *
+     * @return Whether the queue is empty.
+     */
+    bool empty() const;
+
+    /**
+     * Get the number of directives in the queue.
+     *
+     * @return The number of directives in the queue.
+     */
+    size_t size() const;
+
+    /**
+     * Get the directive at the front of the queue.
+     *
+     * @return The directive at the front of the queue, or @c nullptr if the queue is empty.
+     */
+    std::shared_ptr<avsCommon::avs::AVSDirective> front() const;
+
+    /**
+     * Add a directive to the back of the queue.
+     *
+     * @param directive The directive to add, which must not be @c nullptr.
+     */
+    void pushBack(std::shared_ptr<avsCommon::avs::AVSDirective> directive);
+
+    /**
+     * Remove the directive at the front of the queue, if there is one.
+     */
+    void popFront();
+
+    /**
+     * Remove every copy of a directive from the queue.
+     *
+     * @param directive The directive to remove.
+     * @return Whether the directive was in the queue.
+     */
+    bool erase(const std::shared_ptr<avsCommon::avs::AVSDirective>& directive);
+
+    /**
+     * Move every directive with a @c dialogRequestId from this queue to the back of another, preserving their order.
+     *
+     * @param dialogRequestId The @c dialogRequestId of the directives to move.  Directives with an empty
+     *     @c dialogRequestId are never moved.
+     * @param destination The queue to move the directives to, which must not be this queue.
+     * @return Whether any directives were moved.
+     */
+    bool moveDialogRequestIdTo(const std::string& dialogRequestId, DirectiveQueue* destination);
+
+    /**
+     * Move every directive from this queue to the back of another, preserving their order.
+     *
+     * @param destination The queue to move the directives to, which must not be this queue.
+     */
+    void moveAllTo(DirectiveQueue* destination);
+
+    /**
+     * Remove every directive from the queue.
+     *
+     * @return The directives which were in the queue, in order.
+     */
+    std::vector<std::shared_ptr<avsCommon::avs::AVSDirective>> takeAll();
+
+private:
+    struct Node;
+
+    /// The first and last nodes of a dialog, in queue order.
+    struct DialogNodes {
+        /// The first node of the dialog.
+        Node* first;
+
+        /// The last node of the dialog.
+        Node* last;
+    };
+
+    /// The index from each non-empty @c dialogRequestId to the nodes of its dialog.
+    using DialogIndex = std::unordered_map<std::string, DialogNodes>;
+
+    /// A directive in the queue.
+    struct Node {
+        /// The directive.
+        std::shared_ptr<avsCommon::avs::AVSDirective> directive;
+
+        /// The previous node in the queue, or @c nullptr if this is the front.
+        Node* previous;
+
+        /// The next node in the queue, or @c nullptr if this is the back.
+        Node* next;
+
+        /**
+         * The entry of this node's dialog in @c m_nodesByDialogRequestId, or @c nullptr if the directive has an empty
+         * @c dialogRequestId.  Entries of an @c unordered_map don't move, and this saves copying the
+         * @c dialogRequestId out of the directive to look it up again.
+         */
+        DialogIndex::value_type* dialog;
+
+        /// The previous node of the same dialog, or @c nullptr if this is the first of its dialog.
+        Node* previousInDialog;
+
+        /// The next node of the same dialog, or @c nullptr if this is the last of its dialog.
+        Node* nextInDialog;
+    };
+
+    /**
+     * Get the entry of a dialog in @c m_nodesByDialogRequestId, adding an empty one if there is none.
+     *
+     * @param dialogRequestId The non-empty @c dialogRequestId of the dialog.
+     * @return The entry of the dialog.
+     */
+    DialogIndex::value_type* getDialog(const std::string& dialogRequestId);
+
+    /**
+     * Link a node at the back of the queue, and add it to the indices.
+     *
+     * @param node The node to link, which is not linked to any queue.
+     * @param dialog The entry of the node's dialog in @c m_nodesByDialogRequestId, or @c nullptr if its directive has
+     *     an empty @c dialogRequestId.
+     */
+    void linkNode(Node* node, DialogIndex::value_type* dialog);
+
+    /**
+     * Unlink a node from the queue and from the indices, leaving it to the caller to delete or link elsewhere.
+     *
+     * @param node The node to unlink.
+     */
+    void unlinkNode(Node* node);
+
+    /// The node at the front of the queue, or @c nullptr if the queue is empty.
+    Node* m_front;
+
+    /// The node at the back of the queue, or @c nullptr if the queue is empty.
+    Node* m_back;
+
+    /// The number of nodes in the queue.
+    size_t m_size;
+
+    /// The nodes holding each directive.
+    std::unordered_multimap<const avsCommon::avs::AVSDirective*, Node*> m_nodesByDirective;
+
+    /// The nodes of each non-empty @c dialogRequestId.
+    DialogIndex m_nodesByDialogRequestId;
+};
+
+}  // namespace adsl
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_ADSL_INCLUDE_ADSL_DIRECTIVEQUEUE_H_
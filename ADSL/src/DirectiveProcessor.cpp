@@ -16,7 +16,6 @@
  * limitations under the License.
  */
 
-#include <algorithm>
 #include <iostream>
 #include <sstream>
 
@@ -97,7 +96,7 @@ bool DirectiveProcessor::onDirective(std::shared_ptr<AVSDirective> directive) {
     if (m_directiveBeingPreHandled) {
         m_directiveBeingPreHandled.reset();
         if (handled) {
-            m_handlingQueue.push_back(directive);
+            m_handlingQueue.pushBack(directive);
             m_wakeProcessingLoop.notify_one();
         }
     }
@@ -171,22 +170,17 @@ void DirectiveProcessor::onHandlingFailed(std::shared_ptr<AVSDirective> directiv
 }
 
 void DirectiveProcessor::removeDirectiveLocked(std::shared_ptr<AVSDirective> directive) {
-    auto matches = [directive](std::shared_ptr<AVSDirective> item) { return item == directive; };
+    m_cancelingQueue.erase(directive);
 
-    m_cancelingQueue.erase(
-        std::remove_if(m_cancelingQueue.begin(), m_cancelingQueue.end(), matches), m_cancelingQueue.end());
-
-    if (matches(m_directiveBeingPreHandled)) {
+    if (m_directiveBeingPreHandled == directive) {
         m_directiveBeingPreHandled.reset();
     }
 
-    if (m_isHandlingDirective && !m_handlingQueue.empty() && matches(m_handlingQueue.front())) {
+    if (m_isHandlingDirective && m_handlingQueue.front() == directive) {
         m_isHandlingDirective = false;
-        m_handlingQueue.pop_front();
     }
 
-    m_handlingQueue.erase(
-        std::remove_if(m_handlingQueue.begin(), m_handlingQueue.end(), matches), m_handlingQueue.end());
+    m_handlingQueue.erase(directive);
 
     if (!m_cancelingQueue.empty() || !m_handlingQueue.empty()) {
         m_wakeProcessingLoop.notify_one();
@@ -211,7 +205,7 @@ bool DirectiveProcessor::processCancelingQueueLocked(std::unique_lock<std::mutex
     if (m_cancelingQueue.empty()) {
         return false;
     }
-    std::deque<std::shared_ptr<avsCommon::avs::AVSDirective>> temp(std::move(m_cancelingQueue));
+    auto temp = m_cancelingQueue.takeAll();
     lock.unlock();
     for (auto directive : temp) {
         m_directiveRouter->cancelDirective(directive);
@@ -236,7 +230,7 @@ bool DirectiveProcessor::handleDirectiveLocked(std::unique_lock<std::mutex>& loc
     if (!handled || BlockingPolicy::BLOCKING != policy) {
         m_isHandlingDirective = false;
         if (!m_handlingQueue.empty() && m_handlingQueue.front() == directive) {
-            m_handlingQueue.pop_front();
+            m_handlingQueue.popFront();
         } else if (!handled) {
             ACSDK_ERROR(LX("handlingDirectiveLockedFailed")
                             .d("expected", directive->getMessageId())
@@ -276,7 +270,7 @@ void DirectiveProcessor::scrubDialogRequestIdLocked(const std::string& dialogReq
     if (m_directiveBeingPreHandled) {
         auto id = m_directiveBeingPreHandled->getDialogRequestId();
         if (!id.empty() && id == dialogRequestId) {
-            m_cancelingQueue.push_back(m_directiveBeingPreHandled);
+            m_cancelingQueue.pushBack(m_directiveBeingPreHandled);
             m_directiveBeingPreHandled.reset();
             changed = true;
         }
@@ -293,18 +287,11 @@ void DirectiveProcessor::scrubDialogRequestIdLocked(const std::string& dialogReq
         }
     }
 
-    // Filter matching directives from m_handlingQueue and put them in m_cancelingQueue.
-    std::deque<std::shared_ptr<AVSDirective>> temp;
-    for (auto directive : m_handlingQueue) {
-        auto id = directive->getDialogRequestId();
-        if (!id.empty() && id == dialogRequestId) {
-            m_cancelingQueue.push_back(directive);
-            changed = true;
-        } else {
-            temp.push_back(directive);
-        }
+    // Move matching directives from m_handlingQueue to m_cancelingQueue.  This is indexed by dialogRequestId, so
+    // it doesn't scan the directives of other dialogs.
+    if (m_handlingQueue.moveDialogRequestIdTo(dialogRequestId, &m_cancelingQueue)) {
+        changed = true;
     }
-    std::swap(temp, m_handlingQueue);
 
     // If the dialogRequestId to scrub is the current value, reset the current value.
     if (dialogRequestId == m_dialogRequestId) {
@@ -320,12 +307,11 @@ void DirectiveProcessor::scrubDialogRequestIdLocked(const std::string& dialogReq
 void DirectiveProcessor::queueAllDirectivesForCancellationLocked() {
     m_dialogRequestId.clear();
     if (m_directiveBeingPreHandled) {
-        m_handlingQueue.push_back(m_directiveBeingPreHandled);
+        m_handlingQueue.pushBack(m_directiveBeingPreHandled);
         m_directiveBeingPreHandled.reset();
     }
     if (!m_handlingQueue.empty()) {
-        m_cancelingQueue.insert(m_cancelingQueue.end(), m_handlingQueue.begin(), m_handlingQueue.end());
-        m_handlingQueue.clear();
+        m_handlingQueue.moveAllTo(&m_cancelingQueue);
         m_wakeProcessingLoop.notify_one();
     }
     m_isHandlingDirective = false;
@@ -0,0 +1,203 @@
+/*
+ * DirectiveQueue.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "ADSL/DirectiveQueue.h"
+
+namespace alexaClientSDK {
+namespace adsl {
+
+using namespace avsCommon::avs;
+
+DirectiveQueue::DirectiveQueue() : m_front{nullptr}, m_back{nullptr}, m_size{0} {
+}
+
+DirectiveQueue::~DirectiveQueue() {
+    auto node = m_front;
+    while (node) {
+        auto next = node->next;
+        delete node;
+        node = next;
+    }
+}
+
+bool DirectiveQueue::empty() const {
+    return 0 == m_size;
+}
+
+size_t DirectiveQueue::size() const {
+    return m_size;
+}
+
+std::shared_ptr<AVSDirective> DirectiveQueue::front() const {
+    return m_front ? m_front->directive : nullptr;
+}
+
+void DirectiveQueue::pushBack(std::shared_ptr<AVSDirective> directive) {
+    auto dialogRequestId = directive->getDialogRequestId();
+    auto dialog = dialogRequestId.empty() ? nullptr : getDialog(dialogRequestId);
+    linkNode(new Node{std::move(directive), nullptr, nullptr, nullptr, nullptr, nullptr}, dialog);
+}
+
+void DirectiveQueue::popFront() {
+    if (m_front) {
+        auto node = m_front;
+        unlinkNode(node);
+        delete node;
+    }
+}
+
+bool DirectiveQueue::erase(const std::shared_ptr<AVSDirective>& directive) {
+    auto range = m_nodesByDirective.equal_range(directive.get());
+    if (range.first == range.second) {
+        return false;
+    }
+    std::vector<Node*> nodes;
+    for (auto it = range.first; it != range.second; ++it) {
+        nodes.push_back(it->second);
+    }
+    for (auto node : nodes) {
+        unlinkNode(node);
+        delete node;
+    }
+    return true;
+}
+
+bool DirectiveQueue::moveDialogRequestIdTo(const std::string& dialogRequestId, DirectiveQueue* destination) {
+    if (dialogRequestId.empty()) {
+        return false;
+    }
+    auto it = m_nodesByDialogRequestId.find(dialogRequestId);
+    if (it == m_nodesByDialogRequestId.end()) {
+        return false;
+    }
+    // The nodes are relinked rather than copied, as on barge-in the whole queue may belong to the dialog.
+    auto destinationDialog = destination->getDialog(dialogRequestId);
+    auto node = it->second.first;
+    while (node) {
+        auto next = node->nextInDialog;
+        unlinkNode(node);
+        destination->linkNode(node, destinationDialog);
+        node = next;
+    }
+    return true;
+}
+
+void DirectiveQueue::moveAllTo(DirectiveQueue* destination) {
+    auto node = m_front;
+    while (node) {
+        auto next = node->next;
+        destination->linkNode(node, node->dialog ? destination->getDialog(node->dialog->first) : nullptr);
+        node = next;
+    }
+    m_front = nullptr;
+    m_back = nullptr;
+    m_size = 0;
+    m_nodesByDirective.clear();
+    m_nodesByDialogRequestId.clear();
+}
+
+std::vector<std::shared_ptr<AVSDirective>> DirectiveQueue::takeAll() {
+    std::vector<std::shared_ptr<AVSDirective>> directives;
+    directives.reserve(m_size);
+    auto node = m_front;
+    while (node) {
+        auto next = node->next;
+        directives.push_back(std::move(node->directive));
+        delete node;
+        node = next;
+    }
+    m_front = nullptr;
+    m_back = nullptr;
+    m_size = 0;
+    m_nodesByDirective.clear();
+    m_nodesByDialogRequestId.clear();
+    return directives;
+}
+
+DirectiveQueue::DialogIndex::value_type* DirectiveQueue::getDialog(const std::string& dialogRequestId) {
+    return &*m_nodesByDialogRequestId.insert({dialogRequestId, DialogNodes{nullptr, nullptr}}).first;
+}
+
+void DirectiveQueue::linkNode(Node* node, DialogIndex::value_type* dialog) {
+    node->previous = m_back;
+    node->next = nullptr;
+    if (m_back) {
+        m_back->next = node;
+    } else {
+        m_front = node;
+    }
+    m_back = node;
+    ++m_size;
+
+    m_nodesByDirective.insert({node->directive.get(), node});
+
+    node->dialog = dialog;
+    node->nextInDialog = nullptr;
+    node->previousInDialog = nullptr;
+    if (dialog) {
+        auto& nodes = dialog->second;
+        node->previousInDialog = nodes.last;
+        if (nodes.last) {
+            nodes.last->nextInDialog = node;
+        } else {
+            nodes.first = node;
+        }
+        nodes.last = node;
+    }
+}
+
+void DirectiveQueue::unlinkNode(Node* node) {
+    if (node->previous) {
+        node->previous->next = node->next;
+    } else {
+        m_front = node->next;
+    }
+    if (node->next) {
+        node->next->previous = node->previous;
+    } else {
+        m_back = node->previous;
+    }
+    --m_size;
+
+    auto range = m_nodesByDirective.equal_range(node->directive.get());
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == node) {
+            m_nodesByDirective.erase(it);
+            break;
+        }
+    }
+
+    if (node->dialog) {
+        auto& nodes = node->dialog->second;
+        if (node->previousInDialog) {
+            node->previousInDialog->nextInDialog = node->nextInDialog;
+        } else {
+            nodes.first = node->nextInDialog;
+        }
+        if (node->nextInDialog) {
+            node->nextInDialog->previousInDialog = node->previousInDialog;
+        } else {
+            nodes.last = node->previousInDialog;
+        }
+        if (!nodes.first) {
+            m_nodesByDialogRequestId.erase(m_nodesByDialogRequestId.find(node->dialog->first));
+        }
+    }
+}
+
+}  // namespace adsl
+}  // namespace alexaClientSDK
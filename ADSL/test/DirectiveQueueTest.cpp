@@ -0,0 +1,306 @@
+/*
+ * DirectiveQueueTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file DirectiveQueueTest.cpp
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <AVSCommon/AVS/Attachment/AttachmentManager.h>
+
+#include "ADSL/DirectiveQueue.h"
+
+namespace alexaClientSDK {
+namespace adsl {
+namespace test {
+
+using namespace avsCommon::avs;
+using namespace avsCommon::avs::attachment;
+
+/// A namespace for test directives.
+static const std::string NAMESPACE_TEST("SpeechSynthesizer");
+
+/// A name for test directives.
+static const std::string NAME_TEST("Speak");
+
+/// A dialogRequestId for test directives.
+static const std::string DIALOG_REQUEST_ID_0("DialogRequestId_0");
+
+/// Another dialogRequestId for test directives.
+static const std::string DIALOG_REQUEST_ID_1("DialogRequestId_1");
+
+/// The number of directives queued by the benchmark, as for a long run of Speak and Play directives.
+static const int NUM_BENCHMARK_DIRECTIVES = 1000;
+
+/// The number of times the benchmark repeats each measurement.
+static const int NUM_BENCHMARK_ITERATIONS = 200;
+
+/// Test harness for @c DirectiveQueue.
+class DirectiveQueueTest : public ::testing::Test {
+public:
+    /// Set up the test harness for running a test.
+    void SetUp() override;
+
+protected:
+    /**
+     * Create a directive.
+     *
+     * @param messageId The messageId of the directive.
+     * @param dialogRequestId The dialogRequestId of the directive.
+     * @return The new directive.
+     */
+    std::shared_ptr<AVSDirective> createDirective(const std::string& messageId, const std::string& dialogRequestId);
+
+    /**
+     * Take the messageIds of every directive in a queue, in order.
+     *
+     * @param queue The queue to empty.
+     * @return The messageIds of the directives which were in the queue.
+     */
+    std::vector<std::string> takeMessageIds(DirectiveQueue* queue);
+
+    /// AttachmentManager with which to create directives.
+    std::shared_ptr<AttachmentManager> m_attachmentManager;
+};
+
+void DirectiveQueueTest::SetUp() {
+    m_attachmentManager = std::make_shared<AttachmentManager>(AttachmentManager::AttachmentType::IN_PROCESS);
+}
+
+std::shared_ptr<AVSDirective> DirectiveQueueTest::createDirective(
+    const std::string& messageId,
+    const std::string& dialogRequestId) {
+    auto header = std::make_shared<AVSMessageHeader>(NAMESPACE_TEST, NAME_TEST, messageId, dialogRequestId);
+    return AVSDirective::create("", header, "", m_attachmentManager, "");
+}
+
+std::vector<std::string> DirectiveQueueTest::takeMessageIds(DirectiveQueue* queue) {
+    std::vector<std::string> messageIds;
+    for (auto& directive : queue->takeAll()) {
+        messageIds.push_back(directive->getMessageId());
+    }
+    return messageIds;
+}
+
+/**
+ * Verify that directives come out of the queue in the order they went in.
+ */
+TEST_F(DirectiveQueueTest, fifoOrder) {
+    DirectiveQueue queue;
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.front(), nullptr);
+    queue.popFront();
+
+    auto a = createDirective("a", DIALOG_REQUEST_ID_0);
+    auto b = createDirective("b", "");
+    auto c = createDirective("c", DIALOG_REQUEST_ID_1);
+    queue.pushBack(a);
+    queue.pushBack(b);
+    queue.pushBack(c);
+    EXPECT_EQ(queue.size(), 3u);
+    EXPECT_EQ(queue.front(), a);
+    queue.popFront();
+    EXPECT_EQ(queue.front(), b);
+    queue.popFront();
+    EXPECT_EQ(queue.front(), c);
+    queue.popFront();
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.front(), nullptr);
+}
+
+/**
+ * Verify that erasing a directive removes every copy of it from anywhere in the queue, and leaves the rest in order.
+ */
+TEST_F(DirectiveQueueTest, erase) {
+    DirectiveQueue queue;
+    auto a = createDirective("a", DIALOG_REQUEST_ID_0);
+    auto b = createDirective("b", DIALOG_REQUEST_ID_0);
+    auto c = createDirective("c", "");
+    queue.pushBack(a);
+    queue.pushBack(b);
+    queue.pushBack(c);
+    queue.pushBack(b);
+
+    EXPECT_FALSE(queue.erase(createDirective("b", DIALOG_REQUEST_ID_0)));
+    EXPECT_TRUE(queue.erase(b));
+    EXPECT_FALSE(queue.erase(b));
+    EXPECT_EQ(queue.size(), 2u);
+
+    // The dialog index must no longer hold the erased directive.
+    DirectiveQueue canceled;
+    EXPECT_TRUE(queue.moveDialogRequestIdTo(DIALOG_REQUEST_ID_0, &canceled));
+    EXPECT_EQ(takeMessageIds(&canceled), std::vector<std::string>({"a"}));
+    EXPECT_EQ(takeMessageIds(&queue), std::vector<std::string>({"c"}));
+}
+
+/**
+ * Verify that moving a dialog moves exactly its directives, in order, and leaves those of other dialogs and those
+ * without a dialogRequestId in order.
+ */
+TEST_F(DirectiveQueueTest, moveDialogRequestId) {
+    DirectiveQueue queue;
+    queue.pushBack(createDirective("a", DIALOG_REQUEST_ID_0));
+    queue.pushBack(createDirective("b", DIALOG_REQUEST_ID_1));
+    queue.pushBack(createDirective("c", ""));
+    queue.pushBack(createDirective("d", DIALOG_REQUEST_ID_0));
+    queue.pushBack(createDirective("e", DIALOG_REQUEST_ID_1));
+    queue.pushBack(createDirective("f", DIALOG_REQUEST_ID_0));
+
+    DirectiveQueue canceled;
+    canceled.pushBack(createDirective("z", ""));
+    EXPECT_FALSE(queue.moveDialogRequestIdTo("", &canceled));
+    EXPECT_FALSE(queue.moveDialogRequestIdTo("unknown", &canceled));
+    EXPECT_TRUE(queue.moveDialogRequestIdTo(DIALOG_REQUEST_ID_0, &canceled));
+    EXPECT_FALSE(queue.moveDialogRequestIdTo(DIALOG_REQUEST_ID_0, &canceled));
+    EXPECT_EQ(queue.size(), 3u);
+    EXPECT_EQ(takeMessageIds(&canceled), std::vector<std::string>({"z", "a", "d", "f"}));
+
+    // Directives added after a dialog was moved start a new entry in the index.
+    queue.pushBack(createDirective("g", DIALOG_REQUEST_ID_0));
+    EXPECT_TRUE(queue.moveDialogRequestIdTo(DIALOG_REQUEST_ID_0, &canceled));
+    EXPECT_EQ(takeMessageIds(&canceled), std::vector<std::string>({"g"}));
+    EXPECT_EQ(takeMessageIds(&queue), std::vector<std::string>({"b", "c", "e"}));
+}
+
+/**
+ * Verify that moving everything appends the whole queue to the destination, and leaves the indices of both consistent.
+ */
+TEST_F(DirectiveQueueTest, moveAll) {
+    DirectiveQueue queue;
+    auto a = createDirective("a", DIALOG_REQUEST_ID_0);
+    queue.pushBack(a);
+    queue.pushBack(createDirective("b", ""));
+    DirectiveQueue canceled;
+    canceled.pushBack(createDirective("c", DIALOG_REQUEST_ID_0));
+
+    queue.moveAllTo(&canceled);
+    EXPECT_TRUE(queue.empty());
+    EXPECT_FALSE(queue.erase(a));
+    EXPECT_EQ(canceled.size(), 3u);
+    EXPECT_TRUE(canceled.erase(a));
+
+    DirectiveQueue dialog;
+    EXPECT_TRUE(canceled.moveDialogRequestIdTo(DIALOG_REQUEST_ID_0, &dialog));
+    EXPECT_EQ(takeMessageIds(&dialog), std::vector<std::string>({"c"}));
+    EXPECT_EQ(takeMessageIds(&canceled), std::vector<std::string>({"b"}));
+}
+
+/**
+ * Compare the time taken to cancel work on barge-in with a thousand directives queued, using @c DirectiveQueue and
+ * using the @c std::deque scans it replaced in @c DirectiveProcessor.
+ *
+ * Three operations are timed: completing the directive at the back of the queue, which used to scan both queues;
+ * canceling a dialog of ten directives queued behind a thousand which have no dialogRequestId; and canceling a dialog
+ * of a thousand directives, which is linear either way.
+ */
+TEST_F(DirectiveQueueTest, DISABLED_bargeInCancelLatency) {
+    std::vector<std::shared_ptr<AVSDirective>> background;
+    std::vector<std::shared_ptr<AVSDirective>> dialog;
+    std::vector<std::shared_ptr<AVSDirective>> longDialog;
+    for (int i = 0; i < NUM_BENCHMARK_DIRECTIVES; ++i) {
+        background.push_back(createDirective("background" + std::to_string(i), ""));
+        longDialog.push_back(createDirective("long" + std::to_string(i), DIALOG_REQUEST_ID_1));
+    }
+    for (int i = 0; i < 10; ++i) {
+        dialog.push_back(createDirective("dialog" + std::to_string(i), DIALOG_REQUEST_ID_0));
+    }
+
+    // Time only the operation, not the setup before it.
+    auto measure = [](std::function<void()> setUp, std::function<void()> operation) {
+        std::chrono::steady_clock::duration total{0};
+        for (int i = 0; i < NUM_BENCHMARK_ITERATIONS; ++i) {
+            setUp();
+            auto start = std::chrono::steady_clock::now();
+            operation();
+            total += std::chrono::steady_clock::now() - start;
+        }
+        return std::chrono::duration<double, std::micro>(total).count() / NUM_BENCHMARK_ITERATIONS;
+    };
+
+    std::deque<std::shared_ptr<AVSDirective>> dequeHandling;
+    std::deque<std::shared_ptr<AVSDirective>> dequeCanceling;
+    DirectiveQueue handling;
+    DirectiveQueue canceling;
+    auto fillDeque = [&](const std::vector<std::shared_ptr<AVSDirective>>& first,
+                         const std::vector<std::shared_ptr<AVSDirective>>& second) {
+        dequeHandling.assign(first.begin(), first.end());
+        dequeHandling.insert(dequeHandling.end(), second.begin(), second.end());
+        dequeCanceling.clear();
+    };
+    auto fillQueue = [&](const std::vector<std::shared_ptr<AVSDirective>>& first,
+                         const std::vector<std::shared_ptr<AVSDirective>>& second) {
+        handling.takeAll();
+        canceling.takeAll();
+        for (auto& directive : first) {
+            handling.pushBack(directive);
+        }
+        for (auto& directive : second) {
+            handling.pushBack(directive);
+        }
+    };
+    auto dequeScrub = [&](const std::string& dialogRequestId) {
+        std::deque<std::shared_ptr<AVSDirective>> temp;
+        for (auto directive : dequeHandling) {
+            auto id = directive->getDialogRequestId();
+            if (!id.empty() && id == dialogRequestId) {
+                dequeCanceling.push_back(directive);
+            } else {
+                temp.push_back(directive);
+            }
+        }
+        std::swap(temp, dequeHandling);
+    };
+    auto target = dialog.back();
+    auto dequeErase = [&] {
+        auto matches = [&target](const std::shared_ptr<AVSDirective>& item) { return item == target; };
+        dequeCanceling.erase(
+            std::remove_if(dequeCanceling.begin(), dequeCanceling.end(), matches), dequeCanceling.end());
+        dequeHandling.erase(std::remove_if(dequeHandling.begin(), dequeHandling.end(), matches), dequeHandling.end());
+    };
+
+    auto dequeComplete = measure([&] { fillDeque(background, dialog); }, dequeErase);
+    auto queueComplete = measure([&] { fillQueue(background, dialog); }, [&] { handling.erase(target); });
+    auto dequeCancel =
+        measure([&] { fillDeque(background, dialog); }, [&] { dequeScrub(DIALOG_REQUEST_ID_0); });
+    auto queueCancel = measure(
+        [&] { fillQueue(background, dialog); },
+        [&] { handling.moveDialogRequestIdTo(DIALOG_REQUEST_ID_0, &canceling); });
+    auto dequeLongCancel =
+        measure([&] { fillDeque(longDialog, dialog); }, [&] { dequeScrub(DIALOG_REQUEST_ID_1); });
+    auto queueLongCancel = measure(
+        [&] { fillQueue(longDialog, dialog); },
+        [&] { handling.moveDialogRequestIdTo(DIALOG_REQUEST_ID_1, &canceling); });
+
+    std::cout << "Microseconds with " << NUM_BENCHMARK_DIRECTIVES << " directives queued (deque / DirectiveQueue):"
+              << std::endl
+              << "  complete one directive: " << dequeComplete << " / " << queueComplete << std::endl
+              << "  cancel a dialog of " << dialog.size() << ": " << dequeCancel << " / " << queueCancel << std::endl
+              << "  cancel a dialog of " << longDialog.size() << ": " << dequeLongCancel << " / " << queueLongCancel
+              << std::endl;
+}
+
+}  // namespace test
+}  // namespace adsl
+}  // namespace alexaClientSDK
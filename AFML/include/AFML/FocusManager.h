@@ -222,7 +222,8 @@ private:
     std::mutex m_mutex;
 
     /**
-     * @c Executor which queues up operations from asynchronous API calls.
+     * @c Executor which queues up operations from asynchronous API calls.  It has a thread of its own, as channel
+     * observers may block in @c onFocusChanged() until their own executors have acted on the change.
      *
      * @note This declaration needs to come *after* the Executor Thread Variables so that the thread shuts down
      *     before the Executor Thread Variables are destroyed.
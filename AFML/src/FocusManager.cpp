@@ -35,7 +35,8 @@ static const std::string TAG("FocusManager");
  */
 #define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
 
-FocusManager::FocusManager(const std::vector<ChannelConfiguration>& channelConfigurations) {
+FocusManager::FocusManager(const std::vector<ChannelConfiguration>& channelConfigurations) :
+        m_executor{threading::Executor::ThreadPolicy::DEDICATED} {
     for (auto config : channelConfigurations) {
         if (doesChannelNameExist(config.name)) {
             ACSDK_ERROR(LX("createChannelFailed").d("reason", "channelNameExists").d("config", config.toString()));
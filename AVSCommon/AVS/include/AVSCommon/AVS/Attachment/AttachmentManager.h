@@ -18,7 +18,10 @@
 #ifndef ALEXA_CLIENT_SDK_AVSCOMMON_AVS_INCLUDE_AVSCOMMON_AVS_ATTACHMENT_ATTACHMENTMANAGER_H_
 #define ALEXA_CLIENT_SDK_AVSCOMMON_AVS_INCLUDE_AVSCOMMON_AVS_ATTACHMENT_ATTACHMENTMANAGER_H_
 
+#include <atomic>
+#include <memory>
 #include <mutex>
+#include <string>
 #include <unordered_map>
 
 #include "AVSCommon/AVS/Attachment/AttachmentManagerInterface.h"
@@ -43,7 +46,8 @@ namespace attachment {
  *    buffer will remain in existence until both the Reader and Writer have been destroyed.
  *  @li Therefore, application code should ensure that Readers and Writers are destroyed when no longer needed.
  *  @li The AttachmentManager will always satisfy a request to create a Reader or Writer - it will not currently
- *    enforce a maximum resource limit.
+ *    enforce a maximum resource limit.  It can however bound the memory attachments use, by spilling the data which
+ *    does not fit to disk (see @c MemoryPolicy).
  *  @li ACSDK-254 will address this by enforcing such limits.  It should also be noted however, that a well
  *    behaving application may not observe much difference - the future implementation will forcibly close
  *    the oldest Attachment to make space for the new one.  For a system reading and writing a small set of attachments
@@ -74,12 +78,58 @@ public:
     };
 
     /**
-     * Constructor.
+     * The limits on the memory used by the buffers of in-process attachments.
+     *
+     * Without a spill directory, an attachment's writer is told its buffer is full once it gets ahead of the reader by
+     * @c maxMemoryPerAttachmentInBytes, and has to wait for the reader to catch up.  With a spill directory, the writer
+     * instead continues writing to a temporary file in that directory, and the reader continues from the file once it
+     * has read the buffer.  Attachments created while the buffers of existing ones already take up
+     * @c maxTotalMemoryInBytes then get a buffer of only @c SPILL_BUFFER_MINIMUM_SIZE_IN_BYTES, and spill early.
+     *
+     * The policy can also be set in the "attachmentManager" node of the configuration, with the keys
+     * "maxMemoryPerAttachmentInBytes", "maxTotalMemoryInBytes" and "spillDirectory".
+     */
+    struct MemoryPolicy {
+        /**
+         * Constructor, setting the policy attachments had before spilling was supported.
+         */
+        MemoryPolicy();
+
+        /// The size of the buffer of each attachment.
+        size_t maxMemoryPerAttachmentInBytes;
+
+        /// The total size of the buffers of all attachments, or zero for no limit.  Only applied when spilling.
+        size_t maxTotalMemoryInBytes;
+
+        /// The directory to spill attachments to, or empty to never spill.
+        std::string spillDirectory;
+    };
+
+    /// The smallest buffer an attachment is given, including when the total memory limit has been reached.
+    static constexpr size_t SPILL_BUFFER_MINIMUM_SIZE_IN_BYTES = 0x1000;
+
+    /**
+     * Constructor.  The memory policy is read from the configuration, if it has an "attachmentManager" node.
      *
      * @param attachmentType The type of attachments which will be managed.
      */
     AttachmentManager(AttachmentType attachmentType);
 
+    /**
+     * Set the memory policy for attachments created after this call.
+     *
+     * @param policy The new policy.
+     * @return Whether the policy was valid, and set.
+     */
+    bool setMemoryPolicy(const MemoryPolicy& policy);
+
+    /**
+     * Get the number of bytes used by the buffers of the attachments created by this manager which still exist.
+     *
+     * @return The number of bytes used by attachment buffers.
+     */
+    size_t getMemoryInUse() const;
+
     std::string generateAttachmentId(const std::string& contextId, const std::string& contentId) const override;
 
     bool setAttachmentTimeoutMinutes(std::chrono::minutes timeoutMinutes) override;
@@ -123,8 +173,25 @@ private:
      */
     void removeExpiredAttachmentsLocked();
 
+    /**
+     * Create an in-process attachment with a buffer and spill file according to @c m_memoryPolicy.
+     *
+     * @note The class mutex @c m_mutex must be locked before calling this function.
+     *
+     * @param attachmentId The id of the attachment.
+     * @return The new attachment.
+     */
+    std::unique_ptr<Attachment> createInProcessAttachmentLocked(const std::string& attachmentId);
+
     /// The type of attachments that this manager will create.
     AttachmentType m_attachmentType;
+    /// The memory policy for new attachments.
+    MemoryPolicy m_memoryPolicy;
+    /**
+     * The number of bytes used by attachment buffers.  Shared with the buffers, which may outlive the manager, and
+     * which decrement it when they are freed.
+     */
+    std::shared_ptr<std::atomic<size_t>> m_memoryInUse;
     /// The timeout in minutes.  Any attachment whose lifetime exceeds this value will be released.
     std::chrono::minutes m_attachmentExpirationMinutes;
     /// The mutex to ensure the non-static public APIs are thread safe.
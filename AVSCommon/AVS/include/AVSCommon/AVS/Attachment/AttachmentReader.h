@@ -20,6 +20,9 @@
 
 #include <chrono>
 #include <cstddef>
+#include <memory>
+
+#include "AVSCommon/Utils/SDS/ReadinessNotifier.h"
 
 namespace alexaClientSDK {
 namespace avsCommon {
@@ -109,6 +112,17 @@ public:
      * @param closePoint The point at which the reader should stop reading from the attachment.
      */
     virtual void close(ClosePoint closePoint = ClosePoint::AFTER_DRAINING_CURRENT_BUFFER) = 0;
+
+    /**
+     * Get a notifier which is signalled when data may have become available to @c read(), or the attachment may have
+     * closed.  This lets a consumer running an event loop wait for data instead of polling.  Readers which can't
+     * provide one return @c nullptr, and consumers must then fall back to polling.
+     *
+     * @return A notifier for this reader, or @c nullptr if none is available.
+     */
+    virtual std::shared_ptr<utils::sds::ReadinessNotifier> getReadinessNotifier() {
+        return nullptr;
+    }
 };
 
 }  // namespace attachment
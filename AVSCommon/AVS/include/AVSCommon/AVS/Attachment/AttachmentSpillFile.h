@@ -0,0 +1,188 @@
+/*
+ * AttachmentSpillFile.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVSCOMMON_AVS_INCLUDE_AVSCOMMON_AVS_ATTACHMENT_ATTACHMENTSPILLFILE_H_
+#define ALEXA_CLIENT_SDK_AVSCOMMON_AVS_INCLUDE_AVSCOMMON_AVS_ATTACHMENT_ATTACHMENTSPILLFILE_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "AVSCommon/Utils/SDS/ReadinessNotifier.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace avs {
+namespace attachment {
+
+/**
+ * The overflow of an @c InProcessAttachment whose in-memory buffer has filled up.
+ *
+ * Once the writer of the attachment can't write to its buffer without overwriting unread data, it starts spilling:
+ * that write and every later one are appended to a temporary file instead, and the reader carries on from the file
+ * once it has read the buffer up to the index at which spilling started.  This means a slow or absent reader no
+ * longer holds up the writer, which for attachments parsed from the downchannel would otherwise stall every other
+ * directive behind it.
+ *
+ * The file is created in the given directory when spilling starts, and is unlinked straight away so that it is
+ * removed however the process exits.  The writer also uses this object to wake the reader, as a reader blocked on the
+ * buffer would otherwise not notice that data is now arriving in the file.
+ */
+class AttachmentSpillFile {
+public:
+    /**
+     * Create an @c AttachmentSpillFile.  No file is created until @c startSpilling() is called.
+     *
+     * @param directory The directory to create the file in.
+     * @return The new @c AttachmentSpillFile, or @c nullptr if @c directory is empty.
+     */
+    static std::shared_ptr<AttachmentSpillFile> create(const std::string& directory);
+
+    /**
+     * Destructor.  Closes the file, which removes it.
+     */
+    ~AttachmentSpillFile();
+
+    /**
+     * Create the file, and record the index of the attachment's buffer at which the data continues in it.  Called by
+     * the writer, once.
+     *
+     * @param startIndex The index of the buffer at which spilling starts.
+     * @return Whether the file was created.
+     */
+    bool startSpilling(uint64_t startIndex);
+
+    /**
+     * Get the index of the attachment's buffer at which the data continues in the file.
+     *
+     * @param[out] startIndex The index at which spilling started.
+     * @return Whether spilling has started.
+     */
+    bool getSpillStart(uint64_t* startIndex) const;
+
+    /**
+     * Append data to the file.  Called by the writer after @c startSpilling().
+     *
+     * @param data The data to append.
+     * @param size The number of bytes to append.
+     * @return Whether all of the data was appended.
+     */
+    bool append(const void* data, size_t size);
+
+    /**
+     * Read data from the file without blocking.
+     *
+     * @param offset The offset in the file to read from.
+     * @param buf The buffer to read into.
+     * @param size The maximum number of bytes to read.
+     * @return The number of bytes read, which is zero if no data has been appended at @c offset yet.
+     */
+    size_t read(uint64_t offset, void* buf, size_t size);
+
+    /**
+     * Get the number of bytes appended to the file so far.
+     *
+     * @return The size of the file.
+     */
+    uint64_t getSize() const;
+
+    /**
+     * Record that the writer has finished, and wake the reader.
+     */
+    void close();
+
+    /**
+     * Get whether the writer has finished.
+     *
+     * @return Whether @c close() has been called.
+     */
+    bool isClosed() const;
+
+    /**
+     * Get a count of the writes to the attachment, to pass to @c waitForWrite().
+     *
+     * @return The number of writes so far.
+     */
+    uint64_t getWriteCount() const;
+
+    /**
+     * Record that the writer has written to the attachment, to its buffer or to the file, and wake the reader.
+     */
+    void notifyWrite();
+
+    /**
+     * Wait for the writer to write to the attachment or to finish.
+     *
+     * @param writeCount The count returned by @c getWriteCount() before the reader last found no data.
+     * @param timeout The maximum time to wait, or zero to wait forever.
+     * @return Whether there was a write or the writer finished before the timeout.
+     */
+    bool waitForWrite(uint64_t writeCount, std::chrono::milliseconds timeout);
+
+    /**
+     * Add a notifier to signal on each write, so that a reader polling its descriptor sees data arriving in the file.
+     *
+     * @param notifier The notifier to signal.
+     */
+    void addReadinessNotifier(std::shared_ptr<utils::sds::ReadinessNotifier> notifier);
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param directory The directory to create the file in.
+     */
+    AttachmentSpillFile(const std::string& directory);
+
+    /// The directory to create the file in.
+    const std::string m_directory;
+
+    /// Mutex serializing access to the members below.
+    mutable std::mutex m_mutex;
+
+    /// Notified on each write, and when the writer finishes.
+    std::condition_variable m_writeTrigger;
+
+    /// The descriptor of the file, or -1 if spilling has not started.
+    int m_fd;
+
+    /// The index of the attachment's buffer at which spilling started.
+    uint64_t m_startIndex;
+
+    /// The number of bytes appended to the file.
+    uint64_t m_size;
+
+    /// The number of writes to the attachment.
+    uint64_t m_writeCount;
+
+    /// Whether the writer has finished.
+    bool m_isClosed;
+
+    /// The notifiers to signal on each write.
+    std::vector<std::weak_ptr<utils::sds::ReadinessNotifier>> m_notifiers;
+};
+
+}  // namespace attachment
+}  // namespace avs
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVSCOMMON_AVS_INCLUDE_AVSCOMMON_AVS_ATTACHMENT_ATTACHMENTSPILLFILE_H_
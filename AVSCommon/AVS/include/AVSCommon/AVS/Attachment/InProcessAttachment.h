@@ -19,6 +19,7 @@
 #define ALEXA_CLIENT_SDK_AVSCOMMON_AVS_INCLUDE_AVSCOMMON_AVS_ATTACHMENT_INPROCESSATTACHMENT_H_
 
 #include "AVSCommon/AVS/Attachment/Attachment.h"
+#include "AVSCommon/AVS/Attachment/AttachmentSpillFile.h"
 #include "AVSCommon/AVS/Attachment/InProcessAttachmentReader.h"
 #include "AVSCommon/AVS/Attachment/InProcessAttachmentWriter.h"
 
@@ -46,8 +47,13 @@ public:
      *
      * @param id The attachment id.
      * @param sds The underlying @c SharedDataStream object.  If not specified, then this class will create its own.
+     * @param spillFile The file to continue the attachment in once @c sds is full.  If not specified, the writer is
+     *     told when @c sds is full instead.
      */
-    InProcessAttachment(const std::string& id, std::unique_ptr<SDSType> sds = nullptr);
+    InProcessAttachment(
+        const std::string& id,
+        std::unique_ptr<SDSType> sds = nullptr,
+        std::shared_ptr<AttachmentSpillFile> spillFile = nullptr);
 
     std::unique_ptr<AttachmentWriter> createWriter() override;
 
@@ -56,6 +62,9 @@ public:
 private:
     // The sds from which we will create the reader and writer.
     std::shared_ptr<SDSType> m_sds;
+
+    /// The file to continue the attachment in once @c m_sds is full, or @c nullptr.
+    std::shared_ptr<AttachmentSpillFile> m_spillFile;
 };
 
 }  // namespace attachment
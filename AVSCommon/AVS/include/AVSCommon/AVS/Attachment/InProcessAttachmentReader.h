@@ -22,6 +22,7 @@
 #include "AVSCommon/Utils/SDS/Reader.h"
 
 #include "AttachmentReader.h"
+#include "AttachmentSpillFile.h"
 
 namespace alexaClientSDK {
 namespace avsCommon {
@@ -49,6 +50,8 @@ public:
      * @param index If being constructed from an existing @c SharedDataStream, the index indicates where to read from.
      * @param reference The position in the stream @c offset is applied to.  This parameter defaults to 0, indicating
      *     no offset from the specified reference.
+     * @param spillFile The file the attachment's writer continues in once @c sds is full, or @c nullptr if it does
+     *     not spill.
      * @return Returns a new InProcessAttachmentReader, or nullptr if the operation failed.  This parameter defaults
      *     to @c ABSOLUTE, indicating offset is relative to the very beginning of the Attachment.
      */
@@ -56,7 +59,8 @@ public:
         Policy policy,
         std::shared_ptr<SDSType> sds,
         SDSTypeIndex offset = 0,
-        SDSTypeReader::Reference reference = SDSTypeReader::Reference::ABSOLUTE);
+        SDSTypeReader::Reference reference = SDSTypeReader::Reference::ABSOLUTE,
+        std::shared_ptr<AttachmentSpillFile> spillFile = nullptr);
 
     /**
      * Destructor.
@@ -73,17 +77,63 @@ public:
 
     bool seek(uint64_t offset) override;
 
+    /**
+     * @copydoc AttachmentReader::getReadinessNotifier()
+     *
+     * @note The notifier is only signalled by writers in this process, which is always the case for in-process
+     *     attachments.
+     */
+    std::shared_ptr<utils::sds::ReadinessNotifier> getReadinessNotifier() override;
+
 private:
     /**
      * Constructor.
      *
      * @param policy The @c AttachmentReader::Policy of this object.
      * @param sds The underlying @c SharedDataStream which this object will use.
+     * @param spillFile The file the attachment's writer continues in once @c sds is full, or @c nullptr.
+     */
+    InProcessAttachmentReader(
+        Policy policy,
+        std::shared_ptr<SDSType> sds,
+        std::shared_ptr<AttachmentSpillFile> spillFile);
+
+    /**
+     * Read from an attachment which may spill, from the @c SharedDataStream up to the index at which spilling started
+     * and from the spill file after it.
+     *
+     * @param buf The buffer to read into.
+     * @param numWords The maximum number of words to read.
+     * @param[out] readStatus The status of the read.
+     * @param timeoutMs The maximum time to wait for data if the policy is @c BLOCKING, or zero to wait forever.
+     * @return The number of bytes read.
      */
-    InProcessAttachmentReader(Policy policy, std::shared_ptr<SDSType> sds);
+    std::size_t readWithSpill(
+        void* buf,
+        std::size_t numWords,
+        ReadStatus* readStatus,
+        std::chrono::milliseconds timeoutMs);
+
+    /// The @c AttachmentReader::Policy of this object.
+    const Policy m_policy;
 
     /// The underlying @c SharedDataStream reader.
     std::shared_ptr<SDSTypeReader> m_reader;
+
+    /// The file the attachment's writer continues in once the @c SharedDataStream is full, or @c nullptr.
+    std::shared_ptr<AttachmentSpillFile> m_spillFile;
+
+    /// The offset in @c m_spillFile to read from next.
+    uint64_t m_spillReadOffset;
+
+    /// Whether reads from @c m_spillFile stop at @c m_spillReadLimit, because the reader was closed after draining.
+    bool m_hasSpillReadLimit;
+
+    /// The offset in @c m_spillFile at which reads stop, if @c m_hasSpillReadLimit.
+    uint64_t m_spillReadLimit;
+
+    /// Whether the reader was closed immediately.
+    bool m_isClosed;
 };
 
 }  // namespace attachment
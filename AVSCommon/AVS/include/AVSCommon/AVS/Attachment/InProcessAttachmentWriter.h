@@ -21,6 +21,7 @@
 #include "AVSCommon/Utils/SDS/InProcessSDS.h"
 #include "AVSCommon/Utils/SDS/Writer.h"
 
+#include "AttachmentSpillFile.h"
 #include "AttachmentWriter.h"
 
 namespace alexaClientSDK {
@@ -43,9 +44,13 @@ public:
      * Create an InProcessAttachmentWriter.
      *
      * @param sds The underlying @c SharedDataStream which this object will use.
+     * @param spillFile The file to continue writing to once @c sds is full, or @c nullptr to report
+     *     @c OK_BUFFER_FULL instead.
      * @return Returns a new InProcessAttachmentWriter, or nullptr if the operation failed.
      */
-    static std::unique_ptr<InProcessAttachmentWriter> create(std::shared_ptr<SDSType> sds);
+    static std::unique_ptr<InProcessAttachmentWriter> create(
+        std::shared_ptr<SDSType> sds,
+        std::shared_ptr<AttachmentSpillFile> spillFile = nullptr);
 
     /**
      * Destructor.
@@ -61,11 +66,29 @@ protected:
      * Constructor.
      *
      * @param sds The underlying @c SharedDataStream which this object will use.
+     * @param spillFile The file to continue writing to once @c sds is full, or @c nullptr.
      */
-    InProcessAttachmentWriter(std::shared_ptr<SDSType> sds);
+    InProcessAttachmentWriter(std::shared_ptr<SDSType> sds, std::shared_ptr<AttachmentSpillFile> spillFile = nullptr);
+
+    /**
+     * Write whole words to the spill file, starting to spill if this is the first write which did not fit in the
+     * underlying @c SharedDataStream.
+     *
+     * @param buf The data to write.
+     * @param numBytes The number of bytes to write, which must be a multiple of the word size.
+     * @param[out] writeStatus The status of the write.
+     * @return The number of bytes written.
+     */
+    std::size_t spill(const void* buf, std::size_t numBytes, WriteStatus* writeStatus);
 
     /// The underlying @c SharedDataStream reader.
     std::shared_ptr<SDSTypeWriter> m_writer;
+
+    /// The file to continue writing to once the @c SharedDataStream is full, or @c nullptr.
+    std::shared_ptr<AttachmentSpillFile> m_spillFile;
+
+    /// Whether writes are going to @c m_spillFile.
+    bool m_isSpilling;
 };
 
 }  // namespace attachment
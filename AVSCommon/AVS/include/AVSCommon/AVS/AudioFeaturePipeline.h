@@ -0,0 +1,171 @@
+/*
+ * AudioFeaturePipeline.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVSCOMMON_AVS_INCLUDE_AVSCOMMON_AVS_AUDIOFEATUREPIPELINE_H_
+#define ALEXA_CLIENT_SDK_AVSCOMMON_AVS_INCLUDE_AVSCOMMON_AVS_AUDIOFEATUREPIPELINE_H_
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "AVSCommon/AVS/AudioInputStream.h"
+#include "AVSCommon/Utils/Audio/FeatureExtractor.h"
+#include "AVSCommon/Utils/AudioFormat.h"
+#include "AVSCommon/Utils/SDS/InProcessSDS.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace avs {
+
+/**
+ * A stage which reads an @c AudioInputStream once and publishes the @c AudioFeatures of each frame into a feature
+ * stream, so that any number of consumers (keyword detector gating, end-pointing, level metering...) share one
+ * extraction instead of each reading the audio and computing FFTs of its own.
+ *
+ * Frames are @c frameSize samples long and start every @c hopSize samples, at audio indices which are multiples of
+ * @c hopSize.  Word @c i of the feature stream holds the frame starting at audio index @c getAudioIndex(i), so a
+ * consumer can line up features with the audio, for instance with the index of a wake word.  When the stage falls so
+ * far behind that audio is overwritten before it is read, the frames of the lost audio are published zeroed and not
+ * valid, which keeps the indices lined up.
+ *
+ * The feature stream is written with a @c NONBLOCKABLE writer, so as with the audio, a consumer which falls behind
+ * is overrun rather than holding up the others.  It is closed when the audio stream closes.
+ */
+class AudioFeaturePipeline {
+public:
+    /// The stream features are published to, with one @c AudioFeatures per word.
+    using FeatureStream = utils::sds::InProcessSDS;
+
+    /**
+     * Create an @c AudioFeaturePipeline, which starts reading straight away from the oldest audio in the stream.
+     *
+     * @param audioStream The stream to read audio from.
+     * @param audioFormat The format of the audio, which must be 16 bit mono LPCM in the byte order of the platform.
+     * @param frameSize The number of samples per frame.  Must be a power of two of at least
+     *     @c FeatureExtractor::MIN_FRAME_SIZE.
+     * @param hopSize The number of samples between the starts of consecutive frames.  Must be between one and
+     *     @c frameSize.
+     * @param numFrames The number of frames the feature stream holds.
+     * @param maxConsumers The maximum number of readers of the feature stream.
+     * @return The new @c AudioFeaturePipeline, or @c nullptr if the parameters are invalid.
+     */
+    static std::unique_ptr<AudioFeaturePipeline> create(
+        std::shared_ptr<AudioInputStream> audioStream,
+        utils::AudioFormat audioFormat,
+        size_t frameSize,
+        size_t hopSize,
+        size_t numFrames,
+        size_t maxConsumers);
+
+    /**
+     * Destructor.  Stops reading audio, which may take until the read in progress times out.
+     */
+    ~AudioFeaturePipeline();
+
+    /**
+     * Get the stream the features are published to.  Consumers read it with readers of their own.
+     *
+     * @return The feature stream.
+     */
+    std::shared_ptr<FeatureStream> getFeatureStream() const;
+
+    /**
+     * Get the audio index a frame starts at.
+     *
+     * @param featureIndex The index of the frame in the feature stream.
+     * @return The index in the audio stream of the first sample of the frame.
+     */
+    AudioInputStream::Index getAudioIndex(FeatureStream::Index featureIndex) const;
+
+    /**
+     * Get the first frame starting at or after an audio index.
+     *
+     * @param audioIndex The index in the audio stream.
+     * @return The index in the feature stream of the frame.
+     */
+    FeatureStream::Index getFeatureIndex(AudioInputStream::Index audioIndex) const;
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param audioReader The reader of the audio stream, positioned at the start of the first frame.
+     * @param extractor The extractor to compute features with.
+     * @param hopSize The number of samples between the starts of consecutive frames.
+     * @param featureStream The stream to publish features to.
+     * @param featureWriter The writer of @c featureStream.
+     */
+    AudioFeaturePipeline(
+        std::unique_ptr<AudioInputStream::Reader> audioReader,
+        std::unique_ptr<utils::audio::FeatureExtractor> extractor,
+        size_t hopSize,
+        std::shared_ptr<FeatureStream> featureStream,
+        std::unique_ptr<FeatureStream::Writer> featureWriter);
+
+    /**
+     * Reads audio and publishes features until the audio stream closes or the pipeline is destroyed.
+     */
+    void processLoop();
+
+    /**
+     * Recover from the audio being overrun: publish invalid frames in place of those whose audio was lost, and move
+     * the reader to the start of the next frame whose audio has not been written yet.
+     *
+     * @return Whether the reader could be moved.
+     */
+    bool recoverFromOverrun();
+
+    /// The reader of the audio stream.
+    std::unique_ptr<AudioInputStream::Reader> m_audioReader;
+
+    /// The extractor to compute features with.
+    std::unique_ptr<utils::audio::FeatureExtractor> m_extractor;
+
+    /// The number of samples between the starts of consecutive frames.
+    const size_t m_hopSize;
+
+    /// The audio index of the start of the first frame.
+    const AudioInputStream::Index m_firstAudioIndex;
+
+    /// The stream features are published to.
+    std::shared_ptr<FeatureStream> m_featureStream;
+
+    /// The writer of @c m_featureStream.
+    std::unique_ptr<FeatureStream::Writer> m_featureWriter;
+
+    /// The samples of the frame being filled.
+    std::vector<int16_t> m_frame;
+
+    /// The number of samples of @c m_frame which have been read.
+    size_t m_numSamplesInFrame;
+
+    /// The number of frames published.
+    FeatureStream::Index m_numFramesPublished;
+
+    /// Whether the pipeline is being destroyed.
+    std::atomic<bool> m_isShuttingDown;
+
+    /// The thread running @c processLoop().
+    std::thread m_thread;
+};
+
+}  // namespace avs
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVSCOMMON_AVS_INCLUDE_AVSCOMMON_AVS_AUDIOFEATUREPIPELINE_H_
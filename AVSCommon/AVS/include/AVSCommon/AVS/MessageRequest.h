@@ -24,6 +24,7 @@
 #include <unordered_set>
 
 #include "AVSCommon/AVS/Attachment/AttachmentReader.h"
+#include "AVSCommon/AVS/MessageRequestTimings.h"
 #include <AVSCommon/SDKInterfaces/MessageRequestObserverInterface.h>
 
 namespace alexaClientSDK {
@@ -66,7 +67,8 @@ public:
     std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> getAttachmentReader();
 
     /**
-     * This is called once the send request has completed.  The status parameter indicates success or failure.
+     * This is called once the send request has completed.  The status parameter indicates success or failure.  The
+     * timings of the request are available from @c getTimings() by the time this is called.
      * @param status Whether the send request succeeded or failed.
      */
     virtual void sendCompleted(avsCommon::sdkInterfaces::MessageRequestObserverInterface::Status status);
@@ -78,6 +80,21 @@ public:
      */
     virtual void exceptionReceived(const std::string& exceptionMessage);
 
+    /**
+     * Set the breakdown of where the time went while this request was being sent.  This is called by the transport
+     * before @c sendCompleted().
+     *
+     * @param timings The timings of this request.
+     */
+    void setTimings(const MessageRequestTimings& timings);
+
+    /**
+     * Get the breakdown of where the time went while this request was being sent.
+     *
+     * @return The timings of this request, which are all zero until it has been sent.
+     */
+    MessageRequestTimings getTimings();
+
     /**
      * Add observer of MessageRequestObserverInterface.
      *
@@ -120,6 +137,12 @@ protected:
 
     /// The AttachmentReader of the Attachment data to be sent to AVS.
     std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> m_attachmentReader;
+
+    /// Mutex to guard access of m_timings.
+    std::mutex m_timingsMutex;
+
+    /// The timings of this request.
+    MessageRequestTimings m_timings;
 };
 
 }  // namespace avs
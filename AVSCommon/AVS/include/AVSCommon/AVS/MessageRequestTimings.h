@@ -0,0 +1,69 @@
+/*
+ * MessageRequestTimings.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVSCOMMON_AVS_INCLUDE_AVSCOMMON_AVS_MESSAGEREQUESTTIMINGS_H_
+#define ALEXA_CLIENT_SDK_AVSCOMMON_AVS_INCLUDE_AVSCOMMON_AVS_MESSAGEREQUESTTIMINGS_H_
+
+#include <chrono>
+#include <cstdint>
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace avs {
+
+/**
+ * A breakdown of where the time went while a @c MessageRequest was being sent, so that a slow request can be blamed
+ * on name resolution, the handshake, the upload or the server.
+ *
+ * The transfer times are those reported by the HTTP client, each measured from the start of the transfer, so they
+ * only increase from @c nameLookup to @c total.  Times for steps which did not happen, such as the connect of a
+ * request sent on an existing connection, are zero.
+ */
+struct MessageRequestTimings {
+    /// How long the request waited to be sent after it was queued.
+    std::chrono::microseconds queueWait{0};
+
+    /// The time until the name of the server was resolved.
+    std::chrono::microseconds nameLookup{0};
+
+    /// The time until the TCP connection was established.
+    std::chrono::microseconds connect{0};
+
+    /// The time until the TLS handshake was completed.
+    std::chrono::microseconds appConnect{0};
+
+    /// The time until the first byte of the response was received.
+    std::chrono::microseconds startTransfer{0};
+
+    /// The time until the transfer was completed.
+    std::chrono::microseconds total{0};
+
+    /// How long the upload was paused waiting for data from the attachment of the request.
+    std::chrono::microseconds attachmentReadPaused{0};
+
+    /// The number of bytes uploaded.
+    uint64_t bytesUploaded = 0;
+
+    /// The number of bytes downloaded.
+    uint64_t bytesDownloaded = 0;
+};
+
+}  // namespace avs
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVSCOMMON_AVS_INCLUDE_AVSCOMMON_AVS_MESSAGEREQUESTTIMINGS_H_
@@ -15,9 +15,12 @@
  * permissions and limitations under the License.
  */
 
+#include <algorithm>
 #include <vector>
 
+#include "AVSCommon/AVS/Attachment/AttachmentSpillFile.h"
 #include "AVSCommon/AVS/Attachment/InProcessAttachment.h"
+#include "AVSCommon/Utils/Configuration/ConfigurationNode.h"
 #include "AVSCommon/Utils/Logger/Logger.h"
 #include "AVSCommon/Utils/Memory/Memory.h"
 
@@ -41,20 +44,79 @@ static const std::string TAG("AttachmentManager");
  */
 #define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
 
-// The definition for these two static class members.
+// The definition for these static class members.
 constexpr std::chrono::minutes AttachmentManager::ATTACHMENT_MANAGER_TIMOUT_MINUTES_DEFAULT;
 constexpr std::chrono::minutes AttachmentManager::ATTACHMENT_MANAGER_TIMOUT_MINUTES_MINIMUM;
+constexpr size_t AttachmentManager::SPILL_BUFFER_MINIMUM_SIZE_IN_BYTES;
 
 // Used within generateAttachmentId().
 static const std::string ATTACHMENT_ID_COMBINING_SUBSTRING = ":";
 
+/// The key in our config file to find the root of attachment manager configuration.
+static const std::string ATTACHMENT_MANAGER_CONFIG_KEY = "attachmentManager";
+
+/// The key in our config file to find the buffer size of each attachment.
+static const std::string MAX_MEMORY_PER_ATTACHMENT_CONFIG_KEY = "maxMemoryPerAttachmentInBytes";
+
+/// The key in our config file to find the total buffer size of all attachments.
+static const std::string MAX_TOTAL_MEMORY_CONFIG_KEY = "maxTotalMemoryInBytes";
+
+/// The key in our config file to find the directory to spill attachments to.
+static const std::string SPILL_DIRECTORY_CONFIG_KEY = "spillDirectory";
+
+AttachmentManager::MemoryPolicy::MemoryPolicy() :
+        maxMemoryPerAttachmentInBytes{InProcessAttachment::SDS_BUFFER_DEFAULT_SIZE_IN_BYTES},
+        maxTotalMemoryInBytes{0} {
+}
+
 AttachmentManager::AttachmentManagementDetails::AttachmentManagementDetails() :
         creationTime{std::chrono::steady_clock::now()} {
 }
 
 AttachmentManager::AttachmentManager(AttachmentType attachmentType) :
         m_attachmentType{attachmentType},
+        m_memoryInUse{std::make_shared<std::atomic<size_t>>(0)},
         m_attachmentExpirationMinutes{ATTACHMENT_MANAGER_TIMOUT_MINUTES_DEFAULT} {
+    auto config = configuration::ConfigurationNode::getRoot()[ATTACHMENT_MANAGER_CONFIG_KEY];
+    if (config) {
+        MemoryPolicy policy;
+        int maxMemoryPerAttachment = 0;
+        if (config.getInt(MAX_MEMORY_PER_ATTACHMENT_CONFIG_KEY, &maxMemoryPerAttachment) &&
+            maxMemoryPerAttachment > 0) {
+            policy.maxMemoryPerAttachmentInBytes = maxMemoryPerAttachment;
+        }
+        int maxTotalMemory = 0;
+        if (config.getInt(MAX_TOTAL_MEMORY_CONFIG_KEY, &maxTotalMemory) && maxTotalMemory > 0) {
+            policy.maxTotalMemoryInBytes = maxTotalMemory;
+        }
+        config.getString(SPILL_DIRECTORY_CONFIG_KEY, &policy.spillDirectory);
+        setMemoryPolicy(policy);
+    }
+}
+
+bool AttachmentManager::setMemoryPolicy(const MemoryPolicy& policy) {
+    if (policy.maxMemoryPerAttachmentInBytes < SPILL_BUFFER_MINIMUM_SIZE_IN_BYTES) {
+        ACSDK_ERROR(LX("setMemoryPolicyFailed")
+                        .d("reason", "maxMemoryPerAttachmentTooSmall")
+                        .d("maxMemoryPerAttachmentInBytes", policy.maxMemoryPerAttachmentInBytes)
+                        .d("minimum", SPILL_BUFFER_MINIMUM_SIZE_IN_BYTES));
+        return false;
+    }
+    if (policy.maxTotalMemoryInBytes != 0 && policy.spillDirectory.empty()) {
+        ACSDK_WARN(LX("setMemoryPolicyWarning").d("reason", "maxTotalMemoryIgnoredWithoutSpillDirectory"));
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_memoryPolicy = policy;
+    ACSDK_INFO(LX("setMemoryPolicy")
+                   .d("maxMemoryPerAttachmentInBytes", policy.maxMemoryPerAttachmentInBytes)
+                   .d("maxTotalMemoryInBytes", policy.maxTotalMemoryInBytes)
+                   .d("spillDirectory", policy.spillDirectory));
+    return true;
+}
+
+size_t AttachmentManager::getMemoryInUse() const {
+    return *m_memoryInUse;
 }
 
 std::string AttachmentManager::generateAttachmentId(const std::string& contextId, const std::string& contentId) const {
@@ -101,7 +163,7 @@ AttachmentManager::AttachmentManagementDetails& AttachmentManager::getDetailsLoc
         switch (m_attachmentType) {
             // The in-process attachment type.
             case AttachmentType::IN_PROCESS:
-                details.attachment = make_unique<InProcessAttachment>(attachmentId);
+                details.attachment = createInProcessAttachmentLocked(attachmentId);
                 break;
         }
 
@@ -116,6 +178,39 @@ AttachmentManager::AttachmentManagementDetails& AttachmentManager::getDetailsLoc
     return details;
 }
 
+std::unique_ptr<Attachment> AttachmentManager::createInProcessAttachmentLocked(const std::string& attachmentId) {
+    std::shared_ptr<AttachmentSpillFile> spillFile;
+    if (!m_memoryPolicy.spillDirectory.empty()) {
+        spillFile = AttachmentSpillFile::create(m_memoryPolicy.spillDirectory);
+    }
+
+    size_t size = m_memoryPolicy.maxMemoryPerAttachmentInBytes;
+    if (spillFile && m_memoryPolicy.maxTotalMemoryInBytes != 0) {
+        size_t inUse = *m_memoryInUse;
+        size_t available =
+            inUse < m_memoryPolicy.maxTotalMemoryInBytes ? m_memoryPolicy.maxTotalMemoryInBytes - inUse : 0;
+        size = std::max(std::min(size, available), SPILL_BUFFER_MINIMUM_SIZE_IN_BYTES);
+    }
+
+    // The buffer returns its size to the manager's count when freed, which may be after the manager is gone.
+    auto memoryInUse = m_memoryInUse;
+    *memoryInUse += size;
+    auto bufferSize = InProcessAttachment::SDSType::calculateBufferSize(size);
+    std::shared_ptr<InProcessAttachment::SDSBufferType> buffer(
+        new InProcessAttachment::SDSBufferType(bufferSize),
+        [memoryInUse, size](InProcessAttachment::SDSBufferType* buffer) {
+            *memoryInUse -= size;
+            delete buffer;
+        });
+
+    auto sds = InProcessAttachment::SDSType::create(buffer);
+    if (!sds) {
+        ACSDK_ERROR(LX("createInProcessAttachmentFailed").d("reason", "createSdsFailed").d("size", size));
+        return nullptr;
+    }
+    return make_unique<InProcessAttachment>(attachmentId, std::move(sds), spillFile);
+}
+
 std::unique_ptr<AttachmentWriter> AttachmentManager::createWriter(const std::string& attachmentId) {
     std::lock_guard<std::mutex> lock(m_mutex);
 
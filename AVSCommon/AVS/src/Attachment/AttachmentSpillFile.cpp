@@ -0,0 +1,229 @@
+/*
+ * AttachmentSpillFile.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+#include <unistd.h>
+
+#include "AVSCommon/AVS/Attachment/AttachmentSpillFile.h"
+#include "AVSCommon/Utils/Logger/Logger.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace avs {
+namespace attachment {
+
+using namespace avsCommon::utils;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("AttachmentSpillFile");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The template for the names of spill files, as required by @c mkstemp().
+static const std::string SPILL_FILE_NAME_TEMPLATE = "/acsdk-attachment-XXXXXX";
+
+std::shared_ptr<AttachmentSpillFile> AttachmentSpillFile::create(const std::string& directory) {
+    if (directory.empty()) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "emptyDirectory"));
+        return nullptr;
+    }
+    return std::shared_ptr<AttachmentSpillFile>(new AttachmentSpillFile(directory));
+}
+
+AttachmentSpillFile::AttachmentSpillFile(const std::string& directory) :
+        m_directory{directory},
+        m_fd{-1},
+        m_startIndex{0},
+        m_size{0},
+        m_writeCount{0},
+        m_isClosed{false} {
+}
+
+AttachmentSpillFile::~AttachmentSpillFile() {
+    if (m_fd >= 0) {
+        ::close(m_fd);
+    }
+}
+
+bool AttachmentSpillFile::startSpilling(uint64_t startIndex) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_fd >= 0) {
+        ACSDK_ERROR(LX("startSpillingFailed").d("reason", "alreadySpilling"));
+        return false;
+    }
+    std::string path = m_directory + SPILL_FILE_NAME_TEMPLATE;
+    std::vector<char> pathBuffer(path.begin(), path.end());
+    pathBuffer.push_back('\0');
+    int fd = ::mkstemp(pathBuffer.data());
+    if (fd < 0) {
+        ACSDK_ERROR(LX("startSpillingFailed").d("reason", "mkstempFailed").d("error", std::strerror(errno)));
+        return false;
+    }
+    // The file is only reached through its descriptor, so remove its name now.
+    ::unlink(pathBuffer.data());
+    m_fd = fd;
+    m_startIndex = startIndex;
+    ACSDK_DEBUG5(LX("startSpilling").d("startIndex", startIndex));
+    return true;
+}
+
+bool AttachmentSpillFile::getSpillStart(uint64_t* startIndex) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_fd < 0) {
+        return false;
+    }
+    *startIndex = m_startIndex;
+    return true;
+}
+
+bool AttachmentSpillFile::append(const void* data, size_t size) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_fd < 0) {
+        ACSDK_ERROR(LX("appendFailed").d("reason", "notSpilling"));
+        return false;
+    }
+    auto fd = m_fd;
+    auto offset = m_size;
+    // Only the writer appends, so the file can be written without holding the lock.
+    lock.unlock();
+
+    auto bytes = static_cast<const uint8_t*>(data);
+    size_t written = 0;
+    while (written < size) {
+        auto result = ::pwrite(fd, bytes + written, size - written, offset + written);
+        if (result < 0) {
+            if (EINTR == errno) {
+                continue;
+            }
+            ACSDK_ERROR(LX("appendFailed").d("reason", "pwriteFailed").d("error", std::strerror(errno)));
+            return false;
+        }
+        written += result;
+    }
+
+    lock.lock();
+    m_size += size;
+    return true;
+}
+
+size_t AttachmentSpillFile::read(uint64_t offset, void* buf, size_t size) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_fd < 0 || offset >= m_size) {
+        return 0;
+    }
+    auto fd = m_fd;
+    if (size > m_size - offset) {
+        size = m_size - offset;
+    }
+    // The data below m_size is never rewritten, so it can be read without holding the lock.
+    lock.unlock();
+
+    auto bytes = static_cast<uint8_t*>(buf);
+    size_t numRead = 0;
+    while (numRead < size) {
+        auto result = ::pread(fd, bytes + numRead, size - numRead, offset + numRead);
+        if (result < 0 && EINTR == errno) {
+            continue;
+        }
+        if (result <= 0) {
+            ACSDK_ERROR(LX("readFailed").d("reason", "preadFailed").d("error", std::strerror(errno)));
+            break;
+        }
+        numRead += result;
+    }
+    return numRead;
+}
+
+uint64_t AttachmentSpillFile::getSize() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_size;
+}
+
+void AttachmentSpillFile::close() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_isClosed) {
+            return;
+        }
+        m_isClosed = true;
+    }
+    notifyWrite();
+}
+
+bool AttachmentSpillFile::isClosed() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_isClosed;
+}
+
+uint64_t AttachmentSpillFile::getWriteCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_writeCount;
+}
+
+void AttachmentSpillFile::notifyWrite() {
+    std::vector<std::shared_ptr<sds::ReadinessNotifier>> notifiers;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_writeCount;
+        for (auto& weakNotifier : m_notifiers) {
+            auto notifier = weakNotifier.lock();
+            if (notifier) {
+                notifiers.push_back(notifier);
+            }
+        }
+    }
+    m_writeTrigger.notify_all();
+    for (auto& notifier : notifiers) {
+        notifier->signal();
+    }
+}
+
+bool AttachmentSpillFile::waitForWrite(uint64_t writeCount, std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    auto predicate = [this, writeCount] { return m_writeCount != writeCount || m_isClosed; };
+    if (std::chrono::milliseconds::zero() == timeout) {
+        m_writeTrigger.wait(lock, predicate);
+        return true;
+    }
+    return m_writeTrigger.wait_for(lock, timeout, predicate);
+}
+
+void AttachmentSpillFile::addReadinessNotifier(std::shared_ptr<sds::ReadinessNotifier> notifier) {
+    if (!notifier) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& weakNotifier : m_notifiers) {
+        if (weakNotifier.lock() == notifier) {
+            return;
+        }
+    }
+    m_notifiers.push_back(notifier);
+}
+
+}  // namespace attachment
+}  // namespace avs
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
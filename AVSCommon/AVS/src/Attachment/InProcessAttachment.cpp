@@ -25,9 +25,13 @@ namespace attachment {
 
 using namespace alexaClientSDK::avsCommon::utils::memory;
 
-InProcessAttachment::InProcessAttachment(const std::string& id, std::unique_ptr<SDSType> sds) :
+InProcessAttachment::InProcessAttachment(
+    const std::string& id,
+    std::unique_ptr<SDSType> sds,
+    std::shared_ptr<AttachmentSpillFile> spillFile) :
         Attachment(id),
-        m_sds{std::move(sds)} {
+        m_sds{std::move(sds)},
+        m_spillFile{spillFile} {
     if (!m_sds) {
         auto buffSize = SDSType::calculateBufferSize(SDS_BUFFER_DEFAULT_SIZE_IN_BYTES);
         auto buff = std::make_shared<SDSBufferType>(buffSize);
@@ -42,7 +46,7 @@ std::unique_ptr<AttachmentWriter> InProcessAttachment::createWriter() {
         return nullptr;
     }
 
-    auto writer = InProcessAttachmentWriter::create(m_sds);
+    auto writer = InProcessAttachmentWriter::create(m_sds, m_spillFile);
     if (writer) {
         m_hasCreatedWriter = true;
     }
@@ -57,7 +61,8 @@ std::unique_ptr<AttachmentReader> InProcessAttachment::createReader(AttachmentRe
         return nullptr;
     }
 
-    auto reader = InProcessAttachmentReader::create(policy, m_sds);
+    auto reader = InProcessAttachmentReader::create(
+        policy, m_sds, 0, InProcessAttachmentReader::SDSTypeReader::Reference::ABSOLUTE, m_spillFile);
     if (reader) {
         m_hasCreatedReader = true;
     }
@@ -15,6 +15,8 @@
  * permissions and limitations under the License.
  */
 
+#include <algorithm>
+
 #include "AVSCommon/AVS/Attachment/InProcessAttachmentReader.h"
 #include "AVSCommon/Utils/Logger/Logger.h"
 
@@ -39,8 +41,9 @@ std::unique_ptr<InProcessAttachmentReader> InProcessAttachmentReader::create(
     Policy policy,
     std::shared_ptr<SDSType> sds,
     SDSTypeIndex offset,
-    SDSTypeReader::Reference reference) {
-    auto reader = std::unique_ptr<InProcessAttachmentReader>(new InProcessAttachmentReader(policy, sds));
+    SDSTypeReader::Reference reference,
+    std::shared_ptr<AttachmentSpillFile> spillFile) {
+    auto reader = std::unique_ptr<InProcessAttachmentReader>(new InProcessAttachmentReader(policy, sds, spillFile));
 
     if (!reader->m_reader) {
         ACSDK_ERROR(LX("createFailed").d("reason", "object not fully created"));
@@ -55,14 +58,25 @@ std::unique_ptr<InProcessAttachmentReader> InProcessAttachmentReader::create(
     return reader;
 }
 
-InProcessAttachmentReader::InProcessAttachmentReader(Policy policy, std::shared_ptr<SDSType> sds) {
+InProcessAttachmentReader::InProcessAttachmentReader(
+    Policy policy,
+    std::shared_ptr<SDSType> sds,
+    std::shared_ptr<AttachmentSpillFile> spillFile) :
+        m_policy{policy},
+        m_spillFile{spillFile},
+        m_spillReadOffset{0},
+        m_hasSpillReadLimit{false},
+        m_spillReadLimit{0},
+        m_isClosed{false} {
     if (!sds) {
         ACSDK_ERROR(LX("ConstructorFailed").d("reason", "SDS parameter is nullptr"));
         return;
     }
 
-    auto sdsPolicy = (AttachmentReader::Policy::BLOCKING == policy) ? SDSType::Reader::Policy::BLOCKING
-                                                                    : SDSType::Reader::Policy::NONBLOCKING;
+    // A reader which may have to continue in the spill file can't block on the SDS, so it waits on the file instead.
+    auto sdsPolicy = (AttachmentReader::Policy::BLOCKING == policy && !m_spillFile)
+                         ? SDSType::Reader::Policy::BLOCKING
+                         : SDSType::Reader::Policy::NONBLOCKING;
 
     m_reader = sds->createReader(sdsPolicy);
 
@@ -114,6 +128,10 @@ std::size_t InProcessAttachmentReader::read(
     std::size_t bytesRead = 0;
     auto numWords = numBytes / wordSize;
 
+    if (m_spillFile) {
+        return readWithSpill(buf, numWords, readStatus, timeoutMs);
+    }
+
     auto readResult = m_reader->read(buf, numWords, timeoutMs);
 
     /*
@@ -160,13 +178,97 @@ std::size_t InProcessAttachmentReader::read(
     return bytesRead;
 }
 
+std::size_t InProcessAttachmentReader::readWithSpill(
+    void* buf,
+    std::size_t numWords,
+    ReadStatus* readStatus,
+    std::chrono::milliseconds timeoutMs) {
+    auto wordSize = m_reader->getWordSize();
+    auto deadline = std::chrono::steady_clock::now() + timeoutMs;
+
+    while (!m_isClosed) {
+        // Taken before looking for data, so that a write made after the look wakes the wait below.
+        auto writeCount = m_spillFile->getWriteCount();
+
+        SDSTypeIndex spillStart = 0;
+        bool isSpilling = m_spillFile->getSpillStart(&spillStart);
+        if (!isSpilling || m_reader->tell() < spillStart) {
+            auto words = numWords;
+            if (isSpilling) {
+                words = std::min<std::size_t>(words, spillStart - m_reader->tell());
+            }
+            auto readResult = m_reader->read(buf, words);
+            if (readResult > 0) {
+                return static_cast<size_t>(readResult) * wordSize;
+            }
+            if (SDSType::Reader::Error::OVERRUN == readResult) {
+                *readStatus = ReadStatus::ERROR_OVERRUN;
+                ACSDK_ERROR(LX("readFailed").d("reason", "memory overrun by writer"));
+                close();
+                return 0;
+            }
+            if (0 == readResult) {
+                // The SDS is closed, either by the writer at the point it started spilling or by this reader.
+                if (m_spillFile->getSpillStart(&spillStart) && m_reader->tell() >= spillStart) {
+                    continue;
+                }
+                *readStatus = ReadStatus::CLOSED;
+                ACSDK_INFO(LX("readFailed").d("reason", "SDS is closed"));
+                return 0;
+            }
+        } else {
+            uint64_t available = numWords * wordSize;
+            if (m_hasSpillReadLimit) {
+                available = std::min(available, m_spillReadLimit - std::min(m_spillReadOffset, m_spillReadLimit));
+            }
+            auto bytesRead = m_spillFile->read(m_spillReadOffset, buf, available);
+            if (bytesRead > 0) {
+                m_spillReadOffset += bytesRead;
+                return bytesRead;
+            }
+            if ((m_hasSpillReadLimit && m_spillReadOffset >= m_spillReadLimit) ||
+                (m_spillFile->isClosed() && m_spillReadOffset >= m_spillFile->getSize())) {
+                *readStatus = ReadStatus::CLOSED;
+                ACSDK_INFO(LX("readFailed").d("reason", "spill file is closed"));
+                return 0;
+            }
+        }
+
+        if (Policy::NON_BLOCKING == m_policy) {
+            *readStatus = ReadStatus::OK_WOULDBLOCK;
+            return 0;
+        }
+        if (std::chrono::milliseconds::zero() == timeoutMs) {
+            m_spillFile->waitForWrite(writeCount, timeoutMs);
+            continue;
+        }
+        auto remaining =
+            std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+        if (remaining <= std::chrono::milliseconds::zero() || !m_spillFile->waitForWrite(writeCount, remaining)) {
+            *readStatus = ReadStatus::OK_TIMEDOUT;
+            return 0;
+        }
+    }
+
+    *readStatus = ReadStatus::CLOSED;
+    ACSDK_INFO(LX("readFailed").d("reason", "reader is closed"));
+    return 0;
+}
+
 void InProcessAttachmentReader::close(ClosePoint closePoint) {
     if (m_reader) {
         switch (closePoint) {
             case ClosePoint::IMMEDIATELY:
+                m_isClosed = true;
                 m_reader->close();
                 return;
             case ClosePoint::AFTER_DRAINING_CURRENT_BUFFER:
+                if (m_spillFile && !m_hasSpillReadLimit) {
+                    // Whatever has been spilled so far is part of the current buffer too.
+                    SDSTypeIndex spillStart = 0;
+                    m_hasSpillReadLimit = true;
+                    m_spillReadLimit = m_spillFile->getSpillStart(&spillStart) ? m_spillFile->getSize() : 0;
+                }
                 m_reader->close(0, SDSType::Reader::Reference::BEFORE_WRITER);
                 return;
         }
@@ -174,10 +276,31 @@ void InProcessAttachmentReader::close(ClosePoint closePoint) {
 }
 
 bool InProcessAttachmentReader::seek(uint64_t offset) {
-    if (m_reader) {
-        return m_reader->seek(offset);
+    if (!m_reader) {
+        return false;
+    }
+    SDSTypeIndex spillStart = 0;
+    if (m_spillFile && m_spillFile->getSpillStart(&spillStart) && offset > spillStart) {
+        if (!m_reader->seek(spillStart)) {
+            return false;
+        }
+        m_spillReadOffset = (offset - spillStart) * m_reader->getWordSize();
+        return true;
+    }
+    m_spillReadOffset = 0;
+    return m_reader->seek(offset);
+}
+
+std::shared_ptr<utils::sds::ReadinessNotifier> InProcessAttachmentReader::getReadinessNotifier() {
+    if (!m_reader) {
+        return nullptr;
+    }
+    auto notifier = m_reader->getReadinessNotifier();
+    if (m_spillFile) {
+        // Writes to the spill file don't go through the SDS, so the spill file signals the notifier itself.
+        m_spillFile->addReadinessNotifier(notifier);
     }
-    return false;
+    return notifier;
 }
 
 }  // namespace attachment
@@ -35,8 +35,10 @@ static const std::string TAG("InProcessAttachmentWriter");
  */
 #define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
 
-std::unique_ptr<InProcessAttachmentWriter> InProcessAttachmentWriter::create(std::shared_ptr<SDSType> sds) {
-    auto writer = std::unique_ptr<InProcessAttachmentWriter>(new InProcessAttachmentWriter(sds));
+std::unique_ptr<InProcessAttachmentWriter> InProcessAttachmentWriter::create(
+    std::shared_ptr<SDSType> sds,
+    std::shared_ptr<AttachmentSpillFile> spillFile) {
+    auto writer = std::unique_ptr<InProcessAttachmentWriter>(new InProcessAttachmentWriter(sds, spillFile));
 
     if (!writer->m_writer) {
         ACSDK_ERROR(LX("createFailed").d("reason", "could not create instance"));
@@ -46,7 +48,11 @@ std::unique_ptr<InProcessAttachmentWriter> InProcessAttachmentWriter::create(std
     return writer;
 }
 
-InProcessAttachmentWriter::InProcessAttachmentWriter(std::shared_ptr<SDSType> sds) {
+InProcessAttachmentWriter::InProcessAttachmentWriter(
+    std::shared_ptr<SDSType> sds,
+    std::shared_ptr<AttachmentSpillFile> spillFile) :
+        m_spillFile{spillFile},
+        m_isSpilling{false} {
     if (!sds) {
         ACSDK_ERROR(LX("constructorFailed").d("reason", "SDS parameter is nullptr"));
         return;
@@ -84,6 +90,10 @@ std::size_t InProcessAttachmentWriter::write(const void* buff, std::size_t numBy
         return 0;
     }
 
+    if (m_isSpilling) {
+        return spill(buff, numBytes - numBytes % wordSize, writeStatus);
+    }
+
     std::size_t bytesWritten = 0;
     auto numWords = numBytes / wordSize;
     auto writeResult = m_writer->write(buff, numWords);
@@ -100,6 +110,10 @@ std::size_t InProcessAttachmentWriter::write(const void* buff, std::size_t numBy
         switch (writeResult) {
             // This means the buffer is full, and we cannot write until a reader consumes data.
             case SDSType::Writer::Error::WOULDBLOCK:
+                if (m_spillFile) {
+                    // Nothing was written to the SDS, so the file carries on from its current index.
+                    return spill(buff, numWords * wordSize, writeStatus);
+                }
                 *writeStatus = WriteStatus::OK_BUFFER_FULL;
                 break;
 
@@ -124,15 +138,41 @@ std::size_t InProcessAttachmentWriter::write(const void* buff, std::size_t numBy
         close();
     } else {
         bytesWritten = static_cast<size_t>(writeResult) * wordSize;
+        if (m_spillFile) {
+            m_spillFile->notifyWrite();
+        }
     }
 
     return bytesWritten;
 }
 
+std::size_t InProcessAttachmentWriter::spill(const void* buff, std::size_t numBytes, WriteStatus* writeStatus) {
+    if (!m_isSpilling) {
+        if (!m_spillFile->startSpilling(m_writer->tell())) {
+            // Without a file, carry on as an attachment which doesn't spill.
+            ACSDK_WARN(LX("spillFailed").d("reason", "startSpillingFailed"));
+            m_spillFile->notifyWrite();
+            m_spillFile.reset();
+            *writeStatus = WriteStatus::OK_BUFFER_FULL;
+            return 0;
+        }
+        m_isSpilling = true;
+    }
+    if (!m_spillFile->append(buff, numBytes)) {
+        *writeStatus = WriteStatus::ERROR_INTERNAL;
+        return 0;
+    }
+    m_spillFile->notifyWrite();
+    return numBytes;
+}
+
 void InProcessAttachmentWriter::close() {
     if (m_writer) {
         m_writer->close();
     }
+    if (m_spillFile) {
+        m_spillFile->close();
+    }
 }
 
 }  // namespace attachment
@@ -0,0 +1,244 @@
+/*
+ * AudioFeaturePipeline.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <cstring>
+
+#include "AVSCommon/AVS/AudioFeaturePipeline.h"
+#include "AVSCommon/Utils/Logger/Logger.h"
+#include "AVSCommon/Utils/Threading/ThreadName.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace avs {
+
+using namespace utils;
+using namespace utils::audio;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("AudioFeaturePipeline");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The only sample size supported.
+static const unsigned int SUPPORTED_SAMPLE_SIZE_IN_BITS = 16;
+
+/// The only number of channels supported.
+static const unsigned int SUPPORTED_NUM_CHANNELS = 1;
+
+/// The timeout of reads from the audio stream.  Zero blocks until audio arrives, so an idle pipeline never wakes.
+static const std::chrono::milliseconds TIMEOUT_FOR_READ_CALLS = std::chrono::milliseconds::zero();
+
+/**
+ * Check whether audio in a format is in the byte order of the platform.
+ *
+ * @param audioFormat The format of the audio.
+ * @return Whether the samples would have to be byte swapped.
+ */
+static bool isByteswappingRequired(const AudioFormat& audioFormat) {
+    int num = 1;
+    bool isPlatformLittleEndian = (1 == *reinterpret_cast<char*>(&num));
+    bool isFormatLittleEndian = (audioFormat.endianness == AudioFormat::Endianness::LITTLE);
+    return isPlatformLittleEndian != isFormatLittleEndian;
+}
+
+std::unique_ptr<AudioFeaturePipeline> AudioFeaturePipeline::create(
+    std::shared_ptr<AudioInputStream> audioStream,
+    AudioFormat audioFormat,
+    size_t frameSize,
+    size_t hopSize,
+    size_t numFrames,
+    size_t maxConsumers) {
+    if (!audioStream) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "nullAudioStream"));
+        return nullptr;
+    }
+    if (isByteswappingRequired(audioFormat)) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "endianMismatch"));
+        return nullptr;
+    }
+    if (audioFormat.encoding != AudioFormat::Encoding::LPCM ||
+        audioFormat.sampleSizeInBits != SUPPORTED_SAMPLE_SIZE_IN_BITS ||
+        audioFormat.numChannels != SUPPORTED_NUM_CHANNELS) {
+        ACSDK_ERROR(LX("createFailed")
+                        .d("reason", "unsupportedAudioFormat")
+                        .d("encoding", audioFormat.encoding)
+                        .d("sampleSizeInBits", audioFormat.sampleSizeInBits)
+                        .d("numChannels", audioFormat.numChannels));
+        return nullptr;
+    }
+    if (audioStream->getWordSize() != sizeof(int16_t)) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "unsupportedWordSize").d("wordSize", audioStream->getWordSize()));
+        return nullptr;
+    }
+    if (0 == hopSize || hopSize > frameSize) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "invalidHopSize").d("hopSize", hopSize).d("frameSize", frameSize));
+        return nullptr;
+    }
+    if (0 == numFrames || 0 == maxConsumers) {
+        ACSDK_ERROR(LX("createFailed")
+                        .d("reason", "invalidFeatureStreamSize")
+                        .d("numFrames", numFrames)
+                        .d("maxConsumers", maxConsumers));
+        return nullptr;
+    }
+    auto extractor = FeatureExtractor::create(frameSize, audioFormat.sampleRateHz);
+    if (!extractor) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "createFeatureExtractorFailed"));
+        return nullptr;
+    }
+
+    auto bufferSize = FeatureStream::calculateBufferSize(numFrames, sizeof(AudioFeatures), maxConsumers);
+    auto buffer = std::make_shared<FeatureStream::Buffer>(bufferSize);
+    std::shared_ptr<FeatureStream> featureStream =
+        FeatureStream::create(buffer, sizeof(AudioFeatures), maxConsumers);
+    if (!featureStream) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "createFeatureStreamFailed"));
+        return nullptr;
+    }
+    auto featureWriter = featureStream->createWriter(FeatureStream::Writer::Policy::NONBLOCKABLE);
+    if (!featureWriter) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "createFeatureWriterFailed"));
+        return nullptr;
+    }
+
+    auto audioReader = audioStream->createReader(AudioInputStream::Reader::Policy::BLOCKING);
+    if (!audioReader) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "createAudioReaderFailed"));
+        return nullptr;
+    }
+    // Frames start at multiples of the hop size, so that consumers can compute the audio index of any frame.
+    auto firstAudioIndex = (audioReader->tell() + hopSize - 1) / hopSize * hopSize;
+    if (!audioReader->seek(firstAudioIndex)) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "seekFailed").d("index", firstAudioIndex));
+        return nullptr;
+    }
+
+    return std::unique_ptr<AudioFeaturePipeline>(new AudioFeaturePipeline(
+        std::move(audioReader), std::move(extractor), hopSize, featureStream, std::move(featureWriter)));
+}
+
+AudioFeaturePipeline::AudioFeaturePipeline(
+    std::unique_ptr<AudioInputStream::Reader> audioReader,
+    std::unique_ptr<FeatureExtractor> extractor,
+    size_t hopSize,
+    std::shared_ptr<FeatureStream> featureStream,
+    std::unique_ptr<FeatureStream::Writer> featureWriter) :
+        m_audioReader{std::move(audioReader)},
+        m_extractor{std::move(extractor)},
+        m_hopSize{hopSize},
+        m_firstAudioIndex{m_audioReader->tell()},
+        m_featureStream{featureStream},
+        m_featureWriter{std::move(featureWriter)},
+        m_frame(m_extractor->getFrameSize()),
+        m_numSamplesInFrame{0},
+        m_numFramesPublished{0},
+        m_isShuttingDown{false} {
+    m_thread = std::thread(&AudioFeaturePipeline::processLoop, this);
+}
+
+AudioFeaturePipeline::~AudioFeaturePipeline() {
+    m_isShuttingDown = true;
+    // Wake the processing loop if it is blocked reading, as its reads never time out.
+    m_audioReader->close();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+std::shared_ptr<AudioFeaturePipeline::FeatureStream> AudioFeaturePipeline::getFeatureStream() const {
+    return m_featureStream;
+}
+
+AudioInputStream::Index AudioFeaturePipeline::getAudioIndex(FeatureStream::Index featureIndex) const {
+    return m_firstAudioIndex + featureIndex * m_hopSize;
+}
+
+AudioFeaturePipeline::FeatureStream::Index AudioFeaturePipeline::getFeatureIndex(
+    AudioInputStream::Index audioIndex) const {
+    if (audioIndex <= m_firstAudioIndex) {
+        return 0;
+    }
+    return (audioIndex - m_firstAudioIndex + m_hopSize - 1) / m_hopSize;
+}
+
+void AudioFeaturePipeline::processLoop() {
+    utils::threading::setThreadName("FeaturePipeline");
+    AudioFeatures features;
+    while (!m_isShuttingDown) {
+        auto frameSize = m_frame.size();
+        ssize_t wordsRead = m_audioReader->read(
+            m_frame.data() + m_numSamplesInFrame, frameSize - m_numSamplesInFrame, TIMEOUT_FOR_READ_CALLS);
+        if (wordsRead > 0) {
+            m_numSamplesInFrame += wordsRead;
+            if (m_numSamplesInFrame < frameSize) {
+                continue;
+            }
+            m_extractor->extract(m_frame.data(), &features);
+            if (m_featureWriter->write(&features, 1) != 1) {
+                ACSDK_ERROR(LX("processLoopFailed").d("reason", "writeFailed"));
+                break;
+            }
+            ++m_numFramesPublished;
+            // Keep the overlap with the next frame rather than reading it again.
+            m_numSamplesInFrame = frameSize - m_hopSize;
+            std::memmove(m_frame.data(), m_frame.data() + m_hopSize, m_numSamplesInFrame * sizeof(int16_t));
+        } else if (AudioInputStream::Reader::Error::CLOSED == wordsRead) {
+            break;
+        } else if (AudioInputStream::Reader::Error::OVERRUN == wordsRead) {
+            ACSDK_WARN(LX("processLoop").d("reason", "audioOverrun"));
+            if (!recoverFromOverrun()) {
+                break;
+            }
+        } else if (AudioInputStream::Reader::Error::TIMEDOUT != wordsRead) {
+            ACSDK_ERROR(LX("processLoopFailed").d("reason", "readFailed").d("error", wordsRead));
+            break;
+        }
+    }
+    m_featureWriter->close();
+}
+
+bool AudioFeaturePipeline::recoverFromOverrun() {
+    if (!m_audioReader->seek(0, AudioInputStream::Reader::Reference::BEFORE_WRITER)) {
+        ACSDK_ERROR(LX("recoverFromOverrunFailed").d("reason", "seekToWriterFailed"));
+        return false;
+    }
+    auto nextFrame = getFeatureIndex(m_audioReader->tell());
+    if (!m_audioReader->seek(getAudioIndex(nextFrame))) {
+        ACSDK_ERROR(LX("recoverFromOverrunFailed").d("reason", "seekToFrameFailed"));
+        return false;
+    }
+
+    AudioFeatures invalidFeatures;
+    std::memset(&invalidFeatures, 0, sizeof(invalidFeatures));
+    for (; m_numFramesPublished < nextFrame; ++m_numFramesPublished) {
+        if (m_featureWriter->write(&invalidFeatures, 1) != 1) {
+            ACSDK_ERROR(LX("recoverFromOverrunFailed").d("reason", "writeFailed"));
+            return false;
+        }
+    }
+    m_numSamplesInFrame = 0;
+    return true;
+}
+
+}  // namespace avs
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
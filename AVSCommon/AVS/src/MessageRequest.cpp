@@ -74,6 +74,16 @@ void MessageRequest::exceptionReceived(const std::string& exceptionMessage) {
     }
 }
 
+void MessageRequest::setTimings(const MessageRequestTimings& timings) {
+    std::lock_guard<std::mutex> lock{m_timingsMutex};
+    m_timings = timings;
+}
+
+MessageRequestTimings MessageRequest::getTimings() {
+    std::lock_guard<std::mutex> lock{m_timingsMutex};
+    return m_timings;
+}
+
 void MessageRequest::addObserver(std::shared_ptr<avsCommon::sdkInterfaces::MessageRequestObserverInterface> observer) {
     if (!observer) {
         ACSDK_ERROR(LX("addObserverFailed").d("reason", "nullObserver"));
@@ -232,6 +232,22 @@ TEST_F(AttachmentReaderTest, testAttachmentReaderMultipleReadsOfUnfinishedData)
     testMultipleReads(true);
 }
 
+/**
+ * Test that an in-process reader provides a readiness notifier which is signalled when data is written.
+ */
+TEST_F(AttachmentReaderTest, testAttachmentReaderReadinessNotifier) {
+    init();
+    auto notifier = m_reader->getReadinessNotifier();
+    ASSERT_NE(notifier, nullptr);
+    notifier->clear();
+    EXPECT_FALSE(notifier->waitUntilSignalled(std::chrono::milliseconds(10)));
+
+    auto numWritten = m_writer->write(m_testPattern.data(), m_testPattern.size());
+    ASSERT_EQ(numWritten, static_cast<ssize_t>(m_testPattern.size()));
+    EXPECT_TRUE(notifier->waitUntilSignalled(std::chrono::milliseconds(0)));
+    readAndVerifyResult(std::move(m_reader), m_testPattern.size());
+}
+
 }  // namespace test
 }  // namespace avs
 }  // namespace avsCommon
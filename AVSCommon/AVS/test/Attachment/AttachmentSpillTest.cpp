@@ -0,0 +1,324 @@
+/*
+ * AttachmentSpillTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <cstdlib>
+#include <thread>
+
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include "AVSCommon/AVS/Attachment/AttachmentManager.h"
+#include "AVSCommon/AVS/Attachment/AttachmentSpillFile.h"
+#include "AVSCommon/AVS/Attachment/InProcessAttachment.h"
+
+#include "Common/Common.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace avs {
+namespace test {
+
+using namespace alexaClientSDK::avsCommon::avs::attachment;
+
+/// The number of buffers worth of data the tests write, so that most of it is spilled.
+static const int TEST_SPILL_BUFFER_MULTIPLE = 5;
+
+/// The size of the writes and reads the tests make.
+static const size_t TEST_CHUNK_SIZE_IN_BYTES = 64;
+
+/// The time a read which should time out waits for.
+static const auto SHORT_TIMEOUT = std::chrono::milliseconds(50);
+
+/// The per-attachment limit used to test the total memory limit.
+static const size_t TEST_MAX_MEMORY_PER_ATTACHMENT = 0x10000;
+
+/// The total limit used to test the total memory limit, which leaves room for one and a half attachments.
+static const size_t TEST_MAX_TOTAL_MEMORY = TEST_MAX_MEMORY_PER_ATTACHMENT * 3 / 2;
+
+/// Test harness for attachments which spill to disk.
+class AttachmentSpillTest : public ::testing::Test {
+public:
+    /// Set up the test harness for running a test.
+    void SetUp() override;
+
+    /// Remove the spill directory.
+    void TearDown() override;
+
+protected:
+    /**
+     * Create an attachment with a @c TEST_SDS_BUFFER_SIZE_IN_BYTES buffer which spills to @c m_directory.
+     */
+    void createAttachment();
+
+    /**
+     * Write data to an attachment in @c TEST_CHUNK_SIZE_IN_BYTES chunks, expecting every write to succeed.
+     *
+     * @param writer The writer to write with.
+     * @param data The data to write.
+     */
+    void writeAll(AttachmentWriter* writer, const std::vector<uint8_t>& data);
+
+    /**
+     * Read an attachment in @c TEST_CHUNK_SIZE_IN_BYTES chunks until it is closed.
+     *
+     * @param reader The reader to read with.
+     * @return The data read.
+     */
+    std::vector<uint8_t> readAll(AttachmentReader* reader);
+
+    /// The directory attachments spill to.
+    std::string m_directory;
+
+    /// The attachment under test.
+    std::unique_ptr<InProcessAttachment> m_attachment;
+
+    /// The data written to the attachment.
+    std::vector<uint8_t> m_pattern;
+};
+
+void AttachmentSpillTest::SetUp() {
+    char directory[] = "/tmp/AttachmentSpillTest-XXXXXX";
+    ASSERT_NE(mkdtemp(directory), nullptr);
+    m_directory = directory;
+    m_pattern = createTestPattern(TEST_SDS_BUFFER_SIZE_IN_BYTES * TEST_SPILL_BUFFER_MULTIPLE);
+}
+
+void AttachmentSpillTest::TearDown() {
+    m_attachment.reset();
+    // Spill files are unlinked when created, so the directory is empty.
+    EXPECT_EQ(rmdir(m_directory.c_str()), 0);
+}
+
+void AttachmentSpillTest::createAttachment() {
+    m_attachment = std::unique_ptr<InProcessAttachment>(new InProcessAttachment(
+        TEST_ATTACHMENT_ID_STRING_ONE,
+        createSDS(TEST_SDS_BUFFER_SIZE_IN_BYTES),
+        AttachmentSpillFile::create(m_directory)));
+}
+
+void AttachmentSpillTest::writeAll(AttachmentWriter* writer, const std::vector<uint8_t>& data) {
+    for (size_t offset = 0; offset < data.size(); offset += TEST_CHUNK_SIZE_IN_BYTES) {
+        auto size = std::min(TEST_CHUNK_SIZE_IN_BYTES, data.size() - offset);
+        auto writeStatus = AttachmentWriter::WriteStatus::OK;
+        ASSERT_EQ(writer->write(data.data() + offset, size, &writeStatus), size);
+        ASSERT_EQ(writeStatus, AttachmentWriter::WriteStatus::OK);
+    }
+}
+
+std::vector<uint8_t> AttachmentSpillTest::readAll(AttachmentReader* reader) {
+    std::vector<uint8_t> result;
+    std::vector<uint8_t> buffer(TEST_CHUNK_SIZE_IN_BYTES);
+    auto readStatus = AttachmentReader::ReadStatus::OK;
+    while (AttachmentReader::ReadStatus::CLOSED != readStatus) {
+        auto numRead = reader->read(buffer.data(), buffer.size(), &readStatus);
+        EXPECT_TRUE(numRead > 0 || AttachmentReader::ReadStatus::CLOSED == readStatus);
+        result.insert(result.end(), buffer.begin(), buffer.begin() + numRead);
+    }
+    return result;
+}
+
+/**
+ * Verify that @c AttachmentSpillFile can't be created without a directory.
+ */
+TEST_F(AttachmentSpillTest, createWithoutDirectoryFails) {
+    EXPECT_EQ(AttachmentSpillFile::create(""), nullptr);
+}
+
+/**
+ * Verify that a writer with no reader keeps writing past the size of its buffer, and that a reader created afterwards
+ * reads all of the data back.
+ */
+TEST_F(AttachmentSpillTest, writerWithoutReaderDoesNotFill) {
+    createAttachment();
+    auto writer = m_attachment->createWriter();
+    ASSERT_NE(writer, nullptr);
+    writeAll(writer.get(), m_pattern);
+    writer->close();
+
+    auto reader = m_attachment->createReader(AttachmentReader::Policy::NON_BLOCKING);
+    ASSERT_NE(reader, nullptr);
+    EXPECT_EQ(readAll(reader.get()), m_pattern);
+}
+
+/**
+ * Verify that a non-blocking reader which catches up with the writer in the spill file is told to try again rather
+ * than that the attachment is closed.
+ */
+TEST_F(AttachmentSpillTest, nonBlockingReaderWouldBlockInSpillFile) {
+    createAttachment();
+    auto writer = m_attachment->createWriter();
+    auto reader = m_attachment->createReader(AttachmentReader::Policy::NON_BLOCKING);
+    ASSERT_NE(writer, nullptr);
+    ASSERT_NE(reader, nullptr);
+    std::vector<uint8_t> firstPart(m_pattern.begin(), m_pattern.begin() + TEST_SDS_BUFFER_SIZE_IN_BYTES * 2);
+    writeAll(writer.get(), firstPart);
+
+    std::vector<uint8_t> buffer(m_pattern.size());
+    auto readStatus = AttachmentReader::ReadStatus::OK;
+    size_t numRead = 0;
+    while (AttachmentReader::ReadStatus::OK == readStatus) {
+        numRead += reader->read(buffer.data() + numRead, buffer.size() - numRead, &readStatus);
+    }
+    EXPECT_EQ(readStatus, AttachmentReader::ReadStatus::OK_WOULDBLOCK);
+    ASSERT_EQ(numRead, firstPart.size());
+    EXPECT_TRUE(std::equal(firstPart.begin(), firstPart.end(), buffer.begin()));
+
+    std::vector<uint8_t> secondPart(m_pattern.begin() + firstPart.size(), m_pattern.end());
+    writeAll(writer.get(), secondPart);
+    writer->close();
+    EXPECT_EQ(readAll(reader.get()), secondPart);
+}
+
+/**
+ * Verify that a blocking reader running alongside the writer follows it from the buffer into the spill file, and is
+ * woken by writes to the file.
+ */
+TEST_F(AttachmentSpillTest, blockingReaderFollowsWriterIntoSpillFile) {
+    createAttachment();
+    auto writer = m_attachment->createWriter();
+    auto reader = m_attachment->createReader(AttachmentReader::Policy::BLOCKING);
+    ASSERT_NE(writer, nullptr);
+    ASSERT_NE(reader, nullptr);
+
+    std::vector<uint8_t> result;
+    std::thread readerThread([this, &reader, &result] { result = readAll(reader.get()); });
+    writeAll(writer.get(), m_pattern);
+    writer->close();
+    readerThread.join();
+    EXPECT_EQ(result, m_pattern);
+}
+
+/**
+ * Verify that a blocking read with a timeout times out once the reader has caught up with the spill file.
+ */
+TEST_F(AttachmentSpillTest, blockingReadTimesOutInSpillFile) {
+    createAttachment();
+    auto writer = m_attachment->createWriter();
+    auto reader = m_attachment->createReader(AttachmentReader::Policy::BLOCKING);
+    ASSERT_NE(writer, nullptr);
+    ASSERT_NE(reader, nullptr);
+    writeAll(writer.get(), m_pattern);
+
+    // Leave room for more data than was written, so the last read waits.
+    std::vector<uint8_t> buffer(m_pattern.size() + TEST_CHUNK_SIZE_IN_BYTES);
+    auto readStatus = AttachmentReader::ReadStatus::OK;
+    size_t numRead = 0;
+    while (AttachmentReader::ReadStatus::OK == readStatus) {
+        numRead += reader->read(buffer.data() + numRead, buffer.size() - numRead, &readStatus, SHORT_TIMEOUT);
+    }
+    EXPECT_EQ(readStatus, AttachmentReader::ReadStatus::OK_TIMEDOUT);
+    EXPECT_EQ(numRead, m_pattern.size());
+}
+
+/**
+ * Verify that a reader can seek into the spilled part of an attachment.
+ */
+TEST_F(AttachmentSpillTest, seekIntoSpillFile) {
+    createAttachment();
+    auto writer = m_attachment->createWriter();
+    ASSERT_NE(writer, nullptr);
+    writeAll(writer.get(), m_pattern);
+    writer->close();
+
+    auto reader = m_attachment->createReader(AttachmentReader::Policy::NON_BLOCKING);
+    ASSERT_NE(reader, nullptr);
+    auto offset = m_pattern.size() - TEST_SDS_BUFFER_SIZE_IN_BYTES;
+    ASSERT_TRUE(reader->seek(offset));
+    EXPECT_EQ(readAll(reader.get()), std::vector<uint8_t>(m_pattern.begin() + offset, m_pattern.end()));
+}
+
+/**
+ * Verify that closing a reader after draining still lets it read what has been spilled so far, but nothing written
+ * after the close.
+ */
+TEST_F(AttachmentSpillTest, closeAfterDrainingIncludesSpilledData) {
+    createAttachment();
+    auto writer = m_attachment->createWriter();
+    auto reader = m_attachment->createReader(AttachmentReader::Policy::NON_BLOCKING);
+    ASSERT_NE(writer, nullptr);
+    ASSERT_NE(reader, nullptr);
+    std::vector<uint8_t> firstPart(m_pattern.begin(), m_pattern.begin() + TEST_SDS_BUFFER_SIZE_IN_BYTES * 2);
+    writeAll(writer.get(), firstPart);
+
+    reader->close(AttachmentReader::ClosePoint::AFTER_DRAINING_CURRENT_BUFFER);
+    writeAll(writer.get(), std::vector<uint8_t>(m_pattern.begin() + firstPart.size(), m_pattern.end()));
+    EXPECT_EQ(readAll(reader.get()), firstPart);
+}
+
+/**
+ * Verify that the @c AttachmentManager gives attachments smaller buffers once the total memory limit is reached, that
+ * such attachments still hold all of their data, and that the memory is returned when the attachments are freed.
+ */
+TEST_F(AttachmentSpillTest, managerLimitsTotalMemory) {
+    AttachmentManager manager(AttachmentManager::AttachmentType::IN_PROCESS);
+    AttachmentManager::MemoryPolicy policy;
+    policy.maxMemoryPerAttachmentInBytes = TEST_MAX_MEMORY_PER_ATTACHMENT;
+    policy.maxTotalMemoryInBytes = TEST_MAX_TOTAL_MEMORY;
+    policy.spillDirectory = m_directory;
+    ASSERT_TRUE(manager.setMemoryPolicy(policy));
+
+    auto writer1 = manager.createWriter(TEST_ATTACHMENT_ID_STRING_ONE);
+    EXPECT_EQ(manager.getMemoryInUse(), TEST_MAX_MEMORY_PER_ATTACHMENT);
+    auto writer2 = manager.createWriter(TEST_ATTACHMENT_ID_STRING_TWO);
+    EXPECT_EQ(manager.getMemoryInUse(), TEST_MAX_TOTAL_MEMORY);
+    auto writer3 = manager.createWriter(TEST_ATTACHMENT_ID_STRING_THREE);
+    EXPECT_EQ(manager.getMemoryInUse(), TEST_MAX_TOTAL_MEMORY + AttachmentManager::SPILL_BUFFER_MINIMUM_SIZE_IN_BYTES);
+    ASSERT_NE(writer3, nullptr);
+
+    auto pattern = createTestPattern(TEST_MAX_MEMORY_PER_ATTACHMENT);
+    writeAll(writer3.get(), pattern);
+    writer3->close();
+    auto reader3 = manager.createReader(TEST_ATTACHMENT_ID_STRING_THREE, AttachmentReader::Policy::NON_BLOCKING);
+    ASSERT_NE(reader3, nullptr);
+    EXPECT_EQ(readAll(reader3.get()), pattern);
+
+    for (auto id : {TEST_ATTACHMENT_ID_STRING_ONE, TEST_ATTACHMENT_ID_STRING_TWO}) {
+        manager.createReader(id, AttachmentReader::Policy::NON_BLOCKING);
+    }
+    writer1.reset();
+    writer2.reset();
+    writer3.reset();
+    reader3.reset();
+    EXPECT_EQ(manager.getMemoryInUse(), 0u);
+}
+
+/**
+ * Verify that without a spill directory, the @c AttachmentManager keeps its previous behavior of reporting a full
+ * buffer.
+ */
+TEST_F(AttachmentSpillTest, managerWithoutSpillDirectoryReportsBufferFull) {
+    AttachmentManager manager(AttachmentManager::AttachmentType::IN_PROCESS);
+    AttachmentManager::MemoryPolicy policy;
+    policy.maxMemoryPerAttachmentInBytes = AttachmentManager::SPILL_BUFFER_MINIMUM_SIZE_IN_BYTES;
+    ASSERT_TRUE(manager.setMemoryPolicy(policy));
+    policy.maxMemoryPerAttachmentInBytes = AttachmentManager::SPILL_BUFFER_MINIMUM_SIZE_IN_BYTES - 1;
+    EXPECT_FALSE(manager.setMemoryPolicy(policy));
+
+    auto writer = manager.createWriter(TEST_ATTACHMENT_ID_STRING_ONE);
+    ASSERT_NE(writer, nullptr);
+    auto pattern = createTestPattern(AttachmentManager::SPILL_BUFFER_MINIMUM_SIZE_IN_BYTES + 1);
+    auto writeStatus = AttachmentWriter::WriteStatus::OK;
+    EXPECT_EQ(writer->write(pattern.data(), pattern.size() - 1, &writeStatus), pattern.size() - 1);
+    EXPECT_EQ(writer->write(pattern.data(), 1, &writeStatus), 0u);
+    EXPECT_EQ(writeStatus, AttachmentWriter::WriteStatus::OK_BUFFER_FULL);
+}
+
+}  // namespace test
+}  // namespace avs
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
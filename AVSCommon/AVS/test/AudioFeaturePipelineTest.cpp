@@ -0,0 +1,250 @@
+/*
+ * AudioFeaturePipelineTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file AudioFeaturePipelineTest.cpp
+
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "AVSCommon/AVS/AudioFeaturePipeline.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace avs {
+namespace test {
+
+using namespace utils;
+using namespace utils::audio;
+
+/// The frame size used by the tests.
+static const size_t FRAME_SIZE = 256;
+
+/// The hop size used by the tests.
+static const size_t HOP_SIZE = 128;
+
+/// The number of frames the feature stream holds.
+static const size_t NUM_FRAMES = 64;
+
+/// The number of consumers of the features.
+static const size_t NUM_CONSUMERS = 3;
+
+/// The format of the audio used by the tests.
+static const AudioFormat FORMAT = {AudioFormat::Encoding::LPCM, AudioFormat::Endianness::LITTLE, 16000, 16, 1};
+
+/// The timeout of reads from the feature stream, which will only be hit if a test is failing.
+static const std::chrono::milliseconds TIMEOUT = std::chrono::seconds(2);
+
+/**
+ * Create an audio stream holding some audio, and close its writer.
+ *
+ * @param numWords The number of words the stream holds.
+ * @param maxReaders The maximum number of readers of the stream.
+ * @param samples The audio to write, which is written in chunks, so may be longer than the stream.
+ * @return The audio stream.
+ */
+static std::shared_ptr<AudioInputStream> createAudioStream(
+    size_t numWords,
+    size_t maxReaders,
+    const std::vector<int16_t>& samples) {
+    auto buffer = std::make_shared<AudioInputStream::Buffer>(
+        AudioInputStream::calculateBufferSize(numWords, sizeof(int16_t), maxReaders));
+    std::shared_ptr<AudioInputStream> stream = AudioInputStream::create(buffer, sizeof(int16_t), maxReaders);
+    auto writer = stream->createWriter(AudioInputStream::Writer::Policy::NONBLOCKABLE);
+    static const size_t CHUNK_SIZE = 160;
+    for (size_t i = 0; i < samples.size(); i += CHUNK_SIZE) {
+        auto chunk = std::min(CHUNK_SIZE, samples.size() - i);
+        EXPECT_EQ(writer->write(samples.data() + i, chunk), static_cast<ssize_t>(chunk));
+    }
+    writer->close();
+    return stream;
+}
+
+/**
+ * Generate pseudo random audio.
+ *
+ * @param numSamples The number of samples to generate.
+ * @return The samples.
+ */
+static std::vector<int16_t> generateNoise(size_t numSamples) {
+    std::vector<int16_t> samples(numSamples);
+    unsigned int seed = 1;
+    for (auto& sample : samples) {
+        seed = seed * 1103515245 + 12345;
+        sample = static_cast<int16_t>(seed >> 16);
+    }
+    return samples;
+}
+
+/**
+ * Read the features from a feature stream until it closes.
+ *
+ * @param reader The reader of the stream.
+ * @return The features read.
+ */
+static std::vector<AudioFeatures> readAllFeatures(AudioFeaturePipeline::FeatureStream::Reader* reader) {
+    std::vector<AudioFeatures> allFeatures;
+    AudioFeatures features;
+    while (reader->read(&features, 1, TIMEOUT) == 1) {
+        allFeatures.push_back(features);
+    }
+    return allFeatures;
+}
+
+/**
+ * Verify that invalid streams, formats and sizes are rejected.
+ */
+TEST(AudioFeaturePipelineTest, createWithInvalidParameters) {
+    auto stream = createAudioStream(FRAME_SIZE, 1, {});
+    EXPECT_EQ(AudioFeaturePipeline::create(nullptr, FORMAT, FRAME_SIZE, HOP_SIZE, NUM_FRAMES, 1), nullptr);
+
+    auto format = FORMAT;
+    format.endianness = AudioFormat::Endianness::BIG;
+    EXPECT_EQ(AudioFeaturePipeline::create(stream, format, FRAME_SIZE, HOP_SIZE, NUM_FRAMES, 1), nullptr);
+    format = FORMAT;
+    format.numChannels = 2;
+    EXPECT_EQ(AudioFeaturePipeline::create(stream, format, FRAME_SIZE, HOP_SIZE, NUM_FRAMES, 1), nullptr);
+
+    EXPECT_EQ(AudioFeaturePipeline::create(stream, FORMAT, FRAME_SIZE, 0, NUM_FRAMES, 1), nullptr);
+    EXPECT_EQ(AudioFeaturePipeline::create(stream, FORMAT, FRAME_SIZE, FRAME_SIZE + 1, NUM_FRAMES, 1), nullptr);
+    EXPECT_EQ(AudioFeaturePipeline::create(stream, FORMAT, FRAME_SIZE + 1, HOP_SIZE, NUM_FRAMES, 1), nullptr);
+    EXPECT_EQ(AudioFeaturePipeline::create(stream, FORMAT, FRAME_SIZE, HOP_SIZE, 0, 1), nullptr);
+}
+
+/**
+ * Verify that frames start at multiples of the hop size, and that the features of each frame are those of the audio
+ * at its audio index.
+ */
+TEST(AudioFeaturePipelineTest, featuresAlignWithAudio) {
+    // Overflow the stream a little, so that the oldest audio is not at a multiple of the hop size.
+    static const size_t STREAM_SIZE = 16 * FRAME_SIZE;
+    auto samples = generateNoise(STREAM_SIZE + HOP_SIZE / 2);
+    auto stream = createAudioStream(STREAM_SIZE, 1, samples);
+
+    auto pipeline = AudioFeaturePipeline::create(stream, FORMAT, FRAME_SIZE, HOP_SIZE, NUM_FRAMES, 1);
+    ASSERT_NE(pipeline, nullptr);
+    EXPECT_EQ(pipeline->getAudioIndex(0), HOP_SIZE);
+    EXPECT_EQ(pipeline->getAudioIndex(2), 3 * HOP_SIZE);
+    EXPECT_EQ(pipeline->getFeatureIndex(3 * HOP_SIZE), 2u);
+    EXPECT_EQ(pipeline->getFeatureIndex(3 * HOP_SIZE + 1), 3u);
+
+    auto reader =
+        pipeline->getFeatureStream()->createReader(AudioFeaturePipeline::FeatureStream::Reader::Policy::BLOCKING);
+    ASSERT_NE(reader, nullptr);
+    auto allFeatures = readAllFeatures(reader.get());
+    ASSERT_EQ(allFeatures.size(), (samples.size() - HOP_SIZE - FRAME_SIZE) / HOP_SIZE + 1);
+
+    auto extractor = FeatureExtractor::create(FRAME_SIZE, FORMAT.sampleRateHz);
+    ASSERT_NE(extractor, nullptr);
+    AudioFeatures expected;
+    for (size_t i = 0; i < allFeatures.size(); ++i) {
+        extractor->extract(samples.data() + pipeline->getAudioIndex(i), &expected);
+        EXPECT_EQ(std::memcmp(&allFeatures[i], &expected, sizeof(expected)), 0) << "frame " << i;
+    }
+}
+
+/**
+ * Verify that several consumers each read every frame.
+ */
+TEST(AudioFeaturePipelineTest, multipleConsumers) {
+    auto samples = generateNoise(16 * FRAME_SIZE);
+    auto stream = createAudioStream(samples.size(), 1, samples);
+    auto pipeline = AudioFeaturePipeline::create(stream, FORMAT, FRAME_SIZE, HOP_SIZE, NUM_FRAMES, NUM_CONSUMERS);
+    ASSERT_NE(pipeline, nullptr);
+
+    std::vector<std::unique_ptr<AudioFeaturePipeline::FeatureStream::Reader>> readers;
+    for (size_t i = 0; i < NUM_CONSUMERS; ++i) {
+        readers.push_back(
+            pipeline->getFeatureStream()->createReader(AudioFeaturePipeline::FeatureStream::Reader::Policy::BLOCKING));
+        ASSERT_NE(readers.back(), nullptr);
+    }
+    auto first = readAllFeatures(readers[0].get());
+    EXPECT_EQ(first.size(), (samples.size() - FRAME_SIZE) / HOP_SIZE + 1);
+    for (size_t i = 1; i < NUM_CONSUMERS; ++i) {
+        auto other = readAllFeatures(readers[i].get());
+        ASSERT_EQ(other.size(), first.size());
+        EXPECT_EQ(std::memcmp(other.data(), first.data(), first.size() * sizeof(AudioFeatures)), 0);
+    }
+}
+
+/**
+ * Compare the CPU time of @c NUM_CONSUMERS consumers sharing one pipeline with that of each running its own, as each
+ * consumer would if it computed its own features.  Disabled, as it is a benchmark rather than a test.
+ */
+TEST(AudioFeaturePipelineTest, DISABLED_benchmarkSharedVersusIndependent) {
+    static const size_t NUM_SAMPLES = 60 * FORMAT.sampleRateHz;
+    static const size_t BENCHMARK_FRAME_SIZE = 512;
+    static const size_t BENCHMARK_HOP_SIZE = 160;
+    static const size_t NUM_FEATURES = (NUM_SAMPLES - BENCHMARK_FRAME_SIZE) / BENCHMARK_HOP_SIZE + 1;
+    auto samples = generateNoise(NUM_SAMPLES);
+
+    // Each consumer reads every frame from its own feature stream reader.
+    auto consume = [](std::vector<std::unique_ptr<AudioFeaturePipeline::FeatureStream::Reader>> readers) {
+        std::vector<std::thread> threads;
+        for (auto& reader : readers) {
+            threads.emplace_back([&reader] { EXPECT_EQ(readAllFeatures(reader.get()).size(), NUM_FEATURES); });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    };
+
+    auto start = std::clock();
+    {
+        auto stream = createAudioStream(NUM_SAMPLES, 1, samples);
+        auto pipeline = AudioFeaturePipeline::create(
+            stream, FORMAT, BENCHMARK_FRAME_SIZE, BENCHMARK_HOP_SIZE, NUM_FEATURES, NUM_CONSUMERS);
+        ASSERT_NE(pipeline, nullptr);
+        std::vector<std::unique_ptr<AudioFeaturePipeline::FeatureStream::Reader>> readers;
+        for (size_t i = 0; i < NUM_CONSUMERS; ++i) {
+            readers.push_back(pipeline->getFeatureStream()->createReader(
+                AudioFeaturePipeline::FeatureStream::Reader::Policy::BLOCKING));
+        }
+        consume(std::move(readers));
+    }
+    auto shared = std::clock() - start;
+
+    start = std::clock();
+    {
+        auto stream = createAudioStream(NUM_SAMPLES, NUM_CONSUMERS, samples);
+        std::vector<std::unique_ptr<AudioFeaturePipeline>> pipelines;
+        std::vector<std::unique_ptr<AudioFeaturePipeline::FeatureStream::Reader>> readers;
+        for (size_t i = 0; i < NUM_CONSUMERS; ++i) {
+            pipelines.push_back(AudioFeaturePipeline::create(
+                stream, FORMAT, BENCHMARK_FRAME_SIZE, BENCHMARK_HOP_SIZE, NUM_FEATURES, 1));
+            ASSERT_NE(pipelines.back(), nullptr);
+            readers.push_back(pipelines.back()->getFeatureStream()->createReader(
+                AudioFeaturePipeline::FeatureStream::Reader::Policy::BLOCKING));
+        }
+        consume(std::move(readers));
+    }
+    auto independent = std::clock() - start;
+
+    auto toMs = [](std::clock_t ticks) { return ticks * 1000 / CLOCKS_PER_SEC; };
+    std::cout << NUM_CONSUMERS << " consumers of " << NUM_SAMPLES / FORMAT.sampleRateHz
+              << " s of audio: shared pipeline " << toMs(shared) << " ms CPU, independent pipelines "
+              << toMs(independent) << " ms CPU" << std::endl;
+}
+
+}  // namespace test
+}  // namespace avs
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
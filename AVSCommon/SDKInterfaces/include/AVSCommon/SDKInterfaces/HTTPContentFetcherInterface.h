@@ -18,6 +18,8 @@
 #ifndef ALEXA_CLIENT_SDK_AVSCOMMON_SDKINTERFACES_INCLUDE_AVSCOMMON_SDKINTERFACES_HTTPCONTENTFETCHERINTERFACE_H_
 #define ALEXA_CLIENT_SDK_AVSCOMMON_SDKINTERFACES_INCLUDE_AVSCOMMON_SDKINTERFACES_HTTPCONTENTFETCHERINTERFACE_H_
 
+#include <cstddef>
+#include <limits>
 #include <memory>
 
 #include <AVSCommon/Utils/HTTPContent.h>
@@ -40,6 +42,9 @@ public:
         ENTIRE_BODY
     };
 
+    /// Value of @c lastByte passed to @c getContentInRange() to request everything up to the end of the body.
+    static constexpr size_t END_OF_BODY = std::numeric_limits<size_t>::max();
+
     /**
      * Destructor.
      */
@@ -52,6 +57,25 @@ public:
      * @return A new @c HTTPContent object or @c nullptr if a failure occured.
      */
     virtual std::unique_ptr<avsCommon::utils::HTTPContent> getContent(FetchOptions option) = 0;
+
+    /**
+     * This function retrieves a byte range of the body of a remote location using an HTTP Range request. Servers that
+     * honor the request respond with status code 206, while servers that ignore it respond with status code 200 and
+     * the entire body. Callers must check the status code to know where the returned content begins. No thread safety
+     * is guaranteed.
+     *
+     * The default implementation ignores the range and retrieves the entire body.
+     *
+     * @param firstByte The offset of the first byte to retrieve.
+     * @param lastByte The offset of the last byte to retrieve (inclusive), or @c END_OF_BODY to retrieve everything
+     * from @c firstByte onwards.
+     * @return A new @c HTTPContent object or @c nullptr if a failure occured.
+     */
+    virtual std::unique_ptr<avsCommon::utils::HTTPContent> getContentInRange(
+        size_t firstByte,
+        size_t lastByte = END_OF_BODY) {
+        return getContent(FetchOptions::ENTIRE_BODY);
+    }
 };
 
 }  // namespace sdkInterfaces
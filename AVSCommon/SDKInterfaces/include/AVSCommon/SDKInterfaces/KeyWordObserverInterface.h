@@ -46,6 +46,9 @@ public:
      * engine is used. Any additional work that needs to be done should be done on a separate thread or after
      * returning.
      *
+     * If the @c stream has a @c TimestampTrack, the time at which the audio at @c beginIndex and @c endIndex was
+     * captured can be looked up with @c stream->getTimestampTrack()->getTime().
+     *
      * @param stream The stream in which the keyword was detected.
      * @param keyword The keyword detected.
      * @param beginIndex The optional absolute begin index of the first part of the keyword found within the @c stream.
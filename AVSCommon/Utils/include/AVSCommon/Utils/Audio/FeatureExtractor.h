@@ -0,0 +1,162 @@
+/*
+ * FeatureExtractor.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_AUDIO_FEATUREEXTRACTOR_H_
+#define ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_AUDIO_FEATUREEXTRACTOR_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace audio {
+
+/**
+ * The features of one frame of audio.  This is a plain struct of fixed size, so that frames can be published as the
+ * words of a @c SharedDataStream.
+ */
+struct AudioFeatures {
+    /// The number of bands the spectrum is divided into.
+    static constexpr size_t NUM_BANDS = 16;
+
+    /// The mean square of the samples of the frame, with samples scaled to [-1, 1).
+    float energy;
+
+    /// The fraction of pairs of neighbouring samples in the frame which differ in sign.
+    float zeroCrossingRate;
+
+    /**
+     * The energy of the Hann windowed frame in each band, from low to high frequency.  The bands are equally wide on
+     * the mel scale, and together cover the spectrum above DC up to half the sample rate.  The energies are scaled
+     * so that a full scale sine wave centered in a band gives that band about the same energy as @c energy.
+     */
+    float bandEnergies[NUM_BANDS];
+
+    /// Whether the frame was computed from audio.  Frames standing in for audio which was lost are zero and invalid.
+    uint32_t isValid;
+};
+
+/**
+ * Computes @c AudioFeatures from frames of 16 bit mono PCM audio: the energy and zero crossing rate of the frame, and
+ * the band energies of its real FFT.
+ *
+ * The per sample kernels (windowing, energy, zero crossings and the FFT butterflies) work four samples at a time with
+ * SSE or NEON where available, and with plain C++ elsewhere.
+ *
+ * An instance keeps scratch buffers, so it must not be used by more than one thread at a time.
+ */
+class FeatureExtractor {
+public:
+    /// The smallest frame size supported.
+    static constexpr size_t MIN_FRAME_SIZE = 64;
+
+    /**
+     * Create a @c FeatureExtractor.
+     *
+     * @param frameSize The number of samples per frame.  Must be a power of two, and at least @c MIN_FRAME_SIZE, which
+     *     gives each band at least one bin.
+     * @param sampleRateHz The sample rate of the audio, which places the band edges.
+     * @return The new @c FeatureExtractor, or @c nullptr if the parameters are invalid.
+     */
+    static std::unique_ptr<FeatureExtractor> create(size_t frameSize, unsigned int sampleRateHz);
+
+    /**
+     * Compute the features of a frame.
+     *
+     * @param samples The @c getFrameSize() samples of the frame.
+     * @param[out] features The features of the frame.
+     */
+    void extract(const int16_t* samples, AudioFeatures* features);
+
+    /**
+     * Get the power spectrum of the frame last passed to @c extract(), for consumers which need more detail than the
+     * bands give.
+     *
+     * @return The power of the bins from DC to half the sample rate; @c getFrameSize() / 2 + 1 values.
+     */
+    const std::vector<float>& getPowerSpectrum() const;
+
+    /**
+     * Get the number of samples per frame.
+     *
+     * @return The number of samples per frame.
+     */
+    size_t getFrameSize() const;
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param frameSize The number of samples per frame.
+     * @param sampleRateHz The sample rate of the audio.
+     */
+    FeatureExtractor(size_t frameSize, unsigned int sampleRateHz);
+
+    /**
+     * Transform @c m_real and @c m_imaginary in place with a complex FFT of @c frameSize / 2 points.
+     */
+    void complexFft();
+
+    /// The number of samples per frame.
+    const size_t m_frameSize;
+
+    /// The Hann window.
+    std::vector<float> m_window;
+
+    /// The bit reversal permutation of the complex FFT.
+    std::vector<uint32_t> m_bitReversal;
+
+    /// The real parts of the twiddle factors of each stage of the complex FFT, one stage after the other.
+    std::vector<float> m_twiddleReal;
+
+    /// The imaginary parts of the twiddle factors of each stage of the complex FFT.
+    std::vector<float> m_twiddleImaginary;
+
+    /// The real parts of the twiddle factors which split the complex FFT into the real FFT.
+    std::vector<float> m_splitReal;
+
+    /// The imaginary parts of the twiddle factors which split the complex FFT into the real FFT.
+    std::vector<float> m_splitImaginary;
+
+    /// The first bin of each band, and the bin after the last band.
+    std::vector<size_t> m_bandEdges;
+
+    /// The factor scaling the power of each bin to contribute to a band energy.
+    float m_bandScale;
+
+    /// Scratch space for the samples of the frame, scaled to [-1, 1).
+    std::vector<float> m_samples;
+
+    /// Scratch space for the real parts of the complex FFT.
+    std::vector<float> m_real;
+
+    /// Scratch space for the imaginary parts of the complex FFT.
+    std::vector<float> m_imaginary;
+
+    /// The power spectrum of the last frame.
+    std::vector<float> m_powerSpectrum;
+};
+
+}  // namespace audio
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_AUDIO_FEATUREEXTRACTOR_H_
@@ -28,6 +28,12 @@ namespace alexaClientSDK {
 namespace avsCommon {
 namespace utils {
 
+/// HTTP status code indicating success.
+static const long HTTP_STATUS_CODE_SUCCESS_OK = 200;
+
+/// HTTP status code indicating that a Range request was honored and only part of the body is returned.
+static const long HTTP_STATUS_CODE_SUCCESS_PARTIAL_CONTENT = 206;
+
 /**
  * This struct encapsulates content received from HTTP request, specifically the status code, the content-type, and the
  * actual content of the response.
@@ -37,6 +43,9 @@ struct HTTPContent {
      * This function blocks until @c statusCode is set and checks whether it is equal to 200, indicating an HTTP sucess
      * code.
      *
+     * @note This consumes @c statusCode. Callers that issued a Range request should read @c statusCode directly to
+     * distinguish a full (200) from a partial (206) response.
+     *
      * @return @c true if `statuscode == 200`, else @c false.
      */
     operator bool() const;
@@ -52,7 +61,7 @@ struct HTTPContent {
 };
 
 inline HTTPContent::operator bool() const {
-    return statusCode.get() == 200;
+    return statusCode.get() == HTTP_STATUS_CODE_SUCCESS_OK;
 }
 
 }  // namespace utils
@@ -90,6 +90,22 @@ public:
      */
     CURLMcode wait(std::chrono::milliseconds timeout, int* countHandlesUpdated);
 
+    /**
+     * Make a @c wait() in progress, or the next one, return early.  This may be called from any thread.  With a
+     * @c libcurl older than 7.68.0, this does nothing, and @c wait() returns at its timeout.
+     *
+     * @return @c libcurl code indicating the result of this operation.
+     */
+    CURLMcode wakeup();
+
+    /**
+     * Whether @c wakeup() can end a @c wait(), which needs @c libcurl 7.68.0 or newer.  Without it, callers must not
+     * wait for longer than they can afford to react late.
+     *
+     * @return Whether @c wakeup() ends a @c wait().
+     */
+    static bool isWakeupSupported();
+
     /**
      * Receive the next messages about the @c libcurl @c handles added to this @c libcurl @c multi @c handle.
      *
@@ -45,6 +45,13 @@ public:
      */
     std::unique_ptr<avsCommon::utils::HTTPContent> getContent(FetchOptions fetchOption) override;
 
+    /**
+     * @copydoc
+     * In this implementation, the function may only be called once, and not after @c getContent() has been called.
+     */
+    std::unique_ptr<avsCommon::utils::HTTPContent> getContentInRange(size_t firstByte, size_t lastByte = END_OF_BODY)
+        override;
+
     /*
      * Destructor.
      */
@@ -0,0 +1,50 @@
+/*
+ * BinaryLogDecoder.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_LOGGER_BINARYLOGDECODER_H_
+#define ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_LOGGER_BINARYLOGDECODER_H_
+
+#include <istream>
+#include <ostream>
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace logger {
+
+/**
+ * Decodes a log written by @c BinaryLogger back in to the text lines @c ConsoleLogger would have emitted.
+ */
+class BinaryLogDecoder {
+public:
+    /**
+     * Decode a binary log.  Entries are decoded up to the end of @c input, or up to the first record which is
+     * truncated or corrupt.
+     *
+     * @param input The binary log.
+     * @param output The stream to write the text lines to, one per entry.
+     * @return @c true if all of @c input was decoded, else @c false.
+     */
+    static bool decode(std::istream& input, std::ostream& output);
+};
+
+}  // namespace logger
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_LOGGER_BINARYLOGDECODER_H_
@@ -0,0 +1,102 @@
+/*
+ * BinaryLogFormat.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_LOGGER_BINARYLOGFORMAT_H_
+#define ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_LOGGER_BINARYLOGFORMAT_H_
+
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace logger {
+
+/**
+ * A @c BinaryLogFormat describes one binary log call site: the source and event of the entry, and the keys of the
+ * values logged with it.  It is the binary equivalent of the @c LX(event).d(key, ...) expression of a text log line,
+ * except that it is built once rather than on every log call.
+ *
+ * Formats are intended to be defined with static storage duration next to the @c TAG of a .cpp file, so that each is
+ * assigned its id when the module is loaded.  Ids are taken from a process wide counter; there is no registry of
+ * formats, each log learns of a format the first time it is used with it:
+ *
+ *     static const std::string TAG("MyClass");
+ *     static const BinaryLogFormat READ_FAILED(TAG, "readFailed", {"reason", "error"});
+ *
+ *     binaryLogger.logBinary(Level::ERROR, READ_FAILED, "overrun", error);
+ *
+ * Only the id of the format and the raw values are written per entry.  The strings of the format are written to a
+ * log once, the first time the format is used with it.
+ */
+class BinaryLogFormat {
+public:
+    /**
+     * Constructor.  Assigns the format the next unused id.
+     *
+     * @param source The name of the source of entries of this format, typically the @c TAG of the file.
+     * @param event The name of the event that entries of this format describe.
+     * @param keys The keys of the values logged with each entry, in the order the values are passed.
+     */
+    BinaryLogFormat(const std::string& source, const std::string& event, std::initializer_list<const char*> keys = {});
+
+    /// Formats are identified by their id, so may not be copied.
+    BinaryLogFormat(const BinaryLogFormat&) = delete;
+    BinaryLogFormat& operator=(const BinaryLogFormat&) = delete;
+
+    /**
+     * @return The id of this format, unique within the process.
+     */
+    uint32_t getId() const;
+
+    /**
+     * @return The name of the source of entries of this format.
+     */
+    const std::string& getSource() const;
+
+    /**
+     * @return The name of the event that entries of this format describe.
+     */
+    const std::string& getEvent() const;
+
+    /**
+     * @return The keys of the values logged with each entry.
+     */
+    const std::vector<std::string>& getKeys() const;
+
+private:
+    /// The id of this format.
+    const uint32_t m_id;
+
+    /// The name of the source of entries of this format.
+    const std::string m_source;
+
+    /// The name of the event that entries of this format describe.
+    const std::string m_event;
+
+    /// The keys of the values logged with each entry.
+    const std::vector<std::string> m_keys;
+};
+
+}  // namespace logger
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_LOGGER_BINARYLOGFORMAT_H_
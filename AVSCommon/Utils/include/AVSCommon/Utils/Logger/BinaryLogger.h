@@ -0,0 +1,368 @@
+/*
+ * BinaryLogger.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_LOGGER_BINARYLOGGER_H_
+#define ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_LOGGER_BINARYLOGGER_H_
+
+#include <cstring>
+#include <memory>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "AVSCommon/Utils/Logger/BinaryLogFormat.h"
+#include "AVSCommon/Utils/Logger/Logger.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace logger {
+
+/**
+ * A @c Logger which writes a compact binary log to a stream (typically a file) rather than rendering text.  Entries
+ * logged with @c logBinary() are written as the id of their @c BinaryLogFormat followed by their raw values, so no
+ * text is formatted on the device.  Entries which arrive through the regular @c Logger interface (for example when
+ * this logger is installed with @c LoggerSinkManager) are written with their text, but without the date, time,
+ * thread and level formatting done by @c formatLogString().
+ *
+ * Strings which repeat across entries (format sources, events and keys, and thread monikers) are written once, the
+ * first time they are used, so a log is self describing.  @c BinaryLogDecoder reconstructs the text which
+ * @c ConsoleLogger would have emitted for each entry.
+ *
+ * Thread indices are reused once @c MAX_THREAD_INDICES threads have logged, so that a process which keeps creating
+ * threads does not grow the table without bound.  A reused index is redefined with a new @c THREAD record first.
+ *
+ * The sink is opt in: no SDK component logs with @c logBinary() yet, so until call sites are converted an application
+ * gets the smaller log and cheaper formatting of @c TEXT records by installing a @c BinaryLogger as its sink.
+ *
+ * The log is a magic string followed by records.  Each record starts with a @c RecordType byte.  Integers are
+ * written as LEB128 varints, signed integers and time deltas zigzag encoded first, and strings as a varint length
+ * followed by their bytes.
+ */
+class BinaryLogger : public Logger {
+public:
+    /// The types of record in a binary log.
+    enum class RecordType : uint8_t {
+        /// Defines a format: id, source, event, number of keys, keys.
+        FORMAT = 1,
+        /// Defines a thread: index, moniker.
+        THREAD = 2,
+        /// An entry logged with @c logBinary(): level, time delta, thread index, format id, number of values, values.
+        ENTRY = 3,
+        /// An entry logged with text: level, time delta, thread index, text.
+        TEXT = 4
+    };
+
+    /// The types of value in an @c ENTRY record.  Each value is written as its type followed by its payload.
+    enum class ValueType : uint8_t {
+        /// A zigzag encoded varint.
+        SIGNED = 1,
+        /// A varint.
+        UNSIGNED = 2,
+        /// The 8 bytes of an IEEE 754 double, least significant first.
+        DOUBLE = 3,
+        /// The value @c false, without payload.
+        BOOL_FALSE = 4,
+        /// The value @c true, without payload.
+        BOOL_TRUE = 5,
+        /// A string.
+        STRING = 6
+    };
+
+    /// The magic string at the start of every binary log, which includes the version of the log format.
+    static const std::string MAGIC;
+
+    /// The maximum number of thread indices defined in a log before they are reused.
+    static const size_t MAX_THREAD_INDICES;
+
+    /**
+     * Create a @c BinaryLogger.
+     *
+     * @param stream The stream to write the log to.
+     * @param level The lowest severity level of logs to be written.
+     * @return A new @c BinaryLogger, or @c nullptr if the operation failed.
+     */
+    static std::shared_ptr<BinaryLogger> create(std::shared_ptr<std::ostream> stream, Level level = Level::INFO);
+
+    /**
+     * Destructor.  Flushes the stream.
+     */
+    ~BinaryLogger() override;
+
+    void emit(Level level, std::chrono::system_clock::time_point time, const char* threadMoniker, const char* text)
+        override;
+
+    /**
+     * Log an entry of the given format, if @c level is to be logged.  Values must be passed in the order of the keys
+     * of @c format.  Integral, floating point, boolean and string values are written raw; values of other types are
+     * rendered with their @c operator<<.
+     *
+     * @param level The severity Level of this entry.
+     * @param format The format of this entry.
+     * @param values The values of this entry.
+     */
+    template <typename... Values>
+    void logBinary(Level level, const BinaryLogFormat& format, const Values&... values);
+
+    /**
+     * Flush any entries buffered by the stream.  Entries of severity @c ERROR and above are flushed as they are
+     * written.
+     */
+    void flush();
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param stream The stream to write the log to.
+     * @param level The lowest severity level of logs to be written.
+     */
+    BinaryLogger(std::shared_ptr<std::ostream> stream, Level level);
+
+    /**
+     * Write an @c ENTRY record, preceded by any @c FORMAT or @c THREAD records it depends on.
+     *
+     * @param level The severity Level of the entry.
+     * @param time The time of the entry.
+     * @param format The format of the entry.
+     * @param numValues The number of values of the entry.
+     * @param values The encoded values of the entry.
+     */
+    void writeEntry(
+        Level level,
+        std::chrono::system_clock::time_point time,
+        const BinaryLogFormat& format,
+        size_t numValues,
+        const std::string& values);
+
+    /**
+     * Append the level, time delta and thread index shared by @c ENTRY and @c TEXT records to @c m_record, preceded
+     * by a @c THREAD record if the thread has not been defined yet.  @c m_mutex must be held.
+     *
+     * @param type The type of record being written.
+     * @param level The severity Level of the entry.
+     * @param time The time of the entry.
+     * @param threadMoniker The moniker of the thread which logged the entry.
+     */
+    void appendEntryHeaderLocked(
+        RecordType type,
+        Level level,
+        std::chrono::system_clock::time_point time,
+        const char* threadMoniker);
+
+    /**
+     * Get the index of a thread in this log, appending a @c THREAD record to @c m_record if the thread has not been
+     * defined yet.  @c m_mutex must be held.
+     *
+     * @param threadMoniker The moniker of the thread.
+     * @return The index of the thread.
+     */
+    uint32_t getThreadIndexLocked(const char* threadMoniker);
+
+    /**
+     * Write @c m_record to the stream, flushing it if the entry is severe.  @c m_mutex must be held.
+     *
+     * @param level The severity Level of the entry.
+     */
+    void writeRecordLocked(Level level);
+
+    /**
+     * Append a varint to a buffer.
+     *
+     * @param value The value to append.
+     * @param buffer The buffer to append to.
+     */
+    static inline void appendVarint(uint64_t value, std::string* buffer);
+
+    /**
+     * Append a zigzag encoded varint to a buffer.
+     *
+     * @param value The value to append.
+     * @param buffer The buffer to append to.
+     */
+    static inline void appendSignedVarint(int64_t value, std::string* buffer);
+
+    /**
+     * Append a string to a buffer.
+     *
+     * @param data The characters of the string.
+     * @param size The number of characters of the string.
+     * @param buffer The buffer to append to.
+     */
+    static inline void appendString(const char* data, size_t size, std::string* buffer);
+
+    /// @name Typed value encoders.
+    /// @{
+    static inline void appendValue(bool value, std::string* buffer);
+    static inline void appendValue(const char* value, std::string* buffer);
+    static inline void appendValue(const std::string& value, std::string* buffer);
+    template <typename Value>
+    static inline typename std::enable_if<std::is_integral<Value>::value && std::is_signed<Value>::value>::type
+    appendValue(const Value& value, std::string* buffer);
+    template <typename Value>
+    static inline typename std::enable_if<std::is_integral<Value>::value && std::is_unsigned<Value>::value>::type
+    appendValue(const Value& value, std::string* buffer);
+    template <typename Value>
+    static inline typename std::enable_if<std::is_floating_point<Value>::value>::type appendValue(
+        const Value& value,
+        std::string* buffer);
+    template <typename Value>
+    static inline typename std::enable_if<!std::is_arithmetic<Value>::value>::type appendValue(
+        const Value& value,
+        std::string* buffer);
+    /// @}
+
+    /**
+     * Terminates the recursion of @c appendValues().
+     *
+     * @param buffer The buffer to append to.
+     */
+    static inline void appendValues(std::string* buffer);
+
+    /**
+     * Append values to a buffer.
+     *
+     * @param buffer The buffer to append to.
+     * @param value The first value to append.
+     * @param rest The remaining values to append.
+     */
+    template <typename Value, typename... Rest>
+    static inline void appendValues(std::string* buffer, const Value& value, const Rest&... rest);
+
+    /// Serializes access to the members below and to @c m_stream.
+    std::mutex m_mutex;
+
+    /// The stream to write the log to.
+    std::shared_ptr<std::ostream> m_stream;
+
+    /// Buffer in which a record is assembled before it is written, reused to avoid allocations.
+    std::string m_record;
+
+    /// Whether the format with a given id has been defined in this log.
+    std::vector<bool> m_definedFormats;
+
+    /// The indices of the threads defined in this log, keyed by moniker.  Holds at most @c MAX_THREAD_INDICES.
+    std::unordered_map<std::string, uint32_t> m_threadIndices;
+
+    /**
+     * Identifies this logger's current set of thread indices to the per-thread cache of the last index used, and
+     * changes whenever the indices are reset.  Unique across all loggers in the process.
+     */
+    uint64_t m_threadIndicesGeneration;
+
+    /// The time of the previous entry, in microseconds since the epoch.
+    int64_t m_previousTimeMicros;
+};
+
+template <typename... Values>
+void BinaryLogger::logBinary(Level level, const BinaryLogFormat& format, const Values&... values) {
+    if (!shouldLog(level)) {
+        return;
+    }
+    auto time = std::chrono::system_clock::now();
+    // Encode the values before taking the lock, into a per-thread buffer so that its capacity is reused.
+    static thread_local std::string encodedValues;
+    encodedValues.clear();
+    appendValues(&encodedValues, values...);
+    writeEntry(level, time, format, sizeof...(values), encodedValues);
+}
+
+void BinaryLogger::appendVarint(uint64_t value, std::string* buffer) {
+    while (value >= 0x80) {
+        buffer->push_back(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    buffer->push_back(static_cast<char>(value));
+}
+
+void BinaryLogger::appendSignedVarint(int64_t value, std::string* buffer) {
+    appendVarint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63), buffer);
+}
+
+void BinaryLogger::appendString(const char* data, size_t size, std::string* buffer) {
+    appendVarint(size, buffer);
+    buffer->append(data, size);
+}
+
+void BinaryLogger::appendValue(bool value, std::string* buffer) {
+    buffer->push_back(static_cast<char>(value ? ValueType::BOOL_TRUE : ValueType::BOOL_FALSE));
+}
+
+void BinaryLogger::appendValue(const char* value, std::string* buffer) {
+    buffer->push_back(static_cast<char>(ValueType::STRING));
+    appendString(value, value ? std::strlen(value) : 0, buffer);
+}
+
+void BinaryLogger::appendValue(const std::string& value, std::string* buffer) {
+    buffer->push_back(static_cast<char>(ValueType::STRING));
+    appendString(value.data(), value.size(), buffer);
+}
+
+template <typename Value>
+typename std::enable_if<std::is_integral<Value>::value && std::is_signed<Value>::value>::type BinaryLogger::
+    appendValue(const Value& value, std::string* buffer) {
+    buffer->push_back(static_cast<char>(BinaryLogger::ValueType::SIGNED));
+    appendSignedVarint(value, buffer);
+}
+
+template <typename Value>
+typename std::enable_if<std::is_integral<Value>::value && std::is_unsigned<Value>::value>::type BinaryLogger::
+    appendValue(const Value& value, std::string* buffer) {
+    buffer->push_back(static_cast<char>(BinaryLogger::ValueType::UNSIGNED));
+    appendVarint(value, buffer);
+}
+
+template <typename Value>
+typename std::enable_if<std::is_floating_point<Value>::value>::type BinaryLogger::appendValue(
+    const Value& value,
+    std::string* buffer) {
+    buffer->push_back(static_cast<char>(BinaryLogger::ValueType::DOUBLE));
+    double asDouble = value;
+    uint64_t bits;
+    std::memcpy(&bits, &asDouble, sizeof(bits));
+    for (size_t i = 0; i < sizeof(bits); ++i) {
+        buffer->push_back(static_cast<char>(bits >> (i * 8)));
+    }
+}
+
+template <typename Value>
+typename std::enable_if<!std::is_arithmetic<Value>::value>::type BinaryLogger::appendValue(
+    const Value& value,
+    std::string* buffer) {
+    std::ostringstream rendered;
+    rendered << value;
+    appendValue(rendered.str(), buffer);
+}
+
+void BinaryLogger::appendValues(std::string* buffer) {
+}
+
+template <typename Value, typename... Rest>
+void BinaryLogger::appendValues(std::string* buffer, const Value& value, const Rest&... rest) {
+    appendValue(value, buffer);
+    appendValues(buffer, rest...);
+}
+
+}  // namespace logger
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_LOGGER_BINARYLOGGER_H_
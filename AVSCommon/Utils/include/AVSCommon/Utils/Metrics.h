@@ -18,8 +18,11 @@
 #ifndef ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_METRICS_H_
 #define ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_METRICS_H_
 
+#include <chrono>
+
 #include <AVSCommon/Utils/Logger/LogEntry.h>
 #include <AVSCommon/AVS/AVSMessage.h>
+#include <AVSCommon/AVS/MessageRequestTimings.h>
 
 namespace alexaClientSDK {
 namespace avsCommon {
@@ -48,6 +51,12 @@ public:
         // AudioInputProcessor send the message
         AIP_SEND,
 
+        // A keyword detector detected a keyword
+        KWD_DETECT,
+
+        // ACL finished sending the message
+        ACL_SEND_COMPLETE,
+
         // Used when issuing an extra metric log for missing Ids
         BUILDING_MESSAGE
     };
@@ -80,6 +89,34 @@ public:
         const std::shared_ptr<alexaClientSDK::avsCommon::avs::AVSMessage> msg,
         Location location);
 
+    /**
+     * Add the latency since the capture of some audio to a @c LogEntry.
+     * @param logEntry The @c LogEntry object to add the metric info.
+     * @param name @c Event/@c Directive name.
+     * @param captureLatency The time elapsed since the audio was captured.
+     * @param location The location in which the log was issued.
+     * @return The given @c LogEntry with the metric info added.
+     */
+    static logger::LogEntry& d(
+        alexaClientSDK::avsCommon::utils::logger::LogEntry& logEntry,
+        const std::string& name,
+        std::chrono::milliseconds captureLatency,
+        Location location);
+
+    /**
+     * Add the network timings of a sent message to a @c LogEntry.
+     * @param logEntry The @c LogEntry object to add the metric info.
+     * @param name @c Event name.
+     * @param timings The timings of the message.
+     * @param location The location in which the log was issued.
+     * @return The given @c LogEntry with the metric info added.
+     */
+    static logger::LogEntry& d(
+        alexaClientSDK::avsCommon::utils::logger::LogEntry& logEntry,
+        const std::string& name,
+        const alexaClientSDK::avsCommon::avs::MessageRequestTimings& timings,
+        Location location);
+
 private:
     /**
      * Translate @c Location into a string representation.
@@ -134,6 +171,38 @@ private:
         ACSDK_METRIC_WITH_ENTRY(logEntry);                                     \
     } while (false)
 
+/**
+ * Send a Metric log line with the latency since some audio was captured.
+ *
+ * @param TAG The name of the source of the log entry
+ * @param name The Event \ Directive name.
+ * @param captureLatency The time elapsed since the audio was captured.  This is not evaluated if metrics are disabled.
+ * @param location The location where this message was issued.
+ */
+#define ACSDK_METRIC_CAPTURE_LATENCY(TAG, name, captureLatency, location)                       \
+    do {                                                                                        \
+        alexaClientSDK::avsCommon::utils::logger::LogEntry logEntry(                            \
+            TAG, __func__ + alexaClientSDK::avsCommon::utils::METRICS_TAG);                     \
+        alexaClientSDK::avsCommon::utils::Metrics::d(logEntry, name, captureLatency, location); \
+        ACSDK_METRIC_WITH_ENTRY(logEntry);                                                      \
+    } while (false)
+
+/**
+ * Send a Metric log line with the network timings of a sent message.
+ *
+ * @param TAG The name of the source of the log entry
+ * @param name The Event name.  This is not evaluated if metrics are disabled.
+ * @param timings The @c MessageRequestTimings of the message.
+ * @param location The location where this message was issued.
+ */
+#define ACSDK_METRIC_TIMINGS(TAG, name, timings, location)                               \
+    do {                                                                                 \
+        alexaClientSDK::avsCommon::utils::logger::LogEntry logEntry(                     \
+            TAG, __func__ + alexaClientSDK::avsCommon::utils::METRICS_TAG);              \
+        alexaClientSDK::avsCommon::utils::Metrics::d(logEntry, name, timings, location); \
+        ACSDK_METRIC_WITH_ENTRY(logEntry);                                               \
+    } while (false)
+
 #else  // ACSDK_LATENCY_LOG_ENABLED
 
 /**
@@ -156,6 +225,26 @@ private:
  */
 #define ACSDK_METRIC_MSG(TAG, msg, location)
 
+/**
+ * Compile out a METRIC log line.
+ *
+ * @param TAG The name of the source of the log entry
+ * @param name The Event \ Directive name.
+ * @param captureLatency The time elapsed since the audio was captured.
+ * @param location The location where this message was issued.
+ */
+#define ACSDK_METRIC_CAPTURE_LATENCY(TAG, name, captureLatency, location)
+
+/**
+ * Compile out a METRIC log line.
+ *
+ * @param TAG The name of the source of the log entry
+ * @param name The Event name.
+ * @param timings The @c MessageRequestTimings of the message.
+ * @param location The location where this message was issued.
+ */
+#define ACSDK_METRIC_TIMINGS(TAG, name, timings, location)
+
 #endif  // ACSDK_LATENCY_LOG_ENABLED
 
 #endif  // ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_METRICS_H_
@@ -18,14 +18,21 @@
 #ifndef ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_SDS_BUFFERLAYOUT_H_
 #define ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_SDS_BUFFERLAYOUT_H_
 
+#include <algorithm>
+#include <atomic>
+#include <bitset>
 #include <cstdint>
 #include <cstddef>
+#include <limits>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <vector>
 
 #include "AVSCommon/Utils/Logger/LoggerUtils.h"
+#include "ReadinessNotifier.h"
 #include "SharedDataStream.h"
+#include "TimestampTrack.h"
 
 namespace alexaClientSDK {
 namespace avsCommon {
@@ -34,9 +41,8 @@ namespace sds {
 
 /**
  * This is a nested class inside @c SharedDatastream which defines the layout of a @c Buffer for use with a
- * @c SharedDataStream.  This layout begins with a fixed @c Header structure, followed by two arrays of
- * @c Reader @c Indexes, with the remainder allocated to data.  All four of these sections are aligned on a 64-bit
- * boundary.
+ * @c SharedDataStream.  This layout begins with a fixed @c Header structure, followed by the per-@c Reader arrays
+ * and the per-@c Writer arrays, with the remainder allocated to data.
  */
 template <typename T>
 class SharedDataStream<T>::BufferLayout {
@@ -45,7 +51,7 @@ public:
     static const uint32_t MAGIC_NUMBER = 0x53445348;
 
     /// Version of this header layout.
-    static const uint32_t VERSION = 2;
+    static const uint32_t VERSION = 4;
 
     /**
      * The constructor only initializes a shared pointer to the provided buffer.  Attaching and/or initializing is
@@ -97,12 +103,26 @@ public:
          */
         uint8_t maxReaders;
 
-        /// This field contains the condition variable used to notify @c Readers that data is available.
-        ConditionVariable dataAvailableConditionVariable;
+        /**
+         * This field specifies the maximum number of @c Writers which may be open at once.
+         *
+         * @note This value determines the size of the writer arrays that follow the reader arrays in the @c Buffer.
+         */
+        uint8_t maxWriters;
 
-        /// This field contains the mutex used by @c dataAvailableConditionVariable.
+        /**
+         * This field contains the mutex used by the @c Reader data available condition variables, and which protects
+         * the @c Reader wake @c Indexes and @c readerWakeCursor.
+         */
         Mutex dataAvailableMutex;
 
+        /**
+         * This field contains the lowest @c Reader wake @c Index.  A @c Writer compares @c writeStartCursor against it
+         * after each write, and only wakes @c Readers once it has been reached.  It is
+         * @c std::numeric_limits<Index>::max() when no @c Reader is waiting.
+         */
+        AtomicIndex readerWakeCursor;
+
         /**
          * This field contains the condition variable used to notify @c Writers that space is available.  Note that
          * this condition variable does not have a dedicated mutex; the condition is protected by backwardSeekMutex.
@@ -117,27 +137,48 @@ public:
          */
         Mutex backwardSeekMutex;
 
-        /// This field indicates whether there is an enabled (not closed) @c Writer.
+        /// This field indicates whether there is at least one enabled (not closed) @c Writer.
         AtomicBool isWriterEnabled;
 
-        /// This field indicates that a @c Writer had at one point been enabled and then closed.
+        /**
+         * This field indicates that a @c Writer had at one point been enabled and then closed.  With multiple
+         * @c Writers, it is set when the last open one closes.
+         */
         AtomicBool hasWriterBeenClosed;
 
         /**
-         * This mutex is used to protect creation of the writer.  In particular, it is locked when attempting to add
-         * the writer so that there are no races between overlapping calls to @c createWriter().
+         * This mutex is used to protect creation of writers.  In particular, it is locked when attempting to add a
+         * writer so that there are no races between overlapping calls to @c createWriter().
          */
         Mutex writerEnableMutex;
 
-        /// This field contains the next location to write to.
+        /**
+         * This field contains the next location to write to.  With multiple @c Writers, it is the end of the data
+         * published to @c Readers, which is only advanced over writes which have been completely copied.
+         */
         AtomicIndex writeStartCursor;
 
         /**
          * This field contains the end of the region currently being written to (when no write is in progress,
-         * `(writEndCursor == writeStartCursor)`).
+         * `(writEndCursor == writeStartCursor)`).  With multiple @c Writers, it is the end of the space claimed by all
+         * of the writes in progress.
          */
         AtomicIndex writeEndCursor;
 
+        /**
+         * This mutex is only used when @c maxWriters is greater than one.  It serializes the @c Writers moving
+         * @c writeStartCursor over committed regions, and protects the condition of
+         * @c writePublishedConditionVariable.
+         */
+        Mutex writePublishMutex;
+
+        /**
+         * This field contains the condition variable used to notify @c Writers that @c writeStartCursor has moved.
+         * @c Writers wait on it for the regions claimed before theirs to be published, and for claimed space to
+         * become free.  It is only used when @c maxWriters is greater than one.
+         */
+        ConditionVariable writePublishedConditionVariable;
+
         /**
          * This field contains the location of oldest word in the buffer which has not been consumed (read by a
          * @c Reader).  This field is used as a barrier by @c Writers which have a policy not to overwrite readers.
@@ -205,18 +246,81 @@ public:
      */
     AtomicIndex* getReaderCloseIndexArray() const;
 
+    /**
+     * This function provides access to the array of indices which specify the @c Index each blocked @c Reader is
+     * waiting for the @c Writer to reach.  A @c Reader which is not waiting has its wake @c Index set to
+     * @c std::numeric_limits<Index>::max().
+     *
+     * This array of wake @c Index indices comes next in @c m_buffer after the @c getReaderCloseIndexArray() listed
+     * above.
+     *
+     * @return A pointer to the array of @c maxReaders wake @c Indexes.
+     */
+    AtomicIndex* getReaderWakeIndexArray() const;
+
+    /**
+     * This function provides access to the array of condition variables which each blocked @c Reader waits on.  These
+     * are used with @c Header::dataAvailableMutex.  Giving each @c Reader its own condition variable means that a
+     * write only wakes the @c Readers whose wake @c Index it reached.
+     *
+     * This array of condition variables comes next in @c m_buffer after the @c getReaderWakeIndexArray() listed above.
+     *
+     * @return A pointer to the array of @c maxReaders condition variables.
+     */
+    ConditionVariable* getReaderDataAvailableConditionVariableArray() const;
+
+    /**
+     * This function provides access to the array of booleans which specify whether a particular writer is enabled.
+     *
+     * This array of enabled booleans comes next in @c m_buffer after the
+     * @c getReaderDataAvailableConditionVariableArray() listed above.
+     *
+     * @return A pointer to the array of @c maxWriters enabled booleans.
+     */
+    AtomicBool* getWriterEnabledArray() const;
+
+    /**
+     * This function provides access to the array of indices which specify where the region each @c Writer most
+     * recently claimed starts.  It is only used when @c maxWriters is greater than one.
+     *
+     * This array of claim @c Indexes comes next in @c m_buffer after the @c getWriterEnabledArray() listed above.
+     *
+     * @return A pointer to the array of @c maxWriters claim @c Indexes.
+     */
+    AtomicIndex* getWriterClaimArray() const;
+
+    /**
+     * This function provides access to the array of commit markers, one per @c Writer.  A @c Writer sets its commit
+     * marker to the end of its claimed region once it has copied all of its data there, and clears it to zero once
+     * the region has been published by moving @c Header::writeStartCursor over it.  It is only used when
+     * @c maxWriters is greater than one.
+     *
+     * This array of commit @c Indexes comes next in @c m_buffer after the @c getWriterClaimArray() listed above.
+     *
+     * @return A pointer to the array of @c maxWriters commit @c Indexes.
+     */
+    AtomicIndex* getWriterCommitArray() const;
+
     /**
      * This function returns the size (in words) of the data (non-Header) portion of @c buffer.  The data comes next in
-     * @c m_buffer after the @c getReaderCloseIndexarray() listed above.
+     * @c m_buffer after the @c getWriterCommitArray() listed above.
      *
      * @return The maximum number of words the stream can store.
      */
     Index getDataSize() const;
 
+    /**
+     * This function returns the word size (in bytes) of the stream, cached so that it need not be loaded from the
+     * @c Header.
+     *
+     * @return The size (in bytes) of words in the stream.
+     */
+    size_t getWordSize() const;
+
     /**
      * This function provides access to the data (non-Header) portion of @c buffer.
      *
-     * The data comes next in @c m_buffer after the @c getReaderCloseIndexArray() array listed above.
+     * The data comes next in @c m_buffer after the @c getWriterCommitArray() array listed above.
      *
      * @param at An optional word @c Index to get a data pointer for.  This function will calculate where @c at would
      *     fall in the circular buffer and return a pointer to it, but note that this function does not check whether
@@ -236,9 +340,11 @@ public:
      * @param wordSize The size (in bytes) of words in the stream.  All @c SharedDataStream operations that work with
      *     data or position in the stream are quantified in words.
      * @param maxReaders The maximum number of readers the stream will support.
-     * @return @c false if wordSize or maxReaders are too large to be stored, else @c true.
+     * @param maxWriters The maximum number of writers the stream will support.
+     * @return @c false if wordSize, maxReaders or maxWriters are too large to be stored, or maxWriters is zero, else
+     *     @c true.
      */
-    bool init(size_t wordSize, size_t maxReaders);
+    bool init(size_t wordSize, size_t maxReaders, size_t maxWriters);
 
     /**
      * This function tries to attach this @c BufferLayout to a @c Buffer which was already initialized by another
@@ -284,6 +390,30 @@ public:
      */
     void disableReaderLocked(size_t id);
 
+    /**
+     * This function checks whether the specified writer is enabled.
+     *
+     * @param id The id of the writer to check the enabled status of.
+     * @return @c true if the specified writer is enabled, else @c false.
+     */
+    bool isWriterEnabled(size_t id) const;
+
+    /**
+     * This function enables the specified writer and clears its claim and commit marker.  The caller must be holding
+     * Header::writerEnableMutex when calling this function.
+     *
+     * @param id The id of the writer to enable.
+     */
+    void enableWriterLocked(size_t id);
+
+    /**
+     * This function disables the specified writer.  The caller must be holding Header::writerEnableMutex when calling
+     * this function.
+     *
+     * @param id The id of the writer to disable.
+     */
+    void disableWriterLocked(size_t id);
+
     /**
      * This function returns a count of the number of words after the specified @c Index before the circular data
      * will wrap.
@@ -299,9 +429,10 @@ public:
      * @param wordSize The size (in bytes) of words in the stream.  All @c SharedDataStream operations that work with
      *     data or position in the stream are quantified in words.
      * @param maxReaders The maximum number of readers the stream will support.
+     * @param maxWriters The maximum number of writers the stream will support.
      * @return The offset (in bytes) from the start of a @c Buffer to the start of the circular data.
      */
-    static size_t calculateDataOffset(size_t wordSize, size_t maxReaders);
+    static size_t calculateDataOffset(size_t wordSize, size_t maxReaders, size_t maxWriters);
 
     /// This function calls @c updateOldestUnconsumedCursorLocked() while holding @c Header::backwardSeekMutex.
     void updateOldestUnconsumedCursor();
@@ -330,6 +461,59 @@ public:
      */
     void updateOldestUnconsumedCursorLocked();
 
+    /**
+     * This function recalculates @c Header::readerWakeCursor from the @c Reader wake @c Indexes.  The caller must be
+     * holding @c Header::dataAvailableMutex.
+     */
+    void updateReaderWakeCursorLocked();
+
+    /**
+     * This function wakes the blocked @c Readers whose wake @c Index the @c Writer has reached, or all blocked
+     * @c Readers, and marks them as no longer waiting.  This function locks @c Header::dataAvailableMutex to find
+     * them, but notifies them after releasing it, so that they do not wake only to block on the mutex.
+     *
+     * @param all Whether to wake all blocked @c Readers, as when the @c Writer closes.
+     */
+    void wakeReaders(bool all);
+
+    /**
+     * This function registers a @c ReadinessNotifier to be signalled by @c signalReadinessNotifiers().
+     *
+     * @note Notifiers are local to this @c BufferLayout, so they are only signalled by @c Writers in the same process.
+     *
+     * @param notifier The notifier to add.
+     */
+    void addReadinessNotifier(std::shared_ptr<ReadinessNotifier> notifier);
+
+    /**
+     * This function deregisters a @c ReadinessNotifier added with @c addReadinessNotifier().
+     *
+     * @param notifier The notifier to remove.
+     */
+    void removeReadinessNotifier(std::shared_ptr<ReadinessNotifier> notifier);
+
+    /**
+     * This function signals every registered @c ReadinessNotifier.  It is called by the @c Writer after each write and
+     * when it closes, and costs a single atomic load when no notifiers are registered.
+     */
+    void signalReadinessNotifiers();
+
+    /**
+     * This function sets the @c TimestampTrack which the @c Writer records writes in.  This function can be safely
+     * called from multiple threads.
+     *
+     * @param track The track to record writes in, or @c nullptr to stop recording.
+     */
+    void setTimestampTrack(std::shared_ptr<TimestampTrack> track);
+
+    /**
+     * This function returns the @c TimestampTrack which the @c Writer records writes in.  This function can be safely
+     * called from multiple threads.
+     *
+     * @return The track, or @c nullptr if there is none.
+     */
+    std::shared_ptr<TimestampTrack> getTimestampTrack() const;
+
 private:
     /**
      * This function calculates a 32-bit stable hash of the provided string.  Note that this hash is just used for
@@ -375,14 +559,63 @@ private:
      */
     static size_t calculateReaderCloseIndexArrayOffset(size_t maxReaders);
 
+    /**
+     * This function calculates the offset (in bytes) from the start of a @c Buffer to the start of the @c Reader
+     * wake @c Index array.
+     *
+     * @param maxReaders The maximum number of readers the stream will support.
+     * @return The offset (in bytes) from the start of a @c Buffer to the start of the @c Reader wake @c Index array.
+     */
+    static size_t calculateReaderWakeIndexArrayOffset(size_t maxReaders);
+
+    /**
+     * This function calculates the offset (in bytes) from the start of a @c Buffer to the start of the @c Reader
+     * data available condition variable array.
+     *
+     * @param maxReaders The maximum number of readers the stream will support.
+     * @return The offset (in bytes) from the start of a @c Buffer to the start of the @c Reader data available
+     *     condition variable array.
+     */
+    static size_t calculateReaderDataAvailableConditionVariableArrayOffset(size_t maxReaders);
+
+    /**
+     * This function calculates the offset (in bytes) from the start of a @c Buffer to the start of the @c Writer
+     * enabled array.
+     *
+     * @param maxReaders The maximum number of readers the stream will support.
+     * @return The offset (in bytes) from the start of a @c Buffer to the start of the @c Writer enabled array.
+     */
+    static size_t calculateWriterEnabledArrayOffset(size_t maxReaders);
+
+    /**
+     * This function calculates the offset (in bytes) from the start of a @c Buffer to the start of the @c Writer
+     * claim array.
+     *
+     * @param maxReaders The maximum number of readers the stream will support.
+     * @param maxWriters The maximum number of writers the stream will support.
+     * @return The offset (in bytes) from the start of a @c Buffer to the start of the @c Writer claim array.
+     */
+    static size_t calculateWriterClaimArrayOffset(size_t maxReaders, size_t maxWriters);
+
+    /**
+     * This function calculates the offset (in bytes) from the start of a @c Buffer to the start of the @c Writer
+     * commit array.
+     *
+     * @param maxReaders The maximum number of readers the stream will support.
+     * @param maxWriters The maximum number of writers the stream will support.
+     * @return The offset (in bytes) from the start of a @c Buffer to the start of the @c Writer commit array.
+     */
+    static size_t calculateWriterCommitArrayOffset(size_t maxReaders, size_t maxWriters);
+
     /**
      * This function calculates several frequently-accessed constants and caches them in member variables.
      *
      * @param wordSize The size (in bytes) of words in the stream.  All @c SharedDataStream operations that work with
      *     data or position in the stream are quantified in words.
      * @param maxReaders The maximum number of readers the stream will support.
+     * @param maxWriters The maximum number of writers the stream will support.
      */
-    void calculateAndCacheConstants(size_t wordSize, size_t maxReaders);
+    void calculateAndCacheConstants(size_t wordSize, size_t maxReaders, size_t maxWriters);
 
     /**
      * The tag associated with log entries from this class.
@@ -408,11 +641,47 @@ private:
     /// Precalculated pointer to the @c Reader close @c Index array.
     AtomicIndex* m_readerCloseIndexArray;
 
+    /// Precalculated pointer to the @c Reader wake @c Index array.
+    AtomicIndex* m_readerWakeIndexArray;
+
+    /// Precalculated pointer to the @c Reader data available condition variable array.
+    ConditionVariable* m_readerDataAvailableConditionVariableArray;
+
+    /// Precalculated pointer to the @c Writer enabled array.
+    AtomicBool* m_writerEnabledArray;
+
+    /// Precalculated pointer to the @c Writer claim array.
+    AtomicIndex* m_writerClaimArray;
+
+    /// Precalculated pointer to the @c Writer commit array.
+    AtomicIndex* m_writerCommitArray;
+
     /// Precalculated size (in words) of the circular data.
     Index m_dataSize;
 
+    /// Precalculated size (in bytes) of words, so that it need not be loaded from the @c Header.
+    size_t m_wordSize;
+
     /// Precalculated pointer to the circular data.
     uint8_t* m_data;
+
+    /// Mutex serializing access to @c m_readinessNotifiers.
+    std::mutex m_readinessNotifiersMutex;
+
+    /// The notifiers to signal when data is written or the @c Writer closes.
+    std::vector<std::shared_ptr<ReadinessNotifier>> m_readinessNotifiers;
+
+    /// The size of @c m_readinessNotifiers, which lets writers skip the mutex when nobody is listening.
+    std::atomic<size_t> m_numReadinessNotifiers;
+
+    /// The track the @c Writer records writes in.  This is only accessed with @c std::atomic_load/store().
+    std::shared_ptr<TimestampTrack> m_timestampTrack;
+
+    /**
+     * Whether @c m_timestampTrack is set, which lets writers skip @c std::atomic_load() of the @c shared_ptr (which
+     * takes a lock) when there is no track.
+     */
+    std::atomic<bool> m_hasTimestampTrack;
 };
 
 template <typename T>
@@ -424,8 +693,16 @@ SharedDataStream<T>::BufferLayout::BufferLayout(std::shared_ptr<Buffer> buffer)
         m_readerEnabledArray{nullptr},
         m_readerCursorArray{nullptr},
         m_readerCloseIndexArray{nullptr},
+        m_readerWakeIndexArray{nullptr},
+        m_readerDataAvailableConditionVariableArray{nullptr},
+        m_writerEnabledArray{nullptr},
+        m_writerClaimArray{nullptr},
+        m_writerCommitArray{nullptr},
         m_dataSize{0},
-        m_data{nullptr} {
+        m_wordSize{0},
+        m_data{nullptr},
+        m_numReadinessNotifiers{0},
+        m_hasTimestampTrack{false} {
 }
 
 template <typename T>
@@ -453,18 +730,49 @@ typename SharedDataStream<T>::AtomicIndex* SharedDataStream<T>::BufferLayout::ge
     return m_readerCloseIndexArray;
 }
 
+template <typename T>
+typename SharedDataStream<T>::AtomicIndex* SharedDataStream<T>::BufferLayout::getReaderWakeIndexArray() const {
+    return m_readerWakeIndexArray;
+}
+
+template <typename T>
+typename SharedDataStream<T>::ConditionVariable* SharedDataStream<T>::BufferLayout::
+    getReaderDataAvailableConditionVariableArray() const {
+    return m_readerDataAvailableConditionVariableArray;
+}
+
+template <typename T>
+typename SharedDataStream<T>::AtomicBool* SharedDataStream<T>::BufferLayout::getWriterEnabledArray() const {
+    return m_writerEnabledArray;
+}
+
+template <typename T>
+typename SharedDataStream<T>::AtomicIndex* SharedDataStream<T>::BufferLayout::getWriterClaimArray() const {
+    return m_writerClaimArray;
+}
+
+template <typename T>
+typename SharedDataStream<T>::AtomicIndex* SharedDataStream<T>::BufferLayout::getWriterCommitArray() const {
+    return m_writerCommitArray;
+}
+
 template <typename T>
 typename SharedDataStream<T>::Index SharedDataStream<T>::BufferLayout::getDataSize() const {
     return m_dataSize;
 }
 
+template <typename T>
+size_t SharedDataStream<T>::BufferLayout::getWordSize() const {
+    return m_wordSize;
+}
+
 template <typename T>
 uint8_t* SharedDataStream<T>::BufferLayout::getData(Index at) const {
-    return m_data + (at % getDataSize()) * getHeader()->wordSize;
+    return m_data + (at % getDataSize()) * getWordSize();
 }
 
 template <typename T>
-bool SharedDataStream<T>::BufferLayout::init(size_t wordSize, size_t maxReaders) {
+bool SharedDataStream<T>::BufferLayout::init(size_t wordSize, size_t maxReaders, size_t maxWriters) {
     // Make sure parameters are not too large to store.
     if (wordSize > std::numeric_limits<decltype(Header::wordSize)>::max()) {
         logger::acsdkError(logger::LogEntry(TAG, "initFailed")
@@ -480,9 +788,20 @@ bool SharedDataStream<T>::BufferLayout::init(size_t wordSize, size_t maxReaders)
                                .d("maxReadersLimit", std::numeric_limits<decltype(Header::maxReaders)>::max()));
         return false;
     }
+    if (0 == maxWriters) {
+        logger::acsdkError(logger::LogEntry(TAG, "initFailed").d("reason", "maxWritersZero"));
+        return false;
+    }
+    if (maxWriters > std::numeric_limits<decltype(Header::maxWriters)>::max()) {
+        logger::acsdkError(logger::LogEntry(TAG, "initFailed")
+                               .d("reason", "maxWritersTooLarge")
+                               .d("maxWriters", maxWriters)
+                               .d("maxWritersLimit", std::numeric_limits<decltype(Header::maxWriters)>::max()));
+        return false;
+    }
 
     // Pre-calculate some pointers and sizes that are frequently accessed.
-    calculateAndCacheConstants(wordSize, maxReaders);
+    calculateAndCacheConstants(wordSize, maxReaders, maxWriters);
 
     // Default construction of the Header.
     auto header = new (getHeader()) Header;
@@ -493,6 +812,15 @@ bool SharedDataStream<T>::BufferLayout::init(size_t wordSize, size_t maxReaders)
         new (m_readerEnabledArray + id) AtomicBool;
         new (m_readerCursorArray + id) AtomicIndex;
         new (m_readerCloseIndexArray + id) AtomicIndex;
+        new (m_readerWakeIndexArray + id) AtomicIndex;
+        new (m_readerDataAvailableConditionVariableArray + id) ConditionVariable;
+    }
+
+    // Default construction of the writer arrays.
+    for (id = 0; id < maxWriters; ++id) {
+        new (m_writerEnabledArray + id) AtomicBool;
+        new (m_writerClaimArray + id) AtomicIndex;
+        new (m_writerCommitArray + id) AtomicIndex;
     }
 
     // Header field initialization.
@@ -501,11 +829,13 @@ bool SharedDataStream<T>::BufferLayout::init(size_t wordSize, size_t maxReaders)
     header->traitsNameHash = stableHash(T::traitsName);
     header->wordSize = wordSize;
     header->maxReaders = maxReaders;
+    header->maxWriters = maxWriters;
     header->isWriterEnabled = false;
     header->hasWriterBeenClosed = false;
     header->writeStartCursor = 0;
     header->writeEndCursor = 0;
     header->oldestUnconsumedCursor = 0;
+    header->readerWakeCursor = std::numeric_limits<Index>::max();
     header->referenceCount = 1;
 
     // Reader arrays initialization.
@@ -513,6 +843,14 @@ bool SharedDataStream<T>::BufferLayout::init(size_t wordSize, size_t maxReaders)
         m_readerEnabledArray[id] = false;
         m_readerCursorArray[id] = 0;
         m_readerCloseIndexArray[id] = 0;
+        m_readerWakeIndexArray[id] = std::numeric_limits<Index>::max();
+    }
+
+    // Writer arrays initialization.
+    for (id = 0; id < maxWriters; ++id) {
+        m_writerEnabledArray[id] = false;
+        m_writerClaimArray[id] = 0;
+        m_writerCommitArray[id] = 0;
     }
 
     return true;
@@ -560,7 +898,7 @@ bool SharedDataStream<T>::BufferLayout::attach() {
     ++header->referenceCount;
 
     // Pre-calculate some pointers and sizes that are frequently accessed.
-    calculateAndCacheConstants(header->wordSize, header->maxReaders);
+    calculateAndCacheConstants(header->wordSize, header->maxReaders, header->maxWriters);
 
     return true;
 }
@@ -578,8 +916,17 @@ void SharedDataStream<T>::BufferLayout::detach() {
         return;
     }
 
+    // Destruction of writer arrays.
+    for (size_t id = 0; id < header->maxWriters; ++id) {
+        m_writerCommitArray[id].~AtomicIndex();
+        m_writerClaimArray[id].~AtomicIndex();
+        m_writerEnabledArray[id].~AtomicBool();
+    }
+
     // Destruction of reader arrays.
     for (size_t id = 0; id < header->maxReaders; ++id) {
+        m_readerDataAvailableConditionVariableArray[id].~ConditionVariable();
+        m_readerWakeIndexArray[id].~AtomicIndex();
         m_readerCloseIndexArray[id].~AtomicIndex();
         m_readerCursorArray[id].~AtomicIndex();
         m_readerEnabledArray[id].~AtomicBool();
@@ -604,14 +951,32 @@ void SharedDataStream<T>::BufferLayout::disableReaderLocked(size_t id) {
     m_readerEnabledArray[id] = false;
 }
 
+template <typename T>
+bool SharedDataStream<T>::BufferLayout::isWriterEnabled(size_t id) const {
+    return m_writerEnabledArray[id];
+}
+
+template <typename T>
+void SharedDataStream<T>::BufferLayout::enableWriterLocked(size_t id) {
+    m_writerClaimArray[id] = 0;
+    m_writerCommitArray[id] = 0;
+    m_writerEnabledArray[id] = true;
+}
+
+template <typename T>
+void SharedDataStream<T>::BufferLayout::disableWriterLocked(size_t id) {
+    m_writerEnabledArray[id] = false;
+}
+
 template <typename T>
 typename SharedDataStream<T>::Index SharedDataStream<T>::BufferLayout::wordsUntilWrap(Index after) const {
     return alignSizeTo(after, getDataSize()) - after;
 }
 
 template <typename T>
-size_t SharedDataStream<T>::BufferLayout::calculateDataOffset(size_t wordSize, size_t maxReaders) {
-    return alignSizeTo(calculateReaderCloseIndexArrayOffset(maxReaders) + (maxReaders * sizeof(AtomicIndex)), wordSize);
+size_t SharedDataStream<T>::BufferLayout::calculateDataOffset(size_t wordSize, size_t maxReaders, size_t maxWriters) {
+    return alignSizeTo(
+        calculateWriterCommitArrayOffset(maxReaders, maxWriters) + (maxWriters * sizeof(AtomicIndex)), wordSize);
 }
 
 template <typename T>
@@ -669,6 +1034,80 @@ void SharedDataStream<T>::BufferLayout::updateOldestUnconsumedCursorLocked() {
     }
 }
 
+template <typename T>
+void SharedDataStream<T>::BufferLayout::updateReaderWakeCursorLocked() {
+    auto header = getHeader();
+    Index lowest = std::numeric_limits<Index>::max();
+    for (size_t id = 0; id < header->maxReaders; ++id) {
+        lowest = std::min(lowest, m_readerWakeIndexArray[id].load());
+    }
+    header->readerWakeCursor = lowest;
+}
+
+template <typename T>
+void SharedDataStream<T>::BufferLayout::wakeReaders(bool all) {
+    auto header = getHeader();
+    std::bitset<std::numeric_limits<decltype(Header::maxReaders)>::max() + 1> readersToWake;
+    {
+        // Holding the mutex guarantees that a Reader which published its wake index is now waiting.
+        std::lock_guard<Mutex> lock(header->dataAvailableMutex);
+        Index writeStartCursor = header->writeStartCursor;
+        for (size_t id = 0; id < header->maxReaders; ++id) {
+            auto wakeIndex = m_readerWakeIndexArray[id].load();
+            if (wakeIndex != std::numeric_limits<Index>::max() && (all || wakeIndex <= writeStartCursor)) {
+                m_readerWakeIndexArray[id] = std::numeric_limits<Index>::max();
+                readersToWake.set(id);
+            }
+        }
+        updateReaderWakeCursorLocked();
+    }
+    for (size_t id = 0; id < header->maxReaders; ++id) {
+        if (readersToWake.test(id)) {
+            m_readerDataAvailableConditionVariableArray[id].notify_all();
+        }
+    }
+}
+
+template <typename T>
+void SharedDataStream<T>::BufferLayout::setTimestampTrack(std::shared_ptr<TimestampTrack> track) {
+    m_hasTimestampTrack = static_cast<bool>(track);
+    std::atomic_store(&m_timestampTrack, track);
+}
+
+template <typename T>
+std::shared_ptr<TimestampTrack> SharedDataStream<T>::BufferLayout::getTimestampTrack() const {
+    if (!m_hasTimestampTrack) {
+        return nullptr;
+    }
+    return std::atomic_load(&m_timestampTrack);
+}
+
+template <typename T>
+void SharedDataStream<T>::BufferLayout::addReadinessNotifier(std::shared_ptr<ReadinessNotifier> notifier) {
+    std::lock_guard<std::mutex> lock(m_readinessNotifiersMutex);
+    m_readinessNotifiers.push_back(notifier);
+    m_numReadinessNotifiers = m_readinessNotifiers.size();
+}
+
+template <typename T>
+void SharedDataStream<T>::BufferLayout::removeReadinessNotifier(std::shared_ptr<ReadinessNotifier> notifier) {
+    std::lock_guard<std::mutex> lock(m_readinessNotifiersMutex);
+    m_readinessNotifiers.erase(
+        std::remove(m_readinessNotifiers.begin(), m_readinessNotifiers.end(), notifier), m_readinessNotifiers.end());
+    m_numReadinessNotifiers = m_readinessNotifiers.size();
+}
+
+template <typename T>
+void SharedDataStream<T>::BufferLayout::signalReadinessNotifiers() {
+    if (0 == m_numReadinessNotifiers) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_readinessNotifiersMutex);
+    for (auto& notifier : m_readinessNotifiers) {
+        notifier->signal();
+    }
+}
+
 template <typename T>
 uint32_t SharedDataStream<T>::BufferLayout::stableHash(const char* string) {
     // Simple, stable hash which XORs all bytes of string into the hash value.
@@ -707,13 +1146,56 @@ size_t SharedDataStream<T>::BufferLayout::calculateReaderCloseIndexArrayOffset(s
 }
 
 template <typename T>
-void SharedDataStream<T>::BufferLayout::calculateAndCacheConstants(size_t wordSize, size_t maxReaders) {
+size_t SharedDataStream<T>::BufferLayout::calculateReaderWakeIndexArrayOffset(size_t maxReaders) {
+    return calculateReaderCloseIndexArrayOffset(maxReaders) + (maxReaders * sizeof(AtomicIndex));
+}
+
+template <typename T>
+size_t SharedDataStream<T>::BufferLayout::calculateReaderDataAvailableConditionVariableArrayOffset(
+    size_t maxReaders) {
+    return alignSizeTo(
+        calculateReaderWakeIndexArrayOffset(maxReaders) + (maxReaders * sizeof(AtomicIndex)),
+        alignof(ConditionVariable));
+}
+
+template <typename T>
+size_t SharedDataStream<T>::BufferLayout::calculateWriterEnabledArrayOffset(size_t maxReaders) {
+    return alignSizeTo(
+        calculateReaderDataAvailableConditionVariableArrayOffset(maxReaders) + (maxReaders * sizeof(ConditionVariable)),
+        alignof(AtomicBool));
+}
+
+template <typename T>
+size_t SharedDataStream<T>::BufferLayout::calculateWriterClaimArrayOffset(size_t maxReaders, size_t maxWriters) {
+    return alignSizeTo(
+        calculateWriterEnabledArrayOffset(maxReaders) + (maxWriters * sizeof(AtomicBool)), alignof(AtomicIndex));
+}
+
+template <typename T>
+size_t SharedDataStream<T>::BufferLayout::calculateWriterCommitArrayOffset(size_t maxReaders, size_t maxWriters) {
+    return calculateWriterClaimArrayOffset(maxReaders, maxWriters) + (maxWriters * sizeof(AtomicIndex));
+}
+
+template <typename T>
+void SharedDataStream<T>::BufferLayout::calculateAndCacheConstants(
+    size_t wordSize,
+    size_t maxReaders,
+    size_t maxWriters) {
     auto buffer = reinterpret_cast<uint8_t*>(m_buffer->data());
     m_readerEnabledArray = reinterpret_cast<AtomicBool*>(buffer + calculateReaderEnabledArrayOffset());
     m_readerCursorArray = reinterpret_cast<AtomicIndex*>(buffer + calculateReaderCursorArrayOffset(maxReaders));
     m_readerCloseIndexArray = reinterpret_cast<AtomicIndex*>(buffer + calculateReaderCloseIndexArrayOffset(maxReaders));
-    m_dataSize = (m_buffer->size() - calculateDataOffset(wordSize, maxReaders)) / wordSize;
-    m_data = buffer + calculateDataOffset(wordSize, maxReaders);
+    m_readerWakeIndexArray = reinterpret_cast<AtomicIndex*>(buffer + calculateReaderWakeIndexArrayOffset(maxReaders));
+    m_readerDataAvailableConditionVariableArray = reinterpret_cast<ConditionVariable*>(
+        buffer + calculateReaderDataAvailableConditionVariableArrayOffset(maxReaders));
+    m_writerEnabledArray = reinterpret_cast<AtomicBool*>(buffer + calculateWriterEnabledArrayOffset(maxReaders));
+    m_writerClaimArray =
+        reinterpret_cast<AtomicIndex*>(buffer + calculateWriterClaimArrayOffset(maxReaders, maxWriters));
+    m_writerCommitArray =
+        reinterpret_cast<AtomicIndex*>(buffer + calculateWriterCommitArrayOffset(maxReaders, maxWriters));
+    m_dataSize = (m_buffer->size() - calculateDataOffset(wordSize, maxReaders, maxWriters)) / wordSize;
+    m_data = buffer + calculateDataOffset(wordSize, maxReaders, maxWriters);
+    m_wordSize = wordSize;
 }
 
 template <typename T>
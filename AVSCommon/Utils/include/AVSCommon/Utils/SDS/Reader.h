@@ -18,14 +18,17 @@
 #ifndef ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_SDS_READER_H_
 #define ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_SDS_READER_H_
 
+#include <algorithm>
 #include <cstdint>
 #include <cstddef>
 #include <vector>
+#include <memory>
 #include <mutex>
 #include <limits>
 #include <cstring>
 
 #include "AVSCommon/Utils/Logger/LoggerUtils.h"
+#include "ReadinessNotifier.h"
 #include "SharedDataStream.h"
 
 namespace alexaClientSDK {
@@ -56,7 +59,8 @@ public:
          * A @c BLOCKING @c Reader will wait for up to the specified timeout (or forever if `(timeout == 0)`) for data
          * to become available.  As soon as at least one word is available, the @c Reader will return up to the
          * requested amount of data.  If no data becomes available in the specified timeout, a @c BLOCKING @c Reader
-         * will return @c Error::TIMEDOUT.
+         * will return @c Error::TIMEDOUT.  A @c BLOCKING @c Reader can be made to wait for more than one word with
+         * @c setWakeThreshold().
          */
         BLOCKING
     };
@@ -165,10 +169,9 @@ public:
      * @param offset The position (in @c wordSize words) in the stream, relative to @c reference, to close at.
      * @param reference The position in the stream the close point is measured against.
      *
-     * @note This function can be called from any thread or process, and it will schedule the @c Reader to close,
-     *     however it will *not* wake up a @c BLOCKING @c Reader which is already blocked waiting for data.  In the
-     *     case of a blocked @c read(), that @c read() will return when it wakes up - either due to a timeout, or due
-     *     to a @c Writer adding data to the stream.
+     * @note This function can be called from any thread or process.  It wakes up a @c BLOCKING @c Reader which is
+     *     already blocked waiting for data, so that a thread blocked in @c read() can be stopped promptly by closing
+     *     its @c Reader.  If the new close point has been reached, that @c read() returns @c Error::CLOSED.
      */
     void close(Index offset = 0, Reference reference = Reference::AFTER_READER);
 
@@ -196,6 +199,33 @@ public:
      */
     static std::string errorToString(Error error);
 
+    /**
+     * This function returns a notifier which is signalled whenever this @c Reader may have become readable, which is
+     * when a @c Writer writes data or closes.  The notifier is created on the first call and starts out signalled, so
+     * that data already in the stream is not missed.  Readers which never call this function cost nothing extra.
+     *
+     * To wait for data, @c clear() the notifier, then @c read() until @c Error::WOULDBLOCK is returned, then wait
+     * for the notifier's descriptor to become readable.
+     *
+     * @note The notifier is only signalled by @c Writers in the same process as this @c Reader.
+     *
+     * @return The notifier for this @c Reader, or @c nullptr if it could not be created.
+     */
+    std::shared_ptr<ReadinessNotifier> getReadinessNotifier();
+
+    /**
+     * This function sets the number of words a @c BLOCKING @c read() waits to have available before it returns.
+     * Without a threshold, a blocked @c Reader is woken by every write, however small; a @c Reader which consumes
+     * whole frames can set the threshold to its frame size so that it is only woken once per frame.
+     *
+     * A @c read() still returns early if the @c Writer closes, and returns what is available if it times out after
+     * some data arrived.  The threshold is capped at the number of words requested, the size of the stream, and the
+     * number of words left before the @c Reader's close index.  @c NONBLOCKING @c Readers ignore the threshold.
+     *
+     * @param nWords The minimum number of words to wait for.  The default is 1, and 0 is treated as 1.
+     */
+    void setWakeThreshold(size_t nWords);
+
 private:
     /**
      * The tag associated with log entries from this class.
@@ -219,6 +249,15 @@ private:
 
     /// Pointer to this reader's close index in BufferLayout::getReaderCloseIndexArray().
     AtomicIndex* m_readerCloseIndex;
+
+    /// Pointer to this reader's wake index in BufferLayout::getReaderWakeIndexArray().
+    AtomicIndex* m_readerWakeIndex;
+
+    /// The minimum number of words a @c BLOCKING @c read() waits for.
+    size_t m_wakeThreshold;
+
+    /// The notifier returned by @c getReadinessNotifier(), or @c nullptr if it has not been requested.
+    std::shared_ptr<ReadinessNotifier> m_readinessNotifier;
 };
 
 template <typename T>
@@ -230,7 +269,9 @@ SharedDataStream<T>::Reader::Reader(Policy policy, std::shared_ptr<BufferLayout>
         m_bufferLayout{bufferLayout},
         m_id{id},
         m_readerCursor{&m_bufferLayout->getReaderCursorArray()[m_id]},
-        m_readerCloseIndex{&m_bufferLayout->getReaderCloseIndexArray()[m_id]} {
+        m_readerCloseIndex{&m_bufferLayout->getReaderCloseIndexArray()[m_id]},
+        m_readerWakeIndex{&m_bufferLayout->getReaderWakeIndexArray()[m_id]},
+        m_wakeThreshold{1} {
     // Note - SharedDataStream::createReader() holds readerEnableMutex while calling this function.
     // Read new data only.
     // Note: It is important that new readers start with their cursor at the writer.  This allows
@@ -241,6 +282,9 @@ SharedDataStream<T>::Reader::Reader(Policy policy, std::shared_ptr<BufferLayout>
     // Read indefinitely.
     *m_readerCloseIndex = std::numeric_limits<Index>::max();
 
+    // Not waiting.
+    *m_readerWakeIndex = std::numeric_limits<Index>::max();
+
     m_bufferLayout->enableReaderLocked(m_id);
 }
 
@@ -250,6 +294,10 @@ SharedDataStream<T>::Reader::~Reader() {
     // updateOldestUnconsumedCursor().  See updateOldestUnconsumedCursor() comments for further explanation.
     seek(0, Reference::BEFORE_WRITER);
 
+    if (m_readinessNotifier) {
+        m_bufferLayout->removeReadinessNotifier(m_readinessNotifier);
+    }
+
     std::lock_guard<Mutex> lock(m_bufferLayout->getHeader()->readerEnableMutex);
     m_bufferLayout->disableReaderLocked(m_id);
     m_bufferLayout->updateOldestUnconsumedCursor();
@@ -292,19 +340,56 @@ ssize_t SharedDataStream<T>::Reader::read(void* buf, size_t nWords, std::chrono:
             return Error::CLOSED;
         } else if (Policy::NONBLOCKING == m_policy) {
             return Error::WOULDBLOCK;
-        } else if (Policy::BLOCKING == m_policy) {
-            // Condition for returning from read: the Writer has been closed or there is data to read
-            auto predicate = [this, header] {
-                return header->hasWriterBeenClosed || tell(Reference::BEFORE_WRITER) > 0;
+        }
+    }
+
+    if (Policy::BLOCKING == m_policy) {
+        // Wait for the threshold, but not for more than was asked for, more than the stream holds, or beyond the
+        // close index.
+        size_t wordsToWake = std::min({m_wakeThreshold,
+                                       nWords,
+                                       static_cast<size_t>(m_bufferLayout->getDataSize()),
+                                       static_cast<size_t>(readerCloseIndex - *m_readerCursor)});
+        if (wordsAvailable < wordsToWake) {
+            // Condition for returning from read: the Writer has been closed or there is enough data to read, up to
+            // a close index which close() may have moved in the meantime.
+            auto predicate = [this, header, wordsToWake] {
+                Index closeIndex = *m_readerCloseIndex;
+                Index wordsBeforeClose = closeIndex > *m_readerCursor ? closeIndex - *m_readerCursor : 0;
+                return header->hasWriterBeenClosed ||
+                       tell(Reference::BEFORE_WRITER) >= std::min<Index>(wordsToWake, wordsBeforeClose);
             };
 
+            // Publish where we want to be woken before the predicate checks writeStartCursor; see Writer::write().
+            *m_readerWakeIndex = *m_readerCursor + wordsToWake;
+            if (*m_readerWakeIndex < header->readerWakeCursor) {
+                header->readerWakeCursor = m_readerWakeIndex->load();
+            }
+
+            auto& dataAvailableConditionVariable = m_bufferLayout->getReaderDataAvailableConditionVariableArray()[m_id];
+            bool woken = true;
             if (std::chrono::milliseconds::zero() == timeout) {
-                header->dataAvailableConditionVariable.wait(lock, predicate);
-            } else if (!header->dataAvailableConditionVariable.wait_for(lock, timeout, predicate)) {
+                dataAvailableConditionVariable.wait(lock, predicate);
+            } else {
+                woken = dataAvailableConditionVariable.wait_for(lock, timeout, predicate);
+            }
+
+            // The writer stops waiting for us when it wakes us, but not if we timed out or never had to wait.
+            if (*m_readerWakeIndex != std::numeric_limits<Index>::max()) {
+                *m_readerWakeIndex = std::numeric_limits<Index>::max();
+                m_bufferLayout->updateReaderWakeCursorLocked();
+            }
+
+            readerCloseIndex = m_readerCloseIndex->load();
+            if (*m_readerCursor >= readerCloseIndex) {
+                return Error::CLOSED;
+            }
+
+            wordsAvailable = tell(Reference::BEFORE_WRITER);
+            if (!woken && 0 == wordsAvailable) {
                 return Error::TIMEDOUT;
             }
         }
-        wordsAvailable = tell(Reference::BEFORE_WRITER);
 
         // If there is still no data, the writer has closed in the interim
         if (0 == wordsAvailable) {
@@ -486,6 +571,12 @@ void SharedDataStream<T>::Reader::close(Index offset, Reference reference) {
     }
 
     *m_readerCloseIndex = absolute;
+
+    // Wake a blocked read() so that it sees the new close index.
+    if (Policy::BLOCKING == m_policy) {
+        std::lock_guard<Mutex> lock(m_bufferLayout->getHeader()->dataAvailableMutex);
+        m_bufferLayout->getReaderDataAvailableConditionVariableArray()[m_id].notify_all();
+    }
 }
 
 template <typename T>
@@ -495,7 +586,26 @@ size_t SharedDataStream<T>::Reader::getId() const {
 
 template <typename T>
 size_t SharedDataStream<T>::Reader::getWordSize() const {
-    return m_bufferLayout->getHeader()->wordSize;
+    return m_bufferLayout->getWordSize();
+}
+
+template <typename T>
+void SharedDataStream<T>::Reader::setWakeThreshold(size_t nWords) {
+    m_wakeThreshold = std::max<size_t>(nWords, 1);
+}
+
+template <typename T>
+std::shared_ptr<ReadinessNotifier> SharedDataStream<T>::Reader::getReadinessNotifier() {
+    if (!m_readinessNotifier) {
+        m_readinessNotifier = ReadinessNotifier::create();
+        if (!m_readinessNotifier) {
+            logger::acsdkError(logger::LogEntry(TAG, "getReadinessNotifierFailed").d("reason", "createFailed"));
+            return nullptr;
+        }
+        m_bufferLayout->addReadinessNotifier(m_readinessNotifier);
+        m_readinessNotifier->signal();
+    }
+    return m_readinessNotifier;
 }
 
 template <typename T>
@@ -0,0 +1,99 @@
+/*
+ * ReadinessNotifier.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_SDS_READINESSNOTIFIER_H_
+#define ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_SDS_READINESSNOTIFIER_H_
+
+#include <chrono>
+#include <memory>
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace sds {
+
+/**
+ * A file descriptor which becomes readable when a stream may have become readable, so that consumers running an event
+ * loop (such as a GLib main loop) can wait for data alongside their other sources instead of polling with timed reads.
+ *
+ * The descriptor is an eventfd on Linux and a non-blocking pipe elsewhere.  Signals coalesce: any number of
+ * @c signal() calls leave the descriptor readable until the next @c clear().  A consumer should @c clear() the
+ * notifier @b before reading, and read until the stream would block, so that data arriving after the last read always
+ * leaves the descriptor readable.
+ */
+class ReadinessNotifier {
+public:
+    /**
+     * Create a @c ReadinessNotifier.
+     *
+     * @return The new @c ReadinessNotifier, or @c nullptr if its descriptor could not be created.
+     */
+    static std::shared_ptr<ReadinessNotifier> create();
+
+    /**
+     * Destructor.  Closes the descriptor.
+     */
+    ~ReadinessNotifier();
+
+    /**
+     * Get the descriptor to poll for readability.  It remains owned by this object.
+     *
+     * @return The descriptor to poll for readability.
+     */
+    int getFd() const;
+
+    /**
+     * Make the descriptor readable.  This function may be called from any thread.
+     */
+    void signal();
+
+    /**
+     * Make the descriptor unreadable until the next @c signal().
+     */
+    void clear();
+
+    /**
+     * Wait until the descriptor is readable.  This is meant for consumers which are not running an event loop, and
+     * for tests.  It does not @c clear() the notifier.
+     *
+     * @param timeout The maximum time to wait.
+     * @return Whether the descriptor became readable before the timeout.
+     */
+    bool waitUntilSignalled(std::chrono::milliseconds timeout);
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param readFd The descriptor to poll and drain.
+     * @param writeFd The descriptor to write signals to.  This is the same as @c readFd for an eventfd.
+     */
+    ReadinessNotifier(int readFd, int writeFd);
+
+    /// The descriptor to poll and drain.
+    const int m_readFd;
+
+    /// The descriptor to write signals to.
+    const int m_writeFd;
+};
+
+}  // namespace sds
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_SDS_READINESSNOTIFIER_H_
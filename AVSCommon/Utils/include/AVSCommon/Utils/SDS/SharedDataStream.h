@@ -23,6 +23,7 @@
 #include <memory>
 
 #include "AVSCommon/Utils/Logger/LoggerUtils.h"
+#include "TimestampTrack.h"
 
 namespace alexaClientSDK {
 namespace avsCommon {
@@ -36,16 +37,27 @@ namespace sds {
  * appropriate types for the template parameters which will work reliably for the execution environment where the
  * @c SharedDataStream will be used.
  *
+ * A stream created with @c maxWriters greater than one accepts several concurrent producers instead, for instance
+ * to merge audio from several sources into one stream.  Each write claims a contiguous region of the stream by
+ * advancing @c writeEndCursor atomically, copies its data there, and then sets its commit marker.  Committed regions
+ * are published to @c Readers in index order, so @c Readers see the same stream semantics as with a single producer,
+ * and never see a partially written word.  Each write is contiguous in the stream, but writes from different
+ * @c Writers are interleaved in the order they claimed their regions.
+ *
  * @tparam T::AtomicIndex An atomic version of @c Index (see below) which implements the following methods:
  *     @li @c DefaultConstructible `(std::is_default_constructible<AtomicIndex> == true)`.
  *     @li Basic arithmetic, conversion and assignment operations with @c Index.
  *     @li @c load() performs an atomic read of the @c Index.
+ *     @li @c fetch_add(value) atomically adds @c value and returns the previous @c Index.
+ *     @li @c compare_exchange_strong(expected, desired) atomically replaces the @c Index with @c desired if it equals
+ *         @c expected, and otherwise loads it into @c expected, returning whether it was replaced.
  *     @li If the stream will be shared between processes, the @c AtomicIndex type *must* be a PODType:
  *         `(std::is_pod<AtomicIndex> == true)`.
  *
  *     This should be an equivalent type to @c Index, but which ensures atomic reads and writes between readers and
- *     writers in the execution environment where the @c SharedDataStream will be used.  No methods are called on this
- *     type; it must simply be readable and writable with values of type @c Index or @c AtomicIndex.
+ *     writers in the execution environment where the @c SharedDataStream will be used.  Apart from those listed above,
+ *     no methods are called on this type; it must simply be readable and writable with values of type @c Index or
+ *     @c AtomicIndex.
  *
  * @tparam T::AtomicBool An atomic boolean type which implements the following methods:
  *     @li @c DefaultConstructible `(std::is_default_constructible<AtomicIndex> == true)`.
@@ -136,10 +148,11 @@ public:
      *     data or position in the stream are quantified in words.  The stream's data storage capacity in bytes is
      *     `nWords * wordSize`.  This parameter defaults to 1.
      * @param maxReaders The maximum number of readers the stream will support.  This parameter defaults to 1.
+     * @param maxWriters The maximum number of writers which may be open at once.  This parameter defaults to 1.
      * @return The buffer size (in bytes) required to support the specified parameters, or zero if parameters are
      *     invalid.
      */
-    static size_t calculateBufferSize(size_t nWords, size_t wordSize = 1, size_t maxReaders = 1);
+    static size_t calculateBufferSize(size_t nWords, size_t wordSize = 1, size_t maxReaders = 1, size_t maxWriters = 1);
 
     /**
      * This function creates a new @c SharedDataStream.  It will first verify that the @c Buffer is large enough to
@@ -153,12 +166,15 @@ public:
      * @param wordSize The size (in bytes) of words in the stream.  All @c SharedDataStream operations that work with
      *     data or position in the stream are quantified in words.  This parameter defaults to 1.
      * @param maxReaders The maximum number of readers the stream will support.  This parameter defaults to 1.
+     * @param maxWriters The maximum number of writers which may be open at once.  A stream with one writer uses the
+     *     simpler single producer write path.  This parameter defaults to 1.
      * @return The new stream if @c buffer was successfully initialized, else @c nullptr.
      */
     static std::unique_ptr<SharedDataStream> create(
         std::shared_ptr<Buffer> buffer,
         size_t wordSize = 1,
-        size_t maxReaders = 1);
+        size_t maxReaders = 1,
+        size_t maxWriters = 1);
 
     /**
      * This function creates a new @c SharedDataStream using a preinitialized @c Buffer.  This allows a stream to
@@ -180,6 +196,14 @@ public:
      */
     size_t getMaxReaders() const;
 
+    /**
+     * This function reports the maximum number of writers which may be open at once on this @c SharedDataStream.
+     * This function can be safely called from multiple threads or processes.
+     *
+     * @return The maximum number of @c Writers supported.
+     */
+    size_t getMaxWriters() const;
+
     /**
      * This function returns the number of data words the stream is able to hold.  This function can be safely called
      * from multiple threads or processes.
@@ -197,19 +221,23 @@ public:
     size_t getWordSize() const;
 
     /**
-     * This function creates a @c Writer to the stream.  Only one @c Writer is allowed at a time.  This function must
-     * not be called from multiple threads or processes.
+     * This function creates a @c Writer to the stream.  Up to @c getMaxWriters() @c Writers are allowed at a time.
+     * This function can be safely called from multiple threads or processes.
      *
-     * @param policy The policy to use for writing to the stream.
+     * @param policy The policy to use for writing to the stream.  @c Writers with different policies may share a
+     *     stream.
      * @param forceReplacement If set to @c true, this parameter forcefully deallocates the @c Writer before allocating
      *     a new one. This parameter can be used when a Writer is known to be unused (possibly due to a process crash),
-     *     but was not cleanly destroyed.  This parameter is set to @c false by default.
-     * @return @c nullptr if a @c Writer is already allocated, else the new @c Writer.
+     *     but was not cleanly destroyed.  If all @c Writers are allocated, the first one is replaced.  This parameter
+     *     is set to @c false by default.
+     * @return @c nullptr if all @c Writers are already allocated, else the new @c Writer.
      *
      * @warning Calling this function with `forceReplacement = true` will allow the call to @c createWriter() to
      *     succeed, but will not prevent an previously existing @c Writer from writing to the stream.  The
      *     `forceReplacement = true` option should only be used when higher level software can guarantee that the
-     *     previous @c Writer will no longer be used to attempt to write to the stream.
+     *     previous @c Writer will no longer be used to attempt to write to the stream.  With multiple @c Writers, a
+     *     @c Writer which died in the middle of a write leaves a region which is never committed, and stops later
+     *     writes from being published, so the stream must then be recreated instead.
      */
     std::unique_ptr<Writer> createWriter(typename Writer::Policy policy, bool forceReplacement = false);
 
@@ -256,6 +284,26 @@ public:
         bool startWithNewData = false,
         bool forceReplacement = false);
 
+    /**
+     * This function attaches a @c TimestampTrack to the stream, which the @c Writer then records the end index and
+     * time of each write in.  Readers can use it to look up the capture time of any recent index, for instance to
+     * measure the latency from capturing the start of an utterance to sending it.
+     *
+     * @note The track is local to this @c SharedDataStream instance, so it is only recorded by @c Writers created from
+     *     it, and only visible to code which shares it.
+     *
+     * @param track The track to record writes in, or @c nullptr to stop recording.
+     */
+    void setTimestampTrack(std::shared_ptr<TimestampTrack> track);
+
+    /**
+     * This function returns the @c TimestampTrack attached to the stream.  This function can be safely called from
+     * multiple threads.
+     *
+     * @return The track attached with @c setTimestampTrack(), or @c nullptr if there is none.
+     */
+    std::shared_ptr<TimestampTrack> getTimestampTrack() const;
+
 private:
     /**
      * Constructs a new @c SharedDataStream using the provided @c Buffer.  The constructor does not attempt to
@@ -309,7 +357,7 @@ template <typename T>
 const std::string SharedDataStream<T>::TAG = "SharedDataStream";
 
 template <typename T>
-size_t SharedDataStream<T>::calculateBufferSize(size_t nWords, size_t wordSize, size_t maxReaders) {
+size_t SharedDataStream<T>::calculateBufferSize(size_t nWords, size_t wordSize, size_t maxReaders, size_t maxWriters) {
     if (0 == nWords) {
         logger::acsdkError(logger::LogEntry(TAG, "calculateBufferSizeFailed").d("reason", "numWordsZero"));
         return 0;
@@ -317,7 +365,7 @@ size_t SharedDataStream<T>::calculateBufferSize(size_t nWords, size_t wordSize,
         logger::acsdkError(logger::LogEntry(TAG, "calculateBufferSizeFailed").d("reason", "wordSizeZero"));
         return 0;
     }
-    size_t overhead = BufferLayout::calculateDataOffset(wordSize, maxReaders);
+    size_t overhead = BufferLayout::calculateDataOffset(wordSize, maxReaders, maxWriters);
     size_t dataSize = nWords * wordSize;
     return overhead + dataSize;
 }
@@ -326,8 +374,9 @@ template <typename T>
 std::unique_ptr<SharedDataStream<T>> SharedDataStream<T>::create(
     std::shared_ptr<Buffer> buffer,
     size_t wordSize,
-    size_t maxReaders) {
-    size_t expectedSize = calculateBufferSize(1, wordSize, maxReaders);
+    size_t maxReaders,
+    size_t maxWriters) {
+    size_t expectedSize = calculateBufferSize(1, wordSize, maxReaders, maxWriters);
     if (0 == expectedSize) {
         // Logged in calcutlateBuffersize().
         return nullptr;
@@ -343,7 +392,7 @@ std::unique_ptr<SharedDataStream<T>> SharedDataStream<T>::create(
     }
 
     std::unique_ptr<SharedDataStream<T>> sds(new SharedDataStream<T>(buffer));
-    if (!sds->m_bufferLayout->init(wordSize, maxReaders)) {
+    if (!sds->m_bufferLayout->init(wordSize, maxReaders, maxWriters)) {
         // Logged in init().
         return nullptr;
     }
@@ -366,6 +415,11 @@ size_t SharedDataStream<T>::getMaxReaders() const {
     return m_bufferLayout->getHeader()->maxReaders;
 }
 
+template <typename T>
+size_t SharedDataStream<T>::getMaxWriters() const {
+    return m_bufferLayout->getHeader()->maxWriters;
+}
+
 template <typename T>
 typename SharedDataStream<T>::Index SharedDataStream<T>::getDataSize() const {
     return m_bufferLayout->getDataSize();
@@ -373,7 +427,17 @@ typename SharedDataStream<T>::Index SharedDataStream<T>::getDataSize() const {
 
 template <typename T>
 size_t SharedDataStream<T>::getWordSize() const {
-    return m_bufferLayout->getHeader()->wordSize;
+    return m_bufferLayout->getWordSize();
+}
+
+template <typename T>
+void SharedDataStream<T>::setTimestampTrack(std::shared_ptr<TimestampTrack> track) {
+    m_bufferLayout->setTimestampTrack(track);
+}
+
+template <typename T>
+std::shared_ptr<TimestampTrack> SharedDataStream<T>::getTimestampTrack() const {
+    return m_bufferLayout->getTimestampTrack();
 }
 
 template <typename T>
@@ -382,14 +446,27 @@ std::unique_ptr<typename SharedDataStream<T>::Writer> SharedDataStream<T>::creat
     bool forceReplacement) {
     auto header = m_bufferLayout->getHeader();
     std::lock_guard<Mutex> lock(header->writerEnableMutex);
-    if (header->isWriterEnabled && !forceReplacement) {
+    if (1 == header->maxWriters) {
+        if (header->isWriterEnabled && !forceReplacement) {
+            logger::acsdkError(logger::LogEntry(TAG, "createWriterFailed")
+                                   .d("reason", "existingWriterAttached")
+                                   .d("forceReplacement", "false"));
+            return nullptr;
+        }
+        return std::unique_ptr<Writer>(new Writer(policy, m_bufferLayout, 0));
+    }
+    for (size_t id = 0; id < header->maxWriters; ++id) {
+        if (!m_bufferLayout->isWriterEnabled(id)) {
+            return std::unique_ptr<Writer>(new Writer(policy, m_bufferLayout, id));
+        }
+    }
+    if (!forceReplacement) {
         logger::acsdkError(logger::LogEntry(TAG, "createWriterFailed")
-                               .d("reason", "existingWriterAttached")
+                               .d("reason", "noAvailableWriters")
                                .d("forceReplacement", "false"));
         return nullptr;
-    } else {
-        return std::unique_ptr<Writer>(new Writer(policy, m_bufferLayout));
     }
+    return std::unique_ptr<Writer>(new Writer(policy, m_bufferLayout, 0));
 }
 
 template <typename T>
@@ -0,0 +1,151 @@
+/*
+ * TimestampTrack.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_SDS_TIMESTAMPTRACK_H_
+#define ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_SDS_TIMESTAMPTRACK_H_
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "AVSCommon/Utils/Timing/Clock.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace sds {
+
+/**
+ * A side channel for a @c SharedDataStream which maps stream indices to the monotonic time at which they were
+ * captured, so that latencies such as capture-to-detection or capture-to-upload can be measured per utterance.
+ *
+ * The @c Writer of a stream with a track records the end index and time of each write.  The time of each index in
+ * between is interpolated from the surrounding writes, which is exact for a source with a constant rate such as a
+ * microphone.  The track keeps the time of every @c wordsPerSlot'th index in a ring of @c numSlots slots, so a lookup
+ * is O(1), and times are available for the most recent `wordsPerSlot * numSlots` words.
+ *
+ * The times are those of the @c Clock given at creation; by default, the time of the write stands in for the time
+ * of capture.  A writer which knows the capture time of its data more precisely can instead call @c record() itself
+ * on a track which is not attached to the stream.
+ */
+class TimestampTrack {
+public:
+    /// The index type of a @c SharedDataStream.
+    using Index = uint64_t;
+
+    /**
+     * Create a @c TimestampTrack.
+     *
+     * @param wordsPerSlot The number of words between the indices whose times are kept.  Must be greater than zero.
+     * @param numSlots The number of times kept.  Must be greater than one.
+     * @param clock The clock to read the time of each write from, or @c nullptr to use the default clock.
+     * @return The new @c TimestampTrack, or @c nullptr if the parameters are invalid.
+     */
+    static std::shared_ptr<TimestampTrack> create(
+        size_t wordsPerSlot,
+        size_t numSlots,
+        std::shared_ptr<timing::Clock> clock = nullptr);
+
+    /**
+     * Record that the words before @c endIndex have been captured by now, according to this track's clock.
+     *
+     * @param endIndex The index after the last word captured.
+     */
+    void recordNow(Index endIndex);
+
+    /**
+     * Record that the words before @c endIndex had been captured by @c time.  Calls must be made with increasing
+     * indices and times.
+     *
+     * @param endIndex The index after the last word captured.
+     * @param time The time at which the word at @c endIndex would start to be captured.
+     */
+    void record(Index endIndex, timing::Clock::SteadyTimePoint time);
+
+    /**
+     * Look up the time at which a word was captured.
+     *
+     * @param index The index of the word.
+     * @param[out] time The time at which the word started to be captured.
+     * @return Whether the time is known.  It is not for indices which have not been written yet, which are older than
+     *     the track holds, or which precede the first write the track recorded.
+     */
+    bool getTime(Index index, timing::Clock::SteadyTimePoint* time) const;
+
+    /**
+     * Get the clock this track reads the time from, so that latencies can be measured against the same clock.
+     *
+     * @return The clock of this track.
+     */
+    std::shared_ptr<timing::Clock> getClock() const;
+
+private:
+    /// The time kept for one index which is a multiple of @c m_wordsPerSlot.
+    struct Slot {
+        /// The index divided by @c m_wordsPerSlot, or @c INVALID_SLOT if the slot has not been written.
+        Index slotNumber;
+
+        /// The time of the index.
+        timing::Clock::SteadyTimePoint time;
+    };
+
+    /**
+     * Constructor.
+     *
+     * @param wordsPerSlot The number of words between the indices whose times are kept.
+     * @param numSlots The number of times kept.
+     * @param clock The clock to read the time of each write from.
+     */
+    TimestampTrack(size_t wordsPerSlot, size_t numSlots, std::shared_ptr<timing::Clock> clock);
+
+    /**
+     * Get the slot for a slot number, if it still holds that slot number.  The caller must be holding @c m_mutex.
+     *
+     * @param slotNumber The slot number to look up.
+     * @return The slot, or @c nullptr if it has been overwritten or not yet written.
+     */
+    const Slot* getSlotLocked(Index slotNumber) const;
+
+    /// The number of words between the indices whose times are kept.
+    const Index m_wordsPerSlot;
+
+    /// The clock to read the time of each write from.
+    const std::shared_ptr<timing::Clock> m_clock;
+
+    /// Mutex serializing access to the members below.
+    mutable std::mutex m_mutex;
+
+    /// The ring of slots, indexed by slot number modulo its size.
+    std::vector<Slot> m_slots;
+
+    /// Whether anything has been recorded yet.
+    bool m_hasRecord;
+
+    /// The end index of the last record.
+    Index m_lastIndex;
+
+    /// The time of the last record.
+    timing::Clock::SteadyTimePoint m_lastTime;
+};
+
+}  // namespace sds
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_SDS_TIMESTAMPTRACK_H_
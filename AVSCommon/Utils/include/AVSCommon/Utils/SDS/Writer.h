@@ -42,6 +42,10 @@ namespace sds {
  * the sense that @c Writer and @c Readers can all live in different threads, but individual member functions of a
  * @c Writer instance should not be called from multiple threads except where specifically noted in function
  * documentation below.
+ *
+ * @note On a stream created with @c maxWriters greater than one, several @c Writers may write at the same time, each
+ *     from its own thread.  A @c write() then only returns once its data has been published to the @c Readers, which
+ *     may mean waiting for @c Writers which claimed earlier regions of the stream to finish copying theirs.
  */
 template <typename T>
 class SharedDataStream<T>::Writer {
@@ -51,11 +55,6 @@ public:
         /**
          * A @c NONBLOCKABLE @c Writer will always write all the data provided without waiting for @c Readers to move
          * out of the way.
-         *
-         * @note: This policy causes the @c Writer to notify @c BLOCKING @c Readers about new data being available
-         *     without holding a mutex.  This means that a @c read() call may miss a notification and block when data
-         *     is actually available.  The assumption here is that a @c NONBLOCKABLE @c Writer will be frequently
-         *     writing data, and a subsequent @c write() will again notify the @c Reader and wake it up.
          */
         NONBLOCKABLE,
         /**
@@ -103,8 +102,9 @@ public:
      *
      * @param policy The policy to use for reading from the stream.
      * @param stream The @c BufferLayout to use for writing stream data.
+     * @param id The id of the @c Writer, which indexes the writer arrays of the @c BufferLayout.
      */
-    Writer(Policy policy, std::shared_ptr<BufferLayout> bufferLayout);
+    Writer(Policy policy, std::shared_ptr<BufferLayout> bufferLayout, size_t id);
 
     /// This destructor detaches the @c Writer from a @c BufferLayout.
     ~Writer();
@@ -129,7 +129,8 @@ public:
     ssize_t write(const void* buf, size_t nWords, std::chrono::milliseconds timeout = std::chrono::milliseconds(0));
 
     /**
-     * This function reports the current position of the @c Writer in the stream.
+     * This function reports the current position of the @c Writer in the stream.  With multiple @c Writers, this is
+     * the end of the data published to @c Readers so far.
      *
      * @return The @c Writer's position (in @c wordSize words) in the stream.
      */
@@ -157,6 +158,38 @@ public:
     static std::string errorToString(Error error);
 
 private:
+    /**
+     * This function implements @c write() for a stream which allows multiple @c Writers.  It claims a region by
+     * advancing @c writeEndCursor atomically, copies the data into it, sets this @c Writer's commit marker, and then
+     * publishes committed regions, waiting on @c Header::writePublishedConditionVariable until its own has been
+     * published.
+     *
+     * @param buf8 A buffer to copy the data from.
+     * @param nWords The maximum number of @c wordSize words to copy.
+     * @param timeout The maximum time to wait (if @c policy is @c BLOCKING) for space to write into.
+     * @return The number of @c wordSize words copied, or a negative @c Error code if no data could be written.
+     */
+    ssize_t writeConcurrently(const uint8_t* buf8, size_t nWords, std::chrono::milliseconds timeout);
+
+    /**
+     * This function checks whether a region claimed at @c writeEnd would stay clear of the regions which other
+     * @c Writers have claimed but not yet published, i.e. whether it would not wrap around the ring onto them.
+     *
+     * @param writeEnd The @c Index the region would be claimed at.
+     * @param nWords The size of the region.
+     * @return Whether the region can be claimed without overlapping an unpublished one.
+     */
+    bool fitsBesideUnpublishedWrites(Index writeEnd, size_t nWords) const;
+
+    /**
+     * This function moves @c writeStartCursor over every committed region which starts at it, in index order, so
+     * that @c Readers can read them, and wakes the @c Readers waiting for the data.  Any @c Writer may publish the
+     * regions of the others.  The caller must be holding @c Header::writePublishMutex.
+     *
+     * @return Whether @c writeStartCursor was moved.
+     */
+    bool publishCommittedWritesLocked();
+
     /**
      * The tag associated with log entries from this class.
      */
@@ -168,6 +201,9 @@ private:
     /// The @c BufferLayout to use for writing stream data.
     std::shared_ptr<BufferLayout> m_bufferLayout;
 
+    /// The id of this @c Writer.
+    const size_t m_id;
+
     /**
      * A flag indicating whether this writer has closed.  This flag prevents trying to disable the writer during
      * destruction after previously having closed the writer.  Usage of this flag must be locked by
@@ -180,14 +216,19 @@ template <typename T>
 const std::string SharedDataStream<T>::Writer::TAG = "SdsWriter";
 
 template <typename T>
-SharedDataStream<T>::Writer::Writer(Policy policy, std::shared_ptr<BufferLayout> bufferLayout) :
+SharedDataStream<T>::Writer::Writer(Policy policy, std::shared_ptr<BufferLayout> bufferLayout, size_t id) :
         m_policy{policy},
         m_bufferLayout{bufferLayout},
+        m_id{id},
         m_closed{false} {
     // Note - SharedDataStream::createWriter() holds writerEnableMutex while calling this function.
     auto header = m_bufferLayout->getHeader();
+    // Other open writers may have claimed space beyond writeStartCursor which they are still writing to.
+    if (1 == header->maxWriters || !header->isWriterEnabled) {
+        header->writeEndCursor = header->writeStartCursor.load();
+    }
+    m_bufferLayout->enableWriterLocked(m_id);
     header->isWriterEnabled = true;
-    header->writeEndCursor = header->writeStartCursor.load();
 }
 
 template <typename T>
@@ -207,6 +248,13 @@ ssize_t SharedDataStream<T>::Writer::write(const void* buf, size_t nWords, std::
     }
 
     auto header = m_bufferLayout->getHeader();
+    if (header->maxWriters > 1) {
+        if (!m_bufferLayout->isWriterEnabled(m_id)) {
+            logger::acsdkError(logger::LogEntry(TAG, "writeFailed").d("reason", "writerDisabled"));
+            return Error::CLOSED;
+        }
+        return writeConcurrently(static_cast<const uint8_t*>(buf), nWords, timeout);
+    }
     if (!header->isWriterEnabled) {
         logger::acsdkError(logger::LogEntry(TAG, "writeFailed").d("reason", "writerDisabled"));
         return Error::CLOSED;
@@ -309,28 +357,178 @@ ssize_t SharedDataStream<T>::Writer::write(const void* buf, size_t nWords, std::
             afterWrap * getWordSize());
     }
 
-    // Advance the write cursor.
-    // Note: To prevent a race condition and ensure that readers which block on dataAvailableConditionVariable don't
-    // miss a notify, we should always lock the dataAvailableConditionVariable mutex while moving writeStartCursor.  As
-    // an optimization, we skip that lock for NONBLOCKABLE writers under the assumption that they will be writing
-    // continuously, so a missed notification is not significant.
-    // Note: As a further optimization, the lock could be omitted if no blocking readers are in use (ACSDK-251).
-    std::unique_lock<Mutex> dataAvailableLock(header->dataAvailableMutex, std::defer_lock);
-    if (Policy::NONBLOCKABLE == m_policy) {
-        dataAvailableLock.lock();
+    // Record the time of the write before publishing it, so that any reader which sees the data can look its time up.
+    auto timestampTrack = m_bufferLayout->getTimestampTrack();
+    if (timestampTrack) {
+        timestampTrack->recordNow(header->writeEndCursor);
     }
+
+    // Advance the write cursor.
     header->writeStartCursor = header->writeEndCursor.load();
+
+    // Wake the blocked reader(s) whose wake index has been reached.  Usually none has, so this is a single comparison
+    // and no lock.
+    // Note: A reader publishes its wake index before checking writeStartCursor, and we check its wake index after
+    // moving writeStartCursor, so either the reader sees the new data or we see the reader.
+    if (header->writeStartCursor >= header->readerWakeCursor) {
+        m_bufferLayout->wakeReaders(false);
+    }
+    m_bufferLayout->signalReadinessNotifiers();
+
+    return nWords;
+}
+
+template <typename T>
+ssize_t SharedDataStream<T>::Writer::writeConcurrently(
+    const uint8_t* buf8,
+    size_t nWords,
+    std::chrono::milliseconds timeout) {
+    auto header = m_bufferLayout->getHeader();
+    auto dataSize = m_bufferLayout->getDataSize();
+
+    // Note - for ALL_OR_NOTHING and BLOCKING, the space check must be performed while locked to prevent a reader from
+    // backwards-seeking into the claimed region.  NONBLOCKABLE writers claim without this lock, so the claim is a
+    // compare-and-swap which is retried if another writer moved writeEndCursor in the meantime.
+    std::unique_lock<Mutex> backwardSeekLock(header->backwardSeekMutex, std::defer_lock);
     if (Policy::NONBLOCKABLE == m_policy) {
-        dataAvailableLock.unlock();
+        // For NONBLOCKABLE, we can truncate the write if it won't fit in the buffer.
+        if (nWords > dataSize) {
+            nWords = dataSize;
+        }
+    } else {
+        backwardSeekLock.lock();
     }
 
-    // Notify the reader(s).
-    // Note: as an optimization, we could skip this if there are no blocking readers (ACSDK-251).
-    header->dataAvailableConditionVariable.notify_all();
+    Index writeEnd = header->writeEndCursor;
+    do {
+        if (Policy::BLOCKING == m_policy) {
+            // Condition for claiming: there is unclaimed space.
+            auto predicate = [header, dataSize] {
+                return (header->writeEndCursor < header->oldestUnconsumedCursor) ||
+                       (header->writeEndCursor - header->oldestUnconsumedCursor) < dataSize;
+            };
+            if (std::chrono::milliseconds::zero() == timeout) {
+                header->spaceAvailableConditionVariable.wait(backwardSeekLock, predicate);
+            } else if (!header->spaceAvailableConditionVariable.wait_for(backwardSeekLock, timeout, predicate)) {
+                return Error::TIMEDOUT;
+            }
+            writeEnd = header->writeEndCursor;
+            if (writeEnd >= header->oldestUnconsumedCursor &&
+                dataSize - (writeEnd - header->oldestUnconsumedCursor) < nWords) {
+                nWords = dataSize - (writeEnd - header->oldestUnconsumedCursor);
+            }
+        } else if (
+            Policy::ALL_OR_NOTHING == m_policy && (writeEnd + nWords >= header->oldestUnconsumedCursor) &&
+            ((writeEnd + nWords - header->oldestUnconsumedCursor) > dataSize)) {
+            return Error::WOULDBLOCK;
+        }
+
+        // Readers don't hold off a NONBLOCKABLE write, and one which is seeking into the future doesn't hold off an
+        // ALL_OR_NOTHING write either, but a region still being copied by another writer must.  Otherwise the two
+        // regions would share words of the ring, and the later copy could tear the earlier one.  So wait for enough
+        // of the claimed space to be published first.
+        if (!fitsBesideUnpublishedWrites(writeEnd, nWords)) {
+            std::unique_lock<Mutex> publishLock(header->writePublishMutex);
+            header->writePublishedConditionVariable.wait(publishLock, [this, header, writeEnd, nWords] {
+                return header->writeEndCursor != writeEnd || fitsBesideUnpublishedWrites(writeEnd, nWords);
+            });
+        }
+    } while (!header->writeEndCursor.compare_exchange_strong(writeEnd, writeEnd + nWords));
+    Index writeStart = writeEnd;
+    writeEnd = writeStart + nWords;
+
+    // We've claimed our region, so we no longer need to hold off backward seeks.
+    if (backwardSeekLock) {
+        backwardSeekLock.unlock();
+    }
+
+    // The claim is only looked at once the commit marker is set below.
+    auto& claim = m_bufferLayout->getWriterClaimArray()[m_id];
+    auto& commit = m_bufferLayout->getWriterCommitArray()[m_id];
+    claim = writeStart;
+
+    // As in write(), an ALL_OR_NOTHING write which is larger than the SDS only keeps its trailing data.
+    size_t wordsToCopy = nWords;
+    if (wordsToCopy > dataSize) {
+        buf8 += (wordsToCopy - dataSize) * getWordSize();
+        wordsToCopy = dataSize;
+    }
+    Index copyStart = writeEnd - wordsToCopy;
+
+    // Split it across the wrap and copy the two segments.
+    size_t beforeWrap = m_bufferLayout->wordsUntilWrap(copyStart);
+    if (beforeWrap > wordsToCopy) {
+        beforeWrap = wordsToCopy;
+    }
+    size_t afterWrap = wordsToCopy - beforeWrap;
+    memcpy(m_bufferLayout->getData(copyStart), buf8, beforeWrap * getWordSize());
+    if (afterWrap > 0) {
+        memcpy(
+            m_bufferLayout->getData(copyStart + beforeWrap),
+            buf8 + beforeWrap * getWordSize(),
+            afterWrap * getWordSize());
+    }
+
+    // Commit the region, then publish it along with any others which are ready.  If a writer which claimed an earlier
+    // region is still copying, ours can't be published before it, so wait for that writer to publish both.
+    // Note: We commit before taking writePublishMutex, and every writer publishes under it after committing, so
+    // whichever of us takes it last sees both commits.
+    commit = writeEnd;
+    std::unique_lock<Mutex> publishLock(header->writePublishMutex);
+    if (publishCommittedWritesLocked()) {
+        header->writePublishedConditionVariable.notify_all();
+    }
+    header->writePublishedConditionVariable.wait(
+        publishLock, [header, writeEnd] { return header->writeStartCursor >= writeEnd; });
+    commit = 0;
+    publishLock.unlock();
 
+    m_bufferLayout->signalReadinessNotifiers();
     return nWords;
 }
 
+template <typename T>
+bool SharedDataStream<T>::Writer::fitsBesideUnpublishedWrites(Index writeEnd, size_t nWords) const {
+    auto writeStart = m_bufferLayout->getHeader()->writeStartCursor.load();
+    return writeEnd == writeStart || writeEnd + nWords - writeStart <= m_bufferLayout->getDataSize();
+}
+
+template <typename T>
+bool SharedDataStream<T>::Writer::publishCommittedWritesLocked() {
+    auto header = m_bufferLayout->getHeader();
+    auto claims = m_bufferLayout->getWriterClaimArray();
+    auto commits = m_bufferLayout->getWriterCommitArray();
+    auto timestampTrack = m_bufferLayout->getTimestampTrack();
+    bool published = false;
+    Index writeStart = header->writeStartCursor;
+    bool found = true;
+    while (found) {
+        found = false;
+        for (size_t id = 0; id < header->maxWriters; ++id) {
+            // Note: The commit marker is read before the claim.  A writer only claims again after its commit marker
+            // has been published and cleared, so a marker ahead of writeStart belongs to the claim read after it.
+            Index writeEnd = commits[id];
+            if (writeEnd <= writeStart || claims[id] != writeStart) {
+                continue;
+            }
+            if (timestampTrack) {
+                timestampTrack->recordNow(writeEnd);
+            }
+            header->writeStartCursor = writeEnd;
+            writeStart = writeEnd;
+            published = true;
+            found = true;
+            break;
+        }
+    }
+
+    // See write() for why checking readerWakeCursor after moving writeStartCursor can't miss a reader.
+    if (published && header->writeStartCursor >= header->readerWakeCursor) {
+        m_bufferLayout->wakeReaders(false);
+    }
+    return published;
+}
+
 template <typename T>
 typename SharedDataStream<T>::Index SharedDataStream<T>::Writer::tell() const {
     return m_bufferLayout->getHeader()->writeStartCursor;
@@ -343,6 +541,14 @@ void SharedDataStream<T>::Writer::close() {
     if (m_closed) {
         return;
     }
+    m_bufferLayout->disableWriterLocked(m_id);
+    for (size_t id = 0; id < header->maxWriters; ++id) {
+        if (m_bufferLayout->isWriterEnabled(id)) {
+            // Readers only see the stream close when the last writer does.
+            m_closed = true;
+            return;
+        }
+    }
     if (header->isWriterEnabled) {
         header->isWriterEnabled = false;
 
@@ -350,14 +556,16 @@ void SharedDataStream<T>::Writer::close() {
 
         header->hasWriterBeenClosed = true;
 
-        header->dataAvailableConditionVariable.notify_all();
+        dataAvailableLock.unlock();
+        m_bufferLayout->wakeReaders(true);
+        m_bufferLayout->signalReadinessNotifiers();
     }
     m_closed = true;
 }
 
 template <typename T>
 size_t SharedDataStream<T>::Writer::getWordSize() const {
-    return m_bufferLayout->getHeader()->wordSize;
+    return m_bufferLayout->getWordSize();
 }
 
 template <typename T>
@@ -0,0 +1,99 @@
+/*
+ * ShutdownOrchestrator.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_SHUTDOWNORCHESTRATOR_H_
+#define ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_SHUTDOWNORCHESTRATOR_H_
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "AVSCommon/Utils/RequiresShutdown.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+
+/**
+ * Shuts down a set of @c RequiresShutdown objects in stages, under a deadline.
+ *
+ * Each object's @c shutdown() typically joins threads, which may be waiting on the network, a timer or a stream, so
+ * shutting down the objects of a client one after the other takes the sum of those waits.  Objects which don't depend
+ * on each other can instead be put in the same stage, whose objects are shut down in parallel.  Stages are shut down
+ * one after the other, in the order they were added, so that an object is shut down only once the objects it depends
+ * on have stopped using it.
+ *
+ * If the deadline passes first, @c shutdown() logs an error naming the objects it is still waiting for, and keeps
+ * waiting.  It never returns before every object is shut down, as the caller typically destroys what the objects use
+ * right after.
+ */
+class ShutdownOrchestrator {
+public:
+    /**
+     * Constructor.
+     *
+     * @param deadline The time after which @c shutdown() reports the objects which are still shutting down.
+     */
+    ShutdownOrchestrator(std::chrono::milliseconds deadline);
+
+    /**
+     * Add a stage of objects to shut down in parallel, after the objects of the stages added before.
+     *
+     * @param objects The objects of the stage.  @c nullptr entries are ignored.
+     */
+    void addStage(const std::vector<std::shared_ptr<RequiresShutdown>>& objects);
+
+    /**
+     * Shut down the objects of every stage, waiting until they are all shut down.  This must only be called once.
+     *
+     * @return Whether every object was shut down before the deadline.
+     */
+    bool shutdown();
+
+private:
+    /// The state shared with the thread shutting down the stages.
+    struct State;
+
+    /**
+     * Shuts down the stages one after the other, and reports that they are done through @c state.
+     *
+     * @param state The state shared with @c shutdown().
+     */
+    static void shutdownStages(std::shared_ptr<State> state);
+
+    /**
+     * Shuts down the objects of a stage in parallel, returning once they are all shut down.
+     *
+     * @param state The state shared with @c shutdown().
+     * @param stage The objects of the stage.
+     */
+    static void shutdownStage(
+        std::shared_ptr<State> state,
+        const std::vector<std::shared_ptr<RequiresShutdown>>& stage);
+
+    /// The time after which @c shutdown() reports the objects which are still shutting down.
+    const std::chrono::milliseconds m_deadline;
+
+    /// The stages of objects to shut down, in order.
+    std::vector<std::vector<std::shared_ptr<RequiresShutdown>>> m_stages;
+};
+
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_SHUTDOWNORCHESTRATOR_H_
@@ -19,10 +19,12 @@
 #define ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_THREADING_EXECUTOR_H_
 
 #include <future>
+#include <string>
 #include <utility>
 
 #include "AVSCommon/Utils/Threading/TaskThread.h"
 #include "AVSCommon/Utils/Threading/TaskQueue.h"
+#include "AVSCommon/Utils/Threading/ThreadPool.h"
 
 namespace alexaClientSDK {
 namespace avsCommon {
@@ -30,14 +32,53 @@ namespace utils {
 namespace threading {
 
 /**
- * An Executor is used to run callable types asynchronously.
+ * An Executor is used to run callable types asynchronously.  Tasks run one at a time, in the order they were submitted,
+ * either on a thread owned by the Executor, or on a thread borrowed from a @c ThreadPool while there are tasks to run.
+ *
+ * A task on a pool thread which blocks waiting for another Executor, for instance on the future of a task submitted
+ * to it, holds that pool thread until the other task has run.  If every thread of the pool is held like this, the
+ * tasks they wait for never get a thread, and the pool stalls.  An Executor whose tasks block on other Executors
+ * should therefore be created with @c ThreadPolicy::DEDICATED, or the pool must have more threads than tasks which can
+ * block at once.
  */
 class Executor {
 public:
+    /// Where an Executor runs its tasks.
+    enum class ThreadPolicy {
+        /// On @c ThreadPool::getDefault() if it is set, otherwise on a thread of its own.
+        DEFAULT,
+
+        /// On a thread of its own, even if a default pool is set.  For Executors whose tasks block on other Executors.
+        DEDICATED
+    };
+
     /**
      * Constructs an Executor.
+     *
+     * @param threadPool The pool to run tasks on.  If @c nullptr, @c ThreadPool::getDefault() is used, and if that is
+     *     @c nullptr too, the Executor runs tasks on its own thread.
+     */
+    explicit Executor(std::shared_ptr<ThreadPool> threadPool = nullptr);
+
+    /**
+     * Constructs an Executor.
+     *
+     * @param threadPolicy Whether the Executor may run tasks on the default pool, or must have its own thread.
      */
-    Executor();
+    explicit Executor(ThreadPolicy threadPolicy);
+
+    /**
+     * Constructs an Executor with a bounded queue, for a component whose tasks may be submitted faster than they run.
+     *
+     * @param capacity The most tasks waiting to run before @c overloadPolicy applies, or @c TaskQueue::UNBOUNDED.
+     * @param overloadPolicy What the Executor does with a task submitted while its queue is full.
+     * @param threadPool The pool to run tasks on.  If @c nullptr, @c ThreadPool::getDefault() is used, and if that is
+     *     @c nullptr too, the Executor runs tasks on its own thread.
+     */
+    Executor(
+        size_t capacity,
+        TaskQueue::OverloadPolicy overloadPolicy,
+        std::shared_ptr<ThreadPool> threadPool = nullptr);
 
     /**
      * Destructs an Executor.
@@ -67,6 +108,19 @@ public:
     template <typename Task, typename... Args>
     auto submitToFront(Task task, Args&&... args) -> std::future<decltype(task(args...))>;
 
+    /**
+     * Submits a callable type to be executed on an Executor thread, replacing a waiting task submitted with the same
+     * key if the Executor's overload policy is @c TaskQueue::OverloadPolicy::COALESCE.  This is meant for idempotent
+     * updates, where only the latest one matters.  The future must be checked for validity before waiting on it.
+     *
+     * @param key The key of the task.
+     * @param task A callable type representing a task.
+     * @param args The arguments to call the task with.
+     * @returns A @c std::future for the return value of the task.
+     */
+    template <typename Task, typename... Args>
+    auto submitCoalesced(const std::string& key, Task task, Args&&... args) -> std::future<decltype(task(args...))>;
+
     /**
      * Wait for any previously submitted tasks to complete.
      */
@@ -78,22 +132,56 @@ public:
     /// Returns whether or not the executor is shutdown.
     bool isShutdown();
 
+    /// Returns the counts of the overload policy of the executor's queue being applied so far.
+    TaskQueue::OverloadCounters getOverloadCounters();
+
 private:
+    /// Runs the tasks of an Executor on a @c ThreadPool.
+    class PooledTaskRunner;
+
+    /**
+     * Starts running the tasks of @c m_taskQueue.
+     *
+     * @param threadPool The pool to run tasks on, or @c nullptr to look up the default pool.
+     */
+    void start(std::shared_ptr<ThreadPool> threadPool);
+
+    /// Has @c m_pooledTaskRunner (if any) run the tasks just submitted.
+    void onTaskSubmitted();
+
     /// The queue of tasks to execute.
     std::shared_ptr<TaskQueue> m_taskQueue;
 
+    /// The pool tasks run on, or @c nullptr if @c m_taskThread runs them.  Keeps the pool alive while it is in use.
+    std::shared_ptr<ThreadPool> m_threadPool;
+
+    /// Runs tasks from @c m_taskQueue on @c m_threadPool, or @c nullptr if @c m_taskThread runs them.
+    std::shared_ptr<PooledTaskRunner> m_pooledTaskRunner;
+
     /// The thread to execute tasks on. The thread must be declared last to be destructed first.
     std::unique_ptr<TaskThread> m_taskThread;
 };
 
 template <typename Task, typename... Args>
 auto Executor::submit(Task task, Args&&... args) -> std::future<decltype(task(args...))> {
-    return m_taskQueue->push(task, std::forward<Args>(args)...);
+    auto future = m_taskQueue->push(task, std::forward<Args>(args)...);
+    onTaskSubmitted();
+    return future;
 }
 
 template <typename Task, typename... Args>
 auto Executor::submitToFront(Task task, Args&&... args) -> std::future<decltype(task(args...))> {
-    return m_taskQueue->pushToFront(task, std::forward<Args>(args)...);
+    auto future = m_taskQueue->pushToFront(task, std::forward<Args>(args)...);
+    onTaskSubmitted();
+    return future;
+}
+
+template <typename Task, typename... Args>
+auto Executor::submitCoalesced(const std::string& key, Task task, Args&&... args)
+    -> std::future<decltype(task(args...))> {
+    auto future = m_taskQueue->pushCoalesced(key, task, std::forward<Args>(args)...);
+    onTaskSubmitted();
+    return future;
 }
 
 }  // namespace threading
@@ -20,11 +20,14 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <cstdint>
 #include <deque>
 #include <functional>
 #include <future>
 #include <memory>
 #include <mutex>
+#include <string>
+#include <thread>
 #include <utility>
 
 namespace alexaClientSDK {
@@ -33,14 +36,67 @@ namespace utils {
 namespace threading {
 
 /**
- * A TaskQueue contains a queue of tasks to run
+ * A TaskQueue contains a queue of tasks to run.
+ *
+ * By default a TaskQueue is unbounded.  A queue given a capacity applies its @c OverloadPolicy to tasks pushed to its
+ * back while it is full, so that a consumer which falls behind can't make it grow, and the latency of its tasks rise,
+ * without limit.  Tasks pushed to the front are urgent, and are always queued.
  */
 class TaskQueue {
 public:
+    /// What a TaskQueue does with a task pushed while it is full.
+    enum class OverloadPolicy {
+        /**
+         * Block the pushing thread until there is room.  Pool threads, and the thread consuming the queue, are never
+         * blocked: their tasks are queued past the capacity instead.  Blocking a pool thread could starve the pool, as
+         * the task which would make room may be waiting for a pool thread itself.
+         */
+        BLOCK,
+
+        /// Drop the task which has been waiting longest, to make room.  Its future is fulfilled with an error.
+        DROP_OLDEST,
+
+        /// Drop the task being pushed, and return an invalid future for it.
+        DROP_NEW,
+
+        /**
+         * A task pushed with a key replaces the waiting task with the same key, if any, in its place in the queue, so
+         * the queue holds at most one task per key.  This is meant for idempotent updates, where only the latest one
+         * matters.  The replaced task's future is fulfilled with an error.  Tasks which replace none block while the
+         * queue is full, as with @c BLOCK.
+         */
+        COALESCE
+    };
+
+    /// Counts of the overload policy being applied, and of the queue's size.
+    struct OverloadCounters {
+        /// Constructor.
+        OverloadCounters();
+
+        /// The number of pushes which blocked because the queue was full.
+        uint64_t pushesBlocked;
+
+        /// The number of tasks dropped because the queue was full.
+        uint64_t tasksDropped;
+
+        /// The number of tasks replaced by a task pushed with the same key.
+        uint64_t tasksCoalesced;
+
+        /// The most tasks the queue has held at once.
+        size_t maxSize;
+    };
+
+    /// A capacity which leaves the queue unbounded.
+    static const size_t UNBOUNDED = 0;
+
     /**
      * Constructs an empty TaskQueue.
+     *
+     * @param capacity The most tasks the queue holds before @c overloadPolicy applies, or @c UNBOUNDED.
+     * @param overloadPolicy What the queue does with a task pushed while it is full.  A task pushed with a key is only
+     *     coalesced under @c OverloadPolicy::COALESCE, which also applies to an unbounded queue.
      */
-    TaskQueue();
+    TaskQueue(size_t capacity = UNBOUNDED, OverloadPolicy overloadPolicy = OverloadPolicy::BLOCK);
 
     /**
      * Pushes a task on the back of the queue. If the queue is shutdown, the task will be dropped, and an invalid
@@ -66,14 +122,54 @@ public:
     template <typename Task, typename... Args>
     auto pushToFront(Task task, Args&&... args) -> std::future<decltype(task(args...))>;
 
+    /**
+     * Pushes a task on the back of the queue, to be coalesced with a waiting task pushed with the same key under
+     * @c OverloadPolicy::COALESCE.  Under any other policy, this is the same as @c push().
+     *
+     * @param key The key of the task.  Tasks with an empty key are never coalesced.
+     * @param task A task to push to the back of the queue.
+     * @param args The arguments to call the task with.
+     * @returns A @c std::future to access the return value of the task. If the queue is shutdown, or drops the task
+     *     because it is full, an invalid future will be returned.
+     */
+    template <typename Task, typename... Args>
+    auto pushCoalesced(const std::string& key, Task task, Args&&... args) -> std::future<decltype(task(args...))>;
+
+    /**
+     * Pushes a task on the back of the queue even if the queue is full, without applying the overload policy.  This
+     * is meant for control tasks, such as a marker to wait for the tasks ahead of it.
+     *
+     * @param task A task to push to the back of the queue.
+     * @param args The arguments to call the task with.
+     * @returns A @c std::future to access the return value of the task. If the queue is shutdown, the task will be
+     *     dropped, and an invalid future will be returned.
+     */
+    template <typename Task, typename... Args>
+    auto pushPastCapacity(Task task, Args&&... args) -> std::future<decltype(task(args...))>;
+
     /**
      * Returns and removes the task at the front of the queue. If there are no tasks, this call will block until there
-     * is one. A @c nullptr will be returned if there are no more tasks expected.
+     * is one. A @c nullptr will be returned if there are no more tasks expected.  This is meant for a thread dedicated
+     * to the queue, which is recorded as its consumer.
      *
      * @returns A task which the caller assumes ownership of, or @c nullptr if the TaskQueue expects no more tasks.
      */
     std::unique_ptr<std::function<void()>> pop();
 
+    /**
+     * Returns and removes the task at the front of the queue, without blocking.
+     *
+     * @returns A task which the caller assumes ownership of, or @c nullptr if the queue is empty or shutdown.
+     */
+    std::unique_ptr<std::function<void()>> tryPop();
+
+    /**
+     * Returns whether the queue has no tasks waiting.
+     *
+     * @returns Whether the queue has no tasks waiting.
+     */
+    bool isEmpty();
+
     /**
      * Clears the queue of outstanding tasks and refuses any additional tasks to be pushed onto the queue.
      *
@@ -88,22 +184,76 @@ public:
      */
     bool isShutdown();
 
+    /**
+     * Returns the counts of the overload policy being applied so far.
+     *
+     * @returns The overload counters of the queue.
+     */
+    OverloadCounters getOverloadCounters();
+
 private:
+    /// Where a task is pushed.
+    enum class Placement {
+        /// The front of the queue, without applying the overload policy.
+        FRONT,
+
+        /// The back of the queue.
+        BACK,
+
+        /// The back of the queue, without applying the overload policy.
+        BACK_PAST_CAPACITY
+    };
+
+    /// A task waiting in the queue.
+    struct QueuedTask {
+        /// The task.
+        std::unique_ptr<std::function<void()>> task;
+
+        /// The key to coalesce the task by, or an empty string.
+        std::string key;
+    };
+
     /// The queue type to use for holding tasks.
-    using Queue = std::deque<std::unique_ptr<std::function<void()>>>;
+    using Queue = std::deque<QueuedTask>;
 
     /**
      * Pushes a task on the the queue. If the queue is shutdown, the task will be dropped, and an invalid
      * future will be returned.
      *
-     * @param front If @c true, push to the front of the queue, else push to the back.
+     * @param placement Where to push the task.
+     * @param key The key to coalesce the task by, or an empty string.
      * @param task A task to push to the front or back of the queue.
      * @param args The arguments to call the task with.
-     * @returns A @c std::future to access the return value of the task. If the queue is shutdown, the task will be
-     *     dropped, and an invalid future will be returned.
+     * @returns A @c std::future to access the return value of the task. If the queue is shutdown, or drops the task
+     *     because it is full, an invalid future will be returned.
      */
     template <typename Task, typename... Args>
-    auto pushTo(bool front, Task task, Args&&... args) -> std::future<decltype(task(args...))>;
+    auto pushTo(Placement placement, const std::string& key, Task task, Args&&... args)
+        -> std::future<decltype(task(args...))>;
+
+    /**
+     * Places a task in the queue, applying the overload policy.
+     *
+     * @param placement Where to push the task.
+     * @param key The key to coalesce the task by, or an empty string.
+     * @param task The task to place.
+     * @returns Whether the task was placed in the queue, rather than dropped because the queue is shutdown or full.
+     */
+    bool enqueue(Placement placement, const std::string& key, std::unique_ptr<std::function<void()>> task);
+
+    /**
+     * Removes the task at the front of the queue.  The caller must be holding @c m_queueMutex, and the queue must not
+     * be empty.
+     *
+     * @returns The task removed.
+     */
+    std::unique_ptr<std::function<void()>> popLocked();
+
+    /// The most tasks the queue holds before @c m_overloadPolicy applies, or @c UNBOUNDED.
+    const size_t m_capacity;
+
+    /// What the queue does with a task pushed while it is full.
+    const OverloadPolicy m_overloadPolicy;
 
     /// The queue of tasks
     Queue m_queue;
@@ -111,23 +261,45 @@ private:
     /// A condition variable to wait for new tasks to be placed on the queue.
     std::condition_variable m_queueChanged;
 
+    /// A condition variable to wait for room in a full queue.
+    std::condition_variable m_queueNotFull;
+
     /// A mutex to protect access to the tasks in m_queue.
     std::mutex m_queueMutex;
 
     /// A flag for whether or not the queue is expecting more tasks.
     std::atomic_bool m_shutdown;
+
+    /**
+     * The thread dedicated to the queue, which takes tasks from it with @c pop().  It is not blocked by a full queue, as
+     * it may be running a task of this queue, which would then wait for itself.  Pool threads taking tasks with
+     * @c tryPop() are not recorded, as they move between queues; they are never blocked at all.
+     */
+    std::thread::id m_consumerThread;
+
+    /// The counts of the overload policy being applied.
+    OverloadCounters m_overloadCounters;
 };
 
 template <typename Task, typename... Args>
 auto TaskQueue::push(Task task, Args&&... args) -> std::future<decltype(task(args...))> {
-    bool front = true;
-    return pushTo(!front, std::forward<Task>(task), std::forward<Args>(args)...);
+    return pushTo(Placement::BACK, "", std::forward<Task>(task), std::forward<Args>(args)...);
 }
 
 template <typename Task, typename... Args>
 auto TaskQueue::pushToFront(Task task, Args&&... args) -> std::future<decltype(task(args...))> {
-    bool front = true;
-    return pushTo(front, std::forward<Task>(task), std::forward<Args>(args)...);
+    return pushTo(Placement::FRONT, "", std::forward<Task>(task), std::forward<Args>(args)...);
+}
+
+template <typename Task, typename... Args>
+auto TaskQueue::pushCoalesced(const std::string& key, Task task, Args&&... args)
+    -> std::future<decltype(task(args...))> {
+    return pushTo(Placement::BACK, key, std::forward<Task>(task), std::forward<Args>(args)...);
+}
+
+template <typename Task, typename... Args>
+auto TaskQueue::pushPastCapacity(Task task, Args&&... args) -> std::future<decltype(task(args...))> {
+    return pushTo(Placement::BACK_PAST_CAPACITY, "", std::forward<Task>(task), std::forward<Args>(args)...);
 }
 
 /**
@@ -154,7 +326,8 @@ inline void forwardPromise<void>(std::shared_ptr<std::promise<void>> promise, st
 }
 
 template <typename Task, typename... Args>
-auto TaskQueue::pushTo(bool front, Task task, Args&&... args) -> std::future<decltype(task(args...))> {
+auto TaskQueue::pushTo(Placement placement, const std::string& key, Task task, Args&&... args)
+    -> std::future<decltype(task(args...))> {
     // Remove arguments from the tasks type by binding the arguments to the task.
     auto boundTask = std::bind(std::forward<Task>(task), std::forward<Args>(args)...);
 
@@ -194,17 +367,10 @@ auto TaskQueue::pushTo(bool front, Task task, Args&&... args) -> std::future<dec
     // Release our local reference to packaged task so that the only remaining reference is inside the lambda.
     packaged_task.reset();
 
-    {
-        std::lock_guard<std::mutex> queueLock{m_queueMutex};
-        if (!m_shutdown) {
-            m_queue.emplace(front ? m_queue.begin() : m_queue.end(), new std::function<void()>(translated_task));
-        } else {
-            using FutureType = decltype(task(args...));
-            return std::future<FutureType>();
-        }
+    if (!enqueue(placement, key, std::unique_ptr<std::function<void()>>(new std::function<void()>(translated_task)))) {
+        using FutureType = decltype(task(args...));
+        return std::future<FutureType>();
     }
-
-    m_queueChanged.notify_all();
     return cleanupFuture;
 }
 
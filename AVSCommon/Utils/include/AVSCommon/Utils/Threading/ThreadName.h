@@ -0,0 +1,49 @@
+/*
+ * ThreadName.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_THREADING_THREADNAME_H_
+#define ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_THREADING_THREADNAME_H_
+
+#include <string>
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace threading {
+
+/**
+ * Name the calling thread after its role, so that tools such as @c top -H and @c gdb, and @c WakeupAudit, can tell the
+ * threads of the SDK apart.  Threads with the same role share a name.  Linux limits names to 15 characters, and longer
+ * ones are truncated.  This does nothing on platforms without thread names.
+ *
+ * @param name The name of the thread.
+ */
+void setThreadName(const std::string& name);
+
+/**
+ * Get the name of the calling thread.
+ *
+ * @return The name of the calling thread, or an empty string if it can't be read.
+ */
+std::string getThreadName();
+
+}  // namespace threading
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_THREADING_THREADNAME_H_
@@ -0,0 +1,131 @@
+/*
+ * ThreadPool.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_THREADING_THREADPOOL_H_
+#define ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_THREADING_THREADPOOL_H_
+
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace threading {
+
+/**
+ * A fixed set of threads which run jobs posted from any number of sources.
+ *
+ * By default every @c Executor owns a thread.  When many SDK clients are hosted in one process, for instance to
+ * simulate a fleet of devices, that is thousands of mostly idle threads.  Executors created with a @c ThreadPool
+ * (directly, or through @c setDefault()) instead borrow a pool thread while they have tasks to run, still running their
+ * own tasks one at a time and in order.
+ *
+ * The pool has a fixed number of threads, so a job which blocks until another job has run can starve the pool: once
+ * every thread is blocked like this, the jobs they wait for never start.  This matters for executors whose tasks wait
+ * on other executors, such as the @c FocusManager, whose tasks wait for channel observers to change state.  Such
+ * executors should keep a thread of their own (see @c Executor::ThreadPolicy::DEDICATED), or the pool must have more
+ * threads than jobs which can block at the same time.  For the same reason, a pool thread is never blocked by a full
+ * @c TaskQueue with @c TaskQueue::OverloadPolicy::BLOCK.
+ */
+class ThreadPool {
+public:
+    /**
+     * Create a @c ThreadPool.
+     *
+     * @param numThreads The number of threads in the pool.  Must be greater than zero.
+     * @return The new @c ThreadPool, or @c nullptr if @c numThreads is zero.
+     */
+    static std::shared_ptr<ThreadPool> create(size_t numThreads);
+
+    /**
+     * Destructor.  Jobs which have not started are dropped, and running jobs are waited for.
+     */
+    ~ThreadPool();
+
+    /**
+     * Queue a job to run on one of the threads of the pool.  Jobs start in the order they are posted, but as they
+     * run on several threads, they may finish in any order.
+     *
+     * @param job The job to run.
+     */
+    void post(std::function<void()> job);
+
+    /**
+     * Get the number of threads in the pool.
+     *
+     * @return The number of threads in the pool.
+     */
+    size_t getNumThreads() const;
+
+    /**
+     * Whether the calling thread belongs to a @c ThreadPool.
+     *
+     * @return Whether the calling thread is a pool thread.
+     */
+    static bool isPoolThread();
+
+    /**
+     * Get the pool that executors created without one use.  Unless changed with @c setDefault(), this is @c nullptr,
+     * meaning each executor gets its own thread.
+     *
+     * @return The default pool, or @c nullptr.
+     */
+    static std::shared_ptr<ThreadPool> getDefault();
+
+    /**
+     * Set the pool that executors created without one use.  Only executors created after this call are affected, so a
+     * process hosting many clients should call it before creating them.  Executors created with
+     * @c Executor::ThreadPolicy::DEDICATED keep their own thread.
+     *
+     * @param threadPool The new default pool, or @c nullptr to give each executor its own thread.
+     */
+    static void setDefault(std::shared_ptr<ThreadPool> threadPool);
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param numThreads The number of threads in the pool.
+     */
+    ThreadPool(size_t numThreads);
+
+    /// The state shared between the pool and its threads.
+    struct State;
+
+    /**
+     * Runs jobs until the pool is destroyed.  The thread holds its own reference to the shared state, so that it can
+     * still exit cleanly if it was detached because the pool was destroyed by one of its jobs.
+     *
+     * @param state The state of the pool.
+     */
+    static void workerLoop(std::shared_ptr<State> state);
+
+    /// The state shared between the pool and its threads.
+    std::shared_ptr<State> m_state;
+
+    /// The threads of the pool.
+    std::vector<std::thread> m_threads;
+};
+
+}  // namespace threading
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_THREADING_THREADPOOL_H_
@@ -0,0 +1,110 @@
+/*
+ * WakeupAudit.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_THREADING_WAKEUPAUDIT_H_
+#define ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_THREADING_WAKEUPAUDIT_H_
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace threading {
+
+/**
+ * Counts how often each thread of the process is scheduled over a period, grouped by thread name, to find the threads
+ * which keep waking the CPU while the client is idle.  Threads are named after their role with @c setThreadName(), so
+ * the counts of, say, every @c Executor thread are reported together.
+ *
+ * The counts come from the scheduler statistics in @c /proc/self/task/<tid>/schedstat, which count the timeslices each
+ * thread has run.  A thread which sleeps on a timeout or a condition gets one timeslice per wakeup, so when the process
+ * is idle this is its number of wakeups.  The audit is only available on Linux kernels with scheduler statistics.
+ */
+class WakeupAudit {
+public:
+    /// The wakeups of the threads sharing one name.
+    struct RoleWakeups {
+        /// The number of threads with the name.
+        size_t numThreads;
+
+        /// The number of wakeups of those threads since the audit started.
+        uint64_t numWakeups;
+
+        /// The average number of wakeups per second of those threads since the audit started.
+        double wakeupsPerSecond;
+    };
+
+    /**
+     * Start an audit, taking a first sample of every thread of the process.
+     *
+     * @return The new @c WakeupAudit, or @c nullptr if the scheduler statistics of this process can't be read.
+     */
+    static std::unique_ptr<WakeupAudit> create();
+
+    /**
+     * Get the wakeups since the audit started.  Threads which have exited since are not included, and threads which
+     * started since are counted from their start.  This can be called any number of times as the audit goes on.
+     *
+     * @return The wakeups of the threads of the process, keyed by thread name.
+     */
+    std::map<std::string, RoleWakeups> getWakeups() const;
+
+private:
+    /// A sample of one thread.
+    struct ThreadSample {
+        /// The name of the thread.
+        std::string name;
+
+        /// The number of timeslices the thread has run.
+        uint64_t numTimeslices;
+    };
+
+    /// The samples of the threads of the process, keyed by thread ID.
+    using Samples = std::map<std::string, ThreadSample>;
+
+    /**
+     * Constructor.
+     *
+     * @param start The samples taken at the start of the audit.
+     */
+    WakeupAudit(Samples start);
+
+    /**
+     * Sample every thread of the process.
+     *
+     * @param[out] samples The samples taken.
+     * @return Whether the threads of the process could be listed.  Threads which exit while being sampled are left out.
+     */
+    static bool sample(Samples* samples);
+
+    /// The time the audit started.
+    const std::chrono::steady_clock::time_point m_startTime;
+
+    /// The samples taken at the start of the audit.
+    const Samples m_start;
+};
+
+}  // namespace threading
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_THREADING_WAKEUPAUDIT_H_
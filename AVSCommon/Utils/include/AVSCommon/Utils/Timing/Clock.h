@@ -0,0 +1,123 @@
+/*
+ * Clock.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_TIMING_CLOCK_H_
+#define ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_TIMING_CLOCK_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace timing {
+
+/**
+ * A source of the current time, and of timed waits against that time.
+ *
+ * Components which schedule work in the future read the time and wait for deadlines through a @c Clock rather than
+ * through @c std::chrono::steady_clock and @c std::chrono::system_clock directly.  This allows tests to substitute a
+ * clock which only advances when told to, so that behavior which takes seconds or hours of real time can be verified
+ * deterministically in milliseconds.
+ */
+class Clock {
+public:
+    /// Alias for the type of monotonic time points.
+    using SteadyTimePoint = std::chrono::steady_clock::time_point;
+
+    /// Alias for the type of wall clock time points.
+    using SystemTimePoint = std::chrono::system_clock::time_point;
+
+    /// Destructor.
+    virtual ~Clock() = default;
+
+    /**
+     * Get the current monotonic time.  Use this to measure intervals and compute deadlines.
+     *
+     * @return The current monotonic time.
+     */
+    virtual SteadyTimePoint steadyNow() = 0;
+
+    /**
+     * Get the current wall clock time.  Use this for timestamps which are compared with times from outside the
+     * device, such as the scheduled time of an alert.
+     *
+     * @return The current wall clock time.
+     */
+    virtual SystemTimePoint systemNow() = 0;
+
+    /**
+     * Wait on a condition variable until a predicate is satisfied or a deadline of this clock passes.  This has the
+     * semantics of @c std::condition_variable::wait_until with a predicate, with @c deadline measured by this clock.
+     *
+     * @param condition The condition variable to wait on.  Whoever changes the state tested by @c predicate must
+     *     notify this condition variable.
+     * @param lock A lock on the mutex protecting the state tested by @c predicate.  It must be locked on entry, and is
+     *     locked on return.
+     * @param deadline The time of this clock to stop waiting at.
+     * @param predicate The condition to wait for.
+     * @return The value of @c predicate on return, so @c false means the deadline passed.
+     */
+    virtual bool waitUntil(
+        std::condition_variable& condition,
+        std::unique_lock<std::mutex>& lock,
+        SteadyTimePoint deadline,
+        std::function<bool()> predicate) = 0;
+
+    /**
+     * Get the clock that components use when they are not given one explicitly.  Unless changed with
+     * @c setDefault(), this is a @c SystemClock.
+     *
+     * @return The default clock.
+     */
+    static std::shared_ptr<Clock> getDefault();
+
+    /**
+     * Set the clock that components use when they are not given one explicitly.  Only components created after this
+     * call are affected, so tests should call it before creating the objects under test.
+     *
+     * @param clock The new default clock, or @c nullptr to restore the @c SystemClock.
+     */
+    static void setDefault(std::shared_ptr<Clock> clock);
+};
+
+/**
+ * A @c Clock backed by @c std::chrono::steady_clock and @c std::chrono::system_clock.
+ */
+class SystemClock : public Clock {
+public:
+    /// @name Clock methods.
+    /// @{
+    SteadyTimePoint steadyNow() override;
+    SystemTimePoint systemNow() override;
+    bool waitUntil(
+        std::condition_variable& condition,
+        std::unique_lock<std::mutex>& lock,
+        SteadyTimePoint deadline,
+        std::function<bool()> predicate) override;
+    /// @}
+};
+
+}  // namespace timing
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_TIMING_CLOCK_H_
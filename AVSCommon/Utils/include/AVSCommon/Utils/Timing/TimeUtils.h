@@ -18,7 +18,10 @@
 #ifndef ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_TIMING_TIMEUTILS_H_
 #define ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_TIMING_TIMEUTILS_H_
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
+
 #include "AVSCommon/Utils/RetryTimer.h"
 
 namespace alexaClientSDK {
@@ -26,6 +29,104 @@ namespace avsCommon {
 namespace utils {
 namespace timing {
 
+/// The length of a time string in the ISO-8601 format accepted by @c convert8601TimeStringToUnix().
+constexpr size_t ISO_8601_TIME_STRING_LENGTH = 24;
+
+/// The length of the "YYYY-MM-DD HH:MM:SS" date and time written by @c formatDateAndTime().
+constexpr size_t DATE_AND_TIME_STRING_LENGTH = 19;
+
+/// The number of seconds in a day.  Unix time does not count leap seconds, so every day has this many.
+constexpr int64_t SECONDS_PER_DAY = 86400;
+
+namespace detail {
+
+/**
+ * Get the 400 year era of the Gregorian calendar which a year belongs to.  Helper for @c daysFromCivil().
+ *
+ * @param year A year which starts on March 1st.
+ * @return The era, with era 0 starting on March 1st of the year 0.
+ */
+constexpr int64_t eraOfYear(int64_t year) {
+    return (year >= 0 ? year : year - 399) / 400;
+}
+
+/**
+ * Get the number of days between the start of an era and a date.  Helper for @c daysFromCivil().
+ *
+ * @param yearOfEra The year within its era, from 0 to 399, with years starting on March 1st.
+ * @param month The month, from 1 to 12.
+ * @param day The day of the month, from 1.
+ * @return The day of the era, from 0 to 146096.
+ */
+constexpr int64_t dayOfEra(int64_t yearOfEra, unsigned month, unsigned day) {
+    return yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 +
+           day - 1;
+}
+
+/**
+ * Get the number of days between the Unix epoch and a date, counting years from March 1st so that leap days come at
+ * the end of the year.  Helper for @c daysFromCivil().
+ *
+ * @param marchYear The year which started on the March 1st before the date.
+ * @param month The month, from 1 to 12.
+ * @param day The day of the month, from 1.
+ * @return The number of days since 1970-01-01, which is negative for earlier dates.
+ */
+constexpr int64_t daysFromMarchYear(int64_t marchYear, unsigned month, unsigned day) {
+    // 146097 is the number of days in an era, and 719468 the number of days from 0000-03-01 to 1970-01-01.
+    return eraOfYear(marchYear) * 146097 + dayOfEra(marchYear - eraOfYear(marchYear) * 400, month, day) - 719468;
+}
+
+}  // namespace detail
+
+/**
+ * Get the number of days between the Unix epoch and a date in the proleptic Gregorian calendar.  This is pure
+ * arithmetic, so unlike @c std::mktime() it does not depend on the time zone of the process, is thread-safe, and can
+ * be evaluated at compile time.
+ *
+ * @param year The year, where 0 is 1 BC.
+ * @param month The month, from 1 to 12.
+ * @param day The day of the month, from 1 to the length of the month.
+ * @return The number of days since 1970-01-01, which is negative for earlier dates.
+ */
+constexpr int64_t daysFromCivil(int64_t year, unsigned month, unsigned day) {
+    return detail::daysFromMarchYear(month <= 2 ? year - 1 : year, month, day);
+}
+
+/**
+ * Get the date in the proleptic Gregorian calendar which is a number of days from the Unix epoch.  This is the inverse
+ * of @c daysFromCivil().
+ *
+ * @param days The number of days since 1970-01-01, which is negative for earlier dates.
+ * @param[out] year The year, where 0 is 1 BC.
+ * @param[out] month The month, from 1 to 12.
+ * @param[out] day The day of the month, from 1.
+ */
+void civilFromDays(int64_t days, int64_t* year, unsigned* month, unsigned* day);
+
+/**
+ * Get the number of days in a month of the proleptic Gregorian calendar.
+ *
+ * @param year The year.
+ * @param month The month, from 1 to 12.
+ * @return The number of days in the month.
+ */
+constexpr unsigned daysInMonth(int64_t year, unsigned month) {
+    return month != 2 ? 30 + ((month + month / 8) & 1)
+                      : ((year % 4 == 0 && year % 100 != 0) || year % 400 == 0) ? 29 : 28;
+}
+
+/**
+ * Write the UTC date and time of a Unix time as "YYYY-MM-DD HH:MM:SS", with a chosen separator between the date and
+ * the time.  Nothing is allocated, and no terminating null is written.
+ *
+ * @param unixTime The Unix time to format.
+ * @param dateTimeSeparator The character to write between the date and the time.
+ * @param[out] buffer Where to write the @c DATE_AND_TIME_STRING_LENGTH characters of the date and time.
+ * @return Whether the time was written.  It is not for years outside 0 to 9999, which do not fit in four digits.
+ */
+bool formatDateAndTime(int64_t unixTime, char dateTimeSeparator, char* buffer);
+
 /**
  * This function converts a string representing time, encoded in the ISO-8601 format, to what is commonly
  * known as Unix time (epoch).
@@ -48,6 +149,9 @@ namespace timing {
  *
  * means the year 1986, August 8th, 9:30pm.
  *
+ * The time is converted without allocating or consulting the time zone of the process, taking into account the UTC
+ * offset at the end of the string.
+ *
  * @param timeString The time string, formatted as described above.
  * @param[out] unixTime The converted time into Unix epoch time.
  * @return Whether the conversion was successful.
@@ -55,7 +159,27 @@ namespace timing {
 bool convert8601TimeStringToUnix(const std::string& timeString, int64_t* unixTime);
 
 /**
- * Gets the current time in Unix epoch time, as a 64 bit integer.
+ * Converts a time string in the ISO-8601 format accepted by @c convert8601TimeStringToUnix(), which need not be
+ * null terminated, to Unix time.
+ *
+ * @param timeString The characters of the time string.
+ * @param length The number of characters in the time string.
+ * @param[out] unixTime The converted time into Unix epoch time.
+ * @return Whether the conversion was successful.
+ */
+bool convert8601TimeStringToUnix(const char* timeString, size_t length, int64_t* unixTime);
+
+/**
+ * Converts a Unix time to a string in the ISO-8601 format accepted by @c convert8601TimeStringToUnix(), in UTC.
+ *
+ * @param unixTime The Unix time to convert.
+ * @param[out] timeString The time string, in the form YYYY-MM-DDTHH:MM:SS+0000.
+ * @return Whether the conversion was successful.  It is not for years outside 0 to 9999.
+ */
+bool convertUnixTimeTo8601String(int64_t unixTime, std::string* timeString);
+
+/**
+ * Gets the current time of @c Clock::getDefault() in Unix epoch time, as a 64 bit integer.
  *
  * @param[out] currentTime The current time in Unix epoch time, as a 64 bit integer.
  * @return Whether the get time was successful.
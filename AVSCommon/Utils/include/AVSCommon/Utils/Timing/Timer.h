@@ -26,6 +26,8 @@
 #include <thread>
 
 #include "AVSCommon/Utils/Logger/LoggerUtils.h"
+#include "AVSCommon/Utils/Threading/ThreadName.h"
+#include "AVSCommon/Utils/Timing/Clock.h"
 
 namespace alexaClientSDK {
 namespace avsCommon {
@@ -64,8 +66,10 @@ public:
 
     /**
      * Contructs a @c Timer.
+     *
+     * @param clock The clock to measure delays and periods with.  If @c nullptr, @c Clock::getDefault() is used.
      */
-    Timer();
+    explicit Timer(std::shared_ptr<Clock> clock = nullptr);
 
     /**
      * Destructs a @c Timer.
@@ -188,6 +192,7 @@ private:
      * @tparam Rep A type for measuring 'ticks' in a generic @c std::chrono::duration.
      * @tparam Period A type for representing the number of ticks per second in a generic @c std::chrono::duration.
      *
+     * @param startTime The time of @c m_clock the timer was started at, which @c delay is measured from.
      * @param delay The non-negative time to wait before making the first @c task call.
      * @param period The non-negative time to wait between subsequent @c task calls.
      * @param periodType The type of period to use when making subsequent task calls.
@@ -198,6 +203,7 @@ private:
      */
     template <typename Rep, typename Period>
     void callTask(
+        Clock::SteadyTimePoint startTime,
         std::chrono::duration<Rep, Period> delay,
         std::chrono::duration<Rep, Period> period,
         PeriodType periodType,
@@ -209,6 +215,9 @@ private:
      */
     static const std::string TAG;
 
+    /// The clock to measure delays and periods with.
+    std::shared_ptr<Clock> m_clock;
+
     /// The condition variable used to wait for @c stop() or period timeouts.
     std::condition_variable m_waitCondition;
 
@@ -264,8 +273,9 @@ bool Timer::start(
     auto translatedTask = [boundTask]() { boundTask->operator()(); };
 
     // Kick off the new timer thread.
+    auto startTime = m_clock->steadyNow();
     m_thread = std::thread{
-        std::bind(&Timer::callTask<Rep, Period>, this, delay, period, periodType, maxCount, translatedTask)};
+        std::bind(&Timer::callTask<Rep, Period>, this, startTime, delay, period, periodType, maxCount, translatedTask)};
 
     return true;
 }
@@ -311,21 +321,25 @@ auto Timer::start(const std::chrono::duration<Rep, Period>& delay, Task task, Ar
 
     // Kick off the new timer thread.
     static const size_t once = 1;
-    m_thread = std::thread{
-        std::bind(&Timer::callTask<Rep, Period>, this, delay, delay, PeriodType::ABSOLUTE, once, translatedTask)};
+    auto startTime = m_clock->steadyNow();
+    m_thread = std::thread{std::bind(
+        &Timer::callTask<Rep, Period>, this, startTime, delay, delay, PeriodType::ABSOLUTE, once, translatedTask)};
 
     return packagedTask->get_future();
 }
 
 template <typename Rep, typename Period>
 void Timer::callTask(
+    Clock::SteadyTimePoint startTime,
     std::chrono::duration<Rep, Period> delay,
     std::chrono::duration<Rep, Period> period,
     PeriodType periodType,
     size_t maxCount,
     std::function<void()> task) {
+    threading::setThreadName("Timer");
+
     // Timepoint to measure delay/period against.
-    auto now = std::chrono::steady_clock::now();
+    auto now = startTime;
 
     // Flag indicating whether we've drifted off schedule.
     bool offSchedule = false;
@@ -336,7 +350,7 @@ void Timer::callTask(
             std::unique_lock<std::mutex> lock(m_waitMutex);
 
             // Wait for stop() or a delay/period to elapse.
-            if (m_waitCondition.wait_until(lock, now + waitTime, [this]() { return m_stopping; })) {
+            if (m_clock->waitUntil(m_waitCondition, lock, now + waitTime, [this]() { return m_stopping; })) {
                 m_stopping = false;
                 m_running = false;
                 return;
@@ -354,7 +368,7 @@ void Timer::callTask(
                 }
 
                 // If the task runtime put us off schedule, skip the next task run.
-                if (now + period < std::chrono::steady_clock::now()) {
+                if (now + period < m_clock->steadyNow()) {
                     offSchedule = true;
                 } else {
                     offSchedule = false;
@@ -363,7 +377,7 @@ void Timer::callTask(
 
             case PeriodType::RELATIVE:
                 task();
-                now = std::chrono::steady_clock::now();
+                now = m_clock->steadyNow();
                 break;
         }
     }
@@ -0,0 +1,393 @@
+/*
+ * FeatureExtractor.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE__)
+#include <xmmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
+
+#include "AVSCommon/Utils/Audio/FeatureExtractor.h"
+#include "AVSCommon/Utils/Logger/Logger.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace audio {
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("FeatureExtractor");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+constexpr size_t AudioFeatures::NUM_BANDS;
+constexpr size_t FeatureExtractor::MIN_FRAME_SIZE;
+
+/// The factor scaling 16 bit samples to [-1, 1).
+static const float SAMPLE_SCALE = 1.0f / 32768.0f;
+
+/// Pi, to the precision of a double.
+static const double PI = 3.14159265358979323846;
+
+/// The number of floats the vector kernels work on at a time.
+static const size_t VECTOR_SIZE = 4;
+
+#if defined(__SSE__)
+
+/// Four floats in a register.
+using Vector = __m128;
+
+static inline Vector vectorLoad(const float* source) {
+    return _mm_loadu_ps(source);
+}
+
+static inline void vectorStore(float* destination, Vector value) {
+    _mm_storeu_ps(destination, value);
+}
+
+static inline Vector vectorSplat(float value) {
+    return _mm_set1_ps(value);
+}
+
+static inline Vector vectorAdd(Vector a, Vector b) {
+    return _mm_add_ps(a, b);
+}
+
+static inline Vector vectorSubtract(Vector a, Vector b) {
+    return _mm_sub_ps(a, b);
+}
+
+static inline Vector vectorMultiply(Vector a, Vector b) {
+    return _mm_mul_ps(a, b);
+}
+
+/// One for each negative lane, and zero for the others.
+static inline Vector vectorIsNegative(Vector a) {
+    return _mm_and_ps(_mm_cmplt_ps(a, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+}
+
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+
+/// Four floats in a register.
+using Vector = float32x4_t;
+
+static inline Vector vectorLoad(const float* source) {
+    return vld1q_f32(source);
+}
+
+static inline void vectorStore(float* destination, Vector value) {
+    vst1q_f32(destination, value);
+}
+
+static inline Vector vectorSplat(float value) {
+    return vdupq_n_f32(value);
+}
+
+static inline Vector vectorAdd(Vector a, Vector b) {
+    return vaddq_f32(a, b);
+}
+
+static inline Vector vectorSubtract(Vector a, Vector b) {
+    return vsubq_f32(a, b);
+}
+
+static inline Vector vectorMultiply(Vector a, Vector b) {
+    return vmulq_f32(a, b);
+}
+
+/// One for each negative lane, and zero for the others.
+static inline Vector vectorIsNegative(Vector a) {
+    return vreinterpretq_f32_u32(
+        vandq_u32(vcltq_f32(a, vdupq_n_f32(0.0f)), vreinterpretq_u32_f32(vdupq_n_f32(1.0f))));
+}
+
+#else
+
+/// Four floats, for platforms without a supported vector unit.
+struct Vector {
+    float lanes[VECTOR_SIZE];
+};
+
+static inline Vector vectorLoad(const float* source) {
+    return Vector{{source[0], source[1], source[2], source[3]}};
+}
+
+static inline void vectorStore(float* destination, Vector value) {
+    for (size_t i = 0; i < VECTOR_SIZE; ++i) {
+        destination[i] = value.lanes[i];
+    }
+}
+
+static inline Vector vectorSplat(float value) {
+    return Vector{{value, value, value, value}};
+}
+
+static inline Vector vectorAdd(Vector a, Vector b) {
+    for (size_t i = 0; i < VECTOR_SIZE; ++i) {
+        a.lanes[i] += b.lanes[i];
+    }
+    return a;
+}
+
+static inline Vector vectorSubtract(Vector a, Vector b) {
+    for (size_t i = 0; i < VECTOR_SIZE; ++i) {
+        a.lanes[i] -= b.lanes[i];
+    }
+    return a;
+}
+
+static inline Vector vectorMultiply(Vector a, Vector b) {
+    for (size_t i = 0; i < VECTOR_SIZE; ++i) {
+        a.lanes[i] *= b.lanes[i];
+    }
+    return a;
+}
+
+/// One for each negative lane, and zero for the others.
+static inline Vector vectorIsNegative(Vector a) {
+    for (size_t i = 0; i < VECTOR_SIZE; ++i) {
+        a.lanes[i] = a.lanes[i] < 0.0f ? 1.0f : 0.0f;
+    }
+    return a;
+}
+
+#endif
+
+/**
+ * Add up the lanes of a vector.
+ *
+ * @param value The vector.
+ * @return The sum of its lanes.
+ */
+static inline float vectorSum(Vector value) {
+    float lanes[VECTOR_SIZE];
+    vectorStore(lanes, value);
+    return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+}
+
+/**
+ * Convert a frequency to the mel scale.
+ *
+ * @param hz The frequency in Hz.
+ * @return The frequency in mel.
+ */
+static double hzToMel(double hz) {
+    return 2595.0 * std::log10(1.0 + hz / 700.0);
+}
+
+/**
+ * Convert a frequency from the mel scale.
+ *
+ * @param mel The frequency in mel.
+ * @return The frequency in Hz.
+ */
+static double melToHz(double mel) {
+    return 700.0 * (std::pow(10.0, mel / 2595.0) - 1.0);
+}
+
+std::unique_ptr<FeatureExtractor> FeatureExtractor::create(size_t frameSize, unsigned int sampleRateHz) {
+    if (frameSize < MIN_FRAME_SIZE || 0 != (frameSize & (frameSize - 1))) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "invalidFrameSize").d("frameSize", frameSize));
+        return nullptr;
+    }
+    if (0 == sampleRateHz) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "zeroSampleRate"));
+        return nullptr;
+    }
+    return std::unique_ptr<FeatureExtractor>(new FeatureExtractor(frameSize, sampleRateHz));
+}
+
+FeatureExtractor::FeatureExtractor(size_t frameSize, unsigned int sampleRateHz) :
+        m_frameSize{frameSize},
+        m_window(frameSize),
+        m_bitReversal(frameSize / 2),
+        m_samples(frameSize),
+        m_real(frameSize / 2),
+        m_imaginary(frameSize / 2),
+        m_powerSpectrum(frameSize / 2 + 1) {
+    // A periodic Hann window, which is what spectral analysis of a stream of overlapping frames calls for.
+    double sumOfSquares = 0.0;
+    for (size_t i = 0; i < frameSize; ++i) {
+        m_window[i] = static_cast<float>(0.5 - 0.5 * std::cos(2.0 * PI * i / frameSize));
+        sumOfSquares += m_window[i] * m_window[i];
+    }
+    // Half the power of a sine lands in the positive frequencies, spread by the window.
+    m_bandScale = static_cast<float>(2.0 / (frameSize * sumOfSquares));
+
+    // The real FFT of N samples is a complex FFT of N / 2 points, each pairing an even sample with the next odd one.
+    size_t numPoints = frameSize / 2;
+    size_t numBits = 0;
+    while ((static_cast<size_t>(1) << numBits) < numPoints) {
+        ++numBits;
+    }
+    for (size_t i = 0; i < numPoints; ++i) {
+        uint32_t reversed = 0;
+        for (size_t bit = 0; bit < numBits; ++bit) {
+            reversed |= ((i >> bit) & 1) << (numBits - 1 - bit);
+        }
+        m_bitReversal[i] = reversed;
+    }
+    for (size_t half = 1; half < numPoints; half *= 2) {
+        for (size_t i = 0; i < half; ++i) {
+            double angle = -PI * i / half;
+            m_twiddleReal.push_back(static_cast<float>(std::cos(angle)));
+            m_twiddleImaginary.push_back(static_cast<float>(std::sin(angle)));
+        }
+    }
+    for (size_t bin = 0; bin <= numPoints; ++bin) {
+        double angle = -2.0 * PI * bin / frameSize;
+        m_splitReal.push_back(static_cast<float>(std::cos(angle)));
+        m_splitImaginary.push_back(static_cast<float>(std::sin(angle)));
+    }
+
+    // Bands start above DC, end with the Nyquist bin, and are at least one bin wide.
+    double maxMel = hzToMel(sampleRateHz / 2.0);
+    size_t endBin = numPoints + 1;
+    m_bandEdges.push_back(1);
+    for (size_t band = 1; band < AudioFeatures::NUM_BANDS; ++band) {
+        double hz = melToHz(maxMel * band / AudioFeatures::NUM_BANDS);
+        auto bin = static_cast<size_t>(std::lround(hz * frameSize / sampleRateHz));
+        bin = std::max(bin, m_bandEdges.back() + 1);
+        bin = std::min(bin, endBin - (AudioFeatures::NUM_BANDS - band));
+        m_bandEdges.push_back(bin);
+    }
+    m_bandEdges.push_back(endBin);
+}
+
+void FeatureExtractor::extract(const int16_t* samples, AudioFeatures* features) {
+    if (!samples || !features) {
+        ACSDK_ERROR(LX("extractFailed").d("reason", "nullptr"));
+        return;
+    }
+    float* frame = m_samples.data();
+    for (size_t i = 0; i < m_frameSize; ++i) {
+        frame[i] = samples[i] * SAMPLE_SCALE;
+    }
+
+    // Energy and zero crossings are taken before windowing.  A crossing is a negative product of neighbours.
+    Vector energy = vectorSplat(0.0f);
+    Vector crossings = vectorSplat(0.0f);
+    size_t i = 0;
+    for (; i + VECTOR_SIZE < m_frameSize; i += VECTOR_SIZE) {
+        auto current = vectorLoad(frame + i);
+        energy = vectorAdd(energy, vectorMultiply(current, current));
+        crossings = vectorAdd(crossings, vectorIsNegative(vectorMultiply(current, vectorLoad(frame + i + 1))));
+    }
+    float totalEnergy = vectorSum(energy);
+    float totalCrossings = vectorSum(crossings);
+    for (; i < m_frameSize; ++i) {
+        totalEnergy += frame[i] * frame[i];
+        if (i + 1 < m_frameSize && frame[i] * frame[i + 1] < 0.0f) {
+            totalCrossings += 1.0f;
+        }
+    }
+    features->energy = totalEnergy / m_frameSize;
+    features->zeroCrossingRate = totalCrossings / (m_frameSize - 1);
+
+    for (i = 0; i < m_frameSize; i += VECTOR_SIZE) {
+        vectorStore(frame + i, vectorMultiply(vectorLoad(frame + i), vectorLoad(m_window.data() + i)));
+    }
+    size_t numPoints = m_frameSize / 2;
+    for (i = 0; i < numPoints; ++i) {
+        m_real[m_bitReversal[i]] = frame[2 * i];
+        m_imaginary[m_bitReversal[i]] = frame[2 * i + 1];
+    }
+    complexFft();
+
+    // Split the transform of the interleaved even and odd samples into the transform of the frame.
+    for (size_t bin = 0; bin <= numPoints; ++bin) {
+        size_t forward = bin % numPoints;
+        size_t mirrored = (numPoints - bin) % numPoints;
+        float evenReal = 0.5f * (m_real[forward] + m_real[mirrored]);
+        float evenImaginary = 0.5f * (m_imaginary[forward] - m_imaginary[mirrored]);
+        float oddReal = 0.5f * (m_imaginary[forward] + m_imaginary[mirrored]);
+        float oddImaginary = -0.5f * (m_real[forward] - m_real[mirrored]);
+        float real = evenReal + m_splitReal[bin] * oddReal - m_splitImaginary[bin] * oddImaginary;
+        float imaginary = evenImaginary + m_splitReal[bin] * oddImaginary + m_splitImaginary[bin] * oddReal;
+        m_powerSpectrum[bin] = real * real + imaginary * imaginary;
+    }
+
+    for (size_t band = 0; band < AudioFeatures::NUM_BANDS; ++band) {
+        float bandEnergy = 0.0f;
+        for (size_t bin = m_bandEdges[band]; bin < m_bandEdges[band + 1]; ++bin) {
+            bandEnergy += m_powerSpectrum[bin];
+        }
+        features->bandEnergies[band] = bandEnergy * m_bandScale;
+    }
+    features->isValid = 1;
+}
+
+const std::vector<float>& FeatureExtractor::getPowerSpectrum() const {
+    return m_powerSpectrum;
+}
+
+size_t FeatureExtractor::getFrameSize() const {
+    return m_frameSize;
+}
+
+void FeatureExtractor::complexFft() {
+    size_t numPoints = m_frameSize / 2;
+    float* real = m_real.data();
+    float* imaginary = m_imaginary.data();
+    // The twiddles of the stage combining transforms of size half start at half - 1.
+    for (size_t half = 1; half < numPoints; half *= 2) {
+        const float* twiddleReal = m_twiddleReal.data() + half - 1;
+        const float* twiddleImaginary = m_twiddleImaginary.data() + half - 1;
+        for (size_t group = 0; group < numPoints; group += 2 * half) {
+            float* topReal = real + group;
+            float* topImaginary = imaginary + group;
+            float* bottomReal = topReal + half;
+            float* bottomImaginary = topImaginary + half;
+            size_t i = 0;
+            for (; i + VECTOR_SIZE <= half; i += VECTOR_SIZE) {
+                auto xReal = vectorLoad(bottomReal + i);
+                auto xImaginary = vectorLoad(bottomImaginary + i);
+                auto wReal = vectorLoad(twiddleReal + i);
+                auto wImaginary = vectorLoad(twiddleImaginary + i);
+                auto tReal = vectorSubtract(vectorMultiply(xReal, wReal), vectorMultiply(xImaginary, wImaginary));
+                auto tImaginary = vectorAdd(vectorMultiply(xReal, wImaginary), vectorMultiply(xImaginary, wReal));
+                auto yReal = vectorLoad(topReal + i);
+                auto yImaginary = vectorLoad(topImaginary + i);
+                vectorStore(bottomReal + i, vectorSubtract(yReal, tReal));
+                vectorStore(bottomImaginary + i, vectorSubtract(yImaginary, tImaginary));
+                vectorStore(topReal + i, vectorAdd(yReal, tReal));
+                vectorStore(topImaginary + i, vectorAdd(yImaginary, tImaginary));
+            }
+            for (; i < half; ++i) {
+                float tReal = bottomReal[i] * twiddleReal[i] - bottomImaginary[i] * twiddleImaginary[i];
+                float tImaginary = bottomReal[i] * twiddleImaginary[i] + bottomImaginary[i] * twiddleReal[i];
+                bottomReal[i] = topReal[i] - tReal;
+                bottomImaginary[i] = topImaginary[i] - tImaginary;
+                topReal[i] += tReal;
+                topImaginary[i] += tImaginary;
+            }
+        }
+    }
+}
+
+}  // namespace audio
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
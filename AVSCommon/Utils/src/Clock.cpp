@@ -0,0 +1,70 @@
+/*
+ * Clock.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "AVSCommon/Utils/Timing/Clock.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace timing {
+
+/// Mutex serializing access to the default clock.
+static std::mutex defaultClockMutex;
+
+/// The clock set with @c Clock::setDefault(), or @c nullptr to use the @c SystemClock.
+static std::shared_ptr<Clock> defaultClock;
+
+/**
+ * Get the process wide @c SystemClock.
+ *
+ * @return The process wide @c SystemClock.
+ */
+static std::shared_ptr<Clock> getSystemClock() {
+    static std::shared_ptr<Clock> systemClock = std::make_shared<SystemClock>();
+    return systemClock;
+}
+
+std::shared_ptr<Clock> Clock::getDefault() {
+    std::lock_guard<std::mutex> lock(defaultClockMutex);
+    return defaultClock ? defaultClock : getSystemClock();
+}
+
+void Clock::setDefault(std::shared_ptr<Clock> clock) {
+    std::lock_guard<std::mutex> lock(defaultClockMutex);
+    defaultClock = clock;
+}
+
+Clock::SteadyTimePoint SystemClock::steadyNow() {
+    return std::chrono::steady_clock::now();
+}
+
+Clock::SystemTimePoint SystemClock::systemNow() {
+    return std::chrono::system_clock::now();
+}
+
+bool SystemClock::waitUntil(
+    std::condition_variable& condition,
+    std::unique_lock<std::mutex>& lock,
+    SteadyTimePoint deadline,
+    std::function<bool()> predicate) {
+    return condition.wait_until(lock, deadline, predicate);
+}
+
+}  // namespace timing
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
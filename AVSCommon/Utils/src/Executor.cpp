@@ -15,6 +15,10 @@
  * permissions and limitations under the License.
  */
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 #include "AVSCommon/Utils/Memory/Memory.h"
 #include "AVSCommon/Utils/Threading/Executor.h"
 
@@ -23,10 +27,147 @@ namespace avsCommon {
 namespace utils {
 namespace threading {
 
-Executor::Executor() :
-        m_taskQueue{std::make_shared<TaskQueue>()},
-        m_taskThread{memory::make_unique<TaskThread>(m_taskQueue)} {
-    m_taskThread->start();
+/**
+ * The most tasks a @c PooledTaskRunner runs each time it borrows a pool thread, so that an Executor with a long queue
+ * does not keep other Executors sharing the pool waiting.
+ */
+static const int MAX_TASKS_PER_TURN = 16;
+
+class Executor::PooledTaskRunner : public std::enable_shared_from_this<PooledTaskRunner> {
+public:
+    /**
+     * Constructor.
+     *
+     * @param taskQueue The queue of tasks to run.
+     * @param threadPool The pool to run the tasks on.
+     */
+    PooledTaskRunner(std::shared_ptr<TaskQueue> taskQueue, std::shared_ptr<ThreadPool> threadPool);
+
+    /// Make sure a turn is scheduled on the pool to run the tasks in the queue.
+    void schedule();
+
+    /**
+     * Wait for the current turn (if any) to finish.  Must be called after shutting down the queue, so that no further
+     * tasks start.  Does not wait if called from a task of this runner.
+     */
+    void waitForTurnToFinish();
+
+private:
+    /// Run up to @c MAX_TASKS_PER_TURN tasks from the queue on the calling pool thread.
+    void runTurn();
+
+    /// The queue of tasks to run.
+    std::shared_ptr<TaskQueue> m_taskQueue;
+
+    /**
+     * The pool to run tasks on.  This is weak so that a turn queued on the pool does not keep the pool alive, which
+     * could otherwise leave a pool thread releasing the last reference to its own pool.
+     */
+    std::weak_ptr<ThreadPool> m_threadPool;
+
+    /// Mutex serializing access to the members below.
+    std::mutex m_mutex;
+
+    /// Notified when a turn finishes.
+    std::condition_variable m_turnFinished;
+
+    /// Whether a turn has been posted to the pool and has not finished yet.
+    bool m_isScheduled;
+
+    /// The pool thread running a turn, or a default constructed id if no turn is running.
+    std::thread::id m_runningThread;
+};
+
+Executor::PooledTaskRunner::PooledTaskRunner(
+    std::shared_ptr<TaskQueue> taskQueue,
+    std::shared_ptr<ThreadPool> threadPool) :
+        m_taskQueue{taskQueue},
+        m_threadPool{threadPool},
+        m_isScheduled{false} {
+}
+
+void Executor::PooledTaskRunner::schedule() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_isScheduled) {
+            // The turn re-checks the queue before it finishes, so it will pick up the new task.
+            return;
+        }
+        m_isScheduled = true;
+    }
+    auto threadPool = m_threadPool.lock();
+    if (threadPool) {
+        auto self = shared_from_this();
+        threadPool->post([self] { self->runTurn(); });
+    }
+}
+
+void Executor::PooledTaskRunner::waitForTurnToFinish() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_turnFinished.wait(lock, [this] {
+        return std::thread::id() == m_runningThread || std::this_thread::get_id() == m_runningThread;
+    });
+}
+
+void Executor::PooledTaskRunner::runTurn() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_runningThread = std::this_thread::get_id();
+    }
+    for (int i = 0; i < MAX_TASKS_PER_TURN; ++i) {
+        auto task = m_taskQueue->tryPop();
+        if (!task) {
+            break;
+        }
+        task->operator()();
+    }
+    bool reschedule = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_runningThread = std::thread::id();
+        reschedule = !m_taskQueue->isShutdown() && !m_taskQueue->isEmpty();
+        m_isScheduled = reschedule;
+    }
+    m_turnFinished.notify_all();
+    if (reschedule) {
+        // Go to the back of the pool's queue, behind the other Executors sharing it.
+        auto threadPool = m_threadPool.lock();
+        if (threadPool) {
+            auto self = shared_from_this();
+            threadPool->post([self] { self->runTurn(); });
+        }
+    }
+}
+
+Executor::Executor(std::shared_ptr<ThreadPool> threadPool) : m_taskQueue{std::make_shared<TaskQueue>()} {
+    start(threadPool);
+}
+
+Executor::Executor(ThreadPolicy threadPolicy) : m_taskQueue{std::make_shared<TaskQueue>()} {
+    if (ThreadPolicy::DEDICATED == threadPolicy) {
+        m_taskThread = memory::make_unique<TaskThread>(m_taskQueue);
+        m_taskThread->start();
+    } else {
+        start(nullptr);
+    }
+}
+
+Executor::Executor(size_t capacity, TaskQueue::OverloadPolicy overloadPolicy, std::shared_ptr<ThreadPool> threadPool) :
+        m_taskQueue{std::make_shared<TaskQueue>(capacity, overloadPolicy)} {
+    start(threadPool);
+}
+
+void Executor::start(std::shared_ptr<ThreadPool> threadPool) {
+    if (!threadPool) {
+        threadPool = ThreadPool::getDefault();
+    }
+    if (threadPool) {
+        m_threadPool = threadPool;
+        m_pooledTaskRunner = std::make_shared<PooledTaskRunner>(m_taskQueue, threadPool);
+    } else {
+        m_taskThread = memory::make_unique<TaskThread>(m_taskQueue);
+        m_taskThread->start();
+    }
 }
 
 Executor::~Executor() {
@@ -34,22 +175,37 @@ Executor::~Executor() {
 }
 
 void Executor::waitForSubmittedTasks() {
-    std::promise<void> flushedPromise;
-    auto flushedFuture = flushedPromise.get_future();
-    auto task = [&flushedPromise]() { flushedPromise.set_value(); };
-    submit(task);
-    flushedFuture.get();
+    // The marker task must not be refused by a full queue.  If it is dropped later to make room, the tasks submitted
+    // before it have all been run or dropped too, and its future is fulfilled with an error.
+    auto flushedFuture = m_taskQueue->pushPastCapacity([] {});
+    onTaskSubmitted();
+    if (flushedFuture.valid()) {
+        flushedFuture.wait();
+    }
 }
 
 void Executor::shutdown() {
     m_taskQueue->shutdown();
+    if (m_pooledTaskRunner) {
+        m_pooledTaskRunner->waitForTurnToFinish();
+    }
     m_taskThread.reset();
 }
 
+void Executor::onTaskSubmitted() {
+    if (m_pooledTaskRunner) {
+        m_pooledTaskRunner->schedule();
+    }
+}
+
 bool Executor::isShutdown() {
     return m_taskQueue->isShutdown();
 }
 
+TaskQueue::OverloadCounters Executor::getOverloadCounters() {
+    return m_taskQueue->getOverloadCounters();
+}
+
 }  // namespace threading
 }  // namespace utils
 }  // namespace avsCommon
@@ -35,6 +35,9 @@ static const std::string TAG("CurlMultiHandleWrapper");
  */
 #define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
 
+/// Whether @c libcurl has @c curl_multi_poll() and @c curl_multi_wakeup(), which were added in 7.68.0.
+#define HAS_CURL_MULTI_WAKEUP (LIBCURL_VERSION_NUM >= 0x074400)
+
 std::unique_ptr<CurlMultiHandleWrapper> CurlMultiHandleWrapper::create() {
     auto handle = curl_multi_init();
     if (!handle) {
@@ -96,13 +99,34 @@ CURLMcode CurlMultiHandleWrapper::perform(int* runningHandles) {
 }
 
 CURLMcode CurlMultiHandleWrapper::wait(std::chrono::milliseconds timeout, int* countHandlesUpdated) {
+#if HAS_CURL_MULTI_WAKEUP
+    // Unlike curl_multi_wait(), curl_multi_poll() can be woken by curl_multi_wakeup().
+    auto result = curl_multi_poll(m_handle, NULL, 0, timeout.count(), countHandlesUpdated);
+#else
     auto result = curl_multi_wait(m_handle, NULL, 0, timeout.count(), countHandlesUpdated);
+#endif
     if (result != CURLM_OK) {
         ACSDK_ERROR(LX("curlMultiWaitFailed").d("error", curl_multi_strerror(result)));
     }
     return result;
 }
 
+CURLMcode CurlMultiHandleWrapper::wakeup() {
+#if HAS_CURL_MULTI_WAKEUP
+    auto result = curl_multi_wakeup(m_handle);
+    if (result != CURLM_OK) {
+        ACSDK_ERROR(LX("curlMultiWakeupFailed").d("error", curl_multi_strerror(result)));
+    }
+    return result;
+#else
+    return CURLM_OK;
+#endif
+}
+
+bool CurlMultiHandleWrapper::isWakeupSupported() {
+    return HAS_CURL_MULTI_WAKEUP;
+}
+
 CURLMsg* CurlMultiHandleWrapper::infoRead(int* messagesInQueue) {
     return curl_multi_info_read(m_handle, messagesInQueue);
 }
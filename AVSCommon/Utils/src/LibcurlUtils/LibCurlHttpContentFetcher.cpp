@@ -223,6 +223,26 @@ std::unique_ptr<avsCommon::utils::HTTPContent> LibCurlHttpContentFetcher::getCon
         avsCommon::utils::HTTPContent{std::move(httpStatusCodeFuture), std::move(contentTypeFuture), stream});
 }
 
+std::unique_ptr<avsCommon::utils::HTTPContent> LibCurlHttpContentFetcher::getContentInRange(
+    size_t firstByte,
+    size_t lastByte) {
+    if (lastByte < firstByte) {
+        ACSDK_ERROR(LX("getContentInRangeFailed").d("reason", "invalidRange").d("first", firstByte).d("last", lastByte));
+        return nullptr;
+    }
+    std::string range = std::to_string(firstByte) + "-";
+    if (lastByte != END_OF_BODY) {
+        range += std::to_string(lastByte);
+    }
+    auto curlReturnValue = curl_easy_setopt(m_curlWrapper.getCurlHandle(), CURLOPT_RANGE, range.c_str());
+    if (curlReturnValue != CURLE_OK) {
+        ACSDK_ERROR(LX("getContentInRangeFailed").d("reason", "setRangeFailed").d("range", range));
+        return nullptr;
+    }
+    ACSDK_DEBUG9(LX("getContentInRange").d("range", range).sensitive("url", m_url));
+    return getContent(FetchOptions::ENTIRE_BODY);
+}
+
 LibCurlHttpContentFetcher::~LibCurlHttpContentFetcher() {
     m_shuttingDown = true;
     if (m_thread.joinable()) {
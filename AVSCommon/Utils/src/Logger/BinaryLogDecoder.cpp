@@ -0,0 +1,272 @@
+/*
+ * BinaryLogDecoder.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "AVSCommon/Utils/Logger/BinaryLogDecoder.h"
+#include "AVSCommon/Utils/Logger/BinaryLogger.h"
+#include "AVSCommon/Utils/Logger/LoggerUtils.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace logger {
+
+/// The maximum number of bytes in a varint encoding a 64 bit value.
+static const int MAX_VARINT_SIZE = 10;
+
+/// The maximum size of a string in a log, to reject corrupt lengths before allocating.
+static const uint64_t MAX_STRING_SIZE = 1024 * 1024;
+
+/// The decoded contents of a @c FORMAT record.
+struct DecodedFormat {
+    /// The name of the source of entries of the format.
+    std::string source;
+
+    /// The name of the event of entries of the format.
+    std::string event;
+
+    /// The keys of the values of entries of the format.
+    std::vector<std::string> keys;
+};
+
+/**
+ * Read a varint.
+ *
+ * @param input The stream to read from.
+ * @param [out] value The value read.
+ * @return Whether a value was read.
+ */
+static bool readVarint(std::istream& input, uint64_t* value) {
+    *value = 0;
+    for (int i = 0; i < MAX_VARINT_SIZE; ++i) {
+        auto byte = input.get();
+        if (std::istream::traits_type::eof() == byte) {
+            return false;
+        }
+        *value |= static_cast<uint64_t>(byte & 0x7f) << (7 * i);
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Read a zigzag encoded varint.
+ *
+ * @param input The stream to read from.
+ * @param [out] value The value read.
+ * @return Whether a value was read.
+ */
+static bool readSignedVarint(std::istream& input, int64_t* value) {
+    uint64_t encoded;
+    if (!readVarint(input, &encoded)) {
+        return false;
+    }
+    *value = static_cast<int64_t>(encoded >> 1) ^ -static_cast<int64_t>(encoded & 1);
+    return true;
+}
+
+/**
+ * Read a string.
+ *
+ * @param input The stream to read from.
+ * @param [out] value The value read.
+ * @return Whether a value was read.
+ */
+static bool readString(std::istream& input, std::string* value) {
+    uint64_t size;
+    if (!readVarint(input, &size) || size > MAX_STRING_SIZE) {
+        return false;
+    }
+    value->resize(static_cast<size_t>(size));
+    return size == 0 || input.read(&(*value)[0], size);
+}
+
+/**
+ * Read a value of an @c ENTRY record and add it to a @c LogEntry.
+ *
+ * @param input The stream to read from.
+ * @param key The key of the value.
+ * @param entry The entry to add the value to.
+ * @return Whether a value was read.
+ */
+static bool readValue(std::istream& input, const char* key, LogEntry* entry) {
+    auto type = input.get();
+    switch (static_cast<BinaryLogger::ValueType>(type)) {
+        case BinaryLogger::ValueType::SIGNED: {
+            int64_t value;
+            if (!readSignedVarint(input, &value)) {
+                return false;
+            }
+            entry->d(key, value);
+            return true;
+        }
+        case BinaryLogger::ValueType::UNSIGNED: {
+            uint64_t value;
+            if (!readVarint(input, &value)) {
+                return false;
+            }
+            entry->d(key, value);
+            return true;
+        }
+        case BinaryLogger::ValueType::DOUBLE: {
+            unsigned char bytes[sizeof(uint64_t)];
+            if (!input.read(reinterpret_cast<char*>(bytes), sizeof(bytes))) {
+                return false;
+            }
+            uint64_t bits = 0;
+            for (size_t i = 0; i < sizeof(bits); ++i) {
+                bits |= static_cast<uint64_t>(bytes[i]) << (i * 8);
+            }
+            double value;
+            std::memcpy(&value, &bits, sizeof(value));
+            entry->d(key, value);
+            return true;
+        }
+        case BinaryLogger::ValueType::BOOL_FALSE:
+            entry->d(key, false);
+            return true;
+        case BinaryLogger::ValueType::BOOL_TRUE:
+            entry->d(key, true);
+            return true;
+        case BinaryLogger::ValueType::STRING: {
+            std::string value;
+            if (!readString(input, &value)) {
+                return false;
+            }
+            entry->d(key, value);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool BinaryLogDecoder::decode(std::istream& input, std::ostream& output) {
+    std::string magic(BinaryLogger::MAGIC.size(), '\0');
+    if (!input.read(&magic[0], magic.size()) || magic != BinaryLogger::MAGIC) {
+        std::cerr << "BinaryLogDecoder:decodeFailed:reason=badMagic" << std::endl;
+        return false;
+    }
+
+    std::unordered_map<uint64_t, DecodedFormat> formats;
+    std::unordered_map<uint64_t, std::string> threadMonikers;
+    int64_t timeMicros = 0;
+    while (true) {
+        auto type = input.get();
+        if (std::istream::traits_type::eof() == type) {
+            return true;
+        }
+        switch (static_cast<BinaryLogger::RecordType>(type)) {
+            case BinaryLogger::RecordType::FORMAT: {
+                uint64_t id;
+                uint64_t numKeys;
+                DecodedFormat format;
+                if (!readVarint(input, &id) || !readString(input, &format.source) ||
+                    !readString(input, &format.event) || !readVarint(input, &numKeys)) {
+                    std::cerr << "BinaryLogDecoder:decodeFailed:reason=truncatedFormat" << std::endl;
+                    return false;
+                }
+                for (uint64_t i = 0; i < numKeys; ++i) {
+                    std::string key;
+                    if (!readString(input, &key)) {
+                        std::cerr << "BinaryLogDecoder:decodeFailed:reason=truncatedFormat" << std::endl;
+                        return false;
+                    }
+                    format.keys.push_back(key);
+                }
+                formats[id] = format;
+                break;
+            }
+            case BinaryLogger::RecordType::THREAD: {
+                uint64_t index;
+                std::string moniker;
+                if (!readVarint(input, &index) || !readString(input, &moniker)) {
+                    std::cerr << "BinaryLogDecoder:decodeFailed:reason=truncatedThread" << std::endl;
+                    return false;
+                }
+                threadMonikers[index] = moniker;
+                break;
+            }
+            case BinaryLogger::RecordType::ENTRY:
+            case BinaryLogger::RecordType::TEXT: {
+                auto level = input.get();
+                int64_t timeDelta;
+                uint64_t threadIndex;
+                if (std::istream::traits_type::eof() == level || !readSignedVarint(input, &timeDelta) ||
+                    !readVarint(input, &threadIndex)) {
+                    std::cerr << "BinaryLogDecoder:decodeFailed:reason=truncatedEntry" << std::endl;
+                    return false;
+                }
+                timeMicros += timeDelta;
+                std::chrono::system_clock::time_point time{
+                    std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                        std::chrono::microseconds(timeMicros))};
+                auto moniker = threadMonikers[threadIndex];
+
+                if (BinaryLogger::RecordType::TEXT == static_cast<BinaryLogger::RecordType>(type)) {
+                    std::string text;
+                    if (!readString(input, &text)) {
+                        std::cerr << "BinaryLogDecoder:decodeFailed:reason=truncatedText" << std::endl;
+                        return false;
+                    }
+                    output << formatLogString(static_cast<Level>(level), time, moniker.c_str(), text.c_str())
+                           << "\n";
+                    break;
+                }
+
+                uint64_t id;
+                uint64_t numValues;
+                if (!readVarint(input, &id) || !readVarint(input, &numValues)) {
+                    std::cerr << "BinaryLogDecoder:decodeFailed:reason=truncatedEntry" << std::endl;
+                    return false;
+                }
+                auto it = formats.find(id);
+                if (it == formats.end()) {
+                    std::cerr << "BinaryLogDecoder:decodeFailed:reason=undefinedFormat,id=" << id << std::endl;
+                    return false;
+                }
+                const auto& format = it->second;
+                LogEntry entry(format.source, format.event);
+                for (uint64_t i = 0; i < numValues; ++i) {
+                    // Tolerate call sites passing more values than their format has keys.
+                    auto key = i < format.keys.size() ? format.keys[i] : "value" + std::to_string(i);
+                    if (!readValue(input, key.c_str(), &entry)) {
+                        std::cerr << "BinaryLogDecoder:decodeFailed:reason=badValue" << std::endl;
+                        return false;
+                    }
+                }
+                output << formatLogString(static_cast<Level>(level), time, moniker.c_str(), entry.c_str())
+                       << "\n";
+                break;
+            }
+            default:
+                std::cerr << "BinaryLogDecoder:decodeFailed:reason=unknownRecordType,type=" << type << std::endl;
+                return false;
+        }
+    }
+}
+
+}  // namespace logger
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
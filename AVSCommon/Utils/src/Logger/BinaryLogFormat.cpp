@@ -0,0 +1,67 @@
+/*
+ * BinaryLogFormat.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <atomic>
+
+#include "AVSCommon/Utils/Logger/BinaryLogFormat.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace logger {
+
+/**
+ * Allocates the next format id.  The counter is a function static so that formats defined during static
+ * initialization of any module can be registered, regardless of initialization order.
+ *
+ * @return A format id which has not been allocated before.
+ */
+static uint32_t allocateFormatId() {
+    static std::atomic<uint32_t> nextId{0};
+    return nextId++;
+}
+
+BinaryLogFormat::BinaryLogFormat(
+    const std::string& source,
+    const std::string& event,
+    std::initializer_list<const char*> keys) :
+        m_id{allocateFormatId()},
+        m_source{source},
+        m_event{event},
+        m_keys{keys.begin(), keys.end()} {
+}
+
+uint32_t BinaryLogFormat::getId() const {
+    return m_id;
+}
+
+const std::string& BinaryLogFormat::getSource() const {
+    return m_source;
+}
+
+const std::string& BinaryLogFormat::getEvent() const {
+    return m_event;
+}
+
+const std::vector<std::string>& BinaryLogFormat::getKeys() const {
+    return m_keys;
+}
+
+}  // namespace logger
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
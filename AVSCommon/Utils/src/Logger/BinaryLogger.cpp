@@ -0,0 +1,179 @@
+/*
+ * BinaryLogger.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <atomic>
+#include <iostream>
+
+#include "AVSCommon/Utils/Logger/BinaryLogger.h"
+#include "AVSCommon/Utils/Logger/ThreadMoniker.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace logger {
+
+const std::string BinaryLogger::MAGIC = "ACSDKBL1";
+
+const size_t BinaryLogger::MAX_THREAD_INDICES = 256;
+
+/**
+ * Allocates a thread index generation which has not been used by any @c BinaryLogger.
+ *
+ * @return The generation.
+ */
+static uint64_t allocateThreadIndicesGeneration() {
+    static std::atomic<uint64_t> nextGeneration{1};
+    return nextGeneration++;
+}
+
+/// The thread index most recently used by a thread, so that its next entry needs neither a lookup nor a copy.
+struct CachedThreadIndex {
+    /// The generation of thread indices @c index belongs to, or zero if nothing is cached.
+    uint64_t generation = 0;
+
+    /// The moniker the thread logged with.
+    std::string moniker;
+
+    /// The index of the thread.
+    uint32_t index = 0;
+};
+
+/// The thread index most recently used by this thread.
+static thread_local CachedThreadIndex cachedThreadIndex;
+
+std::shared_ptr<BinaryLogger> BinaryLogger::create(std::shared_ptr<std::ostream> stream, Level level) {
+    if (!stream) {
+        // Logging about a failure to create a logger through that logger is not possible, so use std::cerr.
+        std::cerr << "BinaryLogger::createFailed:reason=nullStream" << std::endl;
+        return nullptr;
+    }
+    std::shared_ptr<BinaryLogger> logger(new BinaryLogger(stream, level));
+    stream->write(MAGIC.data(), MAGIC.size());
+    if (!*stream) {
+        std::cerr << "BinaryLogger::createFailed:reason=writeMagicFailed" << std::endl;
+        return nullptr;
+    }
+    return logger;
+}
+
+BinaryLogger::~BinaryLogger() {
+    flush();
+}
+
+BinaryLogger::BinaryLogger(std::shared_ptr<std::ostream> stream, Level level) :
+        Logger(level),
+        m_stream{stream},
+        m_threadIndicesGeneration{allocateThreadIndicesGeneration()},
+        m_previousTimeMicros{0} {
+}
+
+void BinaryLogger::emit(
+    Level level,
+    std::chrono::system_clock::time_point time,
+    const char* threadMoniker,
+    const char* text) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_record.clear();
+    appendEntryHeaderLocked(RecordType::TEXT, level, time, threadMoniker);
+    appendString(text, std::strlen(text), &m_record);
+    writeRecordLocked(level);
+}
+
+void BinaryLogger::flush() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stream->flush();
+}
+
+void BinaryLogger::writeEntry(
+    Level level,
+    std::chrono::system_clock::time_point time,
+    const BinaryLogFormat& format,
+    size_t numValues,
+    const std::string& values) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_record.clear();
+    auto id = format.getId();
+    if (id >= m_definedFormats.size()) {
+        m_definedFormats.resize(id + 1, false);
+    }
+    if (!m_definedFormats[id]) {
+        m_record.push_back(static_cast<char>(RecordType::FORMAT));
+        appendVarint(id, &m_record);
+        appendString(format.getSource().data(), format.getSource().size(), &m_record);
+        appendString(format.getEvent().data(), format.getEvent().size(), &m_record);
+        appendVarint(format.getKeys().size(), &m_record);
+        for (const auto& key : format.getKeys()) {
+            appendString(key.data(), key.size(), &m_record);
+        }
+        m_definedFormats[id] = true;
+    }
+    appendEntryHeaderLocked(RecordType::ENTRY, level, time, ThreadMoniker::getThisThreadMoniker().c_str());
+    // The format id goes after the shared header so that ENTRY and TEXT records only differ in their tail.
+    appendVarint(id, &m_record);
+    appendVarint(numValues, &m_record);
+    m_record.append(values);
+    writeRecordLocked(level);
+}
+
+void BinaryLogger::appendEntryHeaderLocked(
+    RecordType type,
+    Level level,
+    std::chrono::system_clock::time_point time,
+    const char* threadMoniker) {
+    auto threadIndex = getThreadIndexLocked(threadMoniker);
+    int64_t timeMicros = std::chrono::duration_cast<std::chrono::microseconds>(time.time_since_epoch()).count();
+    m_record.push_back(static_cast<char>(type));
+    m_record.push_back(static_cast<char>(level));
+    appendSignedVarint(timeMicros - m_previousTimeMicros, &m_record);
+    appendVarint(threadIndex, &m_record);
+    m_previousTimeMicros = timeMicros;
+}
+
+uint32_t BinaryLogger::getThreadIndexLocked(const char* threadMoniker) {
+    if (cachedThreadIndex.generation == m_threadIndicesGeneration && cachedThreadIndex.moniker == threadMoniker) {
+        return cachedThreadIndex.index;
+    }
+    auto it = m_threadIndices.find(threadMoniker);
+    if (it == m_threadIndices.end()) {
+        if (m_threadIndices.size() >= MAX_THREAD_INDICES) {
+            // Start over, so that indices are reused.  Each is redefined before its next use.
+            m_threadIndices.clear();
+            m_threadIndicesGeneration = allocateThreadIndicesGeneration();
+        }
+        auto index = static_cast<uint32_t>(m_threadIndices.size());
+        it = m_threadIndices.insert({threadMoniker, index}).first;
+        m_record.push_back(static_cast<char>(RecordType::THREAD));
+        appendVarint(index, &m_record);
+        appendString(it->first.data(), it->first.size(), &m_record);
+    }
+    cachedThreadIndex.generation = m_threadIndicesGeneration;
+    cachedThreadIndex.moniker = it->first;
+    cachedThreadIndex.index = it->second;
+    return it->second;
+}
+
+void BinaryLogger::writeRecordLocked(Level level) {
+    m_stream->write(m_record.data(), m_record.size());
+    if (level >= Level::ERROR) {
+        m_stream->flush();
+    }
+}
+
+}  // namespace logger
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
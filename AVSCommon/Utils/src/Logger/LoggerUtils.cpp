@@ -15,32 +15,33 @@
  * permissions and limitations under the License.
  */
 
-#include <cstdio>
+#include <cstring>
 #include <iomanip>
 #include <iostream>
 
 #include "AVSCommon/Utils/Logger/LoggerUtils.h"
 #include "AVSCommon/Utils/Logger/Logger.h"
+#include "AVSCommon/Utils/Timing/TimeUtils.h"
 
 namespace alexaClientSDK {
 namespace avsCommon {
 namespace utils {
 namespace logger {
 
-/// Format string for strftime() to produce date and time in the format "YYYY-MM-DD HH:MM:SS".
-static const char* STRFTIME_FORMAT_STRING = "%Y-%m-%d %H:%M:%S";
-
 /// Size of buffer needed to hold "YYYY-MM-DD HH:MM:SS" and a null terminator.
-static const int DATE_AND_TIME_STRING_SIZE = 20;
+static const int DATE_AND_TIME_STRING_SIZE = timing::DATE_AND_TIME_STRING_LENGTH + 1;
+
+/// Separator between the date and the time in log lines.
+static const char DATE_AND_TIME_SEPARATOR = ' ';
+
+/// Text logged in place of the date and time if they can't be formatted.
+static const char* DATE_AND_TIME_FAILURE_STRING = "ERROR: Date and time out of range.  Date and time not logged.";
 
 /// Separator between date/time and millis.
 static const char TIME_AND_MILLIS_SEPARATOR = '.';
 
-// Format string for sprintf() to produce millis in the format "nnn".
-static const char* MILLIS_FORMAT_STRING = "%03d";
-
-/// Size of buffer needed to hold "nnn" (milliseconds value) and a null terminator
-static const int MILLIS_STRING_SIZE = 4;
+/// The number of digits of the milliseconds value in log lines.
+static const int MILLIS_STRING_LENGTH = 3;
 
 /// Separator string between milliseconds value and ExampleLogger name.
 static const std::string MILLIS_AND_THREAD_SEPARATOR = " [";
@@ -54,6 +55,45 @@ static const char LEVEL_AND_TEXT_SEPARATOR = ' ';
 /// Number of milliseconds per second.
 static const int MILLISECONDS_PER_SECOND = 1000;
 
+/**
+ * The date and time of the last second formatted by this thread.  Log lines come in bursts, so most of them fall in
+ * the same second as the line before and can reuse its date and time instead of formatting them again.
+ */
+struct CachedDateAndTime {
+    /// The Unix time of @c text.
+    int64_t unixTime;
+
+    /// Whether @c text holds the date and time of @c unixTime.
+    bool isValid;
+
+    /// The formatted date and time, null terminated.
+    char text[DATE_AND_TIME_STRING_SIZE];
+};
+
+/// The date and time of the last second formatted by this thread.
+static thread_local CachedDateAndTime cachedDateAndTime = {0, false, {}};
+
+/**
+ * Get the formatted UTC date and time of a Unix time, reusing the previous result on this thread if it was for the
+ * same second.
+ *
+ * @param unixTime The Unix time to format.
+ * @return The formatted date and time, which remains valid until the next call on this thread, or @c nullptr if
+ *     the time can't be formatted.
+ */
+static const char* getDateAndTimeString(int64_t unixTime) {
+    auto& cache = cachedDateAndTime;
+    if (!cache.isValid || cache.unixTime != unixTime) {
+        cache.isValid = timing::formatDateAndTime(unixTime, DATE_AND_TIME_SEPARATOR, cache.text);
+        cache.unixTime = unixTime;
+        cache.text[timing::DATE_AND_TIME_STRING_LENGTH] = '\0';
+        if (!cache.isValid) {
+            return nullptr;
+        }
+    }
+    return cache.text;
+}
+
 void acsdkDebug9(const LogEntry& entry) {
     logEntry(Level::DEBUG9, entry);
 }
@@ -124,29 +164,34 @@ std::string formatLogString(
     std::chrono::system_clock::time_point time,
     const char* threadMoniker,
     const char* text) {
-    bool dateTimeFailure = false;
-    bool millisecondFailure = false;
-    char dateTimeString[DATE_AND_TIME_STRING_SIZE];
-    auto timeAsTime_t = std::chrono::system_clock::to_time_t(time);
-    auto timeAsTmPtr = std::gmtime(&timeAsTime_t);
-    if (!timeAsTmPtr || 0 == strftime(dateTimeString, sizeof(dateTimeString), STRFTIME_FORMAT_STRING, timeAsTmPtr)) {
-        dateTimeFailure = true;
+    auto millisSinceEpoch = std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count();
+    auto millisPart = static_cast<int>(millisSinceEpoch % MILLISECONDS_PER_SECOND);
+    auto unixTime = static_cast<int64_t>(millisSinceEpoch / MILLISECONDS_PER_SECOND);
+    if (millisPart < 0) {
+        millisPart += MILLISECONDS_PER_SECOND;
+        --unixTime;
     }
-    auto timeMillisPart = static_cast<int>(
-        std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count() %
-        MILLISECONDS_PER_SECOND);
-    char millisString[MILLIS_STRING_SIZE];
-    if (std::snprintf(millisString, sizeof(millisString), MILLIS_FORMAT_STRING, timeMillisPart) < 0) {
-        millisecondFailure = true;
+    auto dateTimeString = getDateAndTimeString(unixTime);
+    char millisString[MILLIS_STRING_LENGTH];
+    for (int i = MILLIS_STRING_LENGTH - 1; i >= 0; --i) {
+        millisString[i] = static_cast<char>('0' + millisPart % 10);
+        millisPart /= 10;
     }
 
-    std::stringstream stringToEmit;
-    stringToEmit << (dateTimeFailure ? "ERROR: strftime() failed.  Date and time not logged." : dateTimeString)
-                 << TIME_AND_MILLIS_SEPARATOR
-                 << (millisecondFailure ? "ERROR: snprintf() failed.  Milliseconds not logged." : millisString)
-                 << MILLIS_AND_THREAD_SEPARATOR << threadMoniker << THREAD_AND_LEVEL_SEPARATOR
-                 << convertLevelToChar(level) << LEVEL_AND_TEXT_SEPARATOR << text;
-    return stringToEmit.str();
+    std::string stringToEmit;
+    stringToEmit.reserve(
+        DATE_AND_TIME_STRING_SIZE + MILLIS_STRING_LENGTH + MILLIS_AND_THREAD_SEPARATOR.length() +
+        std::strlen(threadMoniker) + THREAD_AND_LEVEL_SEPARATOR.length() + 2 + std::strlen(text));
+    stringToEmit.append(dateTimeString ? dateTimeString : DATE_AND_TIME_FAILURE_STRING);
+    stringToEmit.push_back(TIME_AND_MILLIS_SEPARATOR);
+    stringToEmit.append(millisString, MILLIS_STRING_LENGTH);
+    stringToEmit.append(MILLIS_AND_THREAD_SEPARATOR);
+    stringToEmit.append(threadMoniker);
+    stringToEmit.append(THREAD_AND_LEVEL_SEPARATOR);
+    stringToEmit.push_back(convertLevelToChar(level));
+    stringToEmit.push_back(LEVEL_AND_TEXT_SEPARATOR);
+    stringToEmit.append(text);
+    return stringToEmit;
 }
 
 void dumpBytesToStream(std::ostream& stream, const char* prefix, size_t width, const unsigned char* data, size_t size) {
@@ -36,6 +36,10 @@ const std::string Metrics::locationToString(Metrics::Location location) {
             return "AIP Receive";
         case AIP_SEND:
             return "AIP Send";
+        case KWD_DETECT:
+            return "KWD Detect";
+        case ACL_SEND_COMPLETE:
+            return "ACL Send Complete";
         case BUILDING_MESSAGE:
             return "Building Message";
     }
@@ -63,6 +67,34 @@ logger::LogEntry& Metrics::d(
     return logEntry;
 }
 
+logger::LogEntry& Metrics::d(
+    LogEntry& logEntry,
+    const std::string& name,
+    std::chrono::milliseconds captureLatency,
+    Location location) {
+    return logEntry.d("Location", locationToString(location))
+        .d("NAME", name)
+        .d("CaptureLatencyMs", captureLatency.count());
+}
+
+logger::LogEntry& Metrics::d(
+    LogEntry& logEntry,
+    const std::string& name,
+    const MessageRequestTimings& timings,
+    Location location) {
+    return logEntry.d("Location", locationToString(location))
+        .d("NAME", name)
+        .d("QueueWaitUs", timings.queueWait.count())
+        .d("NameLookupUs", timings.nameLookup.count())
+        .d("ConnectUs", timings.connect.count())
+        .d("AppConnectUs", timings.appConnect.count())
+        .d("StartTransferUs", timings.startTransfer.count())
+        .d("TotalUs", timings.total.count())
+        .d("AttachmentReadPausedUs", timings.attachmentReadPaused.count())
+        .d("BytesUp", timings.bytesUploaded)
+        .d("BytesDown", timings.bytesDownloaded);
+}
+
 }  // namespace utils
 }  // namespace avsCommon
 }  // namespace alexaClientSDK
@@ -0,0 +1,108 @@
+/*
+ * ReadinessNotifier.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <cerrno>
+#include <cstdint>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/eventfd.h>
+#endif
+
+#include "AVSCommon/Utils/Logger/Logger.h"
+#include "AVSCommon/Utils/SDS/ReadinessNotifier.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace sds {
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("ReadinessNotifier");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+std::shared_ptr<ReadinessNotifier> ReadinessNotifier::create() {
+#ifdef __linux__
+    int fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (fd < 0) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "eventfdFailed").d("errno", errno));
+        return nullptr;
+    }
+    return std::shared_ptr<ReadinessNotifier>(new ReadinessNotifier(fd, fd));
+#else
+    int fds[2];
+    if (pipe(fds) != 0) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "pipeFailed").d("errno", errno));
+        return nullptr;
+    }
+    for (auto fd : fds) {
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+    }
+    return std::shared_ptr<ReadinessNotifier>(new ReadinessNotifier(fds[0], fds[1]));
+#endif
+}
+
+ReadinessNotifier::ReadinessNotifier(int readFd, int writeFd) : m_readFd{readFd}, m_writeFd{writeFd} {
+}
+
+ReadinessNotifier::~ReadinessNotifier() {
+    ::close(m_readFd);
+    if (m_writeFd != m_readFd) {
+        ::close(m_writeFd);
+    }
+}
+
+int ReadinessNotifier::getFd() const {
+    return m_readFd;
+}
+
+void ReadinessNotifier::signal() {
+    // A full counter or pipe already reads as signalled, so EAGAIN is not an error.
+    uint64_t one = 1;
+    if (write(m_writeFd, &one, m_writeFd == m_readFd ? sizeof(one) : 1) < 0 && errno != EAGAIN) {
+        ACSDK_ERROR(LX("signalFailed").d("errno", errno));
+    }
+}
+
+void ReadinessNotifier::clear() {
+    uint64_t drain[8];
+    while (read(m_readFd, drain, sizeof(drain)) > 0 && m_readFd != m_writeFd) {
+    }
+}
+
+bool ReadinessNotifier::waitUntilSignalled(std::chrono::milliseconds timeout) {
+    struct pollfd pollFd = {m_readFd, POLLIN, 0};
+    int result = 0;
+    do {
+        result = poll(&pollFd, 1, static_cast<int>(timeout.count()));
+    } while (result < 0 && EINTR == errno);
+    return result > 0 && (pollFd.revents & POLLIN);
+}
+
+}  // namespace sds
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -0,0 +1,170 @@
+/*
+ * TimestampTrack.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <limits>
+
+#include "AVSCommon/Utils/Logger/Logger.h"
+#include "AVSCommon/Utils/SDS/TimestampTrack.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace sds {
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("TimestampTrack");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The slot number of a slot which has not been written.
+static const TimestampTrack::Index INVALID_SLOT = std::numeric_limits<TimestampTrack::Index>::max();
+
+/**
+ * Interpolate the time of an index between two known points.
+ *
+ * @param fromIndex The index of the first point.
+ * @param fromTime The time of the first point.
+ * @param toIndex The index of the second point, which must be greater than @c fromIndex.
+ * @param toTime The time of the second point.
+ * @param index The index to interpolate the time of.
+ * @return The interpolated time.
+ */
+static timing::Clock::SteadyTimePoint interpolate(
+    TimestampTrack::Index fromIndex,
+    timing::Clock::SteadyTimePoint fromTime,
+    TimestampTrack::Index toIndex,
+    timing::Clock::SteadyTimePoint toTime,
+    TimestampTrack::Index index) {
+    auto span = (toTime - fromTime).count();
+    auto offset = static_cast<double>(span) * (index - fromIndex) / (toIndex - fromIndex);
+    using Duration = timing::Clock::SteadyTimePoint::duration;
+    return fromTime + Duration(static_cast<Duration::rep>(offset));
+}
+
+std::shared_ptr<TimestampTrack> TimestampTrack::create(
+    size_t wordsPerSlot,
+    size_t numSlots,
+    std::shared_ptr<timing::Clock> clock) {
+    if (0 == wordsPerSlot) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "zeroWordsPerSlot"));
+        return nullptr;
+    }
+    if (numSlots < 2) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "tooFewSlots").d("numSlots", numSlots));
+        return nullptr;
+    }
+    if (!clock) {
+        clock = timing::Clock::getDefault();
+    }
+    return std::shared_ptr<TimestampTrack>(new TimestampTrack(wordsPerSlot, numSlots, clock));
+}
+
+TimestampTrack::TimestampTrack(size_t wordsPerSlot, size_t numSlots, std::shared_ptr<timing::Clock> clock) :
+        m_wordsPerSlot{wordsPerSlot},
+        m_clock{clock},
+        m_slots(numSlots, Slot{INVALID_SLOT, timing::Clock::SteadyTimePoint()}),
+        m_hasRecord{false},
+        m_lastIndex{0} {
+}
+
+void TimestampTrack::recordNow(Index endIndex) {
+    record(endIndex, m_clock->steadyNow());
+}
+
+void TimestampTrack::record(Index endIndex, timing::Clock::SteadyTimePoint time) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_hasRecord && (endIndex <= m_lastIndex || time < m_lastTime)) {
+        return;
+    }
+
+    // Fill in the slots between the last record and this one.  Before the first record, only this one is known.
+    Index firstSlotNumber = m_hasRecord ? m_lastIndex / m_wordsPerSlot + 1 : endIndex / m_wordsPerSlot;
+    Index lastSlotNumber = endIndex / m_wordsPerSlot;
+    if (lastSlotNumber >= m_slots.size() && firstSlotNumber < lastSlotNumber - m_slots.size() + 1) {
+        // Slots which would be overwritten within this record needn't be written.
+        firstSlotNumber = lastSlotNumber - m_slots.size() + 1;
+    }
+    for (Index slotNumber = firstSlotNumber; slotNumber <= lastSlotNumber; ++slotNumber) {
+        Index slotIndex = slotNumber * m_wordsPerSlot;
+        if (!m_hasRecord && slotIndex != endIndex) {
+            continue;
+        }
+        auto& slot = m_slots[slotNumber % m_slots.size()];
+        slot.slotNumber = slotNumber;
+        slot.time = (slotIndex == endIndex) ? time : interpolate(m_lastIndex, m_lastTime, endIndex, time, slotIndex);
+    }
+
+    m_hasRecord = true;
+    m_lastIndex = endIndex;
+    m_lastTime = time;
+}
+
+bool TimestampTrack::getTime(Index index, timing::Clock::SteadyTimePoint* time) const {
+    if (!time) {
+        ACSDK_ERROR(LX("getTimeFailed").d("reason", "nullTime"));
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_hasRecord || index > m_lastIndex) {
+        return false;
+    }
+    if (index == m_lastIndex) {
+        *time = m_lastTime;
+        return true;
+    }
+
+    Index slotNumber = index / m_wordsPerSlot;
+    auto from = getSlotLocked(slotNumber);
+    if (!from) {
+        return false;
+    }
+    Index fromIndex = slotNumber * m_wordsPerSlot;
+    if (index == fromIndex) {
+        *time = from->time;
+        return true;
+    }
+
+    // Interpolate towards the next slot, or towards the last record if the next slot has not been reached yet.
+    Index toIndex = m_lastIndex;
+    auto toTime = m_lastTime;
+    auto to = getSlotLocked(slotNumber + 1);
+    if (to) {
+        toIndex = (slotNumber + 1) * m_wordsPerSlot;
+        toTime = to->time;
+    }
+    *time = interpolate(fromIndex, from->time, toIndex, toTime, index);
+    return true;
+}
+
+std::shared_ptr<timing::Clock> TimestampTrack::getClock() const {
+    return m_clock;
+}
+
+const TimestampTrack::Slot* TimestampTrack::getSlotLocked(Index slotNumber) const {
+    auto& slot = m_slots[slotNumber % m_slots.size()];
+    return slot.slotNumber == slotNumber ? &slot : nullptr;
+}
+
+}  // namespace sds
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -0,0 +1,140 @@
+/*
+ * ShutdownOrchestrator.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "AVSCommon/Utils/Logger/Logger.h"
+#include "AVSCommon/Utils/ShutdownOrchestrator.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("ShutdownOrchestrator");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+struct ShutdownOrchestrator::State {
+    /// The stages of objects to shut down, in order.
+    std::vector<std::vector<std::shared_ptr<RequiresShutdown>>> stages;
+
+    /// Mutex serializing access to @c pendingNames and @c isDone.
+    std::mutex mutex;
+
+    /// Notified when every stage has been shut down.
+    std::condition_variable wakeOnDone;
+
+    /// The names of the objects of the current stage which are still shutting down.
+    std::multiset<std::string> pendingNames;
+
+    /// Whether every stage has been shut down.
+    bool isDone = false;
+};
+
+ShutdownOrchestrator::ShutdownOrchestrator(std::chrono::milliseconds deadline) : m_deadline{deadline} {
+}
+
+void ShutdownOrchestrator::addStage(const std::vector<std::shared_ptr<RequiresShutdown>>& objects) {
+    std::vector<std::shared_ptr<RequiresShutdown>> stage;
+    for (auto& object : objects) {
+        if (object) {
+            stage.push_back(object);
+        }
+    }
+    if (!stage.empty()) {
+        m_stages.push_back(std::move(stage));
+    }
+}
+
+bool ShutdownOrchestrator::shutdown() {
+    auto state = std::make_shared<State>();
+    state->stages.swap(m_stages);
+    auto start = std::chrono::steady_clock::now();
+    std::thread stagesThread(&ShutdownOrchestrator::shutdownStages, state);
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    bool isDoneBeforeDeadline = state->wakeOnDone.wait_for(lock, m_deadline, [&state] { return state->isDone; });
+    if (!isDoneBeforeDeadline) {
+        std::ostringstream pendingNames;
+        for (auto& name : state->pendingNames) {
+            pendingNames << name << ' ';
+        }
+        lock.unlock();
+        ACSDK_ERROR(LX("shutdownDeadlinePassed")
+                        .d("deadlineMs", m_deadline.count())
+                        .d("pending", pendingNames.str())
+                        .m("still waiting"));
+    } else {
+        lock.unlock();
+    }
+    stagesThread.join();
+    ACSDK_DEBUG(LX("shutdownDone")
+                    .d("durationMs",
+                       std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start)
+                           .count()));
+    return isDoneBeforeDeadline;
+}
+
+void ShutdownOrchestrator::shutdownStages(std::shared_ptr<State> state) {
+    for (auto& stage : state->stages) {
+        shutdownStage(state, stage);
+    }
+    std::lock_guard<std::mutex> lock(state->mutex);
+    state->isDone = true;
+    state->wakeOnDone.notify_all();
+}
+
+void ShutdownOrchestrator::shutdownStage(
+    std::shared_ptr<State> state,
+    const std::vector<std::shared_ptr<RequiresShutdown>>& stage) {
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        for (auto& object : stage) {
+            state->pendingNames.insert(object->name());
+        }
+    }
+    auto shutdownObject = [&state](const std::shared_ptr<RequiresShutdown>& object) {
+        object->shutdown();
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->pendingNames.erase(state->pendingNames.find(object->name()));
+    };
+
+    // The last object is shut down on this thread, which would otherwise only wait.
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i + 1 < stage.size(); ++i) {
+        threads.emplace_back(shutdownObject, stage[i]);
+    }
+    shutdownObject(stage.back());
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -16,17 +16,90 @@
  */
 
 #include "AVSCommon/Utils/Threading/TaskQueue.h"
+#include "AVSCommon/Utils/Threading/ThreadPool.h"
 
 namespace alexaClientSDK {
 namespace avsCommon {
 namespace utils {
 namespace threading {
 
-TaskQueue::TaskQueue() : m_shutdown{false} {
+const size_t TaskQueue::UNBOUNDED;
+
+TaskQueue::OverloadCounters::OverloadCounters() : pushesBlocked{0}, tasksDropped{0}, tasksCoalesced{0}, maxSize{0} {
+}
+
+TaskQueue::TaskQueue(size_t capacity, OverloadPolicy overloadPolicy) :
+        m_capacity{capacity},
+        m_overloadPolicy{overloadPolicy},
+        m_shutdown{false} {
+}
+
+bool TaskQueue::enqueue(Placement placement, const std::string& key, std::unique_ptr<std::function<void()>> task) {
+    // Declared before the lock, so that a task dropped to make room is destroyed after the lock is released.
+    std::unique_ptr<std::function<void()>> droppedTask;
+    std::unique_lock<std::mutex> queueLock{m_queueMutex};
+    if (m_shutdown) {
+        return false;
+    }
+
+    if (OverloadPolicy::COALESCE == m_overloadPolicy && !key.empty()) {
+        for (auto& queuedTask : m_queue) {
+            if (queuedTask.key == key) {
+                droppedTask = std::move(queuedTask.task);
+                queuedTask.task = std::move(task);
+                ++m_overloadCounters.tasksCoalesced;
+                return true;
+            }
+        }
+    }
+
+    if (Placement::BACK == placement && m_capacity != UNBOUNDED && m_queue.size() >= m_capacity) {
+        switch (m_overloadPolicy) {
+            case OverloadPolicy::BLOCK:
+            case OverloadPolicy::COALESCE:
+                if (std::this_thread::get_id() == m_consumerThread || ThreadPool::isPoolThread()) {
+                    break;
+                }
+                ++m_overloadCounters.pushesBlocked;
+                m_queueNotFull.wait(queueLock, [this] { return m_shutdown || m_queue.size() < m_capacity; });
+                if (m_shutdown) {
+                    return false;
+                }
+                break;
+            case OverloadPolicy::DROP_OLDEST:
+                droppedTask = std::move(m_queue.front().task);
+                m_queue.pop_front();
+                ++m_overloadCounters.tasksDropped;
+                break;
+            case OverloadPolicy::DROP_NEW:
+                ++m_overloadCounters.tasksDropped;
+                return false;
+        }
+    }
+
+    QueuedTask queuedTask{std::move(task), key};
+    m_queue.emplace(Placement::FRONT == placement ? m_queue.begin() : m_queue.end(), std::move(queuedTask));
+    if (m_queue.size() > m_overloadCounters.maxSize) {
+        m_overloadCounters.maxSize = m_queue.size();
+    }
+    queueLock.unlock();
+
+    m_queueChanged.notify_all();
+    return true;
+}
+
+std::unique_ptr<std::function<void()>> TaskQueue::popLocked() {
+    auto task = std::move(m_queue.front().task);
+    m_queue.pop_front();
+    if (m_capacity != UNBOUNDED) {
+        m_queueNotFull.notify_one();
+    }
+    return task;
 }
 
 std::unique_ptr<std::function<void()>> TaskQueue::pop() {
     std::unique_lock<std::mutex> queueLock{m_queueMutex};
+    m_consumerThread = std::this_thread::get_id();
 
     auto shouldNotWait = [this]() { return m_shutdown || !m_queue.empty(); };
 
@@ -35,26 +108,42 @@ std::unique_ptr<std::function<void()>> TaskQueue::pop() {
     }
 
     if (!m_queue.empty()) {
-        auto task = std::move(m_queue.front());
-
-        m_queue.pop_front();
-        return task;
+        return popLocked();
     }
 
     return nullptr;
 }
 
+std::unique_ptr<std::function<void()>> TaskQueue::tryPop() {
+    std::lock_guard<std::mutex> queueLock{m_queueMutex};
+    if (m_queue.empty()) {
+        return nullptr;
+    }
+    return popLocked();
+}
+
+bool TaskQueue::isEmpty() {
+    std::lock_guard<std::mutex> queueLock{m_queueMutex};
+    return m_queue.empty();
+}
+
 void TaskQueue::shutdown() {
     std::lock_guard<std::mutex> queueLock{m_queueMutex};
     m_queue.clear();
     m_shutdown = true;
     m_queueChanged.notify_all();
+    m_queueNotFull.notify_all();
 }
 
 bool TaskQueue::isShutdown() {
     return m_shutdown;
 }
 
+TaskQueue::OverloadCounters TaskQueue::getOverloadCounters() {
+    std::lock_guard<std::mutex> queueLock{m_queueMutex};
+    return m_overloadCounters;
+}
+
 }  // namespace threading
 }  // namespace utils
 }  // namespace avsCommon
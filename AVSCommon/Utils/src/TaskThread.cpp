@@ -16,6 +16,7 @@
  */
 
 #include "AVSCommon/Utils/Threading/TaskThread.h"
+#include "AVSCommon/Utils/Threading/ThreadName.h"
 
 namespace alexaClientSDK {
 namespace avsCommon {
@@ -42,6 +43,7 @@ bool TaskThread::isShutdown() {
 }
 
 void TaskThread::processTasksLoop() {
+    setThreadName("Executor");
     while (!m_shutdown) {
         auto m_actualTaskQueue = m_taskQueue.lock();
 
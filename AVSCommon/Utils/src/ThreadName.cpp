@@ -0,0 +1,51 @@
+/*
+ * ThreadName.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <pthread.h>
+
+#include "AVSCommon/Utils/Threading/ThreadName.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace threading {
+
+/// The longest thread name Linux keeps, plus its terminating null.
+static const size_t MAX_THREAD_NAME_SIZE = 16;
+
+void setThreadName(const std::string& name) {
+#if defined(__linux__)
+    pthread_setname_np(pthread_self(), name.substr(0, MAX_THREAD_NAME_SIZE - 1).c_str());
+#elif defined(__APPLE__)
+    pthread_setname_np(name.c_str());
+#endif
+}
+
+std::string getThreadName() {
+#if defined(__linux__) || defined(__APPLE__)
+    char name[MAX_THREAD_NAME_SIZE] = {};
+    if (0 == pthread_getname_np(pthread_self(), name, sizeof(name))) {
+        return name;
+    }
+#endif
+    return "";
+}
+
+}  // namespace threading
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -0,0 +1,147 @@
+/*
+ * ThreadPool.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+#include "AVSCommon/Utils/Logger/Logger.h"
+#include "AVSCommon/Utils/Threading/ThreadName.h"
+#include "AVSCommon/Utils/Threading/ThreadPool.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace threading {
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("ThreadPool");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+struct ThreadPool::State {
+    /// Mutex serializing access to @c jobs and @c shutdown.
+    std::mutex mutex;
+
+    /// Notified when a job is posted or the pool is shutting down.
+    std::condition_variable wakeWorker;
+
+    /// The jobs which have not started yet.
+    std::deque<std::function<void()>> jobs;
+
+    /// Whether the pool is shutting down.
+    bool shutdown = false;
+};
+
+/// Mutex serializing access to the default pool.
+static std::mutex defaultThreadPoolMutex;
+
+/// The pool set with @c ThreadPool::setDefault().
+static std::shared_ptr<ThreadPool> defaultThreadPool;
+
+/// Whether the current thread belongs to a pool.
+static thread_local bool isPoolThreadFlag = false;
+
+std::shared_ptr<ThreadPool> ThreadPool::create(size_t numThreads) {
+    if (0 == numThreads) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "zeroThreads"));
+        return nullptr;
+    }
+    return std::shared_ptr<ThreadPool>(new ThreadPool(numThreads));
+}
+
+ThreadPool::ThreadPool(size_t numThreads) : m_state{std::make_shared<State>()} {
+    for (size_t i = 0; i < numThreads; ++i) {
+        m_threads.emplace_back(&ThreadPool::workerLoop, m_state);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    std::deque<std::function<void()>> droppedJobs;
+    {
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        m_state->shutdown = true;
+        droppedJobs.swap(m_state->jobs);
+    }
+    m_state->wakeWorker.notify_all();
+    for (auto& thread : m_threads) {
+        // The last reference to the pool may be released by one of its own jobs, which can't join its own thread.
+        if (thread.get_id() == std::this_thread::get_id()) {
+            thread.detach();
+        } else {
+            thread.join();
+        }
+    }
+}
+
+void ThreadPool::post(std::function<void()> job) {
+    {
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        if (m_state->shutdown) {
+            return;
+        }
+        m_state->jobs.push_back(std::move(job));
+    }
+    m_state->wakeWorker.notify_one();
+}
+
+size_t ThreadPool::getNumThreads() const {
+    return m_threads.size();
+}
+
+bool ThreadPool::isPoolThread() {
+    return isPoolThreadFlag;
+}
+
+std::shared_ptr<ThreadPool> ThreadPool::getDefault() {
+    std::lock_guard<std::mutex> lock(defaultThreadPoolMutex);
+    return defaultThreadPool;
+}
+
+void ThreadPool::setDefault(std::shared_ptr<ThreadPool> threadPool) {
+    std::lock_guard<std::mutex> lock(defaultThreadPoolMutex);
+    defaultThreadPool = threadPool;
+}
+
+void ThreadPool::workerLoop(std::shared_ptr<State> state) {
+    setThreadName("ThreadPool");
+    isPoolThreadFlag = true;
+    std::unique_lock<std::mutex> lock(state->mutex);
+    while (true) {
+        state->wakeWorker.wait(lock, [&state] { return state->shutdown || !state->jobs.empty(); });
+        if (state->shutdown) {
+            return;
+        }
+        auto job = std::move(state->jobs.front());
+        state->jobs.pop_front();
+        lock.unlock();
+        job();
+        // Release whatever the job holds before taking the lock, as that may destroy objects which post jobs.
+        job = nullptr;
+        lock.lock();
+    }
+}
+
+}  // namespace threading
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
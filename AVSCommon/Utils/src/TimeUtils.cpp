@@ -16,13 +16,12 @@
  * limitations under the License.
  */
 
-#include <ctime>
+#include <algorithm>
 #include <chrono>
-#include <random>
 
+#include "AVSCommon/Utils/Timing/Clock.h"
 #include "AVSCommon/Utils/Timing/TimeUtils.h"
 #include "AVSCommon/Utils/Logger/Logger.h"
-#include "AVSCommon/Utils/String/StringUtils.h"
 
 namespace alexaClientSDK {
 namespace avsCommon {
@@ -30,7 +29,6 @@ namespace utils {
 namespace timing {
 
 using namespace avsCommon::utils::logger;
-using namespace avsCommon::utils::string;
 
 /// String to identify log entries originating from this file.
 static const std::string TAG("TimeUtils");
@@ -42,145 +40,220 @@ static const std::string TAG("TimeUtils");
  */
 #define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
 
-/// The length of the year element in an ISO-8601 formatted string.
-static const int ENCODED_TIME_STRING_YEAR_STRING_LENGTH = 4;
-/// The length of the month element in an ISO-8601 formatted string.
-static const int ENCODED_TIME_STRING_MONTH_STRING_LENGTH = 2;
-/// The length of the day element in an ISO-8601 formatted string.
-static const int ENCODED_TIME_STRING_DAY_STRING_LENGTH = 2;
-/// The length of the hour element in an ISO-8601 formatted string.
-static const int ENCODED_TIME_STRING_HOUR_STRING_LENGTH = 2;
-/// The length of the minute element in an ISO-8601 formatted string.
-static const int ENCODED_TIME_STRING_MINUTE_STRING_LENGTH = 2;
-/// The length of the second element in an ISO-8601 formatted string.
-static const int ENCODED_TIME_STRING_SECOND_STRING_LENGTH = 2;
-/// The length of the post-fix element in an ISO-8601 formatted string.
-static const int ENCODED_TIME_STRING_POSTFIX_STRING_LENGTH = 4;
-/// The dash separator used in an ISO-8601 formatted string.
-static const std::string ENCODED_TIME_STRING_DASH_SEPARATOR_STRING = "-";
-/// The 'T' separator used in an ISO-8601 formatted string.
-static const std::string ENCODED_TIME_STRING_T_SEPARATOR_STRING = "T";
-/// The colon separator used in an ISO-8601 formatted string.
-static const std::string ENCODED_TIME_STRING_COLON_SEPARATOR_STRING = ":";
-/// The plus separator used in an ISO-8601 formatted string.
-static const std::string ENCODED_TIME_STRING_PLUS_SEPARATOR_STRING = "+";
-
 /// The offset into an ISO-8601 formatted string where the year begins.
-static const unsigned long ENCODED_TIME_STRING_YEAR_OFFSET = 0;
+static const size_t ENCODED_TIME_STRING_YEAR_OFFSET = 0;
 /// The offset into an ISO-8601 formatted string where the month begins.
-static const unsigned long ENCODED_TIME_STRING_MONTH_OFFSET = ENCODED_TIME_STRING_YEAR_OFFSET +
-                                                              ENCODED_TIME_STRING_YEAR_STRING_LENGTH +
-                                                              ENCODED_TIME_STRING_DASH_SEPARATOR_STRING.length();
+static const size_t ENCODED_TIME_STRING_MONTH_OFFSET = 5;
 /// The offset into an ISO-8601 formatted string where the day begins.
-static const unsigned long ENCODED_TIME_STRING_DAY_OFFSET = ENCODED_TIME_STRING_MONTH_OFFSET +
-                                                            ENCODED_TIME_STRING_MONTH_STRING_LENGTH +
-                                                            ENCODED_TIME_STRING_DASH_SEPARATOR_STRING.length();
+static const size_t ENCODED_TIME_STRING_DAY_OFFSET = 8;
 /// The offset into an ISO-8601 formatted string where the hour begins.
-static const unsigned long ENCODED_TIME_STRING_HOUR_OFFSET = ENCODED_TIME_STRING_DAY_OFFSET +
-                                                             ENCODED_TIME_STRING_DAY_STRING_LENGTH +
-                                                             ENCODED_TIME_STRING_T_SEPARATOR_STRING.length();
+static const size_t ENCODED_TIME_STRING_HOUR_OFFSET = 11;
 /// The offset into an ISO-8601 formatted string where the minute begins.
-static const unsigned long ENCODED_TIME_STRING_MINUTE_OFFSET = ENCODED_TIME_STRING_HOUR_OFFSET +
-                                                               ENCODED_TIME_STRING_HOUR_STRING_LENGTH +
-                                                               ENCODED_TIME_STRING_COLON_SEPARATOR_STRING.length();
+static const size_t ENCODED_TIME_STRING_MINUTE_OFFSET = 14;
 /// The offset into an ISO-8601 formatted string where the second begins.
-static const unsigned long ENCODED_TIME_STRING_SECOND_OFFSET = ENCODED_TIME_STRING_MINUTE_OFFSET +
-                                                               ENCODED_TIME_STRING_MINUTE_STRING_LENGTH +
-                                                               ENCODED_TIME_STRING_COLON_SEPARATOR_STRING.length();
+static const size_t ENCODED_TIME_STRING_SECOND_OFFSET = 17;
+/// The offset into an ISO-8601 formatted string where the sign of the UTC offset is.
+static const size_t ENCODED_TIME_STRING_OFFSET_SIGN_OFFSET = 19;
+/// The offset into an ISO-8601 formatted string where the hours of the UTC offset begin.
+static const size_t ENCODED_TIME_STRING_OFFSET_HOUR_OFFSET = 20;
+/// The offset into an ISO-8601 formatted string where the minutes of the UTC offset begin.
+static const size_t ENCODED_TIME_STRING_OFFSET_MINUTE_OFFSET = 22;
 
-/// The total expected length of an ISO-8601 formatted string.
-static const unsigned long ENCODED_TIME_STRING_EXPECTED_LENGTH =
-    ENCODED_TIME_STRING_SECOND_OFFSET + ENCODED_TIME_STRING_SECOND_STRING_LENGTH +
-    ENCODED_TIME_STRING_PLUS_SEPARATOR_STRING.length() + ENCODED_TIME_STRING_POSTFIX_STRING_LENGTH;
+/// The dash separator used in an ISO-8601 formatted string.
+static const char ENCODED_TIME_STRING_DASH_SEPARATOR = '-';
+/// The 'T' separator used in an ISO-8601 formatted string.
+static const char ENCODED_TIME_STRING_T_SEPARATOR = 'T';
+/// The colon separator used in an ISO-8601 formatted string.
+static const char ENCODED_TIME_STRING_COLON_SEPARATOR = ':';
+/// The UTC offset written to ISO-8601 formatted strings.
+static const char ENCODED_TIME_STRING_UTC_OFFSET[] = "+0000";
 
-bool convert8601TimeStringToUnix(const std::string& timeString, int64_t* unixTime) {
-    // TODO : ACSDK-387 to investigate a simpler and more portable implementation of this logic.
+/// The largest year which can be written in four digits.
+static const int64_t MAX_FORMATTABLE_YEAR = 9999;
 
-    if (!unixTime) {
-        ACSDK_ERROR(LX("convert8601TimeStringToUnixFailed").m("unixTime parameter was nullptr."));
-        return false;
-    }
+/// The number of seconds in an hour.
+static const int SECONDS_PER_HOUR = 3600;
+/// The number of seconds in a minute.
+static const int SECONDS_PER_MINUTE = 60;
 
-    std::time_t rawtime = std::time(0);
-    auto timeInfo = std::localtime(&rawtime);
+static_assert(daysFromCivil(1970, 1, 1) == 0, "The Unix epoch must be day 0");
+static_assert(daysFromCivil(2000, 3, 1) == 11017, "Leap days must be counted");
+static_assert(daysFromCivil(1969, 12, 31) == -1, "Days before the Unix epoch must be negative");
 
-    if (!timeInfo) {
-        ACSDK_ERROR(LX("convert8601TimeStringToUnixFailed").m("localtime returned nullptr."));
-        return false;
+/**
+ * Parse a run of decimal digits, without allocating or accepting signs or whitespace as @c std::stoi() would.
+ *
+ * @param digits The digits to parse.
+ * @param numDigits The number of digits to parse.
+ * @param[out] value The parsed value.
+ * @return Whether all of the characters were digits.
+ */
+static bool parseDigits(const char* digits, size_t numDigits, int* value) {
+    int result = 0;
+    for (size_t i = 0; i < numDigits; ++i) {
+        if (digits[i] < '0' || digits[i] > '9') {
+            return false;
+        }
+        result = result * 10 + (digits[i] - '0');
     }
+    *value = result;
+    return true;
+}
 
-    if (timeString.length() != ENCODED_TIME_STRING_EXPECTED_LENGTH) {
-        ACSDK_ERROR(LX("convert8601TimeStringToUnixFailed").d("unexpected time string length:", timeString.length()));
-        return false;
+/**
+ * Write a value as a fixed number of decimal digits.
+ *
+ * @param value The value to write, which must fit in @c numDigits digits.
+ * @param numDigits The number of digits to write.
+ * @param[out] buffer Where to write the digits.
+ */
+static void writeDigits(int value, size_t numDigits, char* buffer) {
+    for (size_t i = numDigits; i > 0; --i) {
+        buffer[i - 1] = static_cast<char>('0' + value % 10);
+        value /= 10;
     }
+}
 
-    if (!stringToInt(
-            timeString.substr(ENCODED_TIME_STRING_YEAR_OFFSET, ENCODED_TIME_STRING_YEAR_STRING_LENGTH),
-            &(timeInfo->tm_year))) {
-        ACSDK_ERROR(LX("convert8601TimeStringToUnixFailed").m("error parsing year. Input:" + timeString));
+/**
+ * Divide rounding towards negative infinity, so that times before the epoch fall on the day they are in.
+ *
+ * @param dividend The value to divide.
+ * @param divisor The positive value to divide by.
+ * @return The quotient, rounded down.
+ */
+static int64_t floorDivide(int64_t dividend, int64_t divisor) {
+    return (dividend >= 0 ? dividend : dividend - divisor + 1) / divisor;
+}
+
+void civilFromDays(int64_t days, int64_t* year, unsigned* month, unsigned* day) {
+    // The inverse of daysFromCivil(), working in 400 year eras of 146097 days starting on 0000-03-01.
+    days += 719468;
+    int64_t era = floorDivide(days, 146097);
+    int64_t dayOfEra = days - era * 146097;
+    int64_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    int64_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    int64_t marchMonth = (5 * dayOfYear + 2) / 153;
+    *day = static_cast<unsigned>(dayOfYear - (153 * marchMonth + 2) / 5 + 1);
+    *month = static_cast<unsigned>(marchMonth < 10 ? marchMonth + 3 : marchMonth - 9);
+    *year = yearOfEra + era * 400 + (*month <= 2 ? 1 : 0);
+}
+
+bool formatDateAndTime(int64_t unixTime, char dateTimeSeparator, char* buffer) {
+    int64_t days = floorDivide(unixTime, SECONDS_PER_DAY);
+    int secondOfDay = static_cast<int>(unixTime - days * SECONDS_PER_DAY);
+    int64_t year = 0;
+    unsigned month = 0;
+    unsigned day = 0;
+    civilFromDays(days, &year, &month, &day);
+    if (year < 0 || year > MAX_FORMATTABLE_YEAR) {
         return false;
     }
 
-    if (!stringToInt(
-            timeString.substr(ENCODED_TIME_STRING_MONTH_OFFSET, ENCODED_TIME_STRING_MONTH_STRING_LENGTH),
-            &(timeInfo->tm_mon))) {
-        ACSDK_ERROR(LX("convert8601TimeStringToUnixFailed").m("error parsing month. Input:" + timeString));
+    // "YYYY-MM-DD HH:MM:SS"
+    writeDigits(static_cast<int>(year), 4, buffer);
+    buffer[4] = ENCODED_TIME_STRING_DASH_SEPARATOR;
+    writeDigits(month, 2, buffer + 5);
+    buffer[7] = ENCODED_TIME_STRING_DASH_SEPARATOR;
+    writeDigits(day, 2, buffer + 8);
+    buffer[10] = dateTimeSeparator;
+    writeDigits(secondOfDay / SECONDS_PER_HOUR, 2, buffer + 11);
+    buffer[13] = ENCODED_TIME_STRING_COLON_SEPARATOR;
+    writeDigits(secondOfDay % SECONDS_PER_HOUR / SECONDS_PER_MINUTE, 2, buffer + 14);
+    buffer[16] = ENCODED_TIME_STRING_COLON_SEPARATOR;
+    writeDigits(secondOfDay % SECONDS_PER_MINUTE, 2, buffer + 17);
+    return true;
+}
+
+bool convert8601TimeStringToUnix(const std::string& timeString, int64_t* unixTime) {
+    return convert8601TimeStringToUnix(timeString.data(), timeString.length(), unixTime);
+}
+
+bool convert8601TimeStringToUnix(const char* timeString, size_t length, int64_t* unixTime) {
+    if (!unixTime) {
+        ACSDK_ERROR(LX("convert8601TimeStringToUnixFailed").m("unixTime parameter was nullptr."));
         return false;
     }
-
-    if (!stringToInt(
-            timeString.substr(ENCODED_TIME_STRING_DAY_OFFSET, ENCODED_TIME_STRING_DAY_STRING_LENGTH),
-            &(timeInfo->tm_mday))) {
-        ACSDK_ERROR(LX("convert8601TimeStringToUnixFailed").m("error parsing day. Input:" + timeString));
+    if (!timeString) {
+        ACSDK_ERROR(LX("convert8601TimeStringToUnixFailed").m("timeString parameter was nullptr."));
         return false;
     }
-
-    if (!stringToInt(
-            timeString.substr(ENCODED_TIME_STRING_HOUR_OFFSET, ENCODED_TIME_STRING_HOUR_STRING_LENGTH),
-            &(timeInfo->tm_hour))) {
-        ACSDK_ERROR(LX("convert8601TimeStringToUnixFailed").m("error parsing hour. Input:" + timeString));
+    if (length != ISO_8601_TIME_STRING_LENGTH) {
+        ACSDK_ERROR(LX("convert8601TimeStringToUnixFailed").d("unexpected time string length:", length));
         return false;
     }
 
-    if (!stringToInt(
-            timeString.substr(ENCODED_TIME_STRING_MINUTE_OFFSET, ENCODED_TIME_STRING_MINUTE_STRING_LENGTH),
-            &(timeInfo->tm_min))) {
-        ACSDK_ERROR(LX("convert8601TimeStringToUnixFailed").m("error parsing minute. Input:" + timeString));
+    int year = 0;
+    int month = 0;
+    int day = 0;
+    int hour = 0;
+    int minute = 0;
+    int second = 0;
+    int offsetHours = 0;
+    int offsetMinutes = 0;
+    char offsetSign = timeString[ENCODED_TIME_STRING_OFFSET_SIGN_OFFSET];
+    if (!parseDigits(timeString + ENCODED_TIME_STRING_YEAR_OFFSET, 4, &year) ||
+        !parseDigits(timeString + ENCODED_TIME_STRING_MONTH_OFFSET, 2, &month) ||
+        !parseDigits(timeString + ENCODED_TIME_STRING_DAY_OFFSET, 2, &day) ||
+        !parseDigits(timeString + ENCODED_TIME_STRING_HOUR_OFFSET, 2, &hour) ||
+        !parseDigits(timeString + ENCODED_TIME_STRING_MINUTE_OFFSET, 2, &minute) ||
+        !parseDigits(timeString + ENCODED_TIME_STRING_SECOND_OFFSET, 2, &second) ||
+        !parseDigits(timeString + ENCODED_TIME_STRING_OFFSET_HOUR_OFFSET, 2, &offsetHours) ||
+        !parseDigits(timeString + ENCODED_TIME_STRING_OFFSET_MINUTE_OFFSET, 2, &offsetMinutes) ||
+        timeString[ENCODED_TIME_STRING_MONTH_OFFSET - 1] != ENCODED_TIME_STRING_DASH_SEPARATOR ||
+        timeString[ENCODED_TIME_STRING_DAY_OFFSET - 1] != ENCODED_TIME_STRING_DASH_SEPARATOR ||
+        timeString[ENCODED_TIME_STRING_HOUR_OFFSET - 1] != ENCODED_TIME_STRING_T_SEPARATOR ||
+        timeString[ENCODED_TIME_STRING_MINUTE_OFFSET - 1] != ENCODED_TIME_STRING_COLON_SEPARATOR ||
+        timeString[ENCODED_TIME_STRING_SECOND_OFFSET - 1] != ENCODED_TIME_STRING_COLON_SEPARATOR ||
+        (offsetSign != '+' && offsetSign != '-')) {
+        ACSDK_ERROR(LX("convert8601TimeStringToUnixFailed")
+                        .d("reason", "malformedTimeString")
+                        .d("input", std::string(timeString, length)));
         return false;
     }
 
-    if (!stringToInt(
-            timeString.substr(ENCODED_TIME_STRING_SECOND_OFFSET, ENCODED_TIME_STRING_SECOND_STRING_LENGTH),
-            &(timeInfo->tm_sec))) {
-        ACSDK_ERROR(LX("convert8601TimeStringToUnixFailed").m("error parsing second. Input:" + timeString));
+    // A second of 60 is a leap second, which Unix time counts as the first second of the next minute.
+    if (month < 1 || month > 12 || day < 1 || static_cast<unsigned>(day) > daysInMonth(year, month) || hour > 23 ||
+        minute > 59 || second > 60 || offsetHours > 23 || offsetMinutes > 59) {
+        ACSDK_ERROR(LX("convert8601TimeStringToUnixFailed")
+                        .d("reason", "fieldOutOfRange")
+                        .d("input", std::string(timeString, length)));
         return false;
     }
 
-    // adjust for unix epoch.
-    timeInfo->tm_year -= 1900;
-    timeInfo->tm_mon -= 1;
-
-    *unixTime = static_cast<int64_t>(std::mktime(timeInfo));
+    int offset = offsetHours * SECONDS_PER_HOUR + offsetMinutes * SECONDS_PER_MINUTE;
+    *unixTime = daysFromCivil(year, month, day) * SECONDS_PER_DAY + hour * SECONDS_PER_HOUR +
+                minute * SECONDS_PER_MINUTE + second - (offsetSign == '+' ? offset : -offset);
+    return true;
+}
 
+bool convertUnixTimeTo8601String(int64_t unixTime, std::string* timeString) {
+    if (!timeString) {
+        ACSDK_ERROR(LX("convertUnixTimeTo8601StringFailed").m("timeString parameter was nullptr."));
+        return false;
+    }
+    char buffer[ISO_8601_TIME_STRING_LENGTH];
+    if (!formatDateAndTime(unixTime, ENCODED_TIME_STRING_T_SEPARATOR, buffer)) {
+        ACSDK_ERROR(LX("convertUnixTimeTo8601StringFailed").d("reason", "yearOutOfRange").d("unixTime", unixTime));
+        return false;
+    }
+    std::copy(
+        ENCODED_TIME_STRING_UTC_OFFSET,
+        ENCODED_TIME_STRING_UTC_OFFSET + sizeof(ENCODED_TIME_STRING_UTC_OFFSET) - 1,
+        buffer + DATE_AND_TIME_STRING_LENGTH);
+    timeString->assign(buffer, sizeof(buffer));
     return true;
 }
 
 bool getCurrentUnixTime(int64_t* currentTime) {
-    // TODO : ACSDK-387 to investigate a simpler and more portable implementation of this logic.
-
     if (!currentTime) {
         ACSDK_ERROR(LX("getCurrentUnixTimeFailed").m("currentTime parameter was nullptr."));
         return false;
     }
 
-    std::time_t rawtime = std::time(0);
-    auto timeInfo = std::localtime(&rawtime);
-    if (!timeInfo) {
-        ACSDK_ERROR(LX("getCurrentUnixTimeFailed").m("localtime returned nullptr."));
-        return false;
-    }
-    *currentTime = static_cast<int64_t>(std::mktime(timeInfo));
-
+    // The system clock counts Unix time, so there is no need for a round trip through the local time zone.
+    *currentTime = std::chrono::duration_cast<std::chrono::seconds>(
+                       Clock::getDefault()->systemNow().time_since_epoch())
+                       .count();
     return true;
 }
 
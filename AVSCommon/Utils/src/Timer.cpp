@@ -24,7 +24,10 @@ namespace timing {
 
 const std::string Timer::TAG = "Timer";
 
-Timer::Timer() : m_running(false), m_stopping(false) {
+Timer::Timer(std::shared_ptr<Clock> clock) :
+        m_clock{clock ? clock : Clock::getDefault()},
+        m_running(false),
+        m_stopping(false) {
 }
 
 Timer::~Timer() {
@@ -0,0 +1,109 @@
+/*
+ * WakeupAudit.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <dirent.h>
+
+#include <fstream>
+
+#include "AVSCommon/Utils/Logger/Logger.h"
+#include "AVSCommon/Utils/Threading/WakeupAudit.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace threading {
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("WakeupAudit");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The directory listing the threads of this process.
+static const std::string TASK_DIRECTORY = "/proc/self/task/";
+
+std::unique_ptr<WakeupAudit> WakeupAudit::create() {
+    Samples start;
+    if (!sample(&start) || start.empty()) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "schedulerStatisticsUnavailable"));
+        return nullptr;
+    }
+    return std::unique_ptr<WakeupAudit>(new WakeupAudit(std::move(start)));
+}
+
+WakeupAudit::WakeupAudit(Samples start) : m_startTime{std::chrono::steady_clock::now()}, m_start{std::move(start)} {
+}
+
+std::map<std::string, WakeupAudit::RoleWakeups> WakeupAudit::getWakeups() const {
+    std::map<std::string, RoleWakeups> wakeups;
+    Samples now;
+    if (!sample(&now)) {
+        ACSDK_ERROR(LX("getWakeupsFailed").d("reason", "schedulerStatisticsUnavailable"));
+        return wakeups;
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - m_startTime;
+
+    for (const auto& entry : now) {
+        uint64_t numWakeups = entry.second.numTimeslices;
+        auto start = m_start.find(entry.first);
+        if (start != m_start.end() && start->second.numTimeslices <= numWakeups) {
+            numWakeups -= start->second.numTimeslices;
+        }
+        auto& role = wakeups[entry.second.name];
+        ++role.numThreads;
+        role.numWakeups += numWakeups;
+    }
+    for (auto& entry : wakeups) {
+        entry.second.wakeupsPerSecond = elapsed.count() > 0 ? entry.second.numWakeups / elapsed.count() : 0;
+    }
+    return wakeups;
+}
+
+bool WakeupAudit::sample(Samples* samples) {
+    DIR* directory = opendir(TASK_DIRECTORY.c_str());
+    if (!directory) {
+        return false;
+    }
+    while (auto entry = readdir(directory)) {
+        std::string tid = entry->d_name;
+        if (tid.empty() || '.' == tid[0]) {
+            continue;
+        }
+        ThreadSample threadSample;
+        uint64_t runTime = 0;
+        uint64_t waitTime = 0;
+        std::ifstream schedstat(TASK_DIRECTORY + tid + "/schedstat");
+        std::ifstream comm(TASK_DIRECTORY + tid + "/comm");
+        if (!(schedstat >> runTime >> waitTime >> threadSample.numTimeslices) ||
+            !std::getline(comm, threadSample.name)) {
+            // The thread exited, or this kernel has no scheduler statistics.
+            continue;
+        }
+        (*samples)[tid] = std::move(threadSample);
+    }
+    closedir(directory);
+    return true;
+}
+
+}  // namespace threading
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -0,0 +1,270 @@
+/*
+ * SimulatedMediaPlayer.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_TEST_AVSCOMMON_UTILS_MEDIAPLAYER_SIMULATEDMEDIAPLAYER_H_
+#define ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_TEST_AVSCOMMON_UTILS_MEDIAPLAYER_SIMULATEDMEDIAPLAYER_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "AVSCommon/Utils/MediaPlayer/MediaPlayerInterface.h"
+#include "AVSCommon/Utils/MediaPlayer/MediaPlayerObserverInterface.h"
+#include "AVSCommon/Utils/Timing/Clock.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace mediaPlayer {
+namespace test {
+
+/**
+ * A @c MediaPlayerInterface for tests and benchmarks which plays sources without decoding or outputting them, but
+ * which consumes their data as a real player would.
+ *
+ * Every source is taken to be encoded at a constant bitrate, so that each byte read from an @c AttachmentReader or
+ * @c std::istream stands for a fixed amount of playback time.  The offset of a source is the playback time of the
+ * bytes played so far.  URL sources have no data, and stand for silence of a fixed duration.
+ *
+ * Given a @c Clock, the player plays in time on it, waiting for each chunk of data to have played before reading the
+ * next one; with a @c ManualClock, a test then moves playback forward by advancing the clock.  Without a clock, the
+ * player plays each chunk as soon as it is read, so that a benchmark of a capability agent is limited only by how
+ * fast its data arrives and its callbacks run.
+ *
+ * As with a real player, @c onPlaybackStarted() is sent once the first data of a source has been read.  If a source
+ * which has started runs out of data without being closed, @c onBufferUnderrun() is sent, playback time stops until
+ * data arrives, and then @c onBufferRefilled() is sent.  All observer callbacks are made from the player's thread, in
+ * the order of the events they report.
+ */
+class SimulatedMediaPlayer : public MediaPlayerInterface {
+public:
+    /// The default bitrate of the sources, which is that of the MP3 speech AVS sends.
+    static const unsigned int DEFAULT_BYTES_PER_SECOND = 6000;
+
+    /// The default duration of URL sources.
+    static const std::chrono::milliseconds DEFAULT_URL_DURATION;
+
+    /**
+     * Create a @c SimulatedMediaPlayer.
+     *
+     * @param bytesPerSecond The bitrate of the sources, in bytes per second of playback.  Must be greater than zero.
+     * @param clock The clock to play in time on, or @c nullptr to play each chunk of data as soon as it is read.
+     * @param urlDuration The duration of URL sources.
+     * @return The new player, or @c nullptr if @c bytesPerSecond is zero.
+     */
+    static std::shared_ptr<SimulatedMediaPlayer> create(
+        unsigned int bytesPerSecond = DEFAULT_BYTES_PER_SECOND,
+        std::shared_ptr<timing::Clock> clock = nullptr,
+        std::chrono::milliseconds urlDuration = DEFAULT_URL_DURATION);
+
+    /// Destructor.  Stops the player's thread, without notifying the observer.
+    ~SimulatedMediaPlayer();
+
+    /// @name MediaPlayerInterface methods.
+    /// @{
+    SourceId setSource(std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> attachmentReader) override;
+    SourceId setSource(const std::string& url, std::chrono::milliseconds offset = std::chrono::milliseconds::zero())
+        override;
+    SourceId setSource(std::shared_ptr<std::istream> stream, bool repeat) override;
+    bool play(SourceId id) override;
+    bool stop(SourceId id) override;
+    bool pause(SourceId id) override;
+    bool resume(SourceId id) override;
+    std::chrono::milliseconds getOffset(SourceId id) override;
+    void setObserver(std::shared_ptr<MediaPlayerObserverInterface> playerObserver) override;
+    /// @}
+
+    /**
+     * Get the number of bytes the player has consumed from a source.
+     *
+     * @param id The id of the source.
+     * @return The number of bytes consumed, or zero if @c id is not the current source.
+     */
+    uint64_t getBytesConsumed(SourceId id);
+
+private:
+    /// The states of the current source.
+    enum class State {
+        /// There is no source, or it has been stopped, has finished or has failed.
+        IDLE,
+
+        /// The source has been set, but not played.
+        READY,
+
+        /// The source is playing.
+        PLAYING,
+
+        /// The source is playing, but waiting for data.
+        UNDERRUN,
+
+        /// The source is paused.
+        PAUSED
+    };
+
+    /// A notification for the observer.
+    using Notification = std::function<void(std::shared_ptr<MediaPlayerObserverInterface>)>;
+
+    /**
+     * Constructor.
+     *
+     * @param bytesPerSecond The bitrate of the sources.
+     * @param clock The clock to play in time on, or @c nullptr.
+     * @param urlDuration The duration of URL sources.
+     */
+    SimulatedMediaPlayer(
+        unsigned int bytesPerSecond,
+        std::shared_ptr<timing::Clock> clock,
+        std::chrono::milliseconds urlDuration);
+
+    /**
+     * Replace the current source with a new one.  The caller must be holding @c m_mutex.
+     *
+     * @return The id of the new source.
+     */
+    SourceId resetSourceLocked();
+
+    /**
+     * Whether a call for a source may act on it.  The caller must be holding @c m_mutex.
+     *
+     * @param id The id of the source passed to the call.
+     * @param caller The name of the call, for logging.
+     * @return Whether @c id is the current source.
+     */
+    bool isCurrentSourceLocked(SourceId id, const std::string& caller);
+
+    /**
+     * Queue a notification for the observer, and wake the player's thread to send it.  The caller must be holding
+     * @c m_mutex.
+     *
+     * @param notification The notification.
+     */
+    void notifyLocked(Notification notification);
+
+    /**
+     * End the current source, releasing its data.  The caller must be holding @c m_mutex.
+     *
+     * @param notification The notification reporting how the source ended.
+     */
+    void endSourceLocked(Notification notification);
+
+    /**
+     * Get the playback time of a number of bytes.
+     *
+     * @param bytes The number of bytes.
+     * @return The playback time of @c bytes.
+     */
+    std::chrono::nanoseconds toPlaybackTime(uint64_t bytes) const;
+
+    /**
+     * Get the number of bytes of the current source which have played.  The caller must be holding @c m_mutex.
+     *
+     * @return The number of bytes played.
+     */
+    uint64_t getBytesPlayedLocked();
+
+    /**
+     * Read the next chunk of the current source.  The caller must be holding @c m_mutex, which is released while
+     * reading.
+     *
+     * @param lock The lock on @c m_mutex.
+     */
+    void readChunkLocked(std::unique_lock<std::mutex>& lock);
+
+    /// Sends notifications, reads chunks of data and waits for them to play, until the player is destroyed.
+    void playbackLoop();
+
+    /// The bitrate of the sources.
+    const unsigned int m_bytesPerSecond;
+
+    /// The clock to play in time on, or @c nullptr.
+    const std::shared_ptr<timing::Clock> m_clock;
+
+    /// The duration of URL sources.
+    const std::chrono::milliseconds m_urlDuration;
+
+    /// The number of bytes read at a time, which is 10ms of playback.
+    const size_t m_chunkSize;
+
+    /// The buffer chunks are read into.  Only used by the player's thread.
+    std::vector<char> m_chunk;
+
+    /// Mutex serializing access to the members below.
+    std::mutex m_mutex;
+
+    /// Notified when the player's thread has something to do.
+    std::condition_variable m_wakePlaybackLoop;
+
+    /// The observer.
+    std::shared_ptr<MediaPlayerObserverInterface> m_observer;
+
+    /// The notifications not sent to the observer yet.
+    std::deque<Notification> m_notifications;
+
+    /// Whether the player is being destroyed.
+    bool m_isShuttingDown;
+
+    /// The id of the current source, or @c ERROR if no source has been set.
+    SourceId m_sourceId;
+
+    /// The state of the current source.
+    State m_state;
+
+    /// Whether @c onPlaybackStarted() has been sent for the current source.
+    bool m_hasStarted;
+
+    /// The attachment of the current source, if it is one.
+    std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> m_attachmentReader;
+
+    /// The stream of the current source, if it is one.
+    std::shared_ptr<std::istream> m_stream;
+
+    /// Whether to play @c m_stream in a loop.
+    bool m_repeat;
+
+    /// The number of bytes of silence left in the current source, if it is a URL.
+    uint64_t m_urlBytesLeft;
+
+    /// The offset the current source started playing at.
+    std::chrono::nanoseconds m_startOffset;
+
+    /// The number of bytes consumed from the current source.
+    uint64_t m_bytesConsumed;
+
+    /// The number of bytes of the current source played by @c m_resumeTime, when playing in time on @c m_clock.
+    uint64_t m_bytesPlayedAtResume;
+
+    /// When playback last started or resumed, or refilled after an underrun, when playing in time on @c m_clock.
+    timing::Clock::SteadyTimePoint m_resumeTime;
+
+    /// The thread playing the sources.  Declared last, so that it starts once the members above are initialized.
+    std::thread m_playbackThread;
+};
+
+}  // namespace test
+}  // namespace mediaPlayer
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_TEST_AVSCOMMON_UTILS_MEDIAPLAYER_SIMULATEDMEDIAPLAYER_H_
@@ -0,0 +1,110 @@
+/*
+ * ManualClock.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_TEST_AVSCOMMON_UTILS_TIMING_MANUALCLOCK_H_
+#define ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_TEST_AVSCOMMON_UTILS_TIMING_MANUALCLOCK_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <unordered_set>
+
+#include "AVSCommon/Utils/Timing/Clock.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace timing {
+namespace test {
+
+/**
+ * A @c Clock for unit tests whose time only moves when @c advance() is called.
+ *
+ * Threads waiting on the clock through @c waitUntil() are woken whenever the time advances, so a @c Timer or
+ * retry loop using a @c ManualClock fires as soon as the test moves the time past its deadline, however long the
+ * deadline is in real time.  Waits are also woken by their condition variable as usual, so stopping a component
+ * does not depend on the time advancing.
+ */
+class ManualClock : public Clock {
+public:
+    /**
+     * Constructor.  The steady time starts at the epoch of @c std::chrono::steady_clock, and the system time starts at
+     * the real current time.
+     */
+    ManualClock();
+
+    /**
+     * Move the time forward, and wake every waiter so that it can check its deadline.
+     *
+     * @param duration The amount to move both the steady and system time forward by.
+     */
+    void advance(std::chrono::steady_clock::duration duration);
+
+    /**
+     * Set the system time without changing the steady time, as when the device's wall clock is corrected.
+     *
+     * @param time The new system time.
+     */
+    void setSystemTime(SystemTimePoint time);
+
+    /**
+     * Advance the time in steps until a condition holds, letting other threads react between steps.  This lets a test
+     * drive a component through a sequence of timeouts whose exact deadlines it does not know.
+     *
+     * @param condition The condition to wait for.  It is evaluated on the calling thread.
+     * @param step The amount to advance the time by per step.
+     * @param limit The maximum total amount to advance the time by.
+     * @return Whether @c condition held before @c limit was reached.
+     */
+    bool advanceUntil(
+        std::function<bool()> condition,
+        std::chrono::steady_clock::duration step,
+        std::chrono::steady_clock::duration limit);
+
+    /// @name Clock methods.
+    /// @{
+    SteadyTimePoint steadyNow() override;
+    SystemTimePoint systemNow() override;
+    bool waitUntil(
+        std::condition_variable& condition,
+        std::unique_lock<std::mutex>& lock,
+        SteadyTimePoint deadline,
+        std::function<bool()> predicate) override;
+    /// @}
+
+private:
+    /// Mutex serializing access to the time and @c m_waiters.
+    std::mutex m_mutex;
+
+    /// The current steady time.
+    SteadyTimePoint m_steadyNow;
+
+    /// The current system time.
+    SystemTimePoint m_systemNow;
+
+    /// The condition variables of the threads currently waiting in @c waitUntil().
+    std::unordered_multiset<std::condition_variable*> m_waiters;
+};
+
+}  // namespace test
+}  // namespace timing
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_TEST_AVSCOMMON_UTILS_TIMING_MANUALCLOCK_H_
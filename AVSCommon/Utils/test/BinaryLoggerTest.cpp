@@ -0,0 +1,259 @@
+/*
+ * BinaryLoggerTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "AVSCommon/Utils/Logger/BinaryLogDecoder.h"
+#include "AVSCommon/Utils/Logger/BinaryLogger.h"
+#include "AVSCommon/Utils/Logger/LoggerUtils.h"
+#include "AVSCommon/Utils/Logger/ThreadMoniker.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace logger {
+namespace test {
+
+/// The source of the test entries.
+static const std::string TAG("BinaryLoggerTest");
+
+/// A format with a value of each encoded type.
+static const BinaryLogFormat ALL_TYPES(TAG, "allTypes", {"string", "literal", "signed", "unsigned", "double", "bool"});
+
+/// A format with a value needing escaping in its text form.
+static const BinaryLogFormat ESCAPED(TAG, "escaped", {"reason"});
+
+/// A format typical of a frequently logged event, with a short string and an integer.
+static const BinaryLogFormat READ_FAILED(TAG, "readFailed", {"reason", "error"});
+
+/// A format without values.
+static const BinaryLogFormat NO_VALUES(TAG, "noValues");
+
+/// The length of the "YYYY-MM-DD HH:MM:SS.mmm" prefix of a text log line.
+static const size_t TIMESTAMP_LENGTH = 23;
+
+/// The number of entries logged to compare the sizes of binary and text logs.
+static const int NUM_SIZE_COMPARISON_ENTRIES = 1000;
+
+/**
+ * Split text in to lines.
+ *
+ * @param text The text to split.
+ * @return The lines of @c text.
+ */
+static std::vector<std::string> splitLines(const std::string& text) {
+    std::vector<std::string> lines;
+    std::istringstream stream(text);
+    std::string line;
+    while (std::getline(stream, line)) {
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+/**
+ * Render an entry as @c ConsoleLogger would, without its timestamp.
+ *
+ * @param level The level of the entry.
+ * @param entry The entry.
+ * @return The line @c ConsoleLogger would emit, without its timestamp.
+ */
+static std::string renderWithoutTimestamp(Level level, const LogEntry& entry) {
+    return formatLogString(
+               level,
+               std::chrono::system_clock::time_point(),
+               ThreadMoniker::getThisThreadMoniker().c_str(),
+               entry.c_str())
+        .substr(TIMESTAMP_LENGTH);
+}
+
+class BinaryLoggerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        m_log = std::make_shared<std::stringstream>();
+        m_logger = BinaryLogger::create(m_log, Level::DEBUG0);
+        ASSERT_TRUE(m_logger);
+    }
+
+    /**
+     * Decode @c m_log.
+     *
+     * @return The decoded lines.
+     */
+    std::vector<std::string> decode() {
+        m_logger->flush();
+        std::istringstream input(m_log->str());
+        std::ostringstream output;
+        EXPECT_TRUE(BinaryLogDecoder::decode(input, output));
+        return splitLines(output.str());
+    }
+
+    /// The binary log.
+    std::shared_ptr<std::stringstream> m_log;
+
+    /// The logger writing @c m_log.
+    std::shared_ptr<BinaryLogger> m_logger;
+};
+
+/**
+ * Verify that entries of every value type decode to the text @c ConsoleLogger would have emitted.
+ */
+TEST_F(BinaryLoggerTest, decodedEntriesMatchTextRendering) {
+    std::string stringValue("aString");
+    m_logger->logBinary(Level::INFO, ALL_TYPES, stringValue, "aLiteral", -42, 42u, 2.5, true);
+    m_logger->logBinary(Level::ERROR, ESCAPED, R"(reserved_chars['\' ',' ':' '='])");
+    m_logger->logBinary(Level::WARN, NO_VALUES);
+
+    auto lines = decode();
+    ASSERT_EQ(lines.size(), 3u);
+    EXPECT_EQ(
+        lines[0].substr(TIMESTAMP_LENGTH),
+        renderWithoutTimestamp(
+            Level::INFO,
+            LogEntry(TAG, "allTypes")
+                .d("string", stringValue)
+                .d("literal", "aLiteral")
+                .d("signed", -42)
+                .d("unsigned", 42u)
+                .d("double", 2.5)
+                .d("bool", true)));
+    EXPECT_EQ(
+        lines[1].substr(TIMESTAMP_LENGTH),
+        renderWithoutTimestamp(Level::ERROR, LogEntry(TAG, "escaped").d("reason", R"(reserved_chars['\' ',' ':' '='])")));
+    EXPECT_EQ(lines[2].substr(TIMESTAMP_LENGTH), renderWithoutTimestamp(Level::WARN, LogEntry(TAG, "noValues")));
+}
+
+/**
+ * Verify that entries written through the @c Logger interface decode to exactly the text @c ConsoleLogger emits.
+ */
+TEST_F(BinaryLoggerTest, textEntriesMatchConsoleLogger) {
+    auto time = std::chrono::system_clock::now();
+    LogEntry entry(TAG, "textEntry");
+    entry.d("key", "value").d("number", 7);
+    m_logger->emit(Level::DEBUG0, time, "  7", entry.c_str());
+    m_logger->emit(Level::INFO, time + std::chrono::milliseconds(1500), "  8", entry.c_str());
+
+    auto lines = decode();
+    ASSERT_EQ(lines.size(), 2u);
+    EXPECT_EQ(lines[0], formatLogString(Level::DEBUG0, time, "  7", entry.c_str()));
+    EXPECT_EQ(
+        lines[1], formatLogString(Level::INFO, time + std::chrono::milliseconds(1500), "  8", entry.c_str()));
+}
+
+/**
+ * Verify that entries below the level of the logger are not written.
+ */
+TEST_F(BinaryLoggerTest, entriesBelowLevelNotWritten) {
+    m_logger->setLevel(Level::WARN);
+    m_logger->logBinary(Level::INFO, NO_VALUES);
+    EXPECT_EQ(m_log->str(), BinaryLogger::MAGIC);
+    m_logger->logBinary(Level::WARN, NO_VALUES);
+    EXPECT_EQ(decode().size(), 1u);
+}
+
+/**
+ * Verify that entries from several threads are attributed to their threads.
+ */
+TEST_F(BinaryLoggerTest, entriesAttributedToThreads) {
+    std::string otherMoniker;
+    std::thread other([this, &otherMoniker] {
+        otherMoniker = ThreadMoniker::getThisThreadMoniker();
+        m_logger->logBinary(Level::INFO, READ_FAILED, "other", 1);
+    });
+    other.join();
+    m_logger->logBinary(Level::INFO, READ_FAILED, "this", 2);
+
+    auto lines = decode();
+    ASSERT_EQ(lines.size(), 2u);
+    EXPECT_NE(lines[0].find("[" + otherMoniker + "]"), std::string::npos);
+    EXPECT_NE(lines[1].find("[" + ThreadMoniker::getThisThreadMoniker() + "]"), std::string::npos);
+}
+
+/**
+ * Verify that once more threads than @c MAX_THREAD_INDICES have logged, indices are reused and entries are still
+ * attributed to the right threads, including a thread which logged before the indices were reused.
+ */
+TEST_F(BinaryLoggerTest, threadIndicesReused) {
+    auto time = std::chrono::system_clock::now();
+    std::vector<std::string> monikers;
+    for (size_t i = 0; i <= BinaryLogger::MAX_THREAD_INDICES; ++i) {
+        monikers.push_back("t" + std::to_string(i));
+    }
+    monikers.push_back(monikers.front());
+    for (const auto& moniker : monikers) {
+        m_logger->emit(Level::INFO, time, moniker.c_str(), "text");
+    }
+
+    auto lines = decode();
+    ASSERT_EQ(lines.size(), monikers.size());
+    for (size_t i = 0; i < monikers.size(); ++i) {
+        EXPECT_EQ(lines[i], formatLogString(Level::INFO, time, monikers[i].c_str(), "text"));
+    }
+}
+
+/**
+ * Verify that the strings of a format are only written once, and that a binary log of typical entries is several
+ * times smaller than the equivalent text log.
+ */
+TEST_F(BinaryLoggerTest, binaryLogSmallerThanTextLog) {
+    std::string textLog;
+    for (int i = 0; i < NUM_SIZE_COMPARISON_ENTRIES; ++i) {
+        m_logger->logBinary(Level::ERROR, READ_FAILED, "readerTimeOut", -3 - (i % 2));
+        textLog += formatLogString(
+                       Level::ERROR,
+                       std::chrono::system_clock::now(),
+                       ThreadMoniker::getThisThreadMoniker().c_str(),
+                       LogEntry(TAG, "readFailed").d("reason", "readerTimeOut").d("error", -3 - (i % 2)).c_str()) +
+                   "\n";
+    }
+    auto binaryLog = m_log->str();
+    size_t occurrences = 0;
+    for (auto pos = binaryLog.find("readFailed"); pos != std::string::npos;
+         pos = binaryLog.find("readFailed", pos + 1)) {
+        ++occurrences;
+    }
+    EXPECT_EQ(occurrences, 1u);
+    EXPECT_LT(binaryLog.size() * 3, textLog.size());
+    EXPECT_EQ(decode().size(), static_cast<size_t>(NUM_SIZE_COMPARISON_ENTRIES));
+}
+
+/**
+ * Verify that a truncated log decodes the entries before the truncation, and reports failure.
+ */
+TEST_F(BinaryLoggerTest, truncatedLogPartiallyDecoded) {
+    m_logger->logBinary(Level::INFO, READ_FAILED, "first", 1);
+    m_logger->logBinary(Level::INFO, READ_FAILED, "second", 2);
+    auto binaryLog = m_log->str();
+    std::istringstream input(binaryLog.substr(0, binaryLog.size() - 2));
+    std::ostringstream output;
+    EXPECT_FALSE(BinaryLogDecoder::decode(input, output));
+    EXPECT_EQ(splitLines(output.str()).size(), 1u);
+
+    std::istringstream notALog("not a binary log");
+    EXPECT_FALSE(BinaryLogDecoder::decode(notALog, output));
+}
+
+}  // namespace test
+}  // namespace logger
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -0,0 +1,105 @@
+/*
+ * ManualClock.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <thread>
+
+#include "AVSCommon/Utils/Timing/ManualClock.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace timing {
+namespace test {
+
+/**
+ * The longest a waiter sleeps in real time before checking the time again.  @c advance() notifies waiters without
+ * holding their mutexes, so a notification can land between a waiter checking its deadline and starting to wait; this
+ * bounds how late such a waiter notices.
+ */
+static const auto MAX_REAL_WAIT = std::chrono::milliseconds(5);
+
+/// The real time @c advanceUntil() gives other threads to react after each step.
+static const auto REAL_TIME_PER_STEP = std::chrono::milliseconds(1);
+
+ManualClock::ManualClock() : m_steadyNow{}, m_systemNow{std::chrono::system_clock::now()} {
+}
+
+void ManualClock::advance(std::chrono::steady_clock::duration duration) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_steadyNow += duration;
+    m_systemNow += std::chrono::duration_cast<std::chrono::system_clock::duration>(duration);
+    // Notify while holding m_mutex so that a waiter can't deregister and be destroyed in the meantime.
+    for (auto waiter : m_waiters) {
+        waiter->notify_all();
+    }
+}
+
+void ManualClock::setSystemTime(SystemTimePoint time) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_systemNow = time;
+}
+
+bool ManualClock::advanceUntil(
+    std::function<bool()> condition,
+    std::chrono::steady_clock::duration step,
+    std::chrono::steady_clock::duration limit) {
+    for (std::chrono::steady_clock::duration elapsed{0}; elapsed < limit; elapsed += step) {
+        if (condition()) {
+            return true;
+        }
+        advance(step);
+        std::this_thread::sleep_for(REAL_TIME_PER_STEP);
+    }
+    return condition();
+}
+
+Clock::SteadyTimePoint ManualClock::steadyNow() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_steadyNow;
+}
+
+Clock::SystemTimePoint ManualClock::systemNow() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_systemNow;
+}
+
+bool ManualClock::waitUntil(
+    std::condition_variable& condition,
+    std::unique_lock<std::mutex>& lock,
+    SteadyTimePoint deadline,
+    std::function<bool()> predicate) {
+    std::unordered_multiset<std::condition_variable*>::iterator waiter;
+    {
+        std::lock_guard<std::mutex> clockLock(m_mutex);
+        waiter = m_waiters.insert(&condition);
+    }
+    // The predicate is evaluated without m_mutex held, so that it may itself read this clock.
+    while (!predicate() && steadyNow() < deadline) {
+        condition.wait_for(lock, MAX_REAL_WAIT);
+    }
+    {
+        std::lock_guard<std::mutex> clockLock(m_mutex);
+        m_waiters.erase(waiter);
+    }
+    return predicate();
+}
+
+}  // namespace test
+}  // namespace timing
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -0,0 +1,420 @@
+/*
+ * SimulatedMediaPlayer.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+
+#include "AVSCommon/Utils/Logger/Logger.h"
+#include "AVSCommon/Utils/MediaPlayer/SimulatedMediaPlayer.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace mediaPlayer {
+namespace test {
+
+using namespace avsCommon::avs::attachment;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("SimulatedMediaPlayer");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The playback time of each chunk of data read.
+static const std::chrono::milliseconds CHUNK_DURATION(10);
+
+/// How long a read from a @c BLOCKING @c AttachmentReader waits for data.
+static const std::chrono::milliseconds READ_TIMEOUT(1);
+
+/// How long to wait before reading again from a source which had no data.
+static const std::chrono::milliseconds NO_DATA_RETRY_INTERVAL(1);
+
+const unsigned int SimulatedMediaPlayer::DEFAULT_BYTES_PER_SECOND;
+
+const std::chrono::milliseconds SimulatedMediaPlayer::DEFAULT_URL_DURATION(10000);
+
+std::shared_ptr<SimulatedMediaPlayer> SimulatedMediaPlayer::create(
+    unsigned int bytesPerSecond,
+    std::shared_ptr<timing::Clock> clock,
+    std::chrono::milliseconds urlDuration) {
+    if (0 == bytesPerSecond) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "zeroBytesPerSecond"));
+        return nullptr;
+    }
+    return std::shared_ptr<SimulatedMediaPlayer>(new SimulatedMediaPlayer(bytesPerSecond, clock, urlDuration));
+}
+
+SimulatedMediaPlayer::SimulatedMediaPlayer(
+    unsigned int bytesPerSecond,
+    std::shared_ptr<timing::Clock> clock,
+    std::chrono::milliseconds urlDuration) :
+        m_bytesPerSecond{bytesPerSecond},
+        m_clock{clock},
+        m_urlDuration{urlDuration},
+        m_chunkSize{std::max<size_t>(1, bytesPerSecond * CHUNK_DURATION.count() / 1000)},
+        m_chunk(m_chunkSize),
+        m_isShuttingDown{false},
+        m_sourceId{ERROR},
+        m_state{State::IDLE},
+        m_hasStarted{false},
+        m_repeat{false},
+        m_urlBytesLeft{0},
+        m_startOffset{std::chrono::nanoseconds::zero()},
+        m_bytesConsumed{0},
+        m_bytesPlayedAtResume{0},
+        m_playbackThread{&SimulatedMediaPlayer::playbackLoop, this} {
+}
+
+SimulatedMediaPlayer::~SimulatedMediaPlayer() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isShuttingDown = true;
+    }
+    m_wakePlaybackLoop.notify_all();
+    m_playbackThread.join();
+}
+
+MediaPlayerInterface::SourceId SimulatedMediaPlayer::setSource(std::shared_ptr<AttachmentReader> attachmentReader) {
+    if (!attachmentReader) {
+        ACSDK_ERROR(LX("setSourceFailed").d("reason", "nullAttachmentReader"));
+        return ERROR;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto id = resetSourceLocked();
+    m_attachmentReader = attachmentReader;
+    return id;
+}
+
+MediaPlayerInterface::SourceId SimulatedMediaPlayer::setSource(
+    const std::string& url,
+    std::chrono::milliseconds offset) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto id = resetSourceLocked();
+    offset = std::min(offset, m_urlDuration);
+    m_startOffset = offset;
+    m_urlBytesLeft = (m_urlDuration - offset).count() * m_bytesPerSecond / 1000;
+    return id;
+}
+
+MediaPlayerInterface::SourceId SimulatedMediaPlayer::setSource(std::shared_ptr<std::istream> stream, bool repeat) {
+    if (!stream) {
+        ACSDK_ERROR(LX("setSourceFailed").d("reason", "nullStream"));
+        return ERROR;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto id = resetSourceLocked();
+    m_stream = stream;
+    m_repeat = repeat;
+    return id;
+}
+
+bool SimulatedMediaPlayer::play(SourceId id) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!isCurrentSourceLocked(id, "play")) {
+        return false;
+    }
+    if (m_state != State::READY) {
+        ACSDK_ERROR(LX("playFailed").d("reason", "alreadyPlayed").d("id", id));
+        return false;
+    }
+    m_state = State::PLAYING;
+    m_wakePlaybackLoop.notify_all();
+    return true;
+}
+
+bool SimulatedMediaPlayer::stop(SourceId id) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!isCurrentSourceLocked(id, "stop")) {
+        return false;
+    }
+    if (State::IDLE == m_state) {
+        ACSDK_ERROR(LX("stopFailed").d("reason", "notActive").d("id", id));
+        return false;
+    }
+    endSourceLocked([id](std::shared_ptr<MediaPlayerObserverInterface> observer) { observer->onPlaybackStopped(id); });
+    return true;
+}
+
+bool SimulatedMediaPlayer::pause(SourceId id) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!isCurrentSourceLocked(id, "pause")) {
+        return false;
+    }
+    if (m_state != State::PLAYING && m_state != State::UNDERRUN) {
+        ACSDK_ERROR(LX("pauseFailed").d("reason", "notPlaying").d("id", id));
+        return false;
+    }
+    m_bytesPlayedAtResume = getBytesPlayedLocked();
+    m_state = State::PAUSED;
+    notifyLocked([id](std::shared_ptr<MediaPlayerObserverInterface> observer) { observer->onPlaybackPaused(id); });
+    return true;
+}
+
+bool SimulatedMediaPlayer::resume(SourceId id) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!isCurrentSourceLocked(id, "resume")) {
+        return false;
+    }
+    if (m_state != State::PAUSED) {
+        ACSDK_ERROR(LX("resumeFailed").d("reason", "notPaused").d("id", id));
+        return false;
+    }
+    m_state = State::PLAYING;
+    if (m_clock) {
+        m_resumeTime = m_clock->steadyNow();
+    }
+    notifyLocked([id](std::shared_ptr<MediaPlayerObserverInterface> observer) { observer->onPlaybackResumed(id); });
+    return true;
+}
+
+std::chrono::milliseconds SimulatedMediaPlayer::getOffset(SourceId id) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (ERROR == id || id != m_sourceId) {
+        return MEDIA_PLAYER_INVALID_OFFSET;
+    }
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        m_startOffset + toPlaybackTime(getBytesPlayedLocked()));
+}
+
+void SimulatedMediaPlayer::setObserver(std::shared_ptr<MediaPlayerObserverInterface> playerObserver) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_observer = playerObserver;
+}
+
+uint64_t SimulatedMediaPlayer::getBytesConsumed(SourceId id) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return (ERROR != id && id == m_sourceId) ? m_bytesConsumed : 0;
+}
+
+MediaPlayerInterface::SourceId SimulatedMediaPlayer::resetSourceLocked() {
+    if (m_state != State::IDLE) {
+        auto previousId = m_sourceId;
+        endSourceLocked([previousId](std::shared_ptr<MediaPlayerObserverInterface> observer) {
+            observer->onPlaybackStopped(previousId);
+        });
+    }
+    ++m_sourceId;
+    m_state = State::READY;
+    m_hasStarted = false;
+    m_repeat = false;
+    m_urlBytesLeft = 0;
+    m_startOffset = std::chrono::nanoseconds::zero();
+    m_bytesConsumed = 0;
+    m_bytesPlayedAtResume = 0;
+    return m_sourceId;
+}
+
+bool SimulatedMediaPlayer::isCurrentSourceLocked(SourceId id, const std::string& caller) {
+    if (ERROR == id || id != m_sourceId) {
+        ACSDK_ERROR(LX(caller + "Failed").d("reason", "invalidId").d("id", id).d("currentId", m_sourceId));
+        return false;
+    }
+    return true;
+}
+
+void SimulatedMediaPlayer::notifyLocked(Notification notification) {
+    m_notifications.push_back(std::move(notification));
+    m_wakePlaybackLoop.notify_all();
+}
+
+void SimulatedMediaPlayer::endSourceLocked(Notification notification) {
+    m_bytesPlayedAtResume = getBytesPlayedLocked();
+    m_state = State::IDLE;
+    m_attachmentReader.reset();
+    m_stream.reset();
+    notifyLocked(std::move(notification));
+}
+
+std::chrono::nanoseconds SimulatedMediaPlayer::toPlaybackTime(uint64_t bytes) const {
+    return std::chrono::nanoseconds(bytes * std::nano::den / m_bytesPerSecond);
+}
+
+uint64_t SimulatedMediaPlayer::getBytesPlayedLocked() {
+    if (!m_clock) {
+        return m_bytesConsumed;
+    }
+    switch (m_state) {
+        case State::PLAYING:
+            if (m_hasStarted) {
+                auto elapsed =
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(m_clock->steadyNow() - m_resumeTime);
+                uint64_t bytes = m_bytesPlayedAtResume + elapsed.count() * m_bytesPerSecond / std::nano::den;
+                return std::min(bytes, m_bytesConsumed);
+            }
+            return m_bytesPlayedAtResume;
+        case State::UNDERRUN:
+            return m_bytesConsumed;
+        case State::READY:
+        case State::PAUSED:
+        case State::IDLE:
+            return m_bytesPlayedAtResume;
+    }
+    return m_bytesPlayedAtResume;
+}
+
+void SimulatedMediaPlayer::readChunkLocked(std::unique_lock<std::mutex>& lock) {
+    auto id = m_sourceId;
+    auto attachmentReader = m_attachmentReader;
+    auto stream = m_stream;
+    bool repeat = m_repeat;
+    size_t bytesRead = 0;
+    bool isClosed = false;
+    std::string error;
+
+    if (attachmentReader || stream) {
+        lock.unlock();
+        if (attachmentReader) {
+            auto status = AttachmentReader::ReadStatus::OK;
+            bytesRead = attachmentReader->read(m_chunk.data(), m_chunk.size(), &status, READ_TIMEOUT);
+            switch (status) {
+                case AttachmentReader::ReadStatus::OK:
+                case AttachmentReader::ReadStatus::OK_WOULDBLOCK:
+                case AttachmentReader::ReadStatus::OK_TIMEDOUT:
+                    break;
+                case AttachmentReader::ReadStatus::CLOSED:
+                    isClosed = (0 == bytesRead);
+                    break;
+                case AttachmentReader::ReadStatus::ERROR_OVERRUN:
+                case AttachmentReader::ReadStatus::ERROR_BYTES_LESS_THAN_WORD_SIZE:
+                case AttachmentReader::ReadStatus::ERROR_INTERNAL:
+                    error = "attachmentReadFailed";
+                    break;
+            }
+        } else {
+            stream->read(m_chunk.data(), m_chunk.size());
+            bytesRead = stream->gcount();
+            if (repeat && 0 == bytesRead && stream->eof()) {
+                stream->clear();
+                stream->seekg(0);
+                stream->read(m_chunk.data(), m_chunk.size());
+                bytesRead = stream->gcount();
+            }
+            if (stream->bad()) {
+                error = "streamReadFailed";
+            } else {
+                // An empty stream which repeats finishes too, rather than playing nothing forever.
+                isClosed = (0 == bytesRead);
+            }
+        }
+        lock.lock();
+    } else {
+        bytesRead = std::min<uint64_t>(m_chunkSize, m_urlBytesLeft);
+        m_urlBytesLeft -= bytesRead;
+        isClosed = (0 == bytesRead);
+    }
+
+    // Stop if the source was replaced, stopped or paused while reading.
+    if (id != m_sourceId) {
+        return;
+    }
+    m_bytesConsumed += bytesRead;
+    if (m_state != State::PLAYING && m_state != State::UNDERRUN) {
+        return;
+    }
+
+    if (!error.empty()) {
+        ACSDK_ERROR(LX("playbackFailed").d("reason", error).d("id", id));
+        endSourceLocked([id, error](std::shared_ptr<MediaPlayerObserverInterface> observer) {
+            observer->onPlaybackError(id, ErrorType::MEDIA_ERROR_INTERNAL_DEVICE_ERROR, error);
+        });
+        return;
+    }
+    if (isClosed) {
+        endSourceLocked(
+            [id](std::shared_ptr<MediaPlayerObserverInterface> observer) { observer->onPlaybackFinished(id); });
+        return;
+    }
+    if (bytesRead > 0) {
+        if (!m_hasStarted || State::UNDERRUN == m_state) {
+            // Playback time starts, or restarts, with the chunk just read.
+            if (m_clock) {
+                m_resumeTime = m_clock->steadyNow();
+            }
+            m_bytesPlayedAtResume = m_bytesConsumed - bytesRead;
+        }
+        if (!m_hasStarted) {
+            m_hasStarted = true;
+            notifyLocked(
+                [id](std::shared_ptr<MediaPlayerObserverInterface> observer) { observer->onPlaybackStarted(id); });
+        } else if (State::UNDERRUN == m_state) {
+            notifyLocked(
+                [id](std::shared_ptr<MediaPlayerObserverInterface> observer) { observer->onBufferRefilled(id); });
+        }
+        m_state = State::PLAYING;
+        return;
+    }
+
+    if (m_hasStarted && State::PLAYING == m_state) {
+        m_bytesPlayedAtResume = m_bytesConsumed;
+        m_state = State::UNDERRUN;
+        notifyLocked([id](std::shared_ptr<MediaPlayerObserverInterface> observer) { observer->onBufferUnderrun(id); });
+    }
+    m_wakePlaybackLoop.wait_for(lock, NO_DATA_RETRY_INTERVAL, [this, id] {
+        return m_isShuttingDown || !m_notifications.empty() || id != m_sourceId ||
+               (m_state != State::PLAYING && m_state != State::UNDERRUN);
+    });
+}
+
+void SimulatedMediaPlayer::playbackLoop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_isShuttingDown) {
+        if (!m_notifications.empty()) {
+            std::deque<Notification> notifications;
+            notifications.swap(m_notifications);
+            auto observer = m_observer;
+            lock.unlock();
+            if (observer) {
+                for (auto& notification : notifications) {
+                    notification(observer);
+                }
+            }
+            lock.lock();
+            continue;
+        }
+
+        if (State::PLAYING == m_state || State::UNDERRUN == m_state) {
+            if (m_clock && m_hasStarted && State::PLAYING == m_state) {
+                // Wait for the data read so far to play before reading more.
+                auto id = m_sourceId;
+                auto playedTime = m_resumeTime + toPlaybackTime(m_bytesConsumed - m_bytesPlayedAtResume);
+                if (m_clock->waitUntil(m_wakePlaybackLoop, lock, playedTime, [this, id] {
+                        return m_isShuttingDown || !m_notifications.empty() || id != m_sourceId ||
+                               m_state != State::PLAYING;
+                    })) {
+                    continue;
+                }
+            }
+            readChunkLocked(lock);
+            continue;
+        }
+
+        m_wakePlaybackLoop.wait(lock, [this] {
+            return m_isShuttingDown || !m_notifications.empty() || State::PLAYING == m_state ||
+                   State::UNDERRUN == m_state;
+        });
+    }
+}
+
+}  // namespace test
+}  // namespace mediaPlayer
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
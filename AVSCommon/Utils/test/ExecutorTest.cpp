@@ -15,7 +15,11 @@
  * permissions and limitations under the License.
  */
 
+#include <atomic>
 #include <list>
+#include <string>
+#include <thread>
+#include <vector>
 #include <gtest/gtest.h>
 
 #include "ExecutorTestUtils.h"
@@ -249,6 +253,313 @@ TEST_F(ExecutorTest, shutdown) {
     ASSERT_FALSE(rejected.valid());
 }
 
+/// The number of simulated devices sharing a pool in @c pooledExecutorsOfManyTenants.
+static const int NUM_TENANTS = 200;
+
+/// The number of executors each simulated device has in @c pooledExecutorsOfManyTenants.
+static const int EXECUTORS_PER_TENANT = 10;
+
+/// The number of tasks submitted to each executor in pooled tests.
+static const int TASKS_PER_EXECUTOR = 20;
+
+/// The number of threads in the pools of pooled tests.
+static const size_t POOL_THREADS = 4;
+
+/// How long to wait for a task on a pool.  This will only be hit if a test is failing.
+static const std::chrono::seconds POOLED_TASK_TIMEOUT(10);
+
+/// This test verifies that executors sharing a pool run each of their own tasks in order and one at a time.
+TEST_F(ExecutorTest, pooledExecutorsOfManyTenants) {
+    auto pool = ThreadPool::create(POOL_THREADS);
+    ASSERT_TRUE(pool);
+
+    struct Tenant {
+        std::vector<std::unique_ptr<Executor>> executors;
+        std::vector<std::vector<int>> results;
+        std::vector<std::unique_ptr<std::atomic<int>>> running;
+    };
+    std::vector<Tenant> tenants(NUM_TENANTS);
+    std::atomic<bool> overlapped(false);
+    std::vector<std::future<void>> futures;
+    for (auto& tenant : tenants) {
+        for (int e = 0; e < EXECUTORS_PER_TENANT; ++e) {
+            tenant.executors.emplace_back(new Executor(pool));
+            tenant.results.emplace_back();
+            tenant.running.emplace_back(new std::atomic<int>(0));
+        }
+    }
+    for (int t = 0; t < TASKS_PER_EXECUTOR; ++t) {
+        for (auto& tenant : tenants) {
+            for (int e = 0; e < EXECUTORS_PER_TENANT; ++e) {
+                auto results = &tenant.results[e];
+                auto running = tenant.running[e].get();
+                futures.push_back(tenant.executors[e]->submit([results, running, t, &overlapped] {
+                    if (running->fetch_add(1) != 0) {
+                        overlapped = true;
+                    }
+                    results->push_back(t);
+                    running->fetch_sub(1);
+                }));
+            }
+        }
+    }
+    for (auto& future : futures) {
+        ASSERT_EQ(future.wait_for(POOLED_TASK_TIMEOUT), std::future_status::ready);
+    }
+    EXPECT_FALSE(overlapped);
+    for (auto& tenant : tenants) {
+        for (auto& results : tenant.results) {
+            ASSERT_EQ(results.size(), static_cast<size_t>(TASKS_PER_EXECUTOR));
+            for (int t = 0; t < TASKS_PER_EXECUTOR; ++t) {
+                EXPECT_EQ(results[t], t);
+            }
+        }
+    }
+}
+
+/// This test verifies that submitToFront and waitForSubmittedTasks work for an executor on a pool.
+TEST_F(ExecutorTest, pooledSubmitToFrontAndWait) {
+    auto pool = ThreadPool::create(POOL_THREADS);
+    ASSERT_TRUE(pool);
+    Executor pooledExecutor(pool);
+    std::list<int> order;
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    pooledExecutor.submit([released] { released.wait(); });
+    pooledExecutor.submit([&order] { order.push_back(2); });
+    pooledExecutor.submitToFront([&order] { order.push_back(1); });
+    release.set_value();
+    pooledExecutor.waitForSubmittedTasks();
+    EXPECT_EQ(order, std::list<int>({1, 2}));
+}
+
+/// This test verifies that shutting down an executor on a pool waits for its running task and rejects new ones.
+TEST_F(ExecutorTest, pooledShutdown) {
+    auto pool = ThreadPool::create(POOL_THREADS);
+    ASSERT_TRUE(pool);
+    Executor pooledExecutor(pool);
+    std::atomic<bool> blocked(false);
+    std::atomic<bool> finished(false);
+    pooledExecutor.submit([&] {
+        blocked = true;
+        std::this_thread::sleep_for(SHORT_TIMEOUT_MS);
+        finished = true;
+    });
+    while (!blocked) {
+        std::this_thread::yield();
+    }
+    pooledExecutor.shutdown();
+    EXPECT_TRUE(finished);
+    EXPECT_TRUE(pooledExecutor.isShutdown());
+    EXPECT_FALSE(pooledExecutor.submit([] {}).valid());
+}
+
+/// This test verifies that executors created without a pool use the default pool when one is set.
+TEST_F(ExecutorTest, defaultPoolUsed) {
+    auto pool = ThreadPool::create(1);
+    ASSERT_TRUE(pool);
+    std::thread::id poolThread;
+    pool->post([&poolThread] { poolThread = std::this_thread::get_id(); });
+    ThreadPool::setDefault(pool);
+    Executor pooledExecutor;
+    ThreadPool::setDefault(nullptr);
+
+    std::thread::id taskThread;
+    pooledExecutor.submit([&taskThread] { taskThread = std::this_thread::get_id(); }).wait();
+    EXPECT_EQ(taskThread, poolThread);
+}
+
+/**
+ * This test verifies that a dedicated executor keeps its own thread when a default pool is set, so that its tasks can
+ * wait on a pooled executor even when every pool thread is taken.
+ */
+TEST_F(ExecutorTest, dedicatedExecutorIgnoresDefaultPool) {
+    auto pool = ThreadPool::create(1);
+    ASSERT_TRUE(pool);
+    ThreadPool::setDefault(pool);
+    Executor pooledExecutor;
+    Executor dedicatedExecutor(Executor::ThreadPolicy::DEDICATED);
+    ThreadPool::setDefault(nullptr);
+
+    // Take the only pool thread until the dedicated executor has run a task.
+    std::promise<void> dedicatedTaskRan;
+    auto dedicatedTaskRanFuture = dedicatedTaskRan.get_future();
+    pool->post([&dedicatedTaskRanFuture] { dedicatedTaskRanFuture.wait_for(POOLED_TASK_TIMEOUT); });
+    auto future = dedicatedExecutor.submit([&dedicatedTaskRan] { dedicatedTaskRan.set_value(); });
+    EXPECT_EQ(future.wait_for(POOLED_TASK_TIMEOUT), std::future_status::ready);
+    auto pooledFuture = pooledExecutor.submit([] {});
+    EXPECT_EQ(pooledFuture.wait_for(POOLED_TASK_TIMEOUT), std::future_status::ready);
+}
+
+/// The capacity of the bounded executors of the stress tests.
+static const size_t STRESS_CAPACITY = 64;
+
+/// The number of threads submitting tasks at once in the stress tests.
+static const int STRESS_PRODUCERS = 4;
+
+/// The number of tasks each thread submits in the stress tests.
+static const int STRESS_TASKS_PER_PRODUCER = 2500;
+
+/// How long each task of the stress tests takes, so that the producers outpace the executor.
+static const std::chrono::microseconds STRESS_TASK_DURATION(100);
+
+/**
+ * The most time a task may wait to run in the stress tests of the dropping and coalescing policies.  A full queue
+ * takes about `STRESS_CAPACITY * STRESS_TASK_DURATION` to run, while an unbounded queue of all the tasks would take
+ * seconds.
+ */
+static const std::chrono::milliseconds STRESS_MAX_LATENCY(500);
+
+/// The outcome of flooding an executor with tasks.
+struct FloodResult {
+    /// The number of tasks which were accepted, with a valid future.
+    int accepted = 0;
+
+    /// The number of tasks which ran.
+    int ran = 0;
+
+    /// The longest time from the submission of a task to its start.
+    std::chrono::steady_clock::duration maxLatency = std::chrono::steady_clock::duration::zero();
+
+    /// The value of the last task which ran for each producer.
+    std::vector<int> lastValues = std::vector<int>(STRESS_PRODUCERS, -1);
+
+    /// The overload counters once every task was submitted, before waiting for them to run.
+    TaskQueue::OverloadCounters counters;
+};
+
+/**
+ * Floods an executor with tasks submitted from @c STRESS_PRODUCERS threads at once, and waits for it to run them.
+ *
+ * @param executor The executor to flood.
+ * @param coalesce Whether to submit each producer's tasks with its own key.
+ * @return The outcome of the flood.
+ */
+static FloodResult floodExecutor(Executor& executor, bool coalesce) {
+    FloodResult result;
+    std::atomic<int> accepted(0);
+    std::vector<std::thread> producers;
+    for (int producer = 0; producer < STRESS_PRODUCERS; ++producer) {
+        producers.emplace_back([&executor, &result, &accepted, producer, coalesce] {
+            for (int value = 0; value < STRESS_TASKS_PER_PRODUCER; ++value) {
+                auto submitted = std::chrono::steady_clock::now();
+                // The tasks run one at a time, so they can update the result without synchronization.
+                auto task = [&result, producer, value, submitted] {
+                    result.maxLatency = std::max(result.maxLatency, std::chrono::steady_clock::now() - submitted);
+                    result.lastValues[producer] = value;
+                    ++result.ran;
+                    std::this_thread::sleep_for(STRESS_TASK_DURATION);
+                };
+                auto future =
+                    coalesce ? executor.submitCoalesced(std::to_string(producer), task) : executor.submit(task);
+                if (future.valid()) {
+                    ++accepted;
+                }
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    // Waiting queues a task past the capacity, which would count towards the maximum size.
+    result.counters = executor.getOverloadCounters();
+    executor.waitForSubmittedTasks();
+    result.accepted = accepted;
+    return result;
+}
+
+/// This test verifies that a flooded executor under @c OverloadPolicy::BLOCK stays bounded and runs every task.
+TEST_F(ExecutorTest, floodWithBlockPolicy) {
+    Executor boundedExecutor(STRESS_CAPACITY, TaskQueue::OverloadPolicy::BLOCK);
+    auto result = floodExecutor(boundedExecutor, false);
+    auto& counters = result.counters;
+    EXPECT_EQ(result.ran, STRESS_PRODUCERS * STRESS_TASKS_PER_PRODUCER);
+    EXPECT_EQ(result.accepted, result.ran);
+    EXPECT_GT(counters.pushesBlocked, 0u);
+    EXPECT_EQ(counters.tasksDropped, 0u);
+    EXPECT_LE(counters.maxSize, STRESS_CAPACITY);
+}
+
+/// This test verifies that a flooded executor under @c OverloadPolicy::DROP_NEW stays bounded and responsive.
+TEST_F(ExecutorTest, floodWithDropNewPolicy) {
+    Executor boundedExecutor(STRESS_CAPACITY, TaskQueue::OverloadPolicy::DROP_NEW);
+    auto result = floodExecutor(boundedExecutor, false);
+    auto& counters = result.counters;
+    EXPECT_EQ(result.ran, result.accepted);
+    EXPECT_EQ(result.ran + counters.tasksDropped, static_cast<uint64_t>(STRESS_PRODUCERS * STRESS_TASKS_PER_PRODUCER));
+    EXPECT_GT(counters.tasksDropped, 0u);
+    EXPECT_LE(counters.maxSize, STRESS_CAPACITY);
+    EXPECT_LT(result.maxLatency, STRESS_MAX_LATENCY);
+}
+
+/// This test verifies that a flooded executor under @c OverloadPolicy::DROP_OLDEST stays bounded and responsive.
+TEST_F(ExecutorTest, floodWithDropOldestPolicy) {
+    Executor boundedExecutor(STRESS_CAPACITY, TaskQueue::OverloadPolicy::DROP_OLDEST);
+    auto result = floodExecutor(boundedExecutor, false);
+    auto& counters = result.counters;
+    EXPECT_EQ(result.accepted, STRESS_PRODUCERS * STRESS_TASKS_PER_PRODUCER);
+    EXPECT_EQ(result.ran + counters.tasksDropped, static_cast<uint64_t>(STRESS_PRODUCERS * STRESS_TASKS_PER_PRODUCER));
+    EXPECT_GT(counters.tasksDropped, 0u);
+    EXPECT_LE(counters.maxSize, STRESS_CAPACITY);
+    EXPECT_LT(result.maxLatency, STRESS_MAX_LATENCY);
+}
+
+/**
+ * This test verifies that a flooded executor under @c OverloadPolicy::COALESCE holds at most one task per key, and
+ * still runs the latest task of each key.
+ */
+TEST_F(ExecutorTest, floodWithCoalescePolicy) {
+    Executor boundedExecutor(STRESS_CAPACITY, TaskQueue::OverloadPolicy::COALESCE);
+    auto result = floodExecutor(boundedExecutor, true);
+    auto& counters = result.counters;
+    EXPECT_EQ(result.accepted, STRESS_PRODUCERS * STRESS_TASKS_PER_PRODUCER);
+    EXPECT_EQ(
+        result.ran + counters.tasksCoalesced, static_cast<uint64_t>(STRESS_PRODUCERS * STRESS_TASKS_PER_PRODUCER));
+    EXPECT_GT(counters.tasksCoalesced, 0u);
+    EXPECT_EQ(counters.pushesBlocked, 0u);
+    EXPECT_LE(counters.maxSize, static_cast<size_t>(STRESS_PRODUCERS));
+    EXPECT_LT(result.maxLatency, STRESS_MAX_LATENCY);
+    for (auto lastValue : result.lastValues) {
+        EXPECT_EQ(lastValue, STRESS_TASKS_PER_PRODUCER - 1);
+    }
+}
+
+/// This test verifies that waitForSubmittedTasks is not refused by a full executor.
+TEST_F(ExecutorTest, waitForSubmittedTasksWhenFull) {
+    Executor boundedExecutor(1, TaskQueue::OverloadPolicy::DROP_NEW);
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    boundedExecutor.submit([released] { released.wait(); });
+    std::atomic<bool> ran(false);
+    while (!boundedExecutor.submit([&ran] { ran = true; }).valid()) {
+        std::this_thread::yield();
+    }
+    release.set_value();
+    boundedExecutor.waitForSubmittedTasks();
+    EXPECT_TRUE(ran);
+}
+
+/**
+ * This test verifies that a pool thread is not blocked by a full executor under @c OverloadPolicy::BLOCK, which would
+ * starve a pool whose only thread is needed to make room.
+ */
+TEST_F(ExecutorTest, poolThreadNotBlockedByFullExecutor) {
+    auto pool = ThreadPool::create(1);
+    ASSERT_TRUE(pool);
+    Executor boundedExecutor(1, TaskQueue::OverloadPolicy::BLOCK, pool);
+    Executor submittingExecutor(pool);
+    std::atomic<int> ran(0);
+    auto submitted = submittingExecutor.submit([&boundedExecutor, &ran] {
+        for (int i = 0; i < TASKS_PER_EXECUTOR; ++i) {
+            boundedExecutor.submit([&ran] { ++ran; });
+        }
+    });
+    ASSERT_EQ(submitted.wait_for(POOLED_TASK_TIMEOUT), std::future_status::ready);
+    boundedExecutor.waitForSubmittedTasks();
+    EXPECT_EQ(ran, TASKS_PER_EXECUTOR);
+    EXPECT_EQ(boundedExecutor.getOverloadCounters().pushesBlocked, 0u);
+}
+
 }  // namespace test
 }  // namespace threading
 }  // namespace utils
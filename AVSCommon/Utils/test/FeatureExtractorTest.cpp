@@ -0,0 +1,167 @@
+/*
+ * FeatureExtractorTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file FeatureExtractorTest.cpp
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "AVSCommon/Utils/Audio/FeatureExtractor.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace audio {
+namespace test {
+
+/// The frame size used by the tests.
+static const size_t FRAME_SIZE = 512;
+
+/// The sample rate used by the tests.
+static const unsigned int SAMPLE_RATE_HZ = 16000;
+
+/// The amplitude of test tones, as a fraction of full scale.
+static const double AMPLITUDE = 0.5;
+
+/// Pi.
+static const double PI = 3.14159265358979323846;
+
+/**
+ * Generate a frame of a sine wave.
+ *
+ * @param frequencyHz The frequency of the tone.
+ * @return The samples of the frame.
+ */
+static std::vector<int16_t> generateTone(double frequencyHz) {
+    std::vector<int16_t> samples(FRAME_SIZE);
+    for (size_t i = 0; i < FRAME_SIZE; ++i) {
+        auto phase = 2 * PI * frequencyHz * i / SAMPLE_RATE_HZ;
+        samples[i] = static_cast<int16_t>(std::lround(AMPLITUDE * 32768 * std::sin(phase)));
+    }
+    return samples;
+}
+
+/**
+ * Verify that invalid frame sizes and sample rates are rejected.
+ */
+TEST(FeatureExtractorTest, createWithInvalidParameters) {
+    EXPECT_EQ(FeatureExtractor::create(0, SAMPLE_RATE_HZ), nullptr);
+    EXPECT_EQ(FeatureExtractor::create(FeatureExtractor::MIN_FRAME_SIZE / 2, SAMPLE_RATE_HZ), nullptr);
+    EXPECT_EQ(FeatureExtractor::create(FRAME_SIZE + 1, SAMPLE_RATE_HZ), nullptr);
+    EXPECT_EQ(FeatureExtractor::create(FRAME_SIZE, 0), nullptr);
+    EXPECT_NE(FeatureExtractor::create(FeatureExtractor::MIN_FRAME_SIZE, SAMPLE_RATE_HZ), nullptr);
+}
+
+/**
+ * Verify that a frame of silence has no energy in total or in any band, and no zero crossings.
+ */
+TEST(FeatureExtractorTest, silence) {
+    auto extractor = FeatureExtractor::create(FRAME_SIZE, SAMPLE_RATE_HZ);
+    ASSERT_NE(extractor, nullptr);
+    std::vector<int16_t> samples(FRAME_SIZE, 0);
+    AudioFeatures features;
+    extractor->extract(samples.data(), &features);
+    EXPECT_TRUE(features.isValid);
+    EXPECT_EQ(features.energy, 0.0f);
+    EXPECT_EQ(features.zeroCrossingRate, 0.0f);
+    for (auto bandEnergy : features.bandEnergies) {
+        EXPECT_EQ(bandEnergy, 0.0f);
+    }
+}
+
+/**
+ * Verify the energy, zero crossing rate and band energies of a tone: the energy is half the square of the amplitude,
+ * a tone crosses zero twice per period, and the band containing the tone holds most of its energy.
+ */
+TEST(FeatureExtractorTest, tone) {
+    // A tone whose samples never land exactly on zero, which would not count as a crossing.
+    static const double FREQUENCY_HZ = 1234;
+    auto extractor = FeatureExtractor::create(FRAME_SIZE, SAMPLE_RATE_HZ);
+    ASSERT_NE(extractor, nullptr);
+    auto samples = generateTone(FREQUENCY_HZ);
+    AudioFeatures features;
+    extractor->extract(samples.data(), &features);
+
+    EXPECT_NEAR(features.energy, AMPLITUDE * AMPLITUDE / 2, 0.01);
+    EXPECT_NEAR(features.zeroCrossingRate, 2 * FREQUENCY_HZ / SAMPLE_RATE_HZ, 0.01);
+
+    size_t peakBand = 0;
+    float totalBandEnergy = 0;
+    for (size_t band = 0; band < AudioFeatures::NUM_BANDS; ++band) {
+        totalBandEnergy += features.bandEnergies[band];
+        if (features.bandEnergies[band] > features.bandEnergies[peakBand]) {
+            peakBand = band;
+        }
+    }
+    EXPECT_GT(features.bandEnergies[peakBand], 0.5 * totalBandEnergy);
+    EXPECT_NEAR(totalBandEnergy, features.energy, 0.1 * features.energy);
+
+    // A tone an octave up peaks in a higher band.
+    extractor->extract(generateTone(2 * FREQUENCY_HZ).data(), &features);
+    size_t higherPeakBand = 0;
+    for (size_t band = 0; band < AudioFeatures::NUM_BANDS; ++band) {
+        if (features.bandEnergies[band] > features.bandEnergies[higherPeakBand]) {
+            higherPeakBand = band;
+        }
+    }
+    EXPECT_GT(higherPeakBand, peakBand);
+}
+
+/**
+ * Verify that the power spectrum matches a direct DFT of the Hann windowed frame.
+ */
+TEST(FeatureExtractorTest, powerSpectrumMatchesDft) {
+    auto extractor = FeatureExtractor::create(FRAME_SIZE, SAMPLE_RATE_HZ);
+    ASSERT_NE(extractor, nullptr);
+    std::vector<int16_t> samples(FRAME_SIZE);
+    unsigned int seed = 1;
+    for (auto& sample : samples) {
+        seed = seed * 1103515245 + 12345;
+        sample = static_cast<int16_t>(seed >> 16);
+    }
+    AudioFeatures features;
+    extractor->extract(samples.data(), &features);
+    auto& powerSpectrum = extractor->getPowerSpectrum();
+    ASSERT_EQ(powerSpectrum.size(), FRAME_SIZE / 2 + 1);
+
+    double maxPower = 0;
+    std::vector<double> expected(FRAME_SIZE / 2 + 1);
+    for (size_t bin = 0; bin < expected.size(); ++bin) {
+        double real = 0;
+        double imaginary = 0;
+        for (size_t i = 0; i < FRAME_SIZE; ++i) {
+            double window = 0.5 - 0.5 * std::cos(2 * PI * i / FRAME_SIZE);
+            double sample = window * samples[i] / 32768;
+            real += sample * std::cos(2 * PI * bin * i / FRAME_SIZE);
+            imaginary -= sample * std::sin(2 * PI * bin * i / FRAME_SIZE);
+        }
+        expected[bin] = real * real + imaginary * imaginary;
+        maxPower = std::max(maxPower, expected[bin]);
+    }
+    for (size_t bin = 0; bin < expected.size(); ++bin) {
+        EXPECT_NEAR(powerSpectrum[bin], expected[bin], 1e-4 * maxPower) << "bin " << bin;
+    }
+}
+
+}  // namespace test
+}  // namespace audio
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -0,0 +1,202 @@
+/*
+ * ManualClockTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file ManualClockTest.cpp
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "AVSCommon/Utils/Timing/ManualClock.h"
+#include "AVSCommon/Utils/Timing/TimeUtils.h"
+#include "AVSCommon/Utils/Timing/Timer.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace timing {
+namespace test {
+
+/// A delay far longer than any test may take in real time.
+static const auto LONG_DELAY = std::chrono::hours(1);
+
+/// The real time to allow a timer thread to react to a change.
+static const auto REACTION_TIME = std::chrono::milliseconds(100);
+
+/**
+ * Used to limit the amount of real time tests will wait for an operation to finish.  This timeout will only be hit if
+ * a test is failing.
+ */
+static const auto TIMEOUT = std::chrono::seconds(2);
+
+/// Test harness for @c ManualClock, and for @c Timer driven by a @c ManualClock.
+class ManualClockTest : public ::testing::Test {
+public:
+    /// Set up the test harness for running a test.
+    void SetUp() override;
+
+    /// Restore the default clock.
+    void TearDown() override;
+
+protected:
+    /**
+     * Wait in real time for @c m_calls to reach a count.
+     *
+     * @param count The count to wait for.
+     * @return Whether @c m_calls reached @c count before @c TIMEOUT.
+     */
+    bool waitForCalls(int count);
+
+    /// The clock under test.
+    std::shared_ptr<ManualClock> m_clock;
+
+    /// The number of timer task calls made.
+    std::atomic<int> m_calls;
+};
+
+void ManualClockTest::SetUp() {
+    m_clock = std::make_shared<ManualClock>();
+    m_calls = 0;
+}
+
+void ManualClockTest::TearDown() {
+    Clock::setDefault(nullptr);
+}
+
+bool ManualClockTest::waitForCalls(int count) {
+    auto deadline = std::chrono::steady_clock::now() + TIMEOUT;
+    while (m_calls < count) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+/**
+ * Verify that the time only moves when advanced, and that both the steady and system times move together.
+ */
+TEST_F(ManualClockTest, timeOnlyMovesWhenAdvanced) {
+    auto steady = m_clock->steadyNow();
+    auto system = m_clock->systemNow();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_EQ(m_clock->steadyNow(), steady);
+    EXPECT_EQ(m_clock->systemNow(), system);
+
+    m_clock->advance(LONG_DELAY);
+    EXPECT_EQ(m_clock->steadyNow() - steady, LONG_DELAY);
+    EXPECT_EQ(m_clock->systemNow() - system, LONG_DELAY);
+
+    m_clock->setSystemTime(system);
+    EXPECT_EQ(m_clock->systemNow(), system);
+    EXPECT_EQ(m_clock->steadyNow() - steady, LONG_DELAY);
+}
+
+/**
+ * Verify that a single shot @c Timer with an hour long delay fires as soon as the clock passes its deadline, and not
+ * before.
+ */
+TEST_F(ManualClockTest, singleShotFiresWhenAdvancedPastDeadline) {
+    Timer timer(m_clock);
+    auto future = timer.start(LONG_DELAY, [this] { ++m_calls; });
+    ASSERT_TRUE(future.valid());
+
+    m_clock->advance(LONG_DELAY - std::chrono::seconds(1));
+    std::this_thread::sleep_for(REACTION_TIME);
+    EXPECT_EQ(m_calls, 0);
+    EXPECT_TRUE(timer.isActive());
+
+    m_clock->advance(std::chrono::seconds(1));
+    ASSERT_EQ(future.wait_for(TIMEOUT), std::future_status::ready);
+    EXPECT_EQ(m_calls, 1);
+}
+
+/**
+ * Verify that a periodic @c Timer makes one task call per period the clock is advanced by.
+ */
+TEST_F(ManualClockTest, periodicTimerFiresOncePerPeriod) {
+    static const int ITERATIONS = 5;
+    Timer timer(m_clock);
+    ASSERT_TRUE(timer.start(LONG_DELAY, Timer::PeriodType::ABSOLUTE, ITERATIONS, [this] { ++m_calls; }));
+
+    for (int i = 1; i <= ITERATIONS; ++i) {
+        m_clock->advance(LONG_DELAY);
+        ASSERT_TRUE(waitForCalls(i));
+    }
+    std::this_thread::sleep_for(REACTION_TIME);
+    EXPECT_EQ(m_calls, ITERATIONS);
+    EXPECT_FALSE(timer.isActive());
+}
+
+/**
+ * Verify that stopping a @c Timer waiting on a @c ManualClock does not depend on the clock advancing.
+ */
+TEST_F(ManualClockTest, stopDoesNotNeedTimeToAdvance) {
+    Timer timer(m_clock);
+    auto future = timer.start(LONG_DELAY, [this] { ++m_calls; });
+    ASSERT_TRUE(future.valid());
+
+    auto start = std::chrono::steady_clock::now();
+    timer.stop();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, TIMEOUT);
+    EXPECT_FALSE(timer.isActive());
+    EXPECT_EQ(m_calls, 0);
+}
+
+/**
+ * Verify that timers created without a clock, and the current Unix time, follow the default clock.
+ */
+TEST_F(ManualClockTest, defaultClockIsUsed) {
+    Clock::setDefault(m_clock);
+    Timer timer;
+    auto future = timer.start(LONG_DELAY, [this] { ++m_calls; });
+    ASSERT_TRUE(future.valid());
+
+    int64_t before = 0;
+    ASSERT_TRUE(getCurrentUnixTime(&before));
+    m_clock->advance(LONG_DELAY);
+    ASSERT_EQ(future.wait_for(TIMEOUT), std::future_status::ready);
+
+    int64_t after = 0;
+    ASSERT_TRUE(getCurrentUnixTime(&after));
+    EXPECT_EQ(after - before, std::chrono::duration_cast<std::chrono::seconds>(LONG_DELAY).count());
+}
+
+/**
+ * Verify that @c advanceUntil() steps the clock until its condition holds, and gives up at its limit.
+ */
+TEST_F(ManualClockTest, advanceUntil) {
+    Timer timer(m_clock);
+    ASSERT_TRUE(timer.start(std::chrono::minutes(1), Timer::PeriodType::ABSOLUTE, Timer::FOREVER, [this] {
+        ++m_calls;
+    }));
+    auto start = m_clock->steadyNow();
+    EXPECT_TRUE(m_clock->advanceUntil([this] { return m_calls >= 3; }, std::chrono::seconds(10), LONG_DELAY));
+    EXPECT_GE(m_clock->steadyNow() - start, std::chrono::minutes(3));
+    EXPECT_LT(m_clock->steadyNow() - start, LONG_DELAY);
+
+    EXPECT_FALSE(m_clock->advanceUntil([] { return false; }, std::chrono::minutes(1), std::chrono::minutes(3)));
+}
+
+}  // namespace test
+}  // namespace timing
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -22,6 +22,9 @@
 #include <climits>
 #include <algorithm>
 #include <functional>
+#include <iostream>
+#include <mutex>
+#include <thread>
 #include <unordered_map>
 
 #include <gtest/gtest.h>
@@ -96,6 +99,14 @@ public:
         InProcessSDS::AtomicIndex::operator+=(rhs);
         return *this;
     }
+    /// Add to the atomic value, returning the previous value.
+    InProcessSDS::Index fetch_add(const InProcessSDS::Index& rhs) {
+        return InProcessSDS::AtomicIndex::fetch_add(rhs);
+    }
+    /// Replace the atomic value if it equals @c expected, else load it into @c expected.
+    bool compare_exchange_strong(InProcessSDS::Index& expected, const InProcessSDS::Index& desired) {
+        return InProcessSDS::AtomicIndex::compare_exchange_strong(expected, desired);
+    }
 };
 
 /// An @c AtomicBool type with the minimum functionality required by SDS.
@@ -895,6 +906,49 @@ TEST_F(SharedDataStreamTest, readerClose) {
     ASSERT_EQ(reader->read(readBuf, readWords), Sds::Reader::Error::CLOSED);
 }
 
+/// This tests that @c SharedDataStream::Reader::close() wakes a @c BLOCKING @c Reader blocked in @c read().
+TEST_F(SharedDataStreamTest, readerCloseWakesBlockedReader) {
+    static const size_t WORDSIZE = 2;
+    static const size_t WORDCOUNT = 10;
+    static const size_t MAXREADERS = 2;
+    static const std::chrono::milliseconds CLOSE_DELAY{20};
+    static const std::chrono::seconds LONG_TIMEOUT{10};
+
+    // Initialize an sds.
+    size_t bufferSize = Sds::calculateBufferSize(WORDCOUNT, WORDSIZE, MAXREADERS);
+    auto buffer = std::make_shared<Sds::Buffer>(bufferSize);
+    auto sds = Sds::create(buffer, WORDSIZE, MAXREADERS);
+    ASSERT_NE(sds, nullptr);
+
+    auto writer = sds->createWriter(Sds::Writer::Policy::NONBLOCKABLE);
+    ASSERT_NE(writer, nullptr);
+    auto reader = sds->createReader(Sds::Reader::Policy::BLOCKING);
+    ASSERT_NE(reader, nullptr);
+    reader->setWakeThreshold(WORDCOUNT);
+
+    // Verify that a reader blocked with no data, or waiting for more data than it will be allowed to read, returns
+    // as soon as it is closed rather than at its timeout.
+    uint8_t readBuf[WORDSIZE * WORDCOUNT];
+    auto closeThread = std::async(std::launch::async, [&reader]() {
+        std::this_thread::sleep_for(CLOSE_DELAY);
+        reader->close(1);
+    });
+    uint8_t writeBuf[WORDSIZE * WORDCOUNT] = {};
+    ASSERT_EQ(writer->write(writeBuf, 2), 2);
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(reader->read(readBuf, WORDCOUNT, LONG_TIMEOUT), 1);
+    closeThread.wait();
+
+    auto idleReader = sds->createReader(Sds::Reader::Policy::BLOCKING, true);
+    ASSERT_NE(idleReader, nullptr);
+    closeThread = std::async(std::launch::async, [&idleReader]() {
+        std::this_thread::sleep_for(CLOSE_DELAY);
+        idleReader->close();
+    });
+    EXPECT_EQ(idleReader->read(readBuf, WORDCOUNT, LONG_TIMEOUT), Sds::Reader::Error::CLOSED);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, LONG_TIMEOUT);
+}
+
 /// This tests @c SharedDataStream::Reader::getId().
 TEST_F(SharedDataStreamTest, readerGetId) {
     static const size_t WORDSIZE = 1;
@@ -1248,6 +1302,444 @@ TEST_F(SharedDataStreamTest, writerClosedBeforeAttachingReader) {
     ASSERT_EQ(error, Sds::Reader::Error::CLOSED);
 }
 
+/// This tests that a @c BLOCKING @c Reader with a wake threshold waits for that many words, or for the stream to end.
+TEST_F(SharedDataStreamTest, readerWakeThreshold) {
+    static const size_t WORDSIZE = 2;
+    static const size_t WORDCOUNT = 16;
+    static const size_t MAXREADERS = 2;
+    static const size_t THRESHOLD = 4;
+    static const std::chrono::milliseconds WRITE_INTERVAL{5};
+    static const std::chrono::milliseconds SHORT_TIMEOUT{20};
+
+    // Initialize an sds.
+    size_t bufferSize = Sds::calculateBufferSize(WORDCOUNT, WORDSIZE, MAXREADERS);
+    auto buffer = std::make_shared<Sds::Buffer>(bufferSize);
+    auto sds = Sds::create(buffer, WORDSIZE, MAXREADERS);
+    ASSERT_NE(sds, nullptr);
+
+    auto writer = sds->createWriter(Sds::Writer::Policy::NONBLOCKABLE);
+    ASSERT_NE(writer, nullptr);
+    auto framed = sds->createReader(Sds::Reader::Policy::BLOCKING);
+    ASSERT_NE(framed, nullptr);
+    framed->setWakeThreshold(THRESHOLD);
+    auto unframed = sds->createReader(Sds::Reader::Policy::BLOCKING);
+    ASSERT_NE(unframed, nullptr);
+
+    // Verify that a reader with a threshold waits for a whole frame of single word writes, while one without a
+    // threshold does not.
+    uint8_t writeBuf[WORDSIZE * WORDCOUNT] = {};
+    auto writeThread = std::async(std::launch::async, [&writer, &writeBuf]() {
+        for (size_t i = 0; i < THRESHOLD; ++i) {
+            std::this_thread::sleep_for(WRITE_INTERVAL);
+            writer->write(writeBuf, 1);
+        }
+    });
+    uint8_t readBuf[WORDSIZE * WORDCOUNT];
+    EXPECT_EQ(unframed->read(readBuf, WORDCOUNT), 1);
+    EXPECT_EQ(framed->read(readBuf, WORDCOUNT), static_cast<ssize_t>(THRESHOLD));
+    writeThread.wait();
+
+    // Verify that the threshold is capped at the number of words requested.
+    ASSERT_EQ(writer->write(writeBuf, 2), 2);
+    EXPECT_EQ(framed->read(readBuf, 2), 2);
+
+    // Verify that a read which times out returns the words which did arrive, or TIMEDOUT if none did.
+    EXPECT_EQ(framed->read(readBuf, WORDCOUNT, SHORT_TIMEOUT), Sds::Reader::Error::TIMEDOUT);
+    ASSERT_EQ(writer->write(writeBuf, 1), 1);
+    EXPECT_EQ(framed->read(readBuf, WORDCOUNT, SHORT_TIMEOUT), 1);
+
+    // Verify that closing the writer wakes a reader waiting for a partial frame, which then gets the partial frame.
+    ASSERT_EQ(writer->write(writeBuf, 1), 1);
+    auto closeThread = std::async(std::launch::async, [&writer]() {
+        std::this_thread::sleep_for(WRITE_INTERVAL);
+        writer->close();
+    });
+    EXPECT_EQ(framed->read(readBuf, WORDCOUNT), 1);
+    EXPECT_EQ(framed->read(readBuf, WORDCOUNT), Sds::Reader::Error::CLOSED);
+}
+
+/// This tests that a @c Reader's @c ReadinessNotifier is signalled by writes and by the @c Writer closing.
+TEST_F(SharedDataStreamTest, readerReadinessNotifier) {
+    static const size_t WORDSIZE = 2;
+    static const size_t WORDCOUNT = 4;
+    static const size_t MAXREADERS = 2;
+    static const std::chrono::milliseconds SIGNAL_TIMEOUT{2000};
+    static const std::chrono::milliseconds NO_SIGNAL_TIMEOUT{10};
+
+    // Initialize an sds.
+    size_t bufferSize = Sds::calculateBufferSize(WORDCOUNT, WORDSIZE, MAXREADERS);
+    auto buffer = std::make_shared<Sds::Buffer>(bufferSize);
+    auto sds = Sds::create(buffer, WORDSIZE, MAXREADERS);
+    ASSERT_NE(sds, nullptr);
+
+    auto writer = sds->createWriter(Sds::Writer::Policy::NONBLOCKABLE);
+    ASSERT_NE(writer, nullptr);
+    auto reader = sds->createReader(Sds::Reader::Policy::NONBLOCKING);
+    ASSERT_NE(reader, nullptr);
+
+    // Verify that the notifier starts signalled, and is the same on every call.
+    auto notifier = reader->getReadinessNotifier();
+    ASSERT_NE(notifier, nullptr);
+    EXPECT_EQ(reader->getReadinessNotifier(), notifier);
+    EXPECT_TRUE(notifier->waitUntilSignalled(NO_SIGNAL_TIMEOUT));
+    notifier->clear();
+    EXPECT_FALSE(notifier->waitUntilSignalled(NO_SIGNAL_TIMEOUT));
+
+    // Verify that a write from another thread wakes a waiter, and that signals coalesce until cleared.
+    uint8_t buf[WORDSIZE * WORDCOUNT] = {};
+    auto writeThread = std::async(std::launch::async, [&writer, &buf]() {
+        writer->write(buf, 1);
+        writer->write(buf, 1);
+    });
+    EXPECT_TRUE(notifier->waitUntilSignalled(SIGNAL_TIMEOUT));
+    writeThread.wait();
+    notifier->clear();
+    EXPECT_FALSE(notifier->waitUntilSignalled(NO_SIGNAL_TIMEOUT));
+    EXPECT_EQ(reader->read(buf, WORDCOUNT), 2);
+    EXPECT_EQ(reader->read(buf, WORDCOUNT), Sds::Reader::Error::WOULDBLOCK);
+
+    // Verify that closing the writer signals the notifier, and that the reader then sees the stream closed.
+    writer->close();
+    EXPECT_TRUE(notifier->waitUntilSignalled(SIGNAL_TIMEOUT));
+    EXPECT_EQ(reader->read(buf, WORDCOUNT), Sds::Reader::Error::CLOSED);
+}
+
+/// This tests that a destroyed @c Reader's @c ReadinessNotifier is no longer signalled.
+TEST_F(SharedDataStreamTest, readerReadinessNotifierOutlivesReader) {
+    static const size_t WORDSIZE = 1;
+    static const size_t WORDCOUNT = 1;
+    static const size_t MAXREADERS = 1;
+    static const std::chrono::milliseconds NO_SIGNAL_TIMEOUT{10};
+
+    size_t bufferSize = Sds::calculateBufferSize(WORDCOUNT, WORDSIZE, MAXREADERS);
+    auto buffer = std::make_shared<Sds::Buffer>(bufferSize);
+    auto sds = Sds::create(buffer, WORDSIZE, MAXREADERS);
+    ASSERT_NE(sds, nullptr);
+
+    auto writer = sds->createWriter(Sds::Writer::Policy::NONBLOCKABLE);
+    ASSERT_NE(writer, nullptr);
+    auto reader = sds->createReader(Sds::Reader::Policy::NONBLOCKING);
+    ASSERT_NE(reader, nullptr);
+    auto notifier = reader->getReadinessNotifier();
+    ASSERT_NE(notifier, nullptr);
+    notifier->clear();
+    reader.reset();
+
+    uint8_t buf[WORDSIZE * WORDCOUNT] = {};
+    EXPECT_EQ(writer->write(buf, WORDCOUNT), static_cast<ssize_t>(WORDCOUNT));
+    EXPECT_FALSE(notifier->waitUntilSignalled(NO_SIGNAL_TIMEOUT));
+}
+
+/**
+ * Encode a word written by one of several concurrent @c Writers, so that a @c Reader can verify where it came from.
+ *
+ * @param writerId The id of the writer.
+ * @param sequence The position of the word among those the writer wrote.
+ * @param isFirst Whether this is the first word of a @c write() call.
+ * @return The encoded word.
+ */
+static uint64_t encodeWriterWord(uint64_t writerId, uint64_t sequence, bool isFirst) {
+    return (writerId << 40) | (static_cast<uint64_t>(isFirst) << 32) | sequence;
+}
+
+/**
+ * Write @c numWords encoded words to a stream in writes of varying sizes, then close the @c Writer.
+ *
+ * @param writer The @c Writer to write with.
+ * @param writerId The id to encode in the words.
+ * @param numWords The number of words to write.
+ */
+static void writeEncodedWords(Sds::Writer* writer, uint64_t writerId, size_t numWords) {
+    static const size_t MAX_WRITE_WORDS = 7;
+    std::vector<uint64_t> block(MAX_WRITE_WORDS);
+    size_t sequence = 0;
+    while (sequence < numWords) {
+        size_t wordsToWrite = std::min(1 + sequence % MAX_WRITE_WORDS, numWords - sequence);
+        for (size_t i = 0; i < wordsToWrite; ++i) {
+            block[i] = encodeWriterWord(writerId, sequence + i, 0 == i);
+        }
+        auto written = writer->write(block.data(), wordsToWrite, std::chrono::seconds(5));
+        if (Sds::Writer::Error::WOULDBLOCK == written) {
+            std::this_thread::yield();
+            continue;
+        }
+        ASSERT_GT(written, 0);
+        sequence += written;
+    }
+    writer->close();
+}
+
+/**
+ * Read a stream written with @c writeEncodedWords() until it closes, and verify that the words from each @c Writer
+ * arrive in order, and that the words of each @c write() call are contiguous.
+ *
+ * @param reader The @c Reader to read with.
+ * @param numWriters The number of writers.
+ * @param wordsPerWriter The number of words each writer wrote.
+ */
+static void verifyEncodedWords(Sds::Reader* reader, size_t numWriters, size_t wordsPerWriter) {
+    std::vector<uint64_t> nextSequence(numWriters, 0);
+    uint64_t previousWriterId = numWriters;
+    std::vector<uint64_t> block(64);
+    while (true) {
+        auto read = reader->read(block.data(), block.size(), std::chrono::seconds(5));
+        if (Sds::Reader::Error::CLOSED == read) {
+            break;
+        }
+        ASSERT_GT(read, 0);
+        for (ssize_t i = 0; i < read; ++i) {
+            uint64_t writerId = block[i] >> 40;
+            bool isFirst = (block[i] >> 32) & 1;
+            uint64_t sequence = block[i] & 0xffffffff;
+            ASSERT_LT(writerId, numWriters);
+            ASSERT_EQ(sequence, nextSequence[writerId]);
+            if (!isFirst) {
+                ASSERT_EQ(writerId, previousWriterId);
+            }
+            ++nextSequence[writerId];
+            previousWriterId = writerId;
+        }
+    }
+    for (size_t id = 0; id < numWriters; ++id) {
+        EXPECT_EQ(nextSequence[id], wordsPerWriter);
+    }
+}
+
+/// This tests creating and closing the @c Writers of a stream which allows several.
+TEST_F(SharedDataStreamTest, multipleWritersCreateAndClose) {
+    static const size_t WORDSIZE = 1;
+    static const size_t WORDCOUNT = 4;
+    static const size_t MAXREADERS = 1;
+    static const size_t MAXWRITERS = 2;
+
+    // A stream must allow at least one writer.
+    auto buffer = std::make_shared<Sds::Buffer>(Sds::calculateBufferSize(WORDCOUNT, WORDSIZE, MAXREADERS, 0));
+    ASSERT_EQ(Sds::create(buffer, WORDSIZE, MAXREADERS, 0), nullptr);
+
+    buffer = std::make_shared<Sds::Buffer>(Sds::calculateBufferSize(WORDCOUNT, WORDSIZE, MAXREADERS, MAXWRITERS));
+    auto sds = Sds::create(buffer, WORDSIZE, MAXREADERS, MAXWRITERS);
+    ASSERT_NE(sds, nullptr);
+    ASSERT_EQ(sds->getMaxWriters(), MAXWRITERS);
+    ASSERT_EQ(sds->getDataSize(), WORDCOUNT);
+    ASSERT_EQ(Sds::open(buffer)->getMaxWriters(), MAXWRITERS);
+
+    // Verify that no more than maxWriters writers can be open at once.
+    auto writer1 = sds->createWriter(Sds::Writer::Policy::NONBLOCKABLE);
+    ASSERT_NE(writer1, nullptr);
+    auto writer2 = sds->createWriter(Sds::Writer::Policy::ALL_OR_NOTHING);
+    ASSERT_NE(writer2, nullptr);
+    ASSERT_EQ(sds->createWriter(Sds::Writer::Policy::NONBLOCKABLE), nullptr);
+    auto reader = sds->createReader(Sds::Reader::Policy::NONBLOCKING);
+    ASSERT_NE(reader, nullptr);
+
+    // Verify that the stream stays open until the last writer closes, and that a closed writer can't write.
+    uint8_t buf[WORDCOUNT] = {1, 2, 3, 4};
+    ASSERT_EQ(writer1->write(buf, 1), 1);
+    writer1->close();
+    ASSERT_EQ(writer1->write(buf, 1), Sds::Writer::Error::CLOSED);
+    ASSERT_EQ(writer2->write(buf + 1, 2), 2);
+    ASSERT_EQ(reader->read(buf, WORDCOUNT), 3);
+    ASSERT_EQ(buf[0], 1);
+    ASSERT_EQ(buf[1], 2);
+    ASSERT_EQ(buf[2], 3);
+    ASSERT_EQ(reader->read(buf, WORDCOUNT), Sds::Reader::Error::WOULDBLOCK);
+
+    // Verify that the slot of a closed writer can be reused.
+    writer1 = sds->createWriter(Sds::Writer::Policy::NONBLOCKABLE);
+    ASSERT_NE(writer1, nullptr);
+    writer1->close();
+    writer2->close();
+    ASSERT_EQ(reader->read(buf, WORDCOUNT), Sds::Reader::Error::CLOSED);
+}
+
+/**
+ * This tests several blocking and all-or-nothing @c Writers streaming concurrently through a small stream to a
+ * blocking @c Reader, which must receive every write whole and in order.
+ */
+TEST_F(SharedDataStreamTest, concurrencyMultipleBlockingWriters) {
+    static const size_t WORDSIZE = sizeof(uint64_t);
+    static const size_t WORDCOUNT = 32;
+    static const size_t MAXREADERS = 1;
+    static const size_t MAXWRITERS = 4;
+    static const size_t WORDS_PER_WRITER = 20000;
+
+    auto buffer = std::make_shared<Sds::Buffer>(Sds::calculateBufferSize(WORDCOUNT, WORDSIZE, MAXREADERS, MAXWRITERS));
+    auto sds = Sds::create(buffer, WORDSIZE, MAXREADERS, MAXWRITERS);
+    ASSERT_NE(sds, nullptr);
+    auto reader = sds->createReader(Sds::Reader::Policy::BLOCKING);
+    ASSERT_NE(reader, nullptr);
+
+    std::vector<std::unique_ptr<Sds::Writer>> writers;
+    for (size_t id = 0; id < MAXWRITERS; ++id) {
+        writers.push_back(sds->createWriter(
+            id % 2 ? Sds::Writer::Policy::BLOCKING : Sds::Writer::Policy::ALL_OR_NOTHING));
+        ASSERT_NE(writers.back(), nullptr);
+    }
+    std::vector<std::thread> threads;
+    for (size_t id = 0; id < MAXWRITERS; ++id) {
+        threads.emplace_back(writeEncodedWords, writers[id].get(), id, WORDS_PER_WRITER);
+    }
+    verifyEncodedWords(reader.get(), MAXWRITERS, WORDS_PER_WRITER);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+/**
+ * This tests several nonblockable @c Writers claiming space without locks, into a stream large enough to hold all of
+ * their data, which a @c Reader must then find whole and in order.
+ */
+TEST_F(SharedDataStreamTest, concurrencyMultipleNonblockableWriters) {
+    static const size_t WORDSIZE = sizeof(uint64_t);
+    static const size_t MAXREADERS = 1;
+    static const size_t MAXWRITERS = 4;
+    static const size_t WORDS_PER_WRITER = 5000;
+    static const size_t WORDCOUNT = MAXWRITERS * WORDS_PER_WRITER;
+
+    auto buffer = std::make_shared<Sds::Buffer>(Sds::calculateBufferSize(WORDCOUNT, WORDSIZE, MAXREADERS, MAXWRITERS));
+    auto sds = Sds::create(buffer, WORDSIZE, MAXREADERS, MAXWRITERS);
+    ASSERT_NE(sds, nullptr);
+
+    std::vector<std::unique_ptr<Sds::Writer>> writers;
+    for (size_t id = 0; id < MAXWRITERS; ++id) {
+        writers.push_back(sds->createWriter(Sds::Writer::Policy::NONBLOCKABLE));
+        ASSERT_NE(writers.back(), nullptr);
+    }
+    std::vector<std::thread> threads;
+    for (size_t id = 0; id < MAXWRITERS; ++id) {
+        threads.emplace_back(writeEncodedWords, writers[id].get(), id, WORDS_PER_WRITER);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    ASSERT_EQ(writers[0]->tell(), WORDCOUNT);
+
+    auto reader = sds->createReader(Sds::Reader::Policy::NONBLOCKING);
+    ASSERT_NE(reader, nullptr);
+    verifyEncodedWords(reader.get(), MAXWRITERS, WORDS_PER_WRITER);
+}
+
+/**
+ * This tests several nonblockable @c Writers whose writes are each larger than half the stream, so that two writes in
+ * progress at once would share words of the ring.  Whichever order they are copied in, the newest data left in the
+ * stream must be whole.
+ */
+TEST_F(SharedDataStreamTest, concurrencyOverlappingNonblockableWriters) {
+    static const size_t WORDSIZE = sizeof(uint64_t);
+    static const size_t MAXREADERS = 1;
+    static const size_t MAXWRITERS = 4;
+    static const size_t WORDCOUNT = 1000;
+    static const size_t WORDS_PER_WRITE = WORDCOUNT * 3 / 4;
+    static const size_t WRITES_PER_WRITER = 200;
+
+    auto buffer = std::make_shared<Sds::Buffer>(Sds::calculateBufferSize(WORDCOUNT, WORDSIZE, MAXREADERS, MAXWRITERS));
+    auto sds = Sds::create(buffer, WORDSIZE, MAXREADERS, MAXWRITERS);
+    ASSERT_NE(sds, nullptr);
+
+    std::vector<std::unique_ptr<Sds::Writer>> writers;
+    for (size_t id = 0; id < MAXWRITERS; ++id) {
+        writers.push_back(sds->createWriter(Sds::Writer::Policy::NONBLOCKABLE));
+        ASSERT_NE(writers.back(), nullptr);
+    }
+    auto writeBlocks = [](Sds::Writer* writer, uint64_t writerId) {
+        std::vector<uint64_t> block(WORDS_PER_WRITE);
+        for (size_t sequence = 0; sequence < WRITES_PER_WRITER * WORDS_PER_WRITE; sequence += WORDS_PER_WRITE) {
+            for (size_t i = 0; i < WORDS_PER_WRITE; ++i) {
+                block[i] = encodeWriterWord(writerId, sequence + i, 0 == i);
+            }
+            ASSERT_EQ(writer->write(block.data(), block.size()), static_cast<ssize_t>(WORDS_PER_WRITE));
+        }
+    };
+    std::vector<std::thread> threads;
+    for (size_t id = 0; id < MAXWRITERS; ++id) {
+        threads.emplace_back(writeBlocks, writers[id].get(), id);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    ASSERT_EQ(writers[0]->tell(), MAXWRITERS * WRITES_PER_WRITER * WORDS_PER_WRITE);
+
+    // Every word in the stream must follow on from the one before it, unless it starts a write.
+    auto reader = sds->createReader(Sds::Reader::Policy::NONBLOCKING);
+    ASSERT_NE(reader, nullptr);
+    ASSERT_TRUE(reader->seek(WORDCOUNT, Sds::Reader::Reference::BEFORE_WRITER));
+    std::vector<uint64_t> words(WORDCOUNT);
+    ASSERT_EQ(reader->read(words.data(), words.size()), static_cast<ssize_t>(WORDCOUNT));
+    for (size_t i = 1; i < WORDCOUNT; ++i) {
+        bool isFirst = (words[i] >> 32) & 1;
+        if (!isFirst) {
+            ASSERT_EQ(words[i] >> 40, words[i - 1] >> 40) << "at word " << i;
+            ASSERT_EQ(words[i] & 0xffffffff, (words[i - 1] & 0xffffffff) + 1) << "at word " << i;
+        }
+    }
+}
+
+/**
+ * Benchmarks the throughput of several threads writing 10ms blocks of 16kHz audio to one stream, either through a
+ * stream with one @c Writer per thread, or by taking turns on a single @c Writer behind a mutex.  The mean time each
+ * @c write() takes, including waiting for the mutex or for other @c Writers to publish, shows the contention.  Run
+ * with --gtest_also_run_disabled_tests.
+ */
+TEST_F(SharedDataStreamTest, DISABLED_benchmarkMultipleWriters) {
+    static const size_t WORDSIZE = sizeof(int16_t);
+    static const size_t WORDS_PER_WRITE = 160;
+    static const size_t WORDCOUNT = WORDS_PER_WRITE * 100;
+    static const size_t WRITES = 400000;
+
+    // Runs numThreads threads which share WRITES writes of WORDS_PER_WRITE words, and returns the elapsed time.
+    auto run = [](size_t numThreads, bool shareOneWriter, std::chrono::nanoseconds* meanWriteTime) {
+        auto maxWriters = shareOneWriter ? 1 : numThreads;
+        auto buffer = std::make_shared<InProcessSDS::Buffer>(
+            InProcessSDS::calculateBufferSize(WORDCOUNT, WORDSIZE, 1, maxWriters));
+        auto sds = InProcessSDS::create(buffer, WORDSIZE, 1, maxWriters);
+        std::vector<std::unique_ptr<InProcessSDS::Writer>> writers;
+        for (size_t id = 0; id < maxWriters; ++id) {
+            writers.push_back(sds->createWriter(InProcessSDS::Writer::Policy::NONBLOCKABLE));
+        }
+        std::mutex writerMutex;
+        std::atomic<int64_t> totalWriteNanoseconds{0};
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        for (size_t id = 0; id < numThreads; ++id) {
+            threads.emplace_back([&, id] {
+                std::vector<int16_t> block(WORDS_PER_WRITE, static_cast<int16_t>(id));
+                int64_t writeNanoseconds = 0;
+                for (size_t i = 0; i < WRITES / numThreads; ++i) {
+                    auto writeStart = std::chrono::steady_clock::now();
+                    if (shareOneWriter) {
+                        std::lock_guard<std::mutex> lock(writerMutex);
+                        writers[0]->write(block.data(), WORDS_PER_WRITE);
+                    } else {
+                        writers[id]->write(block.data(), WORDS_PER_WRITE);
+                    }
+                    writeNanoseconds += (std::chrono::steady_clock::now() - writeStart).count();
+                }
+                totalWriteNanoseconds += writeNanoseconds;
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        *meanWriteTime = std::chrono::nanoseconds(totalWriteNanoseconds / (WRITES / numThreads * numThreads));
+        return elapsed;
+    };
+
+    std::cout << "threads  one writer + mutex (Mwords/s, ns/write)  writer per thread (Mwords/s, ns/write)"
+              << std::endl;
+    for (size_t numThreads : {1, 2, 4}) {
+        std::cout << "      " << numThreads;
+        for (bool shareOneWriter : {true, false}) {
+            std::chrono::nanoseconds meanWriteTime;
+            auto elapsed = run(numThreads, shareOneWriter, &meanWriteTime);
+            auto wordsPerMicrosecond = static_cast<double>(WRITES / numThreads * numThreads * WORDS_PER_WRITE) /
+                                       std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+            std::cout << "      " << wordsPerMicrosecond << " Mwords/s, " << meanWriteTime.count() << " ns";
+        }
+        std::cout << std::endl;
+    }
+}
+
 }  // namespace test
 }  // namespace sds
 }  // namespace utils
@@ -0,0 +1,232 @@
+/*
+ * ShutdownOrchestratorTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file ShutdownOrchestratorTest.cpp
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "AVSCommon/Utils/ShutdownOrchestrator.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace test {
+
+using namespace std::chrono;
+
+/// How long each @c Component takes to shut down by default.
+static const milliseconds SHUTDOWN_DURATION(50);
+
+/// A deadline which tests don't reach unless they fail.
+static const milliseconds LONG_DEADLINE(5000);
+
+/// A deadline which tests pass on purpose.
+static const milliseconds SHORT_DEADLINE(50);
+
+/// A @c RequiresShutdown which records when it shut down, and can be held in @c doShutdown().
+class Component : public RequiresShutdown {
+public:
+    /**
+     * Constructor.
+     *
+     * @param name The name of the component.
+     * @param duration How long @c doShutdown() takes.
+     */
+    Component(const std::string& name, milliseconds duration = SHUTDOWN_DURATION) :
+            RequiresShutdown(name),
+            m_duration{duration},
+            m_released{m_release.get_future().share()} {
+    }
+
+    /// Make @c doShutdown() wait for @c release() before returning.
+    void hold() {
+        m_isHeld = true;
+    }
+
+    /// Let a held @c doShutdown() return.
+    void release() {
+        m_release.set_value();
+    }
+
+    /// When @c doShutdown() started.
+    steady_clock::time_point started;
+
+    /// When @c doShutdown() finished.
+    steady_clock::time_point finished;
+
+protected:
+    void doShutdown() override {
+        started = steady_clock::now();
+        std::this_thread::sleep_for(m_duration);
+        if (m_isHeld) {
+            m_released.wait();
+        }
+        finished = steady_clock::now();
+    }
+
+private:
+    /// How long @c doShutdown() takes.
+    const milliseconds m_duration;
+
+    /// Whether @c doShutdown() waits for @c release().
+    std::atomic<bool> m_isHeld{false};
+
+    /// Fulfilled by @c release().
+    std::promise<void> m_release;
+
+    /// The future of @c m_release.
+    std::shared_future<void> m_released;
+};
+
+/**
+ * Create a number of components.
+ *
+ * @param count The number of components.
+ * @param duration How long each component takes to shut down.
+ * @return The components.
+ */
+static std::vector<std::shared_ptr<Component>> createComponents(int count, milliseconds duration = SHUTDOWN_DURATION) {
+    std::vector<std::shared_ptr<Component>> components;
+    for (int i = 0; i < count; ++i) {
+        components.push_back(std::make_shared<Component>("component" + std::to_string(i), duration));
+    }
+    return components;
+}
+
+/**
+ * Convert components to the objects of a stage.
+ *
+ * @param components The components.
+ * @return The objects of the stage.
+ */
+static std::vector<std::shared_ptr<RequiresShutdown>> toStage(
+    const std::vector<std::shared_ptr<Component>>& components) {
+    return std::vector<std::shared_ptr<RequiresShutdown>>(components.begin(), components.end());
+}
+
+/// Verify that the components of a stage shut down in parallel, and that stages shut down one after the other.
+TEST(ShutdownOrchestratorTest, stagesShutDownInOrderAndComponentsInParallel) {
+    static const int COMPONENTS_PER_STAGE = 4;
+    auto first = createComponents(COMPONENTS_PER_STAGE);
+    auto second = createComponents(COMPONENTS_PER_STAGE);
+
+    ShutdownOrchestrator orchestrator(LONG_DEADLINE);
+    orchestrator.addStage(toStage(first));
+    orchestrator.addStage(toStage(second));
+    auto start = steady_clock::now();
+    EXPECT_TRUE(orchestrator.shutdown());
+    auto duration = steady_clock::now() - start;
+
+    auto firstFinished = steady_clock::time_point::min();
+    for (auto& component : first) {
+        EXPECT_TRUE(component->isShutdown());
+        firstFinished = std::max(firstFinished, component->finished);
+    }
+    for (auto& component : second) {
+        EXPECT_TRUE(component->isShutdown());
+        EXPECT_GE(component->started, firstFinished);
+    }
+    EXPECT_LT(duration, SHUTDOWN_DURATION * COMPONENTS_PER_STAGE);
+}
+
+/// Verify that @c nullptr objects and empty stages are skipped.
+TEST(ShutdownOrchestratorTest, nullObjectsAreSkipped) {
+    auto component = std::make_shared<Component>("component");
+    ShutdownOrchestrator orchestrator(LONG_DEADLINE);
+    orchestrator.addStage({nullptr});
+    orchestrator.addStage({nullptr, component});
+    orchestrator.addStage({});
+    EXPECT_TRUE(orchestrator.shutdown());
+    EXPECT_TRUE(component->isShutdown());
+}
+
+/**
+ * Verify that shutdown() reports a passed deadline while a component is still shutting down, but still waits for it
+ * and for the remaining stages, so that no object is shut down after it returns.
+ */
+TEST(ShutdownOrchestratorTest, deadlinePassed) {
+    auto stuck = std::make_shared<Component>("stuck");
+    stuck->hold();
+    auto later = std::make_shared<Component>("later");
+
+    ShutdownOrchestrator orchestrator(SHORT_DEADLINE);
+    orchestrator.addStage({stuck});
+    orchestrator.addStage({later});
+    std::thread releaser([&stuck] {
+        std::this_thread::sleep_for(SHORT_DEADLINE * 4);
+        stuck->release();
+    });
+    auto start = steady_clock::now();
+    EXPECT_FALSE(orchestrator.shutdown());
+    EXPECT_GE(steady_clock::now() - start, SHORT_DEADLINE * 4);
+    EXPECT_TRUE(stuck->isShutdown());
+    EXPECT_TRUE(later->isShutdown());
+    releaser.join();
+}
+
+/**
+ * Compare shutting down the components of a client one after the other with shutting them down with a
+ * @c ShutdownOrchestrator, as @c DefaultClient does on destruction and restart.  The components mimic the waits of a
+ * client's: a network loop, detection loops reading with timeouts, and executor and timer threads.
+ */
+TEST(ShutdownOrchestratorTest, DISABLED_benchmarkRestart) {
+    static const milliseconds NETWORK_DURATION(100);
+    static const int CAPABILITY_AGENTS = 7;
+    static const milliseconds CAPABILITY_AGENT_DURATION(30);
+
+    auto createClient = [] {
+        std::vector<std::vector<std::shared_ptr<Component>>> stages;
+        stages.push_back(createComponents(1));
+        stages.push_back(createComponents(CAPABILITY_AGENTS, CAPABILITY_AGENT_DURATION));
+        stages.push_back(createComponents(1, NETWORK_DURATION));
+        return stages;
+    };
+
+    auto sequential = createClient();
+    auto start = steady_clock::now();
+    for (auto& stage : sequential) {
+        for (auto& component : stage) {
+            component->shutdown();
+        }
+    }
+    auto sequentialDuration = duration_cast<milliseconds>(steady_clock::now() - start);
+
+    auto orchestrated = createClient();
+    ShutdownOrchestrator orchestrator(LONG_DEADLINE);
+    for (auto& stage : orchestrated) {
+        orchestrator.addStage(toStage(stage));
+    }
+    start = steady_clock::now();
+    ASSERT_TRUE(orchestrator.shutdown());
+    auto orchestratedDuration = duration_cast<milliseconds>(steady_clock::now() - start);
+
+    std::cout << "sequential shutdown: " << sequentialDuration.count() << " ms" << std::endl;
+    std::cout << "orchestrated shutdown: " << orchestratedDuration.count() << " ms" << std::endl;
+}
+
+}  // namespace test
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
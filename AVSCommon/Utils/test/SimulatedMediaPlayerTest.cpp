@@ -0,0 +1,389 @@
+/*
+ * SimulatedMediaPlayerTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file SimulatedMediaPlayerTest.cpp
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "AVSCommon/AVS/Attachment/InProcessAttachment.h"
+#include "AVSCommon/Utils/MediaPlayer/SimulatedMediaPlayer.h"
+#include "AVSCommon/Utils/Timing/ManualClock.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace mediaPlayer {
+namespace test {
+
+using namespace avsCommon::avs::attachment;
+using namespace avsCommon::utils::timing::test;
+
+/// The bitrate the tests play at, which makes one byte a millisecond.
+static const unsigned int BYTES_PER_SECOND = 1000;
+
+/// The playback time of a chunk read by the player.
+static const std::chrono::milliseconds CHUNK_DURATION(10);
+
+/**
+ * Used to limit the amount of real time tests will wait for an event.  This timeout will only be hit if a test is
+ * failing.
+ */
+static const auto TIMEOUT = std::chrono::seconds(2);
+
+/// A copy of @c MediaPlayerInterface::ERROR which gtest's comparisons can take a reference to.
+static const MediaPlayerInterface::SourceId ERROR_ID = MediaPlayerInterface::ERROR;
+
+/// The real time to allow the player's thread to react to a change.
+static const auto REACTION_TIME = std::chrono::milliseconds(50);
+
+/// An observer which records the events it is sent.
+class RecordingObserver : public MediaPlayerObserverInterface {
+public:
+    /// An event, and the id of the source it is for.
+    using Event = std::pair<std::string, MediaPlayerInterface::SourceId>;
+
+    /// @name MediaPlayerObserverInterface methods.
+    /// @{
+    void onPlaybackStarted(SourceId id) override {
+        record("started", id);
+    }
+    void onPlaybackFinished(SourceId id) override {
+        record("finished", id);
+    }
+    void onPlaybackError(SourceId id, const ErrorType& type, std::string error) override {
+        record("error", id);
+    }
+    void onPlaybackPaused(SourceId id) override {
+        record("paused", id);
+    }
+    void onPlaybackResumed(SourceId id) override {
+        record("resumed", id);
+    }
+    void onPlaybackStopped(SourceId id) override {
+        record("stopped", id);
+    }
+    void onBufferUnderrun(SourceId id) override {
+        record("underrun", id);
+    }
+    void onBufferRefilled(SourceId id) override {
+        record("refilled", id);
+    }
+    /// @}
+
+    /**
+     * Wait for an event to have been recorded.
+     *
+     * @param name The name of the event.
+     * @param id The id of the source of the event.
+     * @return Whether the event was recorded before @c TIMEOUT.
+     */
+    bool waitFor(const std::string& name, SourceId id) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_eventRecorded.wait_for(lock, TIMEOUT, [this, &name, id] {
+            for (auto& event : m_events) {
+                if (event.first == name && event.second == id) {
+                    return true;
+                }
+            }
+            return false;
+        });
+    }
+
+    /**
+     * Get the events recorded so far.
+     *
+     * @return The events, in the order they were sent.
+     */
+    std::vector<Event> getEvents() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_events;
+    }
+
+private:
+    /**
+     * Record an event.
+     *
+     * @param name The name of the event.
+     * @param id The id of the source of the event.
+     */
+    void record(const std::string& name, SourceId id) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_events.emplace_back(name, id);
+        m_eventRecorded.notify_all();
+    }
+
+    /// Mutex serializing access to the members below.
+    std::mutex m_mutex;
+
+    /// Notified when an event is recorded.
+    std::condition_variable m_eventRecorded;
+
+    /// The events recorded so far.
+    std::vector<Event> m_events;
+};
+
+/// Test harness for @c SimulatedMediaPlayer.
+class SimulatedMediaPlayerTest : public ::testing::Test {
+public:
+    /// Set up the test harness for running a test.
+    void SetUp() override;
+
+protected:
+    /**
+     * Create the player under test, and set its observer.
+     *
+     * @param clock The clock for the player to play in time on, or @c nullptr.
+     * @param urlDuration The duration of URL sources.
+     */
+    void createPlayer(
+        std::shared_ptr<timing::Clock> clock,
+        std::chrono::milliseconds urlDuration = SimulatedMediaPlayer::DEFAULT_URL_DURATION);
+
+    /**
+     * Advance @c m_clock a chunk at a time, waiting in real time after each step for the player to read the next
+     * chunk, so that the offset of the source is exactly the time advanced by.
+     *
+     * @param id The source which is playing.
+     * @param duration The time to advance by, which must be a multiple of @c CHUNK_DURATION.
+     * @return Whether the player kept up with the clock.
+     */
+    bool advancePlayback(MediaPlayerInterface::SourceId id, std::chrono::milliseconds duration);
+
+    /**
+     * Wait in real time for the player to have consumed a number of bytes from a source.
+     *
+     * @param id The source.
+     * @param bytes The number of bytes.
+     * @return Whether the bytes were consumed before @c TIMEOUT.
+     */
+    bool waitForBytesConsumed(MediaPlayerInterface::SourceId id, uint64_t bytes);
+
+    /// The clock tests which play in time use.
+    std::shared_ptr<ManualClock> m_clock;
+
+    /// The observer of the player.
+    std::shared_ptr<RecordingObserver> m_observer;
+
+    /// The player under test.
+    std::shared_ptr<SimulatedMediaPlayer> m_player;
+};
+
+void SimulatedMediaPlayerTest::SetUp() {
+    m_clock = std::make_shared<ManualClock>();
+    m_observer = std::make_shared<RecordingObserver>();
+}
+
+void SimulatedMediaPlayerTest::createPlayer(
+    std::shared_ptr<timing::Clock> clock,
+    std::chrono::milliseconds urlDuration) {
+    m_player = SimulatedMediaPlayer::create(BYTES_PER_SECOND, clock, urlDuration);
+    ASSERT_TRUE(m_player);
+    m_player->setObserver(m_observer);
+}
+
+bool SimulatedMediaPlayerTest::advancePlayback(MediaPlayerInterface::SourceId id, std::chrono::milliseconds duration) {
+    for (auto elapsed = CHUNK_DURATION; elapsed <= duration; elapsed += CHUNK_DURATION) {
+        auto consumed = m_player->getBytesConsumed(id);
+        m_clock->advance(CHUNK_DURATION);
+        if (!waitForBytesConsumed(id, consumed + CHUNK_DURATION.count() * BYTES_PER_SECOND / 1000)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SimulatedMediaPlayerTest::waitForBytesConsumed(MediaPlayerInterface::SourceId id, uint64_t bytes) {
+    auto deadline = std::chrono::steady_clock::now() + TIMEOUT;
+    while (m_player->getBytesConsumed(id) < bytes) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+/**
+ * Verify that an unpaced player consumes a whole stream without waiting, and reports its full duration as the offset.
+ */
+TEST_F(SimulatedMediaPlayerTest, unpacedStreamPlaysToFinish) {
+    createPlayer(nullptr);
+    auto id = m_player->setSource(std::make_shared<std::stringstream>(std::string(500, 'x')), false);
+    ASSERT_NE(id, ERROR_ID);
+    ASSERT_TRUE(m_player->play(id));
+    ASSERT_TRUE(m_observer->waitFor("finished", id));
+
+    std::vector<RecordingObserver::Event> expected{{"started", id}, {"finished", id}};
+    EXPECT_EQ(m_observer->getEvents(), expected);
+    EXPECT_EQ(m_player->getBytesConsumed(id), 500u);
+    EXPECT_EQ(m_player->getOffset(id), std::chrono::milliseconds(500));
+}
+
+/**
+ * Verify that a paced player only plays as the clock advances, that its offset follows the clock exactly, and that
+ * the offset does not move while paused.
+ */
+TEST_F(SimulatedMediaPlayerTest, pacedOffsetFollowsClock) {
+    createPlayer(m_clock);
+    auto id = m_player->setSource(std::make_shared<std::stringstream>(std::string(1000, 'x')), false);
+    ASSERT_TRUE(m_player->play(id));
+    ASSERT_TRUE(m_observer->waitFor("started", id));
+    std::this_thread::sleep_for(REACTION_TIME);
+    EXPECT_EQ(m_player->getOffset(id), std::chrono::milliseconds::zero());
+    EXPECT_EQ(m_player->getBytesConsumed(id), static_cast<uint64_t>(CHUNK_DURATION.count()));
+
+    ASSERT_TRUE(advancePlayback(id, std::chrono::milliseconds(250)));
+    EXPECT_EQ(m_player->getOffset(id), std::chrono::milliseconds(250));
+
+    // Offsets between chunks are interpolated from the clock.
+    m_clock->advance(std::chrono::milliseconds(5));
+    EXPECT_EQ(m_player->getOffset(id), std::chrono::milliseconds(255));
+
+    ASSERT_TRUE(m_player->pause(id));
+    ASSERT_TRUE(m_observer->waitFor("paused", id));
+    m_clock->advance(std::chrono::seconds(10));
+    EXPECT_EQ(m_player->getOffset(id), std::chrono::milliseconds(255));
+
+    ASSERT_TRUE(m_player->resume(id));
+    ASSERT_TRUE(m_observer->waitFor("resumed", id));
+    m_clock->advance(std::chrono::seconds(1));
+    ASSERT_TRUE(m_observer->waitFor("finished", id));
+    EXPECT_EQ(m_player->getOffset(id), std::chrono::milliseconds(1000));
+}
+
+/**
+ * Verify that a source which runs out of data reports an underrun, stops its playback time until data arrives, and
+ * finishes once its attachment is closed.
+ */
+TEST_F(SimulatedMediaPlayerTest, attachmentUnderrunAndRefill) {
+    createPlayer(nullptr);
+    InProcessAttachment attachment("underrun");
+    auto writer = attachment.createWriter();
+    auto id = m_player->setSource(attachment.createReader(AttachmentReader::Policy::BLOCKING));
+    ASSERT_NE(id, ERROR_ID);
+
+    std::string data(100, 'x');
+    auto status = AttachmentWriter::WriteStatus::OK;
+    ASSERT_EQ(writer->write(data.data(), data.size(), &status), data.size());
+    ASSERT_TRUE(m_player->play(id));
+    ASSERT_TRUE(m_observer->waitFor("underrun", id));
+    EXPECT_EQ(m_player->getOffset(id), std::chrono::milliseconds(100));
+
+    ASSERT_EQ(writer->write(data.data(), data.size(), &status), data.size());
+    ASSERT_TRUE(m_observer->waitFor("refilled", id));
+    writer->close();
+    ASSERT_TRUE(m_observer->waitFor("finished", id));
+
+    auto events = m_observer->getEvents();
+    ASSERT_GE(events.size(), 4u);
+    EXPECT_EQ(events.front().first, "started");
+    EXPECT_EQ(events.back().first, "finished");
+    EXPECT_EQ(m_player->getOffset(id), std::chrono::milliseconds(200));
+}
+
+/**
+ * Verify that a repeating stream plays until stopped.
+ */
+TEST_F(SimulatedMediaPlayerTest, repeatingStreamPlaysUntilStopped) {
+    createPlayer(nullptr);
+    auto id = m_player->setSource(std::make_shared<std::stringstream>(std::string(25, 'x')), true);
+    ASSERT_TRUE(m_player->play(id));
+    ASSERT_TRUE(waitForBytesConsumed(id, 100));
+    ASSERT_TRUE(m_player->stop(id));
+    ASSERT_TRUE(m_observer->waitFor("stopped", id));
+
+    std::vector<RecordingObserver::Event> expected{{"started", id}, {"stopped", id}};
+    EXPECT_EQ(m_observer->getEvents(), expected);
+    EXPECT_FALSE(m_player->stop(id));
+}
+
+/**
+ * Verify that an empty repeating stream finishes instead of looping forever.
+ */
+TEST_F(SimulatedMediaPlayerTest, emptyRepeatingStreamFinishes) {
+    createPlayer(nullptr);
+    auto id = m_player->setSource(std::make_shared<std::stringstream>(), true);
+    ASSERT_TRUE(m_player->play(id));
+    ASSERT_TRUE(m_observer->waitFor("finished", id));
+}
+
+/**
+ * Verify that a URL source plays silence from its offset to the end of the configured duration.
+ */
+TEST_F(SimulatedMediaPlayerTest, urlSourcePlaysFromOffset) {
+    createPlayer(nullptr, std::chrono::seconds(1));
+    auto id = m_player->setSource("http://example.com/stream", std::chrono::milliseconds(400));
+    EXPECT_EQ(m_player->getOffset(id), std::chrono::milliseconds(400));
+    ASSERT_TRUE(m_player->play(id));
+    ASSERT_TRUE(m_observer->waitFor("finished", id));
+    EXPECT_EQ(m_player->getBytesConsumed(id), 600u);
+    EXPECT_EQ(m_player->getOffset(id), std::chrono::milliseconds(1000));
+}
+
+/**
+ * Verify that setting a new source stops the previous one, and that calls for the previous source then fail.
+ */
+TEST_F(SimulatedMediaPlayerTest, setSourceStopsPreviousSource) {
+    createPlayer(m_clock);
+    auto first = m_player->setSource(std::make_shared<std::stringstream>(std::string(1000, 'x')), false);
+    ASSERT_TRUE(m_player->play(first));
+    ASSERT_TRUE(m_observer->waitFor("started", first));
+
+    auto second = m_player->setSource("http://example.com/stream");
+    ASSERT_NE(second, first);
+    ASSERT_TRUE(m_observer->waitFor("stopped", first));
+    EXPECT_EQ(m_player->getOffset(first), MEDIA_PLAYER_INVALID_OFFSET);
+    EXPECT_FALSE(m_player->play(first));
+    EXPECT_FALSE(m_player->pause(first));
+    EXPECT_TRUE(m_player->play(second));
+    EXPECT_FALSE(m_player->play(second));
+}
+
+/**
+ * Verify that calls which are not valid in the state of the source fail.
+ */
+TEST_F(SimulatedMediaPlayerTest, invalidCallsFail) {
+    createPlayer(m_clock);
+    EXPECT_FALSE(m_player->play(ERROR_ID));
+    EXPECT_EQ(m_player->setSource(std::shared_ptr<AttachmentReader>()), ERROR_ID);
+    EXPECT_EQ(m_player->setSource(std::shared_ptr<std::istream>(), false), ERROR_ID);
+
+    auto id = m_player->setSource(std::make_shared<std::stringstream>(std::string(1000, 'x')), false);
+    EXPECT_FALSE(m_player->pause(id));
+    EXPECT_FALSE(m_player->resume(id));
+    ASSERT_TRUE(m_player->play(id));
+    EXPECT_FALSE(m_player->resume(id));
+    EXPECT_TRUE(m_player->pause(id));
+    EXPECT_FALSE(m_player->pause(id));
+    EXPECT_TRUE(m_player->stop(id));
+    EXPECT_FALSE(m_player->resume(id));
+}
+
+}  // namespace test
+}  // namespace mediaPlayer
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
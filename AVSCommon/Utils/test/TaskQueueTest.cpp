@@ -279,6 +279,97 @@ TEST_F(TaskQueueTest, pushFailsToEnqueueANewTaskOnAShutdownQueue) {
     ASSERT_EQ(retrievedTask, nullptr);
 }
 
+/// The capacity of the bounded queues in tests.
+static const size_t CAPACITY = 2;
+
+/// This test verifies that a full queue under @c OverloadPolicy::DROP_NEW refuses new tasks, but not urgent ones.
+TEST_F(TaskQueueTest, dropNewRefusesTasksWhenFull) {
+    TaskQueue boundedQueue(CAPACITY, TaskQueue::OverloadPolicy::DROP_NEW);
+    for (size_t i = 0; i < CAPACITY; ++i) {
+        ASSERT_TRUE(boundedQueue.push(TASK, VALUE).valid());
+    }
+    EXPECT_FALSE(boundedQueue.push(TASK, VALUE).valid());
+    EXPECT_TRUE(boundedQueue.pushToFront(TASK, VALUE).valid());
+    EXPECT_TRUE(boundedQueue.pushPastCapacity(TASK, VALUE).valid());
+
+    auto counters = boundedQueue.getOverloadCounters();
+    EXPECT_EQ(counters.tasksDropped, 1u);
+    EXPECT_EQ(counters.maxSize, CAPACITY + 2);
+}
+
+/// This test verifies that a full queue under @c OverloadPolicy::DROP_OLDEST drops the task waiting longest.
+TEST_F(TaskQueueTest, dropOldestDropsTheOldestTaskWhenFull) {
+    TaskQueue boundedQueue(CAPACITY, TaskQueue::OverloadPolicy::DROP_OLDEST);
+    auto oldest = boundedQueue.push(TASK, 1);
+    boundedQueue.push(TASK, 2);
+    auto newest = boundedQueue.push(TASK, 3);
+    ASSERT_TRUE(newest.valid());
+
+    ASSERT_EQ(oldest.wait_for(SHORT_TIMEOUT_MS), std::future_status::ready);
+    EXPECT_THROW(oldest.get(), std::future_error);
+    boundedQueue.pop()->operator()();
+    boundedQueue.pop()->operator()();
+    EXPECT_EQ(newest.get(), 3);
+    EXPECT_TRUE(boundedQueue.isEmpty());
+    EXPECT_EQ(boundedQueue.getOverloadCounters().tasksDropped, 1u);
+}
+
+/// This test verifies that @c OverloadPolicy::COALESCE replaces a waiting task with the same key in its place.
+TEST_F(TaskQueueTest, coalesceReplacesWaitingTaskWithSameKey) {
+    TaskQueue boundedQueue(CAPACITY, TaskQueue::OverloadPolicy::COALESCE);
+    auto first = boundedQueue.pushCoalesced("volume", TASK, 1);
+    auto other = boundedQueue.pushCoalesced("mute", TASK, 2);
+    auto second = boundedQueue.pushCoalesced("volume", TASK, 3);
+
+    EXPECT_THROW(first.get(), std::future_error);
+    boundedQueue.pop()->operator()();
+    ASSERT_EQ(second.wait_for(SHORT_TIMEOUT_MS), std::future_status::ready);
+    EXPECT_EQ(second.get(), 3);
+    EXPECT_EQ(other.wait_for(SHORT_TIMEOUT_MS), std::future_status::timeout);
+    boundedQueue.pop()->operator()();
+    EXPECT_EQ(other.get(), 2);
+    EXPECT_EQ(boundedQueue.getOverloadCounters().tasksCoalesced, 1u);
+}
+
+/// This test verifies that keys are ignored by queues which do not coalesce.
+TEST_F(TaskQueueTest, keysIgnoredWithoutCoalescePolicy) {
+    queue.pushCoalesced("volume", TASK, 1);
+    queue.pushCoalesced("volume", TASK, 2);
+    ASSERT_NE(queue.tryPop(), nullptr);
+    ASSERT_NE(queue.tryPop(), nullptr);
+    EXPECT_EQ(queue.getOverloadCounters().tasksCoalesced, 0u);
+}
+
+/// This test verifies that a full queue under @c OverloadPolicy::BLOCK blocks a push until there is room.
+TEST_F(TaskQueueTest, blockWaitsForRoomWhenFull) {
+    TaskQueue boundedQueue(CAPACITY, TaskQueue::OverloadPolicy::BLOCK);
+    for (size_t i = 0; i < CAPACITY; ++i) {
+        boundedQueue.push(TASK, VALUE);
+    }
+    auto pushed = std::async(std::launch::async, [&boundedQueue] { return boundedQueue.push(TASK, VALUE).valid(); });
+    EXPECT_EQ(pushed.wait_for(SHORT_TIMEOUT_MS), std::future_status::timeout);
+
+    boundedQueue.pop();
+    ASSERT_EQ(pushed.wait_for(SHORT_TIMEOUT_MS), std::future_status::ready);
+    EXPECT_TRUE(pushed.get());
+    EXPECT_EQ(boundedQueue.getOverloadCounters().pushesBlocked, 1u);
+    EXPECT_EQ(boundedQueue.getOverloadCounters().maxSize, CAPACITY);
+}
+
+/// This test verifies that a push blocked by a full queue fails when the queue is shutdown.
+TEST_F(TaskQueueTest, blockedPushFailsOnShutdown) {
+    TaskQueue boundedQueue(CAPACITY, TaskQueue::OverloadPolicy::BLOCK);
+    for (size_t i = 0; i < CAPACITY; ++i) {
+        boundedQueue.push(TASK, VALUE);
+    }
+    auto pushed = std::async(std::launch::async, [&boundedQueue] { return boundedQueue.push(TASK, VALUE).valid(); });
+    EXPECT_EQ(pushed.wait_for(SHORT_TIMEOUT_MS), std::future_status::timeout);
+
+    boundedQueue.shutdown();
+    ASSERT_EQ(pushed.wait_for(SHORT_TIMEOUT_MS), std::future_status::ready);
+    EXPECT_FALSE(pushed.get());
+}
+
 }  // namespace test
 }  // namespace threading
 }  // namespace utils
@@ -0,0 +1,92 @@
+/*
+ * ThreadPoolTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <atomic>
+#include <future>
+#include <set>
+
+#include <gtest/gtest.h>
+
+#include "AVSCommon/Utils/Threading/ThreadPool.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace threading {
+namespace test {
+
+/// The number of threads in the pools under test.
+static const size_t NUM_THREADS = 4;
+
+/// How long to wait for a job.  This will only be hit if a test is failing.
+static const std::chrono::seconds TIMEOUT(5);
+
+/// This test verifies that a pool can't be created without threads.
+TEST(ThreadPoolTest, createWithoutThreadsFails) {
+    EXPECT_FALSE(ThreadPool::create(0));
+    auto pool = ThreadPool::create(NUM_THREADS);
+    ASSERT_TRUE(pool);
+    EXPECT_EQ(pool->getNumThreads(), NUM_THREADS);
+}
+
+/// This test verifies that posted jobs run concurrently on all the threads of the pool.
+TEST(ThreadPoolTest, jobsRunOnAllThreads) {
+    auto pool = ThreadPool::create(NUM_THREADS);
+    ASSERT_TRUE(pool);
+    std::mutex mutex;
+    std::condition_variable allStarted;
+    std::set<std::thread::id> threads;
+    std::atomic<size_t> finished(0);
+    for (size_t i = 0; i < NUM_THREADS; ++i) {
+        pool->post([&] {
+            std::unique_lock<std::mutex> lock(mutex);
+            threads.insert(std::this_thread::get_id());
+            allStarted.notify_all();
+            // Only returns once every job has started, so each job must be on its own thread.
+            allStarted.wait_for(lock, TIMEOUT, [&threads] { return threads.size() == NUM_THREADS; });
+            ++finished;
+        });
+    }
+    std::unique_lock<std::mutex> lock(mutex);
+    EXPECT_TRUE(allStarted.wait_for(lock, TIMEOUT, [&] { return finished == NUM_THREADS; }));
+    EXPECT_EQ(threads.size(), NUM_THREADS);
+}
+
+/// This test verifies that a pool whose last reference is released by one of its own jobs shuts down cleanly.
+TEST(ThreadPoolTest, destroyedByOwnJob) {
+    auto pool = ThreadPool::create(NUM_THREADS);
+    ASSERT_TRUE(pool);
+    std::promise<void> released;
+    auto future = released.get_future();
+    auto poolInJob = pool;
+    std::promise<void> go;
+    auto goFuture = go.get_future().share();
+    pool->post([poolInJob, goFuture, &released]() mutable {
+        goFuture.wait();
+        poolInJob.reset();
+        released.set_value();
+    });
+    pool.reset();
+    go.set_value();
+    EXPECT_EQ(future.wait_for(TIMEOUT), std::future_status::ready);
+}
+
+}  // namespace test
+}  // namespace threading
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -0,0 +1,284 @@
+/*
+ * TimeUtilsTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file TimeUtilsTest.cpp
+
+#include <chrono>
+#include <ctime>
+#include <iostream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "AVSCommon/Utils/Logger/LoggerUtils.h"
+#include "AVSCommon/Utils/Timing/TimeUtils.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace timing {
+namespace test {
+
+/// The first day checked by the exhaustive tests, 0000-01-01.
+static const int64_t FIRST_DAY = daysFromCivil(0, 1, 1);
+
+/// The last day checked by the exhaustive tests, 9999-12-31.
+static const int64_t LAST_DAY = daysFromCivil(9999, 12, 31);
+
+/// The number of conversions each benchmark times.
+static const int NUM_BENCHMARK_ITERATIONS = 1000000;
+
+/// A time string used by the benchmarks.
+static const std::string BENCHMARK_TIME_STRING = "2017-08-31T12:34:56+0000";
+
+/**
+ * Convert an ISO-8601 string the way @c convert8601TimeStringToUnix() used to, through @c std::mktime(), to compare
+ * against in the benchmarks.
+ *
+ * @param timeString The time string.
+ * @return The local time the string is read as.
+ */
+static int64_t convertWithMktime(const std::string& timeString) {
+    std::tm timeInfo = {};
+    timeInfo.tm_year = std::stoi(timeString.substr(0, 4)) - 1900;
+    timeInfo.tm_mon = std::stoi(timeString.substr(5, 2)) - 1;
+    timeInfo.tm_mday = std::stoi(timeString.substr(8, 2));
+    timeInfo.tm_hour = std::stoi(timeString.substr(11, 2));
+    timeInfo.tm_min = std::stoi(timeString.substr(14, 2));
+    timeInfo.tm_sec = std::stoi(timeString.substr(17, 2));
+    timeInfo.tm_isdst = -1;
+    return static_cast<int64_t>(std::mktime(&timeInfo));
+}
+
+/**
+ * Time a number of calls to a function.
+ *
+ * @param function The function to call.
+ * @return The number of nanoseconds each call took on average.
+ */
+template <typename Function>
+static double nanosecondsPerCall(Function function) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < NUM_BENCHMARK_ITERATIONS; ++i) {
+        function(i);
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / NUM_BENCHMARK_ITERATIONS;
+}
+
+/**
+ * Verify that @c civilFromDays() inverts @c daysFromCivil() for every day from 0000-01-01 to 9999-12-31, and that the
+ * days in between are consecutive.
+ */
+TEST(TimeUtilsTest, daysFromCivilRoundTripsEveryDay) {
+    int64_t expectedYear = 0;
+    unsigned expectedMonth = 1;
+    unsigned expectedDay = 1;
+    for (int64_t days = FIRST_DAY; days <= LAST_DAY; ++days) {
+        int64_t year = 0;
+        unsigned month = 0;
+        unsigned day = 0;
+        civilFromDays(days, &year, &month, &day);
+        ASSERT_EQ(year, expectedYear) << "days=" << days;
+        ASSERT_EQ(month, expectedMonth) << "days=" << days;
+        ASSERT_EQ(day, expectedDay) << "days=" << days;
+        ASSERT_EQ(daysFromCivil(year, month, day), days);
+
+        if (++expectedDay > daysInMonth(expectedYear, expectedMonth)) {
+            expectedDay = 1;
+            if (++expectedMonth > 12) {
+                expectedMonth = 1;
+                ++expectedYear;
+            }
+        }
+    }
+}
+
+/**
+ * Verify the lengths of months, including the leap year rules for centuries.
+ */
+TEST(TimeUtilsTest, daysInMonth) {
+    EXPECT_EQ(daysInMonth(2017, 1), 31u);
+    EXPECT_EQ(daysInMonth(2017, 2), 28u);
+    EXPECT_EQ(daysInMonth(2016, 2), 29u);
+    EXPECT_EQ(daysInMonth(1900, 2), 28u);
+    EXPECT_EQ(daysInMonth(2000, 2), 29u);
+    EXPECT_EQ(daysInMonth(2017, 4), 30u);
+    EXPECT_EQ(daysInMonth(2017, 7), 31u);
+    EXPECT_EQ(daysInMonth(2017, 8), 31u);
+    EXPECT_EQ(daysInMonth(2017, 9), 30u);
+    EXPECT_EQ(daysInMonth(2017, 12), 31u);
+}
+
+/**
+ * Verify that formatting and parsing round trip at a different time of day on every day from 0000-01-01 to
+ * 9999-12-31, and that the results agree with @c timegm().
+ */
+TEST(TimeUtilsTest, iso8601RoundTripsEveryDay) {
+    std::string timeString;
+    for (int64_t days = FIRST_DAY; days <= LAST_DAY; ++days) {
+        // Step through the seconds of the day by a prime, so that every field takes many values.
+        int64_t unixTime = days * SECONDS_PER_DAY + (days * 7919) % SECONDS_PER_DAY;
+        if (unixTime < days * SECONDS_PER_DAY) {
+            unixTime += SECONDS_PER_DAY;
+        }
+        ASSERT_TRUE(convertUnixTimeTo8601String(unixTime, &timeString));
+        ASSERT_EQ(timeString.length(), ISO_8601_TIME_STRING_LENGTH);
+        int64_t parsed = 0;
+        ASSERT_TRUE(convert8601TimeStringToUnix(timeString, &parsed)) << timeString;
+        ASSERT_EQ(parsed, unixTime) << timeString;
+
+        if (days % 97 == 0 && unixTime >= 0) {
+            std::tm timeInfo = {};
+            auto timeT = static_cast<std::time_t>(unixTime);
+            ASSERT_NE(gmtime_r(&timeT, &timeInfo), nullptr);
+            char expected[ISO_8601_TIME_STRING_LENGTH + 1];
+            ASSERT_NE(std::strftime(expected, sizeof(expected), "%Y-%m-%dT%H:%M:%S+0000", &timeInfo), 0u);
+            ASSERT_EQ(timeString, expected);
+            ASSERT_EQ(static_cast<int64_t>(timegm(&timeInfo)), parsed);
+        }
+    }
+}
+
+/**
+ * Verify conversions of some well known times, and that the UTC offset is applied.
+ */
+TEST(TimeUtilsTest, convertKnownTimes) {
+    int64_t unixTime = -1;
+    ASSERT_TRUE(convert8601TimeStringToUnix("1970-01-01T00:00:00+0000", &unixTime));
+    EXPECT_EQ(unixTime, 0);
+    ASSERT_TRUE(convert8601TimeStringToUnix("2001-09-09T01:46:40+0000", &unixTime));
+    EXPECT_EQ(unixTime, 1000000000);
+    ASSERT_TRUE(convert8601TimeStringToUnix("2038-01-19T03:14:08+0000", &unixTime));
+    EXPECT_EQ(unixTime, 2147483648);
+    ASSERT_TRUE(convert8601TimeStringToUnix("1969-12-31T23:59:59+0000", &unixTime));
+    EXPECT_EQ(unixTime, -1);
+    ASSERT_TRUE(convert8601TimeStringToUnix("2001-09-09T03:46:40+0200", &unixTime));
+    EXPECT_EQ(unixTime, 1000000000);
+    ASSERT_TRUE(convert8601TimeStringToUnix("2001-09-08T20:16:40-0530", &unixTime));
+    EXPECT_EQ(unixTime, 1000000000);
+    ASSERT_TRUE(convert8601TimeStringToUnix("2016-12-31T23:59:60+0000", &unixTime));
+    EXPECT_EQ(unixTime, 1483228800);
+
+    std::string timeString;
+    ASSERT_TRUE(convertUnixTimeTo8601String(1000000000, &timeString));
+    EXPECT_EQ(timeString, "2001-09-09T01:46:40+0000");
+    ASSERT_TRUE(convertUnixTimeTo8601String(-1, &timeString));
+    EXPECT_EQ(timeString, "1969-12-31T23:59:59+0000");
+    EXPECT_FALSE(convertUnixTimeTo8601String((LAST_DAY + 1) * SECONDS_PER_DAY, &timeString));
+    EXPECT_FALSE(convertUnixTimeTo8601String(FIRST_DAY * SECONDS_PER_DAY - 1, &timeString));
+}
+
+/**
+ * Verify that malformed and out of range time strings are rejected.
+ */
+TEST(TimeUtilsTest, rejectMalformedTimes) {
+    const char* malformed[] = {
+        "",
+        "2017-08-31T12:34:56+000",
+        "2017-08-31T12:34:56+00000",
+        "2017-08-31 12:34:56+0000",
+        "2017/08/31T12:34:56+0000",
+        "2017-08-31T12-34-56+0000",
+        "2017-08-31T12:34:56Z0000",
+        "2017-8-031T12:34:56+0000",
+        "2017-08-31T 2:34:56+0000",
+        "2017-08-31T+2:34:56+0000",
+        "2017-00-31T12:34:56+0000",
+        "2017-13-31T12:34:56+0000",
+        "2017-09-31T12:34:56+0000",
+        "2017-02-29T12:34:56+0000",
+        "2017-08-00T12:34:56+0000",
+        "2017-08-31T24:00:00+0000",
+        "2017-08-31T12:60:56+0000",
+        "2017-08-31T12:34:61+0000",
+        "2017-08-31T12:34:56+2400",
+        "2017-08-31T12:34:56+0060",
+    };
+    for (auto timeString : malformed) {
+        int64_t unixTime = 0;
+        EXPECT_FALSE(convert8601TimeStringToUnix(timeString, &unixTime)) << timeString;
+    }
+    int64_t unixTime = 0;
+    EXPECT_TRUE(convert8601TimeStringToUnix("2016-02-29T12:34:56+0000", &unixTime));
+    EXPECT_FALSE(convert8601TimeStringToUnix(BENCHMARK_TIME_STRING, nullptr));
+    EXPECT_FALSE(convert8601TimeStringToUnix(nullptr, ISO_8601_TIME_STRING_LENGTH, &unixTime));
+}
+
+/**
+ * Verify that log lines carry the UTC date and time, including when consecutive lines share the cached second.
+ */
+TEST(TimeUtilsTest, logLinesCarryDateAndTime) {
+    auto time = std::chrono::system_clock::time_point(std::chrono::seconds(1000000000)) + std::chrono::milliseconds(7);
+    EXPECT_EQ(
+        logger::formatLogString(logger::Level::INFO, time, "  1", "text"),
+        "2001-09-09 01:46:40.007 [  1] I text");
+    EXPECT_EQ(
+        logger::formatLogString(logger::Level::INFO, time + std::chrono::milliseconds(990), "  1", "text"),
+        "2001-09-09 01:46:40.997 [  1] I text");
+    EXPECT_EQ(
+        logger::formatLogString(logger::Level::INFO, time + std::chrono::milliseconds(993), "  1", "text"),
+        "2001-09-09 01:46:41.000 [  1] I text");
+    EXPECT_EQ(
+        logger::formatLogString(logger::Level::INFO, time - std::chrono::seconds(1000000000), "  1", "text"),
+        "1970-01-01 00:00:00.007 [  1] I text");
+    EXPECT_EQ(
+        logger::formatLogString(
+            logger::Level::INFO, std::chrono::system_clock::time_point(std::chrono::milliseconds(-1)), "  1", "text"),
+        "1969-12-31 23:59:59.999 [  1] I text");
+}
+
+/**
+ * Compare the time taken to parse an ISO-8601 string with the @c std::mktime() based conversion this replaced.
+ */
+TEST(TimeUtilsTest, DISABLED_benchmarkParse) {
+    int64_t sum = 0;
+    auto mktimeNanoseconds = nanosecondsPerCall([&sum](int) { sum += convertWithMktime(BENCHMARK_TIME_STRING); });
+    auto codecNanoseconds = nanosecondsPerCall([&sum](int) {
+        int64_t unixTime = 0;
+        convert8601TimeStringToUnix(BENCHMARK_TIME_STRING, &unixTime);
+        sum += unixTime;
+    });
+    std::cout << "Nanoseconds per ISO-8601 parse: mktime " << mktimeNanoseconds << ", codec " << codecNanoseconds
+              << " (checksum " << sum << ")" << std::endl;
+}
+
+/**
+ * Compare the time taken to format the date and time of a log line with @c std::gmtime() and @c std::strftime(), as
+ * log lines were formatted before, with the time taken to format a whole log line now.
+ */
+TEST(TimeUtilsTest, DISABLED_benchmarkFormat) {
+    size_t sum = 0;
+    auto base = std::chrono::system_clock::time_point(std::chrono::seconds(1500000000));
+    auto strftimeNanoseconds = nanosecondsPerCall([&sum, &base](int i) {
+        auto timeT = std::chrono::system_clock::to_time_t(base + std::chrono::microseconds(i * 100));
+        char dateTimeString[DATE_AND_TIME_STRING_LENGTH + 1];
+        sum += std::strftime(dateTimeString, sizeof(dateTimeString), "%Y-%m-%d %H:%M:%S", std::gmtime(&timeT));
+    });
+    auto logLineNanoseconds = nanosecondsPerCall([&sum, &base](int i) {
+        sum += logger::formatLogString(logger::Level::INFO, base + std::chrono::microseconds(i * 100), "  1", "text")
+                   .length();
+    });
+    std::cout << "Nanoseconds per date and time: strftime " << strftimeNanoseconds << ", whole log line "
+              << logLineNanoseconds << " (checksum " << sum << ")" << std::endl;
+}
+
+}  // namespace test
+}  // namespace timing
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
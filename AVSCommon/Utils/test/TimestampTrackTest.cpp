@@ -0,0 +1,218 @@
+/*
+ * TimestampTrackTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file TimestampTrackTest.cpp
+
+#include <chrono>
+#include <cstdlib>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "AVSCommon/Utils/SDS/InProcessSDS.h"
+#include "AVSCommon/Utils/SDS/TimestampTrack.h"
+#include "AVSCommon/Utils/Timing/ManualClock.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace sds {
+namespace test {
+
+using namespace timing;
+using namespace timing::test;
+
+/// The time taken to capture one word at 16kHz.
+static const std::chrono::nanoseconds WORD_DURATION{62500};
+
+/// The number of words between the indices whose times are kept.
+static const size_t WORDS_PER_SLOT = 160;
+
+/// The number of times kept.
+static const size_t NUM_SLOTS = 50;
+
+/// The largest error allowed for an interpolated time, to allow for rounding.
+static const std::chrono::nanoseconds ROUNDING_ERROR{1000};
+
+/// Test harness for @c TimestampTrack.
+class TimestampTrackTest : public ::testing::Test {
+public:
+    /// Set up the test harness for running a test.
+    void SetUp() override;
+
+protected:
+    /**
+     * Check that the time of an index is within a tolerance of the time it would have at a constant rate of capture.
+     *
+     * @param index The index to look up.
+     * @param tolerance The largest allowed difference from the expected time.
+     * @return Whether the time is known and within @c tolerance.
+     */
+    ::testing::AssertionResult timeIsAccurate(TimestampTrack::Index index, std::chrono::nanoseconds tolerance);
+
+    /// The clock the track reads the time from.
+    std::shared_ptr<ManualClock> m_clock;
+
+    /// The time at which the word at index 0 is captured.
+    Clock::SteadyTimePoint m_start;
+
+    /// The track under test.
+    std::shared_ptr<TimestampTrack> m_track;
+};
+
+void TimestampTrackTest::SetUp() {
+    m_clock = std::make_shared<ManualClock>();
+    m_start = m_clock->steadyNow();
+    m_track = TimestampTrack::create(WORDS_PER_SLOT, NUM_SLOTS, m_clock);
+    ASSERT_NE(m_track, nullptr);
+}
+
+::testing::AssertionResult TimestampTrackTest::timeIsAccurate(
+    TimestampTrack::Index index,
+    std::chrono::nanoseconds tolerance) {
+    Clock::SteadyTimePoint time;
+    if (!m_track->getTime(index, &time)) {
+        return ::testing::AssertionFailure() << "no time for index " << index;
+    }
+    auto error = std::chrono::duration_cast<std::chrono::nanoseconds>(time - (m_start + WORD_DURATION * index));
+    if (std::abs(error.count()) > tolerance.count()) {
+        return ::testing::AssertionFailure() << "index " << index << " is off by " << error.count() << "ns";
+    }
+    return ::testing::AssertionSuccess();
+}
+
+/// Verify that @c create() rejects invalid parameters, and uses the default clock if none is given.
+TEST_F(TimestampTrackTest, create) {
+    EXPECT_EQ(TimestampTrack::create(0, NUM_SLOTS), nullptr);
+    EXPECT_EQ(TimestampTrack::create(WORDS_PER_SLOT, 1), nullptr);
+    auto track = TimestampTrack::create(WORDS_PER_SLOT, NUM_SLOTS);
+    ASSERT_NE(track, nullptr);
+    EXPECT_EQ(track->getClock(), Clock::getDefault());
+    EXPECT_EQ(m_track->getClock(), m_clock);
+}
+
+/**
+ * Verify that every index written at a constant rate, in writes which are not aligned to the slots, maps to the time
+ * at which it was captured.
+ */
+TEST_F(TimestampTrackTest, constantRateIsAccurate) {
+    static const TimestampTrack::Index WRITE_SIZE = 197;
+    static const int NUM_WRITES = 30;
+
+    m_track->recordNow(0);
+    for (int i = 1; i <= NUM_WRITES; ++i) {
+        m_clock->advance(WORD_DURATION * WRITE_SIZE);
+        m_track->recordNow(WRITE_SIZE * i);
+    }
+    for (TimestampTrack::Index index = 0; index <= WRITE_SIZE * NUM_WRITES; ++index) {
+        ASSERT_TRUE(timeIsAccurate(index, ROUNDING_ERROR));
+    }
+}
+
+/// Verify that the error of each time is bounded by the jitter of the writes.
+TEST_F(TimestampTrackTest, jitterIsBounded) {
+    static const TimestampTrack::Index WRITE_SIZE = 320;
+    static const int NUM_WRITES = 20;
+    static const std::chrono::nanoseconds JITTER{std::chrono::milliseconds(2)};
+
+    m_track->record(0, m_start);
+    for (int i = 1; i <= NUM_WRITES; ++i) {
+        auto jitter = (i % 2) ? JITTER : -JITTER;
+        m_track->record(WRITE_SIZE * i, m_start + WORD_DURATION * (WRITE_SIZE * i) + jitter);
+    }
+    for (TimestampTrack::Index index = 0; index <= WRITE_SIZE * NUM_WRITES; ++index) {
+        ASSERT_TRUE(timeIsAccurate(index, JITTER + ROUNDING_ERROR));
+    }
+}
+
+/// Verify that no time is given for indices which were not captured, or whose times are no longer kept.
+TEST_F(TimestampTrackTest, unknownIndices) {
+    static const TimestampTrack::Index FIRST_INDEX = 1000;
+    static const TimestampTrack::Index WRITE_SIZE = WORDS_PER_SLOT * 3;
+    Clock::SteadyTimePoint time;
+
+    EXPECT_FALSE(m_track->getTime(0, &time));
+    m_clock->advance(WORD_DURATION * FIRST_INDEX);
+    m_track->recordNow(FIRST_INDEX);
+    EXPECT_TRUE(timeIsAccurate(FIRST_INDEX, ROUNDING_ERROR));
+    EXPECT_FALSE(m_track->getTime(FIRST_INDEX - 1, &time));
+    EXPECT_FALSE(m_track->getTime(FIRST_INDEX + 1, &time));
+    EXPECT_FALSE(m_track->getTime(FIRST_INDEX, nullptr));
+
+    // Write until the ring has wrapped several times.
+    TimestampTrack::Index endIndex = FIRST_INDEX;
+    for (size_t i = 0; i < NUM_SLOTS; ++i) {
+        endIndex += WRITE_SIZE;
+        m_clock->advance(WORD_DURATION * WRITE_SIZE);
+        m_track->recordNow(endIndex);
+    }
+    TimestampTrack::Index oldestIndex = (endIndex / WORDS_PER_SLOT - NUM_SLOTS + 1) * WORDS_PER_SLOT;
+    EXPECT_TRUE(timeIsAccurate(oldestIndex, ROUNDING_ERROR));
+    EXPECT_TRUE(timeIsAccurate(endIndex, ROUNDING_ERROR));
+    EXPECT_FALSE(m_track->getTime(oldestIndex - 1, &time));
+    EXPECT_FALSE(m_track->getTime(FIRST_INDEX, &time));
+    EXPECT_FALSE(m_track->getTime(endIndex + 1, &time));
+
+    // Records which go back in time are ignored.
+    m_track->record(endIndex + WRITE_SIZE, m_start);
+    EXPECT_FALSE(m_track->getTime(endIndex + 1, &time));
+    m_track->recordNow(endIndex - 1);
+    EXPECT_TRUE(timeIsAccurate(endIndex, ROUNDING_ERROR));
+}
+
+/// Verify that the @c Writer of a @c SharedDataStream records its writes in the stream's track.
+TEST_F(TimestampTrackTest, writerRecords) {
+    static const size_t WORD_SIZE = 2;
+    static const size_t WORD_COUNT = 4096;
+    static const size_t MAX_READERS = 1;
+    static const size_t WRITE_SIZE = 250;
+    static const int NUM_WRITES = 10;
+
+    auto buffer = std::make_shared<InProcessSDS::Buffer>(
+        InProcessSDS::calculateBufferSize(WORD_COUNT, WORD_SIZE, MAX_READERS));
+    auto sds = InProcessSDS::create(buffer, WORD_SIZE, MAX_READERS);
+    ASSERT_NE(sds, nullptr);
+    EXPECT_EQ(sds->getTimestampTrack(), nullptr);
+    sds->setTimestampTrack(m_track);
+    EXPECT_EQ(sds->getTimestampTrack(), m_track);
+    auto writer = sds->createWriter(InProcessSDS::Writer::Policy::NONBLOCKABLE);
+    ASSERT_NE(writer, nullptr);
+
+    // Record the start, as a capture source would before its first write.
+    m_track->recordNow(writer->tell());
+    std::vector<uint16_t> samples(WRITE_SIZE);
+    for (int i = 0; i < NUM_WRITES; ++i) {
+        m_clock->advance(WORD_DURATION * WRITE_SIZE);
+        ASSERT_EQ(writer->write(samples.data(), samples.size()), static_cast<ssize_t>(samples.size()));
+    }
+    for (TimestampTrack::Index index = 0; index <= writer->tell(); ++index) {
+        ASSERT_TRUE(timeIsAccurate(index, ROUNDING_ERROR));
+    }
+
+    // Detaching the track stops recording.
+    sds->setTimestampTrack(nullptr);
+    m_clock->advance(WORD_DURATION * WRITE_SIZE);
+    ASSERT_EQ(writer->write(samples.data(), samples.size()), static_cast<ssize_t>(samples.size()));
+    Clock::SteadyTimePoint time;
+    EXPECT_FALSE(m_track->getTime(writer->tell(), &time));
+}
+
+}  // namespace test
+}  // namespace sds
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -0,0 +1,171 @@
+/*
+ * WakeupAuditTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file WakeupAuditTest.cpp
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "AVSCommon/Utils/Threading/ThreadName.h"
+#include "AVSCommon/Utils/Threading/WakeupAudit.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace threading {
+namespace test {
+
+/// The name of the thread the tests wake.
+static const std::string THREAD_NAME = "AuditedThread";
+
+/// The number of times the tests wake the thread.
+static const int NUM_WAKEUPS = 20;
+
+/// The time between wakeups, long enough for the thread to go back to sleep each time.
+static const auto WAKEUP_INTERVAL = std::chrono::milliseconds(5);
+
+/// The time the blocked thread is audited for.
+static const auto AUDIT_PERIOD = std::chrono::milliseconds(200);
+
+/// Test harness for @c WakeupAudit, with a named thread which sleeps until it is woken.
+class WakeupAuditTest : public ::testing::Test {
+public:
+    /// Start the thread, and wait until it has named itself.
+    void SetUp() override;
+
+    /// Stop the thread.
+    void TearDown() override;
+
+protected:
+    /// Wake the thread once.
+    void wake();
+
+    /// Serializes access to the members below.
+    std::mutex m_mutex;
+
+    /// Notified to wake the thread.
+    std::condition_variable m_wakeTrigger;
+
+    /// The number of times the thread has been woken and not yet run.
+    int m_pendingWakeups = 0;
+
+    /// Whether the thread has named itself.
+    bool m_isNamed = false;
+
+    /// Whether the thread should exit.
+    bool m_isStopping = false;
+
+    /// The thread.
+    std::thread m_thread;
+};
+
+void WakeupAuditTest::SetUp() {
+    m_thread = std::thread([this] {
+        setThreadName(THREAD_NAME);
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_isNamed = true;
+        m_wakeTrigger.notify_all();
+        while (true) {
+            m_wakeTrigger.wait(lock, [this] { return m_isStopping || m_pendingWakeups > 0; });
+            if (m_isStopping) {
+                return;
+            }
+            --m_pendingWakeups;
+        }
+    });
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_wakeTrigger.wait(lock, [this] { return m_isNamed; });
+}
+
+void WakeupAuditTest::TearDown() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isStopping = true;
+    }
+    m_wakeTrigger.notify_all();
+    m_thread.join();
+}
+
+void WakeupAuditTest::wake() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_pendingWakeups;
+    }
+    m_wakeTrigger.notify_all();
+}
+
+/**
+ * Verify that a thread can name itself, and that a name too long for Linux is truncated rather than ignored.
+ */
+TEST(ThreadNameTest, setThreadName) {
+    std::string name;
+    std::string longName;
+    std::thread([&name, &longName] {
+        setThreadName("ThreadNameTest");
+        name = getThreadName();
+        setThreadName("ThreadNameTestWithALongName");
+        longName = getThreadName();
+    }).join();
+#ifdef __linux__
+    EXPECT_EQ(name, "ThreadNameTest");
+    EXPECT_EQ(longName, "ThreadNameTestW");
+#endif
+}
+
+// The scheduler statistics the audit reads are only available on Linux.
+#ifdef __linux__
+/**
+ * Verify that each wakeup of a named thread is counted under its name.
+ */
+TEST_F(WakeupAuditTest, countsWakeupsByName) {
+    auto audit = WakeupAudit::create();
+    ASSERT_TRUE(audit);
+    for (int i = 0; i < NUM_WAKEUPS; ++i) {
+        wake();
+        std::this_thread::sleep_for(WAKEUP_INTERVAL);
+    }
+    auto wakeups = audit->getWakeups();
+    ASSERT_EQ(wakeups.count(THREAD_NAME), 1u);
+    EXPECT_EQ(wakeups[THREAD_NAME].numThreads, 1u);
+    EXPECT_GE(wakeups[THREAD_NAME].numWakeups, static_cast<uint64_t>(NUM_WAKEUPS));
+    EXPECT_GT(wakeups[THREAD_NAME].wakeupsPerSecond, 0);
+}
+
+/**
+ * Verify that a thread which stays blocked is not counted as waking.
+ */
+TEST_F(WakeupAuditTest, blockedThreadDoesNotWake) {
+    // Let the thread finish going to sleep after naming itself.
+    std::this_thread::sleep_for(WAKEUP_INTERVAL);
+    auto audit = WakeupAudit::create();
+    ASSERT_TRUE(audit);
+    std::this_thread::sleep_for(AUDIT_PERIOD);
+    auto wakeups = audit->getWakeups();
+    ASSERT_EQ(wakeups.count(THREAD_NAME), 1u);
+    EXPECT_EQ(wakeups[THREAD_NAME].numWakeups, 0u);
+}
+#endif
+
+}  // namespace test
+}  // namespace threading
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -39,7 +39,7 @@
 #include <AVSCommon/SDKInterfaces/TemplateRuntimeObserverInterface.h>
 #include <AVSCommon/Utils/MediaPlayer/MediaPlayerInterface.h>
 #include <CertifiedSender/CertifiedSender.h>
-#include <CertifiedSender/SQLiteMessageStorage.h>
+#include <CertifiedSender/MessageStorageFactory.h>
 #include <PlaybackController/PlaybackController.h>
 #include <Settings/Settings.h>
 #include <Settings/SettingsStorageInterface.h>
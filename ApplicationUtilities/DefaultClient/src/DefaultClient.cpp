@@ -22,6 +22,7 @@
 #include <ACL/Transport/PostConnectObject.h>
 #include <AVSCommon/AVS/Attachment/AttachmentManager.h>
 #include <AVSCommon/AVS/ExceptionEncounteredSender.h>
+#include <AVSCommon/Utils/ShutdownOrchestrator.h>
 #include <Settings/SettingsUpdatedEventSender.h>
 #include <ContextManager/ContextManager.h>
 #include <System/EndpointHandler.h>
@@ -40,6 +41,9 @@ static const std::string TAG("DefaultClient");
  */
 #define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
 
+/// How long the components of a client may take to shut down before those still pending are logged as an error.
+static const std::chrono::seconds SHUTDOWN_DEADLINE(5);
+
 std::unique_ptr<DefaultClient> DefaultClient::create(
     std::shared_ptr<avsCommon::utils::mediaPlayer::MediaPlayerInterface> speakMediaPlayer,
     std::shared_ptr<avsCommon::utils::mediaPlayer::MediaPlayerInterface> audioMediaPlayer,
@@ -159,7 +163,11 @@ bool DefaultClient::initialize(
      * formatted AVS Events) will be sent to AVS.  This nicely decouples strict message sending from components which
      * require an Event be sent, even in conditions when there is no active AVS connection.
      */
-    auto messageStorage = std::make_shared<certifiedSender::SQLiteMessageStorage>();
+    auto messageStorage = certifiedSender::MessageStorageFactory::create();
+    if (!messageStorage) {
+        ACSDK_ERROR(LX("initializeFailed").d("reason", "unableToCreateMessageStorage"));
+        return false;
+    }
     m_certifiedSender =
         certifiedSender::CertifiedSender::create(m_connectionManager, m_connectionManager, messageStorage);
     if (!m_certifiedSender) {
@@ -542,39 +550,27 @@ std::future<bool> DefaultClient::notifyOfTapToTalkEnd() {
 }
 
 DefaultClient::~DefaultClient() {
-    if (m_directiveSequencer) {
-        m_directiveSequencer->shutdown();
-    }
-    if (m_speakerManager) {
-        m_speakerManager->shutdown();
-    }
-    if (m_templateRuntime) {
-        m_templateRuntime->shutdown();
-    }
-    if (m_audioInputProcessor) {
-        m_audioInputProcessor->shutdown();
-    }
-    if (m_audioPlayer) {
-        m_audioPlayer->shutdown();
-    }
-    if (m_speechSynthesizer) {
-        m_speechSynthesizer->shutdown();
-    }
-    if (m_alertsCapabilityAgent) {
-        m_alertsCapabilityAgent->shutdown();
-    }
-    if (m_playbackController) {
-        m_playbackController->shutdown();
-    }
-    if (m_messageRouter) {
-        m_messageRouter->shutdown();
-    }
-    if (m_connectionManager) {
-        m_connectionManager->shutdown();
-    }
-    if (m_certifiedSender) {
-        m_certifiedSender->shutdown();
-    }
+    // The directive sequencer stops first so that no directive reaches a capability agent which is shutting down, and
+    // the connection goes last so that the capability agents can still send their final events.  The capability agents
+    // don't depend on each other's shutdown, so they shut down in parallel.  The only objects they share are the
+    // FocusManager and the ContextManager, which are not shut down here, and which they only call through thread safe
+    // methods that don't wait: releasing a channel is queued on the FocusManager's own thread, and the ContextManager
+    // guards its state providers with a mutex.  A focus change caused by one agent releasing its channel reaches the
+    // others on the FocusManager's thread, not on a shutdown thread, and is dropped by an agent whose executor is
+    // already shut down, as it would be if they were shut down one after the other.
+    avsCommon::utils::ShutdownOrchestrator orchestrator(SHUTDOWN_DEADLINE);
+    orchestrator.addStage({m_directiveSequencer});
+    orchestrator.addStage({m_speakerManager,
+                           m_templateRuntime,
+                           m_audioInputProcessor,
+                           m_audioPlayer,
+                           m_speechSynthesizer,
+                           m_alertsCapabilityAgent,
+                           m_playbackController});
+    orchestrator.addStage({m_messageRouter});
+    orchestrator.addStage({m_connectionManager});
+    orchestrator.addStage({m_certifiedSender});
+    orchestrator.shutdown();
 }
 
 }  // namespace defaultClient
@@ -30,6 +30,9 @@
 #include <AVSCommon/SDKInterfaces/AuthObserverInterface.h>
 #include <AVSCommon/Utils/LibcurlUtils/HttpPostInterface.h>
 #include <AVSCommon/Utils/RetryTimer.h>
+#include <AVSCommon/Utils/Timing/Clock.h>
+
+#include "AuthDelegate/AuthTokenStorageInterface.h"
 
 namespace alexaClientSDK {
 namespace authDelegate {
@@ -63,10 +66,19 @@ public:
      *
      * @param httpPost Instance that implement HttpPostInterface. Must not be @c nullptr. The behavior for passing in
      *     @c nullptr is undefined.
+     * @param clock The clock to schedule refreshes, retries and expirations with.  If @c nullptr,
+     *     @c Clock::getDefault() is used.
+     * @param storage Where to persist the access token, or @c nullptr to not persist it.  A token stored by an earlier
+     *     run which is still valid is used straight away, rather than waiting for a refresh from LWA, which makes the
+     *     @c AuthDelegate @c REFRESHED as soon as it is created.  The token is stored for the configured client ID
+     *     and refresh token, and a token stored for others is discarded, so a device which changes clients or
+     *     accounts never uses the token of the previous one.
      * @return If successful, returns a new AuthDelegate, otherwise @c nullptr.
      */
     static std::unique_ptr<AuthDelegate> create(
-        std::unique_ptr<avsCommon::utils::libcurlUtils::HttpPostInterface> httpPost);
+        std::unique_ptr<avsCommon::utils::libcurlUtils::HttpPostInterface> httpPost,
+        std::shared_ptr<avsCommon::utils::timing::Clock> clock = nullptr,
+        std::shared_ptr<AuthTokenStorageInterface> storage = nullptr);
 
     /**
      * Deleted copy constructor
@@ -96,8 +108,13 @@ private:
      * AuthDelegate constructor.
      *
      * @param httpPost Instance that implement HttpPostInterface. Must not be @c nullptr, or the behavior is undefined.
+     * @param clock The clock to schedule refreshes, retries and expirations with.
+     * @param storage Where to persist the access token, or @c nullptr to not persist it.
      */
-    AuthDelegate(std::unique_ptr<avsCommon::utils::libcurlUtils::HttpPostInterface> httpPost);
+    AuthDelegate(
+        std::unique_ptr<avsCommon::utils::libcurlUtils::HttpPostInterface> httpPost,
+        std::shared_ptr<avsCommon::utils::timing::Clock> clock,
+        std::shared_ptr<AuthTokenStorageInterface> storage);
 
     /**
      * init() is used by create() to perform initialization after construction but before returning the
@@ -107,6 +124,18 @@ private:
      */
     bool init();
 
+    /**
+     * Take the token from @c m_storage if it holds one which has not expired yet.  The next refresh is scheduled as if
+     * the token had just been received from LWA, so a token which is about to expire is refreshed straight away, but
+     * can still be used in the meantime.  Called before @c m_refreshAndNotifyThread starts.
+     */
+    void loadStoredAuthToken();
+
+    /**
+     * Persist @c m_authToken and @c m_expirationTime to @c m_storage, if there is one.
+     */
+    void storeAuthToken();
+
     /// Method run in its own thread to refresh the auth token and notify for auth state changes.
     void refreshAndNotifyThreadFunction();
 
@@ -153,6 +182,22 @@ private:
      */
     void setState(avsCommon::sdkInterfaces::AuthObserverInterface::State newState);
 
+    /// The clock to schedule refreshes, retries and expirations with.
+    std::shared_ptr<avsCommon::utils::timing::Clock> m_clock;
+
+    /**
+     * Where to persist the access token, or @c nullptr to not persist it.
+     * Access is not synchronized because it is only accessed by @c m_refreshAndNotifyThread after @c init().
+     */
+    std::shared_ptr<AuthTokenStorageInterface> m_storage;
+
+    /**
+     * The credentials the access token is stored for: the configured client ID and refresh token.  Unlike
+     * @c m_refreshToken, this is not updated when LWA returns a new refresh token, so that the token stored by one run
+     * loads in the next, which starts from the configuration again.
+     */
+    std::string m_storageCredentials;
+
     /// Authorization state change observers. Access is synchronized with @c m_mutex.
     std::unordered_set<std::shared_ptr<avsCommon::sdkInterfaces::AuthObserverInterface>> m_observers;
 
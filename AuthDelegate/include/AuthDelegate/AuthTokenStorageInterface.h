@@ -0,0 +1,87 @@
+/*
+ * AuthTokenStorageInterface.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AUTHDELEGATE_INCLUDE_AUTHDELEGATE_AUTHTOKENSTORAGEINTERFACE_H_
+#define ALEXA_CLIENT_SDK_AUTHDELEGATE_INCLUDE_AUTHDELEGATE_AUTHTOKENSTORAGEINTERFACE_H_
+
+#include <chrono>
+#include <string>
+
+namespace alexaClientSDK {
+namespace authDelegate {
+
+/**
+ * An interface for persisting the LWA access token across restarts, so that a device which restarts while its token
+ * is still valid can connect to AVS without first waiting for a round trip to LWA.
+ *
+ * The access token grants access to the user's account until it expires, so implementations must keep it encrypted
+ * at rest.
+ *
+ * Each token is stored along with an identifier of the credentials it was issued for.  A token is only loaded with the
+ * credentials it was stored with, so that a device which is given another client or account never uses the token of
+ * the previous one.  The identifier may contain secrets such as the refresh token, so implementations must not store
+ * it in the clear either.
+ *
+ * This interface does not provide any thread-safety guarantees.
+ */
+class AuthTokenStorageInterface {
+public:
+    /**
+     * Destructor.
+     */
+    virtual ~AuthTokenStorageInterface() = default;
+
+    /**
+     * Store an access token, replacing any token stored before.
+     *
+     * @param credentials An identifier of the credentials the token was issued for.
+     * @param authToken The access token.
+     * @param expirationTime The wall clock time at which the token expires.  Wall clock time is used as, unlike the
+     *     steady clock, it keeps its meaning across restarts.
+     * @return Whether the token was stored.
+     */
+    virtual bool store(
+        const std::string& credentials,
+        const std::string& authToken,
+        std::chrono::system_clock::time_point expirationTime) = 0;
+
+    /**
+     * Load the stored access token.  A token stored for other credentials is not loaded, and is removed.
+     *
+     * @param credentials An identifier of the credentials the token must have been issued for.
+     * @param[out] authToken The access token.
+     * @param[out] expirationTime The wall clock time at which the token expires.
+     * @return Whether a token was loaded.  This is @c false if none is stored, if the stored one was issued for other
+     *     credentials, or if it can't be read.
+     */
+    virtual bool load(
+        const std::string& credentials,
+        std::string* authToken,
+        std::chrono::system_clock::time_point* expirationTime) = 0;
+
+    /**
+     * Remove the stored access token, if any.
+     *
+     * @return Whether no token is stored anymore.
+     */
+    virtual bool clear() = 0;
+};
+
+}  // namespace authDelegate
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AUTHDELEGATE_INCLUDE_AUTHDELEGATE_AUTHTOKENSTORAGEINTERFACE_H_
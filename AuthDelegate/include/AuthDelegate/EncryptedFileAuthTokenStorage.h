@@ -0,0 +1,94 @@
+/*
+ * EncryptedFileAuthTokenStorage.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AUTHDELEGATE_INCLUDE_AUTHDELEGATE_ENCRYPTEDFILEAUTHTOKENSTORAGE_H_
+#define ALEXA_CLIENT_SDK_AUTHDELEGATE_INCLUDE_AUTHDELEGATE_ENCRYPTEDFILEAUTHTOKENSTORAGE_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "AuthDelegate/AuthTokenStorageInterface.h"
+
+namespace alexaClientSDK {
+namespace authDelegate {
+
+/**
+ * An @c AuthTokenStorageInterface which keeps the access token in a file, encrypted and authenticated with
+ * AES-256-GCM.
+ *
+ * The key is supplied by the device, which should keep it somewhere the file is not, for instance in a secure element
+ * or a key store of the platform.  A file which was written with another key, or which has been tampered with, fails
+ * to load, in which case the @c AuthDelegate falls back to refreshing the token from LWA.
+ *
+ * The credentials the token was issued for are authenticated along with it as additional data, but are not written to
+ * the file.  Loading with other credentials fails authentication, and the file is then removed.
+ */
+class EncryptedFileAuthTokenStorage : public AuthTokenStorageInterface {
+public:
+    /// The size in bytes of the key.
+    static const size_t KEY_SIZE = 32;
+
+    /**
+     * Create an @c EncryptedFileAuthTokenStorage.
+     *
+     * @param filePath The path of the file to keep the token in.  Its directory must exist.
+     * @param key The key to encrypt the token with, which must be @c KEY_SIZE bytes long.
+     * @return The new @c EncryptedFileAuthTokenStorage, or @c nullptr if the parameters are invalid.
+     */
+    static std::unique_ptr<EncryptedFileAuthTokenStorage> create(
+        const std::string& filePath,
+        const std::vector<unsigned char>& key);
+
+    /**
+     * Destructor.  The copy of the key is wiped.
+     */
+    ~EncryptedFileAuthTokenStorage();
+
+    /// @name AuthTokenStorageInterface methods
+    /// @{
+    bool store(
+        const std::string& credentials,
+        const std::string& authToken,
+        std::chrono::system_clock::time_point expirationTime) override;
+    bool load(
+        const std::string& credentials,
+        std::string* authToken,
+        std::chrono::system_clock::time_point* expirationTime) override;
+    bool clear() override;
+    /// @}
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param filePath The path of the file to keep the token in.
+     * @param key The key to encrypt the token with.
+     */
+    EncryptedFileAuthTokenStorage(const std::string& filePath, const std::vector<unsigned char>& key);
+
+    /// The path of the file to keep the token in.
+    const std::string m_filePath;
+
+    /// The key to encrypt the token with.
+    std::vector<unsigned char> m_key;
+};
+
+}  // namespace authDelegate
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AUTHDELEGATE_INCLUDE_AUTHDELEGATE_ENCRYPTEDFILEAUTHTOKENSTORAGE_H_
@@ -170,10 +170,13 @@ static AuthObserverInterface::Error getErrorCode(const std::string& error) {
 /**
  * Function to convert the number of times we have already retried to the time to perform the next retry.
  *
+ * @param now The current time.
  * @param retryCount The number of times we have retried
  * @return The time that the next retry should be attempted
  */
-static std::chrono::steady_clock::time_point calculateTimeToRetry(int retryCount) {
+static std::chrono::steady_clock::time_point calculateTimeToRetry(
+    std::chrono::steady_clock::time_point now,
+    int retryCount) {
     /**
      * Table of retry backoff values based upon page 77 of
      * @see https://images-na.ssl-images-amazon.com/images/G/01/mwsportal/
@@ -203,7 +206,7 @@ static std::chrono::steady_clock::time_point calculateTimeToRetry(int retryCount
     avsCommon::utils::RetryTimer RETRY_TIMER(
         retryBackoffTimes, retryTableSize, RETRY_DECREASE_PERCENTAGE, RETRY_INCREASE_PERCENTAGE);
 
-    return std::chrono::steady_clock::now() + RETRY_TIMER.calculateTimeToRetry(retryCount);
+    return now + RETRY_TIMER.calculateTimeToRetry(retryCount);
 }
 
 std::unique_ptr<AuthDelegate> AuthDelegate::create() {
@@ -211,19 +214,29 @@ std::unique_ptr<AuthDelegate> AuthDelegate::create() {
 }
 
 std::unique_ptr<AuthDelegate> AuthDelegate::create(
-    std::unique_ptr<avsCommon::utils::libcurlUtils::HttpPostInterface> httpPost) {
+    std::unique_ptr<avsCommon::utils::libcurlUtils::HttpPostInterface> httpPost,
+    std::shared_ptr<avsCommon::utils::timing::Clock> clock,
+    std::shared_ptr<AuthTokenStorageInterface> storage) {
     if (!avsCommon::avs::initialization::AlexaClientSDKInit::isInitialized()) {
         ACSDK_ERROR(LX("createFailed").d("reason", "sdkNotInitialized"));
         return nullptr;
     }
-    std::unique_ptr<AuthDelegate> instance(new AuthDelegate(std::move(httpPost)));
+    if (!clock) {
+        clock = avsCommon::utils::timing::Clock::getDefault();
+    }
+    std::unique_ptr<AuthDelegate> instance(new AuthDelegate(std::move(httpPost), clock, storage));
     if (instance->init()) {
         return instance;
     }
     return nullptr;
 }
 
-AuthDelegate::AuthDelegate(std::unique_ptr<avsCommon::utils::libcurlUtils::HttpPostInterface> httpPost) :
+AuthDelegate::AuthDelegate(
+    std::unique_ptr<avsCommon::utils::libcurlUtils::HttpPostInterface> httpPost,
+    std::shared_ptr<avsCommon::utils::timing::Clock> clock,
+    std::shared_ptr<AuthTokenStorageInterface> storage) :
+        m_clock{clock},
+        m_storage{storage},
         m_authState{AuthObserverInterface::State::UNINITIALIZED},
         m_authError{AuthObserverInterface::Error::NO_ERROR},
         m_isStopping{false},
@@ -291,6 +304,9 @@ bool AuthDelegate::init() {
         return false;
     }
 
+    // Neither may contain a NUL, so separating them with one keeps the pair unambiguous.
+    m_storageCredentials = m_clientId + '\0' + m_refreshToken;
+
     configuration.getString(CONFIG_KEY_LWA_URL, &m_lwaUrl, DEFAULT_LWA_URL);
 
     configuration.getDuration<std::chrono::seconds>(
@@ -304,10 +320,53 @@ bool AuthDelegate::init() {
         return false;
     }
 
+    loadStoredAuthToken();
     m_refreshAndNotifyThread = std::thread(&AuthDelegate::refreshAndNotifyThreadFunction, this);
     return true;
 }
 
+void AuthDelegate::loadStoredAuthToken() {
+    if (!m_storage) {
+        return;
+    }
+    std::string authToken;
+    std::chrono::system_clock::time_point expirationTime;
+    if (!m_storage->load(m_storageCredentials, &authToken, &expirationTime) || authToken.empty()) {
+        return;
+    }
+    // The steady clock restarts with the device, so the expiration is stored in wall clock time.
+    auto timeToExpiration = expirationTime - m_clock->systemNow();
+    if (timeToExpiration <= std::chrono::system_clock::duration::zero()) {
+        ACSDK_DEBUG(LX("storedAuthTokenIgnored").d("reason", "expired"));
+        return;
+    }
+
+    ACSDK_INFO(LX("storedAuthTokenLoaded")
+                   .d("expiresInSeconds", std::chrono::duration_cast<std::chrono::seconds>(timeToExpiration).count()));
+    m_expirationTime =
+        m_clock->steadyNow() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(timeToExpiration);
+    m_timeToRefresh = m_expirationTime - m_authTokenRefreshHeadStart;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_authToken = authToken;
+    m_authState = AuthObserverInterface::State::REFRESHED;
+}
+
+void AuthDelegate::storeAuthToken() {
+    if (!m_storage) {
+        return;
+    }
+    std::string authToken;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        authToken = m_authToken;
+    }
+    auto expirationTime = m_clock->systemNow() + std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                                                     m_expirationTime - m_clock->steadyNow());
+    if (!m_storage->store(m_storageCredentials, authToken, expirationTime)) {
+        ACSDK_WARN(LX("storeAuthTokenFailed"));
+    }
+}
+
 void AuthDelegate::refreshAndNotifyThreadFunction() {
     std::function<bool()> isStopping = [this] { return m_isStopping; };
 
@@ -319,7 +378,7 @@ void AuthDelegate::refreshAndNotifyThreadFunction() {
         auto nextState = m_authState;
 
         // Wait for an appropriate amount of time.
-        if (m_wakeThreadCond.wait_until(lock, nextActionTime, isStopping)) {
+        if (m_clock->waitUntil(m_wakeThreadCond, lock, nextActionTime, isStopping)) {
             break;
         }
         if (isAboutToExpire) {
@@ -338,7 +397,7 @@ void AuthDelegate::refreshAndNotifyThreadFunction() {
 
 AuthObserverInterface::Error AuthDelegate::refreshAuthToken() {
     // Don't wait for this request so long that we would be late to notify our observer if the token expires.
-    m_requestTime = std::chrono::steady_clock::now();
+    m_requestTime = m_clock->steadyNow();
     auto timeout = m_requestTimeout;
     if (AuthObserverInterface::State::REFRESHED == m_authState) {
         auto timeUntilExpired = std::chrono::duration_cast<std::chrono::seconds>(m_expirationTime - m_requestTime);
@@ -357,8 +416,13 @@ AuthObserverInterface::Error AuthDelegate::refreshAuthToken() {
 
     if (AuthObserverInterface::Error::NO_ERROR == newError) {
         m_retryCount = 0;
+        storeAuthToken();
     } else {
-        m_timeToRefresh = calculateTimeToRetry(m_retryCount++);
+        if (m_storage && isUnrecoverable(newError)) {
+            // The authorization has been revoked, so a stored token must not be used on the next start either.
+            m_storage->clear();
+        }
+        m_timeToRefresh = calculateTimeToRetry(m_clock->steadyNow(), m_retryCount++);
     }
     {
         std::lock_guard<std::mutex> lock(m_mutex);
@@ -438,7 +502,7 @@ AuthObserverInterface::Error AuthDelegate::handleLwaResponse(long code, const st
 }
 
 bool AuthDelegate::hasAuthTokenExpired() {
-    return std::chrono::steady_clock::now() >= m_expirationTime;
+    return m_clock->steadyNow() >= m_expirationTime;
 }
 
 void AuthDelegate::setState(AuthObserverInterface::State newState) {
@@ -0,0 +1,327 @@
+/*
+ * EncryptedFileAuthTokenStorage.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+#include "AuthDelegate/EncryptedFileAuthTokenStorage.h"
+
+namespace alexaClientSDK {
+namespace authDelegate {
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("EncryptedFileAuthTokenStorage");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/**
+ * The bytes the file starts with, identifying its format.  They are authenticated along with the token, followed by
+ * the credentials the token was issued for.
+ */
+static const std::string MAGIC = "ACSDKAT1";
+
+/// The size in bytes of the initialization vector, which is the size recommended for GCM.
+static const size_t IV_SIZE = 12;
+
+/// The size in bytes of the authentication tag.
+static const size_t TAG_SIZE = 16;
+
+/// The size in bytes of the expiration time, which precedes the token in the plaintext.
+static const size_t EXPIRATION_TIME_SIZE = 8;
+
+/// The suffix of the file the token is written to before it replaces the previous one.
+static const std::string TEMPORARY_FILE_SUFFIX = ".tmp";
+
+/// Deleter for @c EVP_CIPHER_CTX.
+struct CipherContextDeleter {
+    void operator()(EVP_CIPHER_CTX* context) const {
+        EVP_CIPHER_CTX_free(context);
+    }
+};
+
+/// A cipher context which is freed when it goes out of scope.
+using CipherContext = std::unique_ptr<EVP_CIPHER_CTX, CipherContextDeleter>;
+
+/**
+ * Encode a time as a big endian count of milliseconds since the epoch.
+ *
+ * @param time The time to encode.
+ * @return The encoded time.
+ */
+static std::string encodeTime(std::chrono::system_clock::time_point time) {
+    auto milliseconds = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count());
+    std::string encoded(EXPIRATION_TIME_SIZE, '\0');
+    for (size_t i = 0; i < EXPIRATION_TIME_SIZE; ++i) {
+        encoded[EXPIRATION_TIME_SIZE - 1 - i] = static_cast<char>(milliseconds >> (8 * i));
+    }
+    return encoded;
+}
+
+/**
+ * Decode a time encoded by @c encodeTime().
+ *
+ * @param encoded The start of the encoded time, which must be @c EXPIRATION_TIME_SIZE bytes long.
+ * @return The decoded time.
+ */
+static std::chrono::system_clock::time_point decodeTime(const unsigned char* encoded) {
+    uint64_t milliseconds = 0;
+    for (size_t i = 0; i < EXPIRATION_TIME_SIZE; ++i) {
+        milliseconds = (milliseconds << 8) | encoded[i];
+    }
+    return std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(
+            std::chrono::milliseconds(static_cast<int64_t>(milliseconds))));
+}
+
+/**
+ * Write all of a buffer to a file descriptor.
+ *
+ * @param fd The file descriptor to write to.
+ * @param data The data to write.
+ * @return Whether all of the data was written.
+ */
+static bool writeAll(int fd, const std::string& data) {
+    size_t written = 0;
+    while (written < data.size()) {
+        auto result = ::write(fd, data.data() + written, data.size() - written);
+        if (result < 0 && EINTR == errno) {
+            continue;
+        }
+        if (result <= 0) {
+            return false;
+        }
+        written += result;
+    }
+    return true;
+}
+
+/**
+ * Flush the directory holding a file to storage, so that a rename into it survives a power loss.
+ *
+ * @param filePath The path of the file whose directory to flush.
+ * @return Whether the directory was flushed.
+ */
+static bool syncDirectory(const std::string& filePath) {
+    auto separator = filePath.find_last_of('/');
+    std::string directory;
+    if (std::string::npos == separator) {
+        directory = ".";
+    } else if (0 == separator) {
+        directory = "/";
+    } else {
+        directory = filePath.substr(0, separator);
+    }
+    int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY);
+    if (fd < 0) {
+        return false;
+    }
+    bool synced = 0 == ::fsync(fd);
+    return 0 == ::close(fd) && synced;
+}
+
+std::unique_ptr<EncryptedFileAuthTokenStorage> EncryptedFileAuthTokenStorage::create(
+    const std::string& filePath,
+    const std::vector<unsigned char>& key) {
+    if (filePath.empty()) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "emptyFilePath"));
+        return nullptr;
+    }
+    if (key.size() != KEY_SIZE) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "invalidKeySize").d("size", key.size()));
+        return nullptr;
+    }
+    return std::unique_ptr<EncryptedFileAuthTokenStorage>(new EncryptedFileAuthTokenStorage(filePath, key));
+}
+
+EncryptedFileAuthTokenStorage::EncryptedFileAuthTokenStorage(
+    const std::string& filePath,
+    const std::vector<unsigned char>& key) :
+        m_filePath{filePath},
+        m_key{key} {
+}
+
+EncryptedFileAuthTokenStorage::~EncryptedFileAuthTokenStorage() {
+    OPENSSL_cleanse(m_key.data(), m_key.size());
+}
+
+bool EncryptedFileAuthTokenStorage::store(
+    const std::string& credentials,
+    const std::string& authToken,
+    std::chrono::system_clock::time_point expirationTime) {
+    unsigned char iv[IV_SIZE];
+    if (1 != RAND_bytes(iv, sizeof(iv))) {
+        ACSDK_ERROR(LX("storeFailed").d("reason", "randBytesFailed"));
+        return false;
+    }
+
+    std::string plaintext = encodeTime(expirationTime) + authToken;
+    std::string ciphertext(plaintext.size(), '\0');
+    unsigned char tag[TAG_SIZE];
+    CipherContext context(EVP_CIPHER_CTX_new());
+    int length = 0;
+    // GCM produces no output when finalized, but the output buffer is still required.
+    unsigned char finalBlock[EVP_MAX_BLOCK_LENGTH];
+    bool encrypted = context && 1 == EVP_EncryptInit_ex(context.get(), EVP_aes_256_gcm(), nullptr, nullptr, nullptr) &&
+                     1 == EVP_CIPHER_CTX_ctrl(context.get(), EVP_CTRL_GCM_SET_IVLEN, IV_SIZE, nullptr) &&
+                     1 == EVP_EncryptInit_ex(context.get(), nullptr, nullptr, m_key.data(), iv) &&
+                     1 == EVP_EncryptUpdate(
+                              context.get(),
+                              nullptr,
+                              &length,
+                              reinterpret_cast<const unsigned char*>(MAGIC.data()),
+                              MAGIC.size()) &&
+                     1 == EVP_EncryptUpdate(
+                              context.get(),
+                              nullptr,
+                              &length,
+                              reinterpret_cast<const unsigned char*>(credentials.data()),
+                              credentials.size()) &&
+                     1 == EVP_EncryptUpdate(
+                              context.get(),
+                              reinterpret_cast<unsigned char*>(&ciphertext[0]),
+                              &length,
+                              reinterpret_cast<const unsigned char*>(plaintext.data()),
+                              plaintext.size()) &&
+                     1 == EVP_EncryptFinal_ex(context.get(), finalBlock, &length) &&
+                     1 == EVP_CIPHER_CTX_ctrl(context.get(), EVP_CTRL_GCM_GET_TAG, TAG_SIZE, tag);
+    OPENSSL_cleanse(&plaintext[0], plaintext.size());
+    if (!encrypted) {
+        ACSDK_ERROR(LX("storeFailed").d("reason", "encryptFailed"));
+        return false;
+    }
+
+    // Write a new file and rename it over the old one, so that a crash part way through leaves the old token intact.
+    auto temporaryFilePath = m_filePath + TEMPORARY_FILE_SUFFIX;
+    int fd = ::open(temporaryFilePath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+    if (fd < 0) {
+        ACSDK_ERROR(LX("storeFailed").d("reason", "openFailed").d("path", temporaryFilePath).d("errno", errno));
+        return false;
+    }
+    auto contents = MAGIC + std::string(reinterpret_cast<char*>(iv), sizeof(iv)) +
+                    std::string(reinterpret_cast<char*>(tag), sizeof(tag)) + ciphertext;
+    bool written = writeAll(fd, contents) && 0 == ::fsync(fd);
+    if (0 != ::close(fd) || !written) {
+        ACSDK_ERROR(LX("storeFailed").d("reason", "writeFailed").d("path", temporaryFilePath));
+        std::remove(temporaryFilePath.c_str());
+        return false;
+    }
+    if (0 != std::rename(temporaryFilePath.c_str(), m_filePath.c_str())) {
+        ACSDK_ERROR(LX("storeFailed").d("reason", "renameFailed").d("path", m_filePath).d("errno", errno));
+        std::remove(temporaryFilePath.c_str());
+        return false;
+    }
+    if (!syncDirectory(m_filePath)) {
+        ACSDK_ERROR(LX("storeFailed").d("reason", "syncDirectoryFailed").d("path", m_filePath).d("errno", errno));
+        return false;
+    }
+    return true;
+}
+
+bool EncryptedFileAuthTokenStorage::load(
+    const std::string& credentials,
+    std::string* authToken,
+    std::chrono::system_clock::time_point* expirationTime) {
+    if (!authToken || !expirationTime) {
+        ACSDK_ERROR(LX("loadFailed").d("reason", "nullOutput"));
+        return false;
+    }
+
+    std::ifstream file(m_filePath, std::ios::binary);
+    if (!file) {
+        ACSDK_DEBUG(LX("loadFailed").d("reason", "noStoredToken").d("path", m_filePath));
+        return false;
+    }
+    std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    size_t headerSize = MAGIC.size() + IV_SIZE + TAG_SIZE;
+    if (contents.size() < headerSize + EXPIRATION_TIME_SIZE || 0 != contents.compare(0, MAGIC.size(), MAGIC)) {
+        ACSDK_ERROR(LX("loadFailed").d("reason", "invalidFormat").d("path", m_filePath));
+        return false;
+    }
+
+    auto iv = reinterpret_cast<const unsigned char*>(contents.data() + MAGIC.size());
+    std::string tag = contents.substr(MAGIC.size() + IV_SIZE, TAG_SIZE);
+    std::string plaintext(contents.size() - headerSize, '\0');
+    CipherContext context(EVP_CIPHER_CTX_new());
+    int length = 0;
+    unsigned char finalBlock[EVP_MAX_BLOCK_LENGTH];
+    bool decrypted = context && 1 == EVP_DecryptInit_ex(context.get(), EVP_aes_256_gcm(), nullptr, nullptr, nullptr) &&
+                     1 == EVP_CIPHER_CTX_ctrl(context.get(), EVP_CTRL_GCM_SET_IVLEN, IV_SIZE, nullptr) &&
+                     1 == EVP_DecryptInit_ex(context.get(), nullptr, nullptr, m_key.data(), iv) &&
+                     1 == EVP_DecryptUpdate(
+                              context.get(),
+                              nullptr,
+                              &length,
+                              reinterpret_cast<const unsigned char*>(MAGIC.data()),
+                              MAGIC.size()) &&
+                     1 == EVP_DecryptUpdate(
+                              context.get(),
+                              nullptr,
+                              &length,
+                              reinterpret_cast<const unsigned char*>(credentials.data()),
+                              credentials.size()) &&
+                     1 == EVP_DecryptUpdate(
+                              context.get(),
+                              reinterpret_cast<unsigned char*>(&plaintext[0]),
+                              &length,
+                              reinterpret_cast<const unsigned char*>(contents.data() + headerSize),
+                              plaintext.size()) &&
+                     1 == EVP_CIPHER_CTX_ctrl(context.get(), EVP_CTRL_GCM_SET_TAG, TAG_SIZE, &tag[0]) &&
+                     1 == EVP_DecryptFinal_ex(context.get(), finalBlock, &length);
+    if (!decrypted) {
+        // The token was stored with another key or for other credentials, or the file was damaged.  It can never be
+        // loaded, so don't leave it behind.
+        OPENSSL_cleanse(&plaintext[0], plaintext.size());
+        ACSDK_ERROR(LX("loadFailed").d("reason", "decryptFailed").d("path", m_filePath));
+        clear();
+        return false;
+    }
+
+    *expirationTime = decodeTime(reinterpret_cast<const unsigned char*>(plaintext.data()));
+    *authToken = plaintext.substr(EXPIRATION_TIME_SIZE);
+    OPENSSL_cleanse(&plaintext[0], plaintext.size());
+    return true;
+}
+
+bool EncryptedFileAuthTokenStorage::clear() {
+    if (0 != std::remove(m_filePath.c_str()) && ENOENT != errno) {
+        ACSDK_ERROR(LX("clearFailed").d("path", m_filePath).d("errno", errno));
+        return false;
+    }
+    return true;
+}
+
+}  // namespace authDelegate
+}  // namespace alexaClientSDK
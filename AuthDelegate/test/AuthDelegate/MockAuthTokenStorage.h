@@ -0,0 +1,53 @@
+/*
+ * MockAuthTokenStorage.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AUTHDELEGATE_TEST_AUTHDELEGATE_MOCKAUTHTOKENSTORAGE_H_
+#define ALEXA_CLIENT_SDK_AUTHDELEGATE_TEST_AUTHDELEGATE_MOCKAUTHTOKENSTORAGE_H_
+
+#include <chrono>
+#include <gmock/gmock.h>
+#include <string>
+
+#include "AuthDelegate/AuthTokenStorageInterface.h"
+
+namespace alexaClientSDK {
+namespace authDelegate {
+namespace test {
+
+/// Mock AuthTokenStorageInterface class
+class MockAuthTokenStorage : public AuthTokenStorageInterface {
+public:
+    MOCK_METHOD3(
+        store,
+        bool(
+            const std::string& credentials,
+            const std::string& authToken,
+            std::chrono::system_clock::time_point expirationTime));
+    MOCK_METHOD3(
+        load,
+        bool(
+            const std::string& credentials,
+            std::string* authToken,
+            std::chrono::system_clock::time_point* expirationTime));
+    MOCK_METHOD0(clear, bool());
+};
+
+}  // namespace test
+}  // namespace authDelegate
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AUTHDELEGATE_TEST_AUTHDELEGATE_MOCKAUTHTOKENSTORAGE_H_
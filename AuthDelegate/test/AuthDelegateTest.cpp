@@ -18,6 +18,7 @@
 #include <condition_variable>
 #include <chrono>
 #include <functional>
+#include <future>
 #include <memory>
 #include <string>
 
@@ -25,13 +26,16 @@
 #include <gtest/gtest.h>
 
 #include "AuthDelegate/AuthDelegate.h"
+#include "AuthDelegate/MockAuthTokenStorage.h"
 #include "AuthDelegate/MockHttpPost.h"
 #include "AVSCommon/AVS/Initialization/AlexaClientSDKInit.h"
+#include "AVSCommon/Utils/Timing/ManualClock.h"
 #include "MockAuthObserver.h"
 
 using namespace alexaClientSDK::authDelegate;
 using namespace alexaClientSDK::authDelegate::test;
 using namespace alexaClientSDK::avsCommon::utils::libcurlUtils;
+using namespace alexaClientSDK::avsCommon::utils::timing::test;
 
 using namespace ::testing;
 using namespace alexaClientSDK::avsCommon::avs::initialization;
@@ -46,6 +50,18 @@ static const std::string DEFAULT_LWA_URL = "https://api.amazon.com/auth/o2/token
  */
 static const auto TIME_OUT_IN_SECONDS = std::chrono::seconds(60);
 
+/// The access token in the responses of @c generateValidLwaResponseWithExpiration().
+static const std::string LWA_ACCESS_TOKEN = "Atza|IQEBLjAsAhQ3yD47Jkj09BfU_qgNk4";
+
+/// An access token persisted by an earlier run.
+static const std::string STORED_ACCESS_TOKEN = "Atza|StoredByAnEarlierRun";
+
+/// The credentials the access token is stored for: the client ID and refresh token of @c DEFAULT_SDK_CONFIGURATION.
+static const std::string STORAGE_CREDENTIALS = std::string("invalid clientId") + '\0' + "invalid refreshToken";
+
+/// How far to advance @c ManualClock at a time while waiting for a state change.
+static const auto CLOCK_STEP = std::chrono::milliseconds(100);
+
 /**
  * 'invalid_request' Error Code from LWA
  * @see https://images-na.ssl-images-amazon.com/images/G/01/lwa/dev/docs/website-developer-guide._TTH_.pdf
@@ -72,6 +88,8 @@ protected:
     AuthDelegateTest() {
         m_mockHttpPost = std::unique_ptr<MockHttpPost>(new MockHttpPost());
         m_mockAuthObserver = std::make_shared<NiceMock<MockAuthObserver>>();
+        m_clock = std::make_shared<ManualClock>();
+        m_observerAdded = m_observerAddedPromise.get_future().share();
     }
 
     /// Stub certain mock objects with default actions
@@ -99,6 +117,32 @@ protected:
         return m_cv.wait_for(lock, seconds, predicate);
     }
 
+    /**
+     * Block until @c m_mockAuthObserver has been added, so that responses which change the state are not sent before
+     * there is an observer to notify of the change.
+     */
+    void waitForObserver() {
+        m_observerAdded.wait_for(TIME_OUT_IN_SECONDS);
+    }
+
+    /**
+     * Advance @c m_clock until a condition becomes true, so that retries and expirations which take seconds of real
+     * time happen in milliseconds.
+     *
+     * @param timeout Specify how much time of @c m_clock to wait on a condition before timeout.
+     * @param predicate The condition to wait on until it becomes true.
+     * @return false if timed out, true otherwise.
+     */
+    bool advanceClockUntil(std::chrono::seconds timeout, std::function<bool()> predicate) {
+        return m_clock->advanceUntil(
+            [this, predicate]() {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                return predicate();
+            },
+            CLOCK_STEP,
+            timeout);
+    }
+
     /**
      * Generate a valid LWA response with specified expiration duration in seconds.
      *
@@ -107,7 +151,9 @@ protected:
      */
     std::string generateValidLwaResponseWithExpiration(std::chrono::seconds seconds) {
         std::string response = R"({
-                    "access_token":"Atza|IQEBLjAsAhQ3yD47Jkj09BfU_qgNk4",
+                    "access_token":")";
+        response += LWA_ACCESS_TOKEN;
+        response += R"(",
                     "expires_in":)";
         response += std::to_string(seconds.count());
         response += R"(,
@@ -133,12 +179,36 @@ protected:
         return response;
     }
 
+    /**
+     * Make @c m_mockStorage hold an access token for @c STORAGE_CREDENTIALS.
+     *
+     * @param authToken The access token.
+     * @param expiresIn How long after the current time of @c m_clock the token expires.
+     */
+    void storeToken(const std::string& authToken, std::chrono::seconds expiresIn) {
+        auto expirationTime = m_clock->systemNow() + expiresIn;
+        ON_CALL(*m_mockStorage, load(STORAGE_CREDENTIALS, _, _))
+            .WillByDefault(DoAll(SetArgPointee<1>(authToken), SetArgPointee<2>(expirationTime), Return(true)));
+    }
+
+    /// Mock object of @c AuthTokenStorageInterface in which AuthDelegate persists the access token.
+    std::shared_ptr<NiceMock<MockAuthTokenStorage>> m_mockStorage = std::make_shared<NiceMock<MockAuthTokenStorage>>();
+
     /// Mock object of @c HttpPostInterface through which refresh token request is sent in AuthDelegate.
     std::unique_ptr<MockHttpPost> m_mockHttpPost;
 
     /// Mock object of @c AuthObserverInterface which will be notified on current AuthDelegate status.
     std::shared_ptr<NiceMock<MockAuthObserver>> m_mockAuthObserver;
 
+    /// The clock driving the @c AuthDelegate under test, in tests which use @c advanceClockUntil.
+    std::shared_ptr<ManualClock> m_clock;
+
+    /// Fulfilled once @c m_mockAuthObserver has been added, in tests which use @c waitForObserver.
+    std::promise<void> m_observerAddedPromise;
+
+    /// Future of @c m_observerAddedPromise.
+    std::shared_future<void> m_observerAdded;
+
     /// Condition variable used by @c waitFor function.
     std::condition_variable m_cv;
 
@@ -270,7 +340,9 @@ TEST_F(AuthDelegateTest, retry) {
     bool tokenRefreshed = false;
     const auto& validResponse = generateValidLwaResponseWithExpiration(std::chrono::seconds(60));
     EXPECT_CALL(*m_mockHttpPost, doPost(_, _, _, _))
-        .WillOnce(Return(HttpPostInterface::HTTP_RESPONSE_CODE_UNDEFINED))
+        .WillOnce(DoAll(
+            InvokeWithoutArgs([this]() { waitForObserver(); }),
+            Return(HttpPostInterface::HTTP_RESPONSE_CODE_UNDEFINED)))
         .WillOnce(Return(HttpPostInterface::HTTP_RESPONSE_CODE_UNDEFINED))
         .WillOnce(DoAll(SetArgReferee<3>(validResponse), Return(HttpPostInterface::HTTP_RESPONSE_CODE_SUCCESS_OK)));
 
@@ -287,9 +359,10 @@ TEST_F(AuthDelegateTest, retry) {
             m_cv.notify_all();
         }));
 
-    auto authDelegate = AuthDelegate::create(std::move(m_mockHttpPost));
+    auto authDelegate = AuthDelegate::create(std::move(m_mockHttpPost), m_clock);
     authDelegate->addAuthObserver(m_mockAuthObserver);
-    ASSERT_TRUE(waitFor(TIME_OUT_IN_SECONDS, [&tokenRefreshed]() { return tokenRefreshed; }));
+    m_observerAddedPromise.set_value();
+    ASSERT_TRUE(advanceClockUntil(TIME_OUT_IN_SECONDS, [&tokenRefreshed]() { return tokenRefreshed; }));
 }
 
 /**
@@ -303,7 +376,10 @@ TEST_F(AuthDelegateTest, expirationNotification) {
     const auto& validResponse = generateValidLwaResponseWithExpiration(std::chrono::seconds(1));
 
     EXPECT_CALL(*m_mockHttpPost, doPost(_, _, _, _))
-        .WillOnce(DoAll(SetArgReferee<3>(validResponse), Return(HttpPostInterface::HTTP_RESPONSE_CODE_SUCCESS_OK)))
+        .WillOnce(DoAll(
+            InvokeWithoutArgs([this]() { waitForObserver(); }),
+            SetArgReferee<3>(validResponse),
+            Return(HttpPostInterface::HTTP_RESPONSE_CODE_SUCCESS_OK)))
         .WillRepeatedly(Return(HttpPostInterface::HTTP_RESPONSE_CODE_UNDEFINED));
 
     ::testing::InSequence s;
@@ -325,9 +401,10 @@ TEST_F(AuthDelegateTest, expirationNotification) {
             m_cv.notify_all();
         }));
 
-    auto authDelegate = AuthDelegate::create(std::move(m_mockHttpPost));
+    auto authDelegate = AuthDelegate::create(std::move(m_mockHttpPost), m_clock);
     authDelegate->addAuthObserver(m_mockAuthObserver);
-    ASSERT_TRUE(waitFor(TIME_OUT_IN_SECONDS, [&tokenExpired]() { return tokenExpired; }));
+    m_observerAddedPromise.set_value();
+    ASSERT_TRUE(advanceClockUntil(TIME_OUT_IN_SECONDS, [&tokenExpired]() { return tokenExpired; }));
 }
 
 /**
@@ -341,7 +418,10 @@ TEST_F(AuthDelegateTest, recoverAfterExpiration) {
     const auto& validResponse = generateValidLwaResponseWithExpiration(std::chrono::seconds(3));
 
     EXPECT_CALL(*m_mockHttpPost, doPost(_, _, _, _))
-        .WillOnce(DoAll(SetArgReferee<3>(validResponse), Return(HttpPostInterface::HTTP_RESPONSE_CODE_SUCCESS_OK)))
+        .WillOnce(DoAll(
+            InvokeWithoutArgs([this]() { waitForObserver(); }),
+            SetArgReferee<3>(validResponse),
+            Return(HttpPostInterface::HTTP_RESPONSE_CODE_SUCCESS_OK)))
         .WillOnce(Return(HttpPostInterface::HTTP_RESPONSE_CODE_UNDEFINED))
         .WillOnce(Return(HttpPostInterface::HTTP_RESPONSE_CODE_UNDEFINED))
         .WillOnce(Return(HttpPostInterface::HTTP_RESPONSE_CODE_UNDEFINED))
@@ -371,9 +451,10 @@ TEST_F(AuthDelegateTest, recoverAfterExpiration) {
             m_cv.notify_all();
         }));
 
-    auto authDelegate = AuthDelegate::create(std::move(m_mockHttpPost));
+    auto authDelegate = AuthDelegate::create(std::move(m_mockHttpPost), m_clock);
     authDelegate->addAuthObserver(m_mockAuthObserver);
-    ASSERT_TRUE(waitFor(TIME_OUT_IN_SECONDS, [&tokenRefreshed]() { return tokenRefreshed; }));
+    m_observerAddedPromise.set_value();
+    ASSERT_TRUE(advanceClockUntil(TIME_OUT_IN_SECONDS, [&tokenRefreshed]() { return tokenRefreshed; }));
 }
 
 /**
@@ -408,3 +489,119 @@ TEST_F(AuthDelegateTest, unrecoverableErrorNotification) {
     authDelegate->addAuthObserver(m_mockAuthObserver);
     ASSERT_TRUE(waitFor(TIME_OUT_IN_SECONDS, [&errorReceived]() { return errorReceived; }));
 }
+
+/**
+ * Test that a stored access token which is still valid is used straight away, without a request to LWA.
+ */
+TEST_F(AuthDelegateTest, storedTokenIsUsedWithoutRefresh) {
+    storeToken(STORED_ACCESS_TOKEN, std::chrono::hours(1));
+    EXPECT_CALL(*m_mockHttpPost, doPost(_, _, _, _)).Times(0);
+    EXPECT_CALL(*m_mockStorage, store(_, _, _)).Times(0);
+    EXPECT_CALL(
+        *m_mockAuthObserver,
+        onAuthStateChange(AuthObserverInterface::State::REFRESHED, AuthObserverInterface::Error::NO_ERROR))
+        .Times(1);
+
+    auto authDelegate = AuthDelegate::create(std::move(m_mockHttpPost), m_clock, m_mockStorage);
+    ASSERT_TRUE(authDelegate);
+    EXPECT_EQ(authDelegate->getAuthToken(), STORED_ACCESS_TOKEN);
+    authDelegate->addAuthObserver(m_mockAuthObserver);
+}
+
+/**
+ * Test that a stored access token is refreshed ahead of its expiration, and that the refreshed token is stored with
+ * its expiration.
+ */
+TEST_F(AuthDelegateTest, storedTokenIsRefreshedAndReplaced) {
+    static const auto STORED_TOKEN_EXPIRES_IN = std::chrono::seconds(10);
+    static const auto LWA_TOKEN_EXPIRES_IN = std::chrono::seconds(3600);
+    bool tokenStored = false;
+    storeToken(STORED_ACCESS_TOKEN, STORED_TOKEN_EXPIRES_IN);
+    EXPECT_CALL(*m_mockHttpPost, doPost(_, _, _, _))
+        .WillOnce(DoAll(
+            SetArgReferee<3>(generateValidLwaResponseWithExpiration(LWA_TOKEN_EXPIRES_IN)),
+            Return(HttpPostInterface::HTTP_RESPONSE_CODE_SUCCESS_OK)));
+    std::chrono::system_clock::time_point expirationTime;
+    std::chrono::system_clock::time_point requestTime;
+    EXPECT_CALL(*m_mockStorage, store(STORAGE_CREDENTIALS, LWA_ACCESS_TOKEN, _))
+        .WillOnce(DoAll(SaveArg<2>(&expirationTime), InvokeWithoutArgs([this, &tokenStored, &requestTime] {
+                            std::lock_guard<std::mutex> lock(m_mutex);
+                            requestTime = m_clock->systemNow();
+                            tokenStored = true;
+                            return true;
+                        })));
+
+    auto authDelegate = AuthDelegate::create(std::move(m_mockHttpPost), m_clock, m_mockStorage);
+    ASSERT_TRUE(authDelegate);
+    EXPECT_EQ(authDelegate->getAuthToken(), STORED_ACCESS_TOKEN);
+    ASSERT_TRUE(advanceClockUntil(TIME_OUT_IN_SECONDS, [&tokenStored]() { return tokenStored; }));
+    EXPECT_EQ(authDelegate->getAuthToken(), LWA_ACCESS_TOKEN);
+    EXPECT_LE(expirationTime - requestTime, LWA_TOKEN_EXPIRES_IN);
+    EXPECT_GT(expirationTime - requestTime, LWA_TOKEN_EXPIRES_IN - STORED_TOKEN_EXPIRES_IN);
+}
+
+/**
+ * Test that an expired stored access token is not used, and that it is replaced once a token is received from LWA.
+ */
+TEST_F(AuthDelegateTest, expiredStoredTokenIsIgnored) {
+    bool tokenRefreshed = false;
+    storeToken(STORED_ACCESS_TOKEN, std::chrono::seconds(-1));
+    EXPECT_CALL(*m_mockHttpPost, doPost(_, _, _, _))
+        .WillOnce(DoAll(
+            InvokeWithoutArgs([this]() { waitForObserver(); }),
+            SetArgReferee<3>(generateValidLwaResponseWithExpiration(std::chrono::seconds(3600))),
+            Return(HttpPostInterface::HTTP_RESPONSE_CODE_SUCCESS_OK)));
+    EXPECT_CALL(*m_mockStorage, store(STORAGE_CREDENTIALS, LWA_ACCESS_TOKEN, _)).WillOnce(Return(true));
+
+    ::testing::InSequence s;
+    EXPECT_CALL(
+        *m_mockAuthObserver,
+        onAuthStateChange(AuthObserverInterface::State::UNINITIALIZED, AuthObserverInterface::Error::NO_ERROR))
+        .Times(1);
+    EXPECT_CALL(
+        *m_mockAuthObserver,
+        onAuthStateChange(AuthObserverInterface::State::REFRESHED, AuthObserverInterface::Error::NO_ERROR))
+        .WillOnce(InvokeWithoutArgs([this, &tokenRefreshed]() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            tokenRefreshed = true;
+            m_cv.notify_all();
+        }));
+
+    auto authDelegate = AuthDelegate::create(std::move(m_mockHttpPost), m_clock, m_mockStorage);
+    ASSERT_TRUE(authDelegate);
+    EXPECT_TRUE(authDelegate->getAuthToken().empty());
+    authDelegate->addAuthObserver(m_mockAuthObserver);
+    m_observerAddedPromise.set_value();
+    ASSERT_TRUE(waitFor(TIME_OUT_IN_SECONDS, [&tokenRefreshed]() { return tokenRefreshed; }));
+}
+
+/**
+ * Test that an unrecoverable error from LWA removes the stored access token, so that it is not used on the next start.
+ */
+TEST_F(AuthDelegateTest, unrecoverableErrorClearsStoredToken) {
+    bool errorReceived = false;
+    storeToken(STORED_ACCESS_TOKEN, std::chrono::seconds(1));
+    EXPECT_CALL(*m_mockHttpPost, doPost(_, _, _, _))
+        .WillOnce(DoAll(
+            SetArgReferee<3>(generateErrorLwaResponseWithErrorCode(ERROR_CODE_INVALID_REQUEST)),
+            Return(HTTP_RESPONSE_CODE_BAD_REQUEST)));
+    EXPECT_CALL(*m_mockStorage, clear()).WillOnce(Return(true));
+    EXPECT_CALL(
+        *m_mockAuthObserver,
+        onAuthStateChange(AuthObserverInterface::State::REFRESHED, AuthObserverInterface::Error::NO_ERROR))
+        .Times(AtMost(1));
+    EXPECT_CALL(
+        *m_mockAuthObserver,
+        onAuthStateChange(
+            AuthObserverInterface::State::UNRECOVERABLE_ERROR, AuthObserverInterface::Error::INVALID_REQUEST))
+        .WillOnce(InvokeWithoutArgs([this, &errorReceived]() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            errorReceived = true;
+            m_cv.notify_all();
+        }));
+
+    auto authDelegate = AuthDelegate::create(std::move(m_mockHttpPost), m_clock, m_mockStorage);
+    ASSERT_TRUE(authDelegate);
+    authDelegate->addAuthObserver(m_mockAuthObserver);
+    ASSERT_TRUE(waitFor(TIME_OUT_IN_SECONDS, [&errorReceived]() { return errorReceived; }));
+}
@@ -0,0 +1,225 @@
+/*
+ * EncryptedFileAuthTokenStorageTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "AuthDelegate/EncryptedFileAuthTokenStorage.h"
+
+namespace alexaClientSDK {
+namespace authDelegate {
+namespace test {
+
+/// The access token stored by the tests.
+static const std::string TEST_AUTH_TOKEN = "Atza|IQEBLjAsAhQ3yD47Jkj09BfU_qgNk4";
+
+/// The credentials the test token is stored for.
+static const std::string TEST_CREDENTIALS = std::string("amzn1.application-oa2-client.0") + '\0' + "Atzr|IwEBIA";
+
+/// The name of the file the tests store the token in, within a fresh directory.
+static const std::string TEST_FILE_NAME = "authToken";
+
+/// Test harness for @c EncryptedFileAuthTokenStorage.
+class EncryptedFileAuthTokenStorageTest : public ::testing::Test {
+public:
+    void SetUp() override;
+
+    void TearDown() override;
+
+protected:
+    /**
+     * Read the raw contents of the token file.
+     *
+     * @return The contents of the file.
+     */
+    std::string readFile();
+
+    /**
+     * Replace the raw contents of the token file.
+     *
+     * @param contents The new contents of the file.
+     */
+    void writeFile(const std::string& contents);
+
+    /// The directory holding the token file.
+    std::string m_directory;
+
+    /// The path of the token file.
+    std::string m_filePath;
+
+    /// The key to encrypt the token with.
+    std::vector<unsigned char> m_key;
+
+    /// The expiration time of the token.
+    std::chrono::system_clock::time_point m_expirationTime;
+};
+
+void EncryptedFileAuthTokenStorageTest::SetUp() {
+    char directory[] = "/tmp/EncryptedFileAuthTokenStorageTest-XXXXXX";
+    ASSERT_NE(mkdtemp(directory), nullptr);
+    m_directory = directory;
+    m_filePath = m_directory + "/" + TEST_FILE_NAME;
+    for (size_t i = 0; i < EncryptedFileAuthTokenStorage::KEY_SIZE; ++i) {
+        m_key.push_back(static_cast<unsigned char>(i * 7 + 1));
+    }
+    // The storage keeps milliseconds.
+    m_expirationTime = std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::milliseconds(1500000000123)));
+}
+
+void EncryptedFileAuthTokenStorageTest::TearDown() {
+    unlink(m_filePath.c_str());
+    EXPECT_EQ(rmdir(m_directory.c_str()), 0);
+}
+
+std::string EncryptedFileAuthTokenStorageTest::readFile() {
+    std::ifstream file(m_filePath, std::ios::binary);
+    return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+}
+
+void EncryptedFileAuthTokenStorageTest::writeFile(const std::string& contents) {
+    std::ofstream file(m_filePath, std::ios::binary | std::ios::trunc);
+    file << contents;
+}
+
+/**
+ * Verify that creation fails without a path or with a key of the wrong size.
+ */
+TEST_F(EncryptedFileAuthTokenStorageTest, createWithInvalidParameters) {
+    EXPECT_EQ(EncryptedFileAuthTokenStorage::create("", m_key), nullptr);
+    EXPECT_EQ(EncryptedFileAuthTokenStorage::create(m_filePath, std::vector<unsigned char>(16)), nullptr);
+    EXPECT_NE(EncryptedFileAuthTokenStorage::create(m_filePath, m_key), nullptr);
+}
+
+/**
+ * Verify that a stored token loads back with its expiration, also through a new instance, and that it is not stored
+ * in the clear.
+ */
+TEST_F(EncryptedFileAuthTokenStorageTest, storeAndLoad) {
+    auto storage = EncryptedFileAuthTokenStorage::create(m_filePath, m_key);
+    ASSERT_NE(storage, nullptr);
+    std::string authToken;
+    std::chrono::system_clock::time_point expirationTime;
+    EXPECT_FALSE(storage->load(TEST_CREDENTIALS, &authToken, &expirationTime));
+
+    ASSERT_TRUE(storage->store(TEST_CREDENTIALS, TEST_AUTH_TOKEN, m_expirationTime));
+    EXPECT_EQ(readFile().find(TEST_AUTH_TOKEN), std::string::npos);
+    EXPECT_EQ(access((m_filePath + ".tmp").c_str(), F_OK), -1);
+
+    storage = EncryptedFileAuthTokenStorage::create(m_filePath, m_key);
+    ASSERT_TRUE(storage->load(TEST_CREDENTIALS, &authToken, &expirationTime));
+    EXPECT_EQ(authToken, TEST_AUTH_TOKEN);
+    EXPECT_EQ(expirationTime, m_expirationTime);
+}
+
+/**
+ * Verify that storing replaces the previous token, and that encrypting the same token twice gives different files.
+ */
+TEST_F(EncryptedFileAuthTokenStorageTest, storeReplaces) {
+    auto storage = EncryptedFileAuthTokenStorage::create(m_filePath, m_key);
+    ASSERT_TRUE(storage->store(TEST_CREDENTIALS, TEST_AUTH_TOKEN, m_expirationTime));
+    auto first = readFile();
+    ASSERT_TRUE(storage->store(TEST_CREDENTIALS, TEST_AUTH_TOKEN, m_expirationTime));
+    EXPECT_NE(readFile(), first);
+
+    ASSERT_TRUE(storage->store(TEST_CREDENTIALS, "newToken", m_expirationTime + std::chrono::hours(1)));
+    std::string authToken;
+    std::chrono::system_clock::time_point expirationTime;
+    ASSERT_TRUE(storage->load(TEST_CREDENTIALS, &authToken, &expirationTime));
+    EXPECT_EQ(authToken, "newToken");
+    EXPECT_EQ(expirationTime, m_expirationTime + std::chrono::hours(1));
+}
+
+/**
+ * Verify that a token stored with another key does not load.
+ */
+TEST_F(EncryptedFileAuthTokenStorageTest, wrongKeyFailsToLoad) {
+    ASSERT_TRUE(EncryptedFileAuthTokenStorage::create(m_filePath, m_key)
+                    ->store(TEST_CREDENTIALS, TEST_AUTH_TOKEN, m_expirationTime));
+    auto otherKey = m_key;
+    otherKey[0] ^= 1;
+    std::string authToken;
+    std::chrono::system_clock::time_point expirationTime;
+    EXPECT_FALSE(EncryptedFileAuthTokenStorage::create(m_filePath, otherKey)
+                     ->load(TEST_CREDENTIALS, &authToken, &expirationTime));
+    EXPECT_TRUE(authToken.empty());
+}
+
+/**
+ * Verify that a token stored for other credentials does not load, and is removed.
+ */
+TEST_F(EncryptedFileAuthTokenStorageTest, otherCredentialsFailToLoad) {
+    auto storage = EncryptedFileAuthTokenStorage::create(m_filePath, m_key);
+    ASSERT_TRUE(storage->store(TEST_CREDENTIALS, TEST_AUTH_TOKEN, m_expirationTime));
+    EXPECT_EQ(readFile().find(TEST_CREDENTIALS), std::string::npos);
+
+    auto otherCredentials = TEST_CREDENTIALS;
+    otherCredentials.back() ^= 1;
+    std::string authToken;
+    std::chrono::system_clock::time_point expirationTime;
+    EXPECT_FALSE(storage->load(otherCredentials, &authToken, &expirationTime));
+    EXPECT_TRUE(authToken.empty());
+    EXPECT_EQ(access(m_filePath.c_str(), F_OK), -1);
+    EXPECT_FALSE(storage->load(TEST_CREDENTIALS, &authToken, &expirationTime));
+}
+
+/**
+ * Verify that a token file which has been tampered with or truncated does not load.
+ */
+TEST_F(EncryptedFileAuthTokenStorageTest, tamperedFileFailsToLoad) {
+    auto storage = EncryptedFileAuthTokenStorage::create(m_filePath, m_key);
+    ASSERT_TRUE(storage->store(TEST_CREDENTIALS, TEST_AUTH_TOKEN, m_expirationTime));
+    auto contents = readFile();
+    std::string authToken;
+    std::chrono::system_clock::time_point expirationTime;
+
+    for (size_t i = 0; i < contents.size(); ++i) {
+        auto tampered = contents;
+        tampered[i] ^= 0x40;
+        writeFile(tampered);
+        EXPECT_FALSE(storage->load(TEST_CREDENTIALS, &authToken, &expirationTime)) << "byte " << i;
+    }
+    writeFile(contents.substr(0, contents.size() - 1));
+    EXPECT_FALSE(storage->load(TEST_CREDENTIALS, &authToken, &expirationTime));
+    writeFile(contents);
+    EXPECT_TRUE(storage->load(TEST_CREDENTIALS, &authToken, &expirationTime));
+}
+
+/**
+ * Verify that a cleared token no longer loads, and that clearing without a token succeeds.
+ */
+TEST_F(EncryptedFileAuthTokenStorageTest, clear) {
+    auto storage = EncryptedFileAuthTokenStorage::create(m_filePath, m_key);
+    EXPECT_TRUE(storage->clear());
+    ASSERT_TRUE(storage->store(TEST_CREDENTIALS, TEST_AUTH_TOKEN, m_expirationTime));
+    EXPECT_TRUE(storage->clear());
+    std::string authToken;
+    std::chrono::system_clock::time_point expirationTime;
+    EXPECT_FALSE(storage->load(TEST_CREDENTIALS, &authToken, &expirationTime));
+}
+
+}  // namespace test
+}  // namespace authDelegate
+}  // namespace alexaClientSDK
@@ -18,6 +18,8 @@
 #ifndef ALEXA_CLIENT_SDK_CAPABILITYAGENTS_AIP_INCLUDE_AIP_AUDIOINPUTPROCESSOR_H_
 #define ALEXA_CLIENT_SDK_CAPABILITYAGENTS_AIP_INCLUDE_AIP_AUDIOINPUTPROCESSOR_H_
 
+#include <chrono>
+#include <cstdint>
 #include <memory>
 #include <unordered_set>
 
@@ -36,6 +38,7 @@
 #include <AVSCommon/SDKInterfaces/MessageSenderInterface.h>
 #include <AVSCommon/SDKInterfaces/UserActivityNotifierInterface.h>
 #include <AVSCommon/Utils/RequiresShutdown.h>
+#include <AVSCommon/Utils/SDS/TimestampTrack.h>
 #include <AVSCommon/Utils/Threading/Executor.h>
 #include <AVSCommon/Utils/Timing/Timer.h>
 #include "AudioProvider.h"
@@ -70,6 +73,9 @@ public:
     /// A reserved @c Index value which is considered invalid.
     static const auto INVALID_INDEX = std::numeric_limits<avsCommon::avs::AudioInputStream::Index>::max();
 
+    /// A @c contextSnapshotTimeout which makes every Recognize event wait for a fresh context.
+    static const std::chrono::milliseconds WAIT_FOR_FRESH_CONTEXT;
+
     /**
      * Creates a new @c AudioInputProcessor instance.
      *
@@ -83,6 +89,10 @@ public:
      * @param defaultAudioProvider A default @c avsCommon::AudioProvider to use for ExpectSpeech if the previous
      *     provider is not readable (@c avsCommon::AudioProvider::alwaysReadable).  This parameter is optional and
      *     defaults to an invalid @c avsCommon::AudioProvider.
+     * @param contextSnapshotTimeout How long a Recognize event waits for a fresh context from @c ContextManager
+     *     before it is sent with the most recent context received instead, so that slow state providers don't delay
+     *     the upload of the user's speech.  With a timeout of zero, the event is sent right away whenever a previous
+     *     context is available.  This parameter is optional and defaults to @c WAIT_FOR_FRESH_CONTEXT.
      * @return A @c std::shared_ptr to the new @c AudioInputProcessor instance.
      */
     static std::shared_ptr<AudioInputProcessor> create(
@@ -93,7 +103,8 @@ public:
         std::shared_ptr<avsCommon::avs::DialogUXStateAggregator> dialogUXStateAggregator,
         std::shared_ptr<avsCommon::sdkInterfaces::ExceptionEncounteredSenderInterface> exceptionEncounteredSender,
         std::shared_ptr<avsCommon::sdkInterfaces::UserActivityNotifierInterface> userActivityNotifier,
-        AudioProvider defaultAudioProvider = AudioProvider::null());
+        AudioProvider defaultAudioProvider = AudioProvider::null(),
+        std::chrono::milliseconds contextSnapshotTimeout = WAIT_FOR_FRESH_CONTEXT);
 
     /**
      * Adds an observer to be notified of AudioInputProcessor state changes.
@@ -228,6 +239,8 @@ private:
      * @param defaultAudioProvider A default @c avsCommon::AudioProvider to use for ExpectSpeech if the previous
      *     provider is not readable (@c AudioProvider::alwaysReadable).  This parameter is optional, and ignored if set
      *     to @c AudioProvider::null().
+     * @param contextSnapshotTimeout How long a Recognize event waits for a fresh context before it is sent with the
+     *     most recent context received instead.
      *
      * @note This constructor is private so that users are forced to use the @c create() factory function.  The primary
      *     reason for this is to ensure that a @c std::shared_ptr to the instance exists, which is a requirement for
@@ -240,7 +253,8 @@ private:
         std::shared_ptr<avsCommon::sdkInterfaces::FocusManagerInterface> focusManager,
         std::shared_ptr<avsCommon::sdkInterfaces::ExceptionEncounteredSenderInterface> exceptionEncounteredSender,
         std::shared_ptr<avsCommon::sdkInterfaces::UserActivityNotifierInterface> userActivityNotifier,
-        AudioProvider defaultAudioProvider);
+        AudioProvider defaultAudioProvider,
+        std::chrono::milliseconds contextSnapshotTimeout);
 
     /// @name RequiresShutdown Functions
     /// @{
@@ -354,6 +368,29 @@ private:
      */
     void executeOnContextFailure(const avsCommon::sdkInterfaces::ContextRequestError error);
 
+    /**
+     * This function sends the pending Recognize event with the most recent context received, because a fresh context
+     * did not arrive within @c m_contextSnapshotTimeout.
+     */
+    void executeOnContextSnapshotTimeout();
+
+    /**
+     * This function counts a response from @c ContextManager and checks whether it answers an earlier request than the
+     * last one made, in which case it is for a Recognize event which has since been sent or reset.
+     *
+     * @return Whether the response is stale and should be ignored.
+     */
+    bool executeIsStaleContextResponse();
+
+    /**
+     * This function assembles the @c MessageRequest for the pending Recognize event, and sends it if the dialog
+     * channel is already focused.  Otherwise, it is sent by @c executeOnFocusChanged() once the channel is acquired.
+     *
+     * @param jsonContext The system context to send with the event.
+     * @param isSnapshot Whether @c jsonContext is @c m_contextSnapshot rather than a context assembled for this event.
+     */
+    void executeAssembleRecognizeRequest(const std::string& jsonContext, bool isSnapshot);
+
     /**
      * This function is called when the @c FocusManager focus changes.  This might occur when another component
      * acquires focus on the dialog channel, in which case the @c AudioInputProcessor will end any activity and return
@@ -452,6 +489,14 @@ private:
     /// This function sends @c m_request, updates state, and calls @c m_deferredStopCapture if pending.
     void sendRequestNow();
 
+    /**
+     * This function returns the time elapsed since the first audio streamed in the current Recognize event was
+     * captured.  It must only be called while @c m_captureTimestampTrack is set.
+     *
+     * @return The time elapsed since the capture of the start of the audio.
+     */
+    std::chrono::milliseconds timeSinceCaptureBegin() const;
+
     /// @}
 
     /// The Directive Sequencer to register with for receiving directives.
@@ -469,9 +514,15 @@ private:
     /// The @c UserInactivityMonitor used to reset the inactivity timer of the user.
     std::shared_ptr<avsCommon::sdkInterfaces::UserActivityNotifierInterface> m_userActivityNotifier;
 
+    /// How long a Recognize event waits for a fresh context before it is sent with @c m_contextSnapshot instead.
+    const std::chrono::milliseconds m_contextSnapshotTimeout;
+
     /// Timer which runs in the @c EXPECTING_SPEECH state.
     avsCommon::utils::timing::Timer m_expectingSpeechTimer;
 
+    /// Timer which runs while a Recognize event waits for a fresh context, if it may fall back to a snapshot.
+    avsCommon::utils::timing::Timer m_contextSnapshotTimer;
+
     /**
      * @name Executor Thread Variables
      *
@@ -502,6 +553,15 @@ private:
      */
     std::shared_ptr<avsCommon::avs::attachment::InProcessAttachmentReader> m_reader;
 
+    /**
+     * The @c TimestampTrack of the stream being streamed for a Recognize event, if it has one and it knows when the
+     * first audio streamed was captured.  This is used to log latencies from the capture of the audio.
+     */
+    std::shared_ptr<avsCommon::utils::sds::TimestampTrack> m_captureTimestampTrack;
+
+    /// The time at which the first audio streamed for a Recognize event was captured, if @c m_captureTimestampTrack.
+    avsCommon::utils::timing::Clock::SteadyTimePoint m_captureBeginTime;
+
     /**
      * The payload for a Recognize event.  This string is populated by a call to @c executeRecognize(), and later
      * consumed by a call to @c executeOnContextAvailable() when the context arrives and the full @c MessageRequest can
@@ -517,6 +577,24 @@ private:
      */
     std::shared_ptr<avsCommon::avs::MessageRequest> m_request;
 
+    /**
+     * This flag is set to @c true when a Recognize event requests the context, and remains true until the event's
+     * @c MessageRequest is assembled, with either a fresh context or @c m_contextSnapshot.
+     */
+    bool m_waitingForContext;
+
+    /// The number of context requests made to @c ContextManager.  The last one is for the current Recognize event.
+    uint64_t m_contextRequestCount;
+
+    /// The number of responses received from @c ContextManager, up to @c m_contextRequestCount.
+    uint64_t m_contextResponseCount;
+
+    /// The most recent context received from @c ContextManager, or an empty string if none has been received.
+    std::string m_contextSnapshot;
+
+    /// The time at which @c m_contextSnapshot was received.
+    avsCommon::utils::timing::Clock::SteadyTimePoint m_contextSnapshotTime;
+
     /// The current state of the @c AudioInputProcessor.
     ObserverInterface::State m_state;
 
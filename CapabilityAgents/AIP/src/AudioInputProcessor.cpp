@@ -60,6 +60,8 @@ static const avsCommon::avs::NamespaceAndName EXPECT_SPEECH{NAMESPACE, "ExpectSp
 /// The SpeechRecognizer context state signature.
 static const avsCommon::avs::NamespaceAndName RECOGNIZER_STATE{NAMESPACE, "RecognizerState"};
 
+const std::chrono::milliseconds AudioInputProcessor::WAIT_FOR_FRESH_CONTEXT = std::chrono::milliseconds::max();
+
 std::shared_ptr<AudioInputProcessor> AudioInputProcessor::create(
     std::shared_ptr<avsCommon::sdkInterfaces::DirectiveSequencerInterface> directiveSequencer,
     std::shared_ptr<avsCommon::sdkInterfaces::MessageSenderInterface> messageSender,
@@ -68,7 +70,8 @@ std::shared_ptr<AudioInputProcessor> AudioInputProcessor::create(
     std::shared_ptr<avsCommon::avs::DialogUXStateAggregator> dialogUXStateAggregator,
     std::shared_ptr<avsCommon::sdkInterfaces::ExceptionEncounteredSenderInterface> exceptionEncounteredSender,
     std::shared_ptr<avsCommon::sdkInterfaces::UserActivityNotifierInterface> userActivityNotifier,
-    AudioProvider defaultAudioProvider) {
+    AudioProvider defaultAudioProvider,
+    std::chrono::milliseconds contextSnapshotTimeout) {
     if (!directiveSequencer) {
         ACSDK_ERROR(LX("createFailed").d("reason", "nullDirectiveSequencer"));
         return nullptr;
@@ -90,6 +93,11 @@ std::shared_ptr<AudioInputProcessor> AudioInputProcessor::create(
     } else if (!userActivityNotifier) {
         ACSDK_ERROR(LX("createFailed").d("reason", "nullUserActivityNotifier"));
         return nullptr;
+    } else if (contextSnapshotTimeout < std::chrono::milliseconds::zero()) {
+        ACSDK_ERROR(LX("createFailed")
+                        .d("reason", "negativeContextSnapshotTimeout")
+                        .d("contextSnapshotTimeoutMs", contextSnapshotTimeout.count()));
+        return nullptr;
     }
 
     auto aip = std::shared_ptr<AudioInputProcessor>(new AudioInputProcessor(
@@ -99,7 +107,8 @@ std::shared_ptr<AudioInputProcessor> AudioInputProcessor::create(
         focusManager,
         exceptionEncounteredSender,
         userActivityNotifier,
-        defaultAudioProvider));
+        defaultAudioProvider,
+        contextSnapshotTimeout));
 
     if (aip) {
         contextManager->setStateProvider(RECOGNIZER_STATE, aip);
@@ -240,7 +249,8 @@ AudioInputProcessor::AudioInputProcessor(
     std::shared_ptr<avsCommon::sdkInterfaces::FocusManagerInterface> focusManager,
     std::shared_ptr<avsCommon::sdkInterfaces::ExceptionEncounteredSenderInterface> exceptionEncounteredSender,
     std::shared_ptr<avsCommon::sdkInterfaces::UserActivityNotifierInterface> userActivityNotifier,
-    AudioProvider defaultAudioProvider) :
+    AudioProvider defaultAudioProvider,
+    std::chrono::milliseconds contextSnapshotTimeout) :
         CapabilityAgent{NAMESPACE, exceptionEncounteredSender},
         RequiresShutdown{"AudioInputProcessor"},
         m_directiveSequencer{directiveSequencer},
@@ -248,8 +258,12 @@ AudioInputProcessor::AudioInputProcessor(
         m_contextManager{contextManager},
         m_focusManager{focusManager},
         m_userActivityNotifier{userActivityNotifier},
+        m_contextSnapshotTimeout{contextSnapshotTimeout},
         m_defaultAudioProvider{defaultAudioProvider},
         m_lastAudioProvider{AudioProvider::null()},
+        m_waitingForContext{false},
+        m_contextRequestCount{0},
+        m_contextResponseCount{0},
         m_state{ObserverInterface::State::IDLE},
         m_focusState{avsCommon::avs::FocusState::NONE},
         m_preparingToSend{false},
@@ -449,6 +463,15 @@ bool AudioInputProcessor::executeRecognize(
         return false;
     }
 
+    m_captureTimestampTrack = provider.stream->getTimestampTrack();
+    if (m_captureTimestampTrack &&
+        (INVALID_INDEX == begin || !m_captureTimestampTrack->getTime(begin, &m_captureBeginTime))) {
+        m_captureTimestampTrack.reset();
+    }
+    if (m_captureTimestampTrack) {
+        ACSDK_METRIC_CAPTURE_LATENCY(TAG, "Recognize", timeSinceCaptureBegin(), Metrics::Location::AIP_RECEIVE);
+    }
+
     // Code below this point changes the state of AIP.  Formally update state now, and don't error out without calling
     // executeResetState() after this point.
     setState(ObserverInterface::State::RECOGNIZING);
@@ -463,6 +486,8 @@ bool AudioInputProcessor::executeRecognize(
     }
 
     //  Start assembling the context; we'll service the callback after assembling our Recognize event.
+    m_waitingForContext = true;
+    ++m_contextRequestCount;
     m_contextManager->getContext(shared_from_this());
 
     // Stop the ExpectSpeech timer so we don't get a timeout.
@@ -477,12 +502,34 @@ bool AudioInputProcessor::executeRecognize(
     // We can't assemble the MessageRequest until we receive the context.
     m_request.reset();
 
+    // Unless a fresh context arrives in time, fall back to the last one received so the upload can start.
+    if (m_contextSnapshotTimeout != WAIT_FOR_FRESH_CONTEXT && !m_contextSnapshot.empty()) {
+        if (m_contextSnapshotTimeout == std::chrono::milliseconds::zero()) {
+            executeOnContextSnapshotTimeout();
+        } else if (!m_contextSnapshotTimer
+                        .start(
+                            m_contextSnapshotTimeout,
+                            [this] { m_executor.submit([this] { executeOnContextSnapshotTimeout(); }); })
+                        .valid()) {
+            ACSDK_ERROR(LX("executeRecognizeFailed").d("reason", "startContextSnapshotTimerFailed"));
+        }
+    }
+
     return true;
 }
 
 void AudioInputProcessor::executeOnContextAvailable(const std::string jsonContext) {
     ACSDK_DEBUG(LX("executeOnContextAvailable").d("jsonContext", jsonContext));
 
+    // Keep the context, so that later Recognize events can be sent with it if their own context is slow to arrive.
+    m_contextSnapshot = jsonContext;
+    m_contextSnapshotTime = avsCommon::utils::timing::Clock::getDefault()->steadyNow();
+
+    if (executeIsStaleContextResponse()) {
+        ACSDK_DEBUG(LX("executeOnContextAvailable").d("reason", "staleContextResponse"));
+        return;
+    }
+
     // Should already be RECOGNIZING if we get here.
     if (m_state != ObserverInterface::State::RECOGNIZING) {
         ACSDK_ERROR(
@@ -490,15 +537,46 @@ void AudioInputProcessor::executeOnContextAvailable(const std::string jsonContex
         return;
     }
 
+    // The Recognize event may already have been sent with a snapshot.
+    if (!m_waitingForContext) {
+        ACSDK_DEBUG(LX("executeOnContextAvailable").d("reason", "recognizeAlreadySentWithContextSnapshot"));
+        return;
+    }
+    m_contextSnapshotTimer.stop();
+
+    executeAssembleRecognizeRequest(jsonContext, false);
+}
+
+void AudioInputProcessor::executeOnContextSnapshotTimeout() {
+    if (!m_waitingForContext || m_state != ObserverInterface::State::RECOGNIZING) {
+        return;
+    }
+    ACSDK_DEBUG(LX("executeOnContextSnapshotTimeout").d("contextSnapshotTimeoutMs", m_contextSnapshotTimeout.count()));
+    executeAssembleRecognizeRequest(m_contextSnapshot, true);
+}
+
+void AudioInputProcessor::executeAssembleRecognizeRequest(const std::string& jsonContext, bool isSnapshot) {
+    m_waitingForContext = false;
+
+    // Report the age of the context sent with the event.  A fresh context was assembled for this event.
+    auto contextAge = std::chrono::milliseconds::zero();
+    if (isSnapshot) {
+        contextAge = std::chrono::duration_cast<std::chrono::milliseconds>(
+            avsCommon::utils::timing::Clock::getDefault()->steadyNow() - m_contextSnapshotTime);
+    }
+    ACSDK_INFO(LX("recognizeContextSelected")
+                   .d("source", isSnapshot ? "snapshot" : "fresh")
+                   .d("contextAgeMs", contextAge.count()));
+
     // Should already have a reader.
     if (!m_reader) {
-        ACSDK_ERROR(LX("executeOnContextAvailableFailed").d("reason", "nullReader"));
+        ACSDK_ERROR(LX("executeAssembleRecognizeRequestFailed").d("reason", "nullReader"));
         executeResetState();
         return;
     }
     // Payload should not be empty.
     if (m_payload.empty()) {
-        ACSDK_ERROR(LX("executeOnContextAvailableFailed").d("reason", "payloadEmpty"));
+        ACSDK_ERROR(LX("executeAssembleRecognizeRequestFailed").d("reason", "payloadEmpty"));
         executeResetState();
         return;
     }
@@ -506,7 +584,7 @@ void AudioInputProcessor::executeOnContextAvailable(const std::string jsonContex
     // Start acquiring the channel right away; we'll service the callback after assembling our Recognize event.
     if (m_focusState != avsCommon::avs::FocusState::FOREGROUND) {
         if (!m_focusManager->acquireChannel(CHANNEL_NAME, shared_from_this(), ACTIVITY_ID)) {
-            ACSDK_ERROR(LX("executeOnContextAvailableFailed").d("reason", "Unable to acquire channel"));
+            ACSDK_ERROR(LX("executeAssembleRecognizeRequestFailed").d("reason", "Unable to acquire channel"));
             executeResetState();
             return;
         }
@@ -527,9 +605,35 @@ void AudioInputProcessor::executeOnContextAvailable(const std::string jsonContex
 
 void AudioInputProcessor::executeOnContextFailure(const avsCommon::sdkInterfaces::ContextRequestError error) {
     ACSDK_ERROR(LX("executeOnContextFailure").d("error", error));
+
+    if (executeIsStaleContextResponse()) {
+        ACSDK_DEBUG(LX("executeOnContextFailure").d("reason", "staleContextResponse"));
+        return;
+    }
+
+    if (m_contextSnapshotTimeout != WAIT_FOR_FRESH_CONTEXT) {
+        // A Recognize event which has been sent with a snapshot, or reset, doesn't need the context any more.
+        if (!m_waitingForContext) {
+            return;
+        }
+        if (!m_contextSnapshot.empty()) {
+            m_contextSnapshotTimer.stop();
+            executeAssembleRecognizeRequest(m_contextSnapshot, true);
+            return;
+        }
+    }
     executeResetState();
 }
 
+bool AudioInputProcessor::executeIsStaleContextResponse() {
+    // ContextManager answers each request once, in the order of the requests.
+    if (++m_contextResponseCount >= m_contextRequestCount) {
+        m_contextResponseCount = m_contextRequestCount;
+        return false;
+    }
+    return true;
+}
+
 void AudioInputProcessor::executeOnFocusChanged(avsCommon::avs::FocusState newFocus) {
     ACSDK_DEBUG(LX("executeOnFocusChanged").d("newFocus", newFocus));
 
@@ -575,6 +679,11 @@ bool AudioInputProcessor::executeStopCapture(bool stopImmediately, std::shared_p
                         .d("state", m_state));
         return false;
     }
+    if (info && m_captureTimestampTrack) {
+        ACSDK_METRIC_CAPTURE_LATENCY(TAG, "StopCapture", timeSinceCaptureBegin(), Metrics::Location::AIP_RECEIVE);
+    }
+    m_captureTimestampTrack.reset();
+
     // Create a lambda to do the StopCapture.
     std::function<void()> stopCapture = [=] {
         ACSDK_DEBUG(LX("stopCapture").d("stopImmediately", stopImmediately));
@@ -609,10 +718,13 @@ bool AudioInputProcessor::executeStopCapture(bool stopImmediately, std::shared_p
 void AudioInputProcessor::executeResetState() {
     // Irrespective of current state, clean up and go back to idle.
     m_expectingSpeechTimer.stop();
+    m_contextSnapshotTimer.stop();
+    m_waitingForContext = false;
     if (m_reader) {
         m_reader->close();
     }
     m_reader.reset();
+    m_captureTimestampTrack.reset();
     m_request.reset();
     m_preparingToSend = false;
     m_deferredStopCapture = nullptr;
@@ -738,6 +850,9 @@ void AudioInputProcessor::removeDirective(std::shared_ptr<DirectiveInfo> info) {
 
 void AudioInputProcessor::sendRequestNow() {
     ACSDK_METRIC_IDS(TAG, "Recognize", "", "", Metrics::Location::AIP_SEND);
+    if (m_captureTimestampTrack) {
+        ACSDK_METRIC_CAPTURE_LATENCY(TAG, "Recognize", timeSinceCaptureBegin(), Metrics::Location::AIP_SEND);
+    }
 
     m_messageSender->sendMessage(m_request);
     m_request.reset();
@@ -748,6 +863,11 @@ void AudioInputProcessor::sendRequestNow() {
     }
 }
 
+std::chrono::milliseconds AudioInputProcessor::timeSinceCaptureBegin() const {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        m_captureTimestampTrack->getClock()->steadyNow() - m_captureBeginTime);
+}
+
 void AudioInputProcessor::onExceptionReceived(const std::string& exceptionMessage) {
     ACSDK_ERROR(LX("onExceptionReceived").d("exception", exceptionMessage));
     resetState();
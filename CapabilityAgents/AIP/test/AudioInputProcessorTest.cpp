@@ -21,6 +21,9 @@
 #include <vector>
 #include <numeric>
 #include <climits>
+#include <future>
+#include <iostream>
+#include <thread>
 #include <gtest/gtest.h>
 
 #include <rapidjson/document.h>
@@ -210,6 +213,21 @@ static const bool VERIFY_TIMEOUT = true;
 /// General timeout for tests to fail.
 static const std::chrono::seconds TEST_TIMEOUT(10);
 
+/// A context snapshot timeout short enough for a test to wait out.
+static const std::chrono::milliseconds SHORT_CONTEXT_SNAPSHOT_TIMEOUT(100);
+
+/// A context snapshot timeout far longer than any test may take.
+static const std::chrono::milliseconds LONG_CONTEXT_SNAPSHOT_TIMEOUT = std::chrono::hours(1);
+
+/// A context which arrives after the Recognize event it was requested for has been sent with a snapshot.
+static const std::string LATE_CONTEXT = R"({"context":[{"header":{"namespace":"Late","name":"State"},"payload":{}}]})";
+
+/// How long the slow state provider of the benchmark takes to provide its state.
+static const std::chrono::milliseconds SLOW_CONTEXT_DELAY(500);
+
+/// The number of Recognize events the benchmark sends for each context snapshot timeout.
+static const int BENCHMARK_ITERATIONS = 5;
+
 /// Utility function to parse a JSON document.
 static rapidjson::Document parseJson(const std::string& json) {
     rapidjson::Document document;
@@ -582,6 +600,23 @@ protected:
      */
     void makeDefaultAudioProviderNotAlwaysReadable();
 
+    /**
+     * This function replaces @c m_audioInputProcessor with a new one that falls back to a context snapshot.
+     *
+     * @param contextSnapshotTimeout The context snapshot timeout of the new @c AudioInputProcessor.
+     */
+    void setContextSnapshotTimeout(std::chrono::milliseconds contextSnapshotTimeout);
+
+    /**
+     * Function to send a Recognize event whose context does not arrive in time, and verify that the event is sent with
+     * the context of the previous Recognize event instead, and only once.
+     *
+     * @param contextSnapshotTimeout The context snapshot timeout to test with.
+     * @param contextFails Whether the context request fails, rather than never completing.
+     * @return @c true if the event was sent with the snapshot, else @c false.
+     */
+    bool testRecognizeSentWithContextSnapshot(std::chrono::milliseconds contextSnapshotTimeout, bool contextFails);
+
     /**
      * Function to call @c onFocusChanged() and verify that @c AudioInputProcessor responds correctly.
      *
@@ -1126,6 +1161,82 @@ void AudioInputProcessorTest::makeDefaultAudioProviderNotAlwaysReadable() {
     m_audioInputProcessor->addObserver(m_dialogUXStateAggregator);
 }
 
+void AudioInputProcessorTest::setContextSnapshotTimeout(std::chrono::milliseconds contextSnapshotTimeout) {
+    EXPECT_CALL(*m_mockContextManager, setStateProvider(RECOGNIZER_STATE, Ne(nullptr)));
+    m_audioInputProcessor->removeObserver(m_dialogUXStateAggregator);
+    m_audioInputProcessor = AudioInputProcessor::create(
+        m_mockDirectiveSequencer,
+        m_mockMessageSender,
+        m_mockContextManager,
+        m_mockFocusManager,
+        m_dialogUXStateAggregator,
+        m_mockExceptionEncounteredSender,
+        m_mockUserActivityNotifier,
+        *m_audioProvider,
+        contextSnapshotTimeout);
+    EXPECT_NE(m_audioInputProcessor, nullptr);
+    m_audioInputProcessor->addObserver(m_mockObserver);
+    m_audioInputProcessor->addObserver(m_dialogUXStateAggregator);
+}
+
+bool AudioInputProcessorTest::testRecognizeSentWithContextSnapshot(
+    std::chrono::milliseconds contextSnapshotTimeout,
+    bool contextFails) {
+    setContextSnapshotTimeout(contextSnapshotTimeout);
+
+    // The context of the first Recognize event becomes the snapshot for the next one.
+    bool firstRecognizeSucceeded = testRecognizeSucceeds(
+        *m_audioProvider,
+        Initiator::TAP,
+        AudioInputProcessor::INVALID_INDEX,
+        AudioInputProcessor::INVALID_INDEX,
+        "",
+        RecognizeStopPoint::AFTER_SEND);
+    EXPECT_TRUE(firstRecognizeSucceeded);
+    if (!firstRecognizeSucceeded) {
+        return false;
+    }
+
+    auto sentJson = std::make_shared<std::promise<std::string>>();
+    EXPECT_CALL(*m_mockContextManager, getContext(_)).WillOnce(InvokeWithoutArgs([this, contextFails] {
+        if (contextFails) {
+            m_audioInputProcessor->onContextFailure(
+                avsCommon::sdkInterfaces::ContextRequestError::STATE_PROVIDER_TIMEDOUT);
+        }
+    }));
+    EXPECT_CALL(*m_mockUserActivityNotifier, onUserActive()).Times(AtLeast(1));
+    EXPECT_CALL(*m_mockObserver, onStateChanged(AudioInputProcessorObserverInterface::State::RECOGNIZING));
+    EXPECT_CALL(*m_mockFocusManager, acquireChannel(CHANNEL_NAME, _, ACTIVITY_ID)).WillOnce(InvokeWithoutArgs([this] {
+        m_audioInputProcessor->onFocusChanged(avsCommon::avs::FocusState::FOREGROUND);
+        return true;
+    }));
+    EXPECT_CALL(*m_mockDirectiveSequencer, setDialogRequestId(_));
+    EXPECT_CALL(*m_mockMessageSender, sendMessage(_))
+        .WillOnce(Invoke([sentJson](std::shared_ptr<avsCommon::avs::MessageRequest> request) {
+            sentJson->set_value(request->getJsonContent());
+        }));
+
+    RecognizeEvent recognize(*m_audioProvider, Initiator::TAP);
+    auto sentFuture = sentJson->get_future();
+    EXPECT_TRUE(recognize.send(m_audioInputProcessor).get());
+    if (sentFuture.wait_for(TEST_TIMEOUT) != std::future_status::ready) {
+        return false;
+    }
+
+    // The snapshot is the empty context sent with the first Recognize event.
+    rapidjson::Document document = parseJson(sentFuture.get());
+    auto context = document.FindMember(MESSAGE_CONTEXT_KEY);
+    EXPECT_NE(context, document.MemberEnd());
+    if (context == document.MemberEnd()) {
+        return false;
+    }
+    EXPECT_TRUE(context->value.IsArray() && context->value.Empty());
+
+    // A context which arrives after the event was sent must not send it again.
+    m_audioInputProcessor->onContextAvailable(LATE_CONTEXT);
+    return true;
+}
+
 bool AudioInputProcessorTest::testFocusChange(avsCommon::avs::FocusState state) {
     std::mutex mutex;
     std::condition_variable conditionVariable;
@@ -1696,6 +1807,165 @@ TEST_F(AudioInputProcessorTest, focusChangedNone) {
     ASSERT_TRUE(testFocusChange(avsCommon::avs::FocusState::NONE));
 }
 
+/// This function verifies that a Recognize event is sent right away with a context snapshot if the timeout is zero.
+TEST_F(AudioInputProcessorTest, recognizeWithContextSnapshotWithoutWaiting) {
+    ASSERT_TRUE(testRecognizeSentWithContextSnapshot(std::chrono::milliseconds::zero(), false));
+}
+
+/// This function verifies that a Recognize event is sent with a context snapshot once a fresh context is overdue.
+TEST_F(AudioInputProcessorTest, recognizeWithContextSnapshotAfterTimeout) {
+    ASSERT_TRUE(testRecognizeSentWithContextSnapshot(SHORT_CONTEXT_SNAPSHOT_TIMEOUT, false));
+}
+
+/// This function verifies that a Recognize event is sent with a context snapshot if the context request fails.
+TEST_F(AudioInputProcessorTest, recognizeWithContextSnapshotOnContextFailure) {
+    ASSERT_TRUE(testRecognizeSentWithContextSnapshot(LONG_CONTEXT_SNAPSHOT_TIMEOUT, true));
+}
+
+/// This function verifies that a Recognize event still waits for its context when there is no snapshot yet.
+TEST_F(AudioInputProcessorTest, recognizeWithoutContextSnapshotWaitsForContext) {
+    setContextSnapshotTimeout(std::chrono::milliseconds::zero());
+    ASSERT_TRUE(testRecognizeSucceeds(*m_audioProvider, Initiator::TAP));
+}
+
+/**
+ * This function verifies that a context failure which answers the request of an earlier Recognize event, reset before
+ * its context arrived, does not affect the Recognize event waiting for its own context.
+ */
+TEST_F(AudioInputProcessorTest, staleContextFailureIgnored) {
+    EXPECT_CALL(*m_mockContextManager, getContext(_)).Times(2);
+    EXPECT_CALL(*m_mockUserActivityNotifier, onUserActive()).Times(AtLeast(1));
+    EXPECT_CALL(*m_mockObserver, onStateChanged(AudioInputProcessorObserverInterface::State::RECOGNIZING)).Times(2);
+    EXPECT_CALL(*m_mockObserver, onStateChanged(AudioInputProcessorObserverInterface::State::IDLE));
+    RecognizeEvent firstRecognize(*m_audioProvider, Initiator::TAP);
+    EXPECT_TRUE(firstRecognize.send(m_audioInputProcessor).get());
+    m_audioInputProcessor->resetState().get();
+
+    auto sentJson = std::make_shared<std::promise<std::string>>();
+    EXPECT_CALL(*m_mockFocusManager, acquireChannel(CHANNEL_NAME, _, ACTIVITY_ID)).WillOnce(InvokeWithoutArgs([this] {
+        m_audioInputProcessor->onFocusChanged(avsCommon::avs::FocusState::FOREGROUND);
+        return true;
+    }));
+    EXPECT_CALL(*m_mockDirectiveSequencer, setDialogRequestId(_));
+    EXPECT_CALL(*m_mockMessageSender, sendMessage(_))
+        .WillOnce(Invoke([sentJson](std::shared_ptr<avsCommon::avs::MessageRequest> request) {
+            sentJson->set_value(request->getJsonContent());
+        }));
+    RecognizeEvent secondRecognize(*m_audioProvider, Initiator::TAP);
+    auto sentFuture = sentJson->get_future();
+    EXPECT_TRUE(secondRecognize.send(m_audioInputProcessor).get());
+
+    m_audioInputProcessor->onContextFailure(avsCommon::sdkInterfaces::ContextRequestError::STATE_PROVIDER_TIMEDOUT);
+    m_audioInputProcessor->onContextAvailable(LATE_CONTEXT);
+    ASSERT_EQ(sentFuture.wait_for(TEST_TIMEOUT), std::future_status::ready);
+
+    // The event is sent with the context which answers its own request.
+    rapidjson::Document document = parseJson(sentFuture.get());
+    auto context = document.FindMember(MESSAGE_CONTEXT_KEY);
+    ASSERT_NE(context, document.MemberEnd());
+    ASSERT_TRUE(context->value.IsArray() && context->value.Size() == 1);
+    EXPECT_STREQ(context->value[0]["header"]["namespace"].GetString(), "Late");
+}
+
+/**
+ * This function verifies that once a Recognize event has been sent with a context snapshot, the failure of its own
+ * context request does not reset the @c AudioInputProcessor, whatever its state.
+ */
+TEST_F(AudioInputProcessorTest, contextFailureAfterSnapshotSendIgnored) {
+    ASSERT_TRUE(testRecognizeSentWithContextSnapshot(std::chrono::milliseconds::zero(), false));
+    EXPECT_CALL(*m_mockObserver, onStateChanged(AudioInputProcessorObserverInterface::State::BUSY));
+    EXPECT_TRUE(m_audioInputProcessor->stopCapture().get());
+
+    // The observer is strict, so a reset to IDLE fails the test.  The second stopCapture() waits for the failure to be
+    // handled, and fails because the state is still BUSY.
+    m_audioInputProcessor->onContextFailure(avsCommon::sdkInterfaces::ContextRequestError::STATE_PROVIDER_TIMEDOUT);
+    EXPECT_FALSE(m_audioInputProcessor->stopCapture().get());
+}
+
+/// This function verifies that @c AudioInputProcessor::create() errors out with a negative context snapshot timeout.
+TEST_F(AudioInputProcessorTest, createWithNegativeContextSnapshotTimeout) {
+    EXPECT_EQ(
+        AudioInputProcessor::create(
+            m_mockDirectiveSequencer,
+            m_mockMessageSender,
+            m_mockContextManager,
+            m_mockFocusManager,
+            m_dialogUXStateAggregator,
+            m_mockExceptionEncounteredSender,
+            m_mockUserActivityNotifier,
+            *m_audioProvider,
+            -SHORT_CONTEXT_SNAPSHOT_TIMEOUT),
+        nullptr);
+}
+
+/**
+ * Benchmark of the time from a wakeword detection to the first audio byte handed to the network, with a state provider
+ * which takes @c SLOW_CONTEXT_DELAY to provide its state.  This is run with each context snapshot timeout, and prints
+ * the time of each Recognize event; the first event of each run has no snapshot to fall back to.
+ */
+TEST_F(AudioInputProcessorTest, DISABLED_benchmarkWakewordToFirstAudioByteWithSlowContext) {
+    for (auto contextSnapshotTimeout : {AudioInputProcessor::WAIT_FOR_FRESH_CONTEXT,
+                                        SHORT_CONTEXT_SNAPSHOT_TIMEOUT,
+                                        std::chrono::milliseconds::zero()}) {
+        setContextSnapshotTimeout(contextSnapshotTimeout);
+        EXPECT_CALL(*m_mockObserver, onStateChanged(_)).Times(AnyNumber());
+        EXPECT_CALL(*m_mockUserActivityNotifier, onUserActive()).Times(AnyNumber());
+        EXPECT_CALL(*m_mockDirectiveSequencer, setDialogRequestId(_)).Times(AnyNumber());
+        EXPECT_CALL(*m_mockFocusManager, releaseChannel(CHANNEL_NAME, _)).Times(AnyNumber());
+        EXPECT_CALL(*m_mockFocusManager, acquireChannel(CHANNEL_NAME, _, ACTIVITY_ID))
+            .WillRepeatedly(InvokeWithoutArgs([this] {
+                m_audioInputProcessor->onFocusChanged(avsCommon::avs::FocusState::FOREGROUND);
+                return true;
+            }));
+
+        std::vector<std::thread> slowStateProviders;
+        EXPECT_CALL(*m_mockContextManager, getContext(_)).WillRepeatedly(InvokeWithoutArgs([this, &slowStateProviders] {
+            auto audioInputProcessor = m_audioInputProcessor;
+            slowStateProviders.emplace_back([audioInputProcessor] {
+                std::this_thread::sleep_for(SLOW_CONTEXT_DELAY);
+                audioInputProcessor->onContextAvailable(R"({"context":[]})");
+            });
+        }));
+
+        for (int i = 0; i < BENCHMARK_ITERATIONS; ++i) {
+            auto firstByteSent = std::make_shared<std::promise<std::chrono::steady_clock::time_point>>();
+            EXPECT_CALL(*m_mockMessageSender, sendMessage(_))
+                .WillOnce(Invoke([firstByteSent](std::shared_ptr<avsCommon::avs::MessageRequest> request) {
+                    auto reader = request->getAttachmentReader();
+                    Sample sample;
+                    auto status = avsCommon::avs::attachment::AttachmentReader::ReadStatus::OK_WOULDBLOCK;
+                    while (reader && reader->read(&sample, sizeof(sample), &status) == 0 &&
+                           avsCommon::avs::attachment::AttachmentReader::ReadStatus::OK_WOULDBLOCK == status) {
+                        std::this_thread::yield();
+                    }
+                    firstByteSent->set_value(std::chrono::steady_clock::now());
+                }));
+
+            // The call to recognize() stands in for the wakeword detection.
+            auto wakeword = std::chrono::steady_clock::now();
+            auto firstByteFuture = firstByteSent->get_future();
+            auto recognizeResult = m_audioInputProcessor->recognize(*m_audioProvider, Initiator::TAP);
+            m_writer->write(m_pattern.data(), m_pattern.size());
+            ASSERT_TRUE(recognizeResult.get());
+            ASSERT_EQ(firstByteFuture.wait_for(TEST_TIMEOUT), std::future_status::ready);
+            auto firstByte = firstByteFuture.get();
+
+            std::cout << "contextSnapshotTimeoutMs="
+                      << (AudioInputProcessor::WAIT_FOR_FRESH_CONTEXT == contextSnapshotTimeout
+                              ? std::string("none")
+                              : std::to_string(contextSnapshotTimeout.count()))
+                      << " iteration=" << i << " wakewordToFirstAudioByteMs="
+                      << std::chrono::duration_cast<std::chrono::milliseconds>(firstByte - wakeword).count()
+                      << std::endl;
+            m_audioInputProcessor->resetState().wait();
+        }
+        for (auto& slowStateProvider : slowStateProviders) {
+            slowStateProvider.join();
+        }
+        Mock::VerifyAndClearExpectations(m_mockContextManager.get());
+    }
+}
+
 /// Test that the @c AudioInputProcessor correctly transitions to @c State::IDLE
 /// if @c Status::TIMEDOUT is received
 TEST_F(AudioInputProcessorTest, resetStateOnTimeOut) {
@@ -0,0 +1,228 @@
+/*
+ * RendererTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <AVSCommon/Utils/MediaPlayer/SimulatedMediaPlayer.h>
+#include <AVSCommon/Utils/Timing/ManualClock.h>
+
+#include "Alerts/Renderer/Renderer.h"
+
+namespace alexaClientSDK {
+namespace capabilityAgents {
+namespace alerts {
+namespace renderer {
+namespace test {
+
+using namespace avsCommon::utils::mediaPlayer::test;
+using namespace avsCommon::utils::timing::test;
+
+/// Plenty of time for a test to complete.
+static const std::chrono::milliseconds WAIT_TIMEOUT(1000);
+
+/// The duration of the default audio of an alert.
+static const std::chrono::seconds DEFAULT_AUDIO_DURATION(1);
+
+/// The urls of an alert's assets.
+static const std::vector<std::string> URLS = {"http://127.0.0.1/a.mp3",
+                                              "http://127.0.0.1/b.mp3",
+                                              "http://127.0.0.1/c.mp3"};
+
+/// The number of times @c URLS are rendered again after the first time.
+static const int LOOP_COUNT = 2;
+
+/**
+ * A @c RendererObserverInterface which counts the state changes it is notified of.
+ */
+class TestRendererObserver : public RendererObserverInterface {
+public:
+    void onRendererStateChange(State state, const std::string& reason) override;
+
+    /**
+     * Wait until the observer has been notified of a state a number of times.
+     *
+     * @param state The state to wait for.
+     * @param count The number of notifications of @c state to wait for.
+     * @return Whether @c state was notified @c count times before @c WAIT_TIMEOUT.
+     */
+    bool waitFor(State state, int count);
+
+    /**
+     * Get the number of times the observer has been notified of a state.
+     *
+     * @param state The state to count.
+     * @return The number of notifications of @c state.
+     */
+    int getCount(State state);
+
+private:
+    /// Mutex serializing access to @c m_counts.
+    std::mutex m_mutex;
+
+    /// Notified when a state change is counted.
+    std::condition_variable m_wake;
+
+    /// The number of notifications of each state.
+    std::map<State, int> m_counts;
+};
+
+void TestRendererObserver::onRendererStateChange(State state, const std::string& reason) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ++m_counts[state];
+    m_wake.notify_all();
+}
+
+bool TestRendererObserver::waitFor(State state, int count) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    return m_wake.wait_for(lock, WAIT_TIMEOUT, [this, state, count] { return m_counts[state] >= count; });
+}
+
+int TestRendererObserver::getCount(State state) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_counts[state];
+}
+
+/**
+ * Renders alerts with a @c SimulatedMediaPlayer.
+ */
+class RendererTest : public ::testing::Test {
+protected:
+    /**
+     * Create the player and the renderer.
+     *
+     * @param clock The clock for the player to play in time on, or @c nullptr to play sources as soon as they are read.
+     */
+    void createRenderer(std::shared_ptr<ManualClock> clock);
+
+    /**
+     * Produce the default audio of an alert.
+     *
+     * @return The default audio.
+     */
+    static std::unique_ptr<std::istream> createDefaultAudio();
+
+    /// The player rendering the alerts.
+    std::shared_ptr<SimulatedMediaPlayer> m_player;
+
+    /// The renderer to test.
+    std::shared_ptr<Renderer> m_renderer;
+
+    /// The observer of @c m_renderer.
+    std::shared_ptr<TestRendererObserver> m_observer;
+};
+
+void RendererTest::createRenderer(std::shared_ptr<ManualClock> clock) {
+    m_player = SimulatedMediaPlayer::create(SimulatedMediaPlayer::DEFAULT_BYTES_PER_SECOND, clock);
+    ASSERT_TRUE(m_player);
+    m_renderer = Renderer::create(m_player);
+    ASSERT_TRUE(m_renderer);
+    m_observer = std::make_shared<TestRendererObserver>();
+}
+
+std::unique_ptr<std::istream> RendererTest::createDefaultAudio() {
+    return std::unique_ptr<std::istream>(new std::stringstream(
+        std::string(SimulatedMediaPlayer::DEFAULT_BYTES_PER_SECOND * DEFAULT_AUDIO_DURATION.count(), 'x')));
+}
+
+/**
+ * Test that the default audio of an alert keeps playing until the renderer is stopped.
+ */
+TEST_F(RendererTest, defaultAudioPlaysUntilStopped) {
+    auto clock = std::make_shared<ManualClock>();
+    createRenderer(clock);
+    m_renderer->setObserver(m_observer);
+    m_renderer->start(createDefaultAudio);
+    ASSERT_TRUE(m_observer->waitFor(RendererObserverInterface::State::STARTED, 1));
+
+    // The default audio is repeated, so it still plays after its duration.
+    clock->advance(DEFAULT_AUDIO_DURATION * 3);
+    m_renderer->stop();
+    ASSERT_TRUE(m_observer->waitFor(RendererObserverInterface::State::STOPPED, 1));
+    EXPECT_EQ(0, m_observer->getCount(RendererObserverInterface::State::ERROR));
+}
+
+/**
+ * Test that the urls of an alert are rendered in order, @c LOOP_COUNT more times after the first, and that the
+ * renderer stops once they have all been rendered.
+ */
+TEST_F(RendererTest, urlsRenderedInLoops) {
+    createRenderer(nullptr);
+    m_renderer->setObserver(m_observer);
+    m_renderer->start(createDefaultAudio, URLS, LOOP_COUNT);
+    ASSERT_TRUE(m_observer->waitFor(RendererObserverInterface::State::STOPPED, 1));
+    EXPECT_EQ(static_cast<int>(URLS.size()) * (LOOP_COUNT + 1),
+              m_observer->getCount(RendererObserverInterface::State::STARTED));
+    EXPECT_EQ(0, m_observer->getCount(RendererObserverInterface::State::ERROR));
+}
+
+/**
+ * Benchmark the latency of starting and stopping the default audio of an alert, and the time taken to go from one url
+ * of an alert to the next, with a @c SimulatedMediaPlayer.  The player plays on a @c ManualClock which isn't advanced
+ * while measuring start and stop, and without a clock while measuring urls, so the timings are those of the
+ * @c Renderer alone.  Disabled as it only prints timings.
+ */
+TEST_F(RendererTest, DISABLED_benchmarkStartStopAndUrlTransitionLatency) {
+    static const int ITERATIONS = 200;
+
+    createRenderer(std::make_shared<ManualClock>());
+    std::chrono::steady_clock::duration totalStart{0};
+    std::chrono::steady_clock::duration totalStop{0};
+    for (int i = 0; i < ITERATIONS; ++i) {
+        // The renderer drops its observer once it stops.
+        m_renderer->setObserver(m_observer);
+        auto start = std::chrono::steady_clock::now();
+        m_renderer->start(createDefaultAudio);
+        ASSERT_TRUE(m_observer->waitFor(RendererObserverInterface::State::STARTED, i + 1));
+        auto started = std::chrono::steady_clock::now();
+        m_renderer->stop();
+        ASSERT_TRUE(m_observer->waitFor(RendererObserverInterface::State::STOPPED, i + 1));
+        totalStart += started - start;
+        totalStop += std::chrono::steady_clock::now() - started;
+    }
+
+    createRenderer(nullptr);
+    m_renderer->setObserver(m_observer);
+    auto start = std::chrono::steady_clock::now();
+    m_renderer->start(createDefaultAudio, URLS, ITERATIONS - 1);
+    ASSERT_TRUE(m_observer->waitFor(RendererObserverInterface::State::STOPPED, 1));
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    auto urlsRendered = m_observer->getCount(RendererObserverInterface::State::STARTED);
+    ASSERT_EQ(static_cast<int>(URLS.size()) * ITERATIONS, urlsRendered);
+
+    std::cout << ITERATIONS << " alerts: start mean "
+              << std::chrono::duration_cast<std::chrono::microseconds>(totalStart).count() / ITERATIONS
+              << "us, stop mean "
+              << std::chrono::duration_cast<std::chrono::microseconds>(totalStop).count() / ITERATIONS << "us; " << urlsRendered << " urls rendered, "
+              << std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count() / urlsRendered
+              << "us per url" << std::endl;
+}
+
+}  // namespace test
+}  // namespace renderer
+}  // namespace alerts
+}  // namespace capabilityAgents
+}  // namespace alexaClientSDK
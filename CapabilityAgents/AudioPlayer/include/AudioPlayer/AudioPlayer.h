@@ -31,6 +31,7 @@
 #include <AVSCommon/Utils/MediaPlayer/MediaPlayerObserverInterface.h>
 #include <AVSCommon/Utils/RequiresShutdown.h>
 #include <AVSCommon/Utils/Threading/Executor.h>
+#include <AVSCommon/Utils/Timing/Clock.h>
 #include <AVSCommon/Utils/Timing/Timer.h>
 
 #include "AudioItem.h"
@@ -439,6 +440,9 @@ private:
     /// The id of the currently (or most recently) playing @c MediaPlayer source.
     SourceId m_sourceId;
 
+    /// The clock to measure stream expiry and buffer underruns with.
+    std::shared_ptr<avsCommon::utils::timing::Clock> m_clock;
+
     /// When in the @c BUFFER_UNDERRUN state, this records the time at which the state was entered.
     std::chrono::steady_clock::time_point m_bufferUnderrunTimestamp;
 
@@ -473,7 +477,8 @@ private:
     /// @}
 
     /**
-     * @c Executor which queues up operations from asynchronous API calls.
+     * @c Executor which queues up operations from asynchronous API calls.  It has a thread of its own, as its tasks
+     * block on the @c MediaPlayer, and @c onFocusChanged() and @c getAudioItemOffset() block until its tasks have run.
      *
      * @note This declaration needs to come *after* the Executor Thread Variables above so that the thread shuts down
      *     before the Executor Thread Variables are destroyed.
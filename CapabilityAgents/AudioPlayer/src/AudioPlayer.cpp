@@ -353,8 +353,10 @@ AudioPlayer::AudioPlayer(
         m_focus{FocusState::NONE},
         m_initialOffset{0},
         m_sourceId{MediaPlayerInterface::ERROR},
+        m_clock{timing::Clock::getDefault()},
         m_offset{std::chrono::milliseconds{std::chrono::milliseconds::zero()}},
-        m_isStopCalled{false} {
+        m_isStopCalled{false},
+        m_executor{threading::Executor::ThreadPolicy::DEDICATED} {
 }
 
 void AudioPlayer::doShutdown() {
@@ -476,7 +478,7 @@ void AudioPlayer::handlePlayDirective(std::shared_ptr<DirectiveInfo> info) {
             int64_t currentTime;
             if (timing::getCurrentUnixTime(&currentTime)) {
                 std::chrono::seconds timeToExpiry(unixTime - currentTime);
-                audioItem.stream.expiryTime = std::chrono::steady_clock::now() + timeToExpiry;
+                audioItem.stream.expiryTime = m_clock->steadyNow() + timeToExpiry;
             }
         }
     }
@@ -873,7 +875,7 @@ void AudioPlayer::executeOnBufferUnderrun(SourceId id) {
         ACSDK_ERROR(LX("executeOnBufferUnderrunFailed").d("reason", "alreadyInUnderrun"));
         return;
     }
-    m_bufferUnderrunTimestamp = std::chrono::steady_clock::now();
+    m_bufferUnderrunTimestamp = m_clock->steadyNow();
     sendPlaybackStutterStartedEvent();
     changeActivity(PlayerActivity::BUFFER_UNDERRUN);
 }
@@ -1120,7 +1122,7 @@ void AudioPlayer::sendPlaybackStutterFinishedEvent() {
     payload.AddMember(TOKEN_KEY, m_token, payload.GetAllocator());
     payload.AddMember(
         OFFSET_KEY, std::chrono::duration_cast<std::chrono::milliseconds>(getOffset()).count(), payload.GetAllocator());
-    auto stutterDuration = std::chrono::steady_clock::now() - m_bufferUnderrunTimestamp;
+    auto stutterDuration = m_clock->steadyNow() - m_bufferUnderrunTimestamp;
     payload.AddMember(
         STUTTER_DURATION_KEY,
         std::chrono::duration_cast<std::chrono::milliseconds>(stutterDuration).count(),
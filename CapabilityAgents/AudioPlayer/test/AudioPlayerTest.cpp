@@ -18,9 +18,12 @@
 /// @file AudioPlayerTest.cpp
 
 #include <chrono>
+#include <condition_variable>
 #include <future>
+#include <iostream>
 #include <memory>
 #include <map>
+#include <mutex>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -42,6 +45,8 @@
 #include <AVSCommon/AVS/Attachment/AttachmentManager.h>
 #include <AVSCommon/Utils/Memory/Memory.h>
 #include <AVSCommon/Utils/MediaPlayer/MockMediaPlayer.h>
+#include <AVSCommon/Utils/MediaPlayer/SimulatedMediaPlayer.h>
+#include <AVSCommon/Utils/Timing/ManualClock.h>
 
 #include "AudioPlayer/AudioPlayer.h"
 
@@ -60,6 +65,7 @@ using namespace avsCommon::sdkInterfaces::test;
 using namespace avsCommon::utils::mediaPlayer;
 using namespace avsCommon::utils::memory;
 using namespace avsCommon::utils::mediaPlayer::test;
+using namespace avsCommon::utils::timing::test;
 using namespace ::testing;
 using namespace rapidjson;
 
@@ -111,8 +117,11 @@ static const std::string PREV_TOKEN_TEST("Prev_Token_Test");
 /// Format of the audio.
 static const std::string FORMAT_TEST("AUDIO_MPEG");
 
+/// Content Id of the audio attachment for testing.
+static const std::string CONTENT_ID_TEST("Test");
+
 /// URL for testing.
-static const std::string URL_TEST("cid:Test");
+static const std::string URL_TEST("cid:" + CONTENT_ID_TEST);
 
 /// ENQUEUE playBehavior.
 static const std::string NAME_ENQUEUE("ENQUEUE");
@@ -1426,6 +1435,110 @@ TEST_F(AudioPlayerTest, testPlayAfterOnPlaybackError) {
     ASSERT_TRUE(m_testAudioPlayerObserver->waitFor(PlayerActivity::PLAYING, WAIT_TIMEOUT));
 }
 
+/**
+ * Benchmark the latency of starting a queue of tracks played by a @c SimulatedMediaPlayer on a @c ManualClock: from
+ * handling the first Play directive to its PlaybackStarted event, and from the end of each track to the PlaybackStarted
+ * event of the next one.  Each track is a second of audio in an attachment, which plays as soon as the clock is
+ * advanced, so the timings are those of the @c AudioPlayer and the attachment it reads alone.  Disabled as it only
+ * prints timings.
+ */
+TEST_F(AudioPlayerTest, DISABLED_benchmarkTrackStartAndTransitionLatency) {
+    static const int ITERATIONS = 100;
+    static const std::chrono::seconds TRACK_DURATION(1);
+    // clang-format off
+    static const std::string PAYLOAD =
+        "{"
+            "\"playBehavior\":\"" + NAME_ENQUEUE + "\","
+            "\"audioItem\": {"
+                "\"audioItemId\":\"" + AUDIO_ITEM_ID_1 + "\","
+                "\"stream\": {"
+                    "\"url\":\"" + URL_TEST + "\","
+                    "\"streamFormat\":\"" + FORMAT_TEST + "\","
+                    "\"token\":\"" + TOKEN_TEST + "\""
+                "}"
+            "}"
+        "}";
+    // clang-format on
+    const std::string track(SimulatedMediaPlayer::DEFAULT_BYTES_PER_SECOND * TRACK_DURATION.count(), 'x');
+
+    auto clock = std::make_shared<ManualClock>();
+    auto player = SimulatedMediaPlayer::create(SimulatedMediaPlayer::DEFAULT_BYTES_PER_SECOND, clock);
+    ASSERT_TRUE(player);
+    auto audioPlayer = AudioPlayer::create(
+        player,
+        m_mockMessageSender,
+        m_mockFocusManager,
+        m_mockContextManager,
+        m_attachmentManager,
+        m_mockExceptionSender);
+    ASSERT_TRUE(audioPlayer);
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    int channelsAcquired = 0;
+    int tracksStarted = 0;
+    auto waitForCount = [&mutex, &wake](const int& count, int target) {
+        std::unique_lock<std::mutex> lock(mutex);
+        return wake.wait_for(lock, WAIT_TIMEOUT, [&count, target] { return count >= target; });
+    };
+    EXPECT_CALL(*(m_mockFocusManager.get()), acquireChannel(CHANNEL_NAME, _, FOCUS_MANAGER_ACTIVITY_ID))
+        .WillRepeatedly(InvokeWithoutArgs([&] {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++channelsAcquired;
+            wake.notify_all();
+            return true;
+        }));
+    EXPECT_CALL(*(m_mockMessageSender.get()), sendMessage(_))
+        .WillRepeatedly(Invoke([&](std::shared_ptr<avsCommon::avs::MessageRequest> request) {
+            if (verifyMessage(request, PLAYBACK_STARTED_NAME)) {
+                std::lock_guard<std::mutex> lock(mutex);
+                ++tracksStarted;
+                wake.notify_all();
+            }
+        }));
+
+    // Queues a track, as AVS does once the track before it is nearly finished.
+    auto enqueueTrack = [&](int i) {
+        auto contextId = CONTEXT_ID_TEST + std::to_string(i);
+        auto writer =
+            m_attachmentManager->createWriter(m_attachmentManager->generateAttachmentId(contextId, CONTENT_ID_TEST));
+        auto writeStatus = AttachmentWriter::WriteStatus::OK;
+        writer->write(track.data(), track.size(), &writeStatus);
+        writer->close();
+        auto avsMessageHeader = std::make_shared<AVSMessageHeader>(
+            NAMESPACE_AUDIO_PLAYER, NAME_PLAY, MESSAGE_ID_TEST + std::to_string(i), PLAY_REQUEST_ID_TEST);
+        audioPlayer->handleDirectiveImmediately(
+            AVSDirective::create("", avsMessageHeader, PAYLOAD, m_attachmentManager, contextId));
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    enqueueTrack(0);
+    ASSERT_TRUE(waitForCount(channelsAcquired, 1));
+    audioPlayer->onFocusChanged(FocusState::FOREGROUND);
+    ASSERT_TRUE(waitForCount(tracksStarted, 1));
+    auto firstTrackLatency = std::chrono::steady_clock::now() - start;
+
+    std::chrono::steady_clock::duration totalTransition{0};
+    std::chrono::steady_clock::duration maxTransition{0};
+    for (int i = 1; i < ITERATIONS; ++i) {
+        enqueueTrack(i);
+        auto trackEnded = std::chrono::steady_clock::now();
+        clock->advance(TRACK_DURATION);
+        ASSERT_TRUE(waitForCount(tracksStarted, i + 1));
+        auto transition = std::chrono::steady_clock::now() - trackEnded;
+        totalTransition += transition;
+        maxTransition = std::max(maxTransition, transition);
+    }
+    audioPlayer->shutdown();
+
+    std::cout << "Play-to-PlaybackStarted "
+              << std::chrono::duration_cast<std::chrono::microseconds>(firstTrackLatency).count() << "us, "
+              << ITERATIONS - 1 << " track transitions mean "
+              << std::chrono::duration_cast<std::chrono::microseconds>(totalTransition).count() / (ITERATIONS - 1)
+              << "us max " << std::chrono::duration_cast<std::chrono::microseconds>(maxTransition).count() << "us"
+              << std::endl;
+}
+
 }  // namespace test
 }  // namespace audioPlayer
 }  // namespace capabilityAgents
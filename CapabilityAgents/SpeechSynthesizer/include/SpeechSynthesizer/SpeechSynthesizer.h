@@ -505,7 +505,8 @@ private:
     /// @}
 
     /**
-     * @c Executor which queues up operations from asynchronous API calls.
+     * @c Executor which queues up operations from asynchronous API calls.  It has a thread of its own, as its tasks
+     * block on the @c MediaPlayer, and @c onFocusChanged() blocks until its tasks have changed state.
      *
      * @note This declaration needs to come *after* any variables used by the executor thread so that the thread shuts
      *     down before the variables are destroyed.
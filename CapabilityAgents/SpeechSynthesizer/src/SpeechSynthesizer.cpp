@@ -318,7 +318,8 @@ SpeechSynthesizer::SpeechSynthesizer(
         m_desiredState{SpeechSynthesizerObserverInterface::SpeechSynthesizerState::FINISHED},
         m_currentFocus{FocusState::NONE},
         m_isAlreadyStopping{false},
-        m_initialDialogUXStateReceived{false} {
+        m_initialDialogUXStateReceived{false},
+        m_executor{threading::Executor::ThreadPolicy::DEDICATED} {
 }
 
 void SpeechSynthesizer::doShutdown() {
@@ -16,8 +16,11 @@
  */
 
 #include <chrono>
+#include <condition_variable>
 #include <future>
+#include <iostream>
 #include <memory>
+#include <mutex>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -31,6 +34,8 @@
 #include <AVSCommon/SDKInterfaces/MockDirectiveHandlerResult.h>
 #include <AVSCommon/AVS/Attachment/AttachmentManager.h>
 #include <AVSCommon/Utils/MediaPlayer/MockMediaPlayer.h>
+#include <AVSCommon/Utils/MediaPlayer/SimulatedMediaPlayer.h>
+#include <AVSCommon/Utils/Timing/ManualClock.h>
 
 #include "SpeechSynthesizer/SpeechSynthesizer.h"
 
@@ -47,6 +52,7 @@ using namespace avsCommon::sdkInterfaces;
 using namespace avsCommon::sdkInterfaces::test;
 using namespace avsCommon::utils::mediaPlayer;
 using namespace avsCommon::utils::mediaPlayer::test;
+using namespace avsCommon::utils::timing::test;
 using namespace ::testing;
 
 /// Plenty of time for a test to complete.
@@ -85,8 +91,11 @@ static const std::string TOKEN_TEST("Token_Test");
 /// Format of the audio.
 static const std::string FORMAT_TEST("AUDIO_MPEG");
 
+/// Content Id of the audio attachment for testing.
+static const std::string CONTENT_ID_TEST("Test");
+
 /// URL for testing.
-static const std::string URL_TEST("cid:Test");
+static const std::string URL_TEST("cid:" + CONTENT_ID_TEST);
 
 /// Context ID for testing
 static const std::string CONTEXT_ID_TEST("ContextId_Test");
@@ -856,6 +865,92 @@ TEST_F(SpeechSynthesizerTest, testMediaPlayerFailedToStop) {
     ASSERT_TRUE(m_mockSpeechPlayer->waitUntilPlaybackStarted());
 }
 
+/**
+ * Benchmark the throughput of Speak directives, and the latency from handling one to its SpeechStarted event, with the
+ * speech played by a @c SimulatedMediaPlayer on a @c ManualClock.  Each Speak carries a second of speech, which plays
+ * as soon as the clock is advanced, so the timings are those of the @c SpeechSynthesizer and the attachment it reads
+ * alone.  Disabled as it only prints timings.
+ */
+TEST_F(SpeechSynthesizerTest, DISABLED_benchmarkSpeakThroughputAndLatency) {
+    static const int ITERATIONS = 200;
+    static const std::chrono::seconds SPEECH_DURATION(1);
+    const std::string speech(SimulatedMediaPlayer::DEFAULT_BYTES_PER_SECOND * SPEECH_DURATION.count(), 'x');
+
+    auto clock = std::make_shared<ManualClock>();
+    auto player = SimulatedMediaPlayer::create(SimulatedMediaPlayer::DEFAULT_BYTES_PER_SECOND, clock);
+    ASSERT_TRUE(player);
+    auto speechSynthesizer = SpeechSynthesizer::create(
+        player,
+        m_mockMessageSender,
+        m_mockFocusManager,
+        m_mockContextManager,
+        m_attachmentManager,
+        m_mockExceptionSender,
+        m_dialogUXStateAggregator);
+    ASSERT_TRUE(speechSynthesizer);
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    int channelsAcquired = 0;
+    int messagesSent = 0;
+    auto waitForCount = [&mutex, &wake](const int& count, int target) {
+        std::unique_lock<std::mutex> lock(mutex);
+        return wake.wait_for(lock, WAIT_TIMEOUT, [&count, target] { return count >= target; });
+    };
+    EXPECT_CALL(*(m_mockFocusManager.get()), acquireChannel(CHANNEL_NAME, _, FOCUS_MANAGER_ACTIVITY_ID))
+        .WillRepeatedly(InvokeWithoutArgs([&] {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++channelsAcquired;
+            wake.notify_all();
+            return true;
+        }));
+    EXPECT_CALL(*(m_mockMessageSender.get()), sendMessage(_)).WillRepeatedly(InvokeWithoutArgs([&] {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++messagesSent;
+        wake.notify_all();
+    }));
+
+    std::chrono::steady_clock::duration totalLatency{0};
+    std::chrono::steady_clock::duration maxLatency{0};
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ITERATIONS; ++i) {
+        auto messageId = MESSAGE_ID_TEST + std::to_string(i);
+        auto contextId = CONTEXT_ID_TEST + std::to_string(i);
+        auto writer =
+            m_attachmentManager->createWriter(m_attachmentManager->generateAttachmentId(contextId, CONTENT_ID_TEST));
+        auto writeStatus = AttachmentWriter::WriteStatus::OK;
+        ASSERT_EQ(writer->write(speech.data(), speech.size(), &writeStatus), speech.size());
+        writer->close();
+        auto avsMessageHeader = std::make_shared<AVSMessageHeader>(
+            NAMESPACE_SPEECH_SYNTHESIZER, NAME_SPEAK, messageId, DIALOG_REQUEST_ID_TEST);
+        std::shared_ptr<AVSDirective> directive =
+            AVSDirective::create("", avsMessageHeader, PAYLOAD_TEST, m_attachmentManager, contextId);
+
+        auto handled = std::chrono::steady_clock::now();
+        speechSynthesizer->handleDirectiveImmediately(directive);
+        ASSERT_TRUE(waitForCount(channelsAcquired, i + 1));
+        speechSynthesizer->onFocusChanged(FocusState::FOREGROUND);
+        // SpeechStarted, then SpeechFinished once the speech has played.
+        ASSERT_TRUE(waitForCount(messagesSent, 2 * i + 1));
+        auto latency = std::chrono::steady_clock::now() - handled;
+        totalLatency += latency;
+        maxLatency = std::max(maxLatency, latency);
+        clock->advance(SPEECH_DURATION);
+        ASSERT_TRUE(waitForCount(messagesSent, 2 * i + 2));
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    speechSynthesizer->shutdown();
+
+    std::cout << ITERATIONS << " Speak directives of " << SPEECH_DURATION.count() << "s in "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count() << "ms ("
+              << ITERATIONS * std::chrono::steady_clock::duration::period::den /
+                     (elapsed.count() * std::chrono::steady_clock::duration::period::num)
+              << "/s), handle-to-SpeechStarted mean "
+              << std::chrono::duration_cast<std::chrono::microseconds>(totalLatency).count() / ITERATIONS
+              << "us max " << std::chrono::duration_cast<std::chrono::microseconds>(maxLatency).count() << "us"
+              << std::endl;
+}
+
 }  // namespace test
 }  // namespace speechSynthesizer
 }  // namespace capabilityAgents
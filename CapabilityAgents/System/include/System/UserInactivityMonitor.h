@@ -24,6 +24,7 @@
 #include <string>
 
 #include <AVSCommon/AVS/CapabilityAgent.h>
+#include <AVSCommon/Utils/Timing/Clock.h>
 #include <AVSCommon/Utils/Timing/Timer.h>
 #include <AVSCommon/SDKInterfaces/MessageSenderInterface.h>
 #include <AVSCommon/SDKInterfaces/ExceptionEncounteredSenderInterface.h>
@@ -44,12 +45,15 @@ public:
      * @param messageSender The @c MessageSenderInterface for sending events.
      * @param exceptionEncounteredSender The interface that sends exceptions.
      * @param sendPeriod The period of send events in seconds.
+     * @param clock The clock to measure inactivity and the send period with.  If @c nullptr, @c Clock::getDefault()
+     *     is used.
      * @return @c nullptr if the inputs are not defined, else a new instance of @c UserInactivityMonitor.
      */
     static std::shared_ptr<UserInactivityMonitor> create(
         std::shared_ptr<avsCommon::sdkInterfaces::MessageSenderInterface> messageSender,
         std::shared_ptr<avsCommon::sdkInterfaces::ExceptionEncounteredSenderInterface> exceptionEncounteredSender,
-        const std::chrono::milliseconds& sendPeriod = std::chrono::hours(1));
+        const std::chrono::milliseconds& sendPeriod = std::chrono::hours(1),
+        std::shared_ptr<avsCommon::utils::timing::Clock> clock = nullptr);
 
     /// @name DirectiveHandlerInterface and CapabilityAgent Functions
     /// @{
@@ -71,11 +75,13 @@ private:
      * @param messageSender The @c MessageSenderInterface for sending events.
      * @param exceptionEncounteredSender The interface that sends exceptions.
      * @param sendPeriod The period of send events in seconds.
+     * @param clock The clock to measure inactivity and the send period with.
      */
     UserInactivityMonitor(
         std::shared_ptr<avsCommon::sdkInterfaces::MessageSenderInterface> messageSender,
         std::shared_ptr<avsCommon::sdkInterfaces::ExceptionEncounteredSenderInterface> exceptionEncounteredSender,
-        const std::chrono::milliseconds& sendPeriod);
+        const std::chrono::milliseconds& sendPeriod,
+        std::shared_ptr<avsCommon::utils::timing::Clock> clock);
 
     /**
      *
@@ -96,6 +102,9 @@ private:
     /// The @c MessageSender interface to send inactivity event.
     std::shared_ptr<avsCommon::sdkInterfaces::MessageSenderInterface> m_messageSender;
 
+    /// The clock to measure inactivity and the send period with.
+    std::shared_ptr<avsCommon::utils::timing::Clock> m_clock;
+
     /**
      * Time point to keep user inactivity. Access synchronized by @c m_timeMutex, and blocks tracked by @c
      * m_recentUpdateBlocked.
@@ -78,7 +78,8 @@ void UserInactivityMonitor::removeDirectiveGracefully(
 std::shared_ptr<UserInactivityMonitor> UserInactivityMonitor::create(
     std::shared_ptr<MessageSenderInterface> messageSender,
     std::shared_ptr<ExceptionEncounteredSenderInterface> exceptionEncounteredSender,
-    const std::chrono::milliseconds& sendPeriod) {
+    const std::chrono::milliseconds& sendPeriod,
+    std::shared_ptr<Clock> clock) {
     if (!messageSender) {
         ACSDK_ERROR(LX("createFailed").d("reason", "nullMessageSender"));
         return nullptr;
@@ -87,17 +88,23 @@ std::shared_ptr<UserInactivityMonitor> UserInactivityMonitor::create(
         ACSDK_ERROR(LX("createFailed").d("reason", "nullExceptionEncounteredSender"));
         return nullptr;
     }
+    if (!clock) {
+        clock = Clock::getDefault();
+    }
     return std::shared_ptr<UserInactivityMonitor>(
-        new UserInactivityMonitor(messageSender, exceptionEncounteredSender, sendPeriod));
+        new UserInactivityMonitor(messageSender, exceptionEncounteredSender, sendPeriod, clock));
 }
 
 UserInactivityMonitor::UserInactivityMonitor(
     std::shared_ptr<MessageSenderInterface> messageSender,
     std::shared_ptr<ExceptionEncounteredSenderInterface> exceptionEncounteredSender,
-    const std::chrono::milliseconds& sendPeriod) :
+    const std::chrono::milliseconds& sendPeriod,
+    std::shared_ptr<Clock> clock) :
         CapabilityAgent(USER_INACTIVITY_MONITOR_NAMESPACE, exceptionEncounteredSender),
         m_messageSender{messageSender},
-        m_lastTimeActive{std::chrono::steady_clock::now()} {
+        m_clock{clock},
+        m_lastTimeActive{m_clock->steadyNow()},
+        m_eventTimer{m_clock} {
     m_eventTimer.start(
         sendPeriod,
         Timer::PeriodType::ABSOLUTE,
@@ -114,7 +121,7 @@ void UserInactivityMonitor::sendInactivityReport() {
     }
     if (m_recentUpdateBlocked) {
         std::lock_guard<std::mutex> timeLock(m_timeMutex);
-        m_lastTimeActive = std::chrono::steady_clock::now();
+        m_lastTimeActive = m_clock->steadyNow();
         lastTimeActive = m_lastTimeActive;
     }
 
@@ -122,7 +129,7 @@ void UserInactivityMonitor::sendInactivityReport() {
     SizeType payloadKeySize = INACTIVITY_EVENT_PAYLOAD_KEY.length();
     const Pointer::Token payloadKey[] = {{INACTIVITY_EVENT_PAYLOAD_KEY.c_str(), payloadKeySize, kPointerInvalidIndex}};
     auto inactiveTime =
-        std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now() - lastTimeActive);
+        std::chrono::duration_cast<std::chrono::seconds>(m_clock->steadyNow() - lastTimeActive);
     Pointer(payloadKey, 1).Set(inactivityPayload, inactiveTime.count());
     std::string inactivityPayloadString;
     jsonUtils::convertToValue(inactivityPayload, &inactivityPayloadString);
@@ -160,7 +167,7 @@ void UserInactivityMonitor::cancelDirective(std::shared_ptr<CapabilityAgent::Dir
 void UserInactivityMonitor::onUserActive() {
     std::unique_lock<std::mutex> timeLock(m_timeMutex, std::defer_lock);
     if (timeLock.try_lock()) {
-        m_lastTimeActive = std::chrono::steady_clock::now();
+        m_lastTimeActive = m_clock->steadyNow();
     } else {
         m_recentUpdateBlocked = true;
     }
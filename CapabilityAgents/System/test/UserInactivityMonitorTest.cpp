@@ -27,6 +27,7 @@
 #include <AVSCommon/SDKInterfaces/MockMessageSender.h>
 #include <AVSCommon/SDKInterfaces/MockExceptionEncounteredSender.h>
 #include <AVSCommon/Utils/JSON/JSONUtils.h>
+#include <AVSCommon/Utils/Timing/ManualClock.h>
 #include <ADSL/DirectiveSequencer.h>
 
 #include "System/UserInactivityMonitor.h"
@@ -42,6 +43,7 @@ using namespace avsCommon::sdkInterfaces::test;
 using namespace avsCommon::sdkInterfaces;
 using namespace avsCommon::avs;
 using namespace avsCommon::utils::json;
+using namespace avsCommon::utils::timing::test;
 using namespace rapidjson;
 using ::testing::InSequence;
 
@@ -56,6 +58,9 @@ static const std::string USER_INACTIVITY_MESSAGE_ID = "ABC123DEF";
 static const std::string USER_INACTIVITY_PAYLOAD_KEY = "inactiveTimeInSeconds";
 static const std::chrono::milliseconds USER_INACTIVITY_REPORT_PERIOD{20};
 
+/// The real time to wait for a report in tests driven by a @c ManualClock.  This will only be hit if a test is failing.
+static const std::chrono::seconds MANUAL_CLOCK_TIMEOUT{2};
+
 /// This is the condition variable to be used to control the exit of the test case.
 std::condition_variable exitTrigger;
 
@@ -86,6 +91,21 @@ static bool checkMessageRequest(std::shared_ptr<MessageRequest> messageRequest)
     return inactivityNode->value.IsUint64();
 }
 
+/**
+ * Get the inactive time reported by a message request.
+ *
+ * @param messageRequest The message request to read.
+ * @return The reported inactive time in seconds, or -1 if the message request has errors.
+ */
+static int64_t getInactiveTime(std::shared_ptr<MessageRequest> messageRequest) {
+    if (!checkMessageRequest(messageRequest)) {
+        return -1;
+    }
+    rapidjson::Document jsonContent(rapidjson::kObjectType);
+    jsonContent.Parse(messageRequest->getJsonContent());
+    return static_cast<int64_t>(jsonContent["event"]["payload"][USER_INACTIVITY_PAYLOAD_KEY].GetUint64());
+}
+
 /**
  * Check if message request has errors.
  *
@@ -215,6 +235,40 @@ TEST_F(UserInactivityMonitorTest, sendMultipleReportsWithReset) {
     directiveSequencer->shutdown();
 }
 
+/**
+ * This case tests that the reported inactive time and the send period follow the clock the monitor was created with,
+ * so that hour long periods can be verified without waiting for them.
+ */
+TEST_F(UserInactivityMonitorTest, reportsFollowClock) {
+    auto clock = std::make_shared<ManualClock>();
+    std::mutex reportMutex;
+    std::condition_variable reportTrigger;
+    std::vector<int64_t> reports;
+    EXPECT_CALL(*m_mockMessageSender, sendMessage(_))
+        .WillRepeatedly(Invoke([&](std::shared_ptr<MessageRequest> request) {
+            std::lock_guard<std::mutex> lock(reportMutex);
+            reports.push_back(getInactiveTime(request));
+            reportTrigger.notify_all();
+        }));
+    auto userInactivityMonitor = UserInactivityMonitor::create(
+        m_mockMessageSender, m_mockExceptionEncounteredSender, std::chrono::hours(1), clock);
+    ASSERT_NE(nullptr, userInactivityMonitor);
+
+    std::unique_lock<std::mutex> lock(reportMutex, std::defer_lock);
+    clock->advance(std::chrono::hours(1));
+    lock.lock();
+    ASSERT_TRUE(reportTrigger.wait_for(lock, MANUAL_CLOCK_TIMEOUT, [&reports] { return reports.size() == 1; }));
+    EXPECT_EQ(reports[0], 3600);
+    lock.unlock();
+
+    clock->advance(std::chrono::minutes(30));
+    userInactivityMonitor->onUserActive();
+    clock->advance(std::chrono::minutes(30));
+    lock.lock();
+    ASSERT_TRUE(reportTrigger.wait_for(lock, MANUAL_CLOCK_TIMEOUT, [&reports] { return reports.size() == 2; }));
+    EXPECT_EQ(reports[1], 1800);
+}
+
 }  // namespace test
 }  // namespace system
 }  // namespace capabilityAgents
@@ -241,7 +241,10 @@ private:
      */
     std::shared_ptr<avsCommon::sdkInterfaces::AudioPlayerInterface> m_audioPlayerInterface;
 
-    /// This is the worker thread for the @c TemplateRuntime CA.
+    /**
+     * This is the worker thread for the @c TemplateRuntime CA.  It has a thread of its own, as its tasks block on
+     * @c AudioPlayerInterface::getAudioItemOffset().
+     */
     avsCommon::utils::threading::Executor m_executor;
 };
 
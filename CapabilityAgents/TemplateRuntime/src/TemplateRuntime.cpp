@@ -154,7 +154,8 @@ TemplateRuntime::TemplateRuntime(
         CapabilityAgent{NAMESPACE, exceptionSender},
         RequiresShutdown{"TemplateRuntime"},
         m_isRenderTemplateLastReceived{false},
-        m_audioPlayerInterface{audioPlayerInterface} {
+        m_audioPlayerInterface{audioPlayerInterface},
+        m_executor{avsCommon::utils::threading::Executor::ThreadPolicy::DEDICATED} {
 }
 
 void TemplateRuntime::doShutdown() {
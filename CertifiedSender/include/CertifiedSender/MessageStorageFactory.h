@@ -0,0 +1,48 @@
+/*
+ * MessageStorageFactory.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_CERTIFIEDSENDER_INCLUDE_CERTIFIEDSENDER_MESSAGESTORAGEFACTORY_H_
+#define ALEXA_CLIENT_SDK_CERTIFIEDSENDER_INCLUDE_CERTIFIEDSENDER_MESSAGESTORAGEFACTORY_H_
+
+#include <memory>
+
+#include "CertifiedSender/MessageStorageInterface.h"
+
+namespace alexaClientSDK {
+namespace certifiedSender {
+
+/**
+ * Creates the @c MessageStorageInterface implementation selected in the "certifiedSender" node of the configuration.
+ *
+ * The "storageEngine" key selects "sqlite", the default, or "segmentedLog".  For "segmentedLog", the optional keys
+ * "segmentSizeInBytes" and "groupCommitIntervalInMilliseconds" configure the @c SegmentedLogMessageStorage, and
+ * "databaseFilePath" names the directory of the log rather than a file.
+ */
+class MessageStorageFactory {
+public:
+    /**
+     * Create the configured message storage.
+     *
+     * @return The storage, or @c nullptr if the configured storage engine is unknown.
+     */
+    static std::shared_ptr<MessageStorageInterface> create();
+};
+
+}  // namespace certifiedSender
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_CERTIFIEDSENDER_INCLUDE_CERTIFIEDSENDER_MESSAGESTORAGEFACTORY_H_
@@ -0,0 +1,230 @@
+/*
+ * SegmentedLogMessageStorage.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_CERTIFIEDSENDER_INCLUDE_CERTIFIEDSENDER_SEGMENTEDLOGMESSAGESTORAGE_H_
+#define ALEXA_CLIENT_SDK_CERTIFIEDSENDER_INCLUDE_CERTIFIEDSENDER_SEGMENTEDLOGMESSAGESTORAGE_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+
+#include "CertifiedSender/MessageStorageInterface.h"
+
+namespace alexaClientSDK {
+namespace certifiedSender {
+
+/**
+ * An implementation which stores messages in an append-only log, split into segment files in a directory.
+ *
+ * @c CertifiedSender uses its storage as a FIFO: each message is stored, sent, and erased once the server has seen it.
+ * Rather than inserting and deleting rows in a B-tree, this class appends a record for each message stored, and a
+ * tombstone record for each message erased.  Each record carries a CRC-32, so that on @c open() a record which was
+ * only partly written before a crash, and anything after it in the same segment, is discarded and truncated away.
+ *
+ * Once the active segment reaches its size limit, a new one is started.  The oldest segment is deleted when none of
+ * its messages are left, and when only a few are left, they are copied to the active segment first, so that one
+ * message which is never erased can't keep an unbounded log alive.  Segments are only ever deleted oldest first, so a
+ * tombstone is never lost while the message it erases is still on disk.
+ *
+ * @c store() only returns once its record has been synced to disk.  Stores made from several threads at once share
+ * syncs: the first to need one syncs every record written so far, outside the lock, and the stores which append their
+ * records meanwhile wait for it and then share the next sync.  With a group commit interval, the thread leading a sync
+ * first waits that long for more records to join it, trading the latency of each store for fewer syncs.  Tombstones
+ * are never synced on their own, as a lost one only means a message is sent again.
+ *
+ * The file path given to @c createDatabase() and @c open() is the directory holding the segments.
+ *
+ * @c store() may be called from several threads at once.  @c createDatabase(), @c open() and @c close() must not be
+ * called while other calls are in progress.
+ */
+class SegmentedLogMessageStorage : public MessageStorageInterface {
+public:
+    /// The default size at which a new segment is started.
+    static constexpr size_t DEFAULT_SEGMENT_SIZE_IN_BYTES = 0x100000;
+
+    /**
+     * Constructor.
+     *
+     * @param segmentSizeInBytes The size at which a new segment is started.
+     * @param groupCommitInterval How long a sync waits for records stored by other threads to join it, or zero to
+     *     sync as soon as a record needs it.
+     */
+    SegmentedLogMessageStorage(
+        size_t segmentSizeInBytes = DEFAULT_SEGMENT_SIZE_IN_BYTES,
+        std::chrono::milliseconds groupCommitInterval = std::chrono::milliseconds::zero());
+
+    ~SegmentedLogMessageStorage();
+
+    bool createDatabase(const std::string& filePath) override;
+
+    bool open(const std::string& filePath) override;
+
+    bool isOpen() override;
+
+    void close() override;
+
+    bool store(const std::string& message, int* id) override;
+
+    bool load(std::queue<StoredMessage>* messageContainer) override;
+
+    bool erase(int messageId) override;
+
+    bool clearDatabase() override;
+
+    /**
+     * Get the number of segment files in the log, for diagnostics and tests.
+     *
+     * @return The number of segments, or zero if no log is open.
+     */
+    size_t getNumSegments();
+
+protected:
+    /**
+     * A non-virtual function that may be called to clean up resources managed by this class.
+     */
+    void doClose();
+
+private:
+    /// A segment file of the log.
+    struct Segment {
+        /// The path of the file.
+        std::string path;
+        /// The descriptor of the file, open for reading and writing.
+        int fd;
+        /// The size of the valid records in the file.
+        uint64_t size;
+        /// The number of messages stored in the segment, including ones erased since.
+        size_t numStored;
+        /// The number of messages stored in the segment which have not been erased.
+        size_t numLive;
+    };
+
+    /// Where the text of a message which has not been erased is.
+    struct Location {
+        /// The sequence number of the segment holding the message.
+        uint32_t sequence;
+        /// The offset of the text in the segment.
+        uint64_t offset;
+        /// The length of the text.
+        uint32_t length;
+    };
+
+    /**
+     * Open each segment in @c m_directory, replay its records, and truncate any which are invalid.
+     *
+     * @return Whether the log was read.
+     */
+    bool recoverLocked();
+
+    /**
+     * Replay the records of a segment into @c m_live.
+     *
+     * @param sequence The sequence number of the segment.
+     * @param segment The segment.
+     * @return Whether the segment could be read.
+     */
+    bool replaySegmentLocked(uint32_t sequence, Segment* segment);
+
+    /**
+     * Start a new active segment.
+     *
+     * @return Whether the segment was created.
+     */
+    bool startSegmentLocked();
+
+    /**
+     * Append a record to the active segment, starting a new segment afterwards if it is full.
+     *
+     * @param type The type of the record.
+     * @param id The message id of the record.
+     * @param payload The text of the record.
+     * @param[out] location Where the text was written, if not @c nullptr.
+     * @return Whether the record was written.
+     */
+    bool appendLocked(uint8_t type, int id, const std::string& payload, Location* location);
+
+    /**
+     * Mark a message as erased in the index, updating the count of its segment.
+     *
+     * @param id The id of the message.
+     * @return Whether the message had not already been erased.
+     */
+    bool dropLiveLocked(int id);
+
+    /**
+     * Delete the oldest segments while they hold no messages, and compact the oldest if only a few of its messages are
+     * left.
+     */
+    void collectSegmentsLocked();
+
+    /**
+     * Sync the active segment, if it has been written to since it was last synced.  Other segments are synced when
+     * they stop being active.
+     *
+     * @return Whether the sync succeeded.
+     */
+    bool syncLocked();
+
+    /**
+     * Wait until the records appended so far have been synced, leading a sync if none is in progress.  The lock is
+     * released while waiting and while syncing.
+     *
+     * @param lock The lock held on @c m_mutex.
+     * @return Whether the records were synced.
+     */
+    bool waitForSyncLocked(std::unique_lock<std::mutex>& lock);
+
+    /// The size at which a new segment is started.
+    const size_t m_segmentSizeInBytes;
+
+    /// How long a sync waits for records stored by other threads to join it.
+    const std::chrono::milliseconds m_groupCommitInterval;
+
+    /// Mutex serializing access to the members below.
+    std::mutex m_mutex;
+
+    /// Notified when a sync finishes.
+    std::condition_variable m_syncTrigger;
+
+    /// The directory of the open log, or empty if no log is open.
+    std::string m_directory;
+
+    /// The segments of the log by sequence number.  The last one is the active segment.
+    std::map<uint32_t, Segment> m_segments;
+
+    /// The messages which have not been erased, by id.
+    std::map<int, Location> m_live;
+
+    /// The id of the next message to store.
+    int m_nextId;
+
+    /// The number of records appended since the log was opened.
+    uint64_t m_numAppended;
+
+    /// The number of the records appended since the log was opened which are known to be on disk.
+    uint64_t m_numSynced;
+
+    /// Whether a thread is syncing the log in @c waitForSyncLocked() with the lock released.
+    bool m_isSyncing;
+};
+
+}  // namespace certifiedSender
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_CERTIFIEDSENDER_INCLUDE_CERTIFIEDSENDER_SEGMENTEDLOGMESSAGESTORAGE_H_
@@ -0,0 +1,86 @@
+/*
+ * MessageStorageFactory.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "CertifiedSender/MessageStorageFactory.h"
+#include "CertifiedSender/SQLiteMessageStorage.h"
+#include "CertifiedSender/SegmentedLogMessageStorage.h"
+
+#include <AVSCommon/Utils/Configuration/ConfigurationNode.h>
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+namespace alexaClientSDK {
+namespace certifiedSender {
+
+using namespace avsCommon::utils::configuration;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("MessageStorageFactory");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The key in our config file to find the root of settings for the certified sender.
+static const std::string CERTIFIED_SENDER_CONFIGURATION_ROOT_KEY = "certifiedSender";
+/// The key in our config file to find the storage engine.
+static const std::string STORAGE_ENGINE_KEY = "storageEngine";
+/// The key in our config file to find the segment size of the segmented log.
+static const std::string SEGMENT_SIZE_KEY = "segmentSizeInBytes";
+/// The key in our config file to find the group commit interval of the segmented log.
+static const std::string GROUP_COMMIT_INTERVAL_KEY = "groupCommitIntervalInMilliseconds";
+
+/// The storage engine value selecting @c SQLiteMessageStorage.
+static const std::string STORAGE_ENGINE_SQLITE = "sqlite";
+/// The storage engine value selecting @c SegmentedLogMessageStorage.
+static const std::string STORAGE_ENGINE_SEGMENTED_LOG = "segmentedLog";
+
+std::shared_ptr<MessageStorageInterface> MessageStorageFactory::create() {
+    auto configurationRoot = ConfigurationNode::getRoot()[CERTIFIED_SENDER_CONFIGURATION_ROOT_KEY];
+
+    std::string storageEngine;
+    configurationRoot.getString(STORAGE_ENGINE_KEY, &storageEngine, STORAGE_ENGINE_SQLITE);
+
+    if (STORAGE_ENGINE_SQLITE == storageEngine) {
+        return std::make_shared<SQLiteMessageStorage>();
+    }
+
+    if (STORAGE_ENGINE_SEGMENTED_LOG == storageEngine) {
+        int segmentSize = 0;
+        configurationRoot.getInt(
+            SEGMENT_SIZE_KEY, &segmentSize, SegmentedLogMessageStorage::DEFAULT_SEGMENT_SIZE_IN_BYTES);
+        int groupCommitInterval = 0;
+        configurationRoot.getInt(GROUP_COMMIT_INTERVAL_KEY, &groupCommitInterval, 0);
+        if (segmentSize <= 0 || groupCommitInterval < 0) {
+            ACSDK_ERROR(LX("createFailed")
+                            .d("reason", "invalidSegmentedLogConfiguration")
+                            .d("segmentSizeInBytes", segmentSize)
+                            .d("groupCommitIntervalInMilliseconds", groupCommitInterval));
+            return nullptr;
+        }
+        return std::make_shared<SegmentedLogMessageStorage>(
+            segmentSize, std::chrono::milliseconds(groupCommitInterval));
+    }
+
+    ACSDK_ERROR(LX("createFailed").d("reason", "unknownStorageEngine").d("storageEngine", storageEngine));
+    return nullptr;
+}
+
+}  // namespace certifiedSender
+}  // namespace alexaClientSDK
@@ -0,0 +1,692 @@
+/*
+ * SegmentedLogMessageStorage.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "CertifiedSender/SegmentedLogMessageStorage.h"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <AVSCommon/Utils/File/FileUtils.h>
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+namespace alexaClientSDK {
+namespace certifiedSender {
+
+using namespace avsCommon::utils::file;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("SegmentedLogMessageStorage");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+constexpr size_t SegmentedLogMessageStorage::DEFAULT_SEGMENT_SIZE_IN_BYTES;
+
+/// The prefix of the names of segment files.
+static const std::string SEGMENT_FILE_PREFIX = "segment-";
+
+/// The suffix of the names of segment files.
+static const std::string SEGMENT_FILE_SUFFIX = ".log";
+
+/// The type of a record storing a message.
+static const uint8_t RECORD_TYPE_STORE = 1;
+
+/// The type of a record erasing a message.
+static const uint8_t RECORD_TYPE_ERASE = 2;
+
+/// The type of a record erasing every message in the log before it.
+static const uint8_t RECORD_TYPE_CLEAR = 3;
+
+/**
+ * The size of a record header: a CRC-32 of the rest of the record, the type, the message id and the length of the
+ * text, all little-endian.
+ */
+static const size_t RECORD_HEADER_SIZE = 4 + 1 + 4 + 4;
+
+/// The offset of the type in a record header.  The CRC covers the record from here on.
+static const size_t RECORD_TYPE_OFFSET = 4;
+
+/// The longest message text accepted.  A header with a longer length can only be garbage.
+static const uint32_t MAX_MESSAGE_LENGTH = 0x1000000;
+
+/// A segment is compacted once no more than one in this many of the messages stored in it are left.
+static const size_t COMPACTION_RATIO = 4;
+
+/**
+ * Build the lookup table for a CRC-32 with the IEEE 802.3 polynomial.
+ *
+ * @return The table.
+ */
+static std::array<uint32_t, 256> buildCrcTable() {
+    std::array<uint32_t, 256> table;
+    for (uint32_t i = 0; i < table.size(); ++i) {
+        uint32_t crc = i;
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320 : crc >> 1;
+        }
+        table[i] = crc;
+    }
+    return table;
+}
+
+/**
+ * Calculate the CRC-32 of some data.
+ *
+ * @param data The data.
+ * @param size The size of the data.
+ * @return The CRC-32.
+ */
+static uint32_t crc32(const uint8_t* data, size_t size) {
+    static const std::array<uint32_t, 256> table = buildCrcTable();
+    uint32_t crc = 0xFFFFFFFF;
+    for (size_t i = 0; i < size; ++i) {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFF;
+}
+
+/**
+ * Write a 32-bit value to a buffer, little-endian.
+ *
+ * @param value The value.
+ * @param buffer The buffer to write the 4 bytes of the value to.
+ */
+static void putUint32(uint32_t value, uint8_t* buffer) {
+    for (int i = 0; i < 4; ++i) {
+        buffer[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+/**
+ * Read a little-endian 32-bit value from a buffer.
+ *
+ * @param buffer The buffer holding the 4 bytes of the value.
+ * @return The value.
+ */
+static uint32_t getUint32(const uint8_t* buffer) {
+    uint32_t value = 0;
+    for (int i = 0; i < 4; ++i) {
+        value |= static_cast<uint32_t>(buffer[i]) << (8 * i);
+    }
+    return value;
+}
+
+/**
+ * Write all of a buffer to a file at an offset.
+ *
+ * @param fd The file.
+ * @param data The data to write.
+ * @param size The size of the data.
+ * @param offset The offset to write at.
+ * @return Whether all of the data was written.
+ */
+static bool writeAt(int fd, const uint8_t* data, size_t size, uint64_t offset) {
+    size_t written = 0;
+    while (written < size) {
+        auto result = ::pwrite(fd, data + written, size - written, offset + written);
+        if (result < 0 && EINTR == errno) {
+            continue;
+        }
+        if (result <= 0) {
+            ACSDK_ERROR(LX("writeAtFailed").d("error", std::strerror(errno)));
+            return false;
+        }
+        written += result;
+    }
+    return true;
+}
+
+/**
+ * Read a whole buffer from a file at an offset.
+ *
+ * @param fd The file.
+ * @param[out] data The buffer to read into.
+ * @param size The number of bytes to read.
+ * @param offset The offset to read at.
+ * @return Whether all of the data was read.
+ */
+static bool readAt(int fd, uint8_t* data, size_t size, uint64_t offset) {
+    size_t numRead = 0;
+    while (numRead < size) {
+        auto result = ::pread(fd, data + numRead, size - numRead, offset + numRead);
+        if (result < 0 && EINTR == errno) {
+            continue;
+        }
+        if (result <= 0) {
+            ACSDK_ERROR(LX("readAtFailed").d("error", result < 0 ? std::strerror(errno) : "endOfFile"));
+            return false;
+        }
+        numRead += result;
+    }
+    return true;
+}
+
+/**
+ * Sync a directory, so that files created in or removed from it persist.
+ *
+ * @param directory The directory.
+ */
+static void syncDirectory(const std::string& directory) {
+    int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY);
+    if (fd < 0) {
+        ACSDK_WARN(LX("syncDirectoryFailed").d("directory", directory).d("error", std::strerror(errno)));
+        return;
+    }
+    ::fsync(fd);
+    ::close(fd);
+}
+
+SegmentedLogMessageStorage::SegmentedLogMessageStorage(
+    size_t segmentSizeInBytes,
+    std::chrono::milliseconds groupCommitInterval) :
+        m_segmentSizeInBytes{segmentSizeInBytes},
+        m_groupCommitInterval{groupCommitInterval},
+        m_nextId{1},
+        m_numAppended{0},
+        m_numSynced{0},
+        m_isSyncing{false} {
+}
+
+SegmentedLogMessageStorage::~SegmentedLogMessageStorage() {
+    doClose();
+}
+
+bool SegmentedLogMessageStorage::createDatabase(const std::string& filePath) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (!m_directory.empty()) {
+        ACSDK_ERROR(LX("createDatabaseFailed").m("Log is already open."));
+        return false;
+    }
+
+    if (fileExists(filePath)) {
+        ACSDK_ERROR(LX("createDatabaseFailed").m("File specified already exists.").d("file path", filePath));
+        return false;
+    }
+
+    if (::mkdir(filePath.c_str(), 0700) != 0) {
+        ACSDK_ERROR(LX("createDatabaseFailed")
+                        .m("Directory could not be created.")
+                        .d("file path", filePath)
+                        .d("error", std::strerror(errno)));
+        return false;
+    }
+
+    m_directory = filePath;
+    m_nextId = 1;
+    m_numAppended = 0;
+    m_numSynced = 0;
+    if (!startSegmentLocked()) {
+        ACSDK_ERROR(LX("createDatabaseFailed").m("Segment could not be created."));
+        lock.unlock();
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool SegmentedLogMessageStorage::open(const std::string& filePath) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (!m_directory.empty()) {
+        ACSDK_ERROR(LX("openFailed").m("Log is already open."));
+        return false;
+    }
+
+    struct stat status;
+    if (::stat(filePath.c_str(), &status) != 0 || !S_ISDIR(status.st_mode)) {
+        ACSDK_ERROR(LX("openFailed").m("Directory specified does not exist.").d("file path", filePath));
+        return false;
+    }
+
+    m_directory = filePath;
+    m_nextId = 1;
+    m_numAppended = 0;
+    m_numSynced = 0;
+    if (!recoverLocked()) {
+        ACSDK_ERROR(LX("openFailed").m("Log could not be read.").d("file path", filePath));
+        lock.unlock();
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool SegmentedLogMessageStorage::isOpen() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return !m_directory.empty();
+}
+
+void SegmentedLogMessageStorage::close() {
+    doClose();
+}
+
+void SegmentedLogMessageStorage::doClose() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_directory.empty()) {
+        return;
+    }
+    if (!syncLocked()) {
+        ACSDK_ERROR(LX("closeFailed").m("Could not sync the log."));
+    }
+    for (auto& entry : m_segments) {
+        ::close(entry.second.fd);
+    }
+    m_segments.clear();
+    m_live.clear();
+    m_directory.clear();
+}
+
+bool SegmentedLogMessageStorage::store(const std::string& message, int* id) {
+    if (!id) {
+        ACSDK_ERROR(LX("storeFailed").m("id parameter was nullptr."));
+        return false;
+    }
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_directory.empty()) {
+        ACSDK_ERROR(LX("storeFailed").m("Log is not open."));
+        return false;
+    }
+
+    if (message.size() > MAX_MESSAGE_LENGTH) {
+        ACSDK_ERROR(LX("storeFailed").m("Message is too long.").d("length", message.size()));
+        return false;
+    }
+
+    if (m_nextId <= 0) {
+        ACSDK_ERROR(LX("storeFailed").m("Invalid computed id.  Possible numerical overflow.").d("id", m_nextId));
+        return false;
+    }
+
+    Location location;
+    if (!appendLocked(RECORD_TYPE_STORE, m_nextId, message, &location)) {
+        ACSDK_ERROR(LX("storeFailed").m("Could not append record."));
+        return false;
+    }
+
+    // Claim the id and index the message before waiting, so that the stores which append meanwhile get other ids.
+    auto storedId = m_nextId++;
+    m_live[storedId] = location;
+    auto& segment = m_segments[location.sequence];
+    ++segment.numStored;
+    ++segment.numLive;
+
+    if (!waitForSyncLocked(lock)) {
+        ACSDK_ERROR(LX("storeFailed").m("Could not sync the log."));
+        dropLiveLocked(storedId);
+        return false;
+    }
+    *id = storedId;
+    return true;
+}
+
+bool SegmentedLogMessageStorage::load(std::queue<StoredMessage>* messageContainer) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_directory.empty()) {
+        ACSDK_ERROR(LX("loadFailed").m("Log is not open."));
+        return false;
+    }
+
+    if (!messageContainer) {
+        ACSDK_ERROR(LX("loadFailed").m("Message container parameter is nullptr."));
+        return false;
+    }
+
+    std::vector<uint8_t> text;
+    for (auto& entry : m_live) {
+        auto& location = entry.second;
+        text.resize(location.length);
+        if (!readAt(m_segments[location.sequence].fd, text.data(), text.size(), location.offset)) {
+            ACSDK_ERROR(LX("loadFailed").m("Could not read message.").d("id", entry.first));
+            return false;
+        }
+        messageContainer->push(StoredMessage(entry.first, std::string(text.begin(), text.end())));
+    }
+    return true;
+}
+
+bool SegmentedLogMessageStorage::erase(int messageId) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_directory.empty()) {
+        ACSDK_ERROR(LX("eraseFailed").m("Log is not open."));
+        return false;
+    }
+
+    if (m_live.find(messageId) == m_live.end()) {
+        return true;
+    }
+
+    if (!appendLocked(RECORD_TYPE_ERASE, messageId, "", nullptr)) {
+        ACSDK_ERROR(LX("eraseFailed").m("Could not append record."));
+        return false;
+    }
+    dropLiveLocked(messageId);
+    collectSegmentsLocked();
+    return true;
+}
+
+bool SegmentedLogMessageStorage::clearDatabase() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_directory.empty()) {
+        ACSDK_ERROR(LX("clearDatabaseFailed").m("Log is not open."));
+        return false;
+    }
+
+    // The record must be on disk before the segments it clears are deleted.
+    if (!appendLocked(RECORD_TYPE_CLEAR, m_nextId - 1, "", nullptr) || !syncLocked()) {
+        ACSDK_ERROR(LX("clearDatabaseFailed").m("Could not append record."));
+        return false;
+    }
+    while (!m_live.empty()) {
+        dropLiveLocked(m_live.begin()->first);
+    }
+    collectSegmentsLocked();
+    return true;
+}
+
+size_t SegmentedLogMessageStorage::getNumSegments() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_segments.size();
+}
+
+bool SegmentedLogMessageStorage::recoverLocked() {
+    DIR* dir = ::opendir(m_directory.c_str());
+    if (!dir) {
+        ACSDK_ERROR(LX("recoverFailed").d("error", std::strerror(errno)));
+        return false;
+    }
+    std::map<uint32_t, std::string> paths;
+    while (auto entry = ::readdir(dir)) {
+        std::string name = entry->d_name;
+        if (name.size() <= SEGMENT_FILE_PREFIX.size() + SEGMENT_FILE_SUFFIX.size() ||
+            name.compare(0, SEGMENT_FILE_PREFIX.size(), SEGMENT_FILE_PREFIX) != 0 ||
+            name.compare(name.size() - SEGMENT_FILE_SUFFIX.size(), SEGMENT_FILE_SUFFIX.size(), SEGMENT_FILE_SUFFIX) !=
+                0) {
+            continue;
+        }
+        auto sequence = std::strtoul(name.c_str() + SEGMENT_FILE_PREFIX.size(), nullptr, 10);
+        paths[sequence] = m_directory + "/" + name;
+    }
+    ::closedir(dir);
+
+    for (auto& entry : paths) {
+        Segment segment{entry.second, -1, 0, 0, 0};
+        segment.fd = ::open(segment.path.c_str(), O_RDWR);
+        if (segment.fd < 0) {
+            ACSDK_ERROR(LX("recoverFailed").d("path", segment.path).d("error", std::strerror(errno)));
+            return false;
+        }
+        m_segments[entry.first] = segment;
+        if (!replaySegmentLocked(entry.first, &m_segments[entry.first])) {
+            return false;
+        }
+    }
+
+    if (m_segments.empty() && !startSegmentLocked()) {
+        return false;
+    }
+    collectSegmentsLocked();
+    ACSDK_INFO(LX("recovered").d("segments", m_segments.size()).d("messages", m_live.size()));
+    return true;
+}
+
+bool SegmentedLogMessageStorage::replaySegmentLocked(uint32_t sequence, Segment* segment) {
+    struct stat status;
+    if (::fstat(segment->fd, &status) != 0) {
+        ACSDK_ERROR(LX("replaySegmentFailed").d("path", segment->path).d("error", std::strerror(errno)));
+        return false;
+    }
+    std::vector<uint8_t> data(status.st_size);
+    if (!data.empty() && !readAt(segment->fd, data.data(), data.size(), 0)) {
+        return false;
+    }
+
+    uint64_t offset = 0;
+    while (offset < data.size()) {
+        if (data.size() - offset < RECORD_HEADER_SIZE) {
+            break;
+        }
+        const uint8_t* header = data.data() + offset;
+        uint8_t type = header[RECORD_TYPE_OFFSET];
+        int id = static_cast<int>(getUint32(header + RECORD_TYPE_OFFSET + 1));
+        uint32_t length = getUint32(header + RECORD_TYPE_OFFSET + 5);
+        if (length > MAX_MESSAGE_LENGTH || data.size() - offset - RECORD_HEADER_SIZE < length) {
+            break;
+        }
+        if (crc32(header + RECORD_TYPE_OFFSET, RECORD_HEADER_SIZE - RECORD_TYPE_OFFSET + length) !=
+            getUint32(header)) {
+            break;
+        }
+
+        switch (type) {
+            case RECORD_TYPE_STORE:
+                // A message copied forward by a compaction which was interrupted is found twice; the copy wins.
+                dropLiveLocked(id);
+                m_live[id] = Location{sequence, offset + RECORD_HEADER_SIZE, length};
+                ++segment->numStored;
+                ++segment->numLive;
+                break;
+            case RECORD_TYPE_ERASE:
+                dropLiveLocked(id);
+                break;
+            case RECORD_TYPE_CLEAR:
+                while (!m_live.empty()) {
+                    dropLiveLocked(m_live.begin()->first);
+                }
+                break;
+            default:
+                ACSDK_WARN(LX("replaySegmentWarning").d("reason", "unknownRecordType").d("type", type));
+                break;
+        }
+        if (id >= m_nextId) {
+            m_nextId = id + 1;
+        }
+        offset += RECORD_HEADER_SIZE + length;
+    }
+
+    if (offset < data.size()) {
+        // The rest of the segment was being written when the device stopped.
+        ACSDK_WARN(LX("replaySegmentTruncating")
+                       .d("path", segment->path)
+                       .d("validSize", offset)
+                       .d("fileSize", data.size()));
+        if (::ftruncate(segment->fd, offset) != 0) {
+            ACSDK_ERROR(LX("replaySegmentFailed").d("reason", "truncateFailed").d("error", std::strerror(errno)));
+            return false;
+        }
+    }
+    segment->size = offset;
+    return true;
+}
+
+bool SegmentedLogMessageStorage::startSegmentLocked() {
+    uint32_t sequence = m_segments.empty() ? 1 : m_segments.rbegin()->first + 1;
+    char name[32];
+    std::snprintf(name, sizeof(name), "%010u", sequence);
+    Segment segment{m_directory + "/" + SEGMENT_FILE_PREFIX + name + SEGMENT_FILE_SUFFIX, -1, 0, 0, 0};
+    segment.fd = ::open(segment.path.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (segment.fd < 0) {
+        ACSDK_ERROR(LX("startSegmentFailed").d("path", segment.path).d("error", std::strerror(errno)));
+        return false;
+    }
+    syncDirectory(m_directory);
+    m_segments[sequence] = segment;
+    m_numSynced = m_numAppended;
+    return true;
+}
+
+bool SegmentedLogMessageStorage::appendLocked(uint8_t type, int id, const std::string& payload, Location* location) {
+    auto sequence = m_segments.rbegin()->first;
+    auto& segment = m_segments.rbegin()->second;
+
+    std::vector<uint8_t> record(RECORD_HEADER_SIZE + payload.size());
+    record[RECORD_TYPE_OFFSET] = type;
+    putUint32(static_cast<uint32_t>(id), record.data() + RECORD_TYPE_OFFSET + 1);
+    putUint32(static_cast<uint32_t>(payload.size()), record.data() + RECORD_TYPE_OFFSET + 5);
+    std::copy(payload.begin(), payload.end(), record.begin() + RECORD_HEADER_SIZE);
+    putUint32(crc32(record.data() + RECORD_TYPE_OFFSET, record.size() - RECORD_TYPE_OFFSET), record.data());
+
+    if (!writeAt(segment.fd, record.data(), record.size(), segment.size)) {
+        // Don't leave part of a record behind for the next one to follow.
+        if (::ftruncate(segment.fd, segment.size) != 0) {
+            ACSDK_ERROR(LX("appendFailed").d("reason", "truncateFailed").d("error", std::strerror(errno)));
+        }
+        return false;
+    }
+    if (location) {
+        *location = Location{sequence, segment.size + RECORD_HEADER_SIZE, static_cast<uint32_t>(payload.size())};
+    }
+    segment.size += record.size();
+    ++m_numAppended;
+
+    if (segment.size >= m_segmentSizeInBytes) {
+        // Only the active segment is synced lazily, so a full one is synced before another is started.
+        if (!syncLocked() || !startSegmentLocked()) {
+            ACSDK_WARN(LX("appendWarning").d("reason", "couldNotStartSegment"));
+        }
+    }
+    return true;
+}
+
+bool SegmentedLogMessageStorage::dropLiveLocked(int id) {
+    auto it = m_live.find(id);
+    if (it == m_live.end()) {
+        return false;
+    }
+    auto segment = m_segments.find(it->second.sequence);
+    if (segment != m_segments.end() && segment->second.numLive > 0) {
+        --segment->second.numLive;
+    }
+    m_live.erase(it);
+    return true;
+}
+
+void SegmentedLogMessageStorage::collectSegmentsLocked() {
+    while (m_segments.size() > 1) {
+        auto oldest = m_segments.begin();
+        auto oldestSequence = oldest->first;
+        auto& segment = oldest->second;
+
+        if (segment.numLive > 0) {
+            if (segment.numLive * COMPACTION_RATIO > segment.numStored) {
+                return;
+            }
+            // Copy the few messages left forward, so that the segment can go.
+            std::vector<uint8_t> text;
+            for (auto& entry : m_live) {
+                auto& location = entry.second;
+                if (location.sequence != oldestSequence) {
+                    continue;
+                }
+                text.resize(location.length);
+                Location newLocation;
+                if (!readAt(segment.fd, text.data(), text.size(), location.offset) ||
+                    !appendLocked(
+                        RECORD_TYPE_STORE, entry.first, std::string(text.begin(), text.end()), &newLocation)) {
+                    ACSDK_ERROR(LX("compactFailed").d("path", segment.path));
+                    return;
+                }
+                location = newLocation;
+                auto& newSegment = m_segments[newLocation.sequence];
+                ++newSegment.numStored;
+                ++newSegment.numLive;
+            }
+            // The copies must be on disk before the originals are removed.
+            if (!syncLocked()) {
+                ACSDK_ERROR(LX("compactFailed").d("reason", "syncFailed"));
+                return;
+            }
+            ACSDK_DEBUG5(LX("compacted").d("path", segment.path).d("moved", segment.numLive));
+        }
+
+        ::unlink(segment.path.c_str());
+        ::close(segment.fd);
+        m_segments.erase(oldest);
+    }
+}
+
+bool SegmentedLogMessageStorage::syncLocked() {
+    if (m_numSynced == m_numAppended || m_segments.empty()) {
+        return true;
+    }
+    if (::fdatasync(m_segments.rbegin()->second.fd) != 0) {
+        ACSDK_ERROR(LX("syncFailed").d("error", std::strerror(errno)));
+        return false;
+    }
+    m_numSynced = m_numAppended;
+    m_syncTrigger.notify_all();
+    return true;
+}
+
+bool SegmentedLogMessageStorage::waitForSyncLocked(std::unique_lock<std::mutex>& lock) {
+    auto numToSync = m_numAppended;
+    while (m_numSynced < numToSync) {
+        if (m_isSyncing) {
+            // Records appended while a sync is in progress may have missed it, so wait for it, then check again.
+            m_syncTrigger.wait(lock);
+            continue;
+        }
+        if (m_segments.empty()) {
+            return false;
+        }
+
+        m_isSyncing = true;
+        if (m_groupCommitInterval > std::chrono::milliseconds::zero()) {
+            lock.unlock();
+            std::this_thread::sleep_for(m_groupCommitInterval);
+            lock.lock();
+        }
+        // Every record up to here is in the active segment, or in one synced when it stopped being active.  The
+        // descriptor is duplicated so that the segment can be closed by a compaction while it is synced.
+        auto numSyncing = m_numAppended;
+        int fd = ::dup(m_segments.rbegin()->second.fd);
+        lock.unlock();
+        bool synced = fd >= 0 && 0 == ::fdatasync(fd);
+        auto error = errno;
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        lock.lock();
+        m_isSyncing = false;
+        if (synced) {
+            m_numSynced = std::max(m_numSynced, numSyncing);
+        }
+        m_syncTrigger.notify_all();
+        if (!synced) {
+            ACSDK_ERROR(LX("syncFailed").d("error", std::strerror(error)));
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace certifiedSender
+}  // namespace alexaClientSDK
@@ -0,0 +1,462 @@
+/*
+ * SegmentedLogMessageStorageTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <CertifiedSender/SQLiteMessageStorage.h>
+#include <CertifiedSender/SegmentedLogMessageStorage.h>
+
+#include <AVSCommon/Utils/File/FileUtils.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace alexaClientSDK {
+namespace certifiedSender {
+namespace test {
+
+using namespace avsCommon::utils::file;
+
+/// The directory the tests create their logs in, set from the command line.
+static std::string g_testDirectory;
+/// The name of the log the tests create.
+static const std::string TEST_LOG_NAME = "segmentedLogMessageStorageTestLog";
+/// The name of the SQLite database the benchmark creates.
+static const std::string TEST_SQLITE_DATABASE_NAME = "segmentedLogMessageStorageTestDatabase.db";
+/// The name of the single segment of a log which has not rolled over.
+static const std::string FIRST_SEGMENT_NAME = "segment-0000000001.log";
+/// The path delimiter used by the OS to identify file locations.
+static const std::string PATH_DELIMITER = "/";
+/// A test message text.
+static const std::string TEST_MESSAGE_ONE = "test_message_one";
+/// A test message text.
+static const std::string TEST_MESSAGE_TWO = "test_message_two";
+/// A test message text.
+static const std::string TEST_MESSAGE_THREE = "test_message_three";
+/// A segment size small enough that every record starts a new segment.
+static const size_t TINY_SEGMENT_SIZE = 16;
+/// A segment size which holds a few dozen records.
+static const size_t SMALL_SEGMENT_SIZE = 1024;
+/// The number of messages the segment tests store.
+static const int NUM_SEGMENT_TEST_MESSAGES = 100;
+/// The group commit interval tested.
+static const std::chrono::milliseconds GROUP_COMMIT_INTERVAL(20);
+/// The group commit interval benchmarked.
+static const std::chrono::milliseconds BENCHMARK_GROUP_COMMIT_INTERVAL(1);
+/// The number of threads storing messages at once in the group commit test and benchmark.
+static const int NUM_STORING_THREADS = 4;
+/// The number of messages the benchmark stores and erases.
+static const int NUM_BENCHMARK_MESSAGES = 2000;
+/// The size of the messages the benchmark stores, about that of a typical event.
+static const size_t BENCHMARK_MESSAGE_SIZE = 1024;
+
+/// The messages expected in a log, in order, as (id, message) pairs.
+using Messages = std::vector<std::pair<int, std::string>>;
+
+/**
+ * Remove a directory and the files in it, if it exists.
+ *
+ * @param path The directory.
+ */
+static void removeDirectory(const std::string& path) {
+    DIR* dir = opendir(path.c_str());
+    if (!dir) {
+        std::remove(path.c_str());
+        return;
+    }
+    while (auto entry = readdir(dir)) {
+        std::string name = entry->d_name;
+        if (name != "." && name != "..") {
+            std::remove((path + PATH_DELIMITER + name).c_str());
+        }
+    }
+    closedir(dir);
+    rmdir(path.c_str());
+}
+
+/**
+ * Get the size of a file.
+ *
+ * @param path The file.
+ * @return The size of the file, or -1 if it does not exist.
+ */
+static off_t getFileSize(const std::string& path) {
+    struct stat status;
+    return stat(path.c_str(), &status) == 0 ? status.st_size : -1;
+}
+
+/**
+ * Load the messages in a log.
+ *
+ * @param storage The storage to load from.
+ * @return The messages, as (id, message) pairs.
+ */
+static Messages loadMessages(MessageStorageInterface* storage) {
+    std::queue<MessageStorageInterface::StoredMessage> stored;
+    EXPECT_TRUE(storage->load(&stored));
+    Messages messages;
+    while (!stored.empty()) {
+        messages.emplace_back(stored.front().id, stored.front().message);
+        stored.pop();
+    }
+    return messages;
+}
+
+/**
+ * A class which helps drive this unit test suite.
+ */
+class SegmentedLogMessageStorageTest : public ::testing::Test {
+public:
+    /// Set up the test harness for running a test.
+    void SetUp() override;
+
+    /// Remove what the test created.
+    void TearDown() override;
+
+protected:
+    /**
+     * Store a message, expecting it to succeed.
+     *
+     * @param storage The storage to store in.
+     * @param message The message.
+     * @return The id of the message.
+     */
+    int store(MessageStorageInterface* storage, const std::string& message);
+
+    /// The path of the log.
+    std::string m_logPath;
+
+    /// The storage under test.
+    std::unique_ptr<SegmentedLogMessageStorage> m_storage;
+};
+
+void SegmentedLogMessageStorageTest::SetUp() {
+    // ctest runs each test in its own process, possibly at the same time, so each gets its own log.
+    m_logPath = g_testDirectory + PATH_DELIMITER + TEST_LOG_NAME + std::to_string(getpid());
+    removeDirectory(m_logPath);
+    m_storage.reset(new SegmentedLogMessageStorage());
+}
+
+void SegmentedLogMessageStorageTest::TearDown() {
+    m_storage.reset();
+    removeDirectory(m_logPath);
+}
+
+int SegmentedLogMessageStorageTest::store(MessageStorageInterface* storage, const std::string& message) {
+    int id = 0;
+    EXPECT_TRUE(storage->store(message, &id));
+    return id;
+}
+
+/**
+ * Verify that a log can only be created where nothing exists, and only opened where it does.
+ */
+TEST_F(SegmentedLogMessageStorageTest, createAndOpen) {
+    EXPECT_FALSE(m_storage->isOpen());
+    EXPECT_FALSE(m_storage->open(m_logPath));
+    ASSERT_TRUE(m_storage->createDatabase(m_logPath));
+    EXPECT_TRUE(m_storage->isOpen());
+    EXPECT_FALSE(m_storage->createDatabase(m_logPath));
+    m_storage->close();
+    EXPECT_FALSE(m_storage->isOpen());
+    EXPECT_FALSE(m_storage->createDatabase(m_logPath));
+    ASSERT_TRUE(m_storage->open(m_logPath));
+    EXPECT_TRUE(m_storage->isOpen());
+    EXPECT_FALSE(m_storage->open(m_logPath));
+}
+
+/**
+ * Verify that messages are loaded in the order they were stored, with increasing ids, and that erased messages and
+ * cleared logs stay that way across a reopen.
+ */
+TEST_F(SegmentedLogMessageStorageTest, storeLoadEraseAndClear) {
+    ASSERT_TRUE(m_storage->createDatabase(m_logPath));
+    EXPECT_TRUE(loadMessages(m_storage.get()).empty());
+
+    EXPECT_EQ(store(m_storage.get(), TEST_MESSAGE_ONE), 1);
+    EXPECT_EQ(store(m_storage.get(), TEST_MESSAGE_TWO), 2);
+    EXPECT_EQ(store(m_storage.get(), TEST_MESSAGE_THREE), 3);
+    EXPECT_EQ(
+        loadMessages(m_storage.get()),
+        (Messages{{1, TEST_MESSAGE_ONE}, {2, TEST_MESSAGE_TWO}, {3, TEST_MESSAGE_THREE}}));
+
+    EXPECT_TRUE(m_storage->erase(1));
+    EXPECT_TRUE(m_storage->erase(1));
+    m_storage->close();
+    ASSERT_TRUE(m_storage->open(m_logPath));
+    EXPECT_EQ(loadMessages(m_storage.get()), (Messages{{2, TEST_MESSAGE_TWO}, {3, TEST_MESSAGE_THREE}}));
+    EXPECT_EQ(store(m_storage.get(), TEST_MESSAGE_ONE), 4);
+
+    EXPECT_TRUE(m_storage->clearDatabase());
+    EXPECT_TRUE(loadMessages(m_storage.get()).empty());
+    m_storage->close();
+    ASSERT_TRUE(m_storage->open(m_logPath));
+    EXPECT_TRUE(loadMessages(m_storage.get()).empty());
+}
+
+/**
+ * Verify that the log rolls over to new segments, and that segments are deleted once their messages are erased.
+ */
+TEST_F(SegmentedLogMessageStorageTest, segmentsAreDeletedWhenErased) {
+    m_storage.reset(new SegmentedLogMessageStorage(SMALL_SEGMENT_SIZE));
+    ASSERT_TRUE(m_storage->createDatabase(m_logPath));
+    std::vector<int> ids;
+    for (int i = 0; i < NUM_SEGMENT_TEST_MESSAGES; ++i) {
+        ids.push_back(store(m_storage.get(), TEST_MESSAGE_ONE + std::to_string(i)));
+    }
+    EXPECT_GT(m_storage->getNumSegments(), 2u);
+
+    for (auto id : ids) {
+        EXPECT_TRUE(m_storage->erase(id));
+    }
+    EXPECT_EQ(m_storage->getNumSegments(), 1u);
+    m_storage->close();
+    ASSERT_TRUE(m_storage->open(m_logPath));
+    EXPECT_TRUE(loadMessages(m_storage.get()).empty());
+    EXPECT_EQ(store(m_storage.get(), TEST_MESSAGE_ONE), NUM_SEGMENT_TEST_MESSAGES + 1);
+}
+
+/**
+ * Verify that a message which is never erased is copied forward rather than keeping its old segments alive.
+ */
+TEST_F(SegmentedLogMessageStorageTest, sparseSegmentsAreCompacted) {
+    m_storage.reset(new SegmentedLogMessageStorage(SMALL_SEGMENT_SIZE));
+    ASSERT_TRUE(m_storage->createDatabase(m_logPath));
+    auto keptId = store(m_storage.get(), TEST_MESSAGE_ONE);
+    for (int i = 0; i < NUM_SEGMENT_TEST_MESSAGES; ++i) {
+        EXPECT_TRUE(m_storage->erase(store(m_storage.get(), TEST_MESSAGE_TWO)));
+    }
+    EXPECT_LE(m_storage->getNumSegments(), 2u);
+    EXPECT_EQ(loadMessages(m_storage.get()), (Messages{{keptId, TEST_MESSAGE_ONE}}));
+
+    m_storage->close();
+    ASSERT_TRUE(m_storage->open(m_logPath));
+    EXPECT_EQ(loadMessages(m_storage.get()), (Messages{{keptId, TEST_MESSAGE_ONE}}));
+}
+
+/**
+ * Verify that each record going to its own segment works, including reopening such a log.
+ */
+TEST_F(SegmentedLogMessageStorageTest, recordPerSegment) {
+    m_storage.reset(new SegmentedLogMessageStorage(TINY_SEGMENT_SIZE));
+    ASSERT_TRUE(m_storage->createDatabase(m_logPath));
+    store(m_storage.get(), TEST_MESSAGE_ONE);
+    auto id = store(m_storage.get(), TEST_MESSAGE_TWO);
+    store(m_storage.get(), TEST_MESSAGE_THREE);
+    EXPECT_TRUE(m_storage->erase(id));
+    m_storage->close();
+    ASSERT_TRUE(m_storage->open(m_logPath));
+    EXPECT_EQ(loadMessages(m_storage.get()), (Messages{{1, TEST_MESSAGE_ONE}, {3, TEST_MESSAGE_THREE}}));
+}
+
+/**
+ * Verify that a log cut short at any byte, as by a crash part way through a write, opens with exactly the records
+ * which were completely written, is truncated to them, and carries on working.
+ */
+TEST_F(SegmentedLogMessageStorageTest, recoversFromTruncationAtEveryOffset) {
+    auto segmentPath = m_logPath + PATH_DELIMITER + FIRST_SEGMENT_NAME;
+    ASSERT_TRUE(m_storage->createDatabase(m_logPath));
+
+    // The messages expected for each size of the segment after an operation, covering every type of record.
+    std::vector<std::pair<off_t, Messages>> checkpoints;
+    Messages expected;
+    checkpoints.emplace_back(getFileSize(segmentPath), expected);
+    auto checkpoint = [&] { checkpoints.emplace_back(getFileSize(segmentPath), expected); };
+
+    auto id = store(m_storage.get(), TEST_MESSAGE_ONE);
+    expected.emplace_back(id, TEST_MESSAGE_ONE);
+    checkpoint();
+    id = store(m_storage.get(), TEST_MESSAGE_TWO);
+    expected.emplace_back(id, TEST_MESSAGE_TWO);
+    checkpoint();
+    ASSERT_TRUE(m_storage->erase(expected.front().first));
+    expected.erase(expected.begin());
+    checkpoint();
+    id = store(m_storage.get(), "");
+    expected.emplace_back(id, "");
+    checkpoint();
+    ASSERT_TRUE(m_storage->clearDatabase());
+    expected.clear();
+    checkpoint();
+    id = store(m_storage.get(), TEST_MESSAGE_THREE);
+    expected.emplace_back(id, TEST_MESSAGE_THREE);
+    checkpoint();
+    m_storage->close();
+    ASSERT_EQ(m_storage->getNumSegments(), 0u);
+
+    std::ifstream segmentFile(segmentPath, std::ios::binary);
+    std::vector<char> contents((std::istreambuf_iterator<char>(segmentFile)), std::istreambuf_iterator<char>());
+    ASSERT_EQ(static_cast<off_t>(contents.size()), checkpoints.back().first);
+
+    for (size_t size = 0; size <= contents.size(); ++size) {
+        SCOPED_TRACE("size " + std::to_string(size));
+        removeDirectory(m_logPath);
+        ASSERT_EQ(mkdir(m_logPath.c_str(), 0700), 0);
+        {
+            std::ofstream truncated(segmentPath, std::ios::binary);
+            truncated.write(contents.data(), size);
+        }
+
+        auto last = checkpoints.begin();
+        for (auto it = checkpoints.begin(); it != checkpoints.end() && it->first <= static_cast<off_t>(size); ++it) {
+            last = it;
+        }
+
+        SegmentedLogMessageStorage recovered;
+        ASSERT_TRUE(recovered.open(m_logPath));
+        auto messages = loadMessages(&recovered);
+        EXPECT_EQ(messages, last->second);
+        EXPECT_EQ(getFileSize(segmentPath), last->first);
+
+        auto newId = store(&recovered, TEST_MESSAGE_ONE);
+        for (auto& message : messages) {
+            EXPECT_GT(newId, message.first);
+        }
+        recovered.close();
+        ASSERT_TRUE(recovered.open(m_logPath));
+        messages.emplace_back(newId, TEST_MESSAGE_ONE);
+        EXPECT_EQ(loadMessages(&recovered), messages);
+    }
+}
+
+/**
+ * Verify that a record whose checksum does not match is discarded, along with the rest of its segment.
+ */
+TEST_F(SegmentedLogMessageStorageTest, corruptRecordIsDiscarded) {
+    auto segmentPath = m_logPath + PATH_DELIMITER + FIRST_SEGMENT_NAME;
+    ASSERT_TRUE(m_storage->createDatabase(m_logPath));
+    store(m_storage.get(), TEST_MESSAGE_ONE);
+    auto corruptOffset = getFileSize(segmentPath) + 1;
+    store(m_storage.get(), TEST_MESSAGE_TWO);
+    store(m_storage.get(), TEST_MESSAGE_THREE);
+    m_storage->close();
+
+    {
+        std::fstream segmentFile(segmentPath, std::ios::binary | std::ios::in | std::ios::out);
+        segmentFile.seekp(corruptOffset);
+        segmentFile.put('\xff');
+    }
+
+    ASSERT_TRUE(m_storage->open(m_logPath));
+    EXPECT_EQ(loadMessages(m_storage.get()), (Messages{{1, TEST_MESSAGE_ONE}}));
+    EXPECT_EQ(store(m_storage.get(), TEST_MESSAGE_TWO), 2);
+}
+
+/**
+ * Verify that with a group commit interval, messages stored from several threads at once each get their own id, and
+ * that they are all there after a reopen.
+ */
+TEST_F(SegmentedLogMessageStorageTest, groupCommit) {
+    m_storage.reset(new SegmentedLogMessageStorage(SMALL_SEGMENT_SIZE, GROUP_COMMIT_INTERVAL));
+    ASSERT_TRUE(m_storage->createDatabase(m_logPath));
+    std::mutex mutex;
+    Messages expected;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < NUM_STORING_THREADS; ++t) {
+        threads.emplace_back([this, t, &mutex, &expected]() {
+            for (int i = 0; i < NUM_SEGMENT_TEST_MESSAGES / NUM_STORING_THREADS; ++i) {
+                auto message = TEST_MESSAGE_ONE + std::to_string(t) + "_" + std::to_string(i);
+                auto id = store(m_storage.get(), message);
+                std::lock_guard<std::mutex> lock(mutex);
+                expected.emplace_back(id, message);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    std::sort(expected.begin(), expected.end());
+    m_storage->close();
+    ASSERT_TRUE(m_storage->open(m_logPath));
+    EXPECT_EQ(loadMessages(m_storage.get()), expected);
+}
+
+/**
+ * Compare the throughput of this storage with @c SQLiteMessageStorage for the store, send, erase cycle of
+ * @c CertifiedSender.  Disabled by default, as it measures the disk more than the code; run it with
+ * --gtest_also_run_disabled_tests.
+ */
+TEST_F(SegmentedLogMessageStorageTest, DISABLED_throughputComparedWithSQLite) {
+    auto sqlitePath = g_testDirectory + PATH_DELIMITER + std::to_string(getpid()) + TEST_SQLITE_DATABASE_NAME;
+    std::remove(sqlitePath.c_str());
+    std::string message(BENCHMARK_MESSAGE_SIZE, 'x');
+
+    auto measure = [&message](MessageStorageInterface* storage, int numThreads) {
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        for (int t = 0; t < numThreads; ++t) {
+            threads.emplace_back([storage, numThreads, &message]() {
+                for (int i = 0; i < NUM_BENCHMARK_MESSAGES / numThreads; ++i) {
+                    int id = 0;
+                    EXPECT_TRUE(storage->store(message, &id));
+                    EXPECT_TRUE(storage->erase(id));
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        return NUM_BENCHMARK_MESSAGES / std::chrono::duration<double>(elapsed).count();
+    };
+
+    SQLiteMessageStorage sqlite;
+    ASSERT_TRUE(sqlite.createDatabase(sqlitePath));
+    auto sqliteRate = measure(&sqlite, 1);
+    sqlite.close();
+    std::remove(sqlitePath.c_str());
+    std::cout << "Messages stored and erased per second: SQLite " << sqliteRate << std::endl;
+
+    for (auto interval : {std::chrono::milliseconds::zero(), BENCHMARK_GROUP_COMMIT_INTERVAL}) {
+        for (int numThreads : {1, NUM_STORING_THREADS}) {
+            SegmentedLogMessageStorage storage(SegmentedLogMessageStorage::DEFAULT_SEGMENT_SIZE_IN_BYTES, interval);
+            ASSERT_TRUE(storage.createDatabase(m_logPath));
+            auto rate = measure(&storage, numThreads);
+            storage.close();
+            removeDirectory(m_logPath);
+            std::cout << "  segmented log, group commit interval " << interval.count() << "ms, " << numThreads
+                      << " thread(s): " << rate << std::endl;
+        }
+    }
+}
+
+}  // namespace test
+}  // namespace certifiedSender
+}  // namespace alexaClientSDK
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    if (argc < 2) {
+        std::cerr << "USAGE: " << std::string(argv[0]) << " <path_to_test_directory_location>" << std::endl;
+        return 1;
+    }
+    alexaClientSDK::certifiedSender::test::g_testDirectory = argv[1];
+    return RUN_ALL_TESTS();
+}
@@ -195,7 +195,10 @@ private:
     /// Mutex to manage the writes and reads to and from the @c m_contextRequesterQueue.
     std::mutex m_contextRequesterMutex;
 
-    /// Thread to request the state updates and request for building the context once the states are available.
+    /**
+     * Thread to request the state updates and request for building the context once the states are available.  This
+     * is a thread of its own rather than a pooled @c Executor, as it blocks until state providers respond.
+     */
     std::thread m_updateStatesThread;
 
     /**
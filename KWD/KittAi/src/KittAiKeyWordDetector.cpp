@@ -19,6 +19,7 @@
 
 #include <AVSCommon/Utils/Logger/Logger.h>
 #include <AVSCommon/Utils/Memory/Memory.h>
+#include <AVSCommon/Utils/Threading/ThreadName.h>
 
 #include "KittAi/KittAiKeyWordDetector.h"
 
@@ -42,8 +43,8 @@ static const std::string TAG("KittAiKeyWordDetector");
 /// The number of hertz per kilohertz.
 static const size_t HERTZ_PER_KILOHERTZ = 1000;
 
-/// The timeout to use for read calls to the SharedDataStream.
-const std::chrono::milliseconds TIMEOUT_FOR_READ_CALLS = std::chrono::milliseconds(1000);
+/// The timeout to use for read calls to the SharedDataStream.  Zero waits for audio for as long as it takes.
+const std::chrono::milliseconds TIMEOUT_FOR_READ_CALLS = std::chrono::milliseconds::zero();
 
 /// The delimiter for Kitt.ai engine constructor parameters
 static const std::string KITT_DELIMITER = ",";
@@ -103,6 +104,10 @@ std::unique_ptr<KittAiKeyWordDetector> KittAiKeyWordDetector::create(
 
 KittAiKeyWordDetector::~KittAiKeyWordDetector() {
     m_isShuttingDown = true;
+    if (m_streamReader) {
+        // Wake the detection loop if it is blocked reading, as its reads never time out.
+        m_streamReader->close();
+    }
     if (m_detectionThread.joinable()) {
         m_detectionThread.join();
     }
@@ -147,6 +152,8 @@ bool KittAiKeyWordDetector::init(avsCommon::utils::AudioFormat audioFormat) {
         ACSDK_ERROR(LX("initFailed").d("reason", "createStreamReaderFailed"));
         return false;
     }
+    // Only wake the detection loop once a full push worth of samples is available.
+    m_streamReader->setWakeThreshold(m_maxSamplesPerPush);
     m_isShuttingDown = false;
     m_detectionThread = std::thread(&KittAiKeyWordDetector::detectionLoop, this);
     return true;
@@ -192,6 +199,7 @@ bool KittAiKeyWordDetector::isAudioFormatCompatibleWithKittAi(avsCommon::utils::
 }
 
 void KittAiKeyWordDetector::detectionLoop() {
+    avsCommon::utils::threading::setThreadName("KittAiKWD");
     notifyKeyWordDetectorStateObservers(KeyWordDetectorStateObserverInterface::KeyWordDetectorState::ACTIVE);
     int16_t audioDataToPush[m_maxSamplesPerPush];
     ssize_t wordsRead;
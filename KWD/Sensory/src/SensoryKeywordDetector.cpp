@@ -18,6 +18,7 @@
 #include <memory>
 
 #include <AVSCommon/Utils/Logger/Logger.h>
+#include <AVSCommon/Utils/Threading/ThreadName.h>
 
 #include "Sensory/SensoryKeywordDetector.h"
 
@@ -39,8 +40,8 @@ static const std::string TAG("SensoryKeywordDetector");
 /// The number of hertz per kilohertz.
 static const size_t HERTZ_PER_KILOHERTZ = 1000;
 
-/// The timeout to use for read calls to the SharedDataStream.
-const std::chrono::milliseconds TIMEOUT_FOR_READ_CALLS = std::chrono::milliseconds(1000);
+/// The timeout to use for read calls to the SharedDataStream, where zero means no timeout.
+const std::chrono::milliseconds TIMEOUT_FOR_READ_CALLS = std::chrono::milliseconds::zero();
 
 /// The Sensory compatible AVS sample rate of 16 kHz.
 static const unsigned int SENSORY_COMPATIBLE_SAMPLE_RATE = 16000;
@@ -197,6 +198,10 @@ std::unique_ptr<SensoryKeywordDetector> SensoryKeywordDetector::create(
 
 SensoryKeywordDetector::~SensoryKeywordDetector() {
     m_isShuttingDown = true;
+    if (m_streamReader) {
+        // Wake the detection loop if it is blocked reading, as its reads never time out.
+        m_streamReader->close();
+    }
     if (m_detectionThread.joinable()) {
         m_detectionThread.join();
     }
@@ -221,6 +226,8 @@ bool SensoryKeywordDetector::init(const std::string& modelFilePath) {
         ACSDK_ERROR(LX("initFailed").d("reason", "createStreamReaderFailed"));
         return false;
     }
+    // Only wake the detection loop once a full push worth of samples is available.
+    m_streamReader->setWakeThreshold(m_maxSamplesPerPush);
 
     // Allocate the Sensory library handle
     SnsrRC result = snsrNew(&m_session);
@@ -308,6 +315,7 @@ bool SensoryKeywordDetector::setUpRuntimeSettings(SnsrSession* session) {
 }
 
 void SensoryKeywordDetector::detectionLoop() {
+    avsCommon::utils::threading::setThreadName("SensoryKWD");
     m_beginIndexOfStreamReader = m_streamReader->tell();
     notifyKeyWordDetectorStateObservers(KeyWordDetectorStateObserverInterface::KeyWordDetectorState::ACTIVE);
     std::vector<int16_t> audioDataToPush(m_maxSamplesPerPush);
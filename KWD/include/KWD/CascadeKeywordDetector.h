@@ -0,0 +1,206 @@
+/*
+ * CascadeKeywordDetector.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_KWD_INCLUDE_KWD_CASCADEKEYWORDDETECTOR_H_
+#define ALEXA_CLIENT_SDK_KWD_INCLUDE_KWD_CASCADEKEYWORDDETECTOR_H_
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include <AVSCommon/Utils/AudioFormat.h>
+#include <AVSCommon/AVS/AudioInputStream.h>
+#include <AVSCommon/SDKInterfaces/KeyWordObserverInterface.h>
+#include <AVSCommon/SDKInterfaces/KeyWordDetectorStateObserverInterface.h>
+
+#include "KWD/AbstractKeywordDetector.h"
+
+namespace alexaClientSDK {
+namespace kwd {
+
+/**
+ * A keyword detector which runs two engines in cascade. A low cost spotter is fed every frame of audio and flags
+ * candidate detections. Only when the spotter flags a candidate is the more expensive verifier run, over a window of
+ * audio which ends at the candidate and is re-read from the same @c AudioInputStream by a second reader seeked back
+ * relative to the writer. Keyword observers are only notified of candidates which the verifier confirms.
+ *
+ * Audio must be LPCM encoded with 16 bits per sample in the native endianness of the platform.
+ */
+class CascadeKeywordDetector : public AbstractKeywordDetector {
+public:
+    /// The first stage engine, which is run on every frame of audio.
+    class SpotterInterface {
+    public:
+        /**
+         * Destructor.
+         */
+        virtual ~SpotterInterface() = default;
+
+        /**
+         * Processes the next frame of audio.
+         *
+         * @param samples The audio samples, which directly follow those of the previous call.
+         * @param numSamples The number of samples in @c samples.
+         * @return @c true if a keyword candidate ends within this frame, else @c false.
+         */
+        virtual bool process(const int16_t* samples, size_t numSamples) = 0;
+
+        /**
+         * Resets any state of the engine. This is called after each candidate, whether or not it was verified, and
+         * whenever samples have been dropped from the stream.
+         */
+        virtual void reset() {
+        }
+    };
+
+    /// The second stage engine, which is only run over the audio preceding a candidate.
+    class VerifierInterface {
+    public:
+        /**
+         * Destructor.
+         */
+        virtual ~VerifierInterface() = default;
+
+        /**
+         * Verifies whether a keyword is present in a window of audio.
+         *
+         * @param samples The audio samples of the window, ending at the end of the candidate frame.
+         * @param numSamples The number of samples in @c samples.
+         * @param [out] keyword The keyword which was verified.
+         * @param [out] beginOffset The offset of the first sample of the keyword within @c samples, or
+         * @c KeyWordObserverInterface::UNSPECIFIED_INDEX if unknown.
+         * @param [out] endOffset The offset of the last sample of the keyword within @c samples, or
+         * @c KeyWordObserverInterface::UNSPECIFIED_INDEX to use the end of the window.
+         * @return @c true if the keyword was verified, else @c false.
+         */
+        virtual bool verify(
+            const int16_t* samples,
+            size_t numSamples,
+            std::string* keyword,
+            avsCommon::avs::AudioInputStream::Index* beginOffset,
+            avsCommon::avs::AudioInputStream::Index* endOffset) = 0;
+    };
+
+    /**
+     * Creates a @c CascadeKeywordDetector.
+     *
+     * @param stream The stream of audio data. This should be formatted in LPCM encoded with 16 bits per sample.
+     * @param audioFormat The format of the audio data located within the stream.
+     * @param keyWordObservers The observers to notify of keyword detections.
+     * @param keyWordDetectorStateObservers The observers to notify of state changes in the engine.
+     * @param spotter The first stage engine.
+     * @param verifier The second stage engine.
+     * @param verificationWindow The amount of audio preceding a candidate to pass to the verifier. This is limited to
+     * the amount of audio still held by @c stream.
+     * @param msToPushPerIteration The amount of data in milliseconds to push to the spotter at a time.
+     * @return A new @c CascadeKeywordDetector, or @c nullptr if the operation failed.
+     */
+    static std::unique_ptr<CascadeKeywordDetector> create(
+        std::shared_ptr<avsCommon::avs::AudioInputStream> stream,
+        avsCommon::utils::AudioFormat audioFormat,
+        std::unordered_set<std::shared_ptr<avsCommon::sdkInterfaces::KeyWordObserverInterface>> keyWordObservers,
+        std::unordered_set<std::shared_ptr<avsCommon::sdkInterfaces::KeyWordDetectorStateObserverInterface>>
+            keyWordDetectorStateObservers,
+        std::shared_ptr<SpotterInterface> spotter,
+        std::shared_ptr<VerifierInterface> verifier,
+        std::chrono::milliseconds verificationWindow = std::chrono::milliseconds(2000),
+        std::chrono::milliseconds msToPushPerIteration = std::chrono::milliseconds(20));
+
+    /**
+     * Destructor.
+     */
+    ~CascadeKeywordDetector() override;
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param stream The stream of audio data.
+     * @param audioFormat The format of the audio data located within the stream.
+     * @param keyWordObservers The observers to notify of keyword detections.
+     * @param keyWordDetectorStateObservers The observers to notify of state changes in the engine.
+     * @param spotter The first stage engine.
+     * @param verifier The second stage engine.
+     * @param verificationWindow The amount of audio preceding a candidate to pass to the verifier.
+     * @param msToPushPerIteration The amount of data in milliseconds to push to the spotter at a time.
+     */
+    CascadeKeywordDetector(
+        std::shared_ptr<avsCommon::avs::AudioInputStream> stream,
+        avsCommon::utils::AudioFormat audioFormat,
+        std::unordered_set<std::shared_ptr<avsCommon::sdkInterfaces::KeyWordObserverInterface>> keyWordObservers,
+        std::unordered_set<std::shared_ptr<avsCommon::sdkInterfaces::KeyWordDetectorStateObserverInterface>>
+            keyWordDetectorStateObservers,
+        std::shared_ptr<SpotterInterface> spotter,
+        std::shared_ptr<VerifierInterface> verifier,
+        std::chrono::milliseconds verificationWindow,
+        std::chrono::milliseconds msToPushPerIteration);
+
+    /**
+     * Initializes the stream reader and kicks off a thread to read data from the stream. This function should only be
+     * called once with each new @c CascadeKeywordDetector.
+     *
+     * @return @c true if the detector was initialized properly and @c false otherwise.
+     */
+    bool init();
+
+    /// The main function that reads data and feeds it into the spotter.
+    void detectionLoop();
+
+    /**
+     * Re-reads the audio preceding a candidate with a second reader and runs the verifier over it, notifying keyword
+     * observers if the candidate is verified.
+     *
+     * @param candidateEndIndex The absolute index just past the last sample of the candidate frame.
+     */
+    void verifyCandidate(avsCommon::avs::AudioInputStream::Index candidateEndIndex);
+
+    /// Indicates whether the internal main loop should keep running.
+    std::atomic<bool> m_isShuttingDown;
+
+    /// The stream of audio data.
+    const std::shared_ptr<avsCommon::avs::AudioInputStream> m_stream;
+
+    /// The reader that will be used to feed audio data to the spotter.
+    std::shared_ptr<avsCommon::avs::AudioInputStream::Reader> m_streamReader;
+
+    /// The first stage engine.
+    std::shared_ptr<SpotterInterface> m_spotter;
+
+    /// The second stage engine.
+    std::shared_ptr<VerifierInterface> m_verifier;
+
+    /// The max number of samples to push into the spotter per iteration.
+    const size_t m_maxSamplesPerPush;
+
+    /// The number of samples preceding a candidate to pass to the verifier.
+    const size_t m_verificationWindowSamples;
+
+    /// Buffer into which the verification window is read. Only accessed from @c m_detectionThread.
+    std::vector<int16_t> m_verificationBuffer;
+
+    /// Internal thread that reads audio from the buffer and feeds it to the engines.
+    std::thread m_detectionThread;
+};
+
+}  // namespace kwd
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_KWD_INCLUDE_KWD_CASCADEKEYWORDDETECTOR_H_
@@ -16,6 +16,7 @@
  */
 
 #include <AVSCommon/Utils/Logger/Logger.h>
+#include <AVSCommon/Utils/Metrics.h>
 
 #include "KWD/AbstractKeywordDetector.h"
 
@@ -71,6 +72,17 @@ void AbstractKeywordDetector::notifyKeyWordObservers(
     std::string keyword,
     AudioInputStream::Index beginIndex,
     AudioInputStream::Index endIndex) const {
+    auto timestampTrack = stream ? stream->getTimestampTrack() : nullptr;
+    avsCommon::utils::timing::Clock::SteadyTimePoint endTime;
+    if (timestampTrack && KeyWordObserverInterface::UNSPECIFIED_INDEX != endIndex &&
+        timestampTrack->getTime(endIndex, &endTime)) {
+        ACSDK_METRIC_CAPTURE_LATENCY(
+            TAG,
+            keyword,
+            std::chrono::duration_cast<std::chrono::milliseconds>(timestampTrack->getClock()->steadyNow() - endTime),
+            avsCommon::utils::Metrics::Location::KWD_DETECT);
+    }
+
     std::lock_guard<std::mutex> lock(m_keyWordObserversMutex);
     for (auto keyWordObserver : m_keyWordObservers) {
         keyWordObserver->onKeyWordDetected(stream, keyword, beginIndex, endIndex);
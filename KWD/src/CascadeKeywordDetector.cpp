@@ -0,0 +1,250 @@
+/*
+ * CascadeKeywordDetector.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+#include <AVSCommon/Utils/Threading/ThreadName.h>
+
+#include "KWD/CascadeKeywordDetector.h"
+
+namespace alexaClientSDK {
+namespace kwd {
+
+using namespace avsCommon;
+using namespace avsCommon::avs;
+using namespace avsCommon::sdkInterfaces;
+using namespace avsCommon::utils;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("CascadeKeywordDetector");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The number of hertz per kilohertz.
+static const size_t HERTZ_PER_KILOHERTZ = 1000;
+
+/**
+ * The timeout to use for read calls to the SharedDataStream.  Zero blocks until audio arrives, so an idle detector
+ * never wakes; the destructor closes the reader to end a blocked read.
+ */
+static const std::chrono::milliseconds TIMEOUT_FOR_READ_CALLS = std::chrono::milliseconds::zero();
+
+/// The only sample size supported by the engines.
+static const unsigned int SUPPORTED_SAMPLE_SIZE_IN_BITS = 16;
+
+std::unique_ptr<CascadeKeywordDetector> CascadeKeywordDetector::create(
+    std::shared_ptr<AudioInputStream> stream,
+    AudioFormat audioFormat,
+    std::unordered_set<std::shared_ptr<KeyWordObserverInterface>> keyWordObservers,
+    std::unordered_set<std::shared_ptr<KeyWordDetectorStateObserverInterface>> keyWordDetectorStateObservers,
+    std::shared_ptr<SpotterInterface> spotter,
+    std::shared_ptr<VerifierInterface> verifier,
+    std::chrono::milliseconds verificationWindow,
+    std::chrono::milliseconds msToPushPerIteration) {
+    if (!stream) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "nullStream"));
+        return nullptr;
+    }
+    if (!spotter) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "nullSpotter"));
+        return nullptr;
+    }
+    if (!verifier) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "nullVerifier"));
+        return nullptr;
+    }
+    if (isByteswappingRequired(audioFormat)) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "endianMismatch"));
+        return nullptr;
+    }
+    if (audioFormat.encoding != AudioFormat::Encoding::LPCM ||
+        audioFormat.sampleSizeInBits != SUPPORTED_SAMPLE_SIZE_IN_BITS) {
+        ACSDK_ERROR(LX("createFailed")
+                        .d("reason", "unsupportedAudioFormat")
+                        .d("encoding", audioFormat.encoding)
+                        .d("sampleSizeInBits", audioFormat.sampleSizeInBits));
+        return nullptr;
+    }
+    if (stream->getWordSize() != sizeof(int16_t)) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "unsupportedWordSize").d("wordSize", stream->getWordSize()));
+        return nullptr;
+    }
+    if (msToPushPerIteration.count() <= 0 || verificationWindow < msToPushPerIteration) {
+        ACSDK_ERROR(LX("createFailed")
+                        .d("reason", "invalidDuration")
+                        .d("verificationWindowMs", verificationWindow.count())
+                        .d("msToPushPerIteration", msToPushPerIteration.count()));
+        return nullptr;
+    }
+    std::unique_ptr<CascadeKeywordDetector> detector(new CascadeKeywordDetector(
+        stream,
+        audioFormat,
+        keyWordObservers,
+        keyWordDetectorStateObservers,
+        spotter,
+        verifier,
+        verificationWindow,
+        msToPushPerIteration));
+    if (!detector->init()) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "initDetectorFailed"));
+        return nullptr;
+    }
+    return detector;
+}
+
+CascadeKeywordDetector::~CascadeKeywordDetector() {
+    m_isShuttingDown = true;
+    if (m_streamReader) {
+        // Wake the detection loop if it is blocked reading, as its reads never time out.
+        m_streamReader->close();
+    }
+    if (m_detectionThread.joinable()) {
+        m_detectionThread.join();
+    }
+}
+
+CascadeKeywordDetector::CascadeKeywordDetector(
+    std::shared_ptr<AudioInputStream> stream,
+    AudioFormat audioFormat,
+    std::unordered_set<std::shared_ptr<KeyWordObserverInterface>> keyWordObservers,
+    std::unordered_set<std::shared_ptr<KeyWordDetectorStateObserverInterface>> keyWordDetectorStateObservers,
+    std::shared_ptr<SpotterInterface> spotter,
+    std::shared_ptr<VerifierInterface> verifier,
+    std::chrono::milliseconds verificationWindow,
+    std::chrono::milliseconds msToPushPerIteration) :
+        AbstractKeywordDetector(keyWordObservers, keyWordDetectorStateObservers),
+        m_stream{stream},
+        m_spotter{spotter},
+        m_verifier{verifier},
+        m_maxSamplesPerPush{(audioFormat.sampleRateHz / HERTZ_PER_KILOHERTZ) * msToPushPerIteration.count()},
+        m_verificationWindowSamples{(audioFormat.sampleRateHz / HERTZ_PER_KILOHERTZ) * verificationWindow.count()} {
+}
+
+bool CascadeKeywordDetector::init() {
+    m_streamReader = m_stream->createReader(AudioInputStream::Reader::Policy::BLOCKING);
+    if (!m_streamReader) {
+        ACSDK_ERROR(LX("initFailed").d("reason", "createStreamReaderFailed"));
+        return false;
+    }
+    // Only wake the detection loop once a full push worth of samples is available.
+    m_streamReader->setWakeThreshold(m_maxSamplesPerPush);
+    m_verificationBuffer.resize(m_verificationWindowSamples);
+    m_isShuttingDown = false;
+    m_detectionThread = std::thread(&CascadeKeywordDetector::detectionLoop, this);
+    return true;
+}
+
+void CascadeKeywordDetector::detectionLoop() {
+    avsCommon::utils::threading::setThreadName("CascadeKWD");
+    notifyKeyWordDetectorStateObservers(KeyWordDetectorStateObserverInterface::KeyWordDetectorState::ACTIVE);
+    std::vector<int16_t> audioDataToPush(m_maxSamplesPerPush);
+    ssize_t wordsRead;
+    while (!m_isShuttingDown) {
+        bool didErrorOccur;
+        wordsRead = readFromStream(
+            m_streamReader,
+            m_stream,
+            audioDataToPush.data(),
+            m_maxSamplesPerPush,
+            TIMEOUT_FOR_READ_CALLS,
+            &didErrorOccur);
+        if (didErrorOccur) {
+            break;
+        } else if (AudioInputStream::Reader::Error::OVERRUN == wordsRead) {
+            // readFromStream() has moved the reader past the gap, so the spotter must not stitch across it.
+            m_spotter->reset();
+        } else if (wordsRead > 0) {
+            // Words were successfully read.
+            notifyKeyWordDetectorStateObservers(KeyWordDetectorStateObserverInterface::KeyWordDetectorState::ACTIVE);
+            if (m_spotter->process(audioDataToPush.data(), wordsRead)) {
+                verifyCandidate(m_streamReader->tell());
+                m_spotter->reset();
+            }
+        }
+    }
+    m_streamReader->close();
+}
+
+void CascadeKeywordDetector::verifyCandidate(AudioInputStream::Index candidateEndIndex) {
+    // The verifier reader is only attached while verifying, so it never holds back a writer between candidates.
+    auto verifierReader = m_stream->createReader(AudioInputStream::Reader::Policy::NONBLOCKING, true);
+    if (!verifierReader) {
+        ACSDK_ERROR(LX("verifyCandidateFailed").d("reason", "createVerifierReaderFailed"));
+        return;
+    }
+
+    // Seek back relative to the writer so that the window ends at the candidate, without reaching past the start of
+    // the stream or into data which has already been overwritten.
+    auto distanceToWriter = m_streamReader->tell(AudioInputStream::Reader::Reference::BEFORE_WRITER);
+    auto offset = distanceToWriter + m_verificationWindowSamples;
+    offset = std::min(offset, candidateEndIndex + distanceToWriter);
+    offset = std::min(offset, m_stream->getDataSize());
+    if (!verifierReader->seek(offset, AudioInputStream::Reader::Reference::BEFORE_WRITER)) {
+        ACSDK_ERROR(LX("verifyCandidateFailed").d("reason", "seekFailed").d("offset", offset));
+        return;
+    }
+
+    // The writer may have moved on since distanceToWriter was sampled, so derive the window from where the reader
+    // actually landed.
+    auto windowBeginIndex = verifierReader->tell();
+    if (windowBeginIndex >= candidateEndIndex) {
+        ACSDK_ERROR(LX("verifyCandidateFailed")
+                        .d("reason", "windowOverwritten")
+                        .d("windowBeginIndex", windowBeginIndex)
+                        .d("candidateEndIndex", candidateEndIndex));
+        return;
+    }
+    size_t windowSamples = static_cast<size_t>(candidateEndIndex - windowBeginIndex);
+    size_t samplesRead = 0;
+    while (samplesRead < windowSamples) {
+        auto result = verifierReader->read(
+            m_verificationBuffer.data() + samplesRead, windowSamples - samplesRead, std::chrono::milliseconds::zero());
+        if (result <= 0) {
+            ACSDK_ERROR(LX("verifyCandidateFailed")
+                            .d("reason", "readFailed")
+                            .d("error", result)
+                            .d("samplesRead", samplesRead)
+                            .d("windowSamples", windowSamples));
+            return;
+        }
+        samplesRead += result;
+    }
+    verifierReader.reset();
+
+    std::string keyword;
+    AudioInputStream::Index beginOffset = KeyWordObserverInterface::UNSPECIFIED_INDEX;
+    AudioInputStream::Index endOffset = KeyWordObserverInterface::UNSPECIFIED_INDEX;
+    if (!m_verifier->verify(m_verificationBuffer.data(), windowSamples, &keyword, &beginOffset, &endOffset)) {
+        ACSDK_DEBUG9(LX("candidateRejected").d("candidateEndIndex", candidateEndIndex));
+        return;
+    }
+    auto beginIndex = KeyWordObserverInterface::UNSPECIFIED_INDEX == beginOffset
+                          ? KeyWordObserverInterface::UNSPECIFIED_INDEX
+                          : windowBeginIndex + beginOffset;
+    auto endIndex =
+        KeyWordObserverInterface::UNSPECIFIED_INDEX == endOffset ? candidateEndIndex : windowBeginIndex + endOffset;
+    notifyKeyWordObservers(m_stream, keyword, beginIndex, endIndex);
+}
+
+}  // namespace kwd
+}  // namespace alexaClientSDK
@@ -0,0 +1,461 @@
+/*
+ * CascadeKeywordDetectorTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <ctime>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <AVSCommon/Utils/AudioFormat.h>
+#include <AVSCommon/AVS/AudioInputStream.h>
+#include <AVSCommon/SDKInterfaces/KeyWordObserverInterface.h>
+
+#include "KWD/CascadeKeywordDetector.h"
+
+namespace alexaClientSDK {
+namespace kwd {
+namespace test {
+
+using namespace avsCommon::avs;
+using namespace avsCommon::sdkInterfaces;
+using namespace avsCommon::utils;
+
+/// The sample rate of the test audio.
+static const unsigned int SAMPLE_RATE_HZ = 16000;
+
+/// The number of samples in the stream buffer, 10 seconds of audio.
+static const size_t SDS_WORDS = SAMPLE_RATE_HZ * 10;
+
+/// The maximum number of readers of the stream.
+static const size_t SDS_MAX_READERS = 2;
+
+/// The verification window used by the tests, and the number of samples it spans.
+static const std::chrono::milliseconds VERIFICATION_WINDOW(2000);
+static const size_t VERIFICATION_WINDOW_SAMPLES = SAMPLE_RATE_HZ * 2;
+
+/// The number of samples pushed per iteration with the default of 20 milliseconds.
+static const size_t SAMPLES_PER_PUSH = SAMPLE_RATE_HZ / 1000 * 20;
+
+/// The value of samples which do not belong to a keyword.
+static const int16_t BACKGROUND_SAMPLE = 0;
+
+/// The value of samples which belong to a keyword.
+static const int16_t KEYWORD_SAMPLE = 1000;
+
+/// The value of the last sample of a keyword, which the spotter flags as a candidate.
+static const int16_t KEYWORD_END_SAMPLE = 2000;
+
+/// The keyword reported by the verifier.
+static const std::string KEYWORD = "ALEXA";
+
+/// Timeout when waiting for the detector.
+static const std::chrono::seconds TIMEOUT(2);
+
+/**
+ * Burns CPU in proportion to the amount of audio, standing in for the arithmetic of a real engine.
+ *
+ * @param samples The audio samples.
+ * @param numSamples The number of samples in @c samples.
+ * @param opsPerSample The number of operations to perform per sample.
+ */
+static void burnCpu(const int16_t* samples, size_t numSamples, unsigned int opsPerSample) {
+    static volatile int64_t sink;
+    int64_t accumulator = 0;
+    for (size_t i = 0; i < numSamples; ++i) {
+        for (unsigned int op = 0; op < opsPerSample; ++op) {
+            accumulator = accumulator * 31 + samples[i] + op;
+        }
+    }
+    sink = accumulator;
+}
+
+/// A spotter which flags a candidate when it sees the last sample of a keyword, and keeps track of its cost.
+class MockSpotter : public CascadeKeywordDetector::SpotterInterface {
+public:
+    /**
+     * Constructor.
+     *
+     * @param opsPerSample The number of operations to burn per sample processed.
+     */
+    MockSpotter(unsigned int opsPerSample = 0) : samplesProcessed{0}, m_opsPerSample{opsPerSample} {
+    }
+
+    bool process(const int16_t* samples, size_t numSamples) override {
+        burnCpu(samples, numSamples, m_opsPerSample);
+        samplesProcessed += numSamples;
+        return std::find(samples, samples + numSamples, KEYWORD_END_SAMPLE) != samples + numSamples;
+    }
+
+    /// The number of samples passed to @c process().
+    std::atomic<size_t> samplesProcessed;
+
+private:
+    /// The number of operations to burn per sample processed.
+    unsigned int m_opsPerSample;
+};
+
+/// A verifier which locates keyword samples within the window, and keeps track of its cost.
+class MockVerifier : public CascadeKeywordDetector::VerifierInterface {
+public:
+    /**
+     * Constructor.
+     *
+     * @param accept Whether candidates containing keyword samples are verified.
+     * @param opsPerSample The number of operations to burn per sample verified.
+     */
+    MockVerifier(bool accept, unsigned int opsPerSample = 0) :
+            calls{0},
+            samplesProcessed{0},
+            m_accept{accept},
+            m_opsPerSample{opsPerSample} {
+    }
+
+    bool verify(
+        const int16_t* samples,
+        size_t numSamples,
+        std::string* keyword,
+        AudioInputStream::Index* beginOffset,
+        AudioInputStream::Index* endOffset) override {
+        burnCpu(samples, numSamples, m_opsPerSample);
+        ++calls;
+        samplesProcessed += numSamples;
+        auto end = samples + numSamples;
+        auto first = std::find(samples, end, KEYWORD_SAMPLE);
+        auto last = std::find(samples, end, KEYWORD_END_SAMPLE);
+        if (!m_accept || first == end || last == end) {
+            return false;
+        }
+        *keyword = KEYWORD;
+        *beginOffset = first - samples;
+        *endOffset = last - samples;
+        return true;
+    }
+
+    /// The number of calls to @c verify().
+    std::atomic<size_t> calls;
+
+    /// The number of samples passed to @c verify().
+    std::atomic<size_t> samplesProcessed;
+
+private:
+    /// Whether candidates containing keyword samples are verified.
+    bool m_accept;
+
+    /// The number of operations to burn per sample verified.
+    unsigned int m_opsPerSample;
+};
+
+/// An observer which records keyword detections.
+class TestKeyWordObserver : public KeyWordObserverInterface {
+public:
+    /// A recorded detection.
+    struct Detection {
+        std::string keyword;
+        AudioInputStream::Index beginIndex;
+        AudioInputStream::Index endIndex;
+    };
+
+    void onKeyWordDetected(
+        std::shared_ptr<AudioInputStream> stream,
+        std::string keyword,
+        AudioInputStream::Index beginIndex,
+        AudioInputStream::Index endIndex) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_detections.push_back({keyword, beginIndex, endIndex});
+        m_cv.notify_all();
+    }
+
+    /**
+     * Waits for a detection.
+     *
+     * @param [out] detection The first detection.
+     * @return @c true if a detection was recorded before the timeout, else @c false.
+     */
+    bool waitForDetection(Detection* detection) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (!m_cv.wait_for(lock, TIMEOUT, [this] { return !m_detections.empty(); })) {
+            return false;
+        }
+        *detection = m_detections.front();
+        return true;
+    }
+
+    /**
+     * Waits until a number of detections have been recorded.
+     *
+     * @param numDetections The number of detections.
+     * @return @c true if the detections were recorded before the timeout, else @c false.
+     */
+    bool waitForNumDetections(size_t numDetections) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_cv.wait_for(lock, TIMEOUT, [this, numDetections] { return m_detections.size() >= numDetections; });
+    }
+
+    /**
+     * @return The number of detections recorded.
+     */
+    size_t numDetections() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_detections.size();
+    }
+
+private:
+    /// Serializes access to @c m_detections.
+    std::mutex m_mutex;
+
+    /// Notified when a detection is recorded.
+    std::condition_variable m_cv;
+
+    /// The detections recorded.
+    std::vector<Detection> m_detections;
+};
+
+class CascadeKeywordDetectorTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        auto bufferSize = AudioInputStream::calculateBufferSize(SDS_WORDS, sizeof(int16_t), SDS_MAX_READERS);
+        auto buffer = std::make_shared<AudioInputStream::Buffer>(bufferSize);
+        m_stream = AudioInputStream::create(buffer, sizeof(int16_t), SDS_MAX_READERS);
+        ASSERT_TRUE(m_stream);
+        m_writer = m_stream->createWriter(AudioInputStream::Writer::Policy::NONBLOCKABLE);
+        ASSERT_TRUE(m_writer);
+
+        m_audioFormat.encoding = AudioFormat::Encoding::LPCM;
+        m_audioFormat.endianness = AudioFormat::Endianness::LITTLE;
+        m_audioFormat.sampleRateHz = SAMPLE_RATE_HZ;
+        m_audioFormat.sampleSizeInBits = 16;
+        m_audioFormat.numChannels = 1;
+
+        m_spotter = std::make_shared<MockSpotter>();
+        m_observer = std::make_shared<TestKeyWordObserver>();
+    }
+
+    /**
+     * Creates a detector with @c m_spotter and the given verifier.
+     *
+     * @param verifier The verifier.
+     * @return The detector.
+     */
+    std::unique_ptr<CascadeKeywordDetector> createDetector(std::shared_ptr<MockVerifier> verifier) {
+        return CascadeKeywordDetector::create(
+            m_stream, m_audioFormat, {m_observer}, {}, m_spotter, verifier, VERIFICATION_WINDOW);
+    }
+
+    /**
+     * Writes audio containing a keyword into the stream.
+     *
+     * @param keywordBegin The index of the first sample of the keyword.
+     * @param keywordEnd The index of the last sample of the keyword.
+     * @param totalSamples The total number of samples to write.
+     */
+    void writeAudio(size_t keywordBegin, size_t keywordEnd, size_t totalSamples) {
+        std::vector<int16_t> audio(totalSamples, BACKGROUND_SAMPLE);
+        std::fill(audio.begin() + keywordBegin, audio.begin() + keywordEnd, KEYWORD_SAMPLE);
+        audio[keywordEnd] = KEYWORD_END_SAMPLE;
+        for (size_t written = 0; written < totalSamples; written += SAMPLES_PER_PUSH) {
+            ASSERT_GT(m_writer->write(audio.data() + written, std::min(SAMPLES_PER_PUSH, totalSamples - written)), 0);
+        }
+    }
+
+    /**
+     * Waits until the spotter has processed the given number of samples.
+     *
+     * @param numSamples The number of samples.
+     * @return @c true if the samples were processed before the timeout, else @c false.
+     */
+    bool waitForSpotter(size_t numSamples) {
+        auto deadline = std::chrono::steady_clock::now() + TIMEOUT;
+        while (m_spotter->samplesProcessed < numSamples) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+
+    /// The stream of audio.
+    std::shared_ptr<AudioInputStream> m_stream;
+
+    /// The writer of the stream.
+    std::unique_ptr<AudioInputStream::Writer> m_writer;
+
+    /// The format of the audio.
+    AudioFormat m_audioFormat;
+
+    /// The first stage engine.
+    std::shared_ptr<MockSpotter> m_spotter;
+
+    /// The observer of keyword detections.
+    std::shared_ptr<TestKeyWordObserver> m_observer;
+};
+
+/**
+ * Verify that creation fails without both engines.
+ */
+TEST_F(CascadeKeywordDetectorTest, createFailsWithoutEngines) {
+    auto verifier = std::make_shared<MockVerifier>(true);
+    EXPECT_FALSE(CascadeKeywordDetector::create(m_stream, m_audioFormat, {}, {}, nullptr, verifier));
+    EXPECT_FALSE(CascadeKeywordDetector::create(m_stream, m_audioFormat, {}, {}, m_spotter, nullptr));
+    EXPECT_FALSE(CascadeKeywordDetector::create(nullptr, m_audioFormat, {}, {}, m_spotter, verifier));
+}
+
+/**
+ * Verify that a verified candidate is reported with the absolute indices of the keyword within the stream, and that
+ * the verifier only runs over one window.
+ */
+TEST_F(CascadeKeywordDetectorTest, verifiedCandidateReportsAbsoluteIndices) {
+    auto verifier = std::make_shared<MockVerifier>(true);
+    auto detector = createDetector(verifier);
+    ASSERT_TRUE(detector);
+
+    const size_t keywordBegin = SAMPLE_RATE_HZ * 3;
+    const size_t keywordEnd = keywordBegin + SAMPLE_RATE_HZ / 2 - 1;
+    const size_t totalSamples = SAMPLE_RATE_HZ * 5;
+    writeAudio(keywordBegin, keywordEnd, totalSamples);
+
+    TestKeyWordObserver::Detection detection;
+    ASSERT_TRUE(m_observer->waitForDetection(&detection));
+    EXPECT_EQ(detection.keyword, KEYWORD);
+    EXPECT_EQ(detection.beginIndex, keywordBegin);
+    EXPECT_EQ(detection.endIndex, keywordEnd);
+
+    ASSERT_TRUE(waitForSpotter(totalSamples));
+    EXPECT_EQ(m_spotter->samplesProcessed, totalSamples);
+    EXPECT_EQ(verifier->calls, 1u);
+    EXPECT_EQ(verifier->samplesProcessed, VERIFICATION_WINDOW_SAMPLES);
+}
+
+/**
+ * Verify that a candidate rejected by the verifier is not reported.
+ */
+TEST_F(CascadeKeywordDetectorTest, rejectedCandidateNotReported) {
+    auto verifier = std::make_shared<MockVerifier>(false);
+    auto detector = createDetector(verifier);
+    ASSERT_TRUE(detector);
+
+    const size_t totalSamples = SAMPLE_RATE_HZ * 5;
+    writeAudio(SAMPLE_RATE_HZ * 3, SAMPLE_RATE_HZ * 3 + SAMPLE_RATE_HZ / 2, totalSamples);
+
+    ASSERT_TRUE(waitForSpotter(totalSamples));
+    EXPECT_EQ(verifier->calls, 1u);
+    EXPECT_EQ(m_observer->numDetections(), 0u);
+}
+
+/**
+ * Verify that a candidate close to the start of the stream is verified over the audio available, and still reported
+ * with absolute indices.
+ */
+TEST_F(CascadeKeywordDetectorTest, windowLimitedByStreamStart) {
+    auto verifier = std::make_shared<MockVerifier>(true);
+    auto detector = createDetector(verifier);
+    ASSERT_TRUE(detector);
+
+    const size_t keywordBegin = 100;
+    const size_t keywordEnd = SAMPLE_RATE_HZ / 2;
+    writeAudio(keywordBegin, keywordEnd, SAMPLE_RATE_HZ);
+
+    TestKeyWordObserver::Detection detection;
+    ASSERT_TRUE(m_observer->waitForDetection(&detection));
+    EXPECT_EQ(detection.beginIndex, keywordBegin);
+    EXPECT_EQ(detection.endIndex, keywordEnd);
+    EXPECT_LT(verifier->samplesProcessed, VERIFICATION_WINDOW_SAMPLES);
+}
+
+/**
+ * Measure the CPU time per hour of audio and the detection latency of a cascade with a cheap spotter in front of an
+ * expensive verifier, against a single stage running the expensive engine on every frame. Engine costs are in
+ * operations per sample. Disabled, as it is a benchmark rather than a test.
+ */
+TEST_F(CascadeKeywordDetectorTest, DISABLED_benchmarkCpuPerAudioHourAndDetectionLatency) {
+    static const unsigned int CHEAP_OPS_PER_SAMPLE = 10;
+    static const unsigned int EXPENSIVE_OPS_PER_SAMPLE = 200;
+    static const size_t AUDIO_SECONDS = 10 * 60;
+    static const size_t KEYWORD_PERIOD_SAMPLES = SAMPLE_RATE_HZ * 60;
+    static const size_t KEYWORD_SAMPLES = SAMPLE_RATE_HZ / 2;
+    // Keep the writer at most this far ahead of the spotter, so the stream never overruns a verification window.
+    static const size_t MAX_WRITER_LEAD_SAMPLES = VERIFICATION_WINDOW_SAMPLES;
+
+    struct Configuration {
+        const char* name;
+        unsigned int spotterOpsPerSample;
+        unsigned int verifierOpsPerSample;
+    };
+    const Configuration configurations[] = {
+        {"cascade", CHEAP_OPS_PER_SAMPLE, EXPENSIVE_OPS_PER_SAMPLE},
+        {"single stage", EXPENSIVE_OPS_PER_SAMPLE, 0},
+    };
+
+    for (auto& configuration : configurations) {
+        // Each configuration gets a fresh stream and observer.
+        SetUp();
+        m_spotter = std::make_shared<MockSpotter>(configuration.spotterOpsPerSample);
+        auto verifier = std::make_shared<MockVerifier>(true, configuration.verifierOpsPerSample);
+        auto detector = createDetector(verifier);
+        ASSERT_TRUE(detector);
+
+        std::vector<int16_t> chunk(SAMPLES_PER_PUSH);
+        std::vector<std::chrono::microseconds> latencies;
+        const size_t totalSamples = SAMPLE_RATE_HZ * AUDIO_SECONDS;
+        auto cpuStart = std::clock();
+        for (size_t written = 0; written < totalSamples; written += SAMPLES_PER_PUSH) {
+            for (size_t i = 0; i < SAMPLES_PER_PUSH; ++i) {
+                size_t positionInPeriod = (written + i) % KEYWORD_PERIOD_SAMPLES;
+                chunk[i] = positionInPeriod >= KEYWORD_PERIOD_SAMPLES - KEYWORD_SAMPLES ? KEYWORD_SAMPLE
+                                                                                        : BACKGROUND_SAMPLE;
+                if (positionInPeriod == KEYWORD_PERIOD_SAMPLES - 1) {
+                    chunk[i] = KEYWORD_END_SAMPLE;
+                }
+            }
+            bool endsKeyword = (written + SAMPLES_PER_PUSH) % KEYWORD_PERIOD_SAMPLES == 0;
+            // Latency is measured from a caught up spotter, so that it does not include the writer's lead.
+            size_t mustHaveProcessed = endsKeyword ? written : written - std::min(written, MAX_WRITER_LEAD_SAMPLES);
+            while (m_spotter->samplesProcessed < mustHaveProcessed) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            ASSERT_GT(m_writer->write(chunk.data(), SAMPLES_PER_PUSH), 0);
+            if (endsKeyword) {
+                auto writeTime = std::chrono::steady_clock::now();
+                ASSERT_TRUE(m_observer->waitForNumDetections(latencies.size() + 1));
+                auto latency = std::chrono::steady_clock::now() - writeTime;
+                latencies.push_back(std::chrono::duration_cast<std::chrono::microseconds>(latency));
+            }
+        }
+        ASSERT_TRUE(waitForSpotter(totalSamples));
+        auto cpuTicks = std::clock() - cpuStart;
+        detector.reset();
+
+        std::sort(latencies.begin(), latencies.end());
+        auto cpuMsPerAudioHour = static_cast<uint64_t>(cpuTicks) * 1000 / CLOCKS_PER_SEC * 3600 / AUDIO_SECONDS;
+        std::cout << configuration.name << " (spotter " << configuration.spotterOpsPerSample << " ops/sample, verifier "
+                  << configuration.verifierOpsPerSample << " ops/sample): " << cpuMsPerAudioHour
+                  << " ms CPU per audio hour, " << verifier->calls << " verifications, detection latency median "
+                  << latencies[latencies.size() / 2].count() << " us, max " << latencies.back().count() << " us"
+                  << std::endl;
+    }
+}
+
+}  // namespace test
+}  // namespace kwd
+}  // namespace alexaClientSDK
@@ -4,6 +4,7 @@
 #include <ws2811.h>
 #include <thread>
 #include <mutex>
+#include <condition_variable>
 
 #define TARGET_FREQ             WS2811_TARGET_FREQ
 #define GPIO_PIN                12
@@ -67,6 +68,8 @@ public:
 	int m_volume;
 	//For serialization, public since TLED will be changing the states
 	std::mutex m_mutex;
+	//Wakes the render loop while it is idle, notify with m_mutex held after setting m_stop
+	std::condition_variable m_wakeLoop;
 
 private:	
 	//Returns color as uint
@@ -1,4 +1,5 @@
 #include "LED/LEDControl.h"
+#include <AVSCommon/Utils/Threading/ThreadName.h>
 
 #include "clk.h"
 #include "gpio.h"
@@ -22,6 +23,9 @@ LEDControl::LEDControl() {
 LEDControl::~LEDControl() {
 	m_kill = true;
 	m_stop = true;
+	m_mutex.lock();
+	m_wakeLoop.notify_all();
+	m_mutex.unlock();
 
 	m_ledThread->join();
 	delete m_ledThread;
@@ -352,6 +356,7 @@ int LEDControl::getDirection() {
     return atoi(buffer);
 }
 void LEDControl::ledLoop() {
+	avsCommon::utils::threading::setThreadName("LEDControl");
 	while(!m_kill)
 	{
 		//Lock so that the state doesn't change mid loop
@@ -373,9 +378,13 @@ void LEDControl::ledLoop() {
 		//Run until the state is going to change
 		while(!m_stop) {
 			switch(m_state) {
-				case LEDState::IDLE:
-					usleep(5000);
+				case LEDState::IDLE: {
+					//Sleep until the state is going to change instead of polling m_stop
+					std::unique_lock<std::mutex> lock(m_mutex, std::adopt_lock);
+					m_wakeLoop.wait(lock, [this] { return m_stop || m_kill; });
+					lock.release();
 					break;
+				}
 				case LEDState::LISTENING:
 					DOA(getDirection());
 					//TODO: Get real value 
@@ -16,6 +16,7 @@ void LEDManager::onDialogUXStateChanged(
         avsCommon::sdkInterfaces::DialogUXStateObserverInterface::DialogUXState state) {
 	ledC->m_stop = true;
 	ledC->m_mutex.lock();
+	ledC->m_wakeLoop.notify_all();
 
 	switch(state){
 	case avsCommon::sdkInterfaces::DialogUXStateObserverInterface::DialogUXState::IDLE:
@@ -50,6 +51,7 @@ void LEDManager::onSpeakerSettingsChanged(
 	
 	ledC->m_stop = true;
 	ledC->m_mutex.lock();
+	ledC->m_wakeLoop.notify_all();
 
 	if (settings.mute)
 	{ 
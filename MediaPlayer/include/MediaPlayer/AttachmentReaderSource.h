@@ -68,6 +68,7 @@ private:
     void close() override;
     gboolean handleReadData() override;
     gboolean handleSeekData(guint64 offset) override;
+    std::shared_ptr<avsCommon::utils::sds::ReadinessNotifier> getReadinessNotifier() override;
     /// @}
 
     /// @name RequiresShutdown Functions
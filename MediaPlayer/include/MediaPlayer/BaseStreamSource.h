@@ -24,6 +24,7 @@
 #include <gst/app/gstappsrc.h>
 
 #include <AVSCommon/Utils/MediaPlayer/MediaPlayerInterface.h>
+#include <AVSCommon/Utils/SDS/ReadinessNotifier.h>
 
 #include "MediaPlayer/SourceInterface.h"
 
@@ -83,6 +84,14 @@ protected:
      */
     virtual gboolean handleSeekData(guint64 offset) = 0;
 
+    /**
+     * Get a notifier which is signalled when this source may have more data to read.  When one is available, the
+     * @c onReadData() handler waits for it instead of retrying on a timer, so data is pushed as soon as it arrives.
+     *
+     * @return The notifier for this source, or @c nullptr to retry reads on a timer.
+     */
+    virtual std::shared_ptr<avsCommon::utils::sds::ReadinessNotifier> getReadinessNotifier();
+
     /**
      * Get the AppSrc to which this instance should feed audio data.
      *
@@ -101,7 +110,9 @@ protected:
     void installOnReadDataHandler();
 
     /**
-     * Update when to call @c onReadData() handler based upon the number of retries since data was last read.
+     * Update when to call @c onReadData() handler after a read found no data.  If the source has a
+     * @c ReadinessNotifier, the handler waits for it to be signalled.  Otherwise, the handler is called again after an
+     * interval based upon the number of retries since data was last read.
      */
     void updateOnReadDataHandler();
 
@@ -158,6 +169,16 @@ private:
      */
     static gboolean onReadData(gpointer source);
 
+    /**
+     * The callback for reading data from this instance once its @c ReadinessNotifier has been signalled.
+     *
+     * @param fd The descriptor of the notifier.
+     * @param condition The condition which was signalled.
+     * @param source The instance to read data from
+     * @return @c false if there is an error or end of data from this source, else @c true.
+     */
+    static gboolean onReadinessSignalled(gint fd, GIOCondition condition, gpointer source);
+
     /// The @c PipelineInterface through which the source of the @c AudioPipeline may be set.
     PipelineInterface* m_pipeline;
 
@@ -167,6 +188,9 @@ private:
     /// Number of times reading data has been attempted since data was last successfully read.
     guint m_sourceRetryCount;
 
+    /// The notifier the @c onReadData() handler is waiting for, or @c nullptr if it is not waiting for one.
+    std::shared_ptr<avsCommon::utils::sds::ReadinessNotifier> m_readinessNotifier;
+
     /// Function to invoke on the worker thread thread when more data is needed.
     const std::function<gboolean()> m_handleNeedDataFunction;
 
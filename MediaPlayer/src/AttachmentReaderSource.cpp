@@ -158,5 +158,12 @@ gboolean AttachmentReaderSource::handleSeekData(guint64 offset) {
     }
 }
 
+std::shared_ptr<avsCommon::utils::sds::ReadinessNotifier> AttachmentReaderSource::getReadinessNotifier() {
+    if (!m_reader) {
+        return nullptr;
+    }
+    return m_reader->getReadinessNotifier();
+}
+
 }  // namespace mediaPlayer
 }  // namespace alexaClientSDK
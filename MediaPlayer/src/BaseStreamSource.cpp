@@ -17,6 +17,8 @@
 
 #include <cstring>
 
+#include <glib-unix.h>
+
 #include <AVSCommon/Utils/Logger/Logger.h>
 #include <AVSCommon/AVS/Attachment/AttachmentReader.h>
 
@@ -28,6 +30,7 @@ namespace mediaPlayer {
 using namespace avsCommon::utils;
 using namespace avsCommon::utils::mediaPlayer;
 using namespace avsCommon::avs::attachment;
+using namespace avsCommon::utils::sds;
 
 /// String to identify log entries originating from this file.
 static const std::string TAG("BaseStreamSource");
@@ -170,8 +173,8 @@ void BaseStreamSource::installOnReadDataHandler() {
         return;
     }
     if (m_sourceId != 0) {
-        // Remove the existing source if it was timer based.  Otherwise it is already properly installed.
-        if (m_sourceRetryCount != 0) {
+        // Remove the existing source if it was timer or notifier based.  Otherwise it is already properly installed.
+        if (m_sourceRetryCount != 0 || m_readinessNotifier) {
             ACSDK_DEBUG9(LX("installOnReadDataHandler").d("action", "removeSourceId").d("sourceId", m_sourceId));
             if (!g_source_remove(m_sourceId)) {
                 ACSDK_ERROR(
@@ -182,11 +185,29 @@ void BaseStreamSource::installOnReadDataHandler() {
         }
     }
     m_sourceRetryCount = 0;
+    m_readinessNotifier.reset();
     m_sourceId = g_idle_add(reinterpret_cast<GSourceFunc>(&onReadData), this);
     ACSDK_DEBUG9(LX("installOnReadDataHandler").d("action", "newSourceId").d("sourceId", m_sourceId));
 }
 
 void BaseStreamSource::updateOnReadDataHandler() {
+    if (m_readinessNotifier) {
+        // Already waiting for the notifier, which was cleared before the read that found no data.
+        return;
+    }
+    auto notifier = getReadinessNotifier();
+    if (notifier) {
+        ACSDK_DEBUG9(LX("updateOnReadDataHandler").d("action", "removeSourceId").d("sourceId", m_sourceId));
+        if (!g_source_remove(m_sourceId)) {
+            ACSDK_ERROR(
+                LX("updateOnReadDataHandlerError").d("reason", "gSourceRemoveFailed").d("sourceId", m_sourceId));
+        }
+        // The notifier is not cleared here: if data arrived since the last read, it fires straight away.
+        m_readinessNotifier = notifier;
+        m_sourceId = g_unix_fd_add(notifier->getFd(), G_IO_IN, &onReadinessSignalled, this);
+        ACSDK_DEBUG9(LX("updateOnReadDataHandler").d("action", "waitForReadiness").d("sourceId", m_sourceId));
+        return;
+    }
     if (m_sourceRetryCount < sizeof(RETRY_INTERVALS_MILLISECONDS) / sizeof(RETRY_INTERVALS_MILLISECONDS[0])) {
         ACSDK_DEBUG9(LX("updateOnReadDataHandler").d("action", "removeSourceId").d("sourceId", m_sourceId));
         if (!g_source_remove(m_sourceId)) {
@@ -217,6 +238,7 @@ void BaseStreamSource::clearOnReadDataHandler() {
     ACSDK_DEBUG9(LX("clearOnReadDataHandlerCalled").d("sourceId", m_sourceId));
     m_sourceRetryCount = 0;
     m_sourceId = 0;
+    m_readinessNotifier.reset();
 }
 
 void BaseStreamSource::onNeedData(GstElement* pipeline, guint size, gpointer pointer) {
@@ -265,6 +287,17 @@ gboolean BaseStreamSource::onReadData(gpointer pointer) {
     return static_cast<BaseStreamSource*>(pointer)->handleReadData();
 }
 
+gboolean BaseStreamSource::onReadinessSignalled(gint fd, GIOCondition condition, gpointer pointer) {
+    auto source = static_cast<BaseStreamSource*>(pointer);
+    // Clear before reading, so that data written after the read leaves the notifier signalled.
+    source->m_readinessNotifier->clear();
+    return source->handleReadData();
+}
+
+std::shared_ptr<ReadinessNotifier> BaseStreamSource::getReadinessNotifier() {
+    return nullptr;
+}
+
 // No additional processing is necessary.
 bool BaseStreamSource::handleEndOfStream() {
     return true;
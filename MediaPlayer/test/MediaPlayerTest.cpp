@@ -625,6 +625,36 @@ TEST_F(MediaPlayerTest, testStartPlayWaitForEnd) {
     ASSERT_TRUE(m_playerObserver->waitForPlaybackFinished(sourceId));
 }
 
+/**
+ * Stream an audio file into an @c InProcessAttachment in bursts, with gaps long enough for the player to run out of
+ * data, and play it from the attachment as it is written.  The source waits on the reader's @c ReadinessNotifier
+ * during each gap, so playback must still reach the end.
+ */
+TEST_F(MediaPlayerTest, testPlayAttachmentWrittenInBursts) {
+    static const size_t BURST_SIZE = 1024;
+    static const std::chrono::milliseconds GAP(100);
+    auto attachment = std::make_shared<InProcessAttachment>("bursts");
+    auto writer = attachment->createWriter();
+    ASSERT_TRUE(writer);
+    auto sourceId = m_mediaPlayer->setSource(attachment->createReader(AttachmentReader::Policy::NON_BLOCKING));
+    ASSERT_NE(ERROR_SOURCE_ID, sourceId);
+    ASSERT_TRUE(m_mediaPlayer->play(sourceId));
+
+    std::thread writerThread([&writer] {
+        std::ifstream file(inputsDirPath + MP3_FILE_PATH, std::ios::binary);
+        std::vector<char> burst(BURST_SIZE);
+        while (file.read(burst.data(), burst.size()) || file.gcount() > 0) {
+            AttachmentWriter::WriteStatus writeStatus;
+            writer->write(burst.data(), file.gcount(), &writeStatus);
+            std::this_thread::sleep_for(GAP);
+        }
+        writer->close();
+    });
+    EXPECT_TRUE(m_playerObserver->waitForPlaybackStarted(sourceId));
+    EXPECT_TRUE(m_playerObserver->waitForPlaybackFinished(sourceId, std::chrono::seconds(10)));
+    writerThread.join();
+}
+
 #ifdef URL_TESTS_RESOLVED
 
 /**
@@ -0,0 +1,116 @@
+/*
+ * PlaylistLineReader.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_PLAYLISTPARSER_INCLUDE_PLAYLISTPARSER_PLAYLISTLINEREADER_H_
+#define ALEXA_CLIENT_SDK_PLAYLISTPARSER_INCLUDE_PLAYLISTPARSER_PLAYLISTLINEREADER_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <AVSCommon/AVS/Attachment/AttachmentReader.h>
+
+namespace alexaClientSDK {
+namespace playlistParser {
+
+/**
+ * Splits a playlist into lines as it is read from an @c AttachmentReader, so that its entries can be parsed while the
+ * rest of it is still being downloaded.  The memory used is bounded by the chunk size and the maximum line length,
+ * however long the playlist is.
+ */
+class PlaylistLineReader {
+public:
+    /// The longest line kept by default.  URLs in playlists are far shorter than this.
+    static const size_t DEFAULT_MAX_LINE_LENGTH = 8192;
+
+    /**
+     * Creates a @c PlaylistLineReader.
+     *
+     * @param reader The reader of the playlist.
+     * @param maxLineLength The longest line to keep.  Longer lines are skipped.  Must be greater than zero.
+     * @return The new @c PlaylistLineReader, or @c nullptr if the parameters are invalid.
+     */
+    static std::unique_ptr<PlaylistLineReader> create(
+        std::unique_ptr<avsCommon::avs::attachment::AttachmentReader> reader,
+        size_t maxLineLength = DEFAULT_MAX_LINE_LENGTH);
+
+    /**
+     * Reads the next line, blocking until it has been received in full.
+     *
+     * @param [out] line The line, without its terminating '\n' or "\r\n".
+     * @return @c true if a line was read, or @c false at the end of the playlist or on a read error.
+     */
+    bool readLine(std::string* line);
+
+    /**
+     * Reads the rest of the playlist, for playlists which must be parsed as a whole.  Unlike lines, the content read
+     * this way is not bounded in size.
+     *
+     * @param [out] content The rest of the playlist.
+     * @return @c true if the rest of the playlist was read, or @c false on a read error.
+     */
+    bool readRemaining(std::string* content);
+
+    /**
+     * Whether reading stopped because of an error rather than the end of the playlist.
+     *
+     * @return Whether there was a read error.
+     */
+    bool hasError() const;
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param reader The reader of the playlist.
+     * @param maxLineLength The longest line to keep.
+     */
+    PlaylistLineReader(std::unique_ptr<avsCommon::avs::attachment::AttachmentReader> reader, size_t maxLineLength);
+
+    /**
+     * Reads the next chunk of the playlist into @c m_chunk, blocking until data is available.
+     *
+     * @return @c true if data was read, or @c false at the end of the playlist or on a read error.
+     */
+    bool readChunk();
+
+    /// The reader of the playlist.
+    std::unique_ptr<avsCommon::avs::attachment::AttachmentReader> m_reader;
+
+    /// The longest line to keep.
+    const size_t m_maxLineLength;
+
+    /// The last chunk read.
+    std::vector<char> m_chunk;
+
+    /// The position in @c m_chunk of the first byte not yet consumed.
+    size_t m_chunkPosition;
+
+    /// The number of bytes of data in @c m_chunk.
+    size_t m_chunkSize;
+
+    /// Whether the end of the playlist has been read.
+    bool m_closed;
+
+    /// Whether a read error occurred.
+    bool m_error;
+};
+
+}  // namespace playlistParser
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_PLAYLISTPARSER_INCLUDE_PLAYLISTPARSER_PLAYLISTLINEREADER_H_
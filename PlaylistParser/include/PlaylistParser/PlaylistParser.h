@@ -21,13 +21,17 @@
 #include <deque>
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 #include <AVSCommon/AVS/Attachment/AttachmentReader.h>
+#include <AVSCommon/SDKInterfaces/HTTPContentFetcherInterface.h>
 #include <AVSCommon/SDKInterfaces/HTTPContentFetcherInterfaceFactoryInterface.h>
 #include <AVSCommon/Utils/PlaylistParser/PlaylistParserInterface.h>
 #include <AVSCommon/Utils/RequiresShutdown.h>
 #include <AVSCommon/Utils/Threading/Executor.h>
 
+#include "PlaylistParser/PlaylistLineReader.h"
+
 namespace alexaClientSDK {
 namespace playlistParser {
 
@@ -72,6 +76,42 @@ private:
         M3UContent() : endlistTagPresent{false}, streamInfTagPresent{false} {};
     };
 
+    /**
+     * A playlist being parsed during the depth first search, and the entries from it which have not been handled yet.
+     * M3U and PLS playlists are read incrementally, a line at a time, so only the entries read ahead are held.
+     */
+    struct PlaylistFrame {
+        /// Constructor.
+        PlaylistFrame() :
+                isPLS{false},
+                m3uEntry{"", avsCommon::utils::playlistParser::PlaylistParserObserverInterface::INVALID_DURATION},
+                failed{false} {};
+
+        /// The entries of the playlist which have been read but not handled yet.
+        std::deque<UrlAndInfo> urls;
+
+        /// The URL of the playlist and its metadata, to report if reading it fails.
+        UrlAndInfo playlist;
+
+        /// The fetcher downloading the playlist, kept while the playlist is being read.
+        std::unique_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterface> contentFetcher;
+
+        /// The reader of the rest of the playlist, or @c nullptr once all of it has been read.
+        std::unique_ptr<PlaylistLineReader> lineReader;
+
+        /// Whether the playlist is a PLS playlist rather than an M3U playlist.
+        bool isPLS;
+
+        /// The entry being built from the lines of an M3U playlist read so far.
+        UrlAndInfo m3uEntry;
+
+        /// The M3U entries completed by the last line read.
+        M3UContent m3uContent;
+
+        /// Whether reading the playlist failed.
+        bool failed;
+    };
+
     /**
      * Constructor.
      *
@@ -103,12 +143,28 @@ private:
     static M3UContent parseM3UContent(const std::string& playlistURL, const std::string& content);
 
     /**
-     * Parses an PLS playlist and returns the "children" URLs in the order they appeared in the playlist.
+     * Parses one line of an M3U playlist.
      *
-     * @param content The content to parse.
-     * @return A vector of URLs in the order they appeared in the playlist.
+     * @param playlistURL The URL of the playlist, against which relative URLs are resolved.
+     * @param line The line to parse, without its line break.
+     * @param [in,out] entry The entry being built.  An #EXTINF line sets its length, and a URL completes it.
+     * @param [in,out] content The playlist content, to which tags found are recorded and completed entries added.
      */
-    static std::vector<std::string> parsePLSContent(const std::string& playlistURL, const std::string& content);
+    static void parseM3ULine(
+        const std::string& playlistURL,
+        const std::string& line,
+        UrlAndInfo* entry,
+        M3UContent* content);
+
+    /**
+     * Parses one line of a PLS playlist.
+     *
+     * @param playlistURL The URL of the playlist, against which relative URLs are resolved.
+     * @param line The line to parse, without its line break.
+     * @param [out] url The URL of the entry on the line, if there is one.
+     * @return Whether the line held the URL of an entry.
+     */
+    static bool parsePLSLine(const std::string& playlistURL, const std::string& line, std::string* url);
 
     /**
      * Determines the playlist type of an M3U playlist.
@@ -127,15 +183,38 @@ private:
     static void removeCarriageReturnFromLine(std::string* line);
 
     /**
-     * Retrieves content from a URL and stores it into a string.
+     * Starts downloading a playlist, to be read a line at a time as it arrives.
      *
-     * @param url The URL to retrieve from.
-     * @param [out] content The playlist content.
-     * @return @c true if no error occured or @c false otherwise.
+     * @param url The URL of the playlist.
+     * @param [out] contentFetcher The fetcher downloading the playlist, which must be kept while it is read.
+     * @return The reader of the playlist, or @c nullptr if it could not be retrieved.
      * @note This function should be used to retrieve content specifically from playlist URLs. Attempting to use this
      * on a media URL could be blocking forever as the URL might point to a live stream.
      */
-    bool getContentFromPlaylistUrlIntoString(const std::string& url, std::string* content) const;
+    std::unique_ptr<PlaylistLineReader> openPlaylistUrl(
+        const std::string& url,
+        std::unique_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterface>* contentFetcher) const;
+
+    /**
+     * Reads lines of a playlist which is being read incrementally, until the next entry has been read or the playlist
+     * ends.  Once the playlist ends, its reader and fetcher are released.
+     *
+     * @param frame The playlist.
+     * @return @c false if reading the playlist failed, else @c true.
+     */
+    static bool readNextEntry(PlaylistFrame* frame);
+
+    /**
+     * Determines whether any entries remain to be handled in the depth first search, reading ahead in the playlists
+     * being read incrementally where necessary.
+     *
+     * @param stack The playlists being parsed, innermost last.
+     * @param urlsToRefresh Live playlists to be fetched again once everything else has been handled.
+     * @return Whether any entries remain.  A playlist which failed counts, as its failure has yet to be reported.
+     */
+    static bool hasMoreUrls(
+        const std::vector<std::unique_ptr<PlaylistFrame>>& stack,
+        const std::deque<UrlAndInfo>& urlsToRefresh);
 
     /**
      * Determines whether the provided url is an absolute url as opposed to a relative url. This is done by simply
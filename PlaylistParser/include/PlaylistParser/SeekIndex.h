@@ -0,0 +1,121 @@
+/*
+ * SeekIndex.h
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_PLAYLISTPARSER_INCLUDE_PLAYLISTPARSER_SEEKINDEX_H_
+#define ALEXA_CLIENT_SDK_PLAYLISTPARSER_INCLUDE_PLAYLISTPARSER_SEEKINDEX_H_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace alexaClientSDK {
+namespace playlistParser {
+
+/**
+ * A @c SeekIndex maps a time offset within a media stream to the position from which fetching should begin in order
+ * to start playback at (or just before) that offset. Positions are opaque to the index; they may be byte offsets into
+ * a single media resource or indices of entries within a playlist.
+ *
+ * An index is either a sorted table of seek points, or a constant rate at which position advances with time (as is
+ * the case for constant bitrate audio).
+ */
+class SeekIndex {
+public:
+    /// A single entry of the index.
+    struct SeekPoint {
+        /**
+         * Constructor.
+         *
+         * @param time The time offset of this seek point.
+         * @param position The position at which @c time begins.
+         */
+        SeekPoint(std::chrono::milliseconds time = std::chrono::milliseconds::zero(), uint64_t position = 0);
+
+        /// The time offset of this seek point.
+        std::chrono::milliseconds time;
+
+        /// The position at which @c time begins.
+        uint64_t position;
+    };
+
+    /**
+     * Constructs an empty index. An empty index maps every offset to position zero.
+     */
+    SeekIndex();
+
+    /**
+     * Builds an index from the leading bytes of an MPEG audio (MP3) resource. Any ID3v2 tag is skipped, and the first
+     * frame is the first Layer III frame header which is followed by a compatible header one frame later. If the first
+     * frame carries a Xing/Info header with a table of contents, the index is built from that table; otherwise the
+     * stream is assumed to be constant bitrate and the index is built from the bitrate of the first frame.
+     *
+     * @param data The leading bytes of the resource.
+     * @param size The number of bytes in @c data.
+     * @param [out] index The index built from the metadata.
+     * @return @c true if a usable index was built, else @c false.
+     */
+    static bool buildFromMp3Header(const uint8_t* data, size_t size, SeekIndex* index);
+
+    /**
+     * Adds a seek point to the index. Seek points may be added in any order.
+     *
+     * @param time The time offset of the seek point.
+     * @param position The position at which @c time begins.
+     */
+    void addSeekPoint(std::chrono::milliseconds time, uint64_t position);
+
+    /**
+     * Sets the index to map time offsets linearly onto positions, starting at @c startPosition and advancing at
+     * @c positionsPerSecond. Any previously added seek points are discarded.
+     *
+     * @param startPosition The position of time offset zero.
+     * @param positionsPerSecond The rate at which position advances, for example the byte rate of the stream.
+     */
+    void setConstantRate(uint64_t startPosition, uint64_t positionsPerSecond);
+
+    /**
+     * Returns whether the index contains no information beyond time offset zero.
+     *
+     * @return @c true if the index is empty, else @c false.
+     */
+    bool empty() const;
+
+    /**
+     * Finds the seek point from which to start fetching in order to play from @c offset. The returned seek point
+     * never starts after @c offset, so the remainder can be skipped by the player once playback starts.
+     *
+     * @param offset The desired time offset.
+     * @return The latest seek point which does not start after @c offset.
+     */
+    SeekPoint lookup(std::chrono::milliseconds offset) const;
+
+private:
+    /// The seek points of the index, sorted by time.
+    std::vector<SeekPoint> m_seekPoints;
+
+    /// The position of time offset zero when the index has a constant rate.
+    uint64_t m_startPosition;
+
+    /// The rate at which position advances per second, or zero if the index is a table of seek points.
+    uint64_t m_positionsPerSecond;
+};
+
+}  // namespace playlistParser
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_PLAYLISTPARSER_INCLUDE_PLAYLISTPARSER_SEEKINDEX_H_
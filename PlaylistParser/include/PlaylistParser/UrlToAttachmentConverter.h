@@ -30,6 +30,7 @@
 #include <AVSCommon/Utils/Threading/Executor.h>
 
 #include "PlaylistParser/PlaylistParser.h"
+#include "PlaylistParser/SeekIndex.h"
 
 namespace alexaClientSDK {
 namespace playlistParser {
@@ -59,8 +60,9 @@ public:
      * @param url The URL to stream from.
      * @param observer An observer to be notified of any errors that may happen during streaming.
      * @param desiredStartTime The desired time to attempt to start streaming from. Note that this will only succeed
-     * in cases where the URL points to a playlist with metadata about individual chunks within it. If none are found,
-     * streaming will begin from the beginning.
+     * in cases where the URL points to a playlist with metadata about individual chunks within it, or to media whose
+     * header allows building a @c SeekIndex and whose server honors HTTP Range requests. Otherwise, streaming will
+     * begin from the beginning.
      * @return A @c std::shared_ptr to the new @c UrlContentToAttachmentConverter object or @c nullptr on failure.
      *
      * @note This object is intended to be used once. Subsequent calls to @c convertPlaylistToAttachment() will fail.
@@ -127,11 +129,28 @@ private:
     /// @{
 
     /**
-     * Downloads the content from the url and writes it into the internal stream.
+     * Downloads the content from the url and writes it into the internal stream. If @c offsetWithinEntry is non-zero,
+     * an attempt is made to begin the download at the closest preceding seek point instead of at the beginning. The
+     * start streaming point is set accordingly.
      *
+     * @param url The URL to download.
+     * @param entryStartPoint The offset within the overall stream at which the content of @c url begins.
+     * @param offsetWithinEntry The offset within the content of @c url at which streaming should begin.
      * @return @c true if the content was successfully streamed and written or @c false otherwise.
      */
-    bool writeUrlContentIntoStream(std::string url);
+    bool writeUrlContentIntoStream(
+        std::string url,
+        std::chrono::milliseconds entryStartPoint,
+        std::chrono::milliseconds offsetWithinEntry);
+
+    /**
+     * Fetches the leading bytes of a media URL and builds a @c SeekIndex from the metadata found there.
+     *
+     * @param url The URL of the media.
+     * @param [out] index The index built.
+     * @return @c true if an index was built or @c false otherwise.
+     */
+    bool buildSeekIndex(const std::string& url, SeekIndex* index);
 
     /**
      * Writes the given data into the internal stream.
@@ -144,6 +163,14 @@ private:
 
     /// @}
 
+    /**
+     * Fulfills @c m_startStreamingPointPromise, unless it has already been fulfilled. @c m_mutex must be held when
+     * calling this function.
+     *
+     * @param startStreamingPoint The point from which streaming began.
+     */
+    void setStartStreamingPointLocked(std::chrono::milliseconds startStreamingPoint);
+
     /// A promise to fulfill once streaming begins.
     std::promise<std::chrono::milliseconds> m_startStreamingPointPromise;
 
@@ -176,9 +203,12 @@ private:
     /// Indicates whether streaming has begun.
     bool m_startedStreaming;
 
+    /// Indicates whether @c m_startStreamingPointPromise has been fulfilled.
+    bool m_startStreamingPointSet;
+
     /**
      * Used to serialize access to private members across callbacks. This mutex protects access to m_desiredStreamPoint,
-     * m_startedStreaming, m_startStreamingPointPromise, m_runningTotal, and m_observer.
+     * m_startedStreaming, m_startStreamingPointSet, m_startStreamingPointPromise, m_runningTotal, and m_observer.
      */
     std::mutex m_mutex;
 
@@ -0,0 +1,167 @@
+/*
+ * PlaylistLineReader.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "PlaylistParser/PlaylistLineReader.h"
+
+#include <algorithm>
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+namespace alexaClientSDK {
+namespace playlistParser {
+
+using namespace avsCommon::avs::attachment;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("PlaylistLineReader");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The number of bytes read from the attachment with each read.
+static const size_t CHUNK_SIZE(1024);
+
+const size_t PlaylistLineReader::DEFAULT_MAX_LINE_LENGTH;
+
+std::unique_ptr<PlaylistLineReader> PlaylistLineReader::create(
+    std::unique_ptr<AttachmentReader> reader,
+    size_t maxLineLength) {
+    if (!reader) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "nullReader"));
+        return nullptr;
+    }
+    if (0 == maxLineLength) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "zeroMaxLineLength"));
+        return nullptr;
+    }
+    return std::unique_ptr<PlaylistLineReader>(new PlaylistLineReader(std::move(reader), maxLineLength));
+}
+
+PlaylistLineReader::PlaylistLineReader(std::unique_ptr<AttachmentReader> reader, size_t maxLineLength) :
+        m_reader{std::move(reader)},
+        m_maxLineLength{maxLineLength},
+        m_chunk(CHUNK_SIZE, 0),
+        m_chunkPosition{0},
+        m_chunkSize{0},
+        m_closed{false},
+        m_error{false} {
+}
+
+bool PlaylistLineReader::readLine(std::string* line) {
+    if (!line) {
+        ACSDK_ERROR(LX("readLineFailed").d("reason", "nullLine"));
+        return false;
+    }
+    line->clear();
+    bool tooLong = false;
+    bool haveData = false;
+    while (true) {
+        if (m_chunkPosition == m_chunkSize && !readChunk()) {
+            // The last line of a playlist needn't end with a newline.
+            if (m_error || !haveData) {
+                return false;
+            }
+            break;
+        }
+        haveData = true;
+        auto begin = m_chunk.begin() + m_chunkPosition;
+        auto end = m_chunk.begin() + m_chunkSize;
+        auto newline = std::find(begin, end, '\n');
+        if (!tooLong) {
+            if (line->size() + (newline - begin) > m_maxLineLength) {
+                tooLong = true;
+                line->clear();
+            } else {
+                line->append(begin, newline);
+            }
+        }
+        m_chunkPosition = newline - m_chunk.begin();
+        if (newline == end) {
+            continue;
+        }
+        // Consume the newline.
+        ++m_chunkPosition;
+        if (!tooLong) {
+            break;
+        }
+        ACSDK_WARN(LX("readLine").d("reason", "lineTooLong").d("maxLineLength", m_maxLineLength));
+        tooLong = false;
+        haveData = false;
+    }
+    if (tooLong) {
+        ACSDK_WARN(LX("readLine").d("reason", "lineTooLong").d("maxLineLength", m_maxLineLength));
+        return false;
+    }
+    if (!line->empty() && line->back() == '\r') {
+        line->pop_back();
+    }
+    return true;
+}
+
+bool PlaylistLineReader::readRemaining(std::string* content) {
+    if (!content) {
+        ACSDK_ERROR(LX("readRemainingFailed").d("reason", "nullContent"));
+        return false;
+    }
+    content->clear();
+    do {
+        content->append(m_chunk.begin() + m_chunkPosition, m_chunk.begin() + m_chunkSize);
+        m_chunkPosition = m_chunkSize;
+    } while (readChunk());
+    return !m_error;
+}
+
+bool PlaylistLineReader::hasError() const {
+    return m_error;
+}
+
+bool PlaylistLineReader::readChunk() {
+    m_chunkPosition = 0;
+    m_chunkSize = 0;
+    while (!m_closed && !m_error) {
+        auto readStatus = AttachmentReader::ReadStatus::OK;
+        auto bytesRead = m_reader->read(m_chunk.data(), m_chunk.size(), &readStatus);
+        switch (readStatus) {
+            case AttachmentReader::ReadStatus::CLOSED:
+                m_closed = true;
+                break;
+            case AttachmentReader::ReadStatus::OK:
+            case AttachmentReader::ReadStatus::OK_WOULDBLOCK:
+            case AttachmentReader::ReadStatus::OK_TIMEDOUT:
+                break;
+            case AttachmentReader::ReadStatus::ERROR_OVERRUN:
+            case AttachmentReader::ReadStatus::ERROR_BYTES_LESS_THAN_WORD_SIZE:
+            case AttachmentReader::ReadStatus::ERROR_INTERNAL:
+                ACSDK_ERROR(LX("readChunkFailed").d("reason", "readError"));
+                m_error = true;
+                return false;
+        }
+        // Data received along with CLOSED is still part of the playlist.
+        if (bytesRead > 0) {
+            m_chunkSize = bytesRead;
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace playlistParser
+}  // namespace alexaClientSDK
@@ -42,9 +42,6 @@ static const std::string M3U_CONTENT_TYPE = "mpegurl";
 /// The HTML content-type of a PLS playlist.
 static const std::string PLS_CONTENT_TYPE = "scpls";
 
-/// The number of bytes read from the attachment with each read in the read loop.
-static const size_t CHUNK_SIZE(1024);
-
 /// The id of each request.
 static int g_id = 0;
 
@@ -65,6 +62,9 @@ static const std::string EXTSTREAMINF = "#EXT-X-STREAM-INF";
  */
 static const std::string ENDLIST = "#EXT-X-ENDLIST";
 
+/// The prefix of the tags which only HLS playlists have, distinguishing them from other extended M3U playlists.
+static const std::string HLS_TAG_PREFIX = "#EXT-X-";
+
 /// The first line of a PLS playlist.
 static const std::string PLS_PLAYLIST_HEADER = "[playlist]";
 
@@ -115,15 +115,46 @@ void PlaylistParser::doDepthFirstSearch(
     std::vector<PlaylistType> playlistTypesToNotBeParsed) {
     /*
      * A depth first search, as follows:
-     * 1. Push root to vector.
-     * 2. While vector isn't empty, pop from front and push children, in the order they appeared, to front of vector.
+     * 1. Push a frame holding the root to a stack.
+     * 2. While the stack isn't empty, take the next URL from the frame on top. Push a frame for each playlist found,
+     *    so that its children are handled, in the order they appeared, before the rest of the playlist containing it.
+     *
+     * M3U and PLS playlists are read incrementally, so that their first entries are handled as soon as they arrive
+     * rather than once the whole playlist has been downloaded, and only the entries read ahead are held in memory.
      */
-    std::deque<UrlAndInfo> urlsToParse;
-    urlsToParse.push_front({rootUrl, INVALID_DURATION});
+    std::vector<std::unique_ptr<PlaylistFrame>> stack;
+    std::unique_ptr<PlaylistFrame> rootFrame(new PlaylistFrame);
+    rootFrame->urls.push_back({rootUrl, INVALID_DURATION});
+    stack.push_back(std::move(rootFrame));
+    // Live playlists to fetch again once everything else has been handled.
+    std::deque<UrlAndInfo> urlsToRefresh;
     std::string lastUrlParsed;
-    while (!urlsToParse.empty() && !m_shuttingDown) {
-        auto urlAndInfo = urlsToParse.front();
-        urlsToParse.pop_front();
+    while (!m_shuttingDown) {
+        // Drop the playlists which have been handled in full, and report any which could not be read.
+        while (!stack.empty() && stack.back()->urls.empty()) {
+            if (!readNextEntry(stack.back().get())) {
+                ACSDK_ERROR(LX("failedToRetrieveContent").sensitive("url", stack.back()->playlist.url));
+                observer->onPlaylistEntryParsed(
+                    id,
+                    stack.back()->playlist.url,
+                    avsCommon::utils::playlistParser::PlaylistParseResult::ERROR,
+                    stack.back()->playlist.length);
+                return;
+            }
+            if (stack.back()->urls.empty()) {
+                stack.pop_back();
+            }
+        }
+        if (stack.empty()) {
+            if (urlsToRefresh.empty()) {
+                return;
+            }
+            std::unique_ptr<PlaylistFrame> refreshFrame(new PlaylistFrame);
+            refreshFrame->urls.swap(urlsToRefresh);
+            stack.push_back(std::move(refreshFrame));
+        }
+        auto urlAndInfo = stack.back()->urls.front();
+        stack.back()->urls.pop_front();
         auto contentFetcher = m_contentFetcherFactory->create(urlAndInfo.url);
         auto httpContent = contentFetcher->getContent(
             avsCommon::sdkInterfaces::HTTPContentFetcherInterface::FetchOptions::CONTENT_TYPE);
@@ -141,8 +172,12 @@ void PlaylistParser::doDepthFirstSearch(
         std::transform(contentType.begin(), contentType.end(), contentType.begin(), ::tolower);
         // Checking the HTML content type to see if the URL is a playlist.
         if (contentType.find(M3U_CONTENT_TYPE) != std::string::npos) {
-            std::string playlistContent;
-            if (!getContentFromPlaylistUrlIntoString(urlAndInfo.url, &playlistContent)) {
+            std::unique_ptr<PlaylistFrame> frame(new PlaylistFrame);
+            frame->playlist = urlAndInfo;
+            frame->lineReader = openPlaylistUrl(urlAndInfo.url, &frame->contentFetcher);
+            std::string firstLine;
+            if (!frame->lineReader ||
+                (!frame->lineReader->readLine(&firstLine) && frame->lineReader->hasError())) {
                 ACSDK_ERROR(LX("failedToRetrieveContent").sensitive("url", urlAndInfo.url));
                 observer->onPlaylistEntryParsed(
                     id,
@@ -152,7 +187,7 @@ void PlaylistParser::doDepthFirstSearch(
                 return;
             }
             // This playlist may either be M3U or M3U8 so some additional parsing is required.
-            bool isM3U8 = isM3UPlaylistM3U8(playlistContent);
+            bool isM3U8 = isM3UPlaylistM3U8(firstLine);
             if (isM3U8) {
                 ACSDK_DEBUG9(LX("isM3U8Playlist").sensitive("url", urlAndInfo.url));
             } else {
@@ -163,14 +198,79 @@ void PlaylistParser::doDepthFirstSearch(
                     playlistTypesToNotBeParsed.begin(),
                     playlistTypesToNotBeParsed.end(),
                     isM3U8 ? PlaylistType::M3U8 : PlaylistType::M3U) != playlistTypesToNotBeParsed.end()) {
+                frame.reset();
                 observer->onPlaylistEntryParsed(
                     id,
                     urlAndInfo.url,
-                    urlsToParse.empty() ? avsCommon::utils::playlistParser::PlaylistParseResult::SUCCESS
-                                        : avsCommon::utils::playlistParser::PlaylistParseResult::STILL_ONGOING,
+                    hasMoreUrls(stack, urlsToRefresh)
+                        ? avsCommon::utils::playlistParser::PlaylistParseResult::STILL_ONGOING
+                        : avsCommon::utils::playlistParser::PlaylistParseResult::SUCCESS,
                     urlAndInfo.length);
                 continue;
             }
+            /*
+             * An extended M3U playlist starts with the same header as an HLS playlist, but only an HLS playlist has
+             * "#EXT-X-" tags, which come before its first entry. Read up to the first entry to tell them apart.
+             */
+            std::vector<std::string> leadingLines{firstLine};
+            bool isHLS = false;
+            if (isM3U8) {
+                std::string line;
+                while (!isHLS && frame->lineReader->readLine(&line)) {
+                    leadingLines.push_back(line);
+                    isHLS = line.compare(0, HLS_TAG_PREFIX.length(), HLS_TAG_PREFIX) == 0;
+                    auto firstChar = line.find_first_not_of(" \t");
+                    if (firstChar != std::string::npos && line[firstChar] != '#') {
+                        break;
+                    }
+                }
+            }
+            if (frame->lineReader->hasError()) {
+                ACSDK_ERROR(LX("failedToRetrieveContent").sensitive("url", urlAndInfo.url));
+                observer->onPlaylistEntryParsed(
+                    id,
+                    urlAndInfo.url,
+                    avsCommon::utils::playlistParser::PlaylistParseResult::ERROR,
+                    urlAndInfo.length);
+                return;
+            }
+            if (!isHLS) {
+                // Any other M3U playlist is read incrementally, starting from the lines already read.
+                for (const auto& line : leadingLines) {
+                    parseM3ULine(urlAndInfo.url, line, &frame->m3uEntry, &frame->m3uContent);
+                }
+                for (auto& entry : frame->m3uContent.childrenUrls) {
+                    frame->urls.push_back(entry);
+                }
+                frame->m3uContent.childrenUrls.clear();
+                if (!readNextEntry(frame.get()) || frame->urls.empty()) {
+                    ACSDK_ERROR(LX("noChildrenURLs"));
+                    observer->onPlaylistEntryParsed(
+                        id,
+                        urlAndInfo.url,
+                        avsCommon::utils::playlistParser::PlaylistParseResult::ERROR,
+                        urlAndInfo.length);
+                    return;
+                }
+                stack.push_back(std::move(frame));
+                continue;
+            }
+            // An HLS playlist is parsed as a whole, as its tags determine how its entries are handled.
+            std::string playlistContent;
+            if (!frame->lineReader->readRemaining(&playlistContent)) {
+                ACSDK_ERROR(LX("failedToRetrieveContent").sensitive("url", urlAndInfo.url));
+                observer->onPlaylistEntryParsed(
+                    id,
+                    urlAndInfo.url,
+                    avsCommon::utils::playlistParser::PlaylistParseResult::ERROR,
+                    urlAndInfo.length);
+                return;
+            }
+            for (auto it = leadingLines.rbegin(); it != leadingLines.rend(); ++it) {
+                playlistContent = *it + '\n' + playlistContent;
+            }
+            frame->lineReader.reset();
+            frame->contentFetcher.reset();
             auto M3UContent = parseM3UContent(urlAndInfo.url, playlistContent);
             const auto& childrenUrls = M3UContent.childrenUrls;
             if (childrenUrls.empty()) {
@@ -183,56 +283,49 @@ void PlaylistParser::doDepthFirstSearch(
                 return;
             }
             ACSDK_DEBUG9((LX("foundChildrenURLsInPlaylist").d("num", childrenUrls.size())));
-            if (isM3U8) {
-                if (M3UContent.streamInfTagPresent) {
-                    // Indicates that this is the Master Playlist and that only one URL should be chosen from here
-                    ACSDK_DEBUG9(LX("encounteredMasterPlaylist").sensitive("url", urlAndInfo.url));
-                    // Because we don't do any selective choosing based on bitrates or codecs, only push the first URL
-                    // as a default.
-                    urlsToParse.push_front(childrenUrls.front());
+            if (M3UContent.streamInfTagPresent) {
+                // Indicates that this is the Master Playlist and that only one URL should be chosen from here
+                ACSDK_DEBUG9(LX("encounteredMasterPlaylist").sensitive("url", urlAndInfo.url));
+                // Because we don't do any selective choosing based on bitrates or codecs, only push the first URL
+                // as a default.
+                frame->urls.push_back(childrenUrls.front());
+            } else {
+                // lastUrlParsed is set when we actually parse some urls from the playlist - here, it is our first
+                // pass at this playlist
+                if (lastUrlParsed.empty()) {
+                    frame->urls.assign(childrenUrls.begin(), childrenUrls.end());
+                    lastUrlParsed = childrenUrls.back().url;
                 } else {
-                    // lastUrlParsed is set when we actually parse some urls from the playlist - here, it is our first
-                    // pass at this playlist
-                    if (lastUrlParsed.empty()) {
-                        for (auto reverseIt = childrenUrls.rbegin(); reverseIt != childrenUrls.rend(); ++reverseIt) {
-                            urlsToParse.push_front(*reverseIt);
-                        }
-                        lastUrlParsed = childrenUrls.back().url;
-                    } else {
-                        // Setting this to 0 as an intial value so that if we don't see the last URL we parsed in the
-                        // latest pass of the playlist, we stream all the URLs within the playlist as a sort of
-                        // recovery mechanism. This way, if we parse this so far into the future that all the URLs we
-                        // had previously seen are gone, we'll still stream the latest URLs.
-                        int startPointForNewURLsAdded = 0;
-                        for (int i = childrenUrls.size() - 1; i >= 0; --i) {
-                            if (childrenUrls.at(i).url == lastUrlParsed) {
-                                // We need to add the URLs past this point
-                                startPointForNewURLsAdded = i + 1;
-                            }
-                        }
-                        for (int i = childrenUrls.size() - 1; i >= startPointForNewURLsAdded; --i) {
-                            ACSDK_DEBUG9(LX("foundNewURLInLivePlaylist"));
-                            urlsToParse.push_front(childrenUrls.at(i));
-                            lastUrlParsed = urlsToParse.back().url;
+                    // Setting this to 0 as an intial value so that if we don't see the last URL we parsed in the
+                    // latest pass of the playlist, we stream all the URLs within the playlist as a sort of
+                    // recovery mechanism. This way, if we parse this so far into the future that all the URLs we
+                    // had previously seen are gone, we'll still stream the latest URLs.
+                    size_t startPointForNewURLsAdded = 0;
+                    for (size_t i = 0; i < childrenUrls.size(); ++i) {
+                        if (childrenUrls.at(i).url == lastUrlParsed) {
+                            // We need to add the URLs past this point
+                            startPointForNewURLsAdded = i + 1;
                         }
                     }
-                    if (!M3UContent.endlistTagPresent) {
-                        ACSDK_DEBUG9(LX("encounteredLiveHLSPlaylist")
-                                         .sensitive("url", urlAndInfo.url)
-                                         .d("info", "willRetryURLInFuture"));
-                        /*
-                         * Because this URL represents a live playlist which can have additional chunks added to it, we
-                         * need to make a request to this URL again in the future to continue playback of additional
-                         * chunks that get added.
-                         */
-                        urlsToParse.push_back(urlAndInfo);
+                    for (size_t i = startPointForNewURLsAdded; i < childrenUrls.size(); ++i) {
+                        ACSDK_DEBUG9(LX("foundNewURLInLivePlaylist"));
+                        frame->urls.push_back(childrenUrls.at(i));
+                        lastUrlParsed = childrenUrls.at(i).url;
                     }
                 }
-            } else {
-                for (auto reverseIt = childrenUrls.rbegin(); reverseIt != childrenUrls.rend(); ++reverseIt) {
-                    urlsToParse.push_front(*reverseIt);
+                if (!M3UContent.endlistTagPresent) {
+                    ACSDK_DEBUG9(LX("encounteredLiveHLSPlaylist")
+                                     .sensitive("url", urlAndInfo.url)
+                                     .d("info", "willRetryURLInFuture"));
+                    /*
+                     * Because this URL represents a live playlist which can have additional chunks added to it, we
+                     * need to make a request to this URL again in the future to continue playback of additional
+                     * chunks that get added.
+                     */
+                    urlsToRefresh.push_back(urlAndInfo);
                 }
             }
+            stack.push_back(std::move(frame));
         } else if (contentType.find(PLS_CONTENT_TYPE) != std::string::npos) {
             ACSDK_DEBUG9(LX("isPLSPlaylist").sensitive("url", urlAndInfo.url));
             /*
@@ -244,22 +337,17 @@ void PlaylistParser::doDepthFirstSearch(
                 observer->onPlaylistEntryParsed(
                     id,
                     urlAndInfo.url,
-                    urlsToParse.empty() ? avsCommon::utils::playlistParser::PlaylistParseResult::SUCCESS
-                                        : avsCommon::utils::playlistParser::PlaylistParseResult::STILL_ONGOING,
+                    hasMoreUrls(stack, urlsToRefresh)
+                        ? avsCommon::utils::playlistParser::PlaylistParseResult::STILL_ONGOING
+                        : avsCommon::utils::playlistParser::PlaylistParseResult::SUCCESS,
                     urlAndInfo.length);
                 continue;
             }
-            std::string playlistContent;
-            if (!getContentFromPlaylistUrlIntoString(urlAndInfo.url, &playlistContent)) {
-                observer->onPlaylistEntryParsed(
-                    id,
-                    urlAndInfo.url,
-                    avsCommon::utils::playlistParser::PlaylistParseResult::ERROR,
-                    urlAndInfo.length);
-                return;
-            }
-            auto childrenUrls = parsePLSContent(urlAndInfo.url, playlistContent);
-            if (childrenUrls.empty()) {
+            std::unique_ptr<PlaylistFrame> frame(new PlaylistFrame);
+            frame->playlist = urlAndInfo;
+            frame->isPLS = true;
+            frame->lineReader = openPlaylistUrl(urlAndInfo.url, &frame->contentFetcher);
+            if (!frame->lineReader || !readNextEntry(frame.get()) || frame->urls.empty()) {
                 observer->onPlaylistEntryParsed(
                     id,
                     urlAndInfo.url,
@@ -267,78 +355,91 @@ void PlaylistParser::doDepthFirstSearch(
                     urlAndInfo.length);
                 return;
             }
-            for (auto reverseIt = childrenUrls.rbegin(); reverseIt != childrenUrls.rend(); ++reverseIt) {
-                urlsToParse.push_front({*reverseIt, INVALID_DURATION});
-            }
+            stack.push_back(std::move(frame));
         } else {
             ACSDK_DEBUG9(LX("foundNonPlaylistURL"));
             // This is a non-playlist URL or a playlist that we don't support (M3U, M3U8, PLS).
             observer->onPlaylistEntryParsed(
                 id,
                 urlAndInfo.url,
-                urlsToParse.empty() ? avsCommon::utils::playlistParser::PlaylistParseResult::SUCCESS
-                                    : avsCommon::utils::playlistParser::PlaylistParseResult::STILL_ONGOING,
+                hasMoreUrls(stack, urlsToRefresh) ? avsCommon::utils::playlistParser::PlaylistParseResult::STILL_ONGOING
+                                                  : avsCommon::utils::playlistParser::PlaylistParseResult::SUCCESS,
                 urlAndInfo.length);
         }
     }
 }
 
-bool PlaylistParser::getContentFromPlaylistUrlIntoString(const std::string& url, std::string* content) const {
-    if (!content) {
-        ACSDK_ERROR(LX("getContentFromPlaylistUrlIntoStringFailed").d("reason", "nullString"));
-        return false;
+std::unique_ptr<PlaylistLineReader> PlaylistParser::openPlaylistUrl(
+    const std::string& url,
+    std::unique_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterface>* contentFetcher) const {
+    if (!contentFetcher) {
+        ACSDK_ERROR(LX("openPlaylistUrlFailed").d("reason", "nullContentFetcher"));
+        return nullptr;
+    }
+    *contentFetcher = m_contentFetcherFactory->create(url);
+    if (!*contentFetcher) {
+        ACSDK_ERROR(LX("openPlaylistUrlFailed").d("reason", "createContentFetcherFailed"));
+        return nullptr;
     }
-    auto contentFetcher = m_contentFetcherFactory->create(url);
     auto httpContent =
-        contentFetcher->getContent(avsCommon::sdkInterfaces::HTTPContentFetcherInterface::FetchOptions::ENTIRE_BODY);
+        (*contentFetcher)
+            ->getContent(avsCommon::sdkInterfaces::HTTPContentFetcherInterface::FetchOptions::ENTIRE_BODY);
     if (!httpContent) {
-        ACSDK_ERROR(LX("getContentFromPlaylistUrlIntoStringFailed").d("reason", "nullHTTPContentReceived"));
-        return false;
+        ACSDK_ERROR(LX("openPlaylistUrlFailed").d("reason", "nullHTTPContentReceived"));
+        return nullptr;
     }
     if (!(*httpContent)) {
-        ACSDK_ERROR(LX("getContentFromPlaylistUrlIntoStringFailed").d("reason", "badHTTPContentReceived"));
-        return false;
+        ACSDK_ERROR(LX("openPlaylistUrlFailed").d("reason", "badHTTPContentReceived"));
+        return nullptr;
     }
     auto reader = httpContent->dataStream->createReader(avsCommon::avs::attachment::AttachmentReader::Policy::BLOCKING);
     if (!reader) {
-        ACSDK_ERROR(LX("getContentFromPlaylistUrlIntoStringFailed").d("reason", "failedToCreateStreamReader"));
+        ACSDK_ERROR(LX("openPlaylistUrlFailed").d("reason", "failedToCreateStreamReader"));
+        return nullptr;
+    }
+    return PlaylistLineReader::create(std::move(reader));
+}
+
+bool PlaylistParser::readNextEntry(PlaylistFrame* frame) {
+    if (frame->failed) {
         return false;
     }
-    avsCommon::avs::attachment::AttachmentReader::ReadStatus readStatus =
-        avsCommon::avs::attachment::AttachmentReader::ReadStatus::OK;
-    std::string playlistContent;
-    std::vector<char> buffer(CHUNK_SIZE, 0);
-    bool streamClosed = false;
-    while (!streamClosed) {
-        auto bytesRead = reader->read(buffer.data(), buffer.size(), &readStatus);
-        switch (readStatus) {
-            case avsCommon::avs::attachment::AttachmentReader::ReadStatus::CLOSED:
-                streamClosed = true;
-                if (bytesRead == 0) {
-                    break;
-                }
-            /* FALL THROUGH - to add any data received even if closed */
-            case avsCommon::avs::attachment::AttachmentReader::ReadStatus::OK:
-            case avsCommon::avs::attachment::AttachmentReader::ReadStatus::OK_WOULDBLOCK:
-            case avsCommon::avs::attachment::AttachmentReader::ReadStatus::OK_TIMEDOUT:
-                playlistContent.append(buffer.data(), bytesRead);
-                break;
-            case avsCommon::avs::attachment::AttachmentReader::ReadStatus::ERROR_OVERRUN:
-            case avsCommon::avs::attachment::AttachmentReader::ReadStatus::ERROR_BYTES_LESS_THAN_WORD_SIZE:
-            case avsCommon::avs::attachment::AttachmentReader::ReadStatus::ERROR_INTERNAL:
-                ACSDK_ERROR(LX("getContentFromPlaylistUrlIntoStringFailed").d("reason", "readError"));
-                return false;
+    std::string line;
+    while (frame->urls.empty() && frame->lineReader) {
+        if (!frame->lineReader->readLine(&line)) {
+            frame->failed = frame->lineReader->hasError();
+            frame->lineReader.reset();
+            frame->contentFetcher.reset();
+            return !frame->failed;
+        }
+        if (frame->isPLS) {
+            std::string url;
+            if (parsePLSLine(frame->playlist.url, line, &url)) {
+                frame->urls.push_back({url, INVALID_DURATION});
+            }
+        } else {
+            parseM3ULine(frame->playlist.url, line, &frame->m3uEntry, &frame->m3uContent);
+            for (auto& entry : frame->m3uContent.childrenUrls) {
+                frame->urls.push_back(entry);
+            }
+            frame->m3uContent.childrenUrls.clear();
         }
     }
-    *content = playlistContent;
     return true;
 }
 
+bool PlaylistParser::hasMoreUrls(
+    const std::vector<std::unique_ptr<PlaylistFrame>>& stack,
+    const std::deque<UrlAndInfo>& urlsToRefresh) {
+    for (auto it = stack.rbegin(); it != stack.rend(); ++it) {
+        if (!readNextEntry(it->get()) || !(*it)->urls.empty()) {
+            return true;
+        }
+    }
+    return !urlsToRefresh.empty();
+}
+
 PlaylistParser::M3UContent PlaylistParser::parseM3UContent(const std::string& playlistURL, const std::string& content) {
-    /*
-     * An M3U playlist is formatted such that all metadata information is prepended with a '#' and everything else is a
-     * URL to play.
-     */
     M3UContent parsedContent;
     std::istringstream iss(content);
     std::string line;
@@ -346,64 +447,67 @@ PlaylistParser::M3UContent PlaylistParser::parseM3UContent(const std::string& pl
     entry.length = INVALID_DURATION;
     while (std::getline(iss, line)) {
         removeCarriageReturnFromLine(&line);
-        std::istringstream iss2(line);
-        char firstChar;
-        iss2 >> firstChar;
-        if (!iss2) {
-            continue;
-        }
-        if (firstChar == '#') {
-            if (line.compare(0, EXTINF.length(), EXTINF) == 0) {
-                entry.length = parseRuntime(line);
-            } else if (line.compare(0, EXTSTREAMINF.length(), EXTSTREAMINF) == 0) {
-                parsedContent.streamInfTagPresent = true;
-            } else if (line.compare(0, ENDLIST.length(), ENDLIST) == 0) {
-                parsedContent.endlistTagPresent = true;
-            }
-            continue;
+        parseM3ULine(playlistURL, line, &entry, &parsedContent);
+    }
+    return parsedContent;
+}
+
+void PlaylistParser::parseM3ULine(
+    const std::string& playlistURL,
+    const std::string& line,
+    UrlAndInfo* entry,
+    M3UContent* content) {
+    /*
+     * An M3U playlist is formatted such that all metadata information is prepended with a '#' and everything else is a
+     * URL to play.
+     */
+    std::istringstream iss(line);
+    char firstChar;
+    iss >> firstChar;
+    if (!iss) {
+        return;
+    }
+    if (firstChar == '#') {
+        if (line.compare(0, EXTINF.length(), EXTINF) == 0) {
+            entry->length = parseRuntime(line);
+        } else if (line.compare(0, EXTSTREAMINF.length(), EXTSTREAMINF) == 0) {
+            content->streamInfTagPresent = true;
+        } else if (line.compare(0, ENDLIST.length(), ENDLIST) == 0) {
+            content->endlistTagPresent = true;
         }
-        // at this point, "line" is a url
-        if (isURLAbsolute(line)) {
-            entry.url = line;
-            parsedContent.childrenUrls.push_back(entry);
-            entry.url.clear();
-            entry.length = INVALID_DURATION;
-        } else {
-            std::string absoluteURL;
-            if (getAbsoluteURLFromRelativePathToURL(playlistURL, line, &absoluteURL)) {
-                entry.url = absoluteURL;
-                parsedContent.childrenUrls.push_back(entry);
-                entry.url.clear();
-                entry.length = INVALID_DURATION;
-            }
+        return;
+    }
+    // at this point, "line" is a url
+    if (isURLAbsolute(line)) {
+        entry->url = line;
+        content->childrenUrls.push_back(*entry);
+        entry->url.clear();
+        entry->length = INVALID_DURATION;
+    } else {
+        std::string absoluteURL;
+        if (getAbsoluteURLFromRelativePathToURL(playlistURL, line, &absoluteURL)) {
+            entry->url = absoluteURL;
+            content->childrenUrls.push_back(*entry);
+            entry->url.clear();
+            entry->length = INVALID_DURATION;
         }
     }
-    return parsedContent;
 }
 
-std::vector<std::string> PlaylistParser::parsePLSContent(const std::string& playlistURL, const std::string& content) {
+bool PlaylistParser::parsePLSLine(const std::string& playlistURL, const std::string& line, std::string* url) {
     /*
      * A PLS playlist is formatted such that all URLs to play are prepended with "File'N'=", where 'N' refers to the
      * numbered URL. For example "File1=url.com ... File2="anotherurl.com".
      */
-    std::vector<std::string> urlsParsed;
-    std::istringstream iss(content);
-    std::string line;
-    while (std::getline(iss, line)) {
-        removeCarriageReturnFromLine(&line);
-        if (line.compare(0, PLS_FILE.length(), PLS_FILE) == 0) {
-            std::string url = line.substr(line.find_first_of('=') + 1);
-            if (isURLAbsolute(url)) {
-                urlsParsed.push_back(url);
-            } else {
-                std::string absoluteURL;
-                if (getAbsoluteURLFromRelativePathToURL(playlistURL, url, &absoluteURL)) {
-                    urlsParsed.push_back(absoluteURL);
-                }
-            }
-        }
+    if (line.compare(0, PLS_FILE.length(), PLS_FILE) != 0) {
+        return false;
+    }
+    std::string fileUrl = line.substr(line.find_first_of('=') + 1);
+    if (isURLAbsolute(fileUrl)) {
+        *url = fileUrl;
+        return true;
     }
-    return urlsParsed;
+    return getAbsoluteURLFromRelativePathToURL(playlistURL, fileUrl, url);
 }
 
 void PlaylistParser::removeCarriageReturnFromLine(std::string* line) {
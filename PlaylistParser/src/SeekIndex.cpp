@@ -0,0 +1,295 @@
+/*
+ * SeekIndex.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+#include "PlaylistParser/SeekIndex.h"
+
+namespace alexaClientSDK {
+namespace playlistParser {
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("SeekIndex");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The size of an ID3v2 tag header (and footer).
+static const size_t ID3V2_HEADER_SIZE = 10;
+
+/// The ID3v2 header flag indicating that a footer follows the tag.
+static const uint8_t ID3V2_FOOTER_PRESENT_FLAG = 0x10;
+
+/// The size of an MPEG audio frame header.
+static const size_t MPEG_FRAME_HEADER_SIZE = 4;
+
+/// The number of bytes past the end of any ID3v2 tag in which to look for the first frame sync.
+static const size_t MAX_BYTES_TO_SCAN_FOR_FRAME_SYNC = 4096;
+
+/// Bitrates in kbps of MPEG-1 Layer III frames, indexed by the bitrate bits of the frame header.
+static const uint32_t MPEG1_LAYER3_BITRATES_KBPS[] = {0, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320};
+
+/// Bitrates in kbps of MPEG-2 and MPEG-2.5 Layer III frames, indexed by the bitrate bits of the frame header.
+static const uint32_t MPEG2_LAYER3_BITRATES_KBPS[] = {0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160};
+
+/// Sample rates of MPEG-1 frames, indexed by the sample rate bits of the frame header.
+static const uint32_t MPEG1_SAMPLE_RATES[] = {44100, 48000, 32000};
+
+/// The number of entries in a Xing table of contents.
+static const size_t XING_TOC_SIZE = 100;
+
+/// The Xing header flag indicating that the frame count is present.
+static const uint32_t XING_FRAMES_FLAG = 0x1;
+
+/// The Xing header flag indicating that the byte count is present.
+static const uint32_t XING_BYTES_FLAG = 0x2;
+
+/// The Xing header flag indicating that the table of contents is present.
+static const uint32_t XING_TOC_FLAG = 0x4;
+
+/// The value of a Xing table of contents entry which corresponds to the end of the stream.
+static const uint64_t XING_TOC_SCALE = 256;
+
+/**
+ * Reads a big endian 32 bit value.
+ *
+ * @param data Pointer to the first of four bytes.
+ * @return The value read.
+ */
+static uint32_t readUint32BigEndian(const uint8_t* data) {
+    return (static_cast<uint32_t>(data[0]) << 24) | (static_cast<uint32_t>(data[1]) << 16) |
+           (static_cast<uint32_t>(data[2]) << 8) | static_cast<uint32_t>(data[3]);
+}
+
+/**
+ * Computes the number of bytes taken up by an ID3v2 tag at the beginning of @c data.
+ *
+ * @param data The leading bytes of the resource.
+ * @param size The number of bytes in @c data.
+ * @return The size of the tag, or zero if there is none.
+ */
+static size_t getId3v2TagSize(const uint8_t* data, size_t size) {
+    if (size < ID3V2_HEADER_SIZE || std::memcmp(data, "ID3", 3) != 0) {
+        return 0;
+    }
+    // The tag size is stored as a 28 bit "syncsafe" integer, 7 bits per byte.
+    size_t tagSize = (static_cast<size_t>(data[6] & 0x7f) << 21) | (static_cast<size_t>(data[7] & 0x7f) << 14) |
+                     (static_cast<size_t>(data[8] & 0x7f) << 7) | static_cast<size_t>(data[9] & 0x7f);
+    tagSize += ID3V2_HEADER_SIZE;
+    if (data[5] & ID3V2_FOOTER_PRESENT_FLAG) {
+        tagSize += ID3V2_HEADER_SIZE;
+    }
+    return tagSize;
+}
+
+/// The fields of an MPEG audio Layer III frame header used to build an index.
+struct Mp3FrameHeader {
+    /// Whether the frame is MPEG-1, rather than MPEG-2 or MPEG-2.5.
+    bool isMpeg1;
+
+    /// Whether the frame is single channel.
+    bool isMono;
+
+    /// The bitrate of the frame in kbps.
+    uint32_t bitrateKbps;
+
+    /// The sample rate of the frame in Hz.
+    uint32_t sampleRate;
+
+    /// The size of the frame in bytes, including the header.
+    size_t frameLength;
+};
+
+/**
+ * Parses an MPEG audio frame header. Only Layer III frames with a known bitrate and sample rate are accepted.
+ *
+ * @param data Pointer to the four bytes of the header.
+ * @param [out] frame The parsed fields.
+ * @return @c true if @c data is a supported frame header, else @c false.
+ */
+static bool parseMp3FrameHeader(const uint8_t* data, Mp3FrameHeader* frame) {
+    if (data[0] != 0xff || (data[1] & 0xe0) != 0xe0) {
+        return false;
+    }
+    uint32_t header = readUint32BigEndian(data);
+    uint32_t versionBits = (header >> 19) & 0x3;
+    uint32_t layerBits = (header >> 17) & 0x3;
+    uint32_t bitrateIndex = (header >> 12) & 0xf;
+    uint32_t sampleRateIndex = (header >> 10) & 0x3;
+    uint32_t padding = (header >> 9) & 0x1;
+
+    // Only Layer III (layer bits 01) is supported, with a known bitrate and sample rate.
+    const uint32_t versionReserved = 0x1;
+    const uint32_t layer3 = 0x1;
+    const uint32_t freeBitrateIndex = 0x0;
+    const uint32_t badBitrateIndex = 0xf;
+    const uint32_t reservedSampleRateIndex = 0x3;
+    if (versionBits == versionReserved || layerBits != layer3 || bitrateIndex == freeBitrateIndex ||
+        bitrateIndex == badBitrateIndex || sampleRateIndex == reservedSampleRateIndex) {
+        return false;
+    }
+
+    const uint32_t mpeg1 = 0x3;
+    const uint32_t mpeg2 = 0x2;
+    frame->isMpeg1 = versionBits == mpeg1;
+    frame->isMono = ((header >> 6) & 0x3) == 0x3;
+    frame->bitrateKbps =
+        frame->isMpeg1 ? MPEG1_LAYER3_BITRATES_KBPS[bitrateIndex] : MPEG2_LAYER3_BITRATES_KBPS[bitrateIndex];
+    frame->sampleRate = MPEG1_SAMPLE_RATES[sampleRateIndex];
+    if (!frame->isMpeg1) {
+        frame->sampleRate /= (versionBits == mpeg2) ? 2 : 4;
+    }
+    // A Layer III frame holds 1152 (MPEG-1) or 576 samples, i.e. 144 or 72 bytes per kbps per kHz.
+    size_t bytesPerFrameFactor = frame->isMpeg1 ? 144 : 72;
+    frame->frameLength = bytesPerFrameFactor * frame->bitrateKbps * 1000 / frame->sampleRate + padding;
+    return true;
+}
+
+SeekIndex::SeekPoint::SeekPoint(std::chrono::milliseconds time, uint64_t position) : time{time}, position{position} {
+}
+
+SeekIndex::SeekIndex() : m_startPosition{0}, m_positionsPerSecond{0} {
+}
+
+bool SeekIndex::buildFromMp3Header(const uint8_t* data, size_t size, SeekIndex* index) {
+    if (!data || !index) {
+        ACSDK_ERROR(LX("buildFromMp3HeaderFailed").d("reason", "nullParameter"));
+        return false;
+    }
+
+    size_t frameStart = getId3v2TagSize(data, size);
+    size_t scanEnd = std::min(size, frameStart + MAX_BYTES_TO_SCAN_FOR_FRAME_SYNC);
+    Mp3FrameHeader frame;
+    bool found = false;
+    while (!found && frameStart + MPEG_FRAME_HEADER_SIZE <= scanEnd) {
+        /*
+         * The 11 bit frame sync is a common byte pattern in other formats, so only accept a sync which is followed
+         * by a compatible frame header exactly one frame later.
+         */
+        Mp3FrameHeader nextFrame;
+        found = parseMp3FrameHeader(data + frameStart, &frame) &&
+                frameStart + frame.frameLength + MPEG_FRAME_HEADER_SIZE <= size &&
+                parseMp3FrameHeader(data + frameStart + frame.frameLength, &nextFrame) &&
+                nextFrame.isMpeg1 == frame.isMpeg1 && nextFrame.sampleRate == frame.sampleRate;
+        if (!found) {
+            ++frameStart;
+        }
+    }
+    if (!found) {
+        ACSDK_DEBUG9(LX("buildFromMp3HeaderFailed").d("reason", "validFrameNotFound"));
+        return false;
+    }
+
+    bool isMpeg1 = frame.isMpeg1;
+    bool isMono = frame.isMono;
+    uint32_t bitrateKbps = frame.bitrateKbps;
+    uint32_t sampleRate = frame.sampleRate;
+    uint64_t samplesPerFrame = isMpeg1 ? 1152 : 576;
+
+    // The Xing/Info header, if any, follows the side information of the first frame.
+    size_t sideInfoSize = isMpeg1 ? (isMono ? 17 : 32) : (isMono ? 9 : 17);
+    size_t xingStart = frameStart + MPEG_FRAME_HEADER_SIZE + sideInfoSize;
+    const size_t xingTagAndFlagsSize = 8;
+    if (xingStart + xingTagAndFlagsSize <= size &&
+        (std::memcmp(data + xingStart, "Xing", 4) == 0 || std::memcmp(data + xingStart, "Info", 4) == 0)) {
+        uint32_t flags = readUint32BigEndian(data + xingStart + 4);
+        size_t cursor = xingStart + xingTagAndFlagsSize;
+        uint64_t frames = 0;
+        uint64_t bytes = 0;
+        const uint8_t* toc = nullptr;
+        if ((flags & XING_FRAMES_FLAG) && cursor + 4 <= size) {
+            frames = readUint32BigEndian(data + cursor);
+            cursor += 4;
+        }
+        if ((flags & XING_BYTES_FLAG) && cursor + 4 <= size) {
+            bytes = readUint32BigEndian(data + cursor);
+            cursor += 4;
+        }
+        if ((flags & XING_TOC_FLAG) && cursor + XING_TOC_SIZE <= size) {
+            toc = data + cursor;
+        }
+        std::chrono::milliseconds duration(frames * samplesPerFrame * 1000 / sampleRate);
+        if (frames && bytes && toc) {
+            SeekIndex result;
+            for (size_t i = 0; i < XING_TOC_SIZE; ++i) {
+                result.addSeekPoint(
+                    std::chrono::milliseconds(duration.count() * i / XING_TOC_SIZE),
+                    frameStart + toc[i] * bytes / XING_TOC_SCALE);
+            }
+            *index = result;
+            ACSDK_DEBUG9(LX("builtFromXingToc").d("durationMs", duration.count()).d("bytes", bytes));
+            return true;
+        }
+        if (frames && bytes && duration.count() > 0) {
+            // No table of contents, so assume the average bitrate holds throughout.
+            index->setConstantRate(frameStart, bytes * 1000 / duration.count());
+            ACSDK_DEBUG9(LX("builtFromXingAverageBitrate").d("durationMs", duration.count()).d("bytes", bytes));
+            return true;
+        }
+    }
+
+    index->setConstantRate(frameStart, bitrateKbps * 1000 / 8);
+    ACSDK_DEBUG9(LX("builtFromConstantBitrate").d("bitrateKbps", bitrateKbps).d("sampleRate", sampleRate));
+    return true;
+}
+
+void SeekIndex::addSeekPoint(std::chrono::milliseconds time, uint64_t position) {
+    SeekPoint seekPoint(time, position);
+    auto it = std::upper_bound(
+        m_seekPoints.begin(), m_seekPoints.end(), seekPoint, [](const SeekPoint& lhs, const SeekPoint& rhs) {
+            return lhs.time < rhs.time;
+        });
+    m_seekPoints.insert(it, seekPoint);
+    m_positionsPerSecond = 0;
+}
+
+void SeekIndex::setConstantRate(uint64_t startPosition, uint64_t positionsPerSecond) {
+    m_seekPoints.clear();
+    m_startPosition = startPosition;
+    m_positionsPerSecond = positionsPerSecond;
+}
+
+bool SeekIndex::empty() const {
+    return m_seekPoints.empty() && 0 == m_positionsPerSecond;
+}
+
+SeekIndex::SeekPoint SeekIndex::lookup(std::chrono::milliseconds offset) const {
+    if (offset < std::chrono::milliseconds::zero()) {
+        offset = std::chrono::milliseconds::zero();
+    }
+    if (m_positionsPerSecond) {
+        return SeekPoint(offset, m_startPosition + offset.count() * m_positionsPerSecond / 1000);
+    }
+    auto it = std::upper_bound(
+        m_seekPoints.begin(), m_seekPoints.end(), offset, [](std::chrono::milliseconds time, const SeekPoint& point) {
+            return time < point.time;
+        });
+    if (it == m_seekPoints.begin()) {
+        return SeekPoint();
+    }
+    return *(--it);
+}
+
+}  // namespace playlistParser
+}  // namespace alexaClientSDK
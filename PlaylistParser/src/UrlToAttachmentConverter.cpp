@@ -17,6 +17,9 @@
 
 #include "PlaylistParser/UrlToAttachmentConverter.h"
 
+#include <algorithm>
+#include <unordered_set>
+
 #include <AVSCommon/Utils/Logger/Logger.h>
 
 namespace alexaClientSDK {
@@ -39,6 +42,33 @@ static const size_t CHUNK_SIZE{avsCommon::avs::attachment::InProcessAttachment::
 
 static const std::chrono::milliseconds TIME_TO_WAIT_BETWEEN_BLOCKED_WRITES{100};
 
+/// The number of leading bytes of a media URL to fetch when looking for metadata from which to build a @c SeekIndex.
+static const size_t SEEK_INDEX_PROBE_SIZE = 16 * 1024;
+
+/// Timeout for each read of the leading bytes of a media URL.
+static const std::chrono::seconds TIMEOUT_FOR_SEEK_INDEX_PROBE_READS{2};
+
+/// Media types of MPEG audio, for which a @c SeekIndex may be built.
+static const std::unordered_set<std::string> MP3_MEDIA_TYPES = {
+    "audio/mpeg", "audio/mp3", "audio/mpeg3", "audio/x-mpeg"};
+
+/// Media types which say nothing about the content, so the leading bytes must be probed to find out.
+static const std::unordered_set<std::string> UNKNOWN_MEDIA_TYPES = {
+    "", "application/octet-stream", "binary/octet-stream"};
+
+/**
+ * Checks whether a Content-Type may describe MPEG audio.
+ *
+ * @param contentType The value of the Content-Type header, which may be empty.
+ * @return @c true if the content is MPEG audio or of unknown type, else @c false.
+ */
+static bool mayBeMp3(std::string contentType) {
+    contentType = contentType.substr(0, contentType.find(';'));
+    contentType.erase(std::remove(contentType.begin(), contentType.end(), ' '), contentType.end());
+    std::transform(contentType.begin(), contentType.end(), contentType.begin(), ::tolower);
+    return MP3_MEDIA_TYPES.count(contentType) || UNKNOWN_MEDIA_TYPES.count(contentType);
+}
+
 static const std::chrono::milliseconds UNVALID_DURATION =
     avsCommon::utils::playlistParser::PlaylistParserObserverInterface::INVALID_DURATION;
 
@@ -75,7 +105,8 @@ UrlContentToAttachmentConverter::UrlContentToAttachmentConverter(
         m_observer{observer},
         m_shuttingDown{false},
         m_runningTotal{0},
-        m_startedStreaming{false} {
+        m_startedStreaming{false},
+        m_startStreamingPointSet{false} {
     m_playlistParser = PlaylistParser::create(m_contentFetcherFactory);
     m_startStreamingPointFuture = m_startStreamingPointPromise.get_future();
     m_stream = std::make_shared<avsCommon::avs::attachment::InProcessAttachment>(url);
@@ -98,27 +129,34 @@ void UrlContentToAttachmentConverter::onPlaylistEntryParsed(
     avsCommon::utils::playlistParser::PlaylistParseResult parseResult,
     std::chrono::milliseconds duration) {
     std::lock_guard<std::mutex> lock{m_mutex};
+    /*
+     * The offset into this entry at which streaming should begin. This is only non-zero for the first entry streamed
+     * when its duration is unknown, in which case the offset is resolved once the content of the entry is inspected.
+     */
+    std::chrono::milliseconds offsetWithinEntry = std::chrono::milliseconds::zero();
+    std::chrono::milliseconds entryStartPoint = m_runningTotal;
     if (!m_startedStreaming) {
         if (m_desiredStreamPoint.count() > 0) {
             if (duration == UNVALID_DURATION) {
-                m_startStreamingPointPromise.set_value(m_runningTotal);
+                offsetWithinEntry = m_desiredStreamPoint - m_runningTotal;
                 // Allow to start streaming below
             } else if (m_runningTotal + duration <= m_desiredStreamPoint) {
                 m_runningTotal += duration;
                 return;
             } else {
-                m_startStreamingPointPromise.set_value(m_runningTotal);
+                setStartStreamingPointLocked(m_runningTotal);
                 m_runningTotal += duration;
                 // Allow to begin streaming below
             }
         } else {
-            m_startStreamingPointPromise.set_value(std::chrono::seconds::zero());
+            setStartStreamingPointLocked(std::chrono::milliseconds::zero());
         }
     }
     m_startedStreaming = true;
     switch (parseResult) {
         case avsCommon::utils::playlistParser::PlaylistParseResult::ERROR:
             ACSDK_DEBUG9(LX("onPlaylistEntryParsed").d("status", parseResult));
+            setStartStreamingPointLocked(entryStartPoint);
             m_executor.submit([this]() {
                 ACSDK_DEBUG9(LX("closingWriter"));
                 m_streamWriter->close();
@@ -130,8 +168,8 @@ void UrlContentToAttachmentConverter::onPlaylistEntryParsed(
             break;
         case avsCommon::utils::playlistParser::PlaylistParseResult::SUCCESS:
             ACSDK_DEBUG9(LX("onPlaylistEntryParsed").d("status", parseResult));
-            m_executor.submit([this, url]() {
-                if (!writeUrlContentIntoStream(url)) {
+            m_executor.submit([this, url, entryStartPoint, offsetWithinEntry]() {
+                if (!writeUrlContentIntoStream(url, entryStartPoint, offsetWithinEntry)) {
                     ACSDK_ERROR(LX("writeUrlContentToStreamFailed"));
                     std::lock_guard<std::mutex> lock{m_mutex};
                     if (m_observer) {
@@ -144,8 +182,8 @@ void UrlContentToAttachmentConverter::onPlaylistEntryParsed(
             break;
         case avsCommon::utils::playlistParser::PlaylistParseResult::STILL_ONGOING:
             ACSDK_DEBUG9(LX("onPlaylistEntryParsed").d("status", parseResult));
-            m_executor.submit([this, url]() {
-                if (!writeUrlContentIntoStream(url)) {
+            m_executor.submit([this, url, entryStartPoint, offsetWithinEntry]() {
+                if (!writeUrlContentIntoStream(url, entryStartPoint, offsetWithinEntry)) {
                     ACSDK_ERROR(LX("writeUrlContentToStreamFailed").d("info", "closingWriter"));
                     m_streamWriter->close();
                     std::lock_guard<std::mutex> lock{m_mutex};
@@ -156,25 +194,125 @@ void UrlContentToAttachmentConverter::onPlaylistEntryParsed(
             });
             break;
         default:
+            setStartStreamingPointLocked(entryStartPoint);
             return;
     }
 }
 
-bool UrlContentToAttachmentConverter::writeUrlContentIntoStream(std::string url) {
+void UrlContentToAttachmentConverter::setStartStreamingPointLocked(std::chrono::milliseconds startStreamingPoint) {
+    if (m_startStreamingPointSet) {
+        return;
+    }
+    m_startStreamingPointSet = true;
+    m_startStreamingPointPromise.set_value(startStreamingPoint);
+}
+
+bool UrlContentToAttachmentConverter::buildSeekIndex(const std::string& url, SeekIndex* index) {
+    auto contentFetcher = m_contentFetcherFactory->create(url);
+    if (!contentFetcher) {
+        return false;
+    }
+    auto httpContent = contentFetcher->getContentInRange(0, SEEK_INDEX_PROBE_SIZE - 1);
+    if (!httpContent || !httpContent->dataStream) {
+        ACSDK_DEBUG9(LX("buildSeekIndexFailed").d("reason", "noContent"));
+        return false;
+    }
+    auto statusCode = httpContent->statusCode.get();
+    if (statusCode != avsCommon::utils::HTTP_STATUS_CODE_SUCCESS_OK &&
+        statusCode != avsCommon::utils::HTTP_STATUS_CODE_SUCCESS_PARTIAL_CONTENT) {
+        ACSDK_DEBUG9(LX("buildSeekIndexFailed").d("reason", "badStatusCode").d("statusCode", statusCode));
+        return false;
+    }
+    auto contentType = httpContent->contentType.get();
+    if (!mayBeMp3(contentType)) {
+        ACSDK_DEBUG9(LX("buildSeekIndexFailed").d("reason", "notMpegAudio").d("contentType", contentType));
+        return false;
+    }
+    auto reader = httpContent->dataStream->createReader(avsCommon::avs::attachment::AttachmentReader::Policy::BLOCKING);
+    if (!reader) {
+        ACSDK_DEBUG9(LX("buildSeekIndexFailed").d("reason", "failedToCreateStreamReader"));
+        return false;
+    }
+    /*
+     * A server which ignores the Range request will send the entire body, so stop reading once enough has been read.
+     * Destroying the fetcher aborts the rest of the transfer.
+     */
+    std::vector<uint8_t> probe(SEEK_INDEX_PROBE_SIZE, 0);
+    size_t probeSize = 0;
+    bool done = false;
+    while (!done && !m_shuttingDown && probeSize < probe.size()) {
+        avsCommon::avs::attachment::AttachmentReader::ReadStatus readStatus;
+        probeSize += reader->read(
+            probe.data() + probeSize, probe.size() - probeSize, &readStatus, TIMEOUT_FOR_SEEK_INDEX_PROBE_READS);
+        switch (readStatus) {
+            case avsCommon::avs::attachment::AttachmentReader::ReadStatus::OK:
+            case avsCommon::avs::attachment::AttachmentReader::ReadStatus::OK_WOULDBLOCK:
+                break;
+            default:
+                done = true;
+                break;
+        }
+    }
+    return SeekIndex::buildFromMp3Header(probe.data(), probeSize, index);
+}
+
+bool UrlContentToAttachmentConverter::writeUrlContentIntoStream(
+    std::string url,
+    std::chrono::milliseconds entryStartPoint,
+    std::chrono::milliseconds offsetWithinEntry) {
     /*
      * TODO: ACSDK-826 We currently copy from one SDS with the individual URL data into a master SDS. We could probably
      * optimize this to avoid the extra copy.
      */
     ACSDK_DEBUG9(LX("writeUrlContentIntoStream").d("info", "beginning"));
-    auto contentFetcher = m_contentFetcherFactory->create(url);
-    auto httpContent =
-        contentFetcher->getContent(avsCommon::sdkInterfaces::HTTPContentFetcherInterface::FetchOptions::ENTIRE_BODY);
+    std::unique_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterface> contentFetcher;
+    std::unique_ptr<avsCommon::utils::HTTPContent> httpContent;
+    long statusCode = 0;
+    std::chrono::milliseconds startPoint = entryStartPoint;
+
+    // Rather than streaming the entry from its beginning, use an HTTP Range request to start close to the offset.
+    SeekIndex seekIndex;
+    if (offsetWithinEntry > std::chrono::milliseconds::zero() && buildSeekIndex(url, &seekIndex)) {
+        auto seekPoint = seekIndex.lookup(offsetWithinEntry);
+        contentFetcher = m_contentFetcherFactory->create(url);
+        if (contentFetcher) {
+            httpContent = contentFetcher->getContentInRange(seekPoint.position);
+        }
+        if (httpContent) {
+            statusCode = httpContent->statusCode.get();
+            if (avsCommon::utils::HTTP_STATUS_CODE_SUCCESS_PARTIAL_CONTENT == statusCode) {
+                ACSDK_DEBUG9(LX("rangeRequestHonored")
+                                 .d("offsetMs", seekPoint.time.count())
+                                 .d("byteOffset", seekPoint.position));
+                startPoint += seekPoint.time;
+            } else if (avsCommon::utils::HTTP_STATUS_CODE_SUCCESS_OK != statusCode) {
+                ACSDK_DEBUG9(LX("rangeRequestFailed").d("statusCode", statusCode));
+                httpContent.reset();
+            }
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        setStartStreamingPointLocked(startPoint);
+    }
+
     if (!httpContent) {
-        ACSDK_ERROR(LX("getContentFailed").d("reason", "nullHTTPContentReceived"));
-        return false;
+        contentFetcher = m_contentFetcherFactory->create(url);
+        if (!contentFetcher) {
+            ACSDK_ERROR(LX("getContentFailed").d("reason", "nullContentFetcher"));
+            return false;
+        }
+        httpContent = contentFetcher->getContent(
+            avsCommon::sdkInterfaces::HTTPContentFetcherInterface::FetchOptions::ENTIRE_BODY);
+        if (!httpContent) {
+            ACSDK_ERROR(LX("getContentFailed").d("reason", "nullHTTPContentReceived"));
+            return false;
+        }
+        statusCode = httpContent->statusCode.get();
     }
-    if (!(*httpContent)) {
-        ACSDK_ERROR(LX("getContentFailed").d("reason", "badHTTPContentReceived"));
+    if (statusCode != avsCommon::utils::HTTP_STATUS_CODE_SUCCESS_OK &&
+        statusCode != avsCommon::utils::HTTP_STATUS_CODE_SUCCESS_PARTIAL_CONTENT) {
+        ACSDK_ERROR(LX("getContentFailed").d("reason", "badHTTPContentReceived").d("statusCode", statusCode));
         return false;
     }
     if (!httpContent->dataStream) {
@@ -266,9 +404,8 @@ void UrlContentToAttachmentConverter::doShutdown() {
     m_playlistParser->shutdown();
     m_playlistParser.reset();
     m_streamWriter.reset();
-    if (!m_startedStreaming) {
-        m_startStreamingPointPromise.set_value(std::chrono::seconds::zero());
-    }
+    std::lock_guard<std::mutex> lock{m_mutex};
+    setStartStreamingPointLocked(std::chrono::milliseconds::zero());
 }
 
 }  // namespace playlistParser
@@ -0,0 +1,187 @@
+/*
+ * PlaylistLineReaderTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <AVSCommon/Utils/LibcurlUtils/LibCurlHttpContentFetcher.h>
+
+#include "Common/LocalHttpServer.h"
+#include "PlaylistParser/PlaylistLineReader.h"
+
+namespace alexaClientSDK {
+namespace playlistParser {
+namespace test {
+
+using namespace avsCommon::avs::attachment;
+using namespace avsCommon::sdkInterfaces;
+using namespace avsCommon::utils;
+using namespace avsCommon::utils::libcurlUtils;
+
+/// The path of the playlist on the local server.
+static const std::string PLAYLIST_PATH = "/playlist.m3u";
+
+/// The content type of the playlists served.
+static const std::string M3U_CONTENT_TYPE = "audio/x-mpegurl";
+
+/// A playlist with both "\n" and "\r\n" line endings and no final line ending.
+static const std::string MIXED_LINE_ENDINGS_PLAYLIST =
+    "#EXTM3U\r\n"
+    "#EXTINF:10,first\n"
+    "http://127.0.0.1/first.mp3\r\n"
+    "\n"
+    "http://127.0.0.1/second.mp3";
+
+/// How long the server holds back the end of a playlist in @c linesArriveBeforeTheDownloadEnds.
+static const std::chrono::milliseconds BODY_DELAY(2000);
+
+/// The longest line kept by the readers in @c longLinesAreSkipped.
+static const size_t SHORT_MAX_LINE_LENGTH = 32;
+
+/**
+ * Fetches a playlist from a local server and wraps it in a @c PlaylistLineReader, the way @c PlaylistParser does.
+ */
+class PlaylistLineReaderTest : public ::testing::Test {
+protected:
+    /**
+     * Starts a local server which serves @c body.
+     *
+     * @param body The playlist to serve.
+     * @param bodyDelay How long to hold back the end of the playlist after sending it.
+     */
+    void serve(const std::string& body, std::chrono::milliseconds bodyDelay = std::chrono::milliseconds::zero());
+
+    /**
+     * Starts fetching the playlist from the local server.
+     *
+     * @param maxLineLength The longest line to keep.
+     * @return The reader of the playlist, or @c nullptr on failure.
+     */
+    std::unique_ptr<PlaylistLineReader> fetch(size_t maxLineLength = PlaylistLineReader::DEFAULT_MAX_LINE_LENGTH);
+
+    /// The local server.
+    std::unique_ptr<acl::test::LocalHttpServer> m_server;
+
+    /// The fetcher of the playlist, which must outlive the download.
+    std::unique_ptr<LibCurlHttpContentFetcher> m_fetcher;
+
+    /// The content being fetched, which must outlive the download.
+    std::unique_ptr<HTTPContent> m_content;
+};
+
+void PlaylistLineReaderTest::serve(const std::string& body, std::chrono::milliseconds bodyDelay) {
+    m_server =
+        acl::test::LocalHttpServer::create(HTTP_STATUS_CODE_SUCCESS_OK, std::chrono::milliseconds::zero(), bodyDelay);
+    ASSERT_TRUE(m_server);
+    m_server->setResponseBody(M3U_CONTENT_TYPE, body);
+}
+
+std::unique_ptr<PlaylistLineReader> PlaylistLineReaderTest::fetch(size_t maxLineLength) {
+    m_fetcher.reset(new LibCurlHttpContentFetcher(m_server->getUrl() + PLAYLIST_PATH));
+    m_content = m_fetcher->getContent(HTTPContentFetcherInterface::FetchOptions::ENTIRE_BODY);
+    if (!m_content || !*m_content) {
+        return nullptr;
+    }
+    auto reader = m_content->dataStream->createReader(AttachmentReader::Policy::BLOCKING);
+    return PlaylistLineReader::create(std::move(reader), maxLineLength);
+}
+
+/**
+ * Tests that lines ending in "\n" and "\r\n" are both split correctly, including a last line with no line ending.
+ */
+TEST_F(PlaylistLineReaderTest, splitsLinesWithMixedLineEndings) {
+    serve(MIXED_LINE_ENDINGS_PLAYLIST);
+    auto reader = fetch();
+    ASSERT_TRUE(reader);
+    std::string line;
+    ASSERT_TRUE(reader->readLine(&line));
+    EXPECT_EQ("#EXTM3U", line);
+    ASSERT_TRUE(reader->readLine(&line));
+    EXPECT_EQ("#EXTINF:10,first", line);
+    ASSERT_TRUE(reader->readLine(&line));
+    EXPECT_EQ("http://127.0.0.1/first.mp3", line);
+    ASSERT_TRUE(reader->readLine(&line));
+    EXPECT_EQ("", line);
+    ASSERT_TRUE(reader->readLine(&line));
+    EXPECT_EQ("http://127.0.0.1/second.mp3", line);
+    EXPECT_FALSE(reader->readLine(&line));
+    EXPECT_FALSE(reader->hasError());
+    EXPECT_EQ(1u, m_server->getNumRequestsServed());
+}
+
+/**
+ * Tests that the lines of a playlist can be read before the server has finished sending it.
+ */
+TEST_F(PlaylistLineReaderTest, linesArriveBeforeTheDownloadEnds) {
+    serve(MIXED_LINE_ENDINGS_PLAYLIST, BODY_DELAY);
+    auto start = std::chrono::steady_clock::now();
+    auto reader = fetch();
+    ASSERT_TRUE(reader);
+    std::string line;
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(reader->readLine(&line));
+    }
+    EXPECT_EQ("", line);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, BODY_DELAY);
+
+    // The last line has no line ending, so it is only complete once the download ends.
+    ASSERT_TRUE(reader->readLine(&line));
+    EXPECT_EQ("http://127.0.0.1/second.mp3", line);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, BODY_DELAY);
+    EXPECT_FALSE(reader->readLine(&line));
+    EXPECT_FALSE(reader->hasError());
+}
+
+/**
+ * Tests that lines longer than the maximum line length are skipped, and the lines around them are still read.
+ */
+TEST_F(PlaylistLineReaderTest, longLinesAreSkipped) {
+    std::string longLine = "http://127.0.0.1/" + std::string(SHORT_MAX_LINE_LENGTH * 4, 'a') + ".mp3";
+    serve("#EXTM3U\n" + longLine + "\nhttp://127.0.0.1/short.mp3\n");
+    auto reader = fetch(SHORT_MAX_LINE_LENGTH);
+    ASSERT_TRUE(reader);
+    std::string line;
+    ASSERT_TRUE(reader->readLine(&line));
+    EXPECT_EQ("#EXTM3U", line);
+    ASSERT_TRUE(reader->readLine(&line));
+    EXPECT_EQ("http://127.0.0.1/short.mp3", line);
+    EXPECT_FALSE(reader->readLine(&line));
+    EXPECT_FALSE(reader->hasError());
+}
+
+/**
+ * Tests that the rest of a playlist can be read as a whole after some of its lines have been read.
+ */
+TEST_F(PlaylistLineReaderTest, readRemainingReturnsTheUnreadContent) {
+    serve(MIXED_LINE_ENDINGS_PLAYLIST);
+    auto reader = fetch();
+    ASSERT_TRUE(reader);
+    std::string line;
+    ASSERT_TRUE(reader->readLine(&line));
+    EXPECT_EQ("#EXTM3U", line);
+    std::string remaining;
+    ASSERT_TRUE(reader->readRemaining(&remaining));
+    EXPECT_EQ(MIXED_LINE_ENDINGS_PLAYLIST.substr(std::string("#EXTM3U\r\n").size()), remaining);
+    EXPECT_FALSE(reader->hasError());
+}
+
+}  // namespace test
+}  // namespace playlistParser
+}  // namespace alexaClientSDK
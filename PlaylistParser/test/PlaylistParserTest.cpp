@@ -17,11 +17,15 @@
 
 #include <memory>
 #include <chrono>
+#include <future>
+#include <iostream>
 #include <mutex>
 #include <condition_variable>
 #include <thread>
 #include <unordered_map>
 
+#include <sys/resource.h>
+
 #include <gmock/gmock.h>
 #include <AVSCommon/SDKInterfaces/HTTPContentFetcherInterface.h>
 #include <AVSCommon/Utils/Logger/Logger.h>
@@ -227,6 +231,52 @@ static const std::vector<std::chrono::milliseconds> TEST_HLS_LIVE_STREAM_DURATIO
 
 static const size_t NUM_PARSES_EXPECTED_WHEN_NO_PARSING = 1;
 
+/// Long time out for when callbacks are expected to occur.
+static const auto LONG_TIMEOUT = std::chrono::seconds(5);
+
+/// A large M3U playlist, generated by the tests which use it and streamed to the parser as it would be downloaded.
+static const std::string TEST_LARGE_M3U_PLAYLIST_URL{"http://sanjayisthecoolest.com/large.m3u"};
+
+/// A large PLS playlist, generated by the tests which use it and streamed to the parser as it would be downloaded.
+static const std::string TEST_LARGE_PLS_PLAYLIST_URL{"http://sanjayisthecoolest.com/large.pls"};
+
+/// The prefix of the URLs of the entries of the large playlists.
+static const std::string TEST_LARGE_PLAYLIST_ENTRY_PREFIX{"http://sanjayisthecoolest.com/chapter"};
+
+/// The number of bytes of a streamed playlist written to its attachment at a time.
+static const size_t STREAMED_CHUNK_SIZE = 4096;
+
+/// The content of the streamed playlists, by URL.
+static std::unordered_map<std::string, std::string> urlsToStreamedContent;
+
+/**
+ * If valid, streamed playlists stop after their first half until this is ready, so that tests can check what is parsed
+ * before the whole playlist has been received.
+ */
+static std::shared_future<void> streamedContentSecondHalfReleased;
+
+/**
+ * Generates a large playlist.
+ *
+ * @param numEntries The number of entries.
+ * @param isPLS Whether to generate a PLS playlist rather than an M3U playlist.
+ * @return The playlist.
+ */
+static std::string generateLargePlaylist(size_t numEntries, bool isPLS) {
+    std::string playlist = isPLS ? "[playlist]\nNumberOfEntries=" + std::to_string(numEntries) + "\n" : "#EXTM3U\n";
+    for (size_t i = 0; i < numEntries; ++i) {
+        auto number = std::to_string(i + 1);
+        if (isPLS) {
+            playlist += "File" + number + "=" + TEST_LARGE_PLAYLIST_ENTRY_PREFIX + number + ".mp3\n";
+            playlist += "Length" + number + "=-1\n";
+        } else {
+            playlist += "#EXTINF:-1,Chapter " + number + "\n";
+            playlist += TEST_LARGE_PLAYLIST_ENTRY_PREFIX + number + ".mp3\n";
+        }
+    }
+    return playlist;
+}
+
 static const std::unordered_map<std::string, std::string> urlsToContentTypes{
     // Valid playlist content types
     {TEST_M3U_PLAYLIST_URL, "audio/mpegurl"},
@@ -235,6 +285,8 @@ static const std::unordered_map<std::string, std::string> urlsToContentTypes{
     {TEST_PLS_PLAYLIST_URL, "audio/x-scpls"},
     {TEST_HLS_RECURSIVE_PLAYLIST_URL, "audio/mpegurl"},
     {TEST_HLS_LIVE_STREAM_PLAYLIST_URL, "audio/mpegurl"},
+    {TEST_LARGE_M3U_PLAYLIST_URL, "audio/mpegurl"},
+    {TEST_LARGE_PLS_PLAYLIST_URL, "audio/x-scpls"},
     // Not playlist content types
     {"http://stream.radiotime.com/sample.mp3", "audio/mpeg"},
     {"http://live-mp3-128.kexp.org", "audio/mpeg"},
@@ -262,7 +314,20 @@ public:
     MockContentFetcher(const std::string& url) : m_url{url} {
     }
 
+    ~MockContentFetcher() {
+        if (m_streamThread.joinable()) {
+            m_streamThread.join();
+        }
+    }
+
     std::unique_ptr<avsCommon::utils::HTTPContent> getContent(FetchOptions fetchOption) {
+        if (fetchOption == FetchOptions::ENTIRE_BODY && urlsToStreamedContent.count(m_url)) {
+            return createContent("", getStreamedContent());
+        }
+        if (fetchOption == FetchOptions::CONTENT_TYPE &&
+            0 == m_url.compare(0, TEST_LARGE_PLAYLIST_ENTRY_PREFIX.size(), TEST_LARGE_PLAYLIST_ENTRY_PREFIX)) {
+            return createContent("audio/mpeg", nullptr);
+        }
         if (fetchOption == FetchOptions::CONTENT_TYPE) {
             auto it1 = urlsToContentTypes.find(m_url);
             if (it1 == urlsToContentTypes.end()) {
@@ -307,6 +372,59 @@ public:
     }
 
 private:
+    /**
+     * Creates a successful @c HTTPContent.
+     *
+     * @param contentType The content type.
+     * @param stream The body, if fetched.
+     * @return The content.
+     */
+    static std::unique_ptr<avsCommon::utils::HTTPContent> createContent(
+        const std::string& contentType,
+        std::shared_ptr<avsCommon::avs::attachment::InProcessAttachment> stream) {
+        std::promise<long> statusPromise;
+        statusPromise.set_value(200);
+        std::promise<std::string> contentTypePromise;
+        contentTypePromise.set_value(contentType);
+        return avsCommon::utils::memory::make_unique<avsCommon::utils::HTTPContent>(avsCommon::utils::HTTPContent{
+            statusPromise.get_future(), contentTypePromise.get_future(), stream});
+    }
+
+    /**
+     * Starts a thread writing a streamed playlist into an attachment a chunk at a time.
+     *
+     * @return The attachment.
+     */
+    std::shared_ptr<avsCommon::avs::attachment::InProcessAttachment> getStreamedContent() {
+        static int id = 0;
+        auto stream =
+            std::make_shared<avsCommon::avs::attachment::InProcessAttachment>("streamed" + std::to_string(id++));
+        std::shared_ptr<avsCommon::avs::attachment::AttachmentWriter> writer = stream->createWriter();
+        const std::string& content = urlsToStreamedContent[m_url];
+        m_streamThread = std::thread([writer, &content]() {
+            size_t written = 0;
+            bool released = false;
+            while (written < content.size()) {
+                if (!released && written >= content.size() / 2) {
+                    if (streamedContentSecondHalfReleased.valid()) {
+                        streamedContentSecondHalfReleased.wait_for(LONG_TIMEOUT);
+                    }
+                    released = true;
+                }
+                auto writeStatus = avsCommon::avs::attachment::AttachmentWriter::WriteStatus::OK;
+                auto size = std::min(STREAMED_CHUNK_SIZE, content.size() - written);
+                written += writer->write(content.data() + written, size, &writeStatus);
+                if (writeStatus == avsCommon::avs::attachment::AttachmentWriter::WriteStatus::OK_BUFFER_FULL) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                } else if (writeStatus != avsCommon::avs::attachment::AttachmentWriter::WriteStatus::OK) {
+                    break;
+                }
+            }
+            writer->close();
+        });
+        return stream;
+    }
+
     std::shared_ptr<avsCommon::avs::attachment::InProcessAttachment> writeStringIntoAttachment(
         const std::string& string) {
         static int id = 0;
@@ -325,6 +443,9 @@ private:
     };
 
     std::string m_url;
+
+    /// The thread writing a streamed playlist.
+    std::thread m_streamThread;
 };
 
 /// A mock factory that creates mock content fetchers
@@ -373,6 +494,20 @@ public:
         return m_parseResults;
     }
 
+    /**
+     * Waits for the PlaylistParserObserverInterface##onPlaylistEntryParsed() call at least N times.
+     *
+     * @param numCallbacksExpected The number of callbacks expected.
+     * @param timeout The amount of time to wait for the calls.
+     * @return The parse results that actually occurred.
+     */
+    std::vector<ParseResult> waitForAtLeastNCallbacks(size_t numCallbacksExpected, std::chrono::milliseconds timeout) {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        m_callbackOccurred.wait_for(
+            lock, timeout, [this, numCallbacksExpected]() { return m_parseResults.size() >= numCallbacksExpected; });
+        return m_parseResults;
+    }
+
 private:
     /// The detection results that have occurred.
     std::vector<ParseResult> m_parseResults;
@@ -394,6 +529,8 @@ protected:
 
     void TearDown() {
         playlistParser->shutdown();
+        urlsToStreamedContent.clear();
+        streamedContentSecondHalfReleased = std::shared_future<void>();
     }
 
     /// A mock factory to create mock content fetchers
@@ -543,6 +680,65 @@ TEST_F(PlaylistParserTest, DISABLED_testParsingLiveStreamPlaylist) {
     }
 }
 
+/**
+ * Tests that a large M3U playlist is parsed as it is received.  The second half of the playlist is held back until the
+ * entries of the first half have been parsed, which they can only be if the parser does not wait for the whole
+ * playlist.
+ */
+TEST_F(PlaylistParserTest, testParsingLargePlaylistIncrementally) {
+    static const size_t NUM_ENTRIES = 5000;
+    urlsToStreamedContent[TEST_LARGE_M3U_PLAYLIST_URL] = generateLargePlaylist(NUM_ENTRIES, false);
+    std::promise<void> releaseSecondHalf;
+    streamedContentSecondHalfReleased = releaseSecondHalf.get_future().share();
+
+    ASSERT_TRUE(playlistParser->parsePlaylist(TEST_LARGE_M3U_PLAYLIST_URL, testObserver));
+    auto results = testObserver->waitForAtLeastNCallbacks(1, LONG_TIMEOUT);
+    ASSERT_FALSE(results.empty());
+    EXPECT_LT(results.size(), NUM_ENTRIES);
+    releaseSecondHalf.set_value();
+
+    results = testObserver->waitForNCallbacks(NUM_ENTRIES, LONG_TIMEOUT);
+    ASSERT_EQ(NUM_ENTRIES, results.size());
+    for (size_t i = 0; i < results.size(); ++i) {
+        ASSERT_EQ(results.at(i).url, TEST_LARGE_PLAYLIST_ENTRY_PREFIX + std::to_string(i + 1) + ".mp3");
+        if (i == results.size() - 1) {
+            ASSERT_EQ(results.at(i).parseResult, avsCommon::utils::playlistParser::PlaylistParseResult::SUCCESS);
+        } else {
+            ASSERT_EQ(results.at(i).parseResult, avsCommon::utils::playlistParser::PlaylistParseResult::STILL_ONGOING);
+        }
+    }
+}
+
+/**
+ * Benchmarks parsing of large M3U and PLS playlists, printing the time to the first entry and to the last, and the
+ * growth of the peak resident set size.  Disabled as it only prints its measurements.
+ */
+TEST_F(PlaylistParserTest, DISABLED_benchmarkParsingLargePlaylists) {
+    static const size_t NUM_ENTRIES = 100000;
+    for (auto isPLS : {false, true}) {
+        auto url = isPLS ? TEST_LARGE_PLS_PLAYLIST_URL : TEST_LARGE_M3U_PLAYLIST_URL;
+        urlsToStreamedContent[url] = generateLargePlaylist(NUM_ENTRIES, isPLS);
+        auto observer = std::make_shared<TestParserObserver>();
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        auto peakBefore = usage.ru_maxrss;
+
+        auto start = std::chrono::steady_clock::now();
+        ASSERT_TRUE(playlistParser->parsePlaylist(url, observer));
+        ASSERT_FALSE(observer->waitForAtLeastNCallbacks(1, LONG_TIMEOUT).empty());
+        auto first = std::chrono::steady_clock::now();
+        ASSERT_EQ(NUM_ENTRIES, observer->waitForNCallbacks(NUM_ENTRIES, std::chrono::seconds(60)).size());
+        auto last = std::chrono::steady_clock::now();
+        getrusage(RUSAGE_SELF, &usage);
+
+        std::cout << (isPLS ? "PLS" : "M3U") << " entries=" << NUM_ENTRIES << " playlistBytes="
+                  << urlsToStreamedContent[url].size() << " firstEntryUs="
+                  << std::chrono::duration_cast<std::chrono::microseconds>(first - start).count()
+                  << " lastEntryUs=" << std::chrono::duration_cast<std::chrono::microseconds>(last - start).count()
+                  << " peakRssGrowthKB=" << usage.ru_maxrss - peakBefore << std::endl;
+    }
+}
+
 }  // namespace test
 }  // namespace playlistParser
 }  // namespace alexaClientSDK
\ No newline at end of file
@@ -0,0 +1,247 @@
+/*
+ * SeekIndexTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <chrono>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "PlaylistParser/SeekIndex.h"
+
+namespace alexaClientSDK {
+namespace playlistParser {
+namespace test {
+
+/// Frame header of an MPEG-1 Layer III, 128 kbps, 44.1 kHz, stereo frame.
+static const std::vector<uint8_t> MPEG1_128KBPS_STEREO_FRAME_HEADER = {0xff, 0xfb, 0x90, 0x00};
+
+/// Frame header of an MPEG-1 Layer III, 128 kbps, 44.1 kHz, mono frame.
+static const std::vector<uint8_t> MPEG1_128KBPS_MONO_FRAME_HEADER = {0xff, 0xfb, 0x90, 0xc0};
+
+/// The length of a 128 kbps, 44.1 kHz MPEG-1 frame without padding, 144 * 128000 / 44100 bytes.
+static const size_t MPEG1_128KBPS_FRAME_LENGTH = 417;
+
+/// The byte rate of a 128 kbps stream.
+static const uint64_t BYTES_PER_SECOND_128KBPS = 16000;
+
+/// Side information size of an MPEG-1 stereo frame, which precedes a Xing header.
+static const size_t MPEG1_STEREO_SIDE_INFO_SIZE = 32;
+
+/// Side information size of an MPEG-1 mono frame, which precedes a Xing header.
+static const size_t MPEG1_MONO_SIDE_INFO_SIZE = 17;
+
+/// Number of frames in the generated Xing header, 1 hour of MPEG-1 audio at 44.1 kHz.
+static const uint32_t XING_FRAMES = 137813;
+
+/// Number of bytes in the generated Xing header.
+static const uint32_t XING_BYTES = 57600000;
+
+/// The duration of @c XING_FRAMES frames.
+static const std::chrono::milliseconds XING_DURATION(static_cast<uint64_t>(XING_FRAMES) * 1152 * 1000 / 44100);
+
+/// 45 minutes, a typical resume offset into a long stream.
+static const std::chrono::milliseconds FORTY_FIVE_MINUTES = std::chrono::minutes(45);
+
+/**
+ * Appends a big endian 32 bit value.
+ *
+ * @param value The value to append.
+ * @param data The buffer to append to.
+ */
+static void appendUint32BigEndian(uint32_t value, std::vector<uint8_t>* data) {
+    data->push_back(static_cast<uint8_t>(value >> 24));
+    data->push_back(static_cast<uint8_t>(value >> 16));
+    data->push_back(static_cast<uint8_t>(value >> 8));
+    data->push_back(static_cast<uint8_t>(value));
+}
+
+/**
+ * Builds the leading bytes of an MP3 file, with the header of a second frame following the first frame.
+ *
+ * @param id3TagBodySize The size of the body of a leading ID3v2 tag, or zero for no tag.
+ * @param frameHeader The header of the first frame.
+ * @param sideInfoSize The size of the side information of the first frame.
+ * @param withXing Whether the first frame carries a Xing header with frame count, byte count and table of contents.
+ * @return The generated bytes.
+ */
+static std::vector<uint8_t> buildMp3Header(
+    size_t id3TagBodySize,
+    const std::vector<uint8_t>& frameHeader,
+    size_t sideInfoSize,
+    bool withXing) {
+    std::vector<uint8_t> data;
+    if (id3TagBodySize) {
+        data = {'I', 'D', '3', 4, 0, 0};
+        data.push_back(static_cast<uint8_t>((id3TagBodySize >> 21) & 0x7f));
+        data.push_back(static_cast<uint8_t>((id3TagBodySize >> 14) & 0x7f));
+        data.push_back(static_cast<uint8_t>((id3TagBodySize >> 7) & 0x7f));
+        data.push_back(static_cast<uint8_t>(id3TagBodySize & 0x7f));
+        data.insert(data.end(), id3TagBodySize, 0);
+    }
+    size_t frameStart = data.size();
+    data.insert(data.end(), frameHeader.begin(), frameHeader.end());
+    data.insert(data.end(), sideInfoSize, 0);
+    if (withXing) {
+        data.insert(data.end(), {'X', 'i', 'n', 'g'});
+        appendUint32BigEndian(0x7, &data);
+        appendUint32BigEndian(XING_FRAMES, &data);
+        appendUint32BigEndian(XING_BYTES, &data);
+        for (size_t i = 0; i < 100; ++i) {
+            // A VBR stream whose second half is twice as dense as its first half.
+            data.push_back(static_cast<uint8_t>(i < 50 ? i * 256 / 150 : (256 / 3) + (i - 50) * 512 / 150));
+        }
+    }
+    data.resize(frameStart + MPEG1_128KBPS_FRAME_LENGTH, 0);
+    data.insert(data.end(), frameHeader.begin(), frameHeader.end());
+    data.insert(data.end(), 512, 0);
+    return data;
+}
+
+/**
+ * Verify that an empty index maps every offset to the beginning.
+ */
+TEST(SeekIndexTest, emptyIndexMapsToBeginning) {
+    SeekIndex index;
+    EXPECT_TRUE(index.empty());
+    auto seekPoint = index.lookup(FORTY_FIVE_MINUTES);
+    EXPECT_EQ(seekPoint.time, std::chrono::milliseconds::zero());
+    EXPECT_EQ(seekPoint.position, 0u);
+}
+
+/**
+ * Verify that lookups return the latest seek point that does not start after the offset, regardless of insertion
+ * order.
+ */
+TEST(SeekIndexTest, lookupReturnsPrecedingSeekPoint) {
+    SeekIndex index;
+    index.addSeekPoint(std::chrono::seconds(20), 2);
+    index.addSeekPoint(std::chrono::seconds(0), 0);
+    index.addSeekPoint(std::chrono::seconds(10), 1);
+    EXPECT_FALSE(index.empty());
+
+    EXPECT_EQ(index.lookup(std::chrono::seconds(0)).position, 0u);
+    EXPECT_EQ(index.lookup(std::chrono::milliseconds(9999)).position, 0u);
+    EXPECT_EQ(index.lookup(std::chrono::seconds(10)).position, 1u);
+    EXPECT_EQ(index.lookup(std::chrono::seconds(15)).time, std::chrono::seconds(10));
+    EXPECT_EQ(index.lookup(std::chrono::hours(1)).position, 2u);
+    EXPECT_EQ(index.lookup(std::chrono::milliseconds(-5)).position, 0u);
+}
+
+/**
+ * Verify that a constant rate index maps offsets linearly onto positions.
+ */
+TEST(SeekIndexTest, constantRate) {
+    SeekIndex index;
+    index.setConstantRate(100, BYTES_PER_SECOND_128KBPS);
+    auto seekPoint = index.lookup(FORTY_FIVE_MINUTES);
+    EXPECT_EQ(seekPoint.time, FORTY_FIVE_MINUTES);
+    EXPECT_EQ(seekPoint.position, 100 + 45 * 60 * BYTES_PER_SECOND_128KBPS);
+}
+
+/**
+ * Verify that a constant bitrate MP3 without a Xing header produces a constant rate index which skips the ID3 tag.
+ */
+TEST(SeekIndexTest, mp3ConstantBitrate) {
+    const size_t id3TagBodySize = 1000;
+    auto data = buildMp3Header(id3TagBodySize, MPEG1_128KBPS_STEREO_FRAME_HEADER, MPEG1_STEREO_SIDE_INFO_SIZE, false);
+    SeekIndex index;
+    ASSERT_TRUE(SeekIndex::buildFromMp3Header(data.data(), data.size(), &index));
+    auto seekPoint = index.lookup(FORTY_FIVE_MINUTES);
+    EXPECT_EQ(seekPoint.time, FORTY_FIVE_MINUTES);
+    EXPECT_EQ(seekPoint.position, 10 + id3TagBodySize + 45 * 60 * BYTES_PER_SECOND_128KBPS);
+}
+
+/**
+ * Verify that the Xing table of contents of a stereo stream is used.
+ */
+TEST(SeekIndexTest, mp3XingTableOfContentsStereo) {
+    auto data = buildMp3Header(0, MPEG1_128KBPS_STEREO_FRAME_HEADER, MPEG1_STEREO_SIDE_INFO_SIZE, true);
+    SeekIndex index;
+    ASSERT_TRUE(SeekIndex::buildFromMp3Header(data.data(), data.size(), &index));
+
+    // Entry 75 of the table of contents starts just after 45 minutes, so entry 74 must be used.
+    auto seekPoint = index.lookup(FORTY_FIVE_MINUTES);
+    EXPECT_EQ(seekPoint.time, std::chrono::milliseconds(XING_DURATION.count() * 74 / 100));
+    uint64_t tocEntry = (256 / 3) + (74 - 50) * 512 / 150;
+    EXPECT_EQ(seekPoint.position, tocEntry * XING_BYTES / 256);
+    EXPECT_LE(seekPoint.time, FORTY_FIVE_MINUTES);
+}
+
+/**
+ * Verify that the Xing header is found after the shorter side information of a mono stream.
+ */
+TEST(SeekIndexTest, mp3XingTableOfContentsMono) {
+    auto data = buildMp3Header(0, MPEG1_128KBPS_MONO_FRAME_HEADER, MPEG1_MONO_SIDE_INFO_SIZE, true);
+    SeekIndex index;
+    ASSERT_TRUE(SeekIndex::buildFromMp3Header(data.data(), data.size(), &index));
+    auto seekPoint = index.lookup(XING_DURATION / 2);
+    EXPECT_EQ(seekPoint.position, static_cast<uint64_t>(256 / 3) * XING_BYTES / 256);
+}
+
+/**
+ * Verify that data which is not MPEG Layer III audio does not produce an index.
+ */
+TEST(SeekIndexTest, nonMp3DataRejected) {
+    SeekIndex index;
+    std::vector<uint8_t> noSync(1024, 0);
+    EXPECT_FALSE(SeekIndex::buildFromMp3Header(noSync.data(), noSync.size(), &index));
+
+    // An ADTS (AAC) header shares the frame sync but has layer bits 00.
+    std::vector<uint8_t> adts = {0xff, 0xf1, 0x50, 0x80, 0x00, 0x1f, 0xfc};
+    EXPECT_FALSE(SeekIndex::buildFromMp3Header(adts.data(), adts.size(), &index));
+    EXPECT_FALSE(SeekIndex::buildFromMp3Header(nullptr, 0, &index));
+    EXPECT_TRUE(index.empty());
+}
+
+/**
+ * Verify that a frame sync which is not followed by another frame header one frame later is skipped in favor of the
+ * first frame which is.
+ */
+TEST(SeekIndexTest, mp3FalseFrameSyncSkipped) {
+    const size_t junkSize = 100;
+    std::vector<uint8_t> data(MPEG1_128KBPS_STEREO_FRAME_HEADER);
+    data.resize(junkSize, 0);
+    auto frames = buildMp3Header(0, MPEG1_128KBPS_STEREO_FRAME_HEADER, MPEG1_STEREO_SIDE_INFO_SIZE, false);
+    data.insert(data.end(), frames.begin(), frames.end());
+    SeekIndex index;
+    ASSERT_TRUE(SeekIndex::buildFromMp3Header(data.data(), data.size(), &index));
+    EXPECT_EQ(index.lookup(FORTY_FIVE_MINUTES).position, junkSize + 45 * 60 * BYTES_PER_SECOND_128KBPS);
+}
+
+/**
+ * Verify that a lone frame header, with no second frame header where the next frame should begin, is rejected.
+ */
+TEST(SeekIndexTest, mp3WithoutSecondFrameRejected) {
+    std::vector<uint8_t> data(MPEG1_128KBPS_STEREO_FRAME_HEADER);
+    data.resize(2 * MPEG1_128KBPS_FRAME_LENGTH, 0);
+    SeekIndex index;
+    EXPECT_FALSE(SeekIndex::buildFromMp3Header(data.data(), data.size(), &index));
+
+    // A second frame header with a different sample rate does not confirm the first.
+    data[MPEG1_128KBPS_FRAME_LENGTH] = 0xff;
+    data[MPEG1_128KBPS_FRAME_LENGTH + 1] = 0xfb;
+    data[MPEG1_128KBPS_FRAME_LENGTH + 2] = 0x94;
+    EXPECT_FALSE(SeekIndex::buildFromMp3Header(data.data(), data.size(), &index));
+
+    // A compatible one does.
+    data[MPEG1_128KBPS_FRAME_LENGTH + 2] = 0x90;
+    EXPECT_TRUE(SeekIndex::buildFromMp3Header(data.data(), data.size(), &index));
+}
+
+}  // namespace test
+}  // namespace playlistParser
+}  // namespace alexaClientSDK
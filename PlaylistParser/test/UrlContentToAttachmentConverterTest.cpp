@@ -0,0 +1,306 @@
+/*
+ * UrlContentToAttachmentConverterTest.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <AVSCommon/SDKInterfaces/HTTPContentFetcherInterfaceFactoryInterface.h>
+#include <AVSCommon/Utils/Memory/Memory.h>
+
+#include "PlaylistParser/UrlToAttachmentConverter.h"
+
+namespace alexaClientSDK {
+namespace playlistParser {
+namespace test {
+
+using namespace avsCommon::avs::attachment;
+using namespace avsCommon::sdkInterfaces;
+using namespace avsCommon::utils;
+
+/// The URL of the test media.
+static const std::string TEST_MEDIA_URL{"http://sanjayisthecoolest.com/audiobook.mp3"};
+
+/// Frame header of an MPEG-1 Layer III, 32 kbps, 44.1 kHz, stereo frame.
+static const std::vector<uint8_t> MPEG1_32KBPS_FRAME_HEADER = {0xff, 0xfb, 0x10, 0x00};
+
+/// The length of a frame with @c MPEG1_32KBPS_FRAME_HEADER, 144 * 32000 / 44100 bytes.
+static const uint64_t MPEG1_32KBPS_FRAME_LENGTH = 104;
+
+/// The byte rate of a 32 kbps stream.
+static const uint64_t BYTES_PER_SECOND_32KBPS = 4000;
+
+/// The total size of the test media, one hour long.
+static const uint64_t TEST_MEDIA_SIZE = BYTES_PER_SECOND_32KBPS * 60 * 60;
+
+/// The maximum number of bytes served per request, well below the capacity of an @c InProcessAttachment.
+static const size_t MAX_BYTES_SERVED = 32 * 1024;
+
+/// 45 minutes, a typical resume offset into a long stream.
+static const std::chrono::milliseconds FORTY_FIVE_MINUTES = std::chrono::minutes(45);
+
+/// Timeout for reads from the converted attachment.
+static const std::chrono::seconds READ_TIMEOUT{2};
+
+/**
+ * Generates the byte at a given position of the test media. The media starts with two frame headers, one frame apart,
+ * and the remaining bytes form a pattern from which their position can be checked.
+ *
+ * @param position The position of the byte.
+ * @return The value of the byte.
+ */
+static uint8_t mediaByteAt(uint64_t position) {
+    uint64_t positionInFrame = position % MPEG1_32KBPS_FRAME_LENGTH;
+    if (position < 2 * MPEG1_32KBPS_FRAME_LENGTH && positionInFrame < MPEG1_32KBPS_FRAME_HEADER.size()) {
+        return MPEG1_32KBPS_FRAME_HEADER[positionInFrame];
+    }
+    return static_cast<uint8_t>(position % 251);
+}
+
+/// A content fetcher serving generated MP3 media, which may or may not honor Range requests.
+class MockMediaContentFetcher : public HTTPContentFetcherInterface {
+public:
+    /**
+     * Constructor.
+     *
+     * @param honorRange Whether Range requests are honored.
+     * @param contentType The content type served.
+     * @param rangeRequests Counter of Range requests received.
+     */
+    MockMediaContentFetcher(bool honorRange, const std::string& contentType, std::atomic<int>* rangeRequests) :
+            m_honorRange{honorRange},
+            m_contentType{contentType},
+            m_rangeRequests{rangeRequests} {
+    }
+
+    std::unique_ptr<HTTPContent> getContent(FetchOptions fetchOption) override {
+        if (FetchOptions::CONTENT_TYPE == fetchOption) {
+            return createContent(HTTP_STATUS_CODE_SUCCESS_OK, m_contentType, nullptr);
+        }
+        return createContent(HTTP_STATUS_CODE_SUCCESS_OK, m_contentType, writeMediaIntoAttachment(0, END_OF_BODY));
+    }
+
+    std::unique_ptr<HTTPContent> getContentInRange(size_t firstByte, size_t lastByte) override {
+        ++(*m_rangeRequests);
+        if (!m_honorRange) {
+            return getContent(FetchOptions::ENTIRE_BODY);
+        }
+        return createContent(
+            HTTP_STATUS_CODE_SUCCESS_PARTIAL_CONTENT, m_contentType, writeMediaIntoAttachment(firstByte, lastByte));
+    }
+
+private:
+    /**
+     * Creates an @c HTTPContent.
+     *
+     * @param statusCode The status code of the response.
+     * @param contentType The content type of the response.
+     * @param dataStream The body of the response.
+     * @return The @c HTTPContent.
+     */
+    static std::unique_ptr<HTTPContent> createContent(
+        long statusCode,
+        const std::string& contentType,
+        std::shared_ptr<InProcessAttachment> dataStream) {
+        std::promise<long> statusPromise;
+        statusPromise.set_value(statusCode);
+        std::promise<std::string> contentTypePromise;
+        contentTypePromise.set_value(contentType);
+        return memory::make_unique<HTTPContent>(
+            HTTPContent{statusPromise.get_future(), contentTypePromise.get_future(), dataStream});
+    }
+
+    /**
+     * Writes up to @c MAX_BYTES_SERVED bytes of the media, starting at @c firstByte, into a new attachment.
+     *
+     * @param firstByte The position of the first byte to write.
+     * @param lastByte The position of the last byte to write.
+     * @return The attachment.
+     */
+    static std::shared_ptr<InProcessAttachment> writeMediaIntoAttachment(size_t firstByte, size_t lastByte) {
+        static int id = 0;
+        auto stream = std::make_shared<InProcessAttachment>("media" + std::to_string(id++));
+        auto writer = stream->createWriter();
+        uint64_t end = std::min<uint64_t>(TEST_MEDIA_SIZE, firstByte + MAX_BYTES_SERVED);
+        if (lastByte != END_OF_BODY) {
+            end = std::min<uint64_t>(end, lastByte + 1);
+        }
+        std::vector<uint8_t> data;
+        for (uint64_t position = firstByte; position < end; ++position) {
+            data.push_back(mediaByteAt(position));
+        }
+        AttachmentWriter::WriteStatus writeStatus;
+        writer->write(data.data(), data.size(), &writeStatus);
+        writer->close();
+        return stream;
+    }
+
+    /// Whether Range requests are honored.
+    bool m_honorRange;
+
+    /// The content type served.
+    std::string m_contentType;
+
+    /// Counter of Range requests received.
+    std::atomic<int>* m_rangeRequests;
+};
+
+/// A factory that creates @c MockMediaContentFetchers.
+class MockMediaContentFetcherFactory : public HTTPContentFetcherInterfaceFactoryInterface {
+public:
+    /**
+     * Constructor.
+     *
+     * @param honorRange Whether fetchers created will honor Range requests.
+     * @param contentType The content type served by fetchers created.
+     */
+    MockMediaContentFetcherFactory(bool honorRange, const std::string& contentType = "audio/mpeg") :
+            m_honorRange{honorRange},
+            m_contentType{contentType},
+            m_rangeRequests{0} {
+    }
+
+    std::unique_ptr<HTTPContentFetcherInterface> create(const std::string& url) override {
+        return memory::make_unique<MockMediaContentFetcher>(m_honorRange, m_contentType, &m_rangeRequests);
+    }
+
+    /// Whether fetchers created will honor Range requests.
+    bool m_honorRange;
+
+    /// The content type served by fetchers created.
+    std::string m_contentType;
+
+    /// Counter of Range requests received by fetchers created.
+    std::atomic<int> m_rangeRequests;
+};
+
+/**
+ * Reads the first bytes of the converted attachment.
+ *
+ * @param converter The converter.
+ * @param numBytes The number of bytes to read.
+ * @return The bytes read.
+ */
+static std::vector<uint8_t> readConvertedBytes(
+    std::shared_ptr<UrlContentToAttachmentConverter> converter,
+    size_t numBytes) {
+    std::vector<uint8_t> buffer(numBytes, 0);
+    auto reader = converter->getAttachment()->createReader(AttachmentReader::Policy::BLOCKING);
+    size_t bytesRead = 0;
+    while (bytesRead < numBytes) {
+        AttachmentReader::ReadStatus readStatus;
+        auto count = reader->read(buffer.data() + bytesRead, numBytes - bytesRead, &readStatus, READ_TIMEOUT);
+        if (0 == count) {
+            break;
+        }
+        bytesRead += count;
+    }
+    buffer.resize(bytesRead);
+    return buffer;
+}
+
+/**
+ * Verify that without a desired offset, streaming begins from the start of the media without Range requests.
+ */
+TEST(UrlContentToAttachmentConverterTest, noOffsetStreamsFromBeginning) {
+    auto factory = std::make_shared<MockMediaContentFetcherFactory>(true);
+    auto converter = UrlContentToAttachmentConverter::create(factory, TEST_MEDIA_URL, nullptr);
+    ASSERT_TRUE(converter);
+    EXPECT_EQ(converter->getStartStreamingPoint(), std::chrono::milliseconds::zero());
+    auto bytes = readConvertedBytes(converter, 16);
+    ASSERT_EQ(bytes.size(), 16u);
+    for (size_t i = 0; i < bytes.size(); ++i) {
+        EXPECT_EQ(bytes[i], mediaByteAt(i));
+    }
+    EXPECT_EQ(factory->m_rangeRequests, 0);
+    converter->shutdown();
+}
+
+/**
+ * Verify that resuming 45 minutes into the media starts fetching at the corresponding byte offset.
+ */
+TEST(UrlContentToAttachmentConverterTest, resumeUsesRangeRequest) {
+    auto factory = std::make_shared<MockMediaContentFetcherFactory>(true);
+    auto converter = UrlContentToAttachmentConverter::create(factory, TEST_MEDIA_URL, nullptr, FORTY_FIVE_MINUTES);
+    ASSERT_TRUE(converter);
+    EXPECT_EQ(converter->getStartStreamingPoint(), FORTY_FIVE_MINUTES);
+    auto bytes = readConvertedBytes(converter, 16);
+    ASSERT_EQ(bytes.size(), 16u);
+    uint64_t expectedPosition = 45 * 60 * BYTES_PER_SECOND_32KBPS;
+    for (size_t i = 0; i < bytes.size(); ++i) {
+        EXPECT_EQ(bytes[i], mediaByteAt(expectedPosition + i));
+    }
+    // One request for the header, and one for the media from the seek point.
+    EXPECT_EQ(factory->m_rangeRequests, 2);
+    converter->shutdown();
+}
+
+/**
+ * Verify that if the server ignores Range requests, streaming begins from the start of the media and the start
+ * streaming point reflects that.
+ */
+TEST(UrlContentToAttachmentConverterTest, resumeFallsBackWhenRangeIgnored) {
+    auto factory = std::make_shared<MockMediaContentFetcherFactory>(false);
+    auto converter = UrlContentToAttachmentConverter::create(factory, TEST_MEDIA_URL, nullptr, FORTY_FIVE_MINUTES);
+    ASSERT_TRUE(converter);
+    EXPECT_EQ(converter->getStartStreamingPoint(), std::chrono::milliseconds::zero());
+    EXPECT_EQ(converter->getDesiredStreamingPoint(), FORTY_FIVE_MINUTES);
+    auto bytes = readConvertedBytes(converter, 16);
+    ASSERT_EQ(bytes.size(), 16u);
+    for (size_t i = 0; i < bytes.size(); ++i) {
+        EXPECT_EQ(bytes[i], mediaByteAt(i));
+    }
+    converter->shutdown();
+}
+
+/**
+ * Verify that media whose content type is not MPEG audio is not probed for a seek index, even though its leading bytes
+ * look like MP3 frames, and streams from the beginning.
+ */
+TEST(UrlContentToAttachmentConverterTest, resumeDoesNotProbeOtherContentTypes) {
+    auto factory = std::make_shared<MockMediaContentFetcherFactory>(true, "audio/aac");
+    auto converter = UrlContentToAttachmentConverter::create(factory, TEST_MEDIA_URL, nullptr, FORTY_FIVE_MINUTES);
+    ASSERT_TRUE(converter);
+    EXPECT_EQ(converter->getStartStreamingPoint(), std::chrono::milliseconds::zero());
+    auto bytes = readConvertedBytes(converter, 16);
+    ASSERT_EQ(bytes.size(), 16u);
+    for (size_t i = 0; i < bytes.size(); ++i) {
+        EXPECT_EQ(bytes[i], mediaByteAt(i));
+    }
+    // Only the probe for the header, which is abandoned once the content type is known.
+    EXPECT_EQ(factory->m_rangeRequests, 1);
+    converter->shutdown();
+}
+
+/**
+ * Verify that a content type with parameters and in upper case is still recognized as MPEG audio.
+ */
+TEST(UrlContentToAttachmentConverterTest, resumeProbesMpegContentTypeWithParameters) {
+    auto factory = std::make_shared<MockMediaContentFetcherFactory>(true, "Audio/MPEG; charset=binary");
+    auto converter = UrlContentToAttachmentConverter::create(factory, TEST_MEDIA_URL, nullptr, FORTY_FIVE_MINUTES);
+    ASSERT_TRUE(converter);
+    EXPECT_EQ(converter->getStartStreamingPoint(), FORTY_FIVE_MINUTES);
+    converter->shutdown();
+}
+
+}  // namespace test
+}  // namespace playlistParser
+}  // namespace alexaClientSDK
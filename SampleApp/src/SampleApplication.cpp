@@ -32,16 +32,19 @@
 #include <AVSCommon/AVS/Initialization/AlexaClientSDKInit.h>
 #include <AVSCommon/Utils/Configuration/ConfigurationNode.h>
 #include <AVSCommon/Utils/LibcurlUtils/HTTPContentFetcherFactory.h>
+#include <AVSCommon/Utils/LibcurlUtils/HttpPost.h>
 #include <AVSCommon/Utils/Logger/LoggerSinkManager.h>
 #include <Alerts/Storage/SQLiteAlertStorage.h>
 #include <Audio/AudioFactory.h>
 #include <AuthDelegate/AuthDelegate.h>
+#include <AuthDelegate/EncryptedFileAuthTokenStorage.h>
 #include <MediaPlayer/MediaPlayer.h>
 #include <Settings/SQLiteSettingStorage.h>
 
 #include <algorithm>
 #include <cctype>
 #include <fstream>
+#include <iterator>
 
 namespace alexaClientSDK {
 namespace sampleApp {
@@ -73,6 +76,15 @@ static const std::string ENDPOINT_KEY("endpoint");
 /// Key for setting if display cards are supported or not under the @c SAMPLE_APP_CONFIG_KEY configuration node.
 static const std::string DISPLAY_CARD_KEY("displayCardsSupported");
 
+/// Key for the path of the file to persist the access token in under the @c SAMPLE_APP_CONFIG_KEY configuration node.
+static const std::string AUTH_TOKEN_FILE_PATH_KEY("authTokenFilePath");
+
+/**
+ * Key for the path of the file holding the key to encrypt the persisted access token with, under the
+ * @c SAMPLE_APP_CONFIG_KEY configuration node.
+ */
+static const std::string AUTH_TOKEN_KEY_FILE_PATH_KEY("authTokenKeyFilePath");
+
 #ifdef KWD_KITTAI
 /// The sensitivity of the Kitt.ai engine.
 static const double KITT_AI_SENSITIVITY = 0.6;
@@ -113,6 +125,33 @@ static alexaClientSDK::avsCommon::utils::logger::Level getLogLevelFromUserInput(
     return alexaClientSDK::avsCommon::utils::logger::convertNameToLevel(userInputLogLevel);
 }
 
+/**
+ * Creates the storage to persist the access token in, if the configuration asks for one.  The SampleApp has no
+ * secure key store, so it reads the key from a file; a product should take it from its platform's key store instead.
+ *
+ * @param config The configuration node of the SampleApp.
+ * @return The storage, or @c nullptr if the access token is not to be persisted or the storage could not be created.
+ */
+static std::shared_ptr<alexaClientSDK::authDelegate::AuthTokenStorageInterface> createAuthTokenStorage(
+    const alexaClientSDK::avsCommon::utils::configuration::ConfigurationNode& config) {
+    std::string filePath;
+    std::string keyFilePath;
+    if (!config.getString(AUTH_TOKEN_FILE_PATH_KEY, &filePath) ||
+        !config.getString(AUTH_TOKEN_KEY_FILE_PATH_KEY, &keyFilePath)) {
+        return nullptr;
+    }
+    std::ifstream keyFile(keyFilePath, std::ios::binary);
+    std::vector<unsigned char> key((std::istreambuf_iterator<char>(keyFile)), std::istreambuf_iterator<char>());
+    auto storage = alexaClientSDK::authDelegate::EncryptedFileAuthTokenStorage::create(filePath, key);
+    std::fill(key.begin(), key.end(), 0);
+    if (!storage) {
+        alexaClientSDK::sampleApp::ConsolePrinter::simplePrint(
+            "Failed to create the access token storage! The key file must hold " +
+            std::to_string(alexaClientSDK::authDelegate::EncryptedFileAuthTokenStorage::KEY_SIZE) + " bytes.");
+    }
+    return std::move(storage);
+}
+
 
 
 std::unique_ptr<SampleApplication> SampleApplication::create(
@@ -255,11 +294,13 @@ bool SampleApplication::initialize(
     auto connectionObserver = std::make_shared<alexaClientSDK::sampleApp::ConnectionObserver>();
 
     /*
-     * Creating the AuthDelegate - this component takes care of LWA and authorization of the client. At the moment,
-     * this must be done and authorization must be achieved prior to making the call to connect().
+     * Creating the AuthDelegate - this component takes care of LWA and authorization of the client.
      */
     std::shared_ptr<alexaClientSDK::authDelegate::AuthDelegate> authDelegate =
-        alexaClientSDK::authDelegate::AuthDelegate::create();
+        alexaClientSDK::authDelegate::AuthDelegate::create(
+            alexaClientSDK::avsCommon::utils::libcurlUtils::HttpPost::create(),
+            nullptr,
+            createAuthTokenStorage(config[SAMPLE_APP_CONFIG_KEY]));
 
     authDelegate->addAuthObserver(connectionObserver);
 
@@ -291,21 +332,21 @@ bool SampleApplication::initialize(
         return false;
     }
 
+    std::string endpoint;
+    config[SAMPLE_APP_CONFIG_KEY].getString(ENDPOINT_KEY, &endpoint);
+
     /*
-     * TODO: ACSDK-384 Remove the requirement of clients having to wait for authorization before making the connect()
-     * call.
+     * Connecting before authorization is achieved lets the connection to AVS be opened while the auth token is
+     * refreshed.
      */
+    client->connect(endpoint);
+
     if (!connectionObserver->waitFor(
             alexaClientSDK::avsCommon::sdkInterfaces::AuthObserverInterface::State::REFRESHED)) {
         alexaClientSDK::sampleApp::ConsolePrinter::simplePrint("Failed to authorize SDK client!");
         return false;
     }
 
-    std::string endpoint;
-    config[SAMPLE_APP_CONFIG_KEY].getString(ENDPOINT_KEY, &endpoint);
-
-    client->connect(endpoint);
-
     if (!connectionObserver->waitFor(avsCommon::sdkInterfaces::ConnectionStatusObserverInterface::Status::CONNECTED)) {
         alexaClientSDK::sampleApp::ConsolePrinter::simplePrint("Failed to connect to AVS!");
         return false;
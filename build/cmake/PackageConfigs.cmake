@@ -14,3 +14,6 @@ set(THREADS_PACKAGE_CONFIG REQUIRED)
 
 # Minimum version of OpenSSL required
 set(OPENSSL_MIN_VERSION 1.0.2)
+
+# Make OpenSSL required, for the libraries which use it directly rather than through CURL.
+set(OPENSSL_PACKAGE_CONFIG ${OPENSSL_MIN_VERSION} REQUIRED)
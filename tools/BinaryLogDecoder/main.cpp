@@ -0,0 +1,51 @@
+/*
+ * main.cpp
+ *
+ * Copyright 2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+#include <AVSCommon/Utils/Logger/BinaryLogDecoder.h>
+
+/**
+ * Decodes a log written by @c BinaryLogger and prints its entries as text to standard output.
+ *
+ * Usage: BinaryLogDecoder [<binary log file>]
+ *
+ * If no file is given, the log is read from standard input.
+ *
+ * @param argc The number of elements in the @c argv array.
+ * @param argv An array of @argc elements, containing the program name and all command-line arguments.
+ * @return @c EXIT_FAILURE if the log could not be opened or was not entirely decoded, else @c EXIT_SUCCESS.
+ */
+int main(int argc, char* argv[]) {
+    using alexaClientSDK::avsCommon::utils::logger::BinaryLogDecoder;
+
+    if (argc > 2) {
+        std::cerr << "Usage: " << argv[0] << " [<binary log file>]" << std::endl;
+        return EXIT_FAILURE;
+    }
+    if (argc == 1) {
+        return BinaryLogDecoder::decode(std::cin, std::cout) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    std::ifstream input(argv[1], std::ios::binary);
+    if (!input) {
+        std::cerr << "Failed to open " << argv[1] << std::endl;
+        return EXIT_FAILURE;
+    }
+    return BinaryLogDecoder::decode(input, std::cout) ? EXIT_SUCCESS : EXIT_FAILURE;
+}